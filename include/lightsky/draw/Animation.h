@@ -2,14 +2,15 @@
 #ifndef __LS_DRAW_ANIMATION_H__
 #define __LS_DRAW_ANIMATION_H__
 
+#include <cstdint> // uint64_t
 #include <vector>
-#include <string>
-#include <utility> // std::forward
 
 #include "lightsky/utils/Hash.h"
 
 #include "lightsky/draw/AnimationProperty.h"
 #include "lightsky/draw/AnimationChannel.h"
+#include "lightsky/draw/AnimationKeyList.h"
+#include "lightsky/draw/SceneNameTable.h"
 
 
 
@@ -81,6 +82,13 @@ class Animation
      */
     utils::hash_t animationId;
 
+    /**
+     * @brief clipId identifies the keyframe data referenced by *this. Copies
+     * of an Animation share the same clip ID, while every new Animation, or
+     * change to its channels, receives a new one.
+     */
+    uint64_t clipId;
+
     /**
      * @brief totalTicks contains the number of ticks, or duration, of an
      * Animation.
@@ -95,9 +103,10 @@ class Animation
 
     /**
      * @brief animName is used alongside 'animationId' to provide this
-     * class with a unique, human-readable, identifier.
+     * class with a unique, human-readable, identifier. It references a name
+     * within the SceneNameTable of the SceneGraph which owns *this.
      */
-    std::string animName;
+    scene_name_t animName;
 
     /**
      * @brief animationIds contains ID of the std::vector<AnimationChannel>
@@ -118,6 +127,23 @@ class Animation
      */
     std::vector<size_t> transformIds;
 
+    /**
+     * @brief morphMeshIds contains the index of each mesh who's morph target
+     * weights are animated by *this (SceneGraph::morphs[meshId]).
+     */
+    std::vector<size_t> morphMeshIds;
+
+    /**
+     * @brief morphTargetIds contains the index of the morph target, within
+     * each animated mesh, which a weight track modifies.
+     */
+    std::vector<unsigned> morphTargetIds;
+
+    /**
+     * @brief morphFrames contains the keyframes of each morph target weight.
+     */
+    std::vector<AnimationKeyListFloat> morphFrames;
+
   public: // public member functions
     /**
      * @brief Destructor
@@ -207,25 +233,50 @@ class Animation
      */
     size_t get_anim_id() const noexcept;
 
+    /**
+     * @brief Retrieve the identifier of the keyframe data used by *this.
+     *
+     * Unlike "get_anim_id()," two Animations which share a name, but were
+     * loaded separately, will return different clip IDs. Copies of an
+     * Animation (and of the SceneGraph containing it) return the same ID
+     * until their channels are modified.
+     *
+     * @return An integer which uniquely identifies the channels of *this.
+     */
+    uint64_t get_clip_id() const noexcept;
+
+    /**
+     * @brief Retrieve the interned name of *this Animation.
+     *
+     * @return The ID of *this Animation's name within the SceneNameTable of
+     * its SceneGraph, or SCENE_NAME_INVALID if no name was set.
+     */
+    scene_name_t get_anim_name_id() const noexcept;
+
     /**
      * @brief Retrieve the name of *this Animation.
      *
-     * @return A constant reference to a constant string, containing the
-     * name of *this.
+     * @param names
+     * The name table of the SceneGraph which owns *this.
+     *
+     * @return A pointer to a null-terminated string, containing the name of
+     * *this.
      */
-    const std::string& get_anim_name() const noexcept;
+    const char* get_anim_name(const SceneNameTable& names) const noexcept;
 
     /**
      * @brief Set *this Animation's name.
      *
      * Caling this function will reset *this Animation's unique integer ID
-     * to the hash of the input name.
+     * to the precomputed hash of the input name.
+     *
+     * @param names
+     * The name table of the SceneGraph which owns *this.
      *
-     * @param name
-     * A constant reference to a string, containing the new name of *this.
+     * @param nameId
+     * The ID of a name within "names."
      */
-    template <typename std_string_type>
-    void set_anim_name(std_string_type&& name) noexcept;
+    void set_anim_name(const SceneNameTable& names, const scene_name_t nameId) noexcept;
 
     /**
      * @brief Get the duration, in ticks, of *this Animation.
@@ -346,6 +397,59 @@ class Animation
      */
     void reserve_anim_channels(const size_t reserveSize) noexcept;
 
+    /**
+     * @brief Get the number of morph target weight tracks that will be
+     * animated by *this.
+     *
+     * @return The total number of morph target weights which *this Animation
+     * object modifies during any given frame.
+     */
+    size_t get_num_morph_channels() const noexcept;
+
+    /**
+     * @brief Retrieve the index of the mesh animated by each morph target
+     * weight track.
+     *
+     * @return A reference to a constant vector of indices which reference
+     * the "morphs" member of a SceneGraph.
+     */
+    const std::vector<size_t>& get_morph_meshes() const noexcept;
+
+    /**
+     * @brief Retrieve the index of the morph target, within each animated
+     * mesh, modified by each weight track.
+     *
+     * @return A reference to a constant vector of morph target indices.
+     */
+    const std::vector<unsigned>& get_morph_targets() const noexcept;
+
+    /**
+     * @brief Retrieve the keyframes of each morph target weight track.
+     *
+     * @return A reference to a constant vector of weight keyframes.
+     */
+    const std::vector<AnimationKeyListFloat>& get_morph_frames() const noexcept;
+
+    /**
+     * @brief Add a morph target weight track to *this.
+     *
+     * @param meshId
+     * The index of the mesh, within "SceneGraph::meshes," which contains the
+     * animated morph target.
+     *
+     * @param targetId
+     * The index of the morph target to animate within the mesh.
+     *
+     * @param frames
+     * An r-value reference to the keyframes of the target's weight.
+     */
+    void add_morph_channel(const size_t meshId, const unsigned targetId, AnimationKeyListFloat&& frames) noexcept;
+
+    /**
+     * Remove all morph target weight tracks inside of *this.
+     */
+    void clear_morph_channels() noexcept;
+
     /**
      * @brief Animate nodes in a sceneGraph.
      *
@@ -362,6 +466,21 @@ class Animation
      */
     void animate(SceneGraph& graph, const anim_prec_t percentDone) const noexcept;
 
+    /**
+     * @brief Animate only the morph target weights of a sceneGraph.
+     *
+     * This is called by "animate(...)" and is provided for systems which
+     * evaluate node transformations separately.
+     *
+     * @param graph
+     * A reference to a sceneGraph object who's morph target weights will be
+     * updated according to the keyframes in *this.
+     *
+     * @param percentDone
+     * The percent of the animation which has been played in total.
+     */
+    void animate_morphs(SceneGraph& graph, const anim_prec_t percentDone) const noexcept;
+
     /**
      * Initialize the animation transformations for all nodes in a scene graph.
      * 
@@ -378,17 +497,6 @@ class Animation
 
 
 
-/*-------------------------------------
- * Set the Animation name
--------------------------------------*/
-template <typename std_string_type>
-void Animation::set_anim_name(std_string_type&& name) noexcept
-{
-    animationId = utils::string_hash(name.c_str());
-    animName = std::forward<std_string_type>(name);
-}
-
-
 } // end draw namespace
 } // end ls namespace
 
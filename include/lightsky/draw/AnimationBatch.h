@@ -0,0 +1,288 @@
+
+#ifndef __LS_DRAW_ANIMATION_BATCH_H__
+#define __LS_DRAW_ANIMATION_BATCH_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint> // uint64_t
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "lightsky/draw/AnimationProperty.h"
+
+
+
+namespace ls
+{
+namespace draw
+{
+
+/*-----------------------------------------------------------------------------
+ * Forward declarations
+-----------------------------------------------------------------------------*/
+class AnimationPlayer;
+class SceneGraph;
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief An AnimationBatchItem references a single player which should animate
+ * a single Animation within a scene graph.
+-----------------------------------------------------------------------------*/
+struct AnimationBatchItem
+{
+    /**
+     * @brief Non-owning pointer to the player which tracks the playback time
+     * of an animation.
+     */
+    AnimationPlayer* pPlayer;
+
+    /**
+     * @brief Non-owning pointer to the scene graph who's transformations will
+     * be modified by an animation.
+     */
+    SceneGraph* pGraph;
+
+    /**
+     * @brief Index of the Animation to play within "pGraph->animations."
+     */
+    unsigned animationIndex;
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief The AnimationBatch class evaluates a large number of animation
+ * players across a set of worker threads.
+ *
+ * Items are split into contiguous, fixed ranges per thread so every player
+ * is always advanced by the same thread in the same order. No locks are taken
+ * while animations are evaluated, therefore all items in a batch must write
+ * to disjoint transformations (i.e. one scene graph per animated agent, or
+ * multiple animations which never share a scene node).
+-----------------------------------------------------------------------------*/
+class AnimationBatch
+{
+  private:
+    /**
+     * @brief items contains the list of players to evaluate during each call
+     * to "tick(...)".
+     */
+    std::vector<AnimationBatchItem> items;
+
+    /**
+     * @brief workers contains all threads which help the calling thread
+     * evaluate animations.
+     */
+    std::vector<std::thread> workers;
+
+    /**
+     * @brief signalLock is only held while a batch is being started or
+     * finished. It protects all members used to signal worker threads.
+     */
+    std::mutex signalLock;
+
+    /**
+     * @brief startCond notifies worker threads that a new tick should be
+     * processed.
+     */
+    std::condition_variable startCond;
+
+    /**
+     * @brief finishCond notifies the calling thread that all workers have
+     * completed the current tick.
+     */
+    std::condition_variable finishCond;
+
+    /**
+     * @brief numPending contains the number of workers which have not yet
+     * completed the current tick.
+     */
+    std::atomic<unsigned> numPending;
+
+    /**
+     * @brief generation is incremented once per tick so sleeping workers can
+     * detect a new batch of work.
+     */
+    uint64_t generation;
+
+    /**
+     * @brief tickMillis contains the time delta which all players will be
+     * advanced by during the current tick.
+     */
+    uint64_t tickMillis;
+
+    /**
+     * @brief shouldStop is used to notify all worker threads to exit.
+     */
+    bool shouldStop;
+
+    /**
+     * @brief Main loop for all worker threads.
+     *
+     * @param partitionId
+     * The index of the contiguous range of items which a worker thread
+     * evaluates. Partition 0 is always reserved for the calling thread.
+     */
+    void thread_loop(const unsigned partitionId) noexcept;
+
+    /**
+     * @brief Join all worker threads without modifying any items.
+     */
+    void stop_workers() noexcept;
+
+    /**
+     * @brief Advance and evaluate a contiguous range of items.
+     *
+     * @param partitionId
+     * The index of the range of items to process.
+     *
+     * @param numPartitions
+     * The total number of ranges which the list of items has been split
+     * into.
+     *
+     * @param millis
+     * The number of milliseconds to advance each player by.
+     */
+    void tick_partition(const unsigned partitionId, const unsigned numPartitions, const uint64_t millis) noexcept;
+
+  public:
+    /**
+     * @brief Destructor
+     *
+     * Joins all worker threads and cleans up all memory and resources used.
+     */
+    ~AnimationBatch() noexcept;
+
+    /**
+     * @brief Constructor
+     *
+     * Initializes all members to their default values. No threads are
+     * started until "init(...)" is called.
+     */
+    AnimationBatch() noexcept;
+
+    /**
+     * @brief Copy Constructor
+     *
+     * Deleted as worker threads reference *this directly.
+     */
+    AnimationBatch(const AnimationBatch&) = delete;
+
+    /**
+     * @brief Move Constructor
+     *
+     * Deleted as worker threads reference *this directly.
+     */
+    AnimationBatch(AnimationBatch&&) = delete;
+
+    /**
+     * @brief Copy Operator
+     *
+     * Deleted as worker threads reference *this directly.
+     */
+    AnimationBatch& operator=(const AnimationBatch&) = delete;
+
+    /**
+     * @brief Move Operator
+     *
+     * Deleted as worker threads reference *this directly.
+     */
+    AnimationBatch& operator=(AnimationBatch&&) = delete;
+
+    /**
+     * @brief Start the worker threads used to evaluate animations.
+     *
+     * @param numThreads
+     * The total number of threads, including the calling thread, which will
+     * evaluate animations. A value of 0 will use the number of hardware
+     * threads available on the system.
+     *
+     * Any previously started threads are joined first. All items remain in
+     * *this, allowing the thread count of a live batch to be changed.
+     *
+     * @return TRUE if all threads were successfully started, FALSE if not.
+     * Items are evaluated on the calling thread alone if no workers could be
+     * started.
+     */
+    bool init(unsigned numThreads = 0) noexcept;
+
+    /**
+     * @brief Join all worker threads and clear all items in *this.
+     */
+    void terminate() noexcept;
+
+    /**
+     * @brief Retrieve the number of threads which evaluate animations,
+     * including the calling thread.
+     *
+     * @return The number of threads used during a call to "tick(...)".
+     */
+    unsigned get_num_threads() const noexcept;
+
+    /**
+     * @brief Add an animation player to *this batch.
+     *
+     * @param player
+     * A reference to the player which tracks playback time. This player must
+     * remain valid until it is removed from *this.
+     *
+     * @param graph
+     * A reference to the scene graph which will be animated. This graph must
+     * remain valid until it is removed from *this.
+     *
+     * @param animationIndex
+     * The index of the Animation within the input scene graph to play.
+     */
+    void add(AnimationPlayer& player, SceneGraph& graph, const unsigned animationIndex) noexcept;
+
+    /**
+     * @brief Remove all items from *this batch.
+     *
+     * Worker threads remain active.
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Retrieve the items contained within *this.
+     *
+     * @return A constant reference to the list of items evaluated by
+     * "tick(...)".
+     */
+    const std::vector<AnimationBatchItem>& get_items() const noexcept;
+
+    /**
+     * @brief Advance all players in *this and animate their scene graphs.
+     *
+     * This function blocks until all items have been evaluated.
+     *
+     * @param millis
+     * The number of milliseconds which have passed since the last update.
+     */
+    void tick(const uint64_t millis) noexcept;
+};
+
+
+
+/*-------------------------------------
+ * Retrieve the number of active threads
+-------------------------------------*/
+inline unsigned AnimationBatch::get_num_threads() const noexcept
+{
+    return (unsigned)workers.size() + 1;
+}
+
+
+
+/*-------------------------------------
+ * Retrieve the batch items
+-------------------------------------*/
+inline const std::vector<AnimationBatchItem>& AnimationBatch::get_items() const noexcept
+{
+    return items;
+}
+} // end draw namespace
+} // end ls namespace
+
+#endif // __LS_DRAW_ANIMATION_BATCH_H__
@@ -0,0 +1,337 @@
+
+#ifndef __LS_DRAW_ANIMATION_BLENDER_H__
+#define __LS_DRAW_ANIMATION_BLENDER_H__
+
+#include <vector>
+
+#include "lightsky/math/vec3.h"
+#include "lightsky/math/quat.h"
+
+#include "lightsky/draw/AnimationProperty.h"
+
+
+
+namespace ls
+{
+namespace draw
+{
+
+/*-----------------------------------------------------------------------------
+ * Forward declarations
+-----------------------------------------------------------------------------*/
+class SceneGraph;
+
+
+
+/**------------------------------------
+ * @brief Blend modes determine how a layer is combined with the layers which
+ * were evaluated before it.
+-------------------------------------*/
+enum animation_blend_t : unsigned
+{
+    /**
+     * The layer's transformations are accumulated with all previous layers
+     * and normalized by the total weight once all layers are evaluated. Use
+     * this for N-way blending of clips (locomotion blend spaces, etc.).
+     */
+    ANIM_BLEND_MIX,
+
+    /**
+     * The layer's transformations are interpolated over the result of all
+     * previous layers using the layer weight. A weight of 1.0 fully replaces
+     * previous layers for all masked nodes.
+     */
+    ANIM_BLEND_OVERRIDE,
+
+    ANIM_BLEND_DEFAULT = ANIM_BLEND_MIX
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief An AnimationBlendLayer describes how a single Animation contributes
+ * to the final pose evaluated by an AnimationBlender.
+-----------------------------------------------------------------------------*/
+struct AnimationBlendLayer
+{
+    /**
+     * @brief Index of the Animation to sample from "SceneGraph::animations."
+     */
+    unsigned animationIndex;
+
+    /**
+     * @brief Percent of the Animation to sample, as provided by
+     * "AnimationPlayer::advance(...)."
+     */
+    anim_prec_t percent;
+
+    /**
+     * @brief Overall weight of the layer, between 0.0 and 1.0.
+     */
+    float weight;
+
+    /**
+     * @brief Determines how *this layer combines with previous layers.
+     */
+    animation_blend_t blendMode;
+
+    /**
+     * @brief Optional, non-owning, per-node weights which are multiplied by
+     * the layer weight. The mask is indexed by a node's transform ID and must
+     * contain one element per transform in the evaluated scene graph. Leave
+     * as NULL to affect all nodes.
+     */
+    const float* pMask;
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief The AnimationBlender evaluates multiple Animations, with weights and
+ * masks, in a single pass.
+ *
+ * All layers are sampled into an internal structure-of-arrays pose buffer.
+ * Scene graph transforms are only written once at the end of an evaluation,
+ * and only for nodes which were affected by at least one layer.
+-----------------------------------------------------------------------------*/
+class AnimationBlender
+{
+  private:
+    /**
+     * @brief layers contains all Animation layers to evaluate, in order.
+     */
+    std::vector<AnimationBlendLayer> layers;
+
+    /**
+     * @brief positions contains the weighted sum of all sampled positions,
+     * indexed by transform ID.
+     */
+    std::vector<math::vec3> positions;
+
+    /**
+     * @brief scales contains the weighted sum of all sampled scalings,
+     * indexed by transform ID.
+     */
+    std::vector<math::vec3> scales;
+
+    /**
+     * @brief rotations contains the weighted sum of all sampled orientations,
+     * indexed by transform ID.
+     */
+    std::vector<math::quat> rotations;
+
+    /**
+     * @brief posWeights contains the total weight of all positions
+     * accumulated for each transform.
+     */
+    std::vector<float> posWeights;
+
+    /**
+     * @brief sclWeights contains the total weight of all scalings
+     * accumulated for each transform.
+     */
+    std::vector<float> sclWeights;
+
+    /**
+     * @brief rotWeights contains the total weight of all orientations
+     * accumulated for each transform.
+     */
+    std::vector<float> rotWeights;
+
+    /**
+     * @brief touchedIds contains the IDs of all transforms modified by the
+     * current evaluation so the pose buffers can be written and reset without
+     * iterating over every node in a scene graph.
+     */
+    std::vector<size_t> touchedIds;
+
+    /**
+     * @brief Resize and clear all internal pose buffers.
+     *
+     * @param numTransforms
+     * The number of transformations in the scene graph being evaluated.
+     */
+    void reset_pose(const size_t numTransforms) noexcept;
+
+    /**
+     * @brief Sample a single layer into the internal pose buffers.
+     *
+     * @param graph
+     * A constant reference to the scene graph containing the layer's
+     * Animation.
+     *
+     * @param layer
+     * A constant reference to the layer which will be sampled.
+     */
+    void sample_layer(const SceneGraph& graph, const AnimationBlendLayer& layer) noexcept;
+
+  public:
+    /**
+     * @brief Destructor
+     *
+     * Cleans up all memory and resources used.
+     */
+    ~AnimationBlender() noexcept;
+
+    /**
+     * @brief Constructor
+     *
+     * Initializes all members to their default values.
+     */
+    AnimationBlender() noexcept;
+
+    /**
+     * @brief Copy Constructor
+     *
+     * Copies all layers from the input parameter into *this. Scratch pose
+     * buffers are not copied.
+     *
+     * @param b
+     * A constant reference to another AnimationBlender object.
+     */
+    AnimationBlender(const AnimationBlender& b) noexcept;
+
+    /**
+     * @brief Move Constructor
+     *
+     * Moves all data from the input parameter into *this.
+     *
+     * @param b
+     * An r-value reference to a temporary AnimationBlender object.
+     */
+    AnimationBlender(AnimationBlender&& b) noexcept;
+
+    /**
+     * @brief Copy Operator
+     *
+     * Copies all layers from the input parameter into *this. Scratch pose
+     * buffers are not copied.
+     *
+     * @param b
+     * A constant reference to another AnimationBlender object.
+     *
+     * @return A reference to *this.
+     */
+    AnimationBlender& operator=(const AnimationBlender& b) noexcept;
+
+    /**
+     * @brief Move Operator
+     *
+     * Moves all data from the input parameter into *this.
+     *
+     * @param b
+     * An r-value reference to a temporary AnimationBlender object.
+     *
+     * @return A reference to *this.
+     */
+    AnimationBlender& operator=(AnimationBlender&& b) noexcept;
+
+    /**
+     * @brief Add a layer to be evaluated.
+     *
+     * Layers are evaluated in the order they were added.
+     *
+     * @param layer
+     * A constant reference to the layer to add.
+     *
+     * @return The index of the newly added layer.
+     */
+    size_t add_layer(const AnimationBlendLayer& layer) noexcept;
+
+    /**
+     * @brief Retrieve a layer so its percent or weight can be updated between
+     * evaluations.
+     *
+     * @param layerId
+     * The index of the layer to retrieve.
+     *
+     * @return A reference to a layer contained within *this.
+     */
+    AnimationBlendLayer& get_layer(const size_t layerId) noexcept;
+
+    /**
+     * @brief Retrieve a layer contained within *this.
+     *
+     * @param layerId
+     * The index of the layer to retrieve.
+     *
+     * @return A constant reference to a layer contained within *this.
+     */
+    const AnimationBlendLayer& get_layer(const size_t layerId) const noexcept;
+
+    /**
+     * @brief Retrieve the number of layers contained within *this.
+     *
+     * @return The number of layers evaluated during "animate(...)".
+     */
+    size_t get_num_layers() const noexcept;
+
+    /**
+     * @brief Remove all layers from *this.
+     */
+    void clear_layers() noexcept;
+
+    /**
+     * @brief Sample all layers and write the blended result into a scene
+     * graph's transformations.
+     *
+     * Each affected transformation is modified, and marked dirty, exactly
+     * once regardless of the number of layers.
+     *
+     * @param graph
+     * A reference to the scene graph which contains all Animations referenced
+     * by each layer.
+     */
+    void animate(SceneGraph& graph) noexcept;
+
+    /**
+     * @brief Generate a mask which only affects a node and all of its
+     * children.
+     *
+     * @param graph
+     * A constant reference to the scene graph which will be animated.
+     *
+     * @param rootNodeId
+     * The index of the node which, along with its children, will be fully
+     * weighted by the mask.
+     *
+     * @param outMask
+     * A reference to a list of floats which will contain one weight per
+     * transform in the input graph.
+     */
+    static void make_node_mask(const SceneGraph& graph, const size_t rootNodeId, std::vector<float>& outMask) noexcept;
+};
+
+
+
+/*-------------------------------------
+ * Retrieve a layer
+-------------------------------------*/
+inline AnimationBlendLayer& AnimationBlender::get_layer(const size_t layerId) noexcept
+{
+    return layers[layerId];
+}
+
+
+
+/*-------------------------------------
+ * Retrieve a layer (const)
+-------------------------------------*/
+inline const AnimationBlendLayer& AnimationBlender::get_layer(const size_t layerId) const noexcept
+{
+    return layers[layerId];
+}
+
+
+
+/*-------------------------------------
+ * Retrieve the layer count
+-------------------------------------*/
+inline size_t AnimationBlender::get_num_layers() const noexcept
+{
+    return layers.size();
+}
+} // end draw namespace
+} // end ls namespace
+
+#endif // __LS_DRAW_ANIMATION_BLENDER_H__
@@ -2,6 +2,8 @@
 #ifndef __LS_DRAW_ANIMATION_KEY_LIST_H__
 #define __LS_DRAW_ANIMATION_KEY_LIST_H__
 
+#include <cstddef> // std::max_align_t
+#include <new> // std::nothrow
 #include <utility> // std::move
 
 #include "lightsky/setup/Macros.h" // LS_DECLARE_CLASS_TYPE
@@ -68,17 +70,34 @@ class AnimationKeyList
      */
       size_t numFrames;
 
+    /**
+     * @brief keyBuffer contains the keyframe data, followed by the keyframe
+     * times, within a single allocation.
+     */
+    utils::Pointer<char[]> keyBuffer;
+
     /**
      * @brief positionTimes contains the keyframe times of a particular
      * animation's positions.
      */
-    utils::Pointer<anim_prec_t[]> keyTimes;
+    anim_prec_t* keyTimes;
 
     /**
      * @brief keyData contains a list of variables which can be
      * interpolated during an animation.
      */
-    utils::Pointer<data_t[]> keyData;
+    data_t* keyData;
+
+    /**
+     * Allocate a buffer large enough to hold the data and times of all
+     * keyframes.
+     *
+     * @param keyCount
+     * The number of keyframes to allocate.
+     *
+     * @return TRUE if the buffer was allocated, FALSE if not.
+     */
+    bool allocate_keys(const size_t keyCount) noexcept;
 
   public:
     /*
@@ -357,6 +376,7 @@ AnimationKeyList<data_t>::~AnimationKeyList() noexcept
 template <typename data_t>
 AnimationKeyList<data_t>::AnimationKeyList() noexcept :
     numFrames{0},
+    keyBuffer{nullptr},
     keyTimes{nullptr},
     keyData{nullptr}
 {
@@ -367,6 +387,7 @@ AnimationKeyList<data_t>::AnimationKeyList() noexcept :
 template <typename data_t>
 AnimationKeyList<data_t>::AnimationKeyList(const AnimationKeyList& a) noexcept :
     numFrames{0},
+    keyBuffer{nullptr},
     keyTimes{nullptr},
     keyData{nullptr}
 {
@@ -378,10 +399,39 @@ AnimationKeyList<data_t>::AnimationKeyList(const AnimationKeyList& a) noexcept :
 template <typename data_t>
 AnimationKeyList<data_t>::AnimationKeyList(AnimationKeyList&& a) noexcept :
     numFrames{a.numFrames},
-    keyTimes{std::move(a.keyTimes)},
-    keyData{std::move(a.keyData)}
+    keyBuffer{std::move(a.keyBuffer)},
+    keyTimes{a.keyTimes},
+    keyData{a.keyData}
 {
     a.numFrames = 0;
+    a.keyTimes = nullptr;
+    a.keyData = nullptr;
+}
+
+/*-------------------------------------
+ * Allocate keyframe storage
+-------------------------------------*/
+template <typename data_t>
+bool AnimationKeyList<data_t>::allocate_keys(const size_t keyCount) noexcept
+{
+    // Keyframe data is placed first so it receives the alignment of the
+    // allocation. Times are placed immediately afterwards.
+    static_assert(alignof(data_t) <= alignof(std::max_align_t), "Keyframe data cannot be over-aligned.");
+    static_assert(sizeof(data_t) % alignof(anim_prec_t) == 0, "Keyframe times would be misaligned.");
+
+    keyBuffer.reset(new(std::nothrow) char[(sizeof(data_t) + sizeof(anim_prec_t)) * keyCount]);
+
+    if (!keyBuffer)
+    {
+        keyTimes = nullptr;
+        keyData = nullptr;
+        return false;
+    }
+
+    keyData = reinterpret_cast<data_t*>(keyBuffer.get());
+    keyTimes = reinterpret_cast<anim_prec_t*>(keyBuffer.get() + sizeof(data_t) * keyCount);
+
+    return true;
 }
 
 /*-------------------------------------
@@ -403,13 +453,7 @@ AnimationKeyList<data_t>& AnimationKeyList<data_t>::operator=(const AnimationKey
         return *this;
     }
 
-    if (k.numFrames != numFrames)
-    {
-        keyTimes.reset(new anim_prec_t[k.numFrames]);
-        keyData.reset(new data_t[k.numFrames]);
-    }
-
-    if (!keyTimes || !keyData)
+    if (k.numFrames != numFrames && !allocate_keys(k.numFrames))
     {
         clear();
         return *this;
@@ -417,8 +461,7 @@ AnimationKeyList<data_t>& AnimationKeyList<data_t>::operator=(const AnimationKey
 
     numFrames = k.numFrames;
 
-    utils::fast_memcpy(keyTimes.get(), k.keyTimes.get(), sizeof(anim_prec_t) * numFrames);
-    utils::fast_memcpy(keyData.get(), k.keyData.get(), sizeof(data_t) * numFrames);
+    utils::fast_memcpy(keyBuffer.get(), k.keyBuffer.get(), (sizeof(data_t) + sizeof(anim_prec_t)) * numFrames);
 
     return *this;
 }
@@ -436,8 +479,13 @@ AnimationKeyList<data_t>& AnimationKeyList<data_t>::operator=(AnimationKeyList&&
     numFrames = k.numFrames;
     k.numFrames = 0;
 
-    keyTimes = std::move(k.keyTimes);
-    keyData = std::move(k.keyData);
+    keyBuffer = std::move(k.keyBuffer);
+
+    keyTimes = k.keyTimes;
+    k.keyTimes = nullptr;
+
+    keyData = k.keyData;
+    k.keyData = nullptr;
 
     return *this;
 }
@@ -448,8 +496,9 @@ template <typename data_t>
 void AnimationKeyList<data_t>::clear() noexcept
 {
     numFrames = 0;
-    keyTimes.reset();
-    keyData.reset();
+    keyBuffer.reset();
+    keyTimes = nullptr;
+    keyData = nullptr;
 }
 
 /*-------------------------------------
@@ -474,21 +523,14 @@ bool AnimationKeyList<data_t>::init(const size_t keyCount) noexcept
         return true;
     }
 
-    if (keyCount != numFrames)
-    {
-        keyTimes.reset(new anim_prec_t[keyCount]);
-        keyData.reset(new data_t[keyCount]);
-    }
-
-    if (!keyTimes || !keyData)
+    if (keyCount != numFrames && !allocate_keys(keyCount))
     {
         clear();
         return false;
     }
 
     numFrames = keyCount;
-    utils::fast_memset(keyTimes.get(), 0, sizeof(anim_prec_t) * numFrames);
-    utils::fast_memset(keyData.get(), 0, sizeof(data_t) * numFrames);
+    utils::fast_memset(keyBuffer.get(), 0, (sizeof(data_t) + sizeof(anim_prec_t)) * numFrames);
 
     return true;
 }
@@ -642,6 +684,9 @@ data_t AnimationKeyList<data_t>::get_interpolated_data(anim_prec_t, const animat
     return data_t{};
 }
 
+template <>
+float AnimationKeyList<float>::get_interpolated_data(anim_prec_t percent, const animation_flag_t animFlags) const noexcept;
+
 template <>
 math::vec3_t<float> AnimationKeyList<math::vec3_t<float>>::get_interpolated_data(anim_prec_t percent, const animation_flag_t animFlags) const noexcept;
 
@@ -654,6 +699,8 @@ math::quat_t<float> AnimationKeyList<math::quat_t<float>>::get_interpolated_data
 /*-----------------------------------------------------------------------------
  * Pre-Compiled Template Specializations
 -----------------------------------------------------------------------------*/
+LS_DECLARE_CLASS_TYPE(AnimationKeyListFloat, AnimationKeyList, float);
+
 LS_DECLARE_CLASS_TYPE(AnimationKeyListVec3, AnimationKeyList, math::vec3_t<float>);
 
 LS_DECLARE_CLASS_TYPE(AnimationKeyListQuat, AnimationKeyList, math::quat_t<float>);
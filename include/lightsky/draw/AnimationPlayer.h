@@ -17,6 +17,7 @@ namespace draw
 /*-----------------------------------------------------------------------------
  * Forward declarations
 -----------------------------------------------------------------------------*/
+class Animation;
 class SceneGraph;
 
 
@@ -199,6 +200,30 @@ class AnimationPlayer
      */
     void tick(SceneGraph& graph, unsigned animationIndex, uint64_t millis) noexcept;
 
+    /**
+     * @brief Progress the playback time of *this without modifying any scene
+     * graph data.
+     *
+     * This function performs all of the time and play-count bookkeeping of
+     * 'tick(...)' so Animation evaluation can be deferred or performed on
+     * another thread. Only the internal state of *this is modified.
+     *
+     * @param anim
+     * A constant reference to the Animation which is being played.
+     *
+     * @param millis
+     * The total number of milliseconds which have passed since the last
+     * update.
+     *
+     * @param outPercent
+     * A reference to a floating-point number which will contain the percent
+     * of the Animation which should be evaluated for the current frame.
+     *
+     * @return TRUE if the input Animation should be evaluated at
+     * 'outPercent', FALSE if playback is paused or stopped.
+     */
+    bool advance(const Animation& anim, uint64_t millis, anim_prec_t& outPercent) noexcept;
+
     /**
      * @brief Get the current state of playback from *this.
      *
@@ -0,0 +1,437 @@
+
+#ifndef __LS_DRAW_ANIMATION_POSE_CACHE_H__
+#define __LS_DRAW_ANIMATION_POSE_CACHE_H__
+
+#include <cstdint> // uint64_t
+#include <unordered_map>
+#include <vector>
+
+#include "lightsky/math/vec3.h"
+#include "lightsky/math/quat.h"
+
+#include "lightsky/draw/AnimationProperty.h"
+
+
+
+namespace ls
+{
+namespace draw
+{
+
+/*-----------------------------------------------------------------------------
+ * Forward declarations
+-----------------------------------------------------------------------------*/
+class Animation;
+class AnimationPlayer;
+class SceneGraph;
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief An AnimationPoseKey uniquely identifies a sampled pose by the
+ * keyframes which generated it and the quantized time it was sampled at.
+-----------------------------------------------------------------------------*/
+struct AnimationPoseKey
+{
+    /**
+     * @brief The clip ID of an animation, from "Animation::get_clip_id()."
+     */
+    uint64_t clipId;
+
+    /**
+     * @brief The quantized playback percent of a pose.
+     */
+    unsigned frameId;
+
+    /**
+     * @brief Compare two pose keys for equality.
+     *
+     * @param k
+     * A constant reference to another pose key.
+     *
+     * @return TRUE if both keys reference the same pose, FALSE if not.
+     */
+    bool operator==(const AnimationPoseKey& k) const noexcept;
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief Hashing functor which allows AnimationPoseKeys to be placed into
+ * hash tables.
+-----------------------------------------------------------------------------*/
+struct AnimationPoseKeyHash
+{
+    size_t operator()(const AnimationPoseKey& k) const noexcept;
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief An AnimationPose contains the local transformations of every channel
+ * of an Animation at a single point in time.
+ *
+ * Data is stored as a structure of arrays, indexed by animation channel, so
+ * poses can be copied into a scene graph without re-evaluating keyframes.
+-----------------------------------------------------------------------------*/
+struct AnimationPose
+{
+    enum : unsigned char
+    {
+        POSE_HAS_POSITION = 0x01,
+        POSE_HAS_SCALE = 0x02,
+        POSE_HAS_ROTATION = 0x04
+    };
+
+    /**
+     * @brief Bitmask of the transformation components which were sampled for
+     * each channel.
+     */
+    std::vector<unsigned char> channelMasks;
+
+    /**
+     * @brief Sampled position of each channel.
+     */
+    std::vector<math::vec3> positions;
+
+    /**
+     * @brief Sampled scale of each channel.
+     */
+    std::vector<math::vec3> scales;
+
+    /**
+     * @brief Sampled orientation of each channel.
+     */
+    std::vector<math::quat> rotations;
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief The AnimationPoseCache class shares sampled poses between many
+ * instances which play the same Animation at the same time.
+ *
+ * Playback time is quantized to a fixed number of steps per animation. The
+ * first player to request a (clip, step) pair samples all of the animation's
+ * channels. All subsequent players which request the same pair copy the
+ * cached pose into their own scene graph. The least recently used pose is
+ * evicted once the cache is full.
+ *
+ * Animations are identified by their clip ID rather than their name, so
+ * poses are only shared between copies of the same Animation. Instances
+ * which should share poses must be copied from a single loaded SceneGraph.
+-----------------------------------------------------------------------------*/
+class AnimationPoseCache
+{
+  private:
+    /**
+     * @brief Number of steps which each animation's playback time is
+     * quantized to.
+     */
+    unsigned quantization;
+
+    /**
+     * @brief Maps each cached pose key to its slot in "poses."
+     */
+    std::unordered_map<AnimationPoseKey, size_t, AnimationPoseKeyHash> slotMap;
+
+    /**
+     * @brief The key of each pose slot.
+     */
+    std::vector<AnimationPoseKey> slotKeys;
+
+    /**
+     * @brief Index of the next most recently used slot. The most recently
+     * used slot contains "(size_t)-1."
+     */
+    std::vector<size_t> slotNewer;
+
+    /**
+     * @brief Index of the next least recently used slot. The least recently
+     * used slot contains "(size_t)-1."
+     */
+    std::vector<size_t> slotOlder;
+
+    /**
+     * @brief Storage for all cached poses. This is only resized when the
+     * capacity of *this changes.
+     */
+    std::vector<AnimationPose> poses;
+
+    /**
+     * @brief Number of pose slots which currently contain data.
+     */
+    size_t numUsed;
+
+    /**
+     * @brief The most recently used slot.
+     */
+    size_t newestSlot;
+
+    /**
+     * @brief The least recently used slot.
+     */
+    size_t oldestSlot;
+
+    /**
+     * @brief Number of requests which were found in the cache.
+     */
+    uint64_t numHits;
+
+    /**
+     * @brief Number of requests which required a pose to be sampled.
+     */
+    uint64_t numMisses;
+
+    /**
+     * @brief Remove a slot from the LRU list.
+     */
+    void unlink_slot(const size_t slot) noexcept;
+
+    /**
+     * @brief Place a slot at the front of the LRU list.
+     */
+    void link_newest(const size_t slot) noexcept;
+
+    /**
+     * @brief Retrieve a slot which can be used to store a new pose, evicting
+     * the least recently used pose if necessary.
+     */
+    size_t acquire_slot() noexcept;
+
+    /**
+     * @brief Sample every channel of an animation into a pose.
+     */
+    static void sample_pose(const SceneGraph& graph, const Animation& anim, const anim_prec_t percent, AnimationPose& outPose) noexcept;
+
+    /**
+     * @brief Copy a pose into the transformations of a scene graph.
+     */
+    static void apply_pose(SceneGraph& graph, const Animation& anim, const AnimationPose& pose) noexcept;
+
+  public:
+    /**
+     * @brief Destructor
+     *
+     * Cleans up all memory and resources used.
+     */
+    ~AnimationPoseCache() noexcept;
+
+    /**
+     * @brief Constructor
+     *
+     * Initializes all members to their default values. No poses can be
+     * cached until "set_capacity(...)" is called.
+     */
+    AnimationPoseCache() noexcept;
+
+    /**
+     * @brief Copy Constructor
+     *
+     * Copies all data from the input parameter into *this.
+     *
+     * @param c
+     * A constant reference to another AnimationPoseCache object.
+     */
+    AnimationPoseCache(const AnimationPoseCache& c) noexcept;
+
+    /**
+     * @brief Move Constructor
+     *
+     * Moves all data from the input parameter into *this.
+     *
+     * @param c
+     * An r-value reference to a temporary AnimationPoseCache object.
+     */
+    AnimationPoseCache(AnimationPoseCache&& c) noexcept;
+
+    /**
+     * @brief Copy Operator
+     *
+     * Copies all data from the input parameter into *this.
+     *
+     * @param c
+     * A constant reference to another AnimationPoseCache object.
+     *
+     * @return A reference to *this.
+     */
+    AnimationPoseCache& operator=(const AnimationPoseCache& c) noexcept;
+
+    /**
+     * @brief Move Operator
+     *
+     * Moves all data from the input parameter into *this.
+     *
+     * @param c
+     * An r-value reference to a temporary AnimationPoseCache object.
+     *
+     * @return A reference to *this.
+     */
+    AnimationPoseCache& operator=(AnimationPoseCache&& c) noexcept;
+
+    /**
+     * @brief Set the maximum number of poses which can be cached.
+     *
+     * All cached poses are discarded.
+     *
+     * @param maxPoses
+     * The number of poses to reserve memory for.
+     */
+    void set_capacity(const size_t maxPoses) noexcept;
+
+    /**
+     * @brief Retrieve the maximum number of poses which can be cached.
+     *
+     * @return The number of pose slots in *this.
+     */
+    size_t get_capacity() const noexcept;
+
+    /**
+     * @brief Set the number of steps which playback time is quantized to.
+     *
+     * Higher values produce smoother animations but reduce the number of
+     * cache hits. All cached poses are discarded.
+     *
+     * @param numSteps
+     * The number of distinct poses which can be sampled from an animation.
+     */
+    void set_quantization(const unsigned numSteps) noexcept;
+
+    /**
+     * @brief Retrieve the number of steps which playback time is quantized
+     * to.
+     *
+     * @return The number of distinct poses per animation.
+     */
+    unsigned get_quantization() const noexcept;
+
+    /**
+     * @brief Remove all cached poses. Hit and miss counters are kept.
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Animate a scene graph using a cached pose, sampling the pose
+     * first if it is not already cached.
+     *
+     * @param graph
+     * A reference to the scene graph which will be animated.
+     *
+     * @param anim
+     * A constant reference to an Animation within the input scene graph.
+     *
+     * @param percentDone
+     * The percent of the animation which has been played.
+     */
+    void animate(SceneGraph& graph, const Animation& anim, const anim_prec_t percentDone) noexcept;
+
+    /**
+     * @brief Advance a player and animate its scene graph using a cached
+     * pose.
+     *
+     * This is a cached equivalent of "AnimationPlayer::tick(...)".
+     *
+     * @param player
+     * A reference to the player which tracks playback time.
+     *
+     * @param graph
+     * A reference to the scene graph which will be animated.
+     *
+     * @param animationIndex
+     * The index of the Animation within the input scene graph to play.
+     *
+     * @param millis
+     * The number of milliseconds which have passed since the last update.
+     */
+    void tick(AnimationPlayer& player, SceneGraph& graph, const unsigned animationIndex, const uint64_t millis) noexcept;
+
+    /**
+     * @brief Retrieve the number of requests which were found in the cache.
+     *
+     * @return The total number of cache hits.
+     */
+    uint64_t get_num_hits() const noexcept;
+
+    /**
+     * @brief Retrieve the number of requests which required sampling.
+     *
+     * @return The total number of cache misses.
+     */
+    uint64_t get_num_misses() const noexcept;
+
+    /**
+     * @brief Retrieve the ratio of cache hits to total requests.
+     *
+     * @return A value between 0.0 and 1.0.
+     */
+    float get_hit_rate() const noexcept;
+
+    /**
+     * @brief Reset the hit and miss counters to 0.
+     */
+    void reset_counters() noexcept;
+};
+
+
+
+/*-------------------------------------
+ * Pose key comparison
+-------------------------------------*/
+inline bool AnimationPoseKey::operator==(const AnimationPoseKey& k) const noexcept
+{
+    return clipId == k.clipId && frameId == k.frameId;
+}
+
+
+
+/*-------------------------------------
+ * Pose key hashing
+-------------------------------------*/
+inline size_t AnimationPoseKeyHash::operator()(const AnimationPoseKey& k) const noexcept
+{
+    return (size_t)(k.clipId ^ ((uint64_t)k.frameId * 0x9E3779B97F4A7C15ull));
+}
+
+
+
+/*-------------------------------------
+ * Retrieve the cache capacity
+-------------------------------------*/
+inline size_t AnimationPoseCache::get_capacity() const noexcept
+{
+    return poses.size();
+}
+
+
+
+/*-------------------------------------
+ * Retrieve the time quantization
+-------------------------------------*/
+inline unsigned AnimationPoseCache::get_quantization() const noexcept
+{
+    return quantization;
+}
+
+
+
+/*-------------------------------------
+ * Retrieve the hit count
+-------------------------------------*/
+inline uint64_t AnimationPoseCache::get_num_hits() const noexcept
+{
+    return numHits;
+}
+
+
+
+/*-------------------------------------
+ * Retrieve the miss count
+-------------------------------------*/
+inline uint64_t AnimationPoseCache::get_num_misses() const noexcept
+{
+    return numMisses;
+}
+} // end draw namespace
+} // end ls namespace
+
+#endif // __LS_DRAW_ANIMATION_POSE_CACHE_H__
@@ -0,0 +1,332 @@
+
+#ifndef __LS_DRAW_ANIMATION_SCHEDULER_H__
+#define __LS_DRAW_ANIMATION_SCHEDULER_H__
+
+#include <cstdint> // uint64_t
+#include <vector>
+
+#include "lightsky/math/vec3.h"
+
+#include "lightsky/draw/AnimationProperty.h"
+
+
+
+namespace ls
+{
+namespace draw
+{
+
+/*-----------------------------------------------------------------------------
+ * Forward declarations
+-----------------------------------------------------------------------------*/
+class AnimationPlayer;
+class SceneGraph;
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief The animation_lod_t enum determines how often an animation is
+ * evaluated by an AnimationScheduler.
+ *
+ * Each level halves the update rate of the previous one. Culled animations
+ * still have their playback time advanced but never modify a scene graph.
+-----------------------------------------------------------------------------*/
+enum animation_lod_t : unsigned
+{
+    ANIM_LOD_FULL = 0,
+    ANIM_LOD_HALF = 1,
+    ANIM_LOD_QUARTER = 2,
+    ANIM_LOD_CULLED = 3,
+
+    ANIM_LOD_MAX = 4
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief An AnimationSchedulerItem references a single player, the animation
+ * it plays, and the scene node used to determine its level of detail.
+-----------------------------------------------------------------------------*/
+struct AnimationSchedulerItem
+{
+    /**
+     * @brief Non-owning pointer to the player which tracks the playback time
+     * of an animation.
+     */
+    AnimationPlayer* pPlayer;
+
+    /**
+     * @brief Non-owning pointer to the scene graph who's transformations will
+     * be modified by an animation.
+     */
+    SceneGraph* pGraph;
+
+    /**
+     * @brief Index of the Animation to play within "pGraph->animations."
+     */
+    unsigned animationIndex;
+
+    /**
+     * @brief Index of the scene node who's position is used to calculate the
+     * item's distance from the viewer.
+     */
+    size_t nodeId;
+
+    /**
+     * @brief Approximate radius of the animated object. Larger objects keep
+     * higher update rates at further distances.
+     */
+    float radius;
+
+    /**
+     * @brief The current update rate of the item.
+     */
+    animation_lod_t lod;
+
+    /**
+     * @brief Offset added to the frame counter so items within the same LOD
+     * are evaluated on different frames. Phases are assigned sequentially
+     * within each LOD bucket.
+     */
+    unsigned phase;
+
+    /**
+     * @brief Number of milliseconds which have elapsed since the item was
+     * last advanced.
+     */
+    uint64_t pendingMillis;
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief The AnimationScheduler class reduces the update rate of animations
+ * which are far away from the viewer.
+ *
+ * Items are placed into buckets which update every frame, every 2nd frame, or
+ * every 4th frame. Items within a bucket are given staggered phases so the
+ * number of evaluated animations stays roughly constant between frames.
+ * Skipped frames hold the last evaluated pose and the elapsed time is applied
+ * once the item is evaluated again.
+ *
+ * The LOD metric is "distance / radius," which is proportional to the inverse
+ * of an object's projected screen size.
+-----------------------------------------------------------------------------*/
+class AnimationScheduler
+{
+  private:
+    /**
+     * @brief items contains the list of players to evaluate during each call
+     * to "tick(...)".
+     */
+    std::vector<AnimationSchedulerItem> items;
+
+    /**
+     * @brief lodThresholds contains the minimum "distance / radius" ratio
+     * required for an item to use the half, quarter, and culled rates.
+     */
+    float lodThresholds[ANIM_LOD_CULLED];
+
+    /**
+     * @brief lodPhases contains the phase which will be given to the next
+     * item placed into each LOD bucket.
+     */
+    unsigned lodPhases[ANIM_LOD_MAX];
+
+    /**
+     * @brief frameId is incremented once per call to "tick(...)".
+     */
+    unsigned frameId;
+
+    /**
+     * @brief numEvaluated contains the number of animations which modified a
+     * scene graph during the last call to "tick(...)".
+     */
+    unsigned numEvaluated;
+
+  public:
+    /**
+     * @brief Destructor
+     *
+     * Cleans up all memory and resources used.
+     */
+    ~AnimationScheduler() noexcept;
+
+    /**
+     * @brief Constructor
+     *
+     * Initializes all members to their default values.
+     */
+    AnimationScheduler() noexcept;
+
+    /**
+     * @brief Copy Constructor
+     *
+     * Copies all data from the input parameter into *this.
+     *
+     * @param s
+     * A constant reference to another AnimationScheduler object.
+     */
+    AnimationScheduler(const AnimationScheduler& s) noexcept;
+
+    /**
+     * @brief Move Constructor
+     *
+     * Moves all data from the input parameter into *this.
+     *
+     * @param s
+     * An r-value reference to a temporary AnimationScheduler object.
+     */
+    AnimationScheduler(AnimationScheduler&& s) noexcept;
+
+    /**
+     * @brief Copy Operator
+     *
+     * Copies all data from the input parameter into *this.
+     *
+     * @param s
+     * A constant reference to another AnimationScheduler object.
+     *
+     * @return A reference to *this.
+     */
+    AnimationScheduler& operator=(const AnimationScheduler& s) noexcept;
+
+    /**
+     * @brief Move Operator
+     *
+     * Moves all data from the input parameter into *this.
+     *
+     * @param s
+     * An r-value reference to a temporary AnimationScheduler object.
+     *
+     * @return A reference to *this.
+     */
+    AnimationScheduler& operator=(AnimationScheduler&& s) noexcept;
+
+    /**
+     * @brief Set the "distance / radius" ratios at which animations switch to
+     * a lower update rate.
+     *
+     * @param halfRate
+     * The ratio at which items are evaluated every 2nd frame.
+     *
+     * @param quarterRate
+     * The ratio at which items are evaluated every 4th frame.
+     *
+     * @param culled
+     * The ratio at which items are no longer evaluated.
+     */
+    void set_lod_thresholds(const float halfRate, const float quarterRate, const float culled) noexcept;
+
+    /**
+     * @brief Add an animation player to *this scheduler.
+     *
+     * @param player
+     * A reference to the player which tracks playback time. This player must
+     * remain valid until it is removed from *this.
+     *
+     * @param graph
+     * A reference to the scene graph which will be animated. This graph must
+     * remain valid until it is removed from *this.
+     *
+     * @param animationIndex
+     * The index of the Animation within the input scene graph to play.
+     *
+     * @param nodeId
+     * The index of the scene node used to determine the item's LOD.
+     *
+     * @param radius
+     * The approximate radius of the animated object.
+     *
+     * @return The index of the newly added item.
+     */
+    size_t add(
+        AnimationPlayer& player,
+        SceneGraph& graph,
+        const unsigned animationIndex,
+        const size_t nodeId,
+        const float radius = 1.f
+    ) noexcept;
+
+    /**
+     * @brief Remove all items from *this scheduler.
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Retrieve the items contained within *this.
+     *
+     * @return A constant reference to the list of items evaluated by
+     * "tick(...)".
+     */
+    const std::vector<AnimationSchedulerItem>& get_items() const noexcept;
+
+    /**
+     * @brief Manually assign the update rate of an item.
+     *
+     * This can be used when the LOD is determined externally, such as by
+     * occlusion culling. The value is overwritten by the next call to
+     * "update_lods(...)". Items which change buckets are given the next
+     * phase within their new bucket.
+     *
+     * @param itemId
+     * The index of an item returned from "add(...)".
+     *
+     * @param lod
+     * The new update rate of the item.
+     */
+    void set_lod(const size_t itemId, const animation_lod_t lod) noexcept;
+
+    /**
+     * @brief Recalculate the update rate of all items.
+     *
+     * Node positions are read from "SceneGraph::modelMatrices," so this should
+     * be called after "SceneGraph::update()." Phases are reassigned so the
+     * items of each bucket remain evenly spread across frames.
+     *
+     * @param viewPos
+     * The world-space position of the viewer.
+     */
+    void update_lods(const math::vec3& viewPos) noexcept;
+
+    /**
+     * @brief Advance all players in *this and animate the scene graphs of
+     * items which are scheduled for the current frame.
+     *
+     * @param millis
+     * The number of milliseconds which have passed since the last update.
+     */
+    void tick(const uint64_t millis) noexcept;
+
+    /**
+     * @brief Retrieve the number of animations which were evaluated during
+     * the last call to "tick(...)".
+     *
+     * @return The number of items which modified their scene graphs.
+     */
+    unsigned get_num_evaluated() const noexcept;
+};
+
+
+
+/*-------------------------------------
+ * Retrieve the scheduled items
+-------------------------------------*/
+inline const std::vector<AnimationSchedulerItem>& AnimationScheduler::get_items() const noexcept
+{
+    return items;
+}
+
+
+
+/*-------------------------------------
+ * Retrieve the evaluation count
+-------------------------------------*/
+inline unsigned AnimationScheduler::get_num_evaluated() const noexcept
+{
+    return numEvaluated;
+}
+} // end draw namespace
+} // end ls namespace
+
+#endif // __LS_DRAW_ANIMATION_SCHEDULER_H__
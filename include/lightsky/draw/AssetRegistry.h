@@ -0,0 +1,327 @@
+
+#ifndef __LS_DRAW_ASSET_REGISTRY_H__
+#define __LS_DRAW_ASSET_REGISTRY_H__
+
+#include <memory> // std::shared_ptr, std::weak_ptr
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "lightsky/draw/SceneFileCache.h"
+#include "lightsky/draw/TextureAttrib.h"
+
+
+
+namespace ls
+{
+namespace draw
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * Forward Declarations
+-----------------------------------------------------------------------------*/
+class SceneFileLoader;
+class SceneGraph;
+class Texture;
+struct AssetReleaseQueue; // AssetRegistry.cpp
+
+enum common_vertex_t : unsigned; // VertexUtils.h
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief A shared reference to a texture owned by an AssetRegistry.
+ *
+ * Once its last reference is destroyed, the texture is queued for release by
+ * "AssetRegistry::flush_releases()."
+-----------------------------------------------------------------------------*/
+typedef std::shared_ptr<const Texture> TextureAssetHandle;
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief A shared reference to a scene graph owned by an AssetRegistry.
+ *
+ * Once its last reference is destroyed, the scene's GPU data is queued for
+ * release by "AssetRegistry::flush_releases()" and its references to any
+ * shared textures are dropped.
+-----------------------------------------------------------------------------*/
+typedef std::shared_ptr<const SceneGraph> SceneAssetHandle;
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief The AssetRegistry class shares textures and whole scenes between
+ * all loads of the same file.
+ *
+ * Assets are keyed by their file path. Textures are additionally keyed by
+ * their wrap mode and scenes by the packed vertex types they were loaded
+ * with, as each produces a different GPU object. The registry only holds
+ * weak references, so an asset is released once all of its handles have
+ * been destroyed and will be loaded again by the next request.
+ *
+ * Textures uploaded while loading a scene through the registry are moved
+ * into the registry, so any scenes which reference the same image file with
+ * the same wrap mode use a single GPU texture.
+ *
+ * Lookups may be performed from any thread. Loading and inserting assets
+ * must occur on the thread which owns the current OpenGL context. Handles may
+ * be destroyed on any thread; the GPU data of released assets is deleted the
+ * next time "flush_releases()" is called from the OpenGL thread. Handles
+ * which outlive the registry release their GPU data immediately and must be
+ * destroyed on the OpenGL thread.
+-----------------------------------------------------------------------------*/
+class AssetRegistry
+{
+  private:
+    /**
+     * @brief lock guards all registered assets.
+     */
+    mutable std::mutex lock;
+
+    /**
+     * @brief textures maps a file path and wrap mode to a shared texture.
+     */
+    std::unordered_map<std::string, std::weak_ptr<const Texture>> textures;
+
+    /**
+     * @brief scenes maps a file path and vertex format to a shared scene.
+     */
+    std::unordered_map<std::string, std::weak_ptr<const SceneGraph>> scenes;
+
+    /**
+     * @brief releaseQueue contains the GPU data of assets whose last handle
+     * was destroyed. It is shared with every asset so handles may outlive
+     * *this.
+     */
+    std::shared_ptr<AssetReleaseQueue> releaseQueue;
+
+    /**
+     * @brief Generate the key of a texture.
+     *
+     * @param filepath
+     * The path of an image file.
+     *
+     * @param wrapMode
+     * The wrap mode which the texture was uploaded with.
+     *
+     * @return A key which is unique to the file and its wrap mode.
+     */
+    static std::string make_texture_key(const std::string& filepath, const tex_wrap_t wrapMode) noexcept;
+
+    /**
+     * @brief Generate the key of a scene.
+     *
+     * @param filepath
+     * The path of a scene file.
+     *
+     * @param packedVertTypes
+     * The packed vertex types which the scene was loaded with.
+     *
+     * @return A key which is unique to the file and its vertex format.
+     */
+    static std::string make_scene_key(const std::string& filepath, const common_vertex_t packedVertTypes) noexcept;
+
+    /**
+     * @brief Register a texture without locking.
+     *
+     * @param filepath
+     * The path of the image file which the texture was loaded from.
+     *
+     * @param tex
+     * An r-value reference to a texture which has been uploaded to the GPU.
+     * It is terminated if another texture was already registered with the
+     * same path and wrap mode.
+     *
+     * @return A handle to the registered texture.
+     */
+    TextureAssetHandle insert_texture_unlocked(const std::string& filepath, Texture&& tex) noexcept;
+
+  public:
+    /**
+     * @brief Destructor
+     *
+     * Releases all queued GPU data, so this must be called on the OpenGL
+     * thread. Outstanding handles remain valid after the registry is
+     * destroyed.
+     */
+    ~AssetRegistry() noexcept;
+
+    /**
+     * @brief Constructor
+     */
+    AssetRegistry() noexcept;
+
+    /**
+     * @brief Copy Constructor
+     *
+     * Deleted so every shared asset has a single owner.
+     */
+    AssetRegistry(const AssetRegistry&) noexcept = delete;
+
+    /**
+     * @brief Move Constructor
+     *
+     * Deleted as the internal lock can not be moved.
+     */
+    AssetRegistry(AssetRegistry&&) noexcept = delete;
+
+    /**
+     * @brief Copy Operator
+     *
+     * Deleted so every shared asset has a single owner.
+     */
+    AssetRegistry& operator=(const AssetRegistry&) noexcept = delete;
+
+    /**
+     * @brief Move Operator
+     *
+     * Deleted as the internal lock can not be moved.
+     */
+    AssetRegistry& operator=(AssetRegistry&&) noexcept = delete;
+
+    /**
+     * @brief Locate a texture which is still referenced.
+     *
+     * @param filepath
+     * The path of an image file.
+     *
+     * @param wrapMode
+     * The wrap mode which the texture was uploaded with.
+     *
+     * @return A handle to the texture, or an empty handle if the file is not
+     * currently loaded with the requested wrap mode.
+     */
+    TextureAssetHandle find_texture(const std::string& filepath, const tex_wrap_t wrapMode = TEX_WRAP_DEFAULT) const noexcept;
+
+    /**
+     * @brief Retrieve a texture, loading it if no other handles exist.
+     *
+     * @param filepath
+     * The path of an image file.
+     *
+     * @param wrapMode
+     * The wrapping mode of the texture. A texture loaded from the same file
+     * with a different wrap mode is not shared.
+     *
+     * @return A handle to the texture, or an empty handle if the file could
+     * not be loaded.
+     */
+    TextureAssetHandle acquire_texture(const std::string& filepath, const tex_wrap_t wrapMode = TEX_WRAP_DEFAULT) noexcept;
+
+    /**
+     * @brief Register a texture which was uploaded elsewhere.
+     *
+     * @param filepath
+     * The path of the image file which the texture was loaded from.
+     *
+     * @param tex
+     * An r-value reference to a texture which has been uploaded to the GPU.
+     * It is terminated if another texture is already registered with the
+     * same path and wrap mode.
+     *
+     * @return A handle to the registered texture.
+     */
+    TextureAssetHandle insert_texture(const std::string& filepath, Texture&& tex) noexcept;
+
+    /**
+     * @brief Locate a scene which is still referenced.
+     *
+     * @param filepath
+     * The path of a scene file.
+     *
+     * @param packedVertTypes
+     * The packed vertex types which the scene was loaded with.
+     *
+     * @return A handle to the scene, or an empty handle if the file is not
+     * currently loaded.
+     */
+    SceneAssetHandle find_scene(const std::string& filepath, const common_vertex_t packedVertTypes = (common_vertex_t)0) const noexcept;
+
+    /**
+     * @brief Retrieve a scene, loading it if no other handles exist.
+     *
+     * @param filepath
+     * The path of a scene file.
+     *
+     * @param cacheFlags
+     * Determines how binary scene caches are used if the scene needs to be
+     * loaded.
+     *
+     * @param packedVertTypes
+     * A bitmask of PACKED_*_VERTEX flags used if the scene needs to be
+     * loaded.
+     *
+     * @return A handle to the scene, or an empty handle if the file could
+     * not be loaded.
+     */
+    SceneAssetHandle acquire_scene(
+        const std::string& filepath,
+        const scene_cache_mode_t cacheFlags = SCENE_CACHE_READ_WRITE,
+        const common_vertex_t packedVertTypes = (common_vertex_t)0
+    ) noexcept;
+
+    /**
+     * @brief Register a scene which was loaded elsewhere, such as through a
+     * SceneLoadService.
+     *
+     * The loaded scene, and all of its textures, are moved out of the
+     * loader. Textures which are already registered replace the scene's own
+     * copies, which are then released.
+     *
+     * @param filepath
+     * The path of the scene file.
+     *
+     * @param packedVertTypes
+     * The packed vertex types which the scene was loaded with.
+     *
+     * @param loader
+     * A reference to a scene loader which has successfully loaded a file.
+     *
+     * @return A handle to the registered scene. If another scene was already
+     * registered with the same key, it is returned and the loader's scene is
+     * released.
+     */
+    SceneAssetHandle insert_scene(
+        const std::string& filepath,
+        const common_vertex_t packedVertTypes,
+        SceneFileLoader& loader
+    ) noexcept;
+
+    /**
+     * @brief Delete the GPU data of all assets whose last handle has been
+     * destroyed.
+     *
+     * This must be called from the OpenGL thread, typically once per frame.
+     *
+     * @return The number of textures and scenes which were released.
+     */
+    size_t flush_releases() noexcept;
+
+    /**
+     * @brief Remove all entries whose assets have been released.
+     *
+     * @return The number of entries which were removed.
+     */
+    size_t prune() noexcept;
+
+    /**
+     * @brief Retrieve the number of textures which are still referenced.
+     *
+     * @return The number of live textures.
+     */
+    size_t get_num_textures() const noexcept;
+
+    /**
+     * @brief Retrieve the number of scenes which are still referenced.
+     *
+     * @return The number of live scenes.
+     */
+    size_t get_num_scenes() const noexcept;
+};
+} // end draw namespace
+} // end ls namespace
+
+#endif /* __LS_DRAW_ASSET_REGISTRY_H__ */
@@ -0,0 +1,208 @@
+
+#ifndef __LS_DRAW_BUFFER_SUBALLOCATOR_H__
+#define __LS_DRAW_BUFFER_SUBALLOCATOR_H__
+
+#include <cstddef> // size_t
+#include <vector>
+
+
+
+namespace ls
+{
+namespace draw
+{
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief A contiguous range of bytes within a buffer.
+-----------------------------------------------------------------------------*/
+struct BufferRange
+{
+    size_t offset;
+
+    size_t numBytes;
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief The BufferSuballocator class tracks which ranges of a fixed-size GPU
+ * buffer are in use.
+ *
+ * No GPU memory is owned by *this. Free ranges are kept sorted by their
+ * offset and are merged with their neighbors when released, so allocations
+ * are placed into the first range which fits. Alignments do not need to be a
+ * power of two, allowing vertices to be placed at a multiple of their stride.
+-----------------------------------------------------------------------------*/
+class BufferSuballocator
+{
+  private:
+    /**
+     * @brief capacity contains the total number of bytes which can be
+     * allocated.
+     */
+    size_t capacity;
+
+    /**
+     * @brief numBytesUsed contains the number of bytes which have been
+     * allocated, excluding alignment padding.
+     */
+    size_t numBytesUsed;
+
+    /**
+     * @brief freeRanges contains all unused ranges, sorted by offset. No two
+     * ranges are adjacent.
+     */
+    std::vector<BufferRange> freeRanges;
+
+  public:
+    /**
+     * @brief Destructor
+     */
+    ~BufferSuballocator() noexcept;
+
+    /**
+     * @brief Constructor
+     *
+     * Initializes *this with a capacity of zero.
+     */
+    BufferSuballocator() noexcept;
+
+    /**
+     * @brief Copy Constructor
+     *
+     * @param a
+     * A constant reference to another BufferSuballocator object.
+     */
+    BufferSuballocator(const BufferSuballocator& a) noexcept;
+
+    /**
+     * @brief Move Constructor
+     *
+     * @param a
+     * An r-value reference to a temporary BufferSuballocator object.
+     */
+    BufferSuballocator(BufferSuballocator&& a) noexcept;
+
+    /**
+     * @brief Copy Operator
+     *
+     * @param a
+     * A constant reference to another BufferSuballocator object.
+     *
+     * @return A reference to *this.
+     */
+    BufferSuballocator& operator=(const BufferSuballocator& a) noexcept;
+
+    /**
+     * @brief Move Operator
+     *
+     * @param a
+     * An r-value reference to a temporary BufferSuballocator object.
+     *
+     * @return A reference to *this.
+     */
+    BufferSuballocator& operator=(BufferSuballocator&& a) noexcept;
+
+    /**
+     * @brief Release all allocations and set the number of bytes which can
+     * be allocated.
+     *
+     * @param numBytes
+     * The size of the buffer being managed.
+     */
+    void reset(const size_t numBytes) noexcept;
+
+    /**
+     * @brief Allocate a range of bytes.
+     *
+     * @param numBytes
+     * The number of bytes to allocate. This must be greater than zero.
+     *
+     * @param alignment
+     * The returned offset will be a multiple of this value. It does not need
+     * to be a power of two.
+     *
+     * @param outOffset
+     * Contains the offset of the allocated range upon success.
+     *
+     * @return TRUE if a range was allocated, FALSE if no free range was large
+     * enough.
+     */
+    bool allocate(const size_t numBytes, const size_t alignment, size_t& outOffset) noexcept;
+
+    /**
+     * @brief Release a range which was returned from "allocate(...)."
+     *
+     * @param offset
+     * The offset returned from "allocate(...)."
+     *
+     * @param numBytes
+     * The number of bytes which were requested from "allocate(...)."
+     */
+    void free(const size_t offset, const size_t numBytes) noexcept;
+
+    /**
+     * @brief Retrieve the size of the buffer being managed.
+     *
+     * @return The total number of bytes which can be allocated.
+     */
+    size_t get_capacity() const noexcept;
+
+    /**
+     * @brief Retrieve the number of bytes currently allocated.
+     *
+     * @return The sum of all allocation sizes, excluding alignment padding.
+     */
+    size_t get_num_bytes_used() const noexcept;
+
+    /**
+     * @brief Retrieve the size of the largest free range.
+     *
+     * @return The largest allocation which could succeed with an alignment
+     * of 1.
+     */
+    size_t get_largest_free_range() const noexcept;
+
+    /**
+     * @brief Retrieve all unused ranges.
+     *
+     * @return A constant reference to a list of free ranges, sorted by offset.
+     */
+    const std::vector<BufferRange>& get_free_ranges() const noexcept;
+};
+
+
+
+/*-------------------------------------
+ * Retrieve the capacity
+-------------------------------------*/
+inline size_t BufferSuballocator::get_capacity() const noexcept
+{
+    return capacity;
+}
+
+
+
+/*-------------------------------------
+ * Retrieve the number of allocated bytes
+-------------------------------------*/
+inline size_t BufferSuballocator::get_num_bytes_used() const noexcept
+{
+    return numBytesUsed;
+}
+
+
+
+/*-------------------------------------
+ * Retrieve all free ranges
+-------------------------------------*/
+inline const std::vector<BufferRange>& BufferSuballocator::get_free_ranges() const noexcept
+{
+    return freeRanges;
+}
+} // end draw namespace
+} // end ls namespace
+
+#endif /* __LS_DRAW_BUFFER_SUBALLOCATOR_H__ */
@@ -5,12 +5,18 @@
 #include "lightsky/draw/Setup.h"
 
 #include "lightsky/draw/Animation.h"
+#include "lightsky/draw/AnimationBatch.h"
+#include "lightsky/draw/AnimationBlender.h"
 #include "lightsky/draw/AnimationPlayer.h"
+#include "lightsky/draw/AnimationPoseCache.h"
+#include "lightsky/draw/AnimationScheduler.h"
 #include "lightsky/draw/AnimationChannel.h"
+#include "lightsky/draw/AssetRegistry.h"
 #include "lightsky/draw/Atlas.h"
 #include "lightsky/draw/BlendObject.h"
 #include "lightsky/draw/BoundingBox.h"
 #include "lightsky/draw/BufferObject.h"
+#include "lightsky/draw/BufferSuballocator.h"
 #include "lightsky/draw/Camera.h"
 #include "lightsky/draw/Color.h"
 #include "lightsky/draw/DepthObject.h"
@@ -22,21 +28,30 @@
 #include "lightsky/draw/GLContext.h"
 #include "lightsky/draw/GLQuery.h"
 #include "lightsky/draw/GLSLCommon.h"
+#include "lightsky/draw/GeometryPool.h"
 #include "lightsky/draw/GeometryUtils.h"
 #include "lightsky/draw/ImageBuffer.h"
 #include "lightsky/draw/IndexBuffer.h"
 #include "lightsky/draw/SceneMaterial.h"
 #include "lightsky/draw/MatrixStack.h"
+#include "lightsky/draw/MeshCodec.h"
+#include "lightsky/draw/MeshOptimizer.h"
+#include "lightsky/draw/MorphTargetBuffer.h"
 #include "lightsky/draw/OcclusionMeshLoader.h"
 #include "lightsky/draw/PixelBuffer.h"
 #include "lightsky/draw/RBOAssembly.h"
 #include "lightsky/draw/RenderBuffer.h"
 #include "lightsky/draw/RenderValidation.h"
+#include "lightsky/draw/SceneFileCache.h"
 #include "lightsky/draw/SceneFileLoader.h"
 #include "lightsky/draw/SceneGraph.h"
+#include "lightsky/draw/SceneLoadService.h"
 #include "lightsky/draw/SceneMaterial.h"
 #include "lightsky/draw/SceneMesh.h"
+#include "lightsky/draw/SceneMorph.h"
 #include "lightsky/draw/SceneNode.h"
+#include "lightsky/draw/SceneSkin.h"
+#include "lightsky/draw/SceneStreamer.h"
 #include "lightsky/draw/Setup.h"
 #include "lightsky/draw/ShaderAssembly.h"
 #include "lightsky/draw/ShaderAttrib.h"
@@ -45,6 +60,7 @@
 #include "lightsky/draw/ShaderObject.h"
 #include "lightsky/draw/ShaderProgram.h"
 #include "lightsky/draw/ShaderUniform.h"
+#include "lightsky/draw/SkinPalette.h"
 #include "lightsky/draw/TextMeshLoader.h"
 #include "lightsky/draw/Texture.h"
 #include "lightsky/draw/TextureAssembly.h"
@@ -55,9 +71,11 @@
 #include "lightsky/draw/VAOAttrib.h"
 #include "lightsky/draw/VBOAttrib.h"
 #include "lightsky/draw/Vertex.h"
+#include "lightsky/draw/VertexAnimationTexture.h"
 #include "lightsky/draw/VertexArray.h"
 #include "lightsky/draw/VertexBuffer.h"
 #include "lightsky/draw/VertexUtils.h"
+#include "lightsky/draw/WorldPartition.h"
 
 
 
@@ -9,6 +9,15 @@
 
 
 
+/*-----------------------------------------------------------------------------
+ * Base-vertex draw calls require OpenGL 3.2 or OpenGL ES 3.2.
+-----------------------------------------------------------------------------*/
+#if defined(LS_DRAW_BACKEND_GL) || defined(GL_ES_VERSION_3_2)
+    #define LS_DRAW_BASE_VERTEX_SUPPORTED 1
+#endif
+
+
+
 namespace ls
 {
 namespace draw
@@ -103,6 +112,17 @@ struct alignas(8) DrawCommandParams
      */
     uint32_t count;
 
+    /**
+     * @brief Value added to each index before fetching a vertex when
+     * rendering with glDrawElements(). This allows each mesh to store small,
+     * local indices while sharing a VAO with other meshes.
+     *
+     * This is always 0 if LS_DRAW_BASE_VERTEX_SUPPORTED is undefined, or if
+     * a scene was imported without SCENE_IMPORT_BASE_VERTEX. A non-zero
+     * value is only honored by submit_draw_command().
+     */
+    int32_t baseVertex;
+
     /**
      * Destructor
      */
@@ -154,6 +174,24 @@ struct alignas(8) DrawCommandParams
      */
     void reset() noexcept;
 };
+
+
+
+/**------------------------------------
+ * @brief Issue an OpenGL draw call for a set of draw parameters.
+ *
+ * The VAO referenced by the input parameters must already be bound.
+ * glDrawElementsBaseVertex() and its instanced variant are used for any
+ * indexed draws with a non-zero base vertex.
+ *
+ * @param params
+ * The geometry which should be rendered.
+ *
+ * @param numInstances
+ * The number of instances to render. Non-instanced draw calls are used if
+ * this is 1.
+-------------------------------------*/
+void submit_draw_command(const DrawCommandParams& params, const unsigned numInstances = 1) noexcept;
 } // end draw namespace
 } // end ls namespace
 
@@ -72,6 +72,146 @@ float brightness = dot(vertNorm, lightDir);
 return brightness;
 }
 )***";
+
+/*-------------------------------------
+ * Vertex Skinning
+ *
+ * Bone IDs and weights are provided through the LAYOUT_LOC_BONE_ID and
+ * LAYOUT_LOC_BONE_WEIGHT vertex attributes. Palettes are uploaded by the
+ * SkinPalette class and already contain each bone's inverse bind pose.
+-------------------------------------*/
+constexpr char const GLSL_SKIN_PALETTE_BLOCK_NAME[] = "BonePalette";
+
+constexpr char const GLSL_CALC_SKIN_MATRIX[] = u8R"***(
+layout(std140) uniform BonePalette {
+mat4 bones[256];
+};
+mat4 getSkinMatrix(in vec4 boneIds, in vec4 boneWeights) {
+return bones[int(boneIds.x)] * boneWeights.x
+    + bones[int(boneIds.y)] * boneWeights.y
+    + bones[int(boneIds.z)] * boneWeights.z
+    + bones[int(boneIds.w)] * boneWeights.w;
+}
+)***";
+
+/*-------------------------------------
+ * Morph Targets
+ *
+ * Deltas are read from the MorphTargetBuffer's texture using the
+ * "morphDeltas" sampler. gl_VertexID addresses the mesh's VAO, including any
+ * base vertex applied by the draw call (e.g. glDrawElementsBaseVertex()).
+ * The mesh's first vertex, morphInfo.x, is subtracted from gl_VertexID before
+ * indexing the delta texture, so meshes may be drawn with either absolute
+ * indices or base-vertex draws.
+-------------------------------------*/
+constexpr char const GLSL_MORPH_TARGET_BLOCK_NAME[] = "MorphTargets";
+
+constexpr char const GLSL_MORPH_TARGET_SAMPLER_NAME[] = "morphDeltas";
+
+constexpr char const GLSL_APPLY_MORPH_TARGETS[] = u8R"***(
+uniform sampler2D morphDeltas;
+layout(std140) uniform MorphTargets {
+ivec4 morphInfo;
+vec4 morphWeights[16];
+};
+vec4 getMorphTexel(in int index) {
+int w = textureSize(morphDeltas, 0).x;
+return texelFetch(morphDeltas, ivec2(index % w, index / w), 0);
+}
+void applyMorphTargets(inout vec3 pos, inout vec3 norm) {
+int vertId = gl_VertexID - morphInfo.x;
+if (morphInfo.w == 0 || vertId < 0 || vertId >= morphInfo.z) {
+    return;
+}
+vec4 header = getMorphTexel(morphInfo.y + vertId);
+int first = int(header.x);
+int count = int(header.y);
+for (int i = 0; i < count; ++i) {
+    vec4 dPos = getMorphTexel(first + i * 2);
+    int t = int(dPos.w);
+    float weight = morphWeights[t >> 2][t & 3];
+    if (weight != 0.0) {
+        pos += dPos.xyz * weight;
+        norm += getMorphTexel(first + i * 2 + 1).xyz * weight;
+    }
+}
+}
+)***";
+
+/*-------------------------------------
+ * Vertex Animation Textures
+ *
+ * Baked frames are read from a VertexAnimationTexture using the "vatFrames"
+ * sampler. Instance transformations and time offsets are read from
+ * "vatInstances" using gl_InstanceID. As with morph targets, vatInfo.x is
+ * subtracted from gl_VertexID, which includes any base vertex, to locate each
+ * vertex's data.
+-------------------------------------*/
+constexpr char const GLSL_VERTEX_ANIMATION_BLOCK_NAME[] = "VertexAnimation";
+
+constexpr char const GLSL_VERTEX_ANIMATION_FRAME_SAMPLER_NAME[] = "vatFrames";
+
+constexpr char const GLSL_VERTEX_ANIMATION_INSTANCE_SAMPLER_NAME[] = "vatInstances";
+
+constexpr char const GLSL_SAMPLE_VERTEX_ANIMATION[] = u8R"***(
+uniform sampler2D vatFrames;
+uniform sampler2D vatInstances;
+layout(std140) uniform VertexAnimation {
+ivec4 vatInfo;
+vec4 vatTiming;
+};
+vec4 getVatTexel(in sampler2D tex, in int index) {
+int w = textureSize(tex, 0).x;
+return texelFetch(tex, ivec2(index % w, index / w), 0);
+}
+mat4 getVatInstanceMatrix() {
+int i = gl_InstanceID * 4;
+vec4 r0 = getVatTexel(vatInstances, i);
+vec4 r1 = getVatTexel(vatInstances, i + 1);
+vec4 r2 = getVatTexel(vatInstances, i + 2);
+return transpose(mat4(r0, r1, r2, vec4(0.0, 0.0, 0.0, 1.0)));
+}
+void sampleVertexAnimation(out vec3 pos, out vec3 norm) {
+vec4 instTime = getVatTexel(vatInstances, gl_InstanceID * 4 + 3);
+int lastFrame = vatInfo.w - 1;
+float t = fract((vatTiming.x * instTime.y + instTime.x) * vatTiming.y) * float(lastFrame);
+int f0 = int(t);
+int f1 = min(f0 + 1, lastFrame);
+int vertId = gl_VertexID - vatInfo.x;
+int p0 = vatInfo.y + f0 * vatInfo.z * 2 + vertId;
+int p1 = vatInfo.y + f1 * vatInfo.z * 2 + vertId;
+pos = mix(getVatTexel(vatFrames, p0).xyz, getVatTexel(vatFrames, p1).xyz, t - float(f0));
+norm = normalize(mix(getVatTexel(vatFrames, p0 + vatInfo.z).xyz, getVatTexel(vatFrames, p1 + vatInfo.z).xyz, t - float(f0)));
+}
+)***";
+
+/*-------------------------------------
+ * Packed Vertices
+ *
+ * Meshes imported with PACKED_POSITION_VERTEX contain positions relative to
+ * their bounding box. Each mesh's "dequantScale" and "dequantBias" must be
+ * uploaded to the "posDequantScale" and "posDequantBias" uniforms before it
+ * is drawn. Packed normals, tangents, and bitangents are octahedral-encoded.
+ * Both should be decoded before applying skinning or morph targets.
+-------------------------------------*/
+constexpr char const GLSL_DEQUANT_SCALE_UNIFORM_NAME[] = "posDequantScale";
+
+constexpr char const GLSL_DEQUANT_BIAS_UNIFORM_NAME[] = "posDequantBias";
+
+constexpr char const GLSL_DECODE_PACKED_VERTEX[] = u8R"***(
+uniform vec3 posDequantScale;
+uniform vec3 posDequantBias;
+vec3 decodePackedPosition(in vec4 packedPos) {
+return packedPos.xyz * posDequantScale + posDequantBias;
+}
+vec3 decodeOctahedral(in vec2 packedNorm) {
+vec3 n = vec3(packedNorm.xy, 1.0 - abs(packedNorm.x) - abs(packedNorm.y));
+float t = max(-n.z, 0.0);
+n.x += (n.x >= 0.0) ? -t : t;
+n.y += (n.y >= 0.0) ? -t : t;
+return normalize(n);
+}
+)***";
 } // end draw namespace
 } // end ls namespace
 
@@ -0,0 +1,500 @@
+
+#ifndef __LS_DRAW_GEOMETRY_POOL_H__
+#define __LS_DRAW_GEOMETRY_POOL_H__
+
+#include <cstdint>
+#include <vector>
+
+#include "lightsky/draw/BufferSuballocator.h"
+#include "lightsky/draw/DrawParams.h"
+#include "lightsky/draw/IndexBuffer.h"
+#include "lightsky/draw/VertexArray.h"
+#include "lightsky/draw/VertexBuffer.h"
+
+
+
+namespace ls
+{
+namespace draw
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * Forward Declarations
+-----------------------------------------------------------------------------*/
+class SceneGraph;
+
+
+
+/*-----------------------------------------------------------------------------
+ * Enumerations for geometry pools
+-----------------------------------------------------------------------------*/
+enum geometry_pool_property_t : uint32_t
+{
+    GEOMETRY_POOL_INVALID_ID = UINT32_MAX
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief A single vertex layout within a GeometryPool.
+ *
+ * Every allocation with the same vertex types shares one VBO and VAO. The
+ * VAO's attributes begin at the start of the VBO and allocations are
+ * located with a base vertex.
+-----------------------------------------------------------------------------*/
+struct GeometryPoolLayout
+{
+    /**
+     * Vertex types interleaved within the layout's VBO.
+     */
+    common_vertex_t vertTypes;
+
+    /**
+     * Size, in bytes, of a single vertex.
+     */
+    uint32_t vertStride;
+
+    /**
+     * Buffer containing every vertex of the layout.
+     */
+    VertexBuffer vbo;
+
+    /**
+     * Vertex array which references "vbo" and the pool's shared IBO.
+     */
+    VertexArray vao;
+
+    /**
+     * Tracks the used and free ranges of "vbo."
+     */
+    BufferSuballocator allocator;
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief A single allocation within a GeometryPool.
+-----------------------------------------------------------------------------*/
+struct GeometryPoolEntry
+{
+    /**
+     * Index of the layout which contains the allocation's vertices.
+     */
+    uint32_t layoutId;
+
+    /**
+     * Byte range of the allocation's vertices within its layout's VBO.
+     */
+    uint32_t vboOffset;
+
+    uint32_t numVertBytes;
+
+    /**
+     * Byte range of the allocation's indices within the shared IBO.
+     */
+    uint32_t iboOffset;
+
+    uint32_t numIndexBytes;
+
+    /**
+     * Value which was already added to every index before it was placed in
+     * the pool. This is subtracted from the allocation's base vertex.
+     */
+    uint32_t indexBias;
+
+    /**
+     * Parameters to draw the allocation. These are updated whenever the
+     * allocation is moved.
+     */
+    DrawCommandParams drawParams;
+
+    /**
+     * Determines if the entry currently refers to an allocation.
+     */
+    bool isUsed;
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief The GeometryPool class stores the geometry of many meshes, or many
+ * scenes, in a few large GPU buffers.
+ *
+ * One VBO and VAO is created for each vertex layout and all indices are
+ * placed in a single IBO. Buffers are fixed in size and are suballocated
+ * using a free-list, so every mesh which shares a layout can be drawn
+ * without rebinding a VAO or buffer, and with a single multi-draw call.
+ *
+ * Freed ranges are merged with their neighbors, though repeated
+ * allocations of varying sizes will eventually fragment each buffer.
+ * "defragment()" moves allocations towards the front of each buffer on the
+ * GPU. Any draw parameters which were copied from the pool must be updated
+ * after allocations have been moved.
+ *
+ * Pools require base-vertex draws and all functions must be called from the
+ * thread which owns the current OpenGL context.
+-----------------------------------------------------------------------------*/
+class GeometryPool
+{
+  private:
+    /**
+     * @brief vboBytesPerLayout contains the size of each layout's VBO.
+     */
+    uint32_t vboBytesPerLayout;
+
+    /**
+     * @brief ibo contains the indices of every allocation.
+     */
+    IndexBuffer ibo;
+
+    /**
+     * @brief iboAllocator tracks the used and free ranges of "ibo."
+     */
+    BufferSuballocator iboAllocator;
+
+    /**
+     * @brief stagingBuffer is used to move an allocation to a range which
+     * overlaps its current location.
+     */
+    VertexBuffer stagingBuffer;
+
+    /**
+     * @brief stagingBytes contains the size of "stagingBuffer."
+     */
+    uint32_t stagingBytes;
+
+    /**
+     * @brief layouts contains each vertex layout which was requested.
+     */
+    std::vector<GeometryPoolLayout> layouts;
+
+    /**
+     * @brief entries contains all allocations. Entry IDs are stable until
+     * freed.
+     */
+    std::vector<GeometryPoolEntry> entries;
+
+    /**
+     * @brief freeEntries contains the IDs of entries which can be reused.
+     */
+    std::vector<uint32_t> freeEntries;
+
+    /**
+     * @brief Locate or create the layout for a set of vertex types.
+     *
+     * @param vertTypes
+     * The interleaved vertex types of an allocation.
+     *
+     * @return The index of the layout, or GEOMETRY_POOL_INVALID_ID if a new
+     * layout could not be created.
+     */
+    uint32_t find_or_add_layout(const common_vertex_t vertTypes) noexcept;
+
+    /**
+     * @brief Reserve space for vertices and indices.
+     *
+     * @param vertTypes
+     * The interleaved vertex types of the allocation.
+     *
+     * @param numVertBytes
+     * The number of bytes occupied by all vertices.
+     *
+     * @param numIndexBytes
+     * The number of bytes occupied by all indices.
+     *
+     * @param indexType
+     * The data type of each index.
+     *
+     * @return The ID of a new entry, or GEOMETRY_POOL_INVALID_ID if either
+     * buffer did not contain enough contiguous space.
+     */
+    uint32_t reserve_entry(
+        const common_vertex_t vertTypes,
+        const uint32_t numVertBytes,
+        const uint32_t numIndexBytes,
+        const index_element_t indexType
+    ) noexcept;
+
+    /**
+     * @brief Ensure the staging buffer can hold a number of bytes.
+     *
+     * @param numBytes
+     * The size of the largest range which will be moved.
+     *
+     * @return TRUE if the staging buffer is large enough, FALSE if it could
+     * not be allocated.
+     */
+    bool reserve_staging(const uint32_t numBytes) noexcept;
+
+    /**
+     * @brief Copy a range of a buffer to a different location within the
+     * same buffer.
+     *
+     * Overlapping ranges are copied through the staging buffer, which must
+     * have been reserved beforehand.
+     *
+     * @param buffer
+     * The GPU buffer containing the data to move.
+     *
+     * @param srcOffset
+     * The current byte offset of the data.
+     *
+     * @param dstOffset
+     * The new byte offset of the data.
+     *
+     * @param numBytes
+     * The number of bytes to move.
+     */
+    void move_range(const BufferObject& buffer, const uint32_t srcOffset, const uint32_t dstOffset, const uint32_t numBytes) noexcept;
+
+    /**
+     * @brief Synchronize an entry's draw parameters with its location.
+     *
+     * @param entry
+     * A reference to an allocated entry.
+     */
+    void update_draw_params(GeometryPoolEntry& entry) noexcept;
+
+  public:
+    /**
+     * @brief Destructor
+     *
+     * Releases all GPU buffers.
+     */
+    ~GeometryPool() noexcept;
+
+    /**
+     * @brief Constructor
+     *
+     * No GPU memory is allocated until "init(...)" is called.
+     */
+    GeometryPool() noexcept;
+
+    /**
+     * @brief Copy Constructor
+     *
+     * Deleted so every pooled buffer has a single owner.
+     */
+    GeometryPool(const GeometryPool&) noexcept = delete;
+
+    /**
+     * @brief Move Constructor
+     *
+     * @param p
+     * An r-value reference to a temporary GeometryPool object.
+     */
+    GeometryPool(GeometryPool&& p) noexcept;
+
+    /**
+     * @brief Copy Operator
+     *
+     * Deleted so every pooled buffer has a single owner.
+     */
+    GeometryPool& operator=(const GeometryPool&) noexcept = delete;
+
+    /**
+     * @brief Move Operator
+     *
+     * @param p
+     * An r-value reference to a temporary GeometryPool object.
+     *
+     * @return A reference to *this.
+     */
+    GeometryPool& operator=(GeometryPool&& p) noexcept;
+
+    /**
+     * @brief Allocate the shared IBO.
+     *
+     * @param vboBytes
+     * The size of each VBO, which is allocated the first time a vertex
+     * layout is requested.
+     *
+     * @param iboBytes
+     * The size of the shared IBO.
+     *
+     * @return TRUE if the pool was initialized, FALSE if not.
+     */
+    bool init(const uint32_t vboBytes, const uint32_t iboBytes) noexcept;
+
+    /**
+     * @brief Release all GPU buffers and invalidate every allocation.
+     */
+    void terminate() noexcept;
+
+    /**
+     * @brief Upload a block of geometry into the pool.
+     *
+     * @param vertTypes
+     * The interleaved vertex types of "pVerts."
+     *
+     * @param numVerts
+     * The number of vertices to upload.
+     *
+     * @param pVerts
+     * A pointer to all vertices.
+     *
+     * @param indexType
+     * The data type of each index.
+     *
+     * @param numIndices
+     * The number of indices to upload.
+     *
+     * @param pIndices
+     * A pointer to all indices. Indices should begin at 0 for the first
+     * vertex in "pVerts."
+     *
+     * @param drawMode
+     * The primitive type which the indices describe.
+     *
+     * @return The ID of the allocation, or GEOMETRY_POOL_INVALID_ID if the
+     * pool did not contain enough contiguous space.
+     */
+    uint32_t allocate(
+        const common_vertex_t vertTypes,
+        const uint32_t numVerts,
+        const void* const pVerts,
+        const index_element_t indexType,
+        const uint32_t numIndices,
+        const void* const pIndices,
+        const draw_mode_t drawMode = draw_mode_t::DRAW_MODE_TRIS
+    ) noexcept;
+
+    /**
+     * @brief Release an allocation.
+     *
+     * @param entryId
+     * An ID returned from "allocate(...)" or "import_scene(...)."
+     */
+    void free(const uint32_t entryId) noexcept;
+
+    /**
+     * @brief Move all meshes of a scene into the pool.
+     *
+     * Each mesh is copied on the GPU into its layout's VBO and the shared
+     * IBO. The draw parameters of every mesh and mesh node are then pointed
+     * at the pool and the scene's own VBOs, IBOs, and VAOs are released.
+     *
+     * Only scenes whose meshes are stored in a single VBO and IBO, such as
+     * those produced by SceneFileLoader, can be imported.
+     *
+     * @param scene
+     * A reference to a scene which has been uploaded to the GPU.
+     *
+     * @param outEntryIds
+     * Contains one allocation ID per mesh, in the same order as
+     * "scene.meshes," upon success.
+     *
+     * @return TRUE if every mesh was moved into the pool, FALSE if not. The
+     * scene is not modified on failure.
+     */
+    bool import_scene(SceneGraph& scene, std::vector<uint32_t>& outEntryIds) noexcept;
+
+    /**
+     * @brief Copy the current draw parameters of each pooled mesh into a
+     * scene.
+     *
+     * This must be called on every imported scene after allocations have
+     * been moved by "defragment()."
+     *
+     * @param scene
+     * A reference to a scene which was imported into *this.
+     *
+     * @param entryIds
+     * The allocation IDs returned by "import_scene(...)."
+     */
+    void update_scene(SceneGraph& scene, const std::vector<uint32_t>& entryIds) const noexcept;
+
+    /**
+     * @brief Compact allocations towards the beginning of each buffer.
+     *
+     * Allocations are processed in order of their offset and are each moved
+     * into the first free range which fits, so free space is merged at the
+     * end of each buffer.
+     *
+     * @param maxBytes
+     * The maximum number of bytes to move before returning. A value of 0
+     * will compact every buffer completely.
+     *
+     * @return The number of bytes which were moved. Draw parameters copied
+     * from the pool are invalid if this is greater than 0.
+     */
+    uint64_t defragment(const uint64_t maxBytes = 0) noexcept;
+
+    /**
+     * @brief Retrieve the draw parameters of an allocation.
+     *
+     * @param entryId
+     * An ID returned from "allocate(...)" or "import_scene(...)."
+     *
+     * @return A constant reference to the draw parameters of an allocation.
+     */
+    const DrawCommandParams& get_draw_params(const uint32_t entryId) const noexcept;
+
+    /**
+     * @brief Retrieve all vertex layouts.
+     *
+     * @return A constant reference to the list of layouts, each of which
+     * contains a VAO shared by all of its allocations.
+     */
+    const std::vector<GeometryPoolLayout>& get_layouts() const noexcept;
+
+    /**
+     * @brief Retrieve the shared IBO.
+     *
+     * @return A constant reference to the pool's index buffer.
+     */
+    const IndexBuffer& get_index_buffer() const noexcept;
+
+    /**
+     * @brief Retrieve the number of index bytes which are in use.
+     *
+     * @return The sum of all index allocations.
+     */
+    size_t get_num_index_bytes_used() const noexcept;
+};
+
+
+
+/*-------------------------------------
+ * Retrieve an allocation's draw parameters
+-------------------------------------*/
+inline const DrawCommandParams& GeometryPool::get_draw_params(const uint32_t entryId) const noexcept
+{
+    return entries[entryId].drawParams;
+}
+
+
+
+/*-------------------------------------
+ * Retrieve all layouts
+-------------------------------------*/
+inline const std::vector<GeometryPoolLayout>& GeometryPool::get_layouts() const noexcept
+{
+    return layouts;
+}
+
+
+
+/*-------------------------------------
+ * Retrieve the shared IBO
+-------------------------------------*/
+inline const IndexBuffer& GeometryPool::get_index_buffer() const noexcept
+{
+    return ibo;
+}
+
+
+
+/*-------------------------------------
+ * Retrieve the number of used index bytes
+-------------------------------------*/
+inline size_t GeometryPool::get_num_index_bytes_used() const noexcept
+{
+    return iboAllocator.get_num_bytes_used();
+}
+} // end draw namespace
+} // end ls namespace
+
+#endif /* __LS_DRAW_GEOMETRY_POOL_H__ */
@@ -0,0 +1,164 @@
+
+#ifndef __LS_DRAW_MESH_CODEC_H__
+#define __LS_DRAW_MESH_CODEC_H__
+
+#include <cstddef> // size_t
+#include <cstdint> // uint32_t
+#include <vector>
+
+
+
+namespace ls
+{
+namespace draw
+{
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief Mesh codec identifiers and limits.
+-----------------------------------------------------------------------------*/
+enum mesh_codec_t : uint32_t
+{
+    /**
+     * Interleaved vertices are split into one plane per byte of each vertex.
+     * Each plane is delta-encoded between consecutive vertices before being
+     * entropy-coded.
+     */
+    MESH_CODEC_VERTICES = 0,
+
+    /**
+     * Indices are delta-encoded against the previous index, zigzag-encoded,
+     * then written as variable-length integers before being entropy-coded.
+     */
+    MESH_CODEC_INDICES = 1,
+
+    /**
+     * Maximum number of vertices or indices which should be encoded within a
+     * single block. Smaller blocks can be decoded in parallel but compress
+     * slightly worse. This is a multiple of 3 so triangles are never split.
+     */
+    MESH_CODEC_BLOCK_ELEMENTS = 98304
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief Encode a block of interleaved vertices.
+ *
+ * @param pVertices
+ * A pointer to the first byte of the first vertex.
+ *
+ * @param numVertices
+ * The number of vertices to encode.
+ *
+ * @param vertStride
+ * The number of bytes within each vertex.
+ *
+ * @param outEncoded
+ * The encoded block is appended to this buffer.
+-----------------------------------------------------------------------------*/
+void encode_mesh_vertices(
+    const char* const pVertices,
+    const uint32_t numVertices,
+    const uint32_t vertStride,
+    std::vector<char>& outEncoded
+) noexcept;
+
+/**----------------------------------------------------------------------------
+ * @brief Decode a block of vertices generated by "encode_mesh_vertices(...)."
+ *
+ * Only the output buffer is written to, and only sequentially, so it may be
+ * mapped GPU memory.
+ *
+ * @param pEncoded
+ * A pointer to the encoded block.
+ *
+ * @param numEncodedBytes
+ * The size of the encoded block, in bytes.
+ *
+ * @param pOutVertices
+ * A pointer to a buffer which can hold "numVertices * vertStride" bytes.
+ *
+ * @param numVertices
+ * The number of vertices which were encoded.
+ *
+ * @param vertStride
+ * The number of bytes within each vertex.
+ *
+ * @param scratch
+ * Temporary memory used while decoding. This can be reused between calls to
+ * avoid repeated allocations.
+ *
+ * @return TRUE if the block was decoded, FALSE if it was corrupt.
+-----------------------------------------------------------------------------*/
+bool decode_mesh_vertices(
+    const char* const pEncoded,
+    const size_t numEncodedBytes,
+    char* const pOutVertices,
+    const uint32_t numVertices,
+    const uint32_t vertStride,
+    std::vector<char>& scratch
+) noexcept;
+
+/**----------------------------------------------------------------------------
+ * @brief Encode a block of indices.
+ *
+ * @param pIndices
+ * A pointer to the first index.
+ *
+ * @param numIndices
+ * The number of indices to encode.
+ *
+ * @param indexBytes
+ * The size of each index. This must be 1, 2, or 4.
+ *
+ * @param outEncoded
+ * The encoded block is appended to this buffer.
+-----------------------------------------------------------------------------*/
+void encode_mesh_indices(
+    const char* const pIndices,
+    const uint32_t numIndices,
+    const uint32_t indexBytes,
+    std::vector<char>& outEncoded
+) noexcept;
+
+/**----------------------------------------------------------------------------
+ * @brief Decode a block of indices generated by "encode_mesh_indices(...)."
+ *
+ * Only the output buffer is written to, and only sequentially, so it may be
+ * mapped GPU memory.
+ *
+ * @param pEncoded
+ * A pointer to the encoded block.
+ *
+ * @param numEncodedBytes
+ * The size of the encoded block, in bytes.
+ *
+ * @param pOutIndices
+ * A pointer to a buffer which can hold "numIndices * indexBytes" bytes.
+ *
+ * @param numIndices
+ * The number of indices which were encoded.
+ *
+ * @param indexBytes
+ * The size of each index. This must be 1, 2, or 4.
+ *
+ * @param scratch
+ * Temporary memory used while decoding. This can be reused between calls to
+ * avoid repeated allocations.
+ *
+ * @return TRUE if the block was decoded, FALSE if it was corrupt.
+-----------------------------------------------------------------------------*/
+bool decode_mesh_indices(
+    const char* const pEncoded,
+    const size_t numEncodedBytes,
+    char* const pOutIndices,
+    const uint32_t numIndices,
+    const uint32_t indexBytes,
+    std::vector<char>& scratch
+) noexcept;
+} // end draw namespace
+} // end ls namespace
+
+#endif /* __LS_DRAW_MESH_CODEC_H__ */
@@ -0,0 +1,313 @@
+
+#ifndef __LS_DRAW_MESH_OPTIMIZER_H__
+#define __LS_DRAW_MESH_OPTIMIZER_H__
+
+#include <cstddef> // size_t
+#include <cstdint> // uint32_t
+#include <vector>
+
+
+
+namespace ls
+{
+namespace draw
+{
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief Mesh optimizer defaults.
+-----------------------------------------------------------------------------*/
+enum mesh_optimizer_property_t : unsigned
+{
+    /**
+     * Number of entries within the simulated post-transform vertex cache.
+     * This is a conservative estimate of most mobile and desktop GPUs.
+     */
+    MESH_OPTIMIZER_CACHE_SIZE = 16
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief Initial value of all mesh hashes (the 64-bit FNV offset basis).
+-----------------------------------------------------------------------------*/
+constexpr uint64_t MESH_OPTIMIZER_HASH_SEED = 0xCBF29CE484222325ull;
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief Vertex cache metrics of a single mesh, before and after being
+ * optimized.
+ *
+ * ACMR (average cache miss ratio) is the number of vertices transformed per
+ * triangle, within the range [0.5, 3]. ATVR (average transform to vertex
+ * ratio) is the number of vertices transformed per unique vertex, where 1 is
+ * optimal.
+-----------------------------------------------------------------------------*/
+struct MeshOptimizerStats
+{
+    uint32_t numVertices;
+
+    uint32_t numTriangles;
+
+    float acmrBefore;
+
+    float acmrAfter;
+
+    float atvrBefore;
+
+    float atvrAfter;
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief Count the number of vertices a FIFO post-transform cache would need
+ * to transform in order to render a list of triangles.
+ *
+ * @param pIndices
+ * A pointer to an array of triangle indices.
+ *
+ * @param numIndices
+ * The number of indices within "pIndices." This must be a multiple of 3.
+ *
+ * @param numVertices
+ * The number of vertices referenced by "pIndices."
+ *
+ * @param cacheSize
+ * The number of vertices within the simulated cache.
+ *
+ * @return The total number of cache misses.
+-----------------------------------------------------------------------------*/
+size_t calc_vertex_cache_misses(
+    const uint32_t* const pIndices,
+    const size_t numIndices,
+    const uint32_t numVertices,
+    const unsigned cacheSize = MESH_OPTIMIZER_CACHE_SIZE
+) noexcept;
+
+/**----------------------------------------------------------------------------
+ * @brief Reorder triangles to improve post-transform vertex cache usage.
+ *
+ * This implements "Tipsify" from Sander, Nehab, and Barczak, "Fast Triangle
+ * Reordering for Vertex Locality and Reduced Overdraw." It runs in linear
+ * time and produces clusters of triangles which can be reordered by
+ * "optimize_overdraw(...)" without losing cache efficiency.
+ *
+ * @param pIndices
+ * A pointer to an array of triangle indices which will be reordered.
+ *
+ * @param numIndices
+ * The number of indices within "pIndices." This must be a multiple of 3.
+ *
+ * @param numVertices
+ * The number of vertices referenced by "pIndices."
+ *
+ * @param outClusters
+ * Contains the index of the first triangle within each cluster upon return.
+ *
+ * @param cacheSize
+ * The number of vertices within the targeted cache.
+-----------------------------------------------------------------------------*/
+void optimize_vertex_cache(
+    uint32_t* const pIndices,
+    const size_t numIndices,
+    const uint32_t numVertices,
+    std::vector<uint32_t>& outClusters,
+    const unsigned cacheSize = MESH_OPTIMIZER_CACHE_SIZE
+) noexcept;
+
+/**----------------------------------------------------------------------------
+ * @brief Sort clusters of triangles so outward-facing surfaces are rendered
+ * first, reducing overdraw from most viewpoints.
+ *
+ * Each input cluster is further split wherever its local ACMR falls below
+ * "threshold" times the ACMR of the entire mesh, so the vertex cache
+ * efficiency of the input order is mostly preserved.
+ *
+ * @param pIndices
+ * A pointer to an array of triangle indices which will be reordered.
+ *
+ * @param numIndices
+ * The number of indices within "pIndices." This must be a multiple of 3.
+ *
+ * @param pPositions
+ * A pointer to the first float of the first vertex position. Each position
+ * must contain 3 contiguous floats.
+ *
+ * @param positionStride
+ * The number of bytes between consecutive vertex positions.
+ *
+ * @param numVertices
+ * The number of vertices referenced by "pIndices."
+ *
+ * @param hardClusters
+ * The index of the first triangle within each cluster, as generated by
+ * "optimize_vertex_cache(...)."
+ *
+ * @param threshold
+ * The maximum ACMR of any cluster, relative to the ACMR of the entire mesh.
+ *
+ * @param cacheSize
+ * The number of vertices within the targeted cache.
+-----------------------------------------------------------------------------*/
+void optimize_overdraw(
+    uint32_t* const pIndices,
+    const size_t numIndices,
+    const float* const pPositions,
+    const size_t positionStride,
+    const uint32_t numVertices,
+    const std::vector<uint32_t>& hardClusters,
+    const float threshold = 1.05f,
+    const unsigned cacheSize = MESH_OPTIMIZER_CACHE_SIZE
+) noexcept;
+
+/**----------------------------------------------------------------------------
+ * @brief Generate a remapping table which places vertices in the order they
+ * are first referenced, then update all indices to match.
+ *
+ * @param pIndices
+ * A pointer to an array of indices which will be remapped.
+ *
+ * @param numIndices
+ * The number of indices within "pIndices."
+ *
+ * @param numVertices
+ * The number of vertices referenced by "pIndices."
+ *
+ * @param outRemap
+ * Contains the new location of each vertex upon return. Unreferenced
+ * vertices are placed at the end of the table, in their original order.
+-----------------------------------------------------------------------------*/
+void optimize_vertex_fetch(
+    uint32_t* const pIndices,
+    const size_t numIndices,
+    const uint32_t numVertices,
+    std::vector<uint32_t>& outRemap
+) noexcept;
+
+/**----------------------------------------------------------------------------
+ * @brief Copy a buffer of interleaved vertices into the order given by a
+ * table generated by "optimize_vertex_fetch(...)."
+ *
+ * Only the output buffer is written to, so it may be mapped GPU memory.
+ *
+ * @param pInVertices
+ * A pointer to the vertices in their original order.
+ *
+ * @param pOutVertices
+ * A pointer to the buffer which will contain the reordered vertices. This
+ * must not overlap the input buffer.
+ *
+ * @param vertStride
+ * The number of bytes within each vertex.
+ *
+ * @param remap
+ * The new location of each vertex.
+-----------------------------------------------------------------------------*/
+void remap_vertices(
+    const char* const pInVertices,
+    char* const pOutVertices,
+    const unsigned vertStride,
+    const std::vector<uint32_t>& remap
+) noexcept;
+
+/**----------------------------------------------------------------------------
+ * @brief Generate a remapping table which merges all vertices containing
+ * identical bytes.
+ *
+ * Vertices are compared using a hash table, so welding runs in linear time.
+ * Unique vertices keep their relative order, so the remapped location of a
+ * vertex is never greater than its original location and vertex data can
+ * be compacted in-place.
+ *
+ * @param pVertices
+ * A pointer to a buffer of interleaved vertices.
+ *
+ * @param vertStride
+ * The number of bytes within each vertex.
+ *
+ * @param numVertices
+ * The number of vertices within "pVertices."
+ *
+ * @param outRemap
+ * Contains the new location of each vertex upon return. Duplicate vertices
+ * share the location of their first occurrence.
+ *
+ * @return The number of unique vertices.
+-----------------------------------------------------------------------------*/
+uint32_t weld_vertices(
+    const char* const pVertices,
+    const unsigned vertStride,
+    const uint32_t numVertices,
+    std::vector<uint32_t>& outRemap
+) noexcept;
+
+/**----------------------------------------------------------------------------
+ * @brief Hash a block of mesh data.
+ *
+ * Hashes may be chained across several blocks by passing the result of one
+ * call as the seed of the next.
+ *
+ * @param pData
+ * A pointer to the data which will be hashed.
+ *
+ * @param numBytes
+ * The number of bytes within "pData."
+ *
+ * @param seed
+ * The initial hash value.
+ *
+ * @return A 64-bit FNV-1a hash of the input data.
+-----------------------------------------------------------------------------*/
+uint64_t hash_mesh_data(
+    const void* const pData,
+    const size_t numBytes,
+    const uint64_t seed = MESH_OPTIMIZER_HASH_SEED
+) noexcept;
+
+/**----------------------------------------------------------------------------
+ * @brief Run all optimization stages on a triangle mesh.
+ *
+ * @param pIndices
+ * A pointer to an array of triangle indices which will be reordered.
+ *
+ * @param numIndices
+ * The number of indices within "pIndices." This must be a multiple of 3.
+ *
+ * @param pPositions
+ * A pointer to the first float of the first vertex position.
+ *
+ * @param positionStride
+ * The number of bytes between consecutive vertex positions.
+ *
+ * @param numVertices
+ * The number of vertices referenced by "pIndices."
+ *
+ * @param outRemap
+ * Contains the new location of each vertex upon return, or is left empty if
+ * "remapVertices" is FALSE. Vertex data must be reordered using
+ * "remap_vertices(...)" to match the returned indices.
+ *
+ * @param remapVertices
+ * Determines if vertices should be reordered for fetch locality. This should
+ * be disabled if other data, such as morph targets, references vertices by
+ * their original index.
+ *
+ * @return The vertex cache metrics of the mesh before and after being
+ * optimized.
+-----------------------------------------------------------------------------*/
+MeshOptimizerStats optimize_mesh(
+    uint32_t* const pIndices,
+    const size_t numIndices,
+    const float* const pPositions,
+    const size_t positionStride,
+    const uint32_t numVertices,
+    std::vector<uint32_t>& outRemap,
+    const bool remapVertices = true
+) noexcept;
+} // end draw namespace
+} // end ls namespace
+
+#endif /* __LS_DRAW_MESH_OPTIMIZER_H__ */
@@ -0,0 +1,216 @@
+
+#ifndef __LS_DRAW_MORPH_TARGET_BUFFER_H__
+#define __LS_DRAW_MORPH_TARGET_BUFFER_H__
+
+#include <vector>
+
+#include "lightsky/draw/Texture.h"
+#include "lightsky/draw/UniformBuffer.h"
+
+
+
+namespace ls
+{
+namespace draw
+{
+
+/*-----------------------------------------------------------------------------
+ * Forward declarations
+-----------------------------------------------------------------------------*/
+class SceneGraph;
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief The MorphTargetBuffer class uploads the sparse morph targets of all
+ * meshes in a scene graph to the GPU so they can be evaluated in a vertex
+ * shader.
+ *
+ * Morph deltas are static and placed into a single RGBA32F texture. Each
+ * morphed mesh contains one header texel per vertex, (firstDelta, numDeltas),
+ * followed by two texels per delta, (position.xyz, targetId) and
+ * (normal.xyz, 0).
+ *
+ * Only target weights change at runtime. These are stored within a small
+ * uniform block per mesh which can be bound using "bind_mesh(...)":
+ *
+ *      layout(std140) uniform MorphTargets
+ *      {
+ *          ivec4 morphInfo; // baseVertex, firstHeader, numVerts, numActive
+ *          vec4 morphWeights[16];
+ *      };
+-----------------------------------------------------------------------------*/
+class MorphTargetBuffer
+{
+  private:
+    /**
+     * @brief blockStride contains the number of bytes between each mesh's
+     * uniform block, including padding for the UBO offset alignment.
+     */
+    size_t blockStride;
+
+    /**
+     * @brief headerOffsets contains the index of the first header texel of
+     * each mesh within the delta texture.
+     */
+    std::vector<unsigned> headerOffsets;
+
+    /**
+     * @brief uniformData contains the CPU copy of all uniform blocks, placed
+     * contiguously in the same layout as the GPU buffer.
+     */
+    std::vector<char> uniformData;
+
+    /**
+     * @brief deltaTex contains all morph deltas on the GPU.
+     */
+    Texture deltaTex;
+
+    /**
+     * @brief ubo contains the target weights of all meshes on the GPU.
+     */
+    UniformBuffer ubo;
+
+  public:
+    /**
+     * @brief Destructor
+     *
+     * Releases all CPU and GPU resources used by *this.
+     */
+    ~MorphTargetBuffer() noexcept;
+
+    /**
+     * @brief Constructor
+     *
+     * Initializes all members to their default values. No GPU data is
+     * allocated until "init(...)" is called.
+     */
+    MorphTargetBuffer() noexcept;
+
+    /**
+     * @brief Copy Constructor
+     *
+     * Copies all CPU-side data from the input parameter into *this. No GPU
+     * data is copied.
+     *
+     * @param m
+     * A constant reference to another MorphTargetBuffer object.
+     */
+    MorphTargetBuffer(const MorphTargetBuffer& m) noexcept;
+
+    /**
+     * @brief Move Constructor
+     *
+     * Moves all data from the input parameter into *this.
+     *
+     * @param m
+     * An r-value reference to a temporary MorphTargetBuffer object.
+     */
+    MorphTargetBuffer(MorphTargetBuffer&& m) noexcept;
+
+    /**
+     * @brief Copy Operator
+     *
+     * Copies all CPU-side data from the input parameter into *this. No GPU
+     * data is copied.
+     *
+     * @param m
+     * A constant reference to another MorphTargetBuffer object.
+     *
+     * @return A reference to *this.
+     */
+    MorphTargetBuffer& operator=(const MorphTargetBuffer& m) noexcept;
+
+    /**
+     * @brief Move Operator
+     *
+     * Moves all data from the input parameter into *this.
+     *
+     * @param m
+     * An r-value reference to a temporary MorphTargetBuffer object.
+     *
+     * @return A reference to *this.
+     */
+    MorphTargetBuffer& operator=(MorphTargetBuffer&& m) noexcept;
+
+    /**
+     * @brief Upload the morph deltas of all meshes in a scene graph and
+     * allocate their uniform blocks.
+     *
+     * @param graph
+     * A constant reference to the scene graph containing morphed meshes.
+     *
+     * @return TRUE if all memory was successfully allocated, FALSE if not.
+     */
+    bool init(const SceneGraph& graph) noexcept;
+
+    /**
+     * @brief Release all CPU and GPU memory used by *this.
+     */
+    void terminate() noexcept;
+
+    /**
+     * @brief Send the current morph target weights of all meshes to the GPU.
+     *
+     * This should be called once per frame, after animations have been
+     * applied. Targets with a weight of zero are skipped by the vertex shader
+     * and meshes without active targets skip morphing entirely.
+     *
+     * @param graph
+     * A constant reference to the scene graph which was used to initialize
+     * *this.
+     */
+    void update(const SceneGraph& graph) noexcept;
+
+    /**
+     * @brief Bind the uniform block of a single mesh.
+     *
+     * Meshes without morph targets contain a valid block which disables
+     * morphing, allowing the same shader to be used for all meshes.
+     *
+     * @param meshId
+     * The index of a mesh within "SceneGraph::meshes."
+     *
+     * @param bindingIndex
+     * The uniform block binding point which a shader's morph targets use.
+     */
+    void bind_mesh(const size_t meshId, const unsigned bindingIndex) const noexcept;
+
+    /**
+     * @brief Retrieve the texture which contains all morph deltas.
+     *
+     * @return A constant reference to the delta texture used by *this.
+     */
+    const Texture& get_texture() const noexcept;
+
+    /**
+     * @brief Retrieve the uniform buffer which contains all target weights.
+     *
+     * @return A constant reference to the uniform buffer used by *this.
+     */
+    const UniformBuffer& get_buffer() const noexcept;
+};
+
+
+
+/*-------------------------------------
+ * Retrieve the delta texture
+-------------------------------------*/
+inline const Texture& MorphTargetBuffer::get_texture() const noexcept
+{
+    return deltaTex;
+}
+
+
+
+/*-------------------------------------
+ * Retrieve the uniform buffer
+-------------------------------------*/
+inline const UniformBuffer& MorphTargetBuffer::get_buffer() const noexcept
+{
+    return ubo;
+}
+} // end draw namespace
+} // end ls namespace
+
+#endif /* __LS_DRAW_MORPH_TARGET_BUFFER_H__ */
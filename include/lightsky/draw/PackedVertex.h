@@ -2,8 +2,14 @@
 #ifndef __LS_DRAW_PACKED_VERTEX_H__
 #define __LS_DRAW_PACKED_VERTEX_H__
 
+#include <cmath> // std::fabs, std::floor, std::sqrt
+#include <cstdint>
+#include <cstring> // std::memcpy
+
 #include "lightsky/utils/Endian.h"
 
+#include "lightsky/math/Math.h"
+
 
 
 namespace ls
@@ -160,6 +166,291 @@ inline int32_t pack_vertex_normal(const math::vec3& norm) noexcept
     // undefined behavior FTW.
     return (int32_t)pn;
 }
+
+
+
+/**------------------------------------
+ * @brief Convert a packed vertex normal, created with
+ * "pack_vertex_normal(...)", back into a 3-dimensional vector.
+ *
+ * @param packedNorm
+ * A signed 32-bit integer containing a packed vertex normal.
+ *
+ * @return A 3-dimensional vector with components in the range of [-1, 1].
+ * The result may need to be re-normalized.
+-------------------------------------*/
+inline math::vec3 unpack_vertex_normal(const int32_t packedNorm) noexcept
+{
+    const PackedVertex& pn = *reinterpret_cast<const PackedVertex*>(&packedNorm);
+
+    return math::vec3{
+        (float)pn.x * (1.f / 511.f),
+        (float)pn.y * (1.f / 511.f),
+        (float)pn.z * (1.f / 511.f)
+    };
+}
+
+
+
+/**------------------------------------
+ * @brief Convert a 32-bit float into a 16-bit half-float, following the
+ * VERTEX_DATA_HALF_FLOAT format.
+ *
+ * Values are rounded to the nearest representable half-float. Values which
+ * are too large become infinite and NaNs remain NaN.
+ *
+ * @param f
+ * A single-precision floating point number.
+ *
+ * @return The bits of a half-precision float.
+-------------------------------------*/
+inline uint16_t pack_vertex_half(const float f) noexcept
+{
+    constexpr uint32_t f32Infinity = 255u << 23;
+    constexpr uint32_t f16Overflow = (127u + 16u) << 23;
+    constexpr uint32_t f16MinNormal = 113u << 23;
+    constexpr uint32_t denormMagicBits = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+
+    uint32_t bits;
+    std::memcpy(&bits, &f, sizeof(float));
+
+    const uint32_t sign = bits & 0x80000000u;
+    bits ^= sign;
+
+    uint32_t half;
+
+    if (bits >= f16Overflow)
+    {
+        half = (bits > f32Infinity) ? 0x7E00u : 0x7C00u;
+    }
+    else if (bits < f16MinNormal)
+    {
+        // Let the FPU round subnormals by aligning them to a magic number.
+        float denormMagic, absVal;
+        std::memcpy(&denormMagic, &denormMagicBits, sizeof(float));
+        std::memcpy(&absVal, &bits, sizeof(float));
+
+        absVal += denormMagic;
+        std::memcpy(&half, &absVal, sizeof(float));
+        half -= denormMagicBits;
+    }
+    else
+    {
+        // Re-bias the exponent, then round to nearest-even.
+        const uint32_t mantissaOdd = (bits >> 13) & 1u;
+        bits += ((uint32_t)(15 - 127) << 23) + 0x0FFFu + mantissaOdd;
+        half = bits >> 13;
+    }
+
+    return (uint16_t)(half | (sign >> 16));
+}
+
+
+
+/**------------------------------------
+ * @brief Convert a 16-bit half-float, created with "pack_vertex_half(...)",
+ * back into a 32-bit float.
+ *
+ * @param h
+ * The bits of a half-precision float.
+ *
+ * @return A single-precision floating point number.
+-------------------------------------*/
+inline float unpack_vertex_half(const uint16_t h) noexcept
+{
+    constexpr uint32_t shiftedExp = 0x7C00u << 13;
+    constexpr uint32_t denormMagicBits = 113u << 23;
+
+    uint32_t bits = ((uint32_t)h & 0x7FFFu) << 13;
+    const uint32_t exponent = bits & shiftedExp;
+    float ret;
+
+    bits += (127u - 15u) << 23;
+
+    if (exponent == shiftedExp)
+    {
+        // infinity & NaN
+        bits += (128u - 16u) << 23;
+        std::memcpy(&ret, &bits, sizeof(float));
+    }
+    else if (exponent == 0)
+    {
+        // subnormals
+        float denormMagic;
+        std::memcpy(&denormMagic, &denormMagicBits, sizeof(float));
+
+        bits += 1u << 23;
+        std::memcpy(&ret, &bits, sizeof(float));
+        ret -= denormMagic;
+    }
+    else
+    {
+        std::memcpy(&ret, &bits, sizeof(float));
+    }
+
+    return ((h & 0x8000u) != 0) ? -ret : ret;
+}
+
+
+
+/**------------------------------------
+ * @brief Encode a unit vector using an octahedral mapping, following the
+ * VERTEX_DATA_VEC_2SN format.
+ *
+ * The vector is projected onto an octahedron, whose lower half is folded
+ * over its upper half, then stored as two normalized 16-bit integers.
+ *
+ * @param norm
+ * A constant reference to a normalized vector.
+ *
+ * @return Two signed 16-bit integers containing the octahedral coordinates
+ * of the input vector.
+-------------------------------------*/
+inline math::vec2_t<int16_t> pack_vertex_octahedral(const math::vec3& norm) noexcept
+{
+    const float l1Norm = std::fabs(norm[0]) + std::fabs(norm[1]) + std::fabs(norm[2]);
+
+    if (l1Norm <= 0.f)
+    {
+        return math::vec2_t<int16_t>{0, 0};
+    }
+
+    float x = norm[0] / l1Norm;
+    float y = norm[1] / l1Norm;
+
+    if (norm[2] < 0.f)
+    {
+        const float foldX = (1.f - std::fabs(y)) * (x >= 0.f ? 1.f : -1.f);
+        const float foldY = (1.f - std::fabs(x)) * (y >= 0.f ? 1.f : -1.f);
+        x = foldX;
+        y = foldY;
+    }
+
+    return math::vec2_t<int16_t>{
+        (int16_t)std::floor(x * 32767.f + 0.5f),
+        (int16_t)std::floor(y * 32767.f + 0.5f)
+    };
+}
+
+
+
+/**------------------------------------
+ * @brief Decode a unit vector created with "pack_vertex_octahedral(...)".
+ *
+ * @param packedNorm
+ * Two signed 16-bit integers containing octahedral coordinates.
+ *
+ * @return A normalized 3-dimensional vector.
+-------------------------------------*/
+inline math::vec3 unpack_vertex_octahedral(const math::vec2_t<int16_t>& packedNorm) noexcept
+{
+    float x = (float)packedNorm[0] * (1.f / 32767.f);
+    float y = (float)packedNorm[1] * (1.f / 32767.f);
+    const float z = 1.f - std::fabs(x) - std::fabs(y);
+    const float t = z < 0.f ? -z : 0.f;
+
+    x += (x >= 0.f) ? -t : t;
+    y += (y >= 0.f) ? -t : t;
+
+    const float invLen = 1.f / std::sqrt(x*x + y*y + z*z);
+
+    return math::vec3{x * invLen, y * invLen, z * invLen};
+}
+
+
+
+/**------------------------------------
+ * @brief Quantize a vertex position into four normalized 16-bit integers,
+ * following the VERTEX_DATA_VEC_4USN format.
+ *
+ * @param pos
+ * A constant reference to the vertex position.
+ *
+ * @param bias
+ * The minimum extent of the mesh containing the input vertex.
+ *
+ * @param invScale
+ * The reciprocal of the size of the mesh containing the input vertex. Axes of
+ * zero size should use a value of 0.
+ *
+ * @return Four unsigned 16-bit integers. The W component is always 65535 so
+ * the result can be dequantized with a single matrix transformation.
+-------------------------------------*/
+inline math::vec4_t<uint16_t> pack_vertex_position(const math::vec3& pos, const math::vec3& bias, const math::vec3& invScale) noexcept
+{
+    uint16_t outPos[3];
+
+    for (unsigned i = 0; i < 3; ++i)
+    {
+        const float t = (pos[i] - bias[i]) * invScale[i];
+        const float clamped = t < 0.f ? 0.f : (t > 1.f ? 1.f : t);
+        outPos[i] = (uint16_t)(clamped * 65535.f + 0.5f);
+    }
+
+    return math::vec4_t<uint16_t>{outPos[0], outPos[1], outPos[2], (uint16_t)65535};
+}
+
+
+
+/**------------------------------------
+ * @brief Convert a floating-point color into four normalized bytes,
+ * following the VERTEX_DATA_VEC_4UBN format.
+ *
+ * @param color
+ * A constant reference to a color with components within the range [0, 1].
+ * Components outside of this range are clamped.
+ *
+ * @return Four unsigned bytes containing the input color.
+-------------------------------------*/
+inline math::vec4_t<uint8_t> pack_vertex_color(const math::vec4& color) noexcept
+{
+    uint8_t outColor[4];
+
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        const float c = color[i] < 0.f ? 0.f : (color[i] > 1.f ? 1.f : color[i]);
+        outColor[i] = (uint8_t)(c * 255.f + 0.5f);
+    }
+
+    return math::vec4_t<uint8_t>{outColor[0], outColor[1], outColor[2], outColor[3]};
+}
+
+
+
+/**------------------------------------
+ * @brief Quantize the bone weights of a single vertex into four normalized
+ * bytes, following the VERTEX_DATA_VEC_4UBN format.
+ *
+ * @param weights
+ * A constant reference to the weight of each bone influencing a vertex. The
+ * weights do not need to be normalized.
+ *
+ * @return Four unsigned bytes which sum to exactly 255, or all zeroes if the
+ * input weights sum to 0. Rounding errors are applied to the largest weight.
+-------------------------------------*/
+inline math::vec4_t<uint8_t> pack_vertex_bone_weights(const math::vec4& weights) noexcept
+{
+    const float totalWeight = weights[0] + weights[1] + weights[2] + weights[3];
+    uint8_t outWeights[4] = {0, 0, 0, 0};
+
+    if (totalWeight > 0.f)
+    {
+        const float scale = 255.f / totalWeight;
+        unsigned maxSlot = 0;
+        int quantizedSum = 0;
+
+        for (unsigned slot = 0; slot < 4; ++slot)
+        {
+            outWeights[slot] = (uint8_t)(weights[slot] * scale + 0.5f);
+            quantizedSum += outWeights[slot];
+            maxSlot = (weights[slot] > weights[maxSlot]) ? slot : maxSlot;
+        }
+
+        outWeights[maxSlot] = (uint8_t)((int)outWeights[maxSlot] + (255 - quantizedSum));
+    }
+
+    return math::vec4_t<uint8_t>{outWeights[0], outWeights[1], outWeights[2], outWeights[3]};
+}
 } // end draw namespace
 } // end ls namespace
 
@@ -0,0 +1,277 @@
+
+#ifndef __LS_DRAW_SCENE_ARENA_H__
+#define __LS_DRAW_SCENE_ARENA_H__
+
+#include <cstddef> // size_t, std::max_align_t
+#include <new> // placement new
+#include <type_traits> // std::is_trivially_destructible
+#include <vector>
+
+#include "lightsky/utils/Pointer.h"
+
+
+
+namespace ls
+{
+namespace draw
+{
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief The SceneArena class is a monotonic allocator for temporary data
+ * used while loading a scene.
+ *
+ * Memory is handed out from large blocks by advancing an offset and is never
+ * released individually. Resetting an arena rewinds all blocks at once, and
+ * merges them into a single block so later loads of a similar size require
+ * only one allocation.
+ *
+ * Destructors are never run on memory returned from an arena, so only
+ * trivially destructible types may be allocated. An arena is not
+ * thread-safe.
+-----------------------------------------------------------------------------*/
+class SceneArena
+{
+  public:
+    enum : size_t
+    {
+        DEFAULT_BLOCK_SIZE = 64 * 1024
+    };
+
+  private:
+    /**
+     * @brief A single allocation from which data is sub-allocated.
+     */
+    struct ArenaBlock
+    {
+        utils::Pointer<char[]> pData;
+
+        size_t capacity;
+
+        size_t numBytesUsed;
+    };
+
+    /**
+     * @brief minBlockSize contains the smallest size of any block allocated
+     * by *this.
+     */
+    size_t minBlockSize;
+
+    /**
+     * @brief currentBlock contains the index of the block which is currently
+     * allocated from. All blocks before it are full.
+     */
+    size_t currentBlock;
+
+    /**
+     * @brief blocks contains all memory owned by *this.
+     */
+    std::vector<ArenaBlock> blocks;
+
+    /**
+     * @brief Add a block to the end of the block list.
+     *
+     * @param numBytes
+     * The minimum size of the new block.
+     *
+     * @return TRUE if the block was allocated, FALSE if not.
+     */
+    bool add_block(const size_t numBytes) noexcept;
+
+  public:
+    /**
+     * @brief Destructor
+     *
+     * Frees all blocks.
+     */
+    ~SceneArena() noexcept;
+
+    /**
+     * @brief Constructor
+     *
+     * No memory is allocated until the first call to "allocate(...)."
+     *
+     * @param blockSize
+     * The smallest size of each block allocated by *this.
+     */
+    SceneArena(const size_t blockSize = DEFAULT_BLOCK_SIZE) noexcept;
+
+    /**
+     * @brief Copy Constructor
+     *
+     * Deleted as memory returned from an arena cannot be duplicated.
+     */
+    SceneArena(const SceneArena&) noexcept = delete;
+
+    /**
+     * @brief Move Constructor
+     *
+     * @param a
+     * An r-value reference to a temporary SceneArena object. All pointers
+     * returned from the input parameter remain valid.
+     */
+    SceneArena(SceneArena&& a) noexcept;
+
+    /**
+     * @brief Copy Operator
+     *
+     * Deleted as memory returned from an arena cannot be duplicated.
+     */
+    SceneArena& operator=(const SceneArena&) noexcept = delete;
+
+    /**
+     * @brief Move Operator
+     *
+     * @param a
+     * An r-value reference to a temporary SceneArena object. All pointers
+     * returned from the input parameter remain valid.
+     *
+     * @return A reference to *this.
+     */
+    SceneArena& operator=(SceneArena&& a) noexcept;
+
+    /**
+     * @brief Allocate a range of uninitialized memory.
+     *
+     * @param numBytes
+     * The number of bytes to allocate.
+     *
+     * @param alignment
+     * The required alignment of the returned pointer. This must be a power
+     * of two no greater than alignof(std::max_align_t).
+     *
+     * @return A pointer to the allocated memory, or NULL if a new block could
+     * not be allocated. This remains valid until *this is reset or cleared.
+     */
+    void* allocate(const size_t numBytes, const size_t alignment = alignof(std::max_align_t)) noexcept;
+
+    /**
+     * @brief Allocate and value-initialize an array.
+     *
+     * @param count
+     * The number of elements to allocate.
+     *
+     * @return A pointer to the first element of the array, or NULL if the
+     * array could not be allocated.
+     */
+    template <typename data_t>
+    data_t* allocate_array(const size_t count) noexcept;
+
+    /**
+     * @brief Allocate an array and copy an existing range of elements into
+     * it.
+     *
+     * @param pData
+     * A pointer to the elements to copy.
+     *
+     * @param count
+     * The number of elements to copy.
+     *
+     * @return A pointer to the first element of the copied array, or NULL if
+     * the array could not be allocated.
+     */
+    template <typename data_t>
+    data_t* copy_array(const data_t* pData, const size_t count) noexcept;
+
+    /**
+     * @brief Invalidate all allocations while keeping the memory owned by
+     * *this.
+     *
+     * If more than one block was used, all blocks are replaced with a single
+     * block of their combined size.
+     */
+    void reset() noexcept;
+
+    /**
+     * @brief Invalidate all allocations and free all memory owned by *this.
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Retrieve the number of blocks owned by *this.
+     *
+     * @return The number of allocations made from the system heap which are
+     * currently held by *this.
+     */
+    size_t get_num_blocks() const noexcept;
+
+    /**
+     * @brief Retrieve the total size of all blocks owned by *this.
+     *
+     * @return The number of bytes which *this can allocate before requiring
+     * a new block.
+     */
+    size_t get_capacity() const noexcept;
+
+    /**
+     * @brief Retrieve the number of bytes allocated since *this was last
+     * reset, including alignment padding.
+     *
+     * @return The number of bytes in use within all blocks.
+     */
+    size_t get_num_bytes_used() const noexcept;
+};
+
+
+
+/*-------------------------------------
+ * Allocate an array
+-------------------------------------*/
+template <typename data_t>
+data_t* SceneArena::allocate_array(const size_t count) noexcept
+{
+    static_assert(std::is_trivially_destructible<data_t>::value, "Arena allocations are never destroyed.");
+
+    data_t* const pData = static_cast<data_t*>(allocate(sizeof(data_t) * count, alignof(data_t)));
+
+    if (pData)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            new(pData + i) data_t{};
+        }
+    }
+
+    return pData;
+}
+
+
+
+/*-------------------------------------
+ * Copy an array
+-------------------------------------*/
+template <typename data_t>
+data_t* SceneArena::copy_array(const data_t* pData, const size_t count) noexcept
+{
+    static_assert(std::is_trivially_destructible<data_t>::value, "Arena allocations are never destroyed.");
+
+    data_t* const pOutData = static_cast<data_t*>(allocate(sizeof(data_t) * count, alignof(data_t)));
+
+    if (pOutData)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            new(pOutData + i) data_t{pData[i]};
+        }
+    }
+
+    return pOutData;
+}
+
+
+
+/*-------------------------------------
+ * Get the number of blocks
+-------------------------------------*/
+inline size_t SceneArena::get_num_blocks() const noexcept
+{
+    return blocks.size();
+}
+
+
+
+} // end draw namespace
+} // end ls namespace
+
+#endif /* __LS_DRAW_SCENE_ARENA_H__ */
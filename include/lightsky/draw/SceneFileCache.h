@@ -0,0 +1,874 @@
+
+#ifndef __LS_DRAW_SCENE_FILE_CACHE_H__
+#define __LS_DRAW_SCENE_FILE_CACHE_H__
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "lightsky/utils/Copy.h"
+
+
+
+namespace ls
+{
+namespace draw
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * Forward Declarations
+-----------------------------------------------------------------------------*/
+enum common_vertex_t : unsigned; // VertexUtils.h
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief Determines how a SceneFilePreLoader should use binary scene caches.
+ *
+ * SCENE_CACHE_COMPRESS encodes the vertex and index payloads of newly written
+ * caches using the MeshCodec. Compressed caches are decoded in parallel while
+ * being uploaded, trading CPU time for less disk I/O. Caches of either type
+ * can be read regardless of this flag.
+-----------------------------------------------------------------------------*/
+enum scene_cache_mode_t : unsigned
+{
+    SCENE_CACHE_DISABLED = 0x00,
+    SCENE_CACHE_READ = 0x01,
+    SCENE_CACHE_WRITE = 0x02,
+    SCENE_CACHE_READ_WRITE = 0x03,
+    SCENE_CACHE_COMPRESS = 0x04,
+    SCENE_CACHE_READ_WRITE_COMPRESSED = 0x07
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief Binary scene cache identifiers and limits.
+ *
+ * SCENE_CACHE_VERSION must be incremented whenever the layout of a cache file,
+ * or any structure written into one, changes.
+-----------------------------------------------------------------------------*/
+enum scene_cache_property_t : uint32_t
+{
+    SCENE_CACHE_MAGIC = 0x4353534C, // "LSSC"
+    SCENE_CACHE_VERSION = 6,
+    SCENE_CACHE_ENDIAN_CHECK = 0x01020304,
+    SCENE_CACHE_PAYLOAD_ALIGNMENT = 64
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief Encodings of the vertex and index payloads within a cache.
+-----------------------------------------------------------------------------*/
+enum scene_cache_payload_t : uint32_t
+{
+    SCENE_CACHE_PAYLOAD_RAW = 0,
+    SCENE_CACHE_PAYLOAD_ENCODED = 1
+};
+
+
+
+/*-------------------------------------
+ * File extension appended to a scene file's path to locate its cache.
+-------------------------------------*/
+constexpr char SCENE_CACHE_FILE_EXTENSION[] = ".lscache";
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief The SceneCacheHeader is placed at the start of every binary scene
+ * cache. It is used to reject caches written by a different version of this
+ * library, a different architecture, or for an outdated source file.
+ *
+ * If "payloadEncoding" is SCENE_CACHE_PAYLOAD_ENCODED, the VBO and IBO ranges
+ * contain blocks described by a list of SceneCachePayloadBlocks rather than
+ * the buffers themselves.
+-----------------------------------------------------------------------------*/
+struct SceneCacheHeader
+{
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint32_t endianCheck = 0;
+    uint32_t pointerBytes = 0;
+    uint32_t payloadEncoding = SCENE_CACHE_PAYLOAD_RAW;
+    uint32_t padding = 0;
+    uint64_t sourceBytes = 0;
+    int64_t sourceTime = 0;
+    uint64_t vboOffset = 0;
+    uint64_t vboBytes = 0;
+    uint64_t iboOffset = 0;
+    uint64_t iboBytes = 0;
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief A SceneCachePayloadBlock describes a range of a VBO or IBO which was
+ * compressed independently of all others.
+ *
+ * Blocks never span multiple meshes so each can be decoded on its own
+ * thread. Encoded offsets are relative to the start of the cache's vertex or
+ * index payload, depending on the codec.
+-----------------------------------------------------------------------------*/
+struct SceneCachePayloadBlock
+{
+    uint64_t rawOffset;
+    uint64_t encodedOffset;
+    uint32_t rawBytes;
+    uint32_t encodedBytes;
+    uint32_t codec; // mesh_codec_t
+    uint32_t elementBytes; // vertex stride or index size
+};
+
+
+
+/**------------------------------------
+ * @brief Retrieve the path of the cache file used for a scene file.
+ *
+ * Each combination of vertex packing and index layout uses its own cache so
+ * loaders which request different settings for the same file do not
+ * overwrite each other's caches.
+ *
+ * @param sourcePath
+ * The path to a 3D scene file.
+ *
+ * @param packedVertTypes
+ * The PACKED_*_VERTEX flags used by the cached scene.
+ *
+ * @param baseVertexDraws
+ * TRUE if the cached scene stores indices relative to each mesh.
+ *
+ * @return The path to the scene file's binary cache.
+-------------------------------------*/
+std::string get_scene_cache_path(
+    const std::string& sourcePath,
+    const common_vertex_t packedVertTypes = (common_vertex_t)0,
+    const bool baseVertexDraws = false
+) noexcept;
+
+
+
+/**------------------------------------
+ * @brief Retrieve the size and modification time of a file on disk.
+ *
+ * @param path
+ * The path to a file.
+ *
+ * @param outBytes
+ * Will contain the size of the file, in bytes.
+ *
+ * @param outTime
+ * Will contain the last modification time of the file, using the finest
+ * resolution available (nanoseconds on POSIX systems, 100-nanosecond
+ * intervals on Windows).
+ *
+ * @return TRUE if the file exists and its statistics were retrieved, FALSE
+ * if not.
+-------------------------------------*/
+bool get_scene_file_stats(const std::string& path, uint64_t& outBytes, int64_t& outTime) noexcept;
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief The SceneFileCache class provides a read-only, memory-mapped view of
+ * a binary scene cache.
+ *
+ * Mapping the file allows the vertex and index payloads to be passed
+ * directly to OpenGL without an intermediate copy or parsing step. Other
+ * binary files, such as glTF buffers, may be mapped in the same manner.
+-----------------------------------------------------------------------------*/
+class SceneFileCache
+{
+  private:
+    /**
+     * @brief pData points to the first byte of the mapped file.
+     */
+    const char* pData;
+
+    /**
+     * @brief numBytes contains the size of the mapped file.
+     */
+    size_t numBytes;
+
+    /**
+     * @brief fileHandle contains the OS handle (or descriptor) of the open
+     * file.
+     */
+    intptr_t fileHandle;
+
+    /**
+     * @brief mapHandle contains the OS handle of the file mapping. This is
+     * only used on Windows.
+     */
+    intptr_t mapHandle;
+
+  public:
+    /**
+     * @brief Destructor
+     *
+     * Unmaps and closes the currently open file.
+     */
+    ~SceneFileCache() noexcept;
+
+    /**
+     * @brief Constructor
+     *
+     * Initializes all members to their default values. No file is opened.
+     */
+    SceneFileCache() noexcept;
+
+    /**
+     * @brief Copy Constructor
+     *
+     * Deleted as file mappings cannot be shared.
+     */
+    SceneFileCache(const SceneFileCache&) noexcept = delete;
+
+    /**
+     * @brief Move Constructor
+     *
+     * Moves the file mapping from the input parameter into *this.
+     *
+     * @param c
+     * An r-value reference to a temporary SceneFileCache object.
+     */
+    SceneFileCache(SceneFileCache&& c) noexcept;
+
+    /**
+     * @brief Copy Operator
+     *
+     * Deleted as file mappings cannot be shared.
+     */
+    SceneFileCache& operator=(const SceneFileCache&) noexcept = delete;
+
+    /**
+     * @brief Move Operator
+     *
+     * Moves the file mapping from the input parameter into *this.
+     *
+     * @param c
+     * An r-value reference to a temporary SceneFileCache object.
+     *
+     * @return A reference to *this.
+     */
+    SceneFileCache& operator=(SceneFileCache&& c) noexcept;
+
+    /**
+     * @brief Map a cache file into memory.
+     *
+     * Any non-empty file can be mapped. Use validate() to determine if the
+     * file contains a scene cache.
+     *
+     * @param path
+     * The path to a binary scene cache.
+     *
+     * @return TRUE if the file was opened and mapped, FALSE if not.
+     */
+    bool open(const std::string& path) noexcept;
+
+    /**
+     * @brief Unmap and close the currently open file.
+     */
+    void close() noexcept;
+
+    /**
+     * @brief Determine if a file is currently mapped.
+     *
+     * @return TRUE if *this contains a mapped file, FALSE if not.
+     */
+    bool is_open() const noexcept;
+
+    /**
+     * @brief Verify the header of the mapped file.
+     *
+     * @param sourcePath
+     * The path to the scene file which the cache was generated from. The
+     * cache is rejected if the file's size or modification time has changed.
+     *
+     * @return TRUE if the cache can be loaded, FALSE if not.
+     */
+    bool validate(const std::string& sourcePath) const noexcept;
+
+    /**
+     * @brief Retrieve the header of the mapped file.
+     *
+     * @return A constant reference to the cache file's header. This is only
+     * valid after "validate(...)" returns TRUE.
+     */
+    const SceneCacheHeader& get_header() const noexcept;
+
+    /**
+     * @brief Retrieve the mapped file data.
+     *
+     * @return A pointer to the first byte of the mapped file.
+     */
+    const char* get_data() const noexcept;
+
+    /**
+     * @brief Retrieve the size of the mapped file.
+     *
+     * @return The number of bytes contained within the mapped file.
+     */
+    size_t get_size() const noexcept;
+};
+
+
+
+/*-------------------------------------
+ * Check if a file is mapped
+-------------------------------------*/
+inline bool SceneFileCache::is_open() const noexcept
+{
+    return pData != nullptr;
+}
+
+
+
+/*-------------------------------------
+ * Retrieve the file header
+-------------------------------------*/
+inline const SceneCacheHeader& SceneFileCache::get_header() const noexcept
+{
+    return *reinterpret_cast<const SceneCacheHeader*>(pData);
+}
+
+
+
+/*-------------------------------------
+ * Retrieve the mapped data
+-------------------------------------*/
+inline const char* SceneFileCache::get_data() const noexcept
+{
+    return pData;
+}
+
+
+
+/*-------------------------------------
+ * Retrieve the mapped size
+-------------------------------------*/
+inline size_t SceneFileCache::get_size() const noexcept
+{
+    return numBytes;
+}
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief The SceneCacheWriter sequentially writes plain data into a binary
+ * scene cache.
+ *
+ * All types written must be trivially copyable. Arrays and strings are
+ * prefixed with a 64-bit element count.
+ *
+ * Data is written into a temporary file which only replaces the cache once
+ * "commit()" is called. Other threads or processes which are reading, or
+ * have mapped, the previous cache are never exposed to partial writes.
+-----------------------------------------------------------------------------*/
+class SceneCacheWriter
+{
+  private:
+    /**
+     * @brief fout contains the temporary file being written.
+     */
+    std::ofstream fout;
+
+    /**
+     * @brief outPath contains the path of the cache which is replaced once
+     * all data has been committed.
+     */
+    std::string outPath;
+
+    /**
+     * @brief tempPath contains the path of the file being written.
+     */
+    std::string tempPath;
+
+  public:
+    /**
+     * @brief Destructor
+     *
+     * Closes the current file, discarding any uncommitted data.
+     */
+    ~SceneCacheWriter() noexcept;
+
+    /**
+     * @brief Constructor
+     */
+    SceneCacheWriter() noexcept;
+
+    /**
+     * @brief Copy Constructor
+     *
+     * Deleted.
+     */
+    SceneCacheWriter(const SceneCacheWriter&) noexcept = delete;
+
+    /**
+     * @brief Move Constructor
+     *
+     * Deleted.
+     */
+    SceneCacheWriter(SceneCacheWriter&&) noexcept = delete;
+
+    /**
+     * @brief Copy Operator
+     *
+     * Deleted.
+     */
+    SceneCacheWriter& operator=(const SceneCacheWriter&) noexcept = delete;
+
+    /**
+     * @brief Move Operator
+     *
+     * Deleted.
+     */
+    SceneCacheWriter& operator=(SceneCacheWriter&&) noexcept = delete;
+
+    /**
+     * @brief Create a temporary file for writing.
+     *
+     * @param path
+     * The path to the output file. It remains untouched until "commit()" is
+     * called.
+     *
+     * @return TRUE if the file was opened, FALSE if not.
+     */
+    bool open(const std::string& path) noexcept;
+
+    /**
+     * @brief Flush and close the temporary file, then move it over the
+     * output file.
+     *
+     * @return TRUE if all writes succeeded and the output file was replaced,
+     * FALSE if not. The temporary file is removed on failure.
+     */
+    bool commit() noexcept;
+
+    /**
+     * @brief Close the current file and discard any uncommitted data.
+     */
+    void close() noexcept;
+
+    /**
+     * @brief Determine if all writes have succeeded.
+     *
+     * @return TRUE if the file is open and no errors have occurred, FALSE if
+     * not.
+     */
+    bool is_valid() const noexcept;
+
+    /**
+     * @brief Retrieve the current write position.
+     *
+     * @return The number of bytes from the start of the file where the next
+     * write will occur.
+     */
+    uint64_t get_offset() noexcept;
+
+    /**
+     * @brief Move the write position.
+     *
+     * @param offset
+     * The number of bytes from the start of the file to write at.
+     */
+    void seek(const uint64_t offset) noexcept;
+
+    /**
+     * @brief Write zeroes until the current position is a multiple of the
+     * input alignment.
+     *
+     * @param alignment
+     * A power-of-two byte alignment.
+     */
+    void pad_to(const uint64_t alignment) noexcept;
+
+    /**
+     * @brief Write raw bytes.
+     *
+     * @param pBytes
+     * A pointer to the data to write.
+     *
+     * @param count
+     * The number of bytes to write.
+     */
+    void write_bytes(const void* const pBytes, const size_t count) noexcept;
+
+    /**
+     * @brief Write a single plain-data object.
+     *
+     * @param data
+     * A constant reference to the object to write.
+     */
+    template <typename data_t>
+    void write(const data_t& data) noexcept;
+
+    /**
+     * @brief Write an array of plain-data objects, prefixed with its size.
+     *
+     * @param pData
+     * A pointer to an array of objects.
+     *
+     * @param count
+     * The number of elements in the array.
+     */
+    template <typename data_t>
+    void write_array(const data_t* const pData, const size_t count) noexcept;
+
+    /**
+     * @brief Write a vector of plain-data objects, prefixed with its size.
+     *
+     * @param data
+     * A constant reference to the vector to write.
+     */
+    template <typename data_t>
+    void write_vector(const std::vector<data_t>& data) noexcept;
+
+    /**
+     * @brief Write a string, prefixed with its length.
+     *
+     * @param str
+     * A constant reference to the string to write.
+     */
+    void write_string(const std::string& str) noexcept;
+};
+
+
+
+/*-------------------------------------
+ * Write a single object
+-------------------------------------*/
+template <typename data_t>
+inline void SceneCacheWriter::write(const data_t& data) noexcept
+{
+    write_bytes(&data, sizeof(data_t));
+}
+
+
+
+/*-------------------------------------
+ * Write an array
+-------------------------------------*/
+template <typename data_t>
+inline void SceneCacheWriter::write_array(const data_t* const pData, const size_t count) noexcept
+{
+    write<uint64_t>((uint64_t)count);
+    write_bytes(pData, sizeof(data_t) * count);
+}
+
+
+
+/*-------------------------------------
+ * Write a vector
+-------------------------------------*/
+template <typename data_t>
+inline void SceneCacheWriter::write_vector(const std::vector<data_t>& data) noexcept
+{
+    write_array<data_t>(data.data(), data.size());
+}
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief The SceneCacheReader sequentially reads plain data from a binary
+ * scene cache which has been mapped into memory.
+ *
+ * All reads are bounds-checked. Once a read fails, all subsequent reads will
+ * fail and "is_valid()" will return FALSE.
+-----------------------------------------------------------------------------*/
+class SceneCacheReader
+{
+  private:
+    /**
+     * @brief pData points to the first byte of the data being read.
+     */
+    const char* pData;
+
+    /**
+     * @brief numBytes contains the total number of readable bytes.
+     */
+    size_t numBytes;
+
+    /**
+     * @brief offset contains the position of the next read.
+     */
+    size_t offset;
+
+    /**
+     * @brief valid determines if any reads have failed.
+     */
+    bool valid;
+
+  public:
+    /**
+     * @brief Destructor
+     */
+    ~SceneCacheReader() noexcept;
+
+    /**
+     * @brief Constructor
+     *
+     * @param pBytes
+     * A pointer to the data to read.
+     *
+     * @param byteCount
+     * The number of readable bytes.
+     *
+     * @param startOffset
+     * The offset, from pBytes, to begin reading at.
+     */
+    SceneCacheReader(const char* const pBytes, const size_t byteCount, const size_t startOffset = 0) noexcept;
+
+    /**
+     * @brief Copy Constructor
+     *
+     * Copies the read position of the input parameter into *this.
+     *
+     * @param r
+     * A constant reference to another SceneCacheReader.
+     */
+    SceneCacheReader(const SceneCacheReader& r) noexcept;
+
+    /**
+     * @brief Move Constructor
+     *
+     * Moves the read position of the input parameter into *this.
+     *
+     * @param r
+     * An r-value reference to a temporary SceneCacheReader.
+     */
+    SceneCacheReader(SceneCacheReader&& r) noexcept;
+
+    /**
+     * @brief Copy Operator
+     *
+     * Copies the read position of the input parameter into *this.
+     *
+     * @param r
+     * A constant reference to another SceneCacheReader.
+     *
+     * @return A reference to *this.
+     */
+    SceneCacheReader& operator=(const SceneCacheReader& r) noexcept;
+
+    /**
+     * @brief Move Operator
+     *
+     * Moves the read position of the input parameter into *this.
+     *
+     * @param r
+     * An r-value reference to a temporary SceneCacheReader.
+     *
+     * @return A reference to *this.
+     */
+    SceneCacheReader& operator=(SceneCacheReader&& r) noexcept;
+
+    /**
+     * @brief Determine if all reads have succeeded.
+     *
+     * @return TRUE if no read has exceeded the available data, FALSE if not.
+     */
+    bool is_valid() const noexcept;
+
+    /**
+     * @brief Retrieve the current read position.
+     *
+     * @return The offset of the next read.
+     */
+    size_t get_offset() const noexcept;
+
+    /**
+     * @brief Retrieve the number of bytes which have not yet been read.
+     *
+     * @return The number of bytes between the read position and the end of
+     * the data.
+     */
+    size_t get_bytes_remaining() const noexcept;
+
+    /**
+     * @brief Read an element count and verify it can fit within the
+     * remaining data.
+     *
+     * This should be used before allocating memory for a list of elements
+     * so a corrupted count cannot trigger a large allocation.
+     *
+     * @param outCount
+     * Will contain the element count, or 0 if the count was invalid.
+     *
+     * @param minElementBytes
+     * The minimum number of bytes each element occupies within the file.
+     *
+     * @return TRUE if a valid count was read, FALSE if not.
+     */
+    bool read_count(size_t& outCount, const size_t minElementBytes) noexcept;
+
+    /**
+     * @brief Retrieve a pointer to a range of bytes and advance the read
+     * position past them.
+     *
+     * @param count
+     * The number of bytes to read.
+     *
+     * @return A pointer to the requested bytes, or NULL if fewer than "count"
+     * bytes remain.
+     */
+    const char* read_bytes(const size_t count) noexcept;
+
+    /**
+     * @brief Read a single plain-data object.
+     *
+     * @param outData
+     * A reference to the object which will be overwritten.
+     *
+     * @return TRUE if the object was read, FALSE if not.
+     */
+    template <typename data_t>
+    bool read(data_t& outData) noexcept;
+
+    /**
+     * @brief Read a size-prefixed array of plain-data objects into a vector.
+     *
+     * @param outData
+     * A reference to the vector which will be resized and overwritten.
+     *
+     * @return TRUE if the array was read, FALSE if not.
+     */
+    template <typename data_t>
+    bool read_vector(std::vector<data_t>& outData) noexcept;
+
+    /**
+     * @brief Read a size-prefixed array of plain-data objects which must
+     * contain an exact number of elements.
+     *
+     * @param pOutData
+     * A pointer to an array which can hold "count" elements.
+     *
+     * @param count
+     * The expected number of elements.
+     *
+     * @return TRUE if the array was read and contained the expected number of
+     * elements, FALSE if not.
+     */
+    template <typename data_t>
+    bool read_array(data_t* const pOutData, const size_t count) noexcept;
+
+    /**
+     * @brief Read a length-prefixed string.
+     *
+     * @param outStr
+     * A reference to the string which will be overwritten.
+     *
+     * @return TRUE if the string was read, FALSE if not.
+     */
+    bool read_string(std::string& outStr) noexcept;
+};
+
+
+
+/*-------------------------------------
+ * Check for read errors
+-------------------------------------*/
+inline bool SceneCacheReader::is_valid() const noexcept
+{
+    return valid;
+}
+
+
+
+/*-------------------------------------
+ * Retrieve the read position
+-------------------------------------*/
+inline size_t SceneCacheReader::get_offset() const noexcept
+{
+    return offset;
+}
+
+
+
+/*-------------------------------------
+ * Retrieve the number of unread bytes
+-------------------------------------*/
+inline size_t SceneCacheReader::get_bytes_remaining() const noexcept
+{
+    return valid ? (numBytes - offset) : 0;
+}
+
+
+
+/*-------------------------------------
+ * Read a single object
+-------------------------------------*/
+template <typename data_t>
+inline bool SceneCacheReader::read(data_t& outData) noexcept
+{
+    const char* const pBytes = read_bytes(sizeof(data_t));
+
+    if (pBytes)
+    {
+        utils::fast_memcpy(&outData, pBytes, sizeof(data_t));
+    }
+
+    return pBytes != nullptr;
+}
+
+
+
+/*-------------------------------------
+ * Read a vector
+-------------------------------------*/
+template <typename data_t>
+bool SceneCacheReader::read_vector(std::vector<data_t>& outData) noexcept
+{
+    uint64_t count = 0;
+
+    if (!read<uint64_t>(count) || count > (numBytes - offset) / sizeof(data_t))
+    {
+        valid = false;
+        return false;
+    }
+
+    outData.resize((size_t)count);
+
+    const char* const pBytes = read_bytes(sizeof(data_t) * (size_t)count);
+
+    if (pBytes && count)
+    {
+        utils::fast_memcpy(outData.data(), pBytes, sizeof(data_t) * (size_t)count);
+    }
+
+    return pBytes != nullptr;
+}
+
+
+
+/*-------------------------------------
+ * Read a fixed-size array
+-------------------------------------*/
+template <typename data_t>
+bool SceneCacheReader::read_array(data_t* const pOutData, const size_t count) noexcept
+{
+    uint64_t inCount = 0;
+
+    if (!read<uint64_t>(inCount) || inCount != (uint64_t)count)
+    {
+        valid = false;
+        return false;
+    }
+
+    const char* const pBytes = read_bytes(sizeof(data_t) * count);
+
+    if (pBytes)
+    {
+        utils::fast_memcpy(pOutData, pBytes, sizeof(data_t) * count);
+    }
+
+    return pBytes != nullptr;
+}
+} // end draw namespace
+} // end ls namespace
+
+#endif /* __LS_DRAW_SCENE_FILE_CACHE_H__ */
@@ -9,13 +9,18 @@
 #ifndef __LS_DRAW_SCENE_GRAPH_LOADER_H__
 #define __LS_DRAW_SCENE_GRAPH_LOADER_H__
 
+#include <atomic>
 #include <utility> // std::pair
 #include <unordered_map>
 
 #include "lightsky/utils/Pointer.h"
 
 #include "lightsky/draw/Camera.h"
+#include "lightsky/draw/MeshOptimizer.h"
+#include "lightsky/draw/SceneArena.h"
+#include "lightsky/draw/SceneFileCache.h"
 #include "lightsky/draw/SceneGraph.h"
+#include "lightsky/draw/SceneLoadProfile.h"
 #include "lightsky/draw/SceneMesh.h"
 #include "lightsky/draw/SceneNode.h"
 #include "lightsky/draw/SceneRenderData.h"
@@ -24,6 +29,7 @@
 
 struct aiMaterial;
 struct aiMesh;
+struct aiMeshMorphAnim;
 struct aiNode;
 struct aiNodeAnim;
 struct aiScene;
@@ -59,6 +65,38 @@ class VertexBuffer;
 
 
 
+/**----------------------------------------------------------------------------
+ * Import profiles determine which mesh optimizations are performed by Assimp
+ * and which are performed by LightDraw.
+ *
+ * SCENE_IMPORT_DEFAULT relies on Assimp's post-processing steps to weld
+ * vertices, find instances, and merge small meshes.
+ *
+ * SCENE_IMPORT_FAST only requests triangulated data from Assimp. Vertices
+ * are then welded using a hash table, in parallel per mesh, and identical
+ * meshes are replaced by a single instance. Small meshes are not merged, so
+ * scenes may contain additional draw calls.
+ *
+ * SCENE_IMPORT_BASE_VERTEX may be combined with either profile. Indices are
+ * then stored relative to each mesh's first vertex, allowing smaller index
+ * types, and each mesh's DrawCommandParams::baseVertex is set. Such scenes
+ * must be rendered through submit_draw_command() (or another base-vertex
+ * draw call). Without this flag, indices address their VAO directly and
+ * baseVertex is always 0. The flag is ignored if
+ * LS_DRAW_BASE_VERTEX_SUPPORTED is undefined.
+-----------------------------------------------------------------------------*/
+enum scene_import_profile_t : unsigned
+{
+    SCENE_IMPORT_DEFAULT = 0x00,
+    SCENE_IMPORT_FAST = 0x01,
+    SCENE_IMPORT_BASE_VERTEX = 0x02,
+
+    SCENE_IMPORT_DEFAULT_BASE_VERTEX = SCENE_IMPORT_DEFAULT | SCENE_IMPORT_BASE_VERTEX,
+    SCENE_IMPORT_FAST_BASE_VERTEX = SCENE_IMPORT_FAST | SCENE_IMPORT_BASE_VERTEX
+};
+
+
+
 /**----------------------------------------------------------------------------
  * Condensed meta-information about a scene file.
 -----------------------------------------------------------------------------*/
@@ -68,7 +106,18 @@ struct SceneFileMetaData
     uint32_t totalVertices = 0;
     uint32_t totalIboBytes = 0;
     uint32_t totalIndices = 0;
+
+    // Largest index type used by any mesh. Each mesh stores its own index
+    // type within its draw parameters.
     index_element_t indexType = index_element_t::INDEX_TYPE_NONE;
+
+    // PACKED_*_VERTEX flags which replace floating-point vertex attributes
+    // for every mesh within a scene.
+    common_vertex_t packedVertTypes = (common_vertex_t)0;
+
+    // Non-zero if indices are relative to each mesh's first vertex and
+    // meshes are drawn using DrawCommandParams::baseVertex.
+    uint32_t baseVertexDraws = 0;
 };
 
 /**----------------------------------------------------------------------------
@@ -102,6 +151,23 @@ struct VboGroupMarker
 
 
 
+/**----------------------------------------------------------------------------
+ * A range of vertex or index data which is uploaded into a scene's VBO or IBO
+ * without further conversion.
+-----------------------------------------------------------------------------*/
+struct SceneUploadRange
+{
+    const char* pData;
+
+    unsigned offset;
+
+    unsigned numBytes;
+
+    bool isIndexData;
+};
+
+
+
 /**----------------------------------------------------------------------------
  * Preloading structure which allows a file to load in a separate thread.
 -----------------------------------------------------------------------------*/
@@ -110,7 +176,15 @@ class SceneFilePreLoader
 
     friend class SceneFileLoader;
 
+    friend class SceneStreamer;
+
   private:
+    /**
+     * The maximum number of threads used by each parallel stage of a load,
+     * including the calling thread. 0 uses all hardware threads.
+     */
+    unsigned maxThreads;
+
     std::string filepath;
 
     utils::Pointer<Assimp::Importer> importer;
@@ -125,10 +199,165 @@ class SceneFilePreLoader
 
     std::unordered_map<std::string, size_t> texturePaths;
 
+    /**
+     * Determines if a binary cache should be read before importing a file,
+     * or written after a file has been imported.
+     */
+    scene_cache_mode_t cacheMode;
+
+    /**
+     * Memory-mapped binary cache which *this was loaded from. The vertex and
+     * index payloads are uploaded directly from the mapping.
+     */
+    SceneFileCache cache;
+
+    /**
+     * Independently compressed ranges of the cached VBO and IBO. This is
+     * empty unless the cache payloads were written with SCENE_CACHE_COMPRESS.
+     */
+    std::vector<SceneCachePayloadBlock> cacheBlocks;
+
+    /**
+     * The path and wrap mode of each unique texture which has yet to be
+     * decoded and uploaded. Materials reference textures by their index in
+     * this list until "SceneFileLoader::import_pending_textures()" remaps
+     * them to OpenGL handles.
+     */
+    std::vector<std::pair<std::string, tex_wrap_t>> pendingTextures;
+
+    /**
+     * Vertex cache metrics of each mesh, generated while meshes are
+     * optimized during an import. This remains empty for scenes loaded from
+     * a binary cache.
+     */
+    std::vector<MeshOptimizerStats> meshStats;
+
+    /**
+     * Memory-mapped files of a natively imported glTF scene. The first
+     * mapping contains the glTF or GLB file, followed by any external
+     * buffers it references.
+     */
+    std::vector<SceneFileCache> gltfMappings;
+
+    /**
+     * Vertices which were converted from a glTF file, along with any buffers
+     * decoded from data URIs. Converted indices are kept in "scratch."
+     */
+    std::vector<std::vector<char>> gltfBuffers;
+
+    /**
+     * Ranges of the mapped glTF files, the converted buffers, or the scratch
+     * arena which are uploaded into the scene's VBO and IBO.
+     */
+    std::vector<SceneUploadRange> gltfRanges;
+
+    /**
+     * Opt-in timing and memory measurements of the current load. These are
+     * kept after a failed load, and are passed to a SceneFileLoader along
+     * with all other preloaded data.
+     */
+    SceneLoadProfile profile;
+
+    /**
+     * Temporary arrays used while a file is loaded by *this or by a
+     * SceneFileLoader. The arena is rewound, not freed, when *this is
+     * unloaded so repeated loads reuse a single block of memory. It must not
+     * be used by worker threads.
+     */
+    SceneArena scratch;
+
+    /**
+     * @brief Determine how many threads a parallel stage of a load should
+     * use.
+     *
+     * @param numTasks
+     * The number of independent items which the stage processes.
+     *
+     * @return The smaller of "numTasks" and the thread limit of *this.
+     */
+    unsigned calc_num_threads(const size_t numTasks) const noexcept;
+
     const aiScene* preload_mesh_data() noexcept;
 
     bool allocate_cpu_data(const aiScene* const pScene) noexcept;
 
+    /**
+     * @brief Weld the vertices of every mesh in parallel, then replace
+     * identical meshes with a single instance.
+     *
+     * This replaces Assimp's JoinIdenticalVertices and FindInstances steps
+     * when importing with SCENE_IMPORT_FAST.
+     *
+     * @param pScene
+     * A pointer to the imported scene, which is modified in-place.
+     */
+    void weld_mesh_data(aiScene* const pScene) noexcept;
+
+    /**
+     * @brief Weld meshes until none remain.
+     *
+     * @param pScene
+     * A pointer to the imported scene.
+     *
+     * @param outHashes
+     * Contains the hash of each mesh upon return, after being welded.
+     *
+     * @param outNumWelded
+     * Accumulates the number of vertices which were removed.
+     *
+     * @param nextMeshId
+     * The index of the next mesh to weld, shared by all threads.
+     */
+    void weld_meshes(
+        aiScene* const pScene,
+        std::vector<uint64_t>& outHashes,
+        std::atomic_uint& outNumWelded,
+        std::atomic_uint& nextMeshId
+    ) noexcept;
+
+    /**
+     * @brief Remove duplicate meshes and update all nodes to reference the
+     * remaining instance.
+     *
+     * @param pScene
+     * A pointer to the imported scene.
+     *
+     * @param meshHashes
+     * The hash of each mesh, generated by "weld_meshes(...)".
+     *
+     * @return The number of meshes which were removed.
+     */
+    unsigned instance_mesh_data(aiScene* const pScene, const std::vector<uint64_t>& meshHashes) noexcept;
+
+    /**
+     * @brief Load all CPU-side scene data from a binary cache.
+     *
+     * @param filename
+     * The path to the original scene file. The cache is expected to be
+     * located at "get_scene_cache_path(...)", using the vertex packing and
+     * index layout within "sceneInfo".
+     *
+     * @return TRUE if a valid, up-to-date cache was found and loaded, FALSE
+     * if not.
+     */
+    bool load_cache(const std::string& filename) noexcept;
+
+    /**
+     * @brief Load all CPU-side scene data from a glTF 2.0 file without
+     * using Assimp.
+     *
+     * The file, and any external buffers, are memory-mapped. Accessors
+     * whose layout already matches the scene's VBO or IBO are uploaded
+     * directly from the mappings while all others are converted.
+     *
+     * @param filename
+     * The path to a ".gltf" or ".glb" file.
+     *
+     * @return TRUE if the file was loaded, FALSE if it uses features which
+     * are not supported natively and should be imported by Assimp instead.
+     */
+    bool load_gltf(const std::string& filename) noexcept;
+
   public:
     /**
      * @brief Destructor
@@ -190,14 +419,40 @@ class SceneFilePreLoader
     /**
      * @brief Load a 3D mesh file
      *
+     * Files with a ".gltf" or ".glb" extension are imported natively. Assimp
+     * is used for all other formats, or if a glTF file requires features
+     * which are not supported natively.
+     *
      * @param filename
      * A string object containing the relative path name to a file that
      * should be loadable into memory.
      *
+     * @param cacheFlags
+     * Determines if a binary cache, located next to the input file, should
+     * be loaded instead of importing the file. If the cache is written, it
+     * will be saved once a SceneFileLoader has finished loading *this.
+     *
+     * @param packedVertTypes
+     * A bitmask of PACKED_*_VERTEX flags, determining which vertex
+     * attributes should be stored using compact encodings. Caches which were
+     * written using different flags are ignored.
+     *
+     * @param importProfile
+     * Determines if mesh optimizations are performed by Assimp or by
+     * LightDraw's own parallel passes. Only SCENE_IMPORT_BASE_VERTEX is used
+     * when a cache is read or when a glTF file is imported natively. Caches
+     * which were written with a different SCENE_IMPORT_BASE_VERTEX setting
+     * are ignored.
+     *
      * @return true if the file was successfully loaded into memory. False
      * if not.
      */
-    bool load(const std::string& filename) noexcept;
+    bool load(
+        const std::string& filename,
+        const scene_cache_mode_t cacheFlags = SCENE_CACHE_READ_WRITE,
+        const common_vertex_t packedVertTypes = (common_vertex_t)0,
+        const scene_import_profile_t importProfile = SCENE_IMPORT_DEFAULT
+    ) noexcept;
 
     /**
      * @brief Verify that data loaded successfully.
@@ -206,16 +461,100 @@ class SceneFilePreLoader
      * passed to a SceneFileLoader object for GPU loading, FALSE if not.
      */
     bool is_loaded() const noexcept;
+
+    /**
+     * @brief Enable or disable profiling of each load phase.
+     *
+     * Profiling remains enabled across loads until disabled. Measurements
+     * are reset at the start of each call to "load()."
+     *
+     * @param enabled
+     * TRUE if subsequent loads should be profiled, FALSE if not.
+     */
+    void set_profiling_enabled(const bool enabled) noexcept;
+
+    /**
+     * @brief Retrieve the phase timings of the most recent load.
+     *
+     * @return A constant reference to the load profile of *this. All
+     * measurements are zero if profiling was disabled.
+     */
+    const SceneLoadProfile& get_load_profile() const noexcept;
+
+    /**
+     * @brief Limit the number of threads used by each parallel stage of a
+     * load.
+     *
+     * The limit remains in place across loads and is passed to a
+     * SceneFileLoader along with all other preloaded data. Loads which run
+     * concurrently, such as within a SceneLoadService, should use a small
+     * limit to avoid oversubscribing the CPU.
+     *
+     * @param numThreads
+     * The maximum number of threads, including the calling thread. A value
+     * of 0 will use the number of hardware threads available on the system.
+     */
+    void set_max_threads(const unsigned numThreads) noexcept;
+
+    /**
+     * @brief Retrieve the thread limit of each parallel stage of a load.
+     *
+     * @return The maximum number of threads used, or 0 if all hardware
+     * threads are used.
+     */
+    unsigned get_max_threads() const noexcept;
 };
 
 
 
+/*-------------------------------------
+ * Enable or disable load profiling
+-------------------------------------*/
+inline void SceneFilePreLoader::set_profiling_enabled(const bool enabled) noexcept
+{
+    profile.enabled = enabled;
+}
+
+
+
+/*-------------------------------------
+ * Set the thread limit
+-------------------------------------*/
+inline void SceneFilePreLoader::set_max_threads(const unsigned numThreads) noexcept
+{
+    maxThreads = numThreads;
+}
+
+
+
+/*-------------------------------------
+ * Retrieve the thread limit
+-------------------------------------*/
+inline unsigned SceneFilePreLoader::get_max_threads() const noexcept
+{
+    return maxThreads;
+}
+
+
+
+/*-------------------------------------
+ * Retrieve the load profile
+-------------------------------------*/
+inline const SceneLoadProfile& SceneFilePreLoader::get_load_profile() const noexcept
+{
+    return profile;
+}
+
+
+
 /**----------------------------------------------------------------------------
  * The scene file loader  can be used to load a 3D scene from a file.
 -----------------------------------------------------------------------------*/
 class SceneFileLoader
 {
 
+    friend class SceneStreamer;
+
     // Private Variables
   private:
     SceneFilePreLoader preloader;
@@ -224,17 +563,190 @@ class SceneFileLoader
   private:
     bool load_scene(const aiScene* const pScene) noexcept;
 
-    bool allocate_gpu_data() noexcept;
+    /**
+     * @brief Upload all data which was loaded from a binary cache to the
+     * GPU.
+     *
+     * @return TRUE if all buffers and VAOs were created, FALSE if not.
+     */
+    bool load_cached_scene() noexcept;
+
+    /**
+     * @brief Upload all data which was natively imported from a glTF file
+     * to the GPU.
+     *
+     * @return TRUE if all buffers and VAOs were created, FALSE if not.
+     */
+    bool load_gltf_scene() noexcept;
+
+    /**
+     * @brief Allocate empty GPU buffers for a scene which was loaded from a
+     * binary cache, leaving all mesh payloads within the mapped cache.
+     *
+     * This is used by a SceneStreamer, which uploads meshes on demand.
+     *
+     * @param numVboBytes
+     * The size of the streaming VBO.
+     *
+     * @param numIboBytes
+     * The size of the streaming IBO.
+     *
+     * @return TRUE if all buffers and VAOs were created, FALSE if not.
+     */
+    bool load_streamed_scene(const unsigned numVboBytes, const unsigned numIboBytes) noexcept;
+
+    /**
+     * @brief Remap the VAO indices of a cached or natively imported scene to
+     * their OpenGL handles, then upload all textures and initialize the
+     * first animation.
+     */
+    void finalize_cached_scene() noexcept;
+
+    /**
+     * @brief Decode the compressed payloads of a binary cache directly into
+     * the scene's mapped VBO and IBO.
+     *
+     * Blocks are decoded on worker threads alongside the calling thread.
+     *
+     * @return TRUE if all blocks were decoded, FALSE if the buffers could not
+     * be mapped or a block was corrupt.
+     */
+    bool decode_cached_payloads() noexcept;
+
+    /**
+     * @brief Decode all pending textures on worker threads, upload them from
+     * the calling thread, then remap all material texture indices to their
+     * OpenGL handles.
+     *
+     * Textures are uploaded in the order they were listed, regardless of the
+     * order in which they finish decoding, so material bindings and texture
+     * indices are identical between loads.
+     */
+    void import_pending_textures() noexcept;
+
+    /**
+     * @brief Allocate all VBOs, IBOs, and VAOs for a scene.
+     *
+     * @param pVboData
+     * A pointer to the vertex data of the entire scene, or NULL to leave the
+     * VBO uninitialized.
+     *
+     * @param pIboData
+     * A pointer to the index data of the entire scene, or NULL to leave the
+     * IBO uninitialized.
+     *
+     * @return TRUE if all GPU objects were created, FALSE if not.
+     */
+    bool allocate_gpu_data(const void* const pVboData = nullptr, const void* const pIboData = nullptr) noexcept;
+
+    /**
+     * @brief Allocate a VBO, IBO, and one VAO per vertex type.
+     *
+     * @param numVboBytes
+     * The size of the VBO, or 0 to skip its creation.
+     *
+     * @param numIboBytes
+     * The size of the IBO, or 0 to skip its creation.
+     *
+     * @param pVboData
+     * A pointer to the initial VBO contents, or NULL.
+     *
+     * @param pIboData
+     * A pointer to the initial IBO contents, or NULL.
+     *
+     * @param isStreamed
+     * If TRUE, the attributes of every VAO begin at the start of the VBO so
+     * meshes can be placed anywhere within it using a base vertex.
+     *
+     * @return TRUE if all GPU objects were created, FALSE if not.
+     */
+    bool allocate_gpu_buffers(
+        const unsigned numVboBytes,
+        const unsigned numIboBytes,
+        const void* const pVboData,
+        const void* const pIboData,
+        const bool isStreamed
+    ) noexcept;
 
     bool import_materials(const aiScene* const pScene) noexcept;
 
-    void import_texture_path(const aiMaterial* const pMaterial, const int slotType, SceneMaterial& outMaterial, ImageBuffer& imgLoader, TextureAssembly& texAssembly) noexcept;
+    void import_texture_path(const aiMaterial* const pMaterial, const int slotType, SceneMaterial& outMaterial) noexcept;
 
-    size_t load_texture_at_path(const std::string& path, ImageBuffer& imgLoader, TextureAssembly& texAssembly, const tex_wrap_t wrapMode) noexcept;
+    /**
+     * @brief Upload a decoded image as a 2D texture.
+     *
+     * @param imgLoader
+     * An image which has been loaded from the filesystem.
+     *
+     * @param texAssembly
+     * A texture assembly which will be reset and reused.
+     *
+     * @param wrapMode
+     * The wrap mode of the texture's S, T, and R coordinates.
+     *
+     * @return The index of the new texture within the scene's render data,
+     * or INVALID_MATERIAL_TEXTURE if the texture could not be created.
+     */
+    size_t upload_texture(const ImageBuffer& imgLoader, TextureAssembly& texAssembly, const tex_wrap_t wrapMode) noexcept;
 
     bool import_mesh_data(const aiScene* const pScene) noexcept;
 
-    char* upload_mesh_indices(const aiMesh* const pMesh, char* pIbo, const unsigned baseIndex, const unsigned baseVertex, SceneMesh& outMesh) noexcept;
+    /**
+     * @brief Import the morph targets of a single mesh as sparse deltas.
+     *
+     * @param pMesh
+     * A constant pointer to the ASSIMP mesh containing morph targets.
+     *
+     * @param baseVertex
+     * The index of the mesh's first vertex within its VAO.
+     *
+     * @param outMorph
+     * A reference to the SceneMorph which will contain the imported targets.
+     */
+    void import_mesh_morphs(const aiMesh* const pMesh, const unsigned baseVertex, SceneMorph& outMorph) noexcept;
+
+    /**
+     * @brief Convert the vertices, indices, and morph targets of all meshes
+     * which have not yet been claimed by another thread.
+     *
+     * All mesh offsets and draw parameters must have been calculated before
+     * calling this function. Multiple threads may call this concurrently.
+     *
+     * @param pScene
+     * A constant pointer to the ASSIMP scene being imported.
+     *
+     * @param pVbo
+     * A pointer to the mapped VBO of the entire scene.
+     *
+     * @param pIbo
+     * A pointer to the mapped IBO of the entire scene.
+     *
+     * @param nextMeshId
+     * A counter, shared between all threads, containing the index of the
+     * next mesh to convert.
+     */
+    void convert_mesh_data(const aiScene* const pScene, char* const pVbo, char* const pIbo, std::atomic_uint& nextMeshId) noexcept;
+
+    /**
+     * @brief Write the indices of a single mesh into an index buffer.
+     *
+     * @param pIndices
+     * A constant pointer to the mesh's indices, relative to its first vertex.
+     *
+     * @param numIndices
+     * The number of indices within "pIndices."
+     *
+     * @param pIbo
+     * A pointer to the location of the mesh's first index.
+     *
+     * @param baseVertex
+     * A value to add to each index. This is 0 if base-vertex draws are used,
+     * or the index of the mesh's first vertex within its VAO if not.
+     *
+     * @param indexType
+     * The type of each index written into the IBO.
+     */
+    void upload_mesh_indices(const uint32_t* const pIndices, const size_t numIndices, char* const pIbo, const unsigned baseVertex, const index_element_t indexType) const noexcept;
 
     size_t get_mesh_group_marker(const common_vertex_t vertType, const std::vector<VboGroupMarker>& markers) const noexcept;
 
@@ -256,6 +768,15 @@ class SceneFileLoader
      */
     void read_node_hierarchy(const aiScene* const pScene, const aiNode* const pNode, const size_t parentId) noexcept;
 
+    /**
+     * @brief Import the bones of all skinned meshes. This must be called after
+     * the node hierarchy has been read so bones can reference their nodes.
+     *
+     * @param pScene
+     * A constant pointer to a constant aiScene object from ASSIMP.
+     */
+    void import_mesh_skins(const aiScene* const pScene) noexcept;
+
     /**
      * @brief Import a sceneMeshNode object if an ASSIMP node contains
      * meshes.
@@ -320,6 +841,28 @@ class SceneFileLoader
         const anim_prec_t animDuration
     ) noexcept;
 
+    /**
+     * @brief Import the morph target weight tracks of a single mesh
+     * animation channel from ASSIMP.
+     *
+     * @param pScene
+     * A constant pointer to a constant ASSIMP scene structure.
+     *
+     * @param pInAnim
+     * A constant pointer to the morph animation channel to import.
+     *
+     * @param outAnim
+     * A reference to the Animation which will contain each imported weight
+     * track.
+     *
+     * @return TRUE if the animated mesh was found, FALSE if not.
+     */
+    bool import_morph_animation(
+        const aiScene* const pScene,
+        const aiMeshMorphAnim* const pInAnim,
+        Animation& outAnim
+    ) noexcept;
+
   public:
     /**
      * @brief Destructor
@@ -385,9 +928,26 @@ class SceneFileLoader
      * A string object containing the relative path name to a file that
      * should be loadable into memory.
      *
+     * @param cacheFlags
+     * Determines if a binary cache should be loaded in place of the input
+     * file, or written once the file has been imported.
+     *
+     * @param packedVertTypes
+     * A bitmask of PACKED_*_VERTEX flags, determining which vertex
+     * attributes should be stored using compact encodings.
+     *
+     * @param importProfile
+     * Determines if mesh optimizations are performed by Assimp or by
+     * LightDraw's own parallel passes, and if meshes use base-vertex draws.
+     *
      * @return true if the file was successfully loaded. False if not.
      */
-    bool load(const std::string& filename) noexcept;
+    bool load(
+        const std::string& filename,
+        const scene_cache_mode_t cacheFlags = SCENE_CACHE_READ_WRITE,
+        const common_vertex_t packedVertTypes = (common_vertex_t)0,
+        const scene_import_profile_t importProfile = SCENE_IMPORT_DEFAULT
+    ) noexcept;
 
     /**
      * @brief Import in-memory mesh data, preloaded from a file.
@@ -400,6 +960,20 @@ class SceneFileLoader
      */
     bool load(SceneFilePreLoader&& preload) noexcept;
 
+    /**
+     * @brief Save the currently loaded scene into a binary cache.
+     *
+     * The cache contains all scene graph data, along with the final vertex
+     * and index data, which is read back from the GPU. Textures are stored
+     * by path and are decoded again when the cache is loaded.
+     *
+     * @param cachePath
+     * The path of the cache file to write.
+     *
+     * @return TRUE if the cache was written, FALSE if not.
+     */
+    bool save_cache(const std::string& cachePath) const noexcept;
+
     /**
      * @brief get_loaded_data() allows the loaded scene graph to be
      * retrieved by reference.
@@ -417,6 +991,57 @@ class SceneFileLoader
      * used for validation, rendering, or something else.
      */
     SceneGraph& get_loaded_data() noexcept;
+
+    /**
+     * @brief Retrieve the vertex cache metrics of each mesh which was
+     * optimized while importing the current scene.
+     *
+     * @return A constant reference to a list of statistics, indexed by mesh.
+     * This list is empty if the scene was loaded from a binary cache.
+     */
+    const std::vector<MeshOptimizerStats>& get_mesh_optimizer_stats() const noexcept;
+
+    /**
+     * @brief Retrieve the path of each texture which was uploaded while
+     * loading the current scene.
+     *
+     * @return A constant reference to a map of texture paths to their index
+     * within the loaded scene's "renderData.textures" member.
+     */
+    const std::unordered_map<std::string, size_t>& get_texture_paths() const noexcept;
+
+    /**
+     * @brief Enable or disable profiling of each load phase.
+     *
+     * Scenes loaded from a SceneFilePreLoader use the profiling state of
+     * the preloader instead.
+     *
+     * @param enabled
+     * TRUE if subsequent loads should be profiled, FALSE if not.
+     */
+    void set_profiling_enabled(const bool enabled) noexcept;
+
+    /**
+     * @brief Retrieve the phase timings of the most recent load, including
+     * all phases which were run by its preloader.
+     *
+     * @return A constant reference to the load profile of the current
+     * scene. Use "SceneLoadProfile::to_json()" to export the report.
+     */
+    const SceneLoadProfile& get_load_profile() const noexcept;
+
+    /**
+     * @brief Limit the number of threads used by each parallel stage of a
+     * load.
+     *
+     * Scenes loaded from a SceneFilePreLoader use the thread limit of the
+     * preloader instead.
+     *
+     * @param numThreads
+     * The maximum number of threads, including the calling thread. A value
+     * of 0 will use the number of hardware threads available on the system.
+     */
+    void set_max_threads(const unsigned numThreads) noexcept;
 };
 
 
@@ -438,6 +1063,57 @@ inline SceneGraph& SceneFileLoader::get_loaded_data() noexcept
 {
     return preloader.sceneData;
 }
+
+
+
+/*-------------------------------------
+ * Retrieve the mesh optimization statistics
+-------------------------------------*/
+inline const std::vector<MeshOptimizerStats>& SceneFileLoader::get_mesh_optimizer_stats() const noexcept
+{
+    return preloader.meshStats;
+}
+
+
+
+/*-------------------------------------
+ * Retrieve the uploaded texture paths
+-------------------------------------*/
+inline const std::unordered_map<std::string, size_t>& SceneFileLoader::get_texture_paths() const noexcept
+{
+    return preloader.texturePaths;
+}
+
+
+
+/*-------------------------------------
+ * Enable or disable load profiling
+-------------------------------------*/
+inline void SceneFileLoader::set_profiling_enabled(const bool enabled) noexcept
+{
+    preloader.set_profiling_enabled(enabled);
+}
+
+
+
+/*-------------------------------------
+ * Retrieve the load profile
+-------------------------------------*/
+inline const SceneLoadProfile& SceneFileLoader::get_load_profile() const noexcept
+{
+    return preloader.get_load_profile();
+}
+
+
+
+/*-------------------------------------
+ * Set the thread limit
+-------------------------------------*/
+inline void SceneFileLoader::set_max_threads(const unsigned numThreads) noexcept
+{
+    preloader.set_max_threads(numThreads);
+}
+
 } // end draw namespace
 } // end ls namespace
 
@@ -11,6 +11,8 @@
 #include "lightsky/draw/Animation.h"
 #include "lightsky/draw/PackedVertex.h"
 #include "lightsky/draw/SceneFileLoader.h"
+#include "lightsky/draw/SceneSkin.h"
+#include "lightsky/draw/VertexUtils.h"
 
 
 
@@ -40,7 +42,21 @@ enum : unsigned int
                               | aiProcess_ImproveCacheLocality
                               | aiProcess_TransformUVCoords
                               | aiProcess_RemoveRedundantMaterials
-                              | 0
+                              | 0,
+
+    // Used with SCENE_IMPORT_FAST. Vertex welding, instancing, and cache
+    // optimization are performed by the SceneFilePreLoader in parallel.
+    SCENE_FILE_FAST_IMPORT_FLAGS = 0
+                                   | aiProcess_Triangulate
+                                   | aiProcess_SortByPType
+                                   | aiProcess_RemoveComponent
+                                   | aiProcess_FindDegenerates
+                                   | aiProcess_FixInfacingNormals
+                                   | aiProcess_FindInvalidData
+                                   | aiProcess_ValidateDataStructure
+                                   | aiProcess_TransformUVCoords
+                                   | aiProcess_RemoveRedundantMaterials
+                                   | 0
 };
 
 
@@ -154,6 +170,25 @@ ls::draw::VboGroupMarker* get_matching_marker(const ls::draw::common_vertex_t in
 
 
 
+/*-------------------------------------
+ * Location of the next mesh within a VBO group while meshes are placed.
+-------------------------------------*/
+struct VboGroupCursor
+{
+    unsigned meshOffset;
+
+    unsigned baseVert;
+};
+
+
+
+/*-------------------------------------
+ * Allocate a cursor for each VBO Group marker from a loader's scratch arena.
+-------------------------------------*/
+VboGroupCursor* init_vbo_group_cursors(ls::draw::SceneArena& arena, const std::vector<ls::draw::VboGroupMarker>& markers) noexcept;
+
+
+
 /*-------------------------------------
  * Helper function to map a VBO/IBO
 -------------------------------------*/
@@ -218,16 +253,113 @@ unsigned calc_mesh_geometry_colors(
 
 
 
+/*-------------------------------------
+ * Calculate the scale and bias which map a mesh's bounding box to [0, 1].
+-------------------------------------*/
+void calc_mesh_dequantization(
+    const aiMesh* const pMesh,
+    ls::math::vec3& outScale,
+    ls::math::vec3& outBias
+) noexcept;
+
+
+
+/*-------------------------------------
+ * Quantize vertex positions to normalized 16-bit integers.
+-------------------------------------*/
+unsigned calc_mesh_geometry_packed_pos(
+    const aiMesh* const pMesh,
+    char* pVbo,
+    const unsigned vertStride,
+    const ls::math::vec3& dequantScale,
+    const ls::math::vec3& dequantBias
+) noexcept;
+
+
+
+/*-------------------------------------
+ * Convert Assimp UVs to half-floats.
+-------------------------------------*/
+unsigned calc_mesh_geometry_packed_uvs(
+    const aiMesh* const pMesh,
+    char* pVbo,
+    const unsigned vertStride
+) noexcept;
+
+
+
+/*-------------------------------------
+ * Octahedral-encode Assimp Normals, Tangents, or BiTangents.
+-------------------------------------*/
+unsigned calc_mesh_geometry_packed_norms(
+    const aiMesh* const pMesh,
+    char* pVbo,
+    const unsigned vertStride,
+    const ls::draw::common_vertex_t normType
+) noexcept;
+
+
+
+/*-------------------------------------
+ * Convert Assimp Colors to normalized bytes.
+-------------------------------------*/
+unsigned calc_mesh_geometry_packed_colors(
+    const aiMesh* const pMesh,
+    char* pVbo,
+    const unsigned vertStride
+) noexcept;
+
+
+
+/*-------------------------------------
+ * Convert Assimp bone weights to internal bone indices and weights.
+ * Up to four of the most influential bones are kept per vertex.
+-------------------------------------*/
+unsigned calc_mesh_geometry_bones(
+    const aiMesh* const pMesh,
+    char* pVbo,
+    const unsigned vertStride
+) noexcept;
+
+
+
 /*-------------------------------------
  * Function to dispatch all text-loading responsibilities to their respective loaders.
 -------------------------------------*/
 unsigned upload_mesh_vertices(
     const aiMesh* const pMesh,
     char* const pVbo,
-    const ls::draw::common_vertex_t vertTypes
+    const ls::draw::MeshMetaData& metaData
 ) noexcept;
 
 
+/*-------------------------------------
+ * Merge all vertices of a mesh which convert to identical internal vertices.
+ * Returns the number of vertices which were removed.
+-------------------------------------*/
+unsigned weld_assimp_mesh(
+    aiMesh* const pMesh,
+    const ls::draw::common_vertex_t packedVertTypes,
+    std::vector<char>& scratchVerts,
+    std::vector<uint32_t>& scratchRemap
+) noexcept;
+
+
+
+/*-------------------------------------
+ * Hash the material, positions, and faces of a mesh.
+-------------------------------------*/
+uint64_t hash_assimp_mesh(const aiMesh* const pMesh) noexcept;
+
+
+
+/*-------------------------------------
+ * Determine if two meshes can be replaced by a single instance.
+-------------------------------------*/
+bool are_assimp_meshes_equal(const aiMesh* const pA, const aiMesh* const pB) noexcept;
+
+
+
 /*-------------------------------------
  * Check to see if a node is a mesh/camera/bone/light node
 -------------------------------------*/
@@ -271,10 +403,65 @@ unsigned count_assimp_nodes(const aiNode* const pNode) noexcept;
 
 
 
+/*-------------------------------------
+ * Determine the index type of a single mesh
+-------------------------------------*/
+inline ls::draw::index_element_t get_mesh_index_type(const unsigned baseVertex, const unsigned numVertices, const bool baseVertexDraws) noexcept
+{
+    // Indices are relative to the mesh's first vertex with base-vertex draws.
+    // Otherwise they must address every vertex in the mesh's VAO.
+    return ls::draw::get_required_index_type(baseVertexDraws ? numVertices : (baseVertex + numVertices));
+}
+
+
+
+/*-------------------------------------
+ * Align the byte offset of a mesh's indices within an IBO
+-------------------------------------*/
+constexpr unsigned get_mesh_index_offset(const unsigned iboBytes) noexcept
+{
+    // Meshes with different index types share an IBO. Keeping each offset
+    // 4-byte aligned satisfies all of them.
+    return (iboBytes + 3u) & ~3u;
+}
+
+
+
+/*-------------------------------------
+ * Write a list of indices into an index buffer
+-------------------------------------*/
+template <typename index_t>
+inline void convert_mesh_indices(const uint32_t* const pIndices, const size_t numIndices, char* const pIbo, const unsigned baseVertex) noexcept
+{
+    index_t* const pOut = reinterpret_cast<index_t*>(pIbo);
+
+    for (size_t i = 0; i < numIndices; ++i)
+    {
+        pOut[i] = (index_t)(pIndices[i] + baseVertex);
+    }
+}
+
+
+
+/*-------------------------------------
+ * Record the storage reserved by a scene array
+-------------------------------------*/
+template <typename data_t>
+inline void profile_scene_allocation(ls::draw::SceneLoadProfile& profile, const ls::draw::scene_load_phase_t phase, const std::vector<data_t>& data) noexcept
+{
+    if (data.capacity())
+    {
+        profile.add_allocation(phase, (uint64_t)data.capacity() * sizeof(data_t));
+    }
+}
+
+
+
 /*-------------------------------------
  * Setup Animation
 -------------------------------------*/
 ls::draw::Animation setup_imported_animation(
+    ls::draw::SceneNameTable& names,
     const char* const name,
     const ls::draw::anim_prec_t duration,
     const ls::draw::anim_prec_t ticksPerSec,
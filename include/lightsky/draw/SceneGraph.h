@@ -8,6 +8,9 @@
 #include "lightsky/draw/Animation.h"
 #include "lightsky/draw/GLContext.h"
 #include "lightsky/draw/DrawParams.h"
+#include "lightsky/draw/SceneMorph.h"
+#include "lightsky/draw/SceneNameTable.h"
+#include "lightsky/draw/SceneSkin.h"
 
 
 
@@ -65,6 +68,20 @@ class SceneGraph
      */
     std::vector<SceneMesh> meshes;
 
+    /**
+     * Bones used to deform meshes. Skins are referenced by the same array
+     * index as their meshes in the "meshes" member. Rigid meshes have a skin
+     * with no bones.
+     */
+    std::vector<SceneSkin> skins;
+
+    /**
+     * Morph targets (blend shapes) used to deform meshes. Morphs are
+     * referenced by the same array index as their meshes in the "meshes"
+     * member. Meshes without blend shapes have a morph with no targets.
+     */
+    std::vector<SceneMorph> morphs;
+
     /**
      * Bounding boxes for meshes
      */
@@ -109,14 +126,22 @@ class SceneGraph
      */
     std::vector<math::mat4> modelMatrices;
 
+    /**
+     * Contains each unique node and animation name. Copies of a scene graph
+     * share their name table until new names are added.
+     */
+    SceneNameTable nameTable;
+
     /**
      * Referenced by all scene node types using their
-     * "SceneNode::nodeId" member.
+     * "SceneNode::nodeId" member. Each value is the ID of a name within
+     * "nameTable."
      */
-    std::vector<std::string> nodeNames;
+    std::vector<scene_name_t> nodeNames;
 
     /**
-     * Contains all animations available in the current scene graph.
+     * Contains all animations available in the current scene graph. Their
+     * names are stored in "nameTable."
      */
     std::vector<Animation> animations;
 
@@ -188,6 +213,14 @@ class SceneGraph
      */
     void delete_node_animation_data(const size_t nodeId, const size_t animId) noexcept;
 
+    /**
+     * Remove all references to a node from the bones of each skinned mesh.
+     *
+     * @param nodeId
+     * The array index of a node being deleted.
+     */
+    void delete_node_skin_data(const size_t nodeId) noexcept;
+
   public: // member functions
     /**
      * @brief Destructor
@@ -322,6 +355,29 @@ class SceneGraph
      */
     size_t find_node_id(const std::string& nameQuery) const noexcept;
 
+    /**
+     * Search for a node by the ID of its name and return its index.
+     *
+     * @param nameId
+     * The ID of a name within "nameTable."
+     *
+     * @return The array-index of the node being searched for, or
+     * SCENE_GRAPH_ROOT_ID if the node was not found.
+     */
+    size_t find_node_id(const scene_name_t nameId) const noexcept;
+
+    /**
+     * Retrieve the name of a node.
+     *
+     * @param nodeIndex
+     * The array-index of a node within the graph.
+     *
+     * @return A pointer to a null-terminated string containing the node's
+     * name. The pointer remains valid until a new name is added to
+     * "nameTable."
+     */
+    const char* get_node_name(const size_t nodeIndex) const noexcept;
+
     /**
      * Retrieve the total number of children hierarchially attached to a
      * SceneNode.
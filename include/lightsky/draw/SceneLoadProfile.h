@@ -0,0 +1,311 @@
+
+#ifndef __LS_DRAW_SCENE_LOAD_PROFILE_H__
+#define __LS_DRAW_SCENE_LOAD_PROFILE_H__
+
+#include <chrono>
+#include <cstdint> // uint64_t
+#include <string>
+
+
+
+namespace ls
+{
+namespace draw
+{
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief Phases of the scene loading pipeline which can be profiled.
+ *
+ * Phases run by a SceneFilePreLoader may execute on a worker thread, while
+ * those run by a SceneFileLoader execute on the GL thread. Work which is
+ * divided among multiple threads is measured by the thread which waits for
+ * it to complete.
+-----------------------------------------------------------------------------*/
+enum scene_load_phase_t : unsigned
+{
+    // Reading the input file through Assimp, mapping a binary cache, or
+    // parsing a glTF file and its buffers.
+    SCENE_LOAD_PHASE_FILE_READ,
+
+    // Welding, instancing, and sizing all meshes prior to allocation.
+    SCENE_LOAD_PHASE_PRELOAD,
+
+    // Allocation of the CPU-side scene graph.
+    SCENE_LOAD_PHASE_CPU_ALLOC,
+
+    // Allocation of all VBOs, IBOs, and VAOs.
+    SCENE_LOAD_PHASE_GPU_ALLOC,
+
+    // Material import, texture decoding, and texture uploads.
+    SCENE_LOAD_PHASE_TEXTURES,
+
+    // Vertex and index conversion, decompression, and uploads.
+    SCENE_LOAD_PHASE_MESHES,
+
+    // Import of the node hierarchy, cameras, and skins.
+    SCENE_LOAD_PHASE_HIERARCHY,
+
+    // Import of all animations.
+    SCENE_LOAD_PHASE_ANIMATIONS,
+
+    // Writing a binary cache after a file was imported.
+    SCENE_LOAD_PHASE_CACHE_WRITE,
+
+    SCENE_LOAD_PHASE_COUNT
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief Retrieve the name of a load phase, as written into JSON reports.
+ *
+ * @param phase
+ * The load phase to query.
+ *
+ * @return A null-terminated string containing the name of "phase," or
+ * "unknown" if the phase is invalid.
+-----------------------------------------------------------------------------*/
+const char* get_scene_load_phase_name(const scene_load_phase_t phase) noexcept;
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief Measurements of a single load phase.
+-----------------------------------------------------------------------------*/
+struct SceneLoadPhaseStats
+{
+    /**
+     * @brief wallTimeMicros contains the total time spent in a phase, in
+     * microseconds.
+     */
+    uint64_t wallTimeMicros;
+
+    /**
+     * @brief numBytes contains the number of bytes read, converted, or
+     * uploaded by a phase, if known.
+     */
+    uint64_t numBytes;
+
+    /**
+     * @brief numAllocations contains the number of buffers, textures, and
+     * scene arrays allocated by a phase.
+     */
+    uint64_t numAllocations;
+
+    /**
+     * @brief allocatedBytes contains the size of all allocations made by a
+     * phase, if known.
+     */
+    uint64_t allocatedBytes;
+
+    /**
+     * @brief numCalls contains the number of times a phase was entered.
+     */
+    uint64_t numCalls;
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief Timing and memory report of a single scene load.
+ *
+ * Profiling is opt-in. No measurements are made, and no clocks are queried,
+ * unless "enabled" has been set before a file is loaded.
+-----------------------------------------------------------------------------*/
+struct SceneLoadProfile
+{
+    /**
+     * @brief enabled determines if measurements are recorded. This is not
+     * modified when a profile is reset.
+     */
+    bool enabled = false;
+
+    /**
+     * @brief filepath contains the path of the file being profiled.
+     */
+    std::string filepath;
+
+    /**
+     * @brief phases contains the measurements of each load phase, indexed
+     * by scene_load_phase_t.
+     */
+    SceneLoadPhaseStats phases[SCENE_LOAD_PHASE_COUNT] = {};
+
+    /**
+     * @brief Clear all measurements, keeping the enabled state.
+     */
+    void reset() noexcept;
+
+    /**
+     * @brief Add to the time spent within a phase.
+     *
+     * @param phase
+     * The phase which was measured.
+     *
+     * @param micros
+     * The elapsed time, in microseconds.
+     */
+    void add_time(const scene_load_phase_t phase, const uint64_t micros) noexcept;
+
+    /**
+     * @brief Add to the number of bytes processed by a phase.
+     *
+     * @param phase
+     * The phase which processed data.
+     *
+     * @param numBytes
+     * The number of bytes read, converted, or uploaded.
+     */
+    void add_bytes(const scene_load_phase_t phase, const uint64_t numBytes) noexcept;
+
+    /**
+     * @brief Record an allocation made by a phase.
+     *
+     * @param phase
+     * The phase which allocated memory.
+     *
+     * @param numBytes
+     * The size of the allocation, or 0 if unknown.
+     */
+    void add_allocation(const scene_load_phase_t phase, const uint64_t numBytes = 0) noexcept;
+
+    /**
+     * @brief Retrieve the time spent within all phases.
+     *
+     * @return The sum of all phase timings, in microseconds.
+     */
+    uint64_t get_total_micros() const noexcept;
+
+    /**
+     * @brief Export all measurements as a JSON object.
+     *
+     * The object contains the profiled file path, the total time, and an
+     * array of phases containing the name and measurements of each phase.
+     *
+     * @return A string containing the JSON report.
+     */
+    std::string to_json() const noexcept;
+};
+
+
+
+/*-------------------------------------
+ * Add phase timing
+-------------------------------------*/
+inline void SceneLoadProfile::add_time(const scene_load_phase_t phase, const uint64_t micros) noexcept
+{
+    if (enabled)
+    {
+        phases[phase].wallTimeMicros += micros;
+        phases[phase].numCalls += 1;
+    }
+}
+
+
+
+/*-------------------------------------
+ * Add processed bytes
+-------------------------------------*/
+inline void SceneLoadProfile::add_bytes(const scene_load_phase_t phase, const uint64_t numBytes) noexcept
+{
+    if (enabled)
+    {
+        phases[phase].numBytes += numBytes;
+    }
+}
+
+
+
+/*-------------------------------------
+ * Add an allocation
+-------------------------------------*/
+inline void SceneLoadProfile::add_allocation(const scene_load_phase_t phase, const uint64_t numBytes) noexcept
+{
+    if (enabled)
+    {
+        phases[phase].numAllocations += 1;
+        phases[phase].allocatedBytes += numBytes;
+    }
+}
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief Scoped timer which adds its lifetime to a phase of a
+ * SceneLoadProfile.
+-----------------------------------------------------------------------------*/
+class SceneLoadTimer
+{
+  private:
+    typedef std::chrono::steady_clock clock_type;
+
+    SceneLoadProfile* pProfile;
+
+    scene_load_phase_t phase;
+
+    clock_type::time_point startTime;
+
+  public:
+    /**
+     * @brief Destructor
+     *
+     * Adds the elapsed time to the profile's current phase.
+     */
+    ~SceneLoadTimer() noexcept;
+
+    /**
+     * @brief Constructor
+     *
+     * Starts timing a phase. Nothing is measured if profiling is disabled.
+     *
+     * @param profile
+     * The profile which receives the elapsed time. This must outlive *this.
+     *
+     * @param loadPhase
+     * The phase being measured.
+     */
+    SceneLoadTimer(SceneLoadProfile& profile, const scene_load_phase_t loadPhase) noexcept;
+
+    SceneLoadTimer(const SceneLoadTimer&) = delete;
+
+    SceneLoadTimer(SceneLoadTimer&&) = delete;
+
+    SceneLoadTimer& operator=(const SceneLoadTimer&) = delete;
+
+    SceneLoadTimer& operator=(SceneLoadTimer&&) = delete;
+};
+
+
+
+/*-------------------------------------
+ * Destructor
+-------------------------------------*/
+inline SceneLoadTimer::~SceneLoadTimer() noexcept
+{
+    if (pProfile)
+    {
+        const uint64_t elapsedMicros = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(clock_type::now() - startTime).count();
+        pProfile->add_time(phase, elapsedMicros);
+    }
+}
+
+
+
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+inline SceneLoadTimer::SceneLoadTimer(SceneLoadProfile& profile, const scene_load_phase_t loadPhase) noexcept :
+    pProfile{profile.enabled ? &profile : nullptr},
+    phase{loadPhase},
+    startTime{profile.enabled ? clock_type::now() : clock_type::time_point{}}
+{
+}
+
+
+
+} // end draw namespace
+} // end ls namespace
+
+#endif /* __LS_DRAW_SCENE_LOAD_PROFILE_H__ */
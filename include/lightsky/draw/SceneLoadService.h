@@ -0,0 +1,480 @@
+
+#ifndef __LS_DRAW_SCENE_LOAD_SERVICE_H__
+#define __LS_DRAW_SCENE_LOAD_SERVICE_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint> // uint64_t
+#include <deque>
+#include <future>
+#include <memory> // std::shared_ptr
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "lightsky/draw/SceneFileLoader.h"
+
+
+
+namespace ls
+{
+namespace draw
+{
+
+/*-----------------------------------------------------------------------------
+ * Forward declarations
+-----------------------------------------------------------------------------*/
+class SceneLoadService;
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief Stages which an asynchronous scene load passes through.
+-----------------------------------------------------------------------------*/
+enum class scene_load_status_t : unsigned
+{
+    SCENE_LOAD_QUEUED,
+    SCENE_LOAD_PRELOADING,
+    SCENE_LOAD_PRELOADED,
+    SCENE_LOAD_UPLOADING,
+    SCENE_LOAD_COMPLETE,
+    SCENE_LOAD_FAILED,
+    SCENE_LOAD_CANCELLED
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief A SceneLoadRequest tracks a single file which is loaded through a
+ * SceneLoadService.
+ *
+ * Requests are shared between the calling thread, worker threads, and the GL
+ * thread through a SceneLoadHandle. All status queries may be made from any
+ * thread.
+-----------------------------------------------------------------------------*/
+class SceneLoadRequest
+{
+    friend class SceneLoadService;
+
+  private:
+    /**
+     * @brief filepath contains the path of the file being loaded.
+     */
+    std::string filepath;
+
+    /**
+     * @brief cacheFlags determines how binary scene caches are used while
+     * preloading.
+     */
+    scene_cache_mode_t cacheFlags;
+
+    /**
+     * @brief packedTypes determines which vertex attributes are stored using
+     * compact encodings.
+     */
+    common_vertex_t packedTypes;
+
+    /**
+     * @brief importProfile determines which mesh optimizations are performed
+     * by Assimp while preloading.
+     */
+    scene_import_profile_t importProfile;
+
+    /**
+     * @brief status contains the current stage of the load.
+     */
+    std::atomic<scene_load_status_t> status;
+
+    /**
+     * @brief preloader contains all CPU-side data, generated on a worker
+     * thread.
+     */
+    SceneFilePreLoader preloader;
+
+    /**
+     * @brief loader contains the final scene data once it has been uploaded
+     * by the GL thread.
+     */
+    SceneFileLoader loader;
+
+    /**
+     * @brief promise is fulfilled once the request has completed, failed, or
+     * been cancelled.
+     */
+    std::promise<scene_load_status_t> promise;
+
+    /**
+     * @brief future is shared with all callers waiting on the request.
+     */
+    std::shared_future<scene_load_status_t> future;
+
+    /**
+     * @brief Set the final status of *this and notify all waiting threads.
+     *
+     * @param finalStatus
+     * Either SCENE_LOAD_COMPLETE, SCENE_LOAD_FAILED, or SCENE_LOAD_CANCELLED.
+     */
+    void finish(const scene_load_status_t finalStatus) noexcept;
+
+  public:
+    /**
+     * @brief Destructor
+     */
+    ~SceneLoadRequest() noexcept;
+
+    /**
+     * @brief Constructor
+     *
+     * @param filename
+     * The path of a file to load.
+     *
+     * @param cacheMode
+     * Determines how binary scene caches are used while preloading.
+     *
+     * @param packedVertTypes
+     * A bitmask of PACKED_*_VERTEX flags which replace floating-point vertex
+     * attributes.
+     *
+     * @param importMode
+     * Determines which mesh optimizations are performed by Assimp, and if
+     * meshes use base-vertex draws.
+     */
+    SceneLoadRequest(
+        const std::string& filename,
+        const scene_cache_mode_t cacheMode,
+        const common_vertex_t packedVertTypes,
+        const scene_import_profile_t importMode = SCENE_IMPORT_DEFAULT
+    ) noexcept;
+
+    /**
+     * @brief Copy Constructor
+     *
+     * Deleted as requests are shared between threads.
+     */
+    SceneLoadRequest(const SceneLoadRequest&) noexcept = delete;
+
+    /**
+     * @brief Move Constructor
+     *
+     * Deleted as requests are shared between threads.
+     */
+    SceneLoadRequest(SceneLoadRequest&&) noexcept = delete;
+
+    /**
+     * @brief Copy Operator
+     *
+     * Deleted as requests are shared between threads.
+     */
+    SceneLoadRequest& operator=(const SceneLoadRequest&) noexcept = delete;
+
+    /**
+     * @brief Move Operator
+     *
+     * Deleted as requests are shared between threads.
+     */
+    SceneLoadRequest& operator=(SceneLoadRequest&&) noexcept = delete;
+
+    /**
+     * @brief Retrieve the path of the file being loaded.
+     *
+     * @return A constant reference to the requested file path.
+     */
+    const std::string& get_filepath() const noexcept;
+
+    /**
+     * @brief Retrieve the current stage of the load.
+     *
+     * @return A value from the scene_load_status_t enumeration.
+     */
+    scene_load_status_t get_status() const noexcept;
+
+    /**
+     * @brief Retrieve the approximate progress of the load.
+     *
+     * Progress is reported per-stage as ASSIMP and the GL upload cannot be
+     * interrupted.
+     *
+     * @return A value within the range [0, 1].
+     */
+    float get_progress() const noexcept;
+
+    /**
+     * @brief Determine if the load has completed, failed, or been cancelled.
+     *
+     * @return TRUE if no further work will be performed for *this, FALSE if
+     * not.
+     */
+    bool is_finished() const noexcept;
+
+    /**
+     * @brief Retrieve a future which becomes ready once *this has finished.
+     *
+     * Do not wait on the future from the thread which calls
+     * "SceneLoadService::update(...)" as the GL upload would never run.
+     *
+     * @return A shared future containing the final status of the load.
+     */
+    std::shared_future<scene_load_status_t> get_future() const noexcept;
+
+    /**
+     * @brief Retrieve the loaded scene.
+     *
+     * This may only be accessed once "get_status()" returns
+     * SCENE_LOAD_COMPLETE.
+     *
+     * @return A reference to the SceneFileLoader containing the uploaded
+     * scene. Its data may be moved elsewhere by the caller.
+     */
+    SceneFileLoader& get_loader() noexcept;
+};
+
+
+
+/*-------------------------------------
+ * Handle to an asynchronous scene load.
+-------------------------------------*/
+typedef std::shared_ptr<SceneLoadRequest> SceneLoadHandle;
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief The SceneLoadService preloads scene files on a pool of worker threads
+ * and uploads them to the GPU from the GL thread within a time budget.
+ *
+ * Each request uses its own SceneFilePreLoader, and therefore its own ASSIMP
+ * importer, so multiple files are imported concurrently. Once preloaded, a
+ * request is queued until "update(...)" is called from the thread which owns
+ * the current OpenGL context.
+-----------------------------------------------------------------------------*/
+class SceneLoadService
+{
+  private:
+    /**
+     * @brief workers contains all threads which preload scene files.
+     */
+    std::vector<std::thread> workers;
+
+    /**
+     * @brief threadsPerLoad limits the number of threads used by each
+     * parallel stage of a single request.
+     */
+    unsigned threadsPerLoad;
+
+    /**
+     * @brief queueLock protects "workers," "threadsPerLoad," "preloadQueue,"
+     * and "shouldStop."
+     */
+    std::mutex queueLock;
+
+    /**
+     * @brief queueCond notifies worker threads that a request was added.
+     */
+    std::condition_variable queueCond;
+
+    /**
+     * @brief preloadQueue contains all requests waiting for a worker thread.
+     */
+    std::deque<SceneLoadHandle> preloadQueue;
+
+    /**
+     * @brief uploadLock protects "uploadQueue."
+     */
+    std::mutex uploadLock;
+
+    /**
+     * @brief uploadQueue contains all preloaded requests waiting for the GL
+     * thread.
+     */
+    std::deque<SceneLoadHandle> uploadQueue;
+
+    /**
+     * @brief shouldStop is used to notify all worker threads to exit.
+     */
+    bool shouldStop;
+
+    /**
+     * @brief Main loop for all worker threads.
+     */
+    void thread_loop() noexcept;
+
+  public:
+    /**
+     * @brief Destructor
+     *
+     * Cancels all pending requests and joins all worker threads.
+     */
+    ~SceneLoadService() noexcept;
+
+    /**
+     * @brief Constructor
+     *
+     * No threads are started until "init(...)" is called.
+     */
+    SceneLoadService() noexcept;
+
+    /**
+     * @brief Copy Constructor
+     *
+     * Deleted as worker threads reference *this.
+     */
+    SceneLoadService(const SceneLoadService&) noexcept = delete;
+
+    /**
+     * @brief Move Constructor
+     *
+     * Deleted as worker threads reference *this.
+     */
+    SceneLoadService(SceneLoadService&&) noexcept = delete;
+
+    /**
+     * @brief Copy Operator
+     *
+     * Deleted as worker threads reference *this.
+     */
+    SceneLoadService& operator=(const SceneLoadService&) noexcept = delete;
+
+    /**
+     * @brief Move Operator
+     *
+     * Deleted as worker threads reference *this.
+     */
+    SceneLoadService& operator=(SceneLoadService&&) noexcept = delete;
+
+    /**
+     * @brief Start the worker threads.
+     *
+     * @param numThreads
+     * The number of files which can be preloaded concurrently. A value of 0
+     * will use the number of available hardware threads.
+     *
+     * @param numThreadsPerLoad
+     * The maximum number of threads used by each parallel stage of a single
+     * request, including its worker thread. Requests are already loaded
+     * concurrently, so the default of 1 avoids oversubscribing the CPU. A
+     * value of 0 will use the number of available hardware threads.
+     *
+     * @return TRUE if all threads were started, FALSE if not.
+     */
+    bool init(unsigned numThreads = 0, const unsigned numThreadsPerLoad = 1) noexcept;
+
+    /**
+     * @brief Cancel all pending requests and join all worker threads.
+     *
+     * Requests which are currently being preloaded are allowed to finish
+     * before being cancelled.
+     */
+    void terminate() noexcept;
+
+    /**
+     * @brief Queue a single file to be loaded.
+     *
+     * @param filename
+     * The path of a scene file.
+     *
+     * @param cacheMode
+     * Determines how binary scene caches are used while preloading.
+     *
+     * @param packedVertTypes
+     * A bitmask of PACKED_*_VERTEX flags which replace floating-point vertex
+     * attributes.
+     *
+     * @param importProfile
+     * Determines which mesh optimizations are performed by Assimp, and if
+     * meshes use base-vertex draws.
+     *
+     * @return A handle which can be used to query the progress and result of
+     * the load. The handle is marked as SCENE_LOAD_FAILED if "init(...)" has
+     * not started any worker threads.
+     */
+    SceneLoadHandle load(
+        const std::string& filename,
+        const scene_cache_mode_t cacheMode = SCENE_CACHE_READ_WRITE,
+        const common_vertex_t packedVertTypes = (common_vertex_t)0,
+        const scene_import_profile_t importProfile = SCENE_IMPORT_DEFAULT
+    ) noexcept;
+
+    /**
+     * @brief Queue multiple files to be loaded concurrently.
+     *
+     * @param filenames
+     * The paths of all scene files to load.
+     *
+     * @param cacheMode
+     * Determines how binary scene caches are used while preloading.
+     *
+     * @param packedVertTypes
+     * A bitmask of PACKED_*_VERTEX flags which replace floating-point vertex
+     * attributes.
+     *
+     * @param importProfile
+     * Determines which mesh optimizations are performed by Assimp, and if
+     * meshes use base-vertex draws.
+     *
+     * @return A list of handles, in the same order as the input paths. Each
+     * handle is marked as SCENE_LOAD_FAILED if "init(...)" has not started
+     * any worker threads.
+     */
+    std::vector<SceneLoadHandle> load(
+        const std::vector<std::string>& filenames,
+        const scene_cache_mode_t cacheMode = SCENE_CACHE_READ_WRITE,
+        const common_vertex_t packedVertTypes = (common_vertex_t)0,
+        const scene_import_profile_t importProfile = SCENE_IMPORT_DEFAULT
+    ) noexcept;
+
+    /**
+     * @brief Cancel a request which has not yet been uploaded.
+     *
+     * @param handle
+     * A handle returned from "load(...)".
+     *
+     * @return TRUE if the request was cancelled, FALSE if it is already being
+     * preloaded, uploaded, or has finished.
+     */
+    bool cancel(const SceneLoadHandle& handle) noexcept;
+
+    /**
+     * @brief Upload preloaded scenes to the GPU.
+     *
+     * This must be called from the thread which owns the current OpenGL
+     * context, usually once per frame. At least one scene is uploaded per call
+     * if any are available. Further scenes are only uploaded while the time
+     * spent remains within the budget. A single scene's upload is not split
+     * across multiple calls.
+     *
+     * @param budgetMicros
+     * The maximum number of microseconds to spend uploading scenes.
+     *
+     * @return The number of scenes which finished uploading.
+     */
+    unsigned update(const uint64_t budgetMicros) noexcept;
+
+    /**
+     * @brief Retrieve the number of requests which have not been uploaded.
+     *
+     * @return The number of queued and preloaded requests. Requests which
+     * are currently being preloaded are not counted.
+     */
+    size_t get_num_pending() noexcept;
+
+    /**
+     * @brief Retrieve the number of worker threads.
+     *
+     * @return The number of files which can be preloaded concurrently.
+     */
+    unsigned get_num_threads() const noexcept;
+};
+
+
+
+/*-------------------------------------
+ * Retrieve the number of threads
+-------------------------------------*/
+inline unsigned SceneLoadService::get_num_threads() const noexcept
+{
+    return (unsigned)workers.size();
+}
+} // end draw namespace
+} // end ls namespace
+
+#endif /* __LS_DRAW_SCENE_LOAD_SERVICE_H__ */
@@ -42,6 +42,19 @@ struct MeshMetaData
      */
     uint32_t totalVerts;
 
+    /**
+     * BaseVertex contains the index of a mesh's first vertex, relative to the
+     * first vertex referenced by its VAO. Index values already include this
+     * offset.
+     */
+    uint32_t baseVertex;
+
+    /**
+     * VboOffset contains the byte offset of a mesh's first vertex within its
+     * VBO.
+     */
+    uint32_t vboOffset;
+
     /**
      * IndexType contains the data type used by OpenGL to take indices from an
      * IBO and reference vertices in a VBO.
@@ -54,6 +67,16 @@ struct MeshMetaData
      */
     uint32_t totalIndices;
 
+    /**
+     * DequantScale and DequantBias restore the object-space positions of a
+     * mesh which uses PACKED_POSITION_VERTEX. Positions are reconstructed
+     * as "packedPos.xyz * dequantScale + dequantBias." These contain
+     * (1, 1, 1) and (0, 0, 0), respectively, for all other meshes.
+     */
+    math::vec3 dequantScale;
+
+    math::vec3 dequantBias;
+
     /**
      * @brief Calculate the size of the currently used vertex type.
      * 
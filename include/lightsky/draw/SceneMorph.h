@@ -0,0 +1,150 @@
+
+#ifndef __LS_DRAW_SCENE_MORPH_H__
+#define __LS_DRAW_SCENE_MORPH_H__
+
+#include <string>
+#include <vector>
+
+#include "lightsky/math/vec3.h"
+
+
+
+namespace ls
+{
+namespace draw
+{
+
+/**----------------------------------------------------------------------------
+ * @brief Morph target limits
+ *
+ * The weights of all morph targets in a mesh are stored in a single uniform
+ * block as an array of vec4's. Texels in the morph delta texture are
+ * addressed using a fixed row width.
+-----------------------------------------------------------------------------*/
+enum morph_property_t : unsigned
+{
+    MORPH_MAX_TARGETS = 64,
+    MORPH_TEXTURE_WIDTH = 1024,
+    MORPH_TEXELS_PER_DELTA = 2
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief A SceneMorphDelta contains the offset of a single vertex within a
+ * single morph target.
+-----------------------------------------------------------------------------*/
+struct SceneMorphDelta
+{
+    /**
+     * @brief position contains the change in a vertex's position when its
+     * target is fully applied.
+     */
+    math::vec3 position;
+
+    /**
+     * @brief normal contains the change in a vertex's normal when its target
+     * is fully applied.
+     */
+    math::vec3 normal;
+
+    /**
+     * @brief targetId contains the index of the morph target which the delta
+     * belongs to.
+     */
+    unsigned targetId;
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief A SceneMorph contains the sparse morph targets (blend shapes) which
+ * deform a single mesh.
+ *
+ * Only vertices which are modified by a target have deltas stored. Deltas are
+ * grouped by vertex so a vertex shader only needs to iterate over the deltas
+ * which affect the current vertex.
+-----------------------------------------------------------------------------*/
+struct SceneMorph
+{
+    /**
+     * @brief baseVertex contains the index of a mesh's first vertex within
+     * its VAO. This is used to convert "gl_VertexID" into a mesh-local vertex
+     * index.
+     */
+    unsigned baseVertex = 0;
+
+    /**
+     * @brief numVerts contains the number of vertices in the morphed mesh.
+     */
+    unsigned numVerts = 0;
+
+    /**
+     * @brief vertOffsets contains the index of the first delta of each
+     * vertex, plus one additional element containing the total number of
+     * deltas. The deltas of vertex "i" are in the range
+     * [vertOffsets[i], vertOffsets[i+1]).
+     */
+    std::vector<unsigned> vertOffsets;
+
+    /**
+     * @brief deltas contains the non-zero offsets of all morph targets.
+     */
+    std::vector<SceneMorphDelta> deltas;
+
+    /**
+     * @brief targetNames contains the name of each morph target.
+     */
+    std::vector<std::string> targetNames;
+
+    /**
+     * @brief weights contains the current weight of each morph target. These
+     * are modified by animations and sent to the GPU through a
+     * MorphTargetBuffer.
+     */
+    std::vector<float> weights;
+
+    /**
+     * @brief Retrieve the number of morph targets which deform a mesh.
+     *
+     * @return The number of morph targets contained within *this.
+     */
+    size_t get_num_targets() const noexcept;
+
+    /**
+     * @brief Remove all morph targets from *this.
+     */
+    void reset() noexcept;
+};
+
+
+
+/*-------------------------------------
+ * Retrieve the target count
+-------------------------------------*/
+inline size_t SceneMorph::get_num_targets() const noexcept
+{
+    return weights.size();
+}
+
+
+
+/**------------------------------------
+ * @brief Apply the current morph target weights to a set of vertex positions
+ * on the CPU.
+ *
+ * This function is intended for headless use (collision, picking, bounding
+ * volume updates) when a vertex shader can't evaluate morph targets.
+ *
+ * @param morph
+ * A constant reference to the morph targets of a mesh.
+ *
+ * @param pPositions
+ * A pointer to an array of at least "morph.numVerts" positions which will be
+ * offset by each active morph target.
+-------------------------------------*/
+void morph_vertex_positions(const SceneMorph& morph, math::vec3* const pPositions) noexcept;
+} // end draw namespace
+} // end ls namespace
+
+#endif /* __LS_DRAW_SCENE_MORPH_H__ */
@@ -0,0 +1,315 @@
+
+#ifndef __LS_DRAW_SCENE_NAME_TABLE_H__
+#define __LS_DRAW_SCENE_NAME_TABLE_H__
+
+#include <cstdint> // uint32_t
+#include <memory> // std::shared_ptr
+#include <string>
+#include <vector>
+
+#include "lightsky/utils/Hash.h"
+
+
+
+namespace ls
+{
+namespace draw
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * Interned name identifiers
+-----------------------------------------------------------------------------*/
+typedef uint32_t scene_name_t;
+
+enum scene_name_property_t : scene_name_t
+{
+    SCENE_NAME_INVALID = 0xFFFFFFFF
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief The SceneNameTable class stores each unique name used by a scene
+ * graph exactly once.
+ *
+ * Names are referenced by 32-bit IDs, allowing two names from the same table
+ * to be compared using a single integer comparison. All characters are kept
+ * within one contiguous buffer and the hash of each name is computed once,
+ * when the name is first interned.
+ *
+ * Names are never removed from a table, so an ID remains valid for the
+ * lifetime of a table and all of its copies. Copies share storage until one
+ * of them interns a new name, at which point it receives its own storage.
+-----------------------------------------------------------------------------*/
+class SceneNameTable
+{
+  private:
+    /**
+     * @brief The location and hash of a single name.
+     */
+    struct NameEntry
+    {
+        uint32_t offset;
+
+        uint32_t numChars;
+
+        utils::hash_t hash;
+    };
+
+    /**
+     * @brief Storage which can be shared by multiple tables.
+     */
+    struct NameData
+    {
+        /**
+         * @brief chars contains all names, each followed by a null
+         * terminator.
+         */
+        std::vector<char> chars;
+
+        /**
+         * @brief entries contains the location of each name, indexed by its
+         * ID.
+         */
+        std::vector<NameEntry> entries;
+
+        /**
+         * @brief buckets is an open-addressed hash table of name IDs. Its
+         * size is always a power of two and empty slots contain
+         * SCENE_NAME_INVALID.
+         */
+        std::vector<scene_name_t> buckets;
+    };
+
+    /**
+     * @brief pData contains all names in *this. This is NULL if no names have
+     * been interned.
+     */
+    std::shared_ptr<NameData> pData;
+
+    /**
+     * @brief Retrieve storage which can be modified without affecting any
+     * copies of *this.
+     *
+     * @return A reference to storage owned only by *this.
+     */
+    NameData& get_unique_data() noexcept;
+
+    /**
+     * @brief Place a name ID into the first empty bucket for its hash.
+     *
+     * @param buckets
+     * The hash table to modify.
+     *
+     * @param hash
+     * The hash of the name being inserted.
+     *
+     * @param nameId
+     * The ID of the name being inserted.
+     */
+    static void insert_bucket(std::vector<scene_name_t>& buckets, const utils::hash_t hash, const scene_name_t nameId) noexcept;
+
+    /**
+     * @brief Search for a name.
+     *
+     * @param pName
+     * A pointer to the characters of a name.
+     *
+     * @param numChars
+     * The number of characters in the name.
+     *
+     * @param hash
+     * The hash of the name.
+     *
+     * @return The ID of the name, or SCENE_NAME_INVALID if it has not been
+     * interned.
+     */
+    scene_name_t find_name(const char* pName, const size_t numChars, const utils::hash_t hash) const noexcept;
+
+    /**
+     * @brief Add a name to *this if it does not already exist.
+     *
+     * @param pName
+     * A pointer to a null-terminated name.
+     *
+     * @param numChars
+     * The number of characters in the name, excluding the null terminator.
+     *
+     * @return The ID of the name.
+     */
+    scene_name_t intern_name(const char* pName, const size_t numChars) noexcept;
+
+  public:
+    /**
+     * @brief Destructor
+     *
+     * Releases *this table's reference to its storage.
+     */
+    ~SceneNameTable() noexcept;
+
+    /**
+     * @brief Constructor
+     *
+     * Initializes an empty table. No memory is allocated.
+     */
+    SceneNameTable() noexcept;
+
+    /**
+     * @brief Copy Constructor
+     *
+     * Shares the storage of the input parameter. No names are copied.
+     *
+     * @param t
+     * A constant reference to another name table.
+     */
+    SceneNameTable(const SceneNameTable& t) noexcept;
+
+    /**
+     * @brief Move Constructor
+     *
+     * @param t
+     * An r-value reference to a temporary name table. The input parameter
+     * will be empty.
+     */
+    SceneNameTable(SceneNameTable&& t) noexcept;
+
+    /**
+     * @brief Copy Operator
+     *
+     * Shares the storage of the input parameter. No names are copied.
+     *
+     * @param t
+     * A constant reference to another name table.
+     *
+     * @return A reference to *this.
+     */
+    SceneNameTable& operator=(const SceneNameTable& t) noexcept;
+
+    /**
+     * @brief Move Operator
+     *
+     * @param t
+     * An r-value reference to a temporary name table. The input parameter
+     * will be empty.
+     *
+     * @return A reference to *this.
+     */
+    SceneNameTable& operator=(SceneNameTable&& t) noexcept;
+
+    /**
+     * @brief Add a name to *this, or retrieve the ID of an identical name
+     * which was previously added.
+     *
+     * @param pName
+     * A pointer to a null-terminated name.
+     *
+     * @return The ID of the name.
+     */
+    scene_name_t intern(const char* pName) noexcept;
+
+    /**
+     * @brief Add a name to *this, or retrieve the ID of an identical name
+     * which was previously added.
+     *
+     * @param name
+     * A constant reference to a string containing the name.
+     *
+     * @return The ID of the name.
+     */
+    scene_name_t intern(const std::string& name) noexcept;
+
+    /**
+     * @brief Retrieve the ID of a name without adding it to *this.
+     *
+     * @param pName
+     * A pointer to a null-terminated name.
+     *
+     * @return The ID of the name, or SCENE_NAME_INVALID if it has not been
+     * interned.
+     */
+    scene_name_t find(const char* pName) const noexcept;
+
+    /**
+     * @brief Retrieve the ID of a name without adding it to *this.
+     *
+     * @param name
+     * A constant reference to a string containing the name.
+     *
+     * @return The ID of the name, or SCENE_NAME_INVALID if it has not been
+     * interned.
+     */
+    scene_name_t find(const std::string& name) const noexcept;
+
+    /**
+     * @brief Retrieve the characters of a name.
+     *
+     * @param nameId
+     * The ID of a name within *this.
+     *
+     * @return A pointer to a null-terminated string, or an empty string if
+     * the ID is invalid. The pointer remains valid until a new name is
+     * interned by *this.
+     */
+    const char* get_name(const scene_name_t nameId) const noexcept;
+
+    /**
+     * @brief Retrieve the length of a name.
+     *
+     * @param nameId
+     * The ID of a name within *this.
+     *
+     * @return The number of characters in the name, excluding its null
+     * terminator, or 0 if the ID is invalid.
+     */
+    size_t get_name_length(const scene_name_t nameId) const noexcept;
+
+    /**
+     * @brief Retrieve the hash of a name.
+     *
+     * @param nameId
+     * The ID of a name within *this.
+     *
+     * @return The value of "utils::string_hash(...)" for the name, or the
+     * hash of an empty string if the ID is invalid.
+     */
+    utils::hash_t get_hash(const scene_name_t nameId) const noexcept;
+
+    /**
+     * @brief Retrieve the number of unique names in *this.
+     *
+     * @return The number of names which have been interned.
+     */
+    size_t size() const noexcept;
+
+    /**
+     * @brief Retrieve the number of bytes used by *this, including any
+     * storage shared with other tables.
+     *
+     * @return The size of all characters, entries, and hash buckets.
+     */
+    size_t get_num_bytes() const noexcept;
+
+    /**
+     * @brief Remove all names from *this. Copies of *this are unaffected.
+     */
+    void clear() noexcept;
+};
+
+
+
+/*-------------------------------------
+ * Get the number of names
+-------------------------------------*/
+inline size_t SceneNameTable::size() const noexcept
+{
+    return pData ? pData->entries.size() : 0;
+}
+
+
+
+} // end draw namespace
+} // end ls namespace
+
+#endif /* __LS_DRAW_SCENE_NAME_TABLE_H__ */
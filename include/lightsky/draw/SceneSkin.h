@@ -0,0 +1,142 @@
+
+#ifndef __LS_DRAW_SCENE_SKIN_H__
+#define __LS_DRAW_SCENE_SKIN_H__
+
+#include <vector>
+
+#include "lightsky/math/mat4.h"
+#include "lightsky/math/vec3.h"
+#include "lightsky/math/vec4.h"
+
+#include "lightsky/draw/VertexUtils.h"
+
+
+
+namespace ls
+{
+namespace draw
+{
+
+/*-----------------------------------------------------------------------------
+ * Forward declarations
+-----------------------------------------------------------------------------*/
+class SceneGraph;
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief Skinning limits
+ *
+ * Bone indices are stored as unsigned bytes within a vertex, limiting each
+ * mesh to 256 bones. This also keeps a full bone palette within the minimum
+ * uniform block size guaranteed by OpenGL (16KB).
+-----------------------------------------------------------------------------*/
+enum skin_property_t : unsigned
+{
+    SKIN_MAX_BONES = 256,
+    SKIN_MAX_VERTEX_INFLUENCES = 4
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief A SceneSkin contains the list of bones which deform a single mesh.
+ *
+ * Bone indices stored within a mesh's vertices reference the elements of
+ * *this.
+-----------------------------------------------------------------------------*/
+struct SceneSkin
+{
+    /**
+     * @brief boneIds contains the transform ID of each bone's scene node.
+     * Bones which no longer reference a node contain SCENE_GRAPH_ROOT_ID.
+     */
+    std::vector<size_t> boneIds;
+
+    /**
+     * @brief inverseBindPoses contains matrices which transform a mesh's
+     * vertices from model-space into the local space of each bone.
+     */
+    std::vector<math::mat4> inverseBindPoses;
+
+    /**
+     * @brief Retrieve the number of bones which deform a mesh.
+     *
+     * @return The number of bones contained within *this.
+     */
+    size_t get_num_bones() const noexcept;
+
+    /**
+     * @brief Remove all bones from *this.
+     */
+    void reset() noexcept;
+};
+
+
+
+/*-------------------------------------
+ * Retrieve the bone count
+-------------------------------------*/
+inline size_t SceneSkin::get_num_bones() const noexcept
+{
+    return boneIds.size();
+}
+
+
+
+/**------------------------------------
+ * @brief Calculate the bone palette for a single skinned mesh.
+ *
+ * Each palette matrix is the product of a bone's model matrix and its inverse
+ * bind pose. Skinned vertices are therefore transformed directly into
+ * world-space and should not have their mesh node's model matrix applied.
+ *
+ * @param graph
+ * A constant reference to the scene graph containing the current model
+ * matrix of each bone. "SceneGraph::update()" should be called beforehand.
+ *
+ * @param skin
+ * A constant reference to the skin who's palette will be calculated.
+ *
+ * @param pOutPalette
+ * A pointer to an array containing at least "skin.get_num_bones()" matrices.
+-------------------------------------*/
+void calc_skin_palette(const SceneGraph& graph, const SceneSkin& skin, math::mat4* const pOutPalette) noexcept;
+
+
+
+/**------------------------------------
+ * @brief Skin vertex positions on the CPU.
+ *
+ * This function is intended for headless use (collision, picking, bounding
+ * volume updates) when a vertex shader can't perform skinning. SIMD
+ * instructions are used when available.
+ *
+ * @param pPalette
+ * A pointer to a bone palette, calculated with "calc_skin_palette(...)".
+ *
+ * @param pVerts
+ * A pointer to a set of interleaved vertices which contain, at minimum, the
+ * POSITION_VERTEX, BONE_ID_VERTEX, and BONE_WEIGHT_VERTEX attributes.
+ *
+ * @param vertTypes
+ * The vertex attributes contained within "pVerts."
+ *
+ * @param numVerts
+ * The number of vertices to transform.
+ *
+ * @param pOutPositions
+ * A pointer to an array of at least "numVerts" positions which will contain
+ * the skinned vertex positions.
+-------------------------------------*/
+void skin_vertex_positions(
+    const math::mat4* const pPalette,
+    const char* const pVerts,
+    const common_vertex_t vertTypes,
+    const unsigned numVerts,
+    math::vec3* const pOutPositions
+) noexcept;
+} // end draw namespace
+} // end ls namespace
+
+#endif /* __LS_DRAW_SCENE_SKIN_H__ */
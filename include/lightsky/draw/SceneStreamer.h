@@ -0,0 +1,537 @@
+
+#ifndef __LS_DRAW_SCENE_STREAMER_H__
+#define __LS_DRAW_SCENE_STREAMER_H__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "lightsky/draw/BufferSuballocator.h"
+#include "lightsky/draw/SceneFileLoader.h"
+
+
+
+namespace ls
+{
+namespace draw
+{
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief Per-mesh streaming state.
+-----------------------------------------------------------------------------*/
+struct SceneStreamedMesh
+{
+    /**
+     * Byte offset of the mesh's vertices within the cached VBO payload.
+     */
+    uint64_t srcVboOffset;
+
+    /**
+     * Byte offset of the mesh's indices within the cached IBO payload.
+     */
+    uint64_t srcIboOffset;
+
+    /**
+     * Range of the mesh's compressed blocks within
+     * "SceneStreamer::meshBlocks." Unused for uncompressed caches.
+     */
+    uint32_t firstBlock;
+
+    uint32_t numBlocks;
+
+    /**
+     * Range of all draw commands which reference the mesh within
+     * "SceneStreamer::draws."
+     */
+    uint32_t firstDraw;
+
+    uint32_t numDraws;
+
+    /**
+     * Value which was added to every cached index. This is 0 if the cache
+     * was written with base-vertex draws.
+     */
+    uint32_t indexBias;
+
+    /**
+     * Byte offsets of the mesh within the streaming VBO and IBO while it is
+     * resident.
+     */
+    uint32_t vboOffset;
+
+    uint32_t iboOffset;
+
+    /**
+     * Frame on which any instance of the mesh was last visible.
+     */
+    uint32_t lastVisibleFrame;
+
+    /**
+     * Streaming priority, calculated during the most recent update. Lower
+     * values are loaded first. Meshes which should not be resident contain
+     * a value of infinity.
+     */
+    float priority;
+
+    /**
+     * Determines if the mesh currently resides within the streaming
+     * buffers.
+     */
+    bool isResident;
+
+    /**
+     * Set if the mesh contains no geometry or could not be decoded. These
+     * meshes are never requested.
+     */
+    bool isCorrupt;
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief A single draw of a streamed mesh by a scene node.
+-----------------------------------------------------------------------------*/
+struct SceneStreamedDraw
+{
+    /**
+     * Index of the node which draws the mesh.
+     */
+    uint32_t nodeId;
+
+    /**
+     * Index of the node's draw commands within "SceneGraph::nodeMeshes."
+     */
+    uint32_t nodeDataId;
+
+    /**
+     * Index of the draw command within the node's list of draw commands.
+     */
+    uint32_t subMeshId;
+
+    /**
+     * Index of the mesh within "SceneGraph::meshes."
+     */
+    uint32_t meshId;
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief The SceneStreamer class keeps the node hierarchy, bounds, materials,
+ * and textures of a scene resident while mesh payloads are only uploaded
+ * once they are needed.
+ *
+ * Scenes are streamed from their binary cache, which remains mapped while
+ * *this is loaded. Meshes are uploaded into a fixed-size VBO and IBO, sized
+ * from a residency budget, and are prioritized by their distance to the
+ * camera and their visibility. Meshes are evicted, farthest and least
+ * recently seen first, whenever the sum of
+ * "MeshMetaData::calc_total_bytes()" of all resident meshes would exceed the
+ * budget.
+ *
+ * The draw parameters of a mesh, and of every node which draws it, are
+ * updated whenever the mesh is uploaded or evicted. Non-resident meshes keep
+ * a valid VAO but draw zero indices, so a scene can be rendered without
+ * checking residency. Base-vertex draws are required so meshes can be placed
+ * anywhere within the streaming buffers.
+ *
+ * Nodes must not be added or removed from the loaded scene graph while it is
+ * being streamed.
+-----------------------------------------------------------------------------*/
+class SceneStreamer
+{
+  private:
+    /**
+     * @brief loader contains the scene graph and the mapped cache which
+     * meshes are streamed from.
+     */
+    SceneFileLoader loader;
+
+    /**
+     * @brief vboAllocator manages the ranges of the streaming VBO.
+     */
+    BufferSuballocator vboAllocator;
+
+    /**
+     * @brief iboAllocator manages the ranges of the streaming IBO.
+     */
+    BufferSuballocator iboAllocator;
+
+    /**
+     * @brief meshes contains the streaming state of every mesh in the scene
+     * graph, using the same indices.
+     */
+    std::vector<SceneStreamedMesh> meshes;
+
+    /**
+     * @brief draws contains every draw command in the scene graph which
+     * references a streamed mesh, sorted by mesh.
+     */
+    std::vector<SceneStreamedDraw> draws;
+
+    /**
+     * @brief meshBlocks contains the indices of all compressed cache blocks,
+     * grouped by mesh.
+     */
+    std::vector<uint32_t> meshBlocks;
+
+    /**
+     * @brief loadOrder is reused between updates to sort meshes by their
+     * priority.
+     */
+    std::vector<uint32_t> loadOrder;
+
+    /**
+     * @brief evictOrder is reused between updates to sort resident meshes
+     * from the lowest priority to the highest.
+     */
+    std::vector<uint32_t> evictOrder;
+
+    /**
+     * @brief scratch is reused while decoding compressed meshes.
+     */
+    std::vector<char> scratch;
+
+    /**
+     * @brief residencyBudget contains the maximum number of vertex and index
+     * bytes which can be resident.
+     */
+    uint64_t residencyBudget;
+
+    /**
+     * @brief residentBytes contains the number of vertex and index bytes
+     * which are currently resident.
+     */
+    uint64_t residentBytes;
+
+    /**
+     * @brief maxDistance contains the distance beyond which meshes are no
+     * longer requested.
+     */
+    float maxDistance;
+
+    /**
+     * @brief frameId is incremented on every update.
+     */
+    uint32_t frameId;
+
+    /**
+     * @brief Match every draw command in the scene graph to its mesh and
+     * group all compressed cache blocks by mesh.
+     *
+     * @return TRUE if all meshes and blocks could be located, FALSE if the
+     * cache is inconsistent.
+     */
+    bool init_streaming_data() noexcept;
+
+    /**
+     * @brief Calculate the streaming priority of every mesh.
+     *
+     * @param viewPos
+     * The world-space position of the camera.
+     *
+     * @param viewProjMatrix
+     * The camera's view-projection matrix.
+     */
+    void update_priorities(const math::vec3& viewPos, const math::mat4& viewProjMatrix) noexcept;
+
+    /**
+     * @brief Allocate space for a mesh and copy or decode its payload from
+     * the cache.
+     *
+     * @param meshId
+     * The index of a non-resident mesh.
+     *
+     * @return TRUE if the mesh was uploaded, FALSE if there was no space for
+     * it or it could not be decoded.
+     */
+    bool upload_mesh(const uint32_t meshId) noexcept;
+
+    /**
+     * @brief Release the GPU memory used by a resident mesh.
+     *
+     * @param meshId
+     * The index of a resident mesh.
+     */
+    void evict_mesh(const uint32_t meshId) noexcept;
+
+    /**
+     * @brief Update the draw parameters of a mesh, and all nodes which draw
+     * it, to match its residency.
+     *
+     * @param meshId
+     * The index of a mesh.
+     */
+    void update_draw_params(const uint32_t meshId) noexcept;
+
+  public:
+    /**
+     * @brief Destructor
+     *
+     * Unloads all data contain within *this.
+     */
+    ~SceneStreamer() noexcept;
+
+    /**
+     * @brief Constructor
+     *
+     * Initializes all members contained within *this.
+     */
+    SceneStreamer() noexcept;
+
+    /**
+     * @brief Copy Constructor
+     *
+     * Deleted as the streamed cache mapping can not be shared.
+     */
+    SceneStreamer(const SceneStreamer&) noexcept = delete;
+
+    /**
+     * @brief Move Constructor
+     *
+     * Moves all data from the input parameter into *this.
+     *
+     * @param s
+     * An r-value reference to a temporary SceneStreamer object.
+     */
+    SceneStreamer(SceneStreamer&& s) noexcept;
+
+    /**
+     * @brief Copy Operator
+     *
+     * Deleted as the streamed cache mapping can not be shared.
+     */
+    SceneStreamer& operator=(const SceneStreamer&) noexcept = delete;
+
+    /**
+     * @brief Move Operator
+     *
+     * Moves all data from the input parameter into *this.
+     *
+     * @param s
+     * An r-value reference to a temporary SceneStreamer object.
+     *
+     * @return A reference to *this.
+     */
+    SceneStreamer& operator=(SceneStreamer&& s) noexcept;
+
+    /**
+     * @brief Unload/free all memory used by *this.
+     */
+    void unload() noexcept;
+
+    /**
+     * @brief Load a scene file for streaming.
+     *
+     * If no up-to-date cache exists, the file is imported once in order to
+     * write it.
+     *
+     * @param filename
+     * The path of a 3D scene file.
+     *
+     * @param budgetBytes
+     * The maximum number of vertex and index bytes which may be resident.
+     *
+     * @param packedVertTypes
+     * A bitmask of PACKED_*_VERTEX flags which replace floating-point vertex
+     * attributes.
+     *
+     * @return TRUE if the scene was loaded, FALSE if not.
+     */
+    bool load(
+        const std::string& filename,
+        const uint64_t budgetBytes,
+        const common_vertex_t packedVertTypes = (common_vertex_t)0
+    ) noexcept;
+
+    /**
+     * @brief Stream a scene which was preloaded from a binary cache.
+     *
+     * @param preload
+     * An r-value reference to a scene preloader whose data was read from a
+     * binary cache.
+     *
+     * @param budgetBytes
+     * The maximum number of vertex and index bytes which may be resident.
+     *
+     * @return TRUE if the scene was loaded, FALSE if not.
+     */
+    bool load(SceneFilePreLoader&& preload, const uint64_t budgetBytes) noexcept;
+
+    /**
+     * @brief Upload and evict meshes based on the current camera.
+     *
+     * This must be called from the thread which owns the current OpenGL
+     * context, after the scene graph's transformations have been updated.
+     * Visible meshes are loaded before meshes which are only nearby, and
+     * closer meshes are loaded first.
+     *
+     * @param viewPos
+     * The world-space position of the camera.
+     *
+     * @param viewProjMatrix
+     * The camera's view-projection matrix, used to test mesh visibility.
+     *
+     * @param maxUploadBytes
+     * The maximum number of bytes to upload during this call, or 0 for no
+     * limit. At least one mesh is uploaded if any are needed.
+     *
+     * @return The number of meshes which were uploaded.
+     */
+    unsigned update(const math::vec3& viewPos, const math::mat4& viewProjMatrix, const uint64_t maxUploadBytes = 0) noexcept;
+
+    /**
+     * @brief Set the maximum number of vertex and index bytes which may be
+     * resident.
+     *
+     * The streaming buffers are sized when a scene is loaded, so increasing
+     * the budget beyond its initial value may not allow more meshes to be
+     * resident. Lowering the budget evicts meshes on the next update.
+     *
+     * @param budgetBytes
+     * The new residency budget.
+     */
+    void set_residency_budget(const uint64_t budgetBytes) noexcept;
+
+    /**
+     * @brief Retrieve the residency budget.
+     *
+     * @return The maximum number of vertex and index bytes which may be
+     * resident.
+     */
+    uint64_t get_residency_budget() const noexcept;
+
+    /**
+     * @brief Retrieve the number of bytes which are resident.
+     *
+     * @return The sum of "MeshMetaData::calc_total_bytes()" of all resident
+     * meshes.
+     */
+    uint64_t get_resident_bytes() const noexcept;
+
+    /**
+     * @brief Set the distance beyond which meshes are no longer requested.
+     *
+     * @param distance
+     * The maximum distance between the camera and the bounds of a mesh.
+     */
+    void set_max_distance(const float distance) noexcept;
+
+    /**
+     * @brief Retrieve the distance beyond which meshes are no longer
+     * requested.
+     *
+     * @return The maximum streaming distance.
+     */
+    float get_max_distance() const noexcept;
+
+    /**
+     * @brief Determine if a mesh currently resides on the GPU.
+     *
+     * @param meshId
+     * The index of a mesh within "SceneGraph::meshes."
+     *
+     * @return TRUE if the mesh can be drawn, FALSE if not.
+     */
+    bool is_mesh_resident(const size_t meshId) const noexcept;
+
+    /**
+     * @brief Retrieve the streamed scene graph.
+     *
+     * @return A constant reference to the loaded scene graph.
+     */
+    const SceneGraph& get_loaded_data() const noexcept;
+
+    /**
+     * @brief Retrieve the streamed scene graph.
+     *
+     * @return A reference to the loaded scene graph.
+     */
+    SceneGraph& get_loaded_data() noexcept;
+};
+
+
+
+/*-------------------------------------
+ * Set the residency budget
+-------------------------------------*/
+inline void SceneStreamer::set_residency_budget(const uint64_t budgetBytes) noexcept
+{
+    residencyBudget = budgetBytes;
+}
+
+
+
+/*-------------------------------------
+ * Retrieve the residency budget
+-------------------------------------*/
+inline uint64_t SceneStreamer::get_residency_budget() const noexcept
+{
+    return residencyBudget;
+}
+
+
+
+/*-------------------------------------
+ * Retrieve the number of resident bytes
+-------------------------------------*/
+inline uint64_t SceneStreamer::get_resident_bytes() const noexcept
+{
+    return residentBytes;
+}
+
+
+
+/*-------------------------------------
+ * Set the maximum streaming distance
+-------------------------------------*/
+inline void SceneStreamer::set_max_distance(const float distance) noexcept
+{
+    maxDistance = distance;
+}
+
+
+
+/*-------------------------------------
+ * Retrieve the maximum streaming distance
+-------------------------------------*/
+inline float SceneStreamer::get_max_distance() const noexcept
+{
+    return maxDistance;
+}
+
+
+
+/*-------------------------------------
+ * Check if a mesh is resident
+-------------------------------------*/
+inline bool SceneStreamer::is_mesh_resident(const size_t meshId) const noexcept
+{
+    return meshId < meshes.size() && meshes[meshId].isResident;
+}
+
+
+
+/*-------------------------------------
+ * Retrieve the loaded scene data (const)
+-------------------------------------*/
+inline const SceneGraph& SceneStreamer::get_loaded_data() const noexcept
+{
+    return loader.get_loaded_data();
+}
+
+
+
+/*-------------------------------------
+ * Retrieve the loaded scene data
+-------------------------------------*/
+inline SceneGraph& SceneStreamer::get_loaded_data() noexcept
+{
+    return loader.get_loaded_data();
+}
+} // end draw namespace
+} // end ls namespace
+
+#endif /* __LS_DRAW_SCENE_STREAMER_H__ */
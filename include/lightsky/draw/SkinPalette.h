@@ -0,0 +1,206 @@
+
+#ifndef __LS_DRAW_SKIN_PALETTE_H__
+#define __LS_DRAW_SKIN_PALETTE_H__
+
+#include <vector>
+
+#include "lightsky/math/mat4.h"
+
+#include "lightsky/draw/UniformBuffer.h"
+
+
+
+namespace ls
+{
+namespace draw
+{
+
+/*-----------------------------------------------------------------------------
+ * Forward declarations
+-----------------------------------------------------------------------------*/
+class SceneGraph;
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief The SkinPalette class calculates the bone palettes of all skinned
+ * meshes in a scene graph and uploads them to the GPU for vertex-shader
+ * skinning.
+ *
+ * All palettes are stored within a single uniform buffer. Each mesh's palette
+ * starts at a multiple of the uniform buffer offset alignment and is always
+ * bound as a full block of SKIN_MAX_BONES matrices, matching the uniform
+ * block used by shaders, using "bind_palette(...)":
+ *
+ *      layout(std140) uniform BonePalette
+ *      {
+ *          mat4 bones[256];
+ *      };
+-----------------------------------------------------------------------------*/
+class SkinPalette
+{
+  private:
+    /**
+     * @brief matrices contains the palettes of all meshes, placed
+     * contiguously in the same layout as the GPU buffer.
+     */
+    std::vector<math::mat4> matrices;
+
+    /**
+     * @brief paletteOffsets contains the index of the first matrix of each
+     * mesh's palette within "matrices."
+     */
+    std::vector<size_t> paletteOffsets;
+
+    /**
+     * @brief ubo contains all bone palettes on the GPU.
+     */
+    UniformBuffer ubo;
+
+  public:
+    /**
+     * @brief Destructor
+     *
+     * Releases all CPU and GPU resources used by *this.
+     */
+    ~SkinPalette() noexcept;
+
+    /**
+     * @brief Constructor
+     *
+     * Initializes all members to their default values. No GPU data is
+     * allocated until "init(...)" is called.
+     */
+    SkinPalette() noexcept;
+
+    /**
+     * @brief Copy Constructor
+     *
+     * Copies all CPU-side data from the input parameter into *this. No GPU
+     * data is copied.
+     *
+     * @param p
+     * A constant reference to another SkinPalette object.
+     */
+    SkinPalette(const SkinPalette& p) noexcept;
+
+    /**
+     * @brief Move Constructor
+     *
+     * Moves all data from the input parameter into *this.
+     *
+     * @param p
+     * An r-value reference to a temporary SkinPalette object.
+     */
+    SkinPalette(SkinPalette&& p) noexcept;
+
+    /**
+     * @brief Copy Operator
+     *
+     * Copies all CPU-side data from the input parameter into *this. No GPU
+     * data is copied.
+     *
+     * @param p
+     * A constant reference to another SkinPalette object.
+     *
+     * @return A reference to *this.
+     */
+    SkinPalette& operator=(const SkinPalette& p) noexcept;
+
+    /**
+     * @brief Move Operator
+     *
+     * Moves all data from the input parameter into *this.
+     *
+     * @param p
+     * An r-value reference to a temporary SkinPalette object.
+     *
+     * @return A reference to *this.
+     */
+    SkinPalette& operator=(SkinPalette&& p) noexcept;
+
+    /**
+     * @brief Allocate CPU and GPU memory for all skinned meshes in a scene
+     * graph.
+     *
+     * @param graph
+     * A constant reference to the scene graph containing skinned meshes.
+     *
+     * @return TRUE if all memory was successfully allocated, FALSE if not.
+     */
+    bool init(const SceneGraph& graph) noexcept;
+
+    /**
+     * @brief Release all CPU and GPU memory used by *this.
+     */
+    void terminate() noexcept;
+
+    /**
+     * @brief Recalculate the palettes of all skinned meshes and upload them
+     * to the GPU.
+     *
+     * This should be called once per frame, after "SceneGraph::update()."
+     *
+     * @param graph
+     * A constant reference to the scene graph which was used to initialize
+     * *this.
+     *
+     * @param uploadToGpu
+     * Determines if the updated palettes should be sent to the GPU. Set this
+     * to FALSE when only CPU skinning is needed.
+     */
+    void update(const SceneGraph& graph, const bool uploadToGpu = true) noexcept;
+
+    /**
+     * @brief Bind the palette of a single mesh to a uniform block binding.
+     *
+     * @param meshId
+     * The index of a mesh within "SceneGraph::meshes."
+     *
+     * @param bindingIndex
+     * The uniform block binding point which a shader's bone palette uses.
+     */
+    void bind_palette(const size_t meshId, const unsigned bindingIndex) const noexcept;
+
+    /**
+     * @brief Retrieve the CPU copy of a mesh's bone palette.
+     *
+     * @param meshId
+     * The index of a mesh within "SceneGraph::meshes."
+     *
+     * @return A pointer to the first bone matrix of a mesh, suitable for use
+     * with "skin_vertex_positions(...)".
+     */
+    const math::mat4* get_palette(const size_t meshId) const noexcept;
+
+    /**
+     * @brief Retrieve the uniform buffer which contains all bone palettes.
+     *
+     * @return A constant reference to the uniform buffer used by *this.
+     */
+    const UniformBuffer& get_buffer() const noexcept;
+};
+
+
+
+/*-------------------------------------
+ * Retrieve a mesh palette
+-------------------------------------*/
+inline const math::mat4* SkinPalette::get_palette(const size_t meshId) const noexcept
+{
+    return matrices.data() + paletteOffsets[meshId];
+}
+
+
+
+/*-------------------------------------
+ * Retrieve the uniform buffer
+-------------------------------------*/
+inline const UniformBuffer& SkinPalette::get_buffer() const noexcept
+{
+    return ubo;
+}
+} // end draw namespace
+} // end ls namespace
+
+#endif /* __LS_DRAW_SKIN_PALETTE_H__ */
@@ -149,6 +149,18 @@ enum vertex_data_t : uint32_t
     VERTEX_DATA_2_10U = GL_UNSIGNED_INT_2_10_10_10_REV,
     VERTEX_DATA_2_10I = GL_INT_2_10_10_10_REV,
 
+    // Four unsigned bytes, packed into 32 bits. There's no OpenGL vertex type
+    // to match these so the equivalent texture formats are used instead.
+    VERTEX_DATA_VEC_4UB = GL_RGBA8UI,
+    VERTEX_DATA_VEC_4UBN = GL_RGBA8,
+
+    // Compact 16-bit types, also identified through texture formats.
+    // VEC_4USN contains four normalized unsigned shorts, VEC_2SN contains two
+    // normalized signed shorts, and VEC_2HF contains two half-floats.
+    VERTEX_DATA_VEC_4USN = GL_RGBA16UI,
+    VERTEX_DATA_VEC_2SN = GL_RG16I,
+    VERTEX_DATA_VEC_2HF = GL_RG16F,
+
     VERTEX_DATA_VEC_2B = GL_BOOL_VEC2,
     VERTEX_DATA_VEC_2I = GL_INT_VEC2,
     VERTEX_DATA_VEC_2UI = GL_UNSIGNED_INT_VEC2,
@@ -207,11 +219,22 @@ enum vertex_data_t : uint32_t
     TANGENT_VERTEX_TYPE = NORMAL_VERTEX_TYPE,
     BITANGENT_VERTEX_TYPE = NORMAL_VERTEX_TYPE,
 
+    // Compact alternatives to the above types. Positions are dequantized
+    // using a per-mesh transform and normals are octahedral-encoded.
+    PACKED_POSITION_VERTEX_TYPE = VERTEX_DATA_VEC_4USN,
+    PACKED_TEXTURE_VERTEX_TYPE = VERTEX_DATA_VEC_2HF,
+    PACKED_COLOR_VERTEX_TYPE = VERTEX_DATA_VEC_4UBN,
+
+    PACKED_NORMAL_VERTEX_TYPE = VERTEX_DATA_VEC_2SN,
+    PACKED_TANGENT_VERTEX_TYPE = PACKED_NORMAL_VERTEX_TYPE,
+    PACKED_BITANGENT_VERTEX_TYPE = PACKED_NORMAL_VERTEX_TYPE,
+
     // per-instance model matrix
     MODEL_MAT_VERTEX_TYPE = VERTEX_DATA_MAT_4F,
 
-    BONE_ID_VERTEX_TYPE = VERTEX_DATA_INT,
-    BONE_WEIGHT_VERTEX_TYPE = VERTEX_DATA_FLOAT,
+    // up to 4 bone indices and 4 normalized weights per vertex
+    BONE_ID_VERTEX_TYPE = VERTEX_DATA_VEC_4UB,
+    BONE_WEIGHT_VERTEX_TYPE = VERTEX_DATA_VEC_4UBN,
 
     AMBIENT_VERTEX_TYPE = COLOR_VERTEX_TYPE,
     DIFFUSE_VERTEX_TYPE = COLOR_VERTEX_TYPE,
@@ -235,12 +258,18 @@ enum vertex_data_t : uint32_t
 // "COMMON_VERTEX_FLAGS_LIST" array in "VertexUtils.h"
 constexpr vertex_data_t COMMON_VERTEX_TYPES_LIST[] = {
     vertex_data_t::POSITION_VERTEX_TYPE,
+    vertex_data_t::PACKED_POSITION_VERTEX_TYPE,
     vertex_data_t::TEXTURE_VERTEX_TYPE,
+    vertex_data_t::PACKED_TEXTURE_VERTEX_TYPE,
     vertex_data_t::COLOR_VERTEX_TYPE,
+    vertex_data_t::PACKED_COLOR_VERTEX_TYPE,
 
     vertex_data_t::NORMAL_VERTEX_TYPE,
+    vertex_data_t::PACKED_NORMAL_VERTEX_TYPE,
     vertex_data_t::TANGENT_VERTEX_TYPE,
+    vertex_data_t::PACKED_TANGENT_VERTEX_TYPE,
     vertex_data_t::BITANGENT_VERTEX_TYPE,
+    vertex_data_t::PACKED_BITANGENT_VERTEX_TYPE,
 
     vertex_data_t::MODEL_MAT_VERTEX_TYPE,
 
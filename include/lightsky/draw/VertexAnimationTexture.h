@@ -0,0 +1,403 @@
+
+#ifndef __LS_DRAW_VERTEX_ANIMATION_TEXTURE_H__
+#define __LS_DRAW_VERTEX_ANIMATION_TEXTURE_H__
+
+#include <vector>
+
+#include "lightsky/math/mat4.h"
+
+#include "lightsky/draw/Texture.h"
+#include "lightsky/draw/UniformBuffer.h"
+
+
+
+namespace ls
+{
+namespace draw
+{
+
+/*-----------------------------------------------------------------------------
+ * Forward declarations
+-----------------------------------------------------------------------------*/
+class SceneGraph;
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief Vertex animation texture limits
+-----------------------------------------------------------------------------*/
+enum vat_property_t : unsigned
+{
+    VAT_TEXTURE_WIDTH = 1024,
+    VAT_TEXELS_PER_INSTANCE = 4,
+    VAT_MIN_FRAMES = 2
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief A VertexAnimationInstance contains the per-instance data of a single
+ * crowd member.
+-----------------------------------------------------------------------------*/
+struct VertexAnimationInstance
+{
+    /**
+     * @brief The world-space transformation of an instance. Only the upper
+     * 3x4 portion of this matrix is sent to the GPU.
+     */
+    math::mat4 modelMatrix;
+
+    /**
+     * @brief Number of seconds to offset an instance's playback time by, so
+     * instances do not animate in lock-step.
+     */
+    float timeOffset;
+
+    /**
+     * @brief Playback speed multiplier of an instance.
+     */
+    float playbackRate;
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief The VertexAnimationTexture class bakes an Animation into a texture
+ * containing the deformed vertices of every frame, allowing large numbers of
+ * instances to be animated without CPU skinning or per-instance palettes.
+ *
+ * Baking plays an animation on a scene graph, applying the skin, morph
+ * targets, or node transformation of each mesh on the CPU. Each mesh is
+ * stored contiguously, with one position texel per vertex followed by one
+ * normal texel per vertex, for every frame. Frames are linearly interpolated
+ * in the vertex shader.
+ *
+ * Instance data is placed into a second RGBA32F texture, using four texels
+ * per instance: three rows of the model matrix and (timeOffset,
+ * playbackRate, 0, 0). Per-mesh information is stored within a uniform block
+ * which can be bound using "bind_mesh(...)":
+ *
+ *      layout(std140) uniform VertexAnimation
+ *      {
+ *          ivec4 vatInfo;   // baseVertex, firstTexel, numVerts, numFrames
+ *          vec4 vatTiming;  // seconds, 1/duration, 0, 0
+ *      };
+ *
+ * See "GLSL_SAMPLE_VERTEX_ANIMATION" for a matching shader implementation.
+-----------------------------------------------------------------------------*/
+class VertexAnimationTexture
+{
+  private:
+    /**
+     * @brief numFrames contains the number of frames baked for each mesh.
+     */
+    unsigned numFrames;
+
+    /**
+     * @brief durationSecs contains the length of the baked animation, in
+     * seconds.
+     */
+    float durationSecs;
+
+    /**
+     * @brief maxInstances contains the number of instances which the instance
+     * texture can hold.
+     */
+    unsigned maxInstances;
+
+    /**
+     * @brief blockStride contains the number of bytes between each mesh's
+     * uniform block, including padding for the UBO offset alignment.
+     */
+    size_t blockStride;
+
+    /**
+     * @brief meshOffsets contains the index of the first texel of each mesh
+     * within the frame texture.
+     */
+    std::vector<unsigned> meshOffsets;
+
+    /**
+     * @brief uniformData contains the CPU copy of all uniform blocks, placed
+     * contiguously in the same layout as the GPU buffer.
+     */
+    std::vector<char> uniformData;
+
+    /**
+     * @brief instanceData contains the CPU copy of the instance texture.
+     */
+    std::vector<float> instanceData;
+
+    /**
+     * @brief frameTex contains all baked vertex positions and normals.
+     */
+    Texture frameTex;
+
+    /**
+     * @brief instanceTex contains the transformation and time offset of all
+     * instances.
+     */
+    Texture instanceTex;
+
+    /**
+     * @brief ubo contains the playback information of all meshes.
+     */
+    UniformBuffer ubo;
+
+    /**
+     * @brief Release the baked frames and their playback information while
+     * keeping the instance data and uniform buffer.
+     */
+    void terminate_frames() noexcept;
+
+  public:
+    /**
+     * @brief Destructor
+     *
+     * Releases all CPU and GPU resources used by *this.
+     */
+    ~VertexAnimationTexture() noexcept;
+
+    /**
+     * @brief Constructor
+     *
+     * Initializes all members to their default values. No GPU data is
+     * allocated until "bake(...)" is called.
+     */
+    VertexAnimationTexture() noexcept;
+
+    /**
+     * @brief Copy Constructor
+     *
+     * Copies all CPU-side data from the input parameter into *this. No GPU
+     * data is copied.
+     *
+     * @param v
+     * A constant reference to another VertexAnimationTexture object.
+     */
+    VertexAnimationTexture(const VertexAnimationTexture& v) noexcept;
+
+    /**
+     * @brief Move Constructor
+     *
+     * Moves all data from the input parameter into *this.
+     *
+     * @param v
+     * An r-value reference to a temporary VertexAnimationTexture object.
+     */
+    VertexAnimationTexture(VertexAnimationTexture&& v) noexcept;
+
+    /**
+     * @brief Copy Operator
+     *
+     * Copies all CPU-side data from the input parameter into *this. No GPU
+     * data is copied.
+     *
+     * @param v
+     * A constant reference to another VertexAnimationTexture object.
+     *
+     * @return A reference to *this.
+     */
+    VertexAnimationTexture& operator=(const VertexAnimationTexture& v) noexcept;
+
+    /**
+     * @brief Move Operator
+     *
+     * Moves all data from the input parameter into *this.
+     *
+     * @param v
+     * An r-value reference to a temporary VertexAnimationTexture object.
+     *
+     * @return A reference to *this.
+     */
+    VertexAnimationTexture& operator=(VertexAnimationTexture&& v) noexcept;
+
+    /**
+     * @brief Bake an animation into a texture.
+     *
+     * Vertices are read back from each mesh's VBO. The transformations and
+     * morph target weights of the input graph are restored once baking has
+     * completed.
+     *
+     * @param graph
+     * A reference to the scene graph containing the meshes and animation to
+     * bake.
+     *
+     * @param animationIndex
+     * The index of the Animation within the input scene graph to bake.
+     *
+     * @param frameCount
+     * The number of evenly spaced frames to sample. The first and last
+     * frames are placed at the start and end of the animation.
+     *
+     * @param useHalfFloats
+     * Determines if frames should be stored using 16-bit floats. This halves
+     * the memory used but reduces the precision of large meshes.
+     *
+     * @return TRUE if all meshes were baked and uploaded, FALSE if not. Any
+     * previously baked frames are released on failure, but instance data
+     * remains available.
+     */
+    bool bake(
+        SceneGraph& graph,
+        const unsigned animationIndex,
+        const unsigned frameCount,
+        const bool useHalfFloats = false
+    ) noexcept;
+
+    /**
+     * @brief Allocate the texture which contains per-instance data.
+     *
+     * @param instanceCount
+     * The maximum number of instances which can be drawn at once.
+     *
+     * @return TRUE if the instance texture was created, FALSE if not.
+     */
+    bool init_instances(const unsigned instanceCount) noexcept;
+
+    /**
+     * @brief Release all resources.
+     */
+    void terminate() noexcept;
+
+    /**
+     * @brief Upload the data of a set of instances to the GPU.
+     *
+     * @param pInstances
+     * A pointer to an array of instances.
+     *
+     * @param instanceCount
+     * The number of instances to upload. This must not be greater than the
+     * value passed into "init_instances(...)".
+     */
+    void set_instances(const VertexAnimationInstance* const pInstances, const unsigned instanceCount) noexcept;
+
+    /**
+     * @brief Update the playback time shared by all instances.
+     *
+     * @param seconds
+     * The current playback time, in seconds. Each instance offsets this
+     * using its own time offset and playback rate.
+     */
+    void update(const float seconds) noexcept;
+
+    /**
+     * @brief Bind a single mesh's uniform block.
+     *
+     * @param meshId
+     * The index of a mesh within "SceneGraph::meshes."
+     *
+     * @param bindingIndex
+     * The uniform block binding point which a shader's "VertexAnimation"
+     * block uses.
+     */
+    void bind_mesh(const size_t meshId, const unsigned bindingIndex) const noexcept;
+
+    /**
+     * @brief Draw multiple instances of a single baked mesh.
+     *
+     * The mesh's VAO is bound and left bound once this function returns.
+     * The frame and instance textures, uniform block, and shader must be
+     * bound beforehand.
+     *
+     * @param graph
+     * A constant reference to the scene graph which was baked.
+     *
+     * @param meshId
+     * The index of a mesh within "SceneGraph::meshes."
+     *
+     * @param instanceCount
+     * The number of instances to draw.
+     */
+    void draw_instances(const SceneGraph& graph, const size_t meshId, const unsigned instanceCount) const noexcept;
+
+    /**
+     * @brief Retrieve the number of frames baked per mesh.
+     *
+     * @return The number of frames contained within the frame texture.
+     */
+    unsigned get_num_frames() const noexcept;
+
+    /**
+     * @brief Retrieve the length of the baked animation.
+     *
+     * @return The duration of the baked animation, in seconds.
+     */
+    float get_duration() const noexcept;
+
+    /**
+     * @brief Retrieve the texture which contains all baked frames.
+     *
+     * @return A constant reference to the frame texture used by *this.
+     */
+    const Texture& get_frame_texture() const noexcept;
+
+    /**
+     * @brief Retrieve the texture which contains all instance data.
+     *
+     * @return A constant reference to the instance texture used by *this.
+     */
+    const Texture& get_instance_texture() const noexcept;
+
+    /**
+     * @brief Retrieve the uniform buffer which contains all playback
+     * information.
+     *
+     * @return A constant reference to the uniform buffer used by *this.
+     */
+    const UniformBuffer& get_buffer() const noexcept;
+};
+
+
+
+/*-------------------------------------
+ * Retrieve the frame count
+-------------------------------------*/
+inline unsigned VertexAnimationTexture::get_num_frames() const noexcept
+{
+    return numFrames;
+}
+
+
+
+/*-------------------------------------
+ * Retrieve the animation length
+-------------------------------------*/
+inline float VertexAnimationTexture::get_duration() const noexcept
+{
+    return durationSecs;
+}
+
+
+
+/*-------------------------------------
+ * Retrieve the frame texture
+-------------------------------------*/
+inline const Texture& VertexAnimationTexture::get_frame_texture() const noexcept
+{
+    return frameTex;
+}
+
+
+
+/*-------------------------------------
+ * Retrieve the instance texture
+-------------------------------------*/
+inline const Texture& VertexAnimationTexture::get_instance_texture() const noexcept
+{
+    return instanceTex;
+}
+
+
+
+/*-------------------------------------
+ * Retrieve the uniform buffer
+-------------------------------------*/
+inline const UniformBuffer& VertexAnimationTexture::get_buffer() const noexcept
+{
+    return ubo;
+}
+} // end draw namespace
+} // end ls namespace
+
+#endif /* __LS_DRAW_VERTEX_ANIMATION_TEXTURE_H__ */
@@ -61,6 +61,24 @@ enum common_vertex_t : uint32_t
     BBOX_TRR_VERTEX = 0x00080000,
     BBOX_BFL_VERTEX = 0x00001000,
 
+    /**
+     * @brief Packed vertex types store the same data as their floating-point
+     * counterparts in fewer bytes. Only one of each pair should be used
+     * within a vertex.
+     *
+     * Packed positions are normalized 16-bit integers which must be
+     * transformed by a per-mesh scale and bias. Packed normals, tangents,
+     * and bitangents are octahedral-encoded. Packed UVs and colors are
+     * converted to floats by the GPU and require no decoding in GLSL.
+     */
+    PACKED_POSITION_VERTEX = 0x00002000,
+    PACKED_TEXTURE_VERTEX = 0x00004000,
+    PACKED_COLOR_VERTEX = 0x00008000,
+
+    PACKED_NORMAL_VERTEX = 0x00000100,
+    PACKED_TANGENT_VERTEX = 0x00000200,
+    PACKED_BITANGENT_VERTEX = 0x00000400,
+
 
     /**
      * @brief A standard vertex is the most commonly supported collection of
@@ -92,6 +110,19 @@ enum common_vertex_t : uint32_t
                         | BBOX_TRR_VERTEX
                         | BBOX_BFL_VERTEX
                         | 0),
+
+    /**
+     * @brief A packed vertex replaces every floating-point attribute with a
+     * compact encoding.
+     */
+    PACKED_VERTEX = (0
+                     | PACKED_POSITION_VERTEX
+                     | PACKED_TEXTURE_VERTEX
+                     | PACKED_COLOR_VERTEX
+                     | PACKED_NORMAL_VERTEX
+                     | PACKED_TANGENT_VERTEX
+                     | PACKED_BITANGENT_VERTEX
+                     | 0),
 };
 
 
@@ -100,12 +131,18 @@ enum common_vertex_t : uint32_t
 // "COMMON_VERTEX_TYPES_LIST" array in "Vertex.h"
 constexpr common_vertex_t COMMON_VERTEX_FLAGS_LIST[] = {
     common_vertex_t::POSITION_VERTEX,
+    common_vertex_t::PACKED_POSITION_VERTEX,
     common_vertex_t::TEXTURE_VERTEX,
+    common_vertex_t::PACKED_TEXTURE_VERTEX,
     common_vertex_t::COLOR_VERTEX,
+    common_vertex_t::PACKED_COLOR_VERTEX,
 
     common_vertex_t::NORMAL_VERTEX,
+    common_vertex_t::PACKED_NORMAL_VERTEX,
     common_vertex_t::TANGENT_VERTEX,
+    common_vertex_t::PACKED_TANGENT_VERTEX,
     common_vertex_t::BITANGENT_VERTEX,
+    common_vertex_t::PACKED_BITANGENT_VERTEX,
 
     common_vertex_t::MODEL_MAT_VERTEX,
 
@@ -169,6 +206,29 @@ constexpr char VERT_ATTRIB_NAME_TANGENT[] = "tangAttrib";
  */
 constexpr char VERT_ATTRIB_NAME_BITANGENT[] = "btngAttrib";
 
+/**
+ * @brief Common name for a vertex attribute containing quantized positions.
+ */
+constexpr char VERT_ATTRIB_NAME_PACKED_POSITION[] = "packedPosAttrib";
+
+/**
+ * @brief Common name for a vertex attribute containing octahedral-encoded
+ * vertex normals.
+ */
+constexpr char VERT_ATTRIB_NAME_PACKED_NORMAL[] = "packedNormAttrib";
+
+/**
+ * @brief Common name for a vertex attribute containing octahedral-encoded
+ * vertex tangents.
+ */
+constexpr char VERT_ATTRIB_NAME_PACKED_TANGENT[] = "packedTangAttrib";
+
+/**
+ * @brief Common name for a vertex attribute containing octahedral-encoded
+ * vertex bi-tangents.
+ */
+constexpr char VERT_ATTRIB_NAME_PACKED_BITANGENT[] = "packedBtngAttrib";
+
 /**
  * @brief Common name for a vertex attribute containing model matrices.
  */
@@ -177,12 +237,12 @@ constexpr char VERT_ATTRIB_NAME_MODEL_MATRIX[] = "modelMatAttrib";
 /**
  * @brief Common name for a vertex attribute containing skeletal bone IDs.
  */
-constexpr char VERT_ATTRIB_NAME_BONE_ID[] = "boneWeightAttrib";
+constexpr char VERT_ATTRIB_NAME_BONE_ID[] = "boneIdAttrib";
 
 /**
  * @brief Common name for a vertex attribute containing skeletal bone weights.
  */
-constexpr char VERT_ATTRIB_NAME_BONE_WEIGHT[] = "boneIdAttrib";
+constexpr char VERT_ATTRIB_NAME_BONE_WEIGHT[] = "boneWeightAttrib";
 
 /**
  * @brief Common name for an ambient lighting vertex attribute.
@@ -229,6 +289,9 @@ constexpr char VERT_ATTRIB_NAME_BBOX_BFL[] = "bboxBFLAttrib";
 /**
  * @Brief the COMMON_VERTEX_NAMES_LIST array helps to keep track of all vertex
  * names and make iteration over them easier in client code.
+ *
+ * Packed UVs and colors share their names with TEXTURE_VERTEX and
+ * COLOR_VERTEX as shaders receive them as floats either way.
  */
 const char* const* get_common_vertex_names() noexcept;
 
@@ -274,6 +337,22 @@ inline unsigned get_vertex_stride(const common_vertex_t vertexTypes)
     return get_vertex_byte_size(vertexTypes);
 }
 
+/**------------------------------------
+ * @brief Replace floating-point vertex types with their packed equivalents.
+ *
+ * @param vertexTypes
+ * A bitmask of common_vertex_t flags, representing all of the vertex elements
+ * within a vertex buffer.
+ *
+ * @param packedTypes
+ * A bitmask of PACKED_*_VERTEX flags. Each unpacked type within
+ * "vertexTypes" is replaced by its packed counterpart if it is listed here.
+ *
+ * @return A bitmask of common_vertex_t flags with the requested attributes
+ * replaced by their packed types.
+-------------------------------------*/
+common_vertex_t get_packed_vertex_types(const common_vertex_t vertexTypes, const common_vertex_t packedTypes) noexcept;
+
 
 
 /*-----------------------------------------------------------------------------
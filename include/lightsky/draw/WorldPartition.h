@@ -0,0 +1,438 @@
+
+#ifndef __LS_DRAW_WORLD_PARTITION_H__
+#define __LS_DRAW_WORLD_PARTITION_H__
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "lightsky/draw/SceneGraph.h"
+#include "lightsky/draw/SceneLoadService.h"
+
+
+
+namespace ls
+{
+namespace draw
+{
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief Residency of a single world cell.
+-----------------------------------------------------------------------------*/
+enum class world_cell_status_t : unsigned
+{
+    WORLD_CELL_UNLOADED,
+    WORLD_CELL_LOADING,
+    WORLD_CELL_RESIDENT,
+    WORLD_CELL_FAILED
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief Approximate memory used by a resident world cell.
+-----------------------------------------------------------------------------*/
+struct WorldCellMemory
+{
+    /**
+     * Bytes used by the CPU-side arrays of a cell's scene graph.
+     */
+    uint64_t cpuBytes;
+
+    /**
+     * Bytes of vertex and index data uploaded to the GPU.
+     */
+    uint64_t geometryBytes;
+
+    /**
+     * Bytes used by the base level of every texture.
+     */
+    uint64_t textureBytes;
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief A WorldCell maps one cell of a world grid to a scene file.
+-----------------------------------------------------------------------------*/
+struct WorldCell
+{
+    /**
+     * Integer coordinate of the cell within the grid.
+     */
+    math::vec3i coord;
+
+    /**
+     * Path of the scene file which contains the cell's contents. Its binary
+     * cache is used if one is available.
+     */
+    std::string filepath;
+
+    /**
+     * Current residency of the cell.
+     */
+    world_cell_status_t status;
+
+    /**
+     * Pending load request while the cell is loading.
+     */
+    SceneLoadHandle request;
+
+    /**
+     * Contents of the cell while it is resident.
+     */
+    SceneGraph scene;
+
+    /**
+     * Memory used by the cell while it is resident.
+     */
+    WorldCellMemory memory;
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief A resident cell, as seen by a renderer.
+-----------------------------------------------------------------------------*/
+struct WorldCellView
+{
+    /**
+     * Index of the cell within its WorldPartition.
+     */
+    size_t cellId;
+
+    /**
+     * Non-owning pointer to the cell's scene. Node transforms and draw
+     * commands are referenced in place rather than copied.
+     */
+    SceneGraph* pScene;
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief The WorldPartition class streams the cells of a large world, each
+ * contained within a separate scene file, around one or more cameras.
+ *
+ * The world is split into a grid of equally sized, axis-aligned cells. A
+ * cell size of zero along an axis ignores that axis, producing a 2D grid.
+ * Cells are loaded asynchronously through a SceneLoadService once any camera
+ * comes within the load radius and are unloaded once all cameras are beyond
+ * the unload radius. Keeping the unload radius larger than the load radius
+ * prevents cells from being repeatedly loaded and unloaded near a boundary.
+ *
+ * Scene files are expected to be exported in world space, so no additional
+ * transformation is applied to a cell's nodes.
+-----------------------------------------------------------------------------*/
+class WorldPartition
+{
+  private:
+    /**
+     * @brief loadService preloads cells on worker threads.
+     */
+    SceneLoadService loadService;
+
+    /**
+     * @brief cells contains every cell which was added to the grid.
+     */
+    std::vector<WorldCell> cells;
+
+    /**
+     * @brief cellIds maps a packed grid coordinate to an index in "cells."
+     */
+    std::unordered_map<uint64_t, size_t> cellIds;
+
+    /**
+     * @brief residentView contains all resident cells, sorted by index.
+     */
+    std::vector<WorldCellView> residentView;
+
+    /**
+     * @brief loadOrder is reused between updates to sort requested cells by
+     * their distance to the nearest camera.
+     */
+    std::vector<std::pair<float, size_t>> loadOrder;
+
+    /**
+     * @brief cellOrigin contains the world-space position of the minimum
+     * corner of the cell at (0, 0, 0).
+     */
+    math::vec3 cellOrigin;
+
+    /**
+     * @brief cellSize contains the world-space dimensions of every cell.
+     */
+    math::vec3 cellSize;
+
+    /**
+     * @brief loadRadius contains the distance from a camera at which cells
+     * are requested.
+     */
+    float loadRadius;
+
+    /**
+     * @brief unloadRadius contains the distance from all cameras at which
+     * cells are unloaded.
+     */
+    float unloadRadius;
+
+    /**
+     * @brief cacheMode determines how binary scene caches are used while
+     * loading cells.
+     */
+    scene_cache_mode_t cacheMode;
+
+    /**
+     * @brief Calculate the distance between a point and the bounds of a
+     * cell.
+     *
+     * @param coord
+     * The grid coordinate of a cell.
+     *
+     * @param point
+     * A world-space position.
+     *
+     * @return The distance between the point and the cell, or 0 if the point
+     * is within it.
+     */
+    float calc_cell_distance(const math::vec3i& coord, const math::vec3& point) const noexcept;
+
+    /**
+     * @brief Release the scene of a resident cell.
+     *
+     * @param cell
+     * A reference to a resident cell.
+     */
+    void unload_cell(WorldCell& cell) noexcept;
+
+    /**
+     * @brief Rebuild the list of resident cells.
+     */
+    void update_view() noexcept;
+
+  public:
+    /**
+     * @brief Destructor
+     *
+     * Cancels all pending loads and releases all resident cells.
+     */
+    ~WorldPartition() noexcept;
+
+    /**
+     * @brief Constructor
+     *
+     * No threads are started until "init(...)" is called.
+     */
+    WorldPartition() noexcept;
+
+    /**
+     * @brief Copy Constructor
+     *
+     * Deleted as worker threads can not be shared.
+     */
+    WorldPartition(const WorldPartition&) noexcept = delete;
+
+    /**
+     * @brief Move Constructor
+     *
+     * Deleted as worker threads can not be moved.
+     */
+    WorldPartition(WorldPartition&&) noexcept = delete;
+
+    /**
+     * @brief Copy Operator
+     *
+     * Deleted as worker threads can not be shared.
+     */
+    WorldPartition& operator=(const WorldPartition&) noexcept = delete;
+
+    /**
+     * @brief Move Operator
+     *
+     * Deleted as worker threads can not be moved.
+     */
+    WorldPartition& operator=(WorldPartition&&) noexcept = delete;
+
+    /**
+     * @brief Set the grid layout and start the loading threads.
+     *
+     * @param origin
+     * The world-space position of the minimum corner of the cell at
+     * (0, 0, 0).
+     *
+     * @param size
+     * The world-space dimensions of every cell. A value of 0 along an axis
+     * ignores that axis.
+     *
+     * @param numThreads
+     * The number of cells which can be preloaded concurrently. A value of 0
+     * will use the number of available hardware threads.
+     *
+     * @param cacheFlags
+     * Determines how binary scene caches are used while loading cells.
+     *
+     * @return TRUE if the loading threads were started, FALSE if not.
+     */
+    bool init(
+        const math::vec3& origin,
+        const math::vec3& size,
+        const unsigned numThreads = 0,
+        const scene_cache_mode_t cacheFlags = SCENE_CACHE_READ_WRITE
+    ) noexcept;
+
+    /**
+     * @brief Cancel all pending loads, release all cells, and join all
+     * loading threads.
+     */
+    void terminate() noexcept;
+
+    /**
+     * @brief Map a grid cell to a scene file.
+     *
+     * @param coord
+     * The grid coordinate of the cell. Each axis must be within the range
+     * [-1048576, 1048575].
+     *
+     * @param filepath
+     * The path of the scene file which contains the cell's contents.
+     *
+     * @return The index of the cell, or the index of the existing cell if the
+     * coordinate was already mapped.
+     */
+    size_t add_cell(const math::vec3i& coord, const std::string& filepath) noexcept;
+
+    /**
+     * @brief Locate a cell by its grid coordinate.
+     *
+     * @param coord
+     * The grid coordinate of a cell.
+     *
+     * @return The index of the cell, or SCENE_GRAPH_ROOT_ID if no cell was
+     * mapped to the coordinate.
+     */
+    size_t find_cell(const math::vec3i& coord) const noexcept;
+
+    /**
+     * @brief Convert a world-space position into a grid coordinate.
+     *
+     * @param point
+     * A world-space position.
+     *
+     * @return The coordinate of the cell which contains the point.
+     */
+    math::vec3i get_cell_coord(const math::vec3& point) const noexcept;
+
+    /**
+     * @brief Set the distances at which cells are loaded and unloaded.
+     *
+     * @param loadDistance
+     * Cells within this distance of any camera are requested.
+     *
+     * @param unloadDistance
+     * Cells beyond this distance from every camera are unloaded. This is
+     * clamped so it is never less than "loadDistance."
+     */
+    void set_radii(const float loadDistance, const float unloadDistance) noexcept;
+
+    /**
+     * @brief Request, upload, and unload cells around a set of cameras.
+     *
+     * This must be called from the thread which owns the current OpenGL
+     * context, usually once per frame.
+     *
+     * @param cameraPositions
+     * The world-space position of every camera which cells are streamed
+     * around.
+     *
+     * @param budgetMicros
+     * The maximum number of microseconds to spend uploading cells, as used
+     * by "SceneLoadService::update(...)."
+     *
+     * @return TRUE if the set of resident cells changed, FALSE if not.
+     */
+    bool update(const std::vector<math::vec3>& cameraPositions, const uint64_t budgetMicros) noexcept;
+
+    /**
+     * @brief Retrieve all resident cells.
+     *
+     * The returned pointers remain valid until the next call to "update()",
+     * "add_cell()", or "terminate()."
+     *
+     * @return A list of every resident cell's scene.
+     */
+    const std::vector<WorldCellView>& get_resident_cells() const noexcept;
+
+    /**
+     * @brief Retrieve the number of mapped cells.
+     *
+     * @return The number of cells which were added to the grid.
+     */
+    size_t get_num_cells() const noexcept;
+
+    /**
+     * @brief Retrieve a single cell.
+     *
+     * @param cellId
+     * The index of a cell.
+     *
+     * @return A constant reference to the requested cell.
+     */
+    const WorldCell& get_cell(const size_t cellId) const noexcept;
+
+    /**
+     * @brief Retrieve the memory used by all resident cells.
+     *
+     * @return The sum of every resident cell's memory.
+     */
+    WorldCellMemory get_resident_memory() const noexcept;
+};
+
+
+
+/*-------------------------------------
+ * Retrieve all resident cells
+-------------------------------------*/
+inline const std::vector<WorldCellView>& WorldPartition::get_resident_cells() const noexcept
+{
+    return residentView;
+}
+
+
+
+/*-------------------------------------
+ * Retrieve the number of cells
+-------------------------------------*/
+inline size_t WorldPartition::get_num_cells() const noexcept
+{
+    return cells.size();
+}
+
+
+
+/*-------------------------------------
+ * Retrieve a single cell
+-------------------------------------*/
+inline const WorldCell& WorldPartition::get_cell(const size_t cellId) const noexcept
+{
+    return cells[cellId];
+}
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief Calculate the approximate memory used by a loaded scene graph.
+ *
+ * @param graph
+ * A constant reference to a scene graph which has been uploaded to the GPU.
+ *
+ * @return The memory used by the scene graph's CPU arrays, its meshes, and
+ * its textures.
+-----------------------------------------------------------------------------*/
+WorldCellMemory calc_scene_memory(const SceneGraph& graph) noexcept;
+} // end draw namespace
+} // end ls namespace
+
+#endif /* __LS_DRAW_WORLD_PARTITION_H__ */
@@ -1,4 +1,5 @@
 
+#include <atomic>
 #include <functional>
 #include <utility>
 
@@ -8,11 +9,30 @@
 
 #include "lightsky/draw/Animation.h"
 #include "lightsky/draw/SceneGraph.h"
+#include "lightsky/draw/SceneMorph.h"
 #include "lightsky/draw/SceneNode.h"
 #include "lightsky/draw/Transform.h"
 
 
 
+/*-----------------------------------------------------------------------------
+ * Anonymous helper functions
+-----------------------------------------------------------------------------*/
+namespace
+{
+
+/*-------------------------------------
+ * Generate a unique clip ID
+-------------------------------------*/
+uint64_t next_animation_clip_id() noexcept
+{
+    static std::atomic<uint64_t> nextClipId{1};
+    return nextClipId.fetch_add(1, std::memory_order_relaxed);
+}
+} // end anonymous namespace
+
+
+
 namespace ls
 {
 namespace draw
@@ -38,12 +58,16 @@ Animation::~Animation() noexcept
 Animation::Animation() noexcept :
     playMode{animation_play_t::ANIM_PLAY_DEFAULT},
     animationId{0},
+    clipId{next_animation_clip_id()},
     totalTicks{0},
     ticksPerSec{0.0},
-    animName{""},
+    animName{SCENE_NAME_INVALID},
     animationIds{},
     nodeTrackIds{},
-    transformIds{}
+    transformIds{},
+    morphMeshIds{},
+    morphTargetIds{},
+    morphFrames{}
 {
 }
 
@@ -55,12 +79,16 @@ Animation::Animation() noexcept :
 Animation::Animation(const Animation& a) noexcept :
     playMode{a.playMode},
     animationId{a.animationId},
+    clipId{a.clipId},
     totalTicks{a.totalTicks},
     ticksPerSec{a.ticksPerSec},
     animName{a.animName},
     animationIds{a.animationIds},
     nodeTrackIds{a.nodeTrackIds},
-    transformIds{a.transformIds}
+    transformIds{a.transformIds},
+    morphMeshIds{a.morphMeshIds},
+    morphTargetIds{a.morphTargetIds},
+    morphFrames{a.morphFrames}
 {
 }
 
@@ -72,17 +100,23 @@ Animation::Animation(const Animation& a) noexcept :
 Animation::Animation(Animation&& a) noexcept :
     playMode{a.playMode},
     animationId{a.animationId},
+    clipId{a.clipId},
     totalTicks{a.totalTicks},
     ticksPerSec{a.ticksPerSec},
-    animName{std::move(a.animName)},
+    animName{a.animName},
     animationIds{std::move(a.animationIds)},
     nodeTrackIds{std::move(a.nodeTrackIds)},
-    transformIds{std::move(a.transformIds)}
+    transformIds{std::move(a.transformIds)},
+    morphMeshIds{std::move(a.morphMeshIds)},
+    morphTargetIds{std::move(a.morphTargetIds)},
+    morphFrames{std::move(a.morphFrames)}
 {
     a.playMode = animation_play_t::ANIM_PLAY_DEFAULT;
     a.animationId = 0;
+    a.clipId = next_animation_clip_id();
     a.totalTicks = 0.0;
     a.ticksPerSec = 0.0;
+    a.animName = SCENE_NAME_INVALID;
 }
 
 
@@ -94,12 +128,16 @@ Animation& Animation::operator=(const Animation& a) noexcept
 {
     playMode = a.playMode;
     animationId = a.animationId;
+    clipId = a.clipId;
     totalTicks = a.totalTicks;
     ticksPerSec = a.ticksPerSec;
     animName = a.animName;
     animationIds = a.animationIds;
     nodeTrackIds = a.nodeTrackIds;
     transformIds = a.transformIds;
+    morphMeshIds = a.morphMeshIds;
+    morphTargetIds = a.morphTargetIds;
+    morphFrames = a.morphFrames;
 
     return *this;
 }
@@ -117,16 +155,24 @@ Animation& Animation::operator=(Animation&& a) noexcept
     animationId = a.animationId;
     a.animationId = 0;
 
+    clipId = a.clipId;
+    a.clipId = next_animation_clip_id();
+
     totalTicks = a.totalTicks;
     a.totalTicks = 0.0;
 
     ticksPerSec = a.ticksPerSec;
     a.ticksPerSec = 0.0;
 
-    animName = std::move(a.animName);
+    animName = a.animName;
+    a.animName = SCENE_NAME_INVALID;
+
     animationIds = std::move(a.animationIds);
     nodeTrackIds = std::move(a.nodeTrackIds);
     transformIds = std::move(a.transformIds);
+    morphMeshIds = std::move(a.morphMeshIds);
+    morphTargetIds = std::move(a.morphTargetIds);
+    morphFrames = std::move(a.morphFrames);
 
     return *this;
 }
@@ -164,15 +210,46 @@ size_t Animation::get_anim_id() const noexcept
 
 
 /*-------------------------------------
- * Retrieve the Animation's name
+ * Retrieve the Animation's clip ID
+-------------------------------------*/
+uint64_t Animation::get_clip_id() const noexcept
+{
+    return clipId;
+}
+
+
+
+/*-------------------------------------
+ * Retrieve the Animation's name ID
 -------------------------------------*/
-const std::string& Animation::get_anim_name() const noexcept
+scene_name_t Animation::get_anim_name_id() const noexcept
 {
     return animName;
 }
 
 
 
+/*-------------------------------------
+ * Retrieve the Animation's name
+-------------------------------------*/
+const char* Animation::get_anim_name(const SceneNameTable& names) const noexcept
+{
+    return names.get_name(animName);
+}
+
+
+
+/*-------------------------------------
+ * Set the Animation's name
+-------------------------------------*/
+void Animation::set_anim_name(const SceneNameTable& names, const scene_name_t nameId) noexcept
+{
+    animName = nameId;
+    animationId = names.get_hash(nameId);
+}
+
+
+
 /*-------------------------------------
  * Set the Animation duration (ticks per second)
 -------------------------------------*/
@@ -263,6 +340,7 @@ void Animation::add_anim_channel(const SceneNode& node, const size_t nodeTrackId
     animationIds.push_back(node.animListId);
     nodeTrackIds.push_back(nodeTrackId);
     transformIds.push_back(node.nodeId);
+    clipId = next_animation_clip_id();
 }
 
 
@@ -280,6 +358,7 @@ void Animation::remove_anim_channel(const size_t channelIndex) noexcept
     animationIds.erase(animationIds.begin() + channelIndex);
     nodeTrackIds.erase(nodeTrackIds.begin() + channelIndex);
     transformIds.erase(transformIds.begin() + channelIndex);
+    clipId = next_animation_clip_id();
 }
 
 
@@ -292,6 +371,7 @@ void Animation::clear_anim_channels() noexcept
     animationIds.clear();
     nodeTrackIds.clear();
     transformIds.clear();
+    clipId = next_animation_clip_id();
 }
 
 
@@ -308,6 +388,72 @@ void Animation::reserve_anim_channels(const size_t reserveSize) noexcept
 
 
 
+/*-------------------------------------
+ * Get the number of morph target tracks
+-------------------------------------*/
+size_t Animation::get_num_morph_channels() const noexcept
+{
+    LS_DEBUG_ASSERT(morphMeshIds.size() == morphTargetIds.size());
+    LS_DEBUG_ASSERT(morphMeshIds.size() == morphFrames.size());
+    return morphMeshIds.size();
+}
+
+
+
+/*-------------------------------------
+ * Get the meshes of all morph target tracks
+-------------------------------------*/
+const std::vector<size_t>& Animation::get_morph_meshes() const noexcept
+{
+    return morphMeshIds;
+}
+
+
+
+/*-------------------------------------
+ * Get the targets of all morph target tracks
+-------------------------------------*/
+const std::vector<unsigned>& Animation::get_morph_targets() const noexcept
+{
+    return morphTargetIds;
+}
+
+
+
+/*-------------------------------------
+ * Get the keyframes of all morph target tracks
+-------------------------------------*/
+const std::vector<AnimationKeyListFloat>& Animation::get_morph_frames() const noexcept
+{
+    return morphFrames;
+}
+
+
+
+/*-------------------------------------
+ * Add a morph target track to *this
+-------------------------------------*/
+void Animation::add_morph_channel(const size_t meshId, const unsigned targetId, AnimationKeyListFloat&& frames) noexcept
+{
+    morphMeshIds.push_back(meshId);
+    morphTargetIds.push_back(targetId);
+    morphFrames.emplace_back(std::move(frames));
+}
+
+
+
+/*-------------------------------------
+ * Clear all morph target tracks.
+-------------------------------------*/
+void Animation::clear_morph_channels() noexcept
+{
+    morphMeshIds.clear();
+    morphTargetIds.clear();
+    morphFrames.clear();
+}
+
+
+
 /*-------------------------------------
  * Animate a scene graph using all tracks.
 -------------------------------------*/
@@ -349,6 +495,31 @@ void Animation::animate(SceneGraph& graph, const anim_prec_t percentDone) const
             nodeTransform.set_orientation(rot);
         }
     }
+
+    animate_morphs(graph, percentDone);
+}
+
+
+
+/*-------------------------------------
+ * Animate all morph target weights.
+-------------------------------------*/
+void Animation::animate_morphs(SceneGraph& graph, const anim_prec_t percentDone) const noexcept
+{
+    // Morph targets only need their weights updated. Vertex data remains
+    // untouched on the GPU.
+    std::vector<SceneMorph>& morphs = graph.morphs;
+
+    for (size_t i = morphMeshIds.size(); i--;)
+    {
+        SceneMorph& morph = morphs[morphMeshIds[i]];
+        const AnimationKeyListFloat& frames = morphFrames[i];
+
+        if (frames.is_valid())
+        {
+            morph.weights[morphTargetIds[i]] = frames.get_interpolated_data(percentDone, animation_flag_t::ANIM_FLAG_DEFAULT);
+        }
+    }
 }
 
 
@@ -388,6 +559,19 @@ void Animation::init(SceneGraph& graph, const bool atStart) const noexcept
             nodeTransform.set_orientation(atStart ? track.rotationFrames.get_start_data() : track.rotationFrames.get_end_data());
         }
     }
+
+    std::vector<SceneMorph>& morphs = graph.morphs;
+
+    for (size_t i = morphMeshIds.size(); i--;)
+    {
+        SceneMorph& morph = morphs[morphMeshIds[i]];
+        const AnimationKeyListFloat& frames = morphFrames[i];
+
+        if (frames.is_valid())
+        {
+            morph.weights[morphTargetIds[i]] = atStart ? frames.get_start_data() : frames.get_end_data();
+        }
+    }
 }
 } // end draw namespace
 } // end ls namespace
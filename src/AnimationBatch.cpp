@@ -0,0 +1,252 @@
+
+#include <system_error>
+#include <utility> // std::move
+
+#include "lightsky/utils/Assertions.h"
+#include "lightsky/utils/Log.h"
+
+#include "lightsky/draw/Animation.h"
+#include "lightsky/draw/AnimationBatch.h"
+#include "lightsky/draw/AnimationPlayer.h"
+#include "lightsky/draw/SceneGraph.h"
+
+
+
+namespace ls
+{
+namespace draw
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * AnimationBatch Class
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Destructor
+-------------------------------------*/
+AnimationBatch::~AnimationBatch() noexcept
+{
+    terminate();
+}
+
+
+
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+AnimationBatch::AnimationBatch() noexcept :
+    items{},
+    workers{},
+    signalLock{},
+    startCond{},
+    finishCond{},
+    numPending{0},
+    generation{0},
+    tickMillis{0},
+    shouldStop{false}
+{
+}
+
+
+
+/*-------------------------------------
+ * Start all worker threads
+-------------------------------------*/
+bool AnimationBatch::init(unsigned numThreads) noexcept
+{
+    stop_workers();
+
+    if (!numThreads)
+    {
+        numThreads = std::thread::hardware_concurrency();
+    }
+
+    // The calling thread always processes the first partition of items.
+    const unsigned numWorkers = numThreads > 1 ? (numThreads - 1) : 0;
+    workers.reserve(numWorkers);
+
+    for (unsigned i = 0; i < numWorkers; ++i)
+    {
+        try
+        {
+            workers.emplace_back(&AnimationBatch::thread_loop, this, i + 1);
+        }
+        catch (const std::system_error& e)
+        {
+            LS_LOG_ERR("Unable to start an animation worker thread: ", e.what());
+            stop_workers();
+            return false;
+        }
+    }
+
+    LS_LOG_MSG("Started ", workers.size(), " animation worker threads.");
+
+    return true;
+}
+
+
+
+/*-------------------------------------
+ * Join all worker threads and remove all items
+-------------------------------------*/
+void AnimationBatch::terminate() noexcept
+{
+    stop_workers();
+    items.clear();
+}
+
+
+
+/*-------------------------------------
+ * Join all worker threads
+-------------------------------------*/
+void AnimationBatch::stop_workers() noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock{signalLock};
+        shouldStop = true;
+    }
+
+    startCond.notify_all();
+
+    for (std::thread& t : workers)
+    {
+        t.join();
+    }
+
+    workers.clear();
+
+    numPending = 0;
+    generation = 0;
+    tickMillis = 0;
+    shouldStop = false;
+}
+
+
+
+/*-------------------------------------
+ * Worker thread loop
+-------------------------------------*/
+void AnimationBatch::thread_loop(const unsigned partitionId) noexcept
+{
+    uint64_t lastGeneration = 0;
+
+    while (true)
+    {
+        uint64_t millis;
+        unsigned numPartitions;
+
+        {
+            std::unique_lock<std::mutex> lock{signalLock};
+            startCond.wait(lock, [&]() -> bool
+            {
+                return shouldStop || generation != lastGeneration;
+            });
+
+            if (shouldStop)
+            {
+                return;
+            }
+
+            lastGeneration = generation;
+            millis = tickMillis;
+            numPartitions = (unsigned)workers.size() + 1;
+        }
+
+        tick_partition(partitionId, numPartitions, millis);
+
+        if (numPending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            std::lock_guard<std::mutex> lock{signalLock};
+            finishCond.notify_one();
+        }
+    }
+}
+
+
+
+/*-------------------------------------
+ * Evaluate a range of items
+-------------------------------------*/
+void AnimationBatch::tick_partition(
+    const unsigned partitionId,
+    const unsigned numPartitions,
+    const uint64_t millis
+) noexcept
+{
+    const size_t numItems = items.size();
+    const size_t begin = (numItems * partitionId) / numPartitions;
+    const size_t end = (numItems * (partitionId + 1)) / numPartitions;
+    const AnimationBatchItem* const pItems = items.data();
+
+    for (size_t i = begin; i < end; ++i)
+    {
+        const AnimationBatchItem& item = pItems[i];
+        SceneGraph& graph = *item.pGraph;
+        const Animation& anim = graph.animations[item.animationIndex];
+        anim_prec_t percentDone;
+
+        if (item.pPlayer->advance(anim, millis, percentDone))
+        {
+            anim.animate(graph, percentDone);
+        }
+    }
+}
+
+
+
+/*-------------------------------------
+ * Add an item to animate
+-------------------------------------*/
+void AnimationBatch::add(AnimationPlayer& player, SceneGraph& graph, const unsigned animationIndex) noexcept
+{
+    LS_DEBUG_ASSERT(animationIndex < graph.animations.size());
+    items.push_back(AnimationBatchItem{&player, &graph, animationIndex});
+}
+
+
+
+/*-------------------------------------
+ * Remove all items
+-------------------------------------*/
+void AnimationBatch::clear() noexcept
+{
+    items.clear();
+}
+
+
+
+/*-------------------------------------
+ * Animate all items
+-------------------------------------*/
+void AnimationBatch::tick(const uint64_t millis) noexcept
+{
+    const unsigned numWorkers = (unsigned)workers.size();
+
+    // Not worth waking up other threads for a single item.
+    if (!numWorkers || items.size() < 2)
+    {
+        tick_partition(0, 1, millis);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{signalLock};
+        tickMillis = millis;
+        numPending.store(numWorkers, std::memory_order_release);
+        ++generation;
+    }
+
+    startCond.notify_all();
+
+    tick_partition(0, numWorkers + 1, millis);
+
+    std::unique_lock<std::mutex> lock{signalLock};
+    finishCond.wait(lock, [&]() -> bool
+    {
+        return numPending.load(std::memory_order_acquire) == 0;
+    });
+}
+} // end draw namespace
+} // end ls namespace
@@ -0,0 +1,369 @@
+
+#include <utility> // std::move
+
+#include "lightsky/math/Math.h"
+
+#include "lightsky/utils/Assertions.h"
+
+#include "lightsky/draw/Animation.h"
+#include "lightsky/draw/AnimationBlender.h"
+#include "lightsky/draw/SceneGraph.h"
+#include "lightsky/draw/Transform.h"
+
+
+
+/*-----------------------------------------------------------------------------
+ * Anonymous helper functions
+-----------------------------------------------------------------------------*/
+namespace
+{
+
+namespace math = ls::math;
+using ls::draw::animation_blend_t;
+
+
+
+/*-------------------------------------
+ * Prepare an accumulated value for an override blend
+-------------------------------------*/
+template <typename data_t>
+inline void apply_override_weight(data_t& accum, float& accumWeight, const float weight) noexcept
+{
+    if (accumWeight > 0.f)
+    {
+        const float remaining = math::max(1.f - weight, 0.f);
+        accum = accum * (remaining / accumWeight);
+        accumWeight = remaining;
+    }
+}
+
+
+
+/*-------------------------------------
+ * Accumulate a weighted vector
+-------------------------------------*/
+inline void accumulate_blend(
+    math::vec3& accum,
+    float& accumWeight,
+    const math::vec3& value,
+    const float weight,
+    const animation_blend_t blendMode
+) noexcept
+{
+    if (blendMode == animation_blend_t::ANIM_BLEND_OVERRIDE)
+    {
+        apply_override_weight(accum, accumWeight, weight);
+    }
+
+    accum = accum + (value * weight);
+    accumWeight += weight;
+}
+
+
+
+/*-------------------------------------
+ * Accumulate a weighted quaternion
+-------------------------------------*/
+inline void accumulate_blend(
+    math::quat& accum,
+    float& accumWeight,
+    const math::quat& value,
+    const float weight,
+    const animation_blend_t blendMode
+) noexcept
+{
+    if (blendMode == animation_blend_t::ANIM_BLEND_OVERRIDE)
+    {
+        apply_override_weight(accum, accumWeight, weight);
+    }
+
+    // Keep all accumulated rotations within the same hemisphere so opposing
+    // quaternions don't cancel each other out.
+    const float signedWeight = math::dot(accum, value) < 0.f ? -weight : weight;
+
+    accum = accum + (value * signedWeight);
+    accumWeight += weight;
+}
+} // end anonymous namespace
+
+
+
+namespace ls
+{
+namespace draw
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * AnimationBlender Class
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Destructor
+-------------------------------------*/
+AnimationBlender::~AnimationBlender() noexcept
+{
+}
+
+
+
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+AnimationBlender::AnimationBlender() noexcept :
+    layers{},
+    positions{},
+    scales{},
+    rotations{},
+    posWeights{},
+    sclWeights{},
+    rotWeights{},
+    touchedIds{}
+{
+}
+
+
+
+/*-------------------------------------
+ * Copy Constructor
+-------------------------------------*/
+AnimationBlender::AnimationBlender(const AnimationBlender& b) noexcept :
+    layers{b.layers},
+    positions{},
+    scales{},
+    rotations{},
+    posWeights{},
+    sclWeights{},
+    rotWeights{},
+    touchedIds{}
+{
+}
+
+
+
+/*-------------------------------------
+ * Move Constructor
+-------------------------------------*/
+AnimationBlender::AnimationBlender(AnimationBlender&& b) noexcept :
+    layers{std::move(b.layers)},
+    positions{std::move(b.positions)},
+    scales{std::move(b.scales)},
+    rotations{std::move(b.rotations)},
+    posWeights{std::move(b.posWeights)},
+    sclWeights{std::move(b.sclWeights)},
+    rotWeights{std::move(b.rotWeights)},
+    touchedIds{std::move(b.touchedIds)}
+{
+}
+
+
+
+/*-------------------------------------
+ * Copy Operator
+-------------------------------------*/
+AnimationBlender& AnimationBlender::operator=(const AnimationBlender& b) noexcept
+{
+    layers = b.layers;
+
+    return *this;
+}
+
+
+
+/*-------------------------------------
+ * Move Operator
+-------------------------------------*/
+AnimationBlender& AnimationBlender::operator=(AnimationBlender&& b) noexcept
+{
+    layers = std::move(b.layers);
+    positions = std::move(b.positions);
+    scales = std::move(b.scales);
+    rotations = std::move(b.rotations);
+    posWeights = std::move(b.posWeights);
+    sclWeights = std::move(b.sclWeights);
+    rotWeights = std::move(b.rotWeights);
+    touchedIds = std::move(b.touchedIds);
+
+    return *this;
+}
+
+
+
+/*-------------------------------------
+ * Add a layer
+-------------------------------------*/
+size_t AnimationBlender::add_layer(const AnimationBlendLayer& layer) noexcept
+{
+    layers.push_back(layer);
+    return layers.size() - 1;
+}
+
+
+
+/*-------------------------------------
+ * Remove all layers
+-------------------------------------*/
+void AnimationBlender::clear_layers() noexcept
+{
+    layers.clear();
+}
+
+
+
+/*-------------------------------------
+ * Resize the pose buffers
+-------------------------------------*/
+void AnimationBlender::reset_pose(const size_t numTransforms) noexcept
+{
+    // Pose buffers are cleared as they're written to a scene graph. They only
+    // need to be re-initialized if the number of transforms changes.
+    if (positions.size() == numTransforms)
+    {
+        return;
+    }
+
+    positions.assign(numTransforms, math::vec3{0.f, 0.f, 0.f});
+    scales.assign(numTransforms, math::vec3{0.f, 0.f, 0.f});
+    rotations.assign(numTransforms, math::quat{0.f, 0.f, 0.f, 0.f});
+    posWeights.assign(numTransforms, 0.f);
+    sclWeights.assign(numTransforms, 0.f);
+    rotWeights.assign(numTransforms, 0.f);
+    touchedIds.clear();
+    touchedIds.reserve(numTransforms);
+}
+
+
+
+/*-------------------------------------
+ * Sample a single layer into the pose buffers
+-------------------------------------*/
+void AnimationBlender::sample_layer(const SceneGraph& graph, const AnimationBlendLayer& layer) noexcept
+{
+    LS_DEBUG_ASSERT(layer.animationIndex < graph.animations.size());
+    LS_DEBUG_ASSERT(layer.percent >= 0.0);
+
+    const Animation& anim = graph.animations[layer.animationIndex];
+    const std::vector<std::vector<AnimationChannel>>& nodeAnims = graph.nodeAnims;
+    const std::vector<size_t>& animIds = anim.get_node_animations();
+    const std::vector<size_t>& trackIds = anim.get_node_tracks();
+    const std::vector<size_t>& transformIds = anim.get_transforms();
+    const anim_prec_t percent = layer.percent;
+
+    for (size_t i = transformIds.size(); i--;)
+    {
+        const size_t transformId = transformIds[i];
+        const float weight = layer.pMask ? (layer.weight * layer.pMask[transformId]) : layer.weight;
+
+        if (weight <= 0.f)
+        {
+            continue;
+        }
+
+        const AnimationChannel& track = nodeAnims[animIds[i]][trackIds[i]];
+        const bool firstTouch = posWeights[transformId] <= 0.f
+                                && sclWeights[transformId] <= 0.f
+                                && rotWeights[transformId] <= 0.f;
+        bool sampled = false;
+
+        if (track.has_position_frame(percent))
+        {
+            accumulate_blend(positions[transformId], posWeights[transformId], track.get_position_frame(percent), weight, layer.blendMode);
+            sampled = true;
+        }
+
+        if (track.has_scale_frame(percent))
+        {
+            accumulate_blend(scales[transformId], sclWeights[transformId], track.get_scale_frame(percent), weight, layer.blendMode);
+            sampled = true;
+        }
+
+        if (track.has_rotation_frame(percent))
+        {
+            accumulate_blend(rotations[transformId], rotWeights[transformId], track.get_rotation_frame(percent), weight, layer.blendMode);
+            sampled = true;
+        }
+
+        if (firstTouch && sampled)
+        {
+            touchedIds.push_back(transformId);
+        }
+    }
+}
+
+
+
+/*-------------------------------------
+ * Evaluate all layers
+-------------------------------------*/
+void AnimationBlender::animate(SceneGraph& graph) noexcept
+{
+    reset_pose(graph.currentTransforms.size());
+
+    for (const AnimationBlendLayer& layer : layers)
+    {
+        sample_layer(graph, layer);
+    }
+
+    // Write each transform exactly once, then clear the pose buffers for the
+    // next evaluation.
+    Transform* const pTransforms = graph.currentTransforms.data();
+
+    for (const size_t transformId : touchedIds)
+    {
+        LS_DEBUG_ASSERT(transformId != scene_property_t::SCENE_GRAPH_ROOT_ID);
+        Transform& nodeTransform = pTransforms[transformId];
+
+        if (posWeights[transformId] > 0.f)
+        {
+            nodeTransform.set_position(positions[transformId] * (1.f / posWeights[transformId]));
+            positions[transformId] = math::vec3{0.f, 0.f, 0.f};
+            posWeights[transformId] = 0.f;
+        }
+
+        if (sclWeights[transformId] > 0.f)
+        {
+            nodeTransform.set_scale(scales[transformId] * (1.f / sclWeights[transformId]));
+            scales[transformId] = math::vec3{0.f, 0.f, 0.f};
+            sclWeights[transformId] = 0.f;
+        }
+
+        if (rotWeights[transformId] > 0.f)
+        {
+            nodeTransform.set_orientation(math::normalize(rotations[transformId]));
+            rotations[transformId] = math::quat{0.f, 0.f, 0.f, 0.f};
+            rotWeights[transformId] = 0.f;
+        }
+    }
+
+    touchedIds.clear();
+}
+
+
+
+/*-------------------------------------
+ * Generate a hierarchical node mask
+-------------------------------------*/
+void AnimationBlender::make_node_mask(const SceneGraph& graph, const size_t rootNodeId, std::vector<float>& outMask) noexcept
+{
+    const size_t numTransforms = graph.currentTransforms.size();
+
+    if (rootNodeId == scene_property_t::SCENE_GRAPH_ROOT_ID)
+    {
+        outMask.assign(numTransforms, 1.f);
+        return;
+    }
+
+    LS_DEBUG_ASSERT(rootNodeId < numTransforms);
+
+    outMask.assign(numTransforms, 0.f);
+
+    // Child nodes are always grouped sequentially after their parents.
+    const size_t numChildren = graph.get_num_total_children(rootNodeId);
+
+    for (size_t i = rootNodeId; i <= rootNodeId + numChildren; ++i)
+    {
+        outMask[i] = 1.f;
+    }
+}
+} // end draw namespace
+} // end ls namespace
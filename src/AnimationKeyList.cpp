@@ -17,6 +17,36 @@ namespace draw
 /*-----------------------------------------------------------------------------
  * Template Specializations
 -----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Scalar interpolation
+-------------------------------------*/
+template <>
+float AnimationKeyList<float>::get_interpolated_data(anim_prec_t percent, const animation_flag_t animFlags) const noexcept
+{
+    if (percent <= get_start_time())
+    {
+        return get_start_data();
+    }
+
+    if (percent >= get_end_time() && (animFlags & animation_flag_t::ANIM_FLAG_REPEAT) == 0)
+    {
+        return get_end_data();
+    }
+
+    size_t currFrame, nextFrame;
+    anim_prec_t interpAmount = calc_frame_interpolation(percent, currFrame, nextFrame);
+
+    if ((animFlags & animation_flag_t::ANIM_FLAG_IMMEDIATE) != 0)
+    {
+        interpAmount = anim_prec_t{0.0};
+    }
+
+    const float c = keyData[currFrame];
+    const float n = keyData[nextFrame];
+
+    return c + (n - c) * (float)interpAmount;
+}
+
 /*-------------------------------------
  * 3D vector interpolation
 -------------------------------------*/
@@ -83,6 +113,8 @@ math::quat AnimationKeyList<math::quat>::get_interpolated_data(anim_prec_t perce
 /*-----------------------------------------------------------------------------
  * Pre-Compiled Template Specializations
 -----------------------------------------------------------------------------*/
+LS_DEFINE_CLASS_TYPE(AnimationKeyList, float);
+
 LS_DEFINE_CLASS_TYPE(AnimationKeyList, math::vec3);
 
 LS_DEFINE_CLASS_TYPE(AnimationKeyList, math::quat);
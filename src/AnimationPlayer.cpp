@@ -124,6 +124,23 @@ void AnimationPlayer::tick(SceneGraph& graph, unsigned animationIndex, uint64_t
 
     const std::vector<Animation>& animations = graph.animations;
     const Animation& anim = animations[animationIndex];
+    anim_prec_t percentDone;
+
+    if (advance(anim, millis, percentDone))
+    {
+        anim.animate(graph, percentDone);
+    }
+}
+
+/*-------------------------------------
+ * Progress the playback time
+-------------------------------------*/
+bool AnimationPlayer::advance(const Animation& anim, uint64_t millis, anim_prec_t& outPercent) noexcept
+{
+    if (currentState != ANIM_STATE_PLAYING)
+    {
+        return false;
+    }
 
     if (numPlays == PLAY_AUTO)
     {
@@ -135,7 +152,7 @@ void AnimationPlayer::tick(SceneGraph& graph, unsigned animationIndex, uint64_t
     if (!numPlays)
     {
         stop_anim();
-        return;
+        return false;
     }
 
     const anim_prec_t secondsDelta = 0.001 * (anim_prec_t)millis;
@@ -144,7 +161,7 @@ void AnimationPlayer::tick(SceneGraph& graph, unsigned animationIndex, uint64_t
     const anim_prec_t percentDone = currentPercent + percentDelta;
     const anim_prec_t nextPercent = percentDone >= 0.0 ? percentDone : math::max(anim_prec_t{1} + percentDone, anim_prec_t{0});
 
-    anim.animate(graph, nextPercent);
+    outPercent = nextPercent;
 
     // check for a looped Animation even when time is going backwards.
     if (percentDone >= anim_prec_t{1}
@@ -163,6 +180,8 @@ void AnimationPlayer::tick(SceneGraph& graph, unsigned animationIndex, uint64_t
     {
         stop_anim();
     }
+
+    return true;
 }
 
 /*-------------------------------------
@@ -0,0 +1,478 @@
+
+#include <utility> // std::move
+
+#include "lightsky/math/Math.h"
+
+#include "lightsky/utils/Assertions.h"
+
+#include "lightsky/draw/Animation.h"
+#include "lightsky/draw/AnimationPlayer.h"
+#include "lightsky/draw/AnimationPoseCache.h"
+#include "lightsky/draw/SceneGraph.h"
+#include "lightsky/draw/Transform.h"
+
+
+
+/*-----------------------------------------------------------------------------
+ * Anonymous helper functions
+-----------------------------------------------------------------------------*/
+namespace
+{
+
+/*-------------------------------------
+ * Sentinel for LRU links
+-------------------------------------*/
+constexpr size_t POSE_SLOT_NONE = (size_t)-1;
+
+/*-------------------------------------
+ * Default number of steps per animation
+-------------------------------------*/
+constexpr unsigned POSE_DEFAULT_QUANTIZATION = 256;
+} // end anonymous namespace
+
+
+
+namespace ls
+{
+namespace draw
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * AnimationPoseCache Class
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Destructor
+-------------------------------------*/
+AnimationPoseCache::~AnimationPoseCache() noexcept
+{
+}
+
+
+
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+AnimationPoseCache::AnimationPoseCache() noexcept :
+    quantization{POSE_DEFAULT_QUANTIZATION},
+    slotMap{},
+    slotKeys{},
+    slotNewer{},
+    slotOlder{},
+    poses{},
+    numUsed{0},
+    newestSlot{POSE_SLOT_NONE},
+    oldestSlot{POSE_SLOT_NONE},
+    numHits{0},
+    numMisses{0}
+{
+}
+
+
+
+/*-------------------------------------
+ * Copy Constructor
+-------------------------------------*/
+AnimationPoseCache::AnimationPoseCache(const AnimationPoseCache& c) noexcept :
+    quantization{c.quantization},
+    slotMap{c.slotMap},
+    slotKeys{c.slotKeys},
+    slotNewer{c.slotNewer},
+    slotOlder{c.slotOlder},
+    poses{c.poses},
+    numUsed{c.numUsed},
+    newestSlot{c.newestSlot},
+    oldestSlot{c.oldestSlot},
+    numHits{c.numHits},
+    numMisses{c.numMisses}
+{
+}
+
+
+
+/*-------------------------------------
+ * Move Constructor
+-------------------------------------*/
+AnimationPoseCache::AnimationPoseCache(AnimationPoseCache&& c) noexcept :
+    quantization{c.quantization},
+    slotMap{std::move(c.slotMap)},
+    slotKeys{std::move(c.slotKeys)},
+    slotNewer{std::move(c.slotNewer)},
+    slotOlder{std::move(c.slotOlder)},
+    poses{std::move(c.poses)},
+    numUsed{c.numUsed},
+    newestSlot{c.newestSlot},
+    oldestSlot{c.oldestSlot},
+    numHits{c.numHits},
+    numMisses{c.numMisses}
+{
+    c.quantization = POSE_DEFAULT_QUANTIZATION;
+    c.numUsed = 0;
+    c.newestSlot = POSE_SLOT_NONE;
+    c.oldestSlot = POSE_SLOT_NONE;
+    c.numHits = 0;
+    c.numMisses = 0;
+}
+
+
+
+/*-------------------------------------
+ * Copy Operator
+-------------------------------------*/
+AnimationPoseCache& AnimationPoseCache::operator=(const AnimationPoseCache& c) noexcept
+{
+    quantization = c.quantization;
+    slotMap = c.slotMap;
+    slotKeys = c.slotKeys;
+    slotNewer = c.slotNewer;
+    slotOlder = c.slotOlder;
+    poses = c.poses;
+    numUsed = c.numUsed;
+    newestSlot = c.newestSlot;
+    oldestSlot = c.oldestSlot;
+    numHits = c.numHits;
+    numMisses = c.numMisses;
+
+    return *this;
+}
+
+
+
+/*-------------------------------------
+ * Move Operator
+-------------------------------------*/
+AnimationPoseCache& AnimationPoseCache::operator=(AnimationPoseCache&& c) noexcept
+{
+    quantization = c.quantization;
+    c.quantization = POSE_DEFAULT_QUANTIZATION;
+
+    slotMap = std::move(c.slotMap);
+    slotKeys = std::move(c.slotKeys);
+    slotNewer = std::move(c.slotNewer);
+    slotOlder = std::move(c.slotOlder);
+    poses = std::move(c.poses);
+
+    numUsed = c.numUsed;
+    c.numUsed = 0;
+
+    newestSlot = c.newestSlot;
+    c.newestSlot = POSE_SLOT_NONE;
+
+    oldestSlot = c.oldestSlot;
+    c.oldestSlot = POSE_SLOT_NONE;
+
+    numHits = c.numHits;
+    c.numHits = 0;
+
+    numMisses = c.numMisses;
+    c.numMisses = 0;
+
+    return *this;
+}
+
+
+
+/*-------------------------------------
+ * Remove a slot from the LRU list
+-------------------------------------*/
+void AnimationPoseCache::unlink_slot(const size_t slot) noexcept
+{
+    const size_t newer = slotNewer[slot];
+    const size_t older = slotOlder[slot];
+
+    if (newer != POSE_SLOT_NONE)
+    {
+        slotOlder[newer] = older;
+    }
+    else
+    {
+        newestSlot = older;
+    }
+
+    if (older != POSE_SLOT_NONE)
+    {
+        slotNewer[older] = newer;
+    }
+    else
+    {
+        oldestSlot = newer;
+    }
+
+    slotNewer[slot] = POSE_SLOT_NONE;
+    slotOlder[slot] = POSE_SLOT_NONE;
+}
+
+
+
+/*-------------------------------------
+ * Mark a slot as most recently used
+-------------------------------------*/
+void AnimationPoseCache::link_newest(const size_t slot) noexcept
+{
+    slotNewer[slot] = POSE_SLOT_NONE;
+    slotOlder[slot] = newestSlot;
+
+    if (newestSlot != POSE_SLOT_NONE)
+    {
+        slotNewer[newestSlot] = slot;
+    }
+
+    newestSlot = slot;
+
+    if (oldestSlot == POSE_SLOT_NONE)
+    {
+        oldestSlot = slot;
+    }
+}
+
+
+
+/*-------------------------------------
+ * Retrieve an unused or evicted slot
+-------------------------------------*/
+size_t AnimationPoseCache::acquire_slot() noexcept
+{
+    if (numUsed < poses.size())
+    {
+        return numUsed++;
+    }
+
+    // Evict the least recently used pose. Its memory is reused by the new
+    // pose so no allocations occur once all slots have been filled.
+    const size_t slot = oldestSlot;
+    LS_DEBUG_ASSERT(slot != POSE_SLOT_NONE);
+
+    unlink_slot(slot);
+    slotMap.erase(slotKeys[slot]);
+
+    return slot;
+}
+
+
+
+/*-------------------------------------
+ * Sample all channels of an animation
+-------------------------------------*/
+void AnimationPoseCache::sample_pose(
+    const SceneGraph& graph,
+    const Animation& anim,
+    const anim_prec_t percent,
+    AnimationPose& outPose
+) noexcept
+{
+    const std::vector<std::vector<AnimationChannel>>& nodeAnims = graph.nodeAnims;
+    const std::vector<size_t>& animIds = anim.get_node_animations();
+    const std::vector<size_t>& trackIds = anim.get_node_tracks();
+    const size_t numChannels = anim.get_num_anim_channels();
+
+    outPose.channelMasks.resize(numChannels);
+    outPose.positions.resize(numChannels);
+    outPose.scales.resize(numChannels);
+    outPose.rotations.resize(numChannels);
+
+    for (size_t i = numChannels; i--;)
+    {
+        const AnimationChannel& track = nodeAnims[animIds[i]][trackIds[i]];
+        unsigned char mask = 0;
+
+        if (track.has_position_frame(percent))
+        {
+            outPose.positions[i] = track.get_position_frame(percent);
+            mask |= AnimationPose::POSE_HAS_POSITION;
+        }
+
+        if (track.has_scale_frame(percent))
+        {
+            outPose.scales[i] = track.get_scale_frame(percent);
+            mask |= AnimationPose::POSE_HAS_SCALE;
+        }
+
+        if (track.has_rotation_frame(percent))
+        {
+            outPose.rotations[i] = track.get_rotation_frame(percent);
+            mask |= AnimationPose::POSE_HAS_ROTATION;
+        }
+
+        outPose.channelMasks[i] = mask;
+    }
+}
+
+
+
+/*-------------------------------------
+ * Copy a pose into a scene graph
+-------------------------------------*/
+void AnimationPoseCache::apply_pose(SceneGraph& graph, const Animation& anim, const AnimationPose& pose) noexcept
+{
+    const std::vector<size_t>& transformIds = anim.get_transforms();
+    Transform* const pTransforms = graph.currentTransforms.data();
+
+    LS_DEBUG_ASSERT(transformIds.size() == pose.channelMasks.size());
+
+    for (size_t i = transformIds.size(); i--;)
+    {
+        Transform& nodeTransform = pTransforms[transformIds[i]];
+        const unsigned char mask = pose.channelMasks[i];
+
+        if (mask & AnimationPose::POSE_HAS_POSITION)
+        {
+            nodeTransform.set_position(pose.positions[i]);
+        }
+
+        if (mask & AnimationPose::POSE_HAS_SCALE)
+        {
+            nodeTransform.set_scale(pose.scales[i]);
+        }
+
+        if (mask & AnimationPose::POSE_HAS_ROTATION)
+        {
+            nodeTransform.set_orientation(pose.rotations[i]);
+        }
+    }
+}
+
+
+
+/*-------------------------------------
+ * Set the number of pose slots
+-------------------------------------*/
+void AnimationPoseCache::set_capacity(const size_t maxPoses) noexcept
+{
+    clear();
+
+    slotKeys.resize(maxPoses);
+    slotNewer.resize(maxPoses, POSE_SLOT_NONE);
+    slotOlder.resize(maxPoses, POSE_SLOT_NONE);
+    poses.resize(maxPoses);
+    slotMap.reserve(maxPoses);
+}
+
+
+
+/*-------------------------------------
+ * Set the time quantization
+-------------------------------------*/
+void AnimationPoseCache::set_quantization(const unsigned numSteps) noexcept
+{
+    LS_DEBUG_ASSERT(numSteps > 0);
+
+    clear();
+    quantization = numSteps;
+}
+
+
+
+/*-------------------------------------
+ * Remove all cached poses
+-------------------------------------*/
+void AnimationPoseCache::clear() noexcept
+{
+    slotMap.clear();
+
+    for (size_t i = 0; i < poses.size(); ++i)
+    {
+        slotNewer[i] = POSE_SLOT_NONE;
+        slotOlder[i] = POSE_SLOT_NONE;
+    }
+
+    numUsed = 0;
+    newestSlot = POSE_SLOT_NONE;
+    oldestSlot = POSE_SLOT_NONE;
+}
+
+
+
+/*-------------------------------------
+ * Animate using a cached pose
+-------------------------------------*/
+void AnimationPoseCache::animate(SceneGraph& graph, const Animation& anim, const anim_prec_t percentDone) noexcept
+{
+    LS_DEBUG_ASSERT(percentDone >= 0.0);
+
+    if (poses.empty())
+    {
+        ++numMisses;
+        anim.animate(graph, percentDone);
+        return;
+    }
+
+    // Every instance which lands on the same step samples the exact same
+    // time, regardless of its own sub-step offset.
+    const unsigned frameId = math::min<unsigned>((unsigned)(percentDone * quantization + 0.5), quantization);
+    const anim_prec_t quantizedPercent = (anim_prec_t)frameId / (anim_prec_t)quantization;
+    const AnimationPoseKey key{anim.get_clip_id(), frameId};
+
+    const std::unordered_map<AnimationPoseKey, size_t, AnimationPoseKeyHash>::const_iterator iter = slotMap.find(key);
+    size_t slot;
+
+    if (iter != slotMap.end())
+    {
+        ++numHits;
+        slot = iter->second;
+        unlink_slot(slot);
+
+        LS_DEBUG_ASSERT(poses[slot].channelMasks.size() == anim.get_num_anim_channels());
+    }
+    else
+    {
+        ++numMisses;
+
+        slot = acquire_slot();
+        slotKeys[slot] = key;
+        slotMap[key] = slot;
+
+        sample_pose(graph, anim, quantizedPercent, poses[slot]);
+    }
+
+    link_newest(slot);
+    apply_pose(graph, anim, poses[slot]);
+
+    // Morph target weights are cheap to evaluate and aren't cached.
+    anim.animate_morphs(graph, quantizedPercent);
+}
+
+
+
+/*-------------------------------------
+ * Advance a player and animate
+-------------------------------------*/
+void AnimationPoseCache::tick(
+    AnimationPlayer& player,
+    SceneGraph& graph,
+    const unsigned animationIndex,
+    const uint64_t millis
+) noexcept
+{
+    const Animation& anim = graph.animations[animationIndex];
+    anim_prec_t percentDone;
+
+    if (player.advance(anim, millis, percentDone))
+    {
+        animate(graph, anim, percentDone);
+    }
+}
+
+
+
+/*-------------------------------------
+ * Retrieve the hit rate
+-------------------------------------*/
+float AnimationPoseCache::get_hit_rate() const noexcept
+{
+    const uint64_t total = numHits + numMisses;
+    return total ? (float)((double)numHits / (double)total) : 0.f;
+}
+
+
+
+/*-------------------------------------
+ * Reset all counters
+-------------------------------------*/
+void AnimationPoseCache::reset_counters() noexcept
+{
+    numHits = 0;
+    numMisses = 0;
+}
+} // end draw namespace
+} // end ls namespace
@@ -0,0 +1,299 @@
+
+#include <utility> // std::move
+
+#include "lightsky/math/Math.h"
+
+#include "lightsky/utils/Assertions.h"
+
+#include "lightsky/draw/Animation.h"
+#include "lightsky/draw/AnimationPlayer.h"
+#include "lightsky/draw/AnimationScheduler.h"
+#include "lightsky/draw/SceneGraph.h"
+
+
+
+namespace ls
+{
+namespace draw
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * AnimationScheduler Class
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Destructor
+-------------------------------------*/
+AnimationScheduler::~AnimationScheduler() noexcept
+{
+}
+
+
+
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+AnimationScheduler::AnimationScheduler() noexcept :
+    items{},
+    lodThresholds{50.f, 100.f, 400.f},
+    lodPhases{0, 0, 0, 0},
+    frameId{0},
+    numEvaluated{0}
+{
+}
+
+
+
+/*-------------------------------------
+ * Copy Constructor
+-------------------------------------*/
+AnimationScheduler::AnimationScheduler(const AnimationScheduler& s) noexcept :
+    items{s.items},
+    lodThresholds{s.lodThresholds[0], s.lodThresholds[1], s.lodThresholds[2]},
+    lodPhases{s.lodPhases[0], s.lodPhases[1], s.lodPhases[2], s.lodPhases[3]},
+    frameId{s.frameId},
+    numEvaluated{s.numEvaluated}
+{
+}
+
+
+
+/*-------------------------------------
+ * Move Constructor
+-------------------------------------*/
+AnimationScheduler::AnimationScheduler(AnimationScheduler&& s) noexcept :
+    items{std::move(s.items)},
+    lodThresholds{s.lodThresholds[0], s.lodThresholds[1], s.lodThresholds[2]},
+    lodPhases{s.lodPhases[0], s.lodPhases[1], s.lodPhases[2], s.lodPhases[3]},
+    frameId{s.frameId},
+    numEvaluated{s.numEvaluated}
+{
+    for (unsigned& phase : s.lodPhases)
+    {
+        phase = 0;
+    }
+
+    s.frameId = 0;
+    s.numEvaluated = 0;
+}
+
+
+
+/*-------------------------------------
+ * Copy Operator
+-------------------------------------*/
+AnimationScheduler& AnimationScheduler::operator=(const AnimationScheduler& s) noexcept
+{
+    items = s.items;
+    set_lod_thresholds(s.lodThresholds[0], s.lodThresholds[1], s.lodThresholds[2]);
+
+    for (unsigned i = 0; i < animation_lod_t::ANIM_LOD_MAX; ++i)
+    {
+        lodPhases[i] = s.lodPhases[i];
+    }
+
+    frameId = s.frameId;
+    numEvaluated = s.numEvaluated;
+
+    return *this;
+}
+
+
+
+/*-------------------------------------
+ * Move Operator
+-------------------------------------*/
+AnimationScheduler& AnimationScheduler::operator=(AnimationScheduler&& s) noexcept
+{
+    items = std::move(s.items);
+    set_lod_thresholds(s.lodThresholds[0], s.lodThresholds[1], s.lodThresholds[2]);
+
+    for (unsigned i = 0; i < animation_lod_t::ANIM_LOD_MAX; ++i)
+    {
+        lodPhases[i] = s.lodPhases[i];
+        s.lodPhases[i] = 0;
+    }
+
+    frameId = s.frameId;
+    s.frameId = 0;
+
+    numEvaluated = s.numEvaluated;
+    s.numEvaluated = 0;
+
+    return *this;
+}
+
+
+
+/*-------------------------------------
+ * Set the LOD distances
+-------------------------------------*/
+void AnimationScheduler::set_lod_thresholds(const float halfRate, const float quarterRate, const float culled) noexcept
+{
+    LS_DEBUG_ASSERT(halfRate <= quarterRate);
+    LS_DEBUG_ASSERT(quarterRate <= culled);
+
+    lodThresholds[0] = halfRate;
+    lodThresholds[1] = quarterRate;
+    lodThresholds[2] = culled;
+}
+
+
+
+/*-------------------------------------
+ * Add an item to animate
+-------------------------------------*/
+size_t AnimationScheduler::add(
+    AnimationPlayer& player,
+    SceneGraph& graph,
+    const unsigned animationIndex,
+    const size_t nodeId,
+    const float radius
+) noexcept
+{
+    LS_DEBUG_ASSERT(animationIndex < graph.animations.size());
+    LS_DEBUG_ASSERT(nodeId < graph.nodes.size());
+    LS_DEBUG_ASSERT(radius > 0.f);
+
+    // New items start in the full-rate bucket, after all other items within
+    // it.
+    const size_t itemId = items.size();
+    items.push_back(AnimationSchedulerItem{
+        &player,
+        &graph,
+        animationIndex,
+        nodeId,
+        radius,
+        animation_lod_t::ANIM_LOD_FULL,
+        lodPhases[animation_lod_t::ANIM_LOD_FULL]++,
+        0
+    });
+
+    return itemId;
+}
+
+
+
+/*-------------------------------------
+ * Remove all items
+-------------------------------------*/
+void AnimationScheduler::clear() noexcept
+{
+    items.clear();
+    frameId = 0;
+    numEvaluated = 0;
+
+    for (unsigned& phase : lodPhases)
+    {
+        phase = 0;
+    }
+}
+
+
+
+/*-------------------------------------
+ * Manually set an item's LOD
+-------------------------------------*/
+void AnimationScheduler::set_lod(const size_t itemId, const animation_lod_t lod) noexcept
+{
+    LS_DEBUG_ASSERT(itemId < items.size());
+    LS_DEBUG_ASSERT(lod < animation_lod_t::ANIM_LOD_MAX);
+
+    AnimationSchedulerItem& item = items[itemId];
+
+    if (item.lod != lod)
+    {
+        item.lod = lod;
+        item.phase = lodPhases[lod]++;
+    }
+}
+
+
+
+/*-------------------------------------
+ * Recalculate all LODs
+-------------------------------------*/
+void AnimationScheduler::update_lods(const math::vec3& viewPos) noexcept
+{
+    // Compare squared distances to avoid a square root per item.
+    const float half = lodThresholds[0] * lodThresholds[0];
+    const float quarter = lodThresholds[1] * lodThresholds[1];
+    const float culled = lodThresholds[2] * lodThresholds[2];
+
+    // Sequential phases within each bucket spread its items evenly across
+    // the frames in which the bucket is evaluated. Phases remain stable
+    // while the contents of each bucket are unchanged.
+    for (unsigned& phase : lodPhases)
+    {
+        phase = 0;
+    }
+
+    for (AnimationSchedulerItem& item : items)
+    {
+        const math::mat4& modelMat = item.pGraph->modelMatrices[item.nodeId];
+        const math::vec3 delta = math::vec3{modelMat[3][0], modelMat[3][1], modelMat[3][2]} - viewPos;
+        const float ratio = math::dot(delta, delta) / (item.radius * item.radius);
+
+        if (ratio >= culled)
+        {
+            item.lod = animation_lod_t::ANIM_LOD_CULLED;
+        }
+        else if (ratio >= quarter)
+        {
+            item.lod = animation_lod_t::ANIM_LOD_QUARTER;
+        }
+        else if (ratio >= half)
+        {
+            item.lod = animation_lod_t::ANIM_LOD_HALF;
+        }
+        else
+        {
+            item.lod = animation_lod_t::ANIM_LOD_FULL;
+        }
+
+        item.phase = lodPhases[item.lod]++;
+    }
+}
+
+
+
+/*-------------------------------------
+ * Animate all scheduled items
+-------------------------------------*/
+void AnimationScheduler::tick(const uint64_t millis) noexcept
+{
+    unsigned evaluated = 0;
+
+    for (AnimationSchedulerItem& item : items)
+    {
+        item.pendingMillis += millis;
+
+        // Culled items advance at the lowest rate to keep their playback
+        // time (and play counts) in sync with visible items.
+        const unsigned rate = math::min<unsigned>(item.lod, animation_lod_t::ANIM_LOD_QUARTER);
+        const unsigned mask = (1u << rate) - 1u;
+
+        if (((frameId + item.phase) & mask) != 0)
+        {
+            continue;
+        }
+
+        SceneGraph& graph = *item.pGraph;
+        const Animation& anim = graph.animations[item.animationIndex];
+        anim_prec_t percentDone;
+
+        if (item.pPlayer->advance(anim, item.pendingMillis, percentDone) && item.lod != animation_lod_t::ANIM_LOD_CULLED)
+        {
+            anim.animate(graph, percentDone);
+            ++evaluated;
+        }
+
+        item.pendingMillis = 0;
+    }
+
+    ++frameId;
+    numEvaluated = evaluated;
+}
+} // end draw namespace
+} // end ls namespace
@@ -0,0 +1,566 @@
+
+#include <algorithm> // std::sort
+#include <memory> // std::nothrow
+#include <utility> // std::move, std::pair
+#include <vector>
+
+#include "lightsky/utils/Log.h"
+
+#include "lightsky/draw/AssetRegistry.h"
+#include "lightsky/draw/ImageBuffer.h"
+#include "lightsky/draw/SceneFileLoader.h"
+#include "lightsky/draw/SceneGraph.h"
+#include "lightsky/draw/SceneMaterial.h"
+#include "lightsky/draw/Texture.h"
+#include "lightsky/draw/TextureAssembly.h"
+#include "lightsky/draw/VertexUtils.h"
+
+
+
+namespace ls
+{
+namespace draw
+{
+
+/*-----------------------------------------------------------------------------
+ * Deferred asset releases
+-----------------------------------------------------------------------------*/
+struct AssetReleaseQueue
+{
+    std::mutex lock;
+
+    // Cleared when the owning registry is destroyed. Assets released
+    // afterwards are terminated immediately.
+    bool isOpen = true;
+
+    std::vector<Texture> textures;
+
+    std::vector<SceneGraph> scenes;
+};
+
+} // end draw namespace
+} // end ls namespace
+
+
+
+/*-----------------------------------------------------------------------------
+ * Anonymous helper functions
+-----------------------------------------------------------------------------*/
+namespace
+{
+
+namespace draw = ls::draw;
+namespace math = ls::math;
+
+
+
+/*-------------------------------------
+ * A texture which is released along with its last handle
+-------------------------------------*/
+struct SharedTexture
+{
+    draw::Texture tex;
+
+    std::shared_ptr<draw::AssetReleaseQueue> releaseQueue;
+
+    // The last handle may be dropped on any thread. GPU data is deleted by
+    // AssetRegistry::flush_releases() on the OpenGL thread.
+    ~SharedTexture() noexcept
+    {
+        std::lock_guard<std::mutex> guard{releaseQueue->lock};
+
+        if (releaseQueue->isOpen)
+        {
+            releaseQueue->textures.emplace_back(std::move(tex));
+        }
+        else
+        {
+            tex.terminate();
+        }
+    }
+
+    SharedTexture(draw::Texture&& t, const std::shared_ptr<draw::AssetReleaseQueue>& q) noexcept :
+        tex{std::move(t)},
+        releaseQueue{q}
+    {}
+};
+
+
+
+/*-------------------------------------
+ * A scene which is released along with its last handle
+-------------------------------------*/
+struct SharedScene
+{
+    draw::SceneGraph scene;
+
+    // Textures which were moved into the registry remain alive for as long
+    // as the scene references them.
+    std::vector<draw::TextureAssetHandle> textures;
+
+    std::shared_ptr<draw::AssetReleaseQueue> releaseQueue;
+
+    // Shared textures are released after the scene, when "textures" is
+    // destroyed.
+    ~SharedScene() noexcept
+    {
+        std::lock_guard<std::mutex> guard{releaseQueue->lock};
+
+        if (releaseQueue->isOpen)
+        {
+            releaseQueue->scenes.emplace_back(std::move(scene));
+        }
+        else
+        {
+            scene.terminate();
+        }
+    }
+
+    SharedScene(const std::shared_ptr<draw::AssetReleaseQueue>& q) noexcept :
+        scene{},
+        textures{},
+        releaseQueue{q}
+    {}
+};
+
+
+
+/*-------------------------------------
+ * Upload a decoded image
+-------------------------------------*/
+bool upload_image(const draw::ImageBuffer& img, const draw::tex_wrap_t wrapMode, draw::Texture& outTex) noexcept
+{
+    draw::TextureAssembly texAssembly;
+
+    const math::vec3i& imgSize3d = img.get_pixel_size();
+    const math::vec2i&& imgSize2d = {imgSize3d[0], imgSize3d[1]};
+
+    LS_ASSERT(texAssembly.set_size_attrib(imgSize2d));
+    LS_ASSERT(texAssembly.set_format_attrib(img.get_internal_format()));
+
+    LS_ASSERT(texAssembly.set_int_attrib(draw::tex_param_t::TEX_PARAM_WRAP_S, wrapMode));
+    LS_ASSERT(texAssembly.set_int_attrib(draw::tex_param_t::TEX_PARAM_WRAP_T, wrapMode));
+    LS_ASSERT(texAssembly.set_int_attrib(draw::tex_param_t::TEX_PARAM_WRAP_R, wrapMode));
+
+    LS_ASSERT(texAssembly.set_int_attrib(draw::tex_param_t::TEX_PARAM_MAG_FILTER, draw::tex_filter_t::TEX_FILTER_LINEAR));
+    LS_ASSERT(texAssembly.set_int_attrib(draw::tex_param_t::TEX_PARAM_MIN_FILTER, draw::tex_filter_t::TEX_FILTER_LINEAR));
+
+    // OpenGL ES doesn't support the GL_BGR & GL_BGRA storage formats
+    #ifdef LS_DRAW_BACKEND_GLES
+    if (img.get_internal_format() == draw::pixel_format_t::COLOR_FMT_DEFAULT_RGB
+    || img.get_internal_format() == draw::pixel_format_t::COLOR_FMT_DEFAULT_RGBA
+    ) {
+        LS_ASSERT(texAssembly.set_int_attrib(draw::tex_param_t::TEX_PARAM_SWIZZLE_R, draw::pixel_swizzle_t::SWIZZLE_BLUE));
+        LS_ASSERT(texAssembly.set_int_attrib(draw::tex_param_t::TEX_PARAM_SWIZZLE_G, draw::pixel_swizzle_t::SWIZZLE_GREEN));
+        LS_ASSERT(texAssembly.set_int_attrib(draw::tex_param_t::TEX_PARAM_SWIZZLE_B, draw::pixel_swizzle_t::SWIZZLE_RED));
+    }
+    #endif
+
+    return texAssembly.assemble(outTex, img.get_data());
+}
+
+
+
+/*-------------------------------------
+ * Point all materials at a different texture
+-------------------------------------*/
+void remap_material_textures(std::vector<draw::SceneMaterial>& materials, const GLuint oldId, const GLuint newId) noexcept
+{
+    for (draw::SceneMaterial& m : materials)
+    {
+        for (unsigned slot = 0; slot < draw::active_texture_t::MAX_ACTIVE_TEXTURES; ++slot)
+        {
+            if (m.textures[slot] == oldId)
+            {
+                m.textures[slot] = newId;
+            }
+        }
+    }
+}
+
+
+
+} // end anonymous namespace
+
+
+
+namespace ls
+{
+namespace draw
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * AssetRegistry Class
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Destructor
+-------------------------------------*/
+AssetRegistry::~AssetRegistry() noexcept
+{
+    {
+        std::lock_guard<std::mutex> guard{releaseQueue->lock};
+        releaseQueue->isOpen = false;
+    }
+
+    flush_releases();
+}
+
+
+
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+AssetRegistry::AssetRegistry() noexcept :
+    lock{},
+    textures{},
+    scenes{},
+    releaseQueue{std::make_shared<AssetReleaseQueue>()}
+{
+}
+
+
+
+/*-------------------------------------
+ * Generate a texture key
+-------------------------------------*/
+std::string AssetRegistry::make_texture_key(const std::string& filepath, const tex_wrap_t wrapMode) noexcept
+{
+    return filepath + '#' + std::to_string((int)wrapMode);
+}
+
+
+
+/*-------------------------------------
+ * Generate a scene key
+-------------------------------------*/
+std::string AssetRegistry::make_scene_key(const std::string& filepath, const common_vertex_t packedVertTypes) noexcept
+{
+    return filepath + '#' + std::to_string((unsigned)packedVertTypes);
+}
+
+
+
+/*-------------------------------------
+ * Register a texture (unlocked)
+-------------------------------------*/
+TextureAssetHandle AssetRegistry::insert_texture_unlocked(const std::string& filepath, Texture&& tex) noexcept
+{
+    const tex_wrap_t wrapMode = tex.get_attribs().get_wrap_mode(tex_param_t::TEX_PARAM_WRAP_S);
+    std::weak_ptr<const Texture>& entry = textures[make_texture_key(filepath, wrapMode)];
+    TextureAssetHandle existing = entry.lock();
+
+    if (existing)
+    {
+        tex.terminate();
+        return existing;
+    }
+
+    SharedTexture* const pShared = new(std::nothrow) SharedTexture{std::move(tex), releaseQueue};
+    if (!pShared)
+    {
+        LS_LOG_ERR("Unable to allocate a shared texture for ", filepath, '.');
+        tex.terminate();
+        return TextureAssetHandle{};
+    }
+
+    // Handles reference the texture while the owner releases it.
+    std::shared_ptr<SharedTexture> owner{pShared};
+    TextureAssetHandle ret{owner, &owner->tex};
+    entry = ret;
+
+    return ret;
+}
+
+
+
+/*-------------------------------------
+ * Locate a texture
+-------------------------------------*/
+TextureAssetHandle AssetRegistry::find_texture(const std::string& filepath, const tex_wrap_t wrapMode) const noexcept
+{
+    const std::string&& key = make_texture_key(filepath, wrapMode);
+    std::lock_guard<std::mutex> guard{lock};
+
+    const std::unordered_map<std::string, std::weak_ptr<const Texture>>::const_iterator iter = textures.find(key);
+    return iter != textures.cend() ? iter->second.lock() : TextureAssetHandle{};
+}
+
+
+
+/*-------------------------------------
+ * Retrieve or load a texture
+-------------------------------------*/
+TextureAssetHandle AssetRegistry::acquire_texture(const std::string& filepath, const tex_wrap_t wrapMode) noexcept
+{
+    TextureAssetHandle ret = find_texture(filepath, wrapMode);
+
+    if (ret)
+    {
+        return ret;
+    }
+
+    ImageBuffer img;
+    Texture tex;
+
+    if (img.load_file(filepath) != ImageBuffer::img_status_t::FILE_LOAD_SUCCESS)
+    {
+        LS_LOG_ERR("Unable to load the texture ", filepath, '.');
+        return ret;
+    }
+
+    if (!upload_image(img, wrapMode, tex))
+    {
+        LS_LOG_ERR("Unable to upload the texture ", filepath, '.');
+        return ret;
+    }
+
+    return insert_texture(filepath, std::move(tex));
+}
+
+
+
+/*-------------------------------------
+ * Register a texture
+-------------------------------------*/
+TextureAssetHandle AssetRegistry::insert_texture(const std::string& filepath, Texture&& tex) noexcept
+{
+    std::lock_guard<std::mutex> guard{lock};
+    return insert_texture_unlocked(filepath, std::move(tex));
+}
+
+
+
+/*-------------------------------------
+ * Locate a scene
+-------------------------------------*/
+SceneAssetHandle AssetRegistry::find_scene(const std::string& filepath, const common_vertex_t packedVertTypes) const noexcept
+{
+    const std::string&& key = make_scene_key(filepath, packedVertTypes);
+    std::lock_guard<std::mutex> guard{lock};
+
+    const std::unordered_map<std::string, std::weak_ptr<const SceneGraph>>::const_iterator iter = scenes.find(key);
+    return iter != scenes.cend() ? iter->second.lock() : SceneAssetHandle{};
+}
+
+
+
+/*-------------------------------------
+ * Retrieve or load a scene
+-------------------------------------*/
+SceneAssetHandle AssetRegistry::acquire_scene(
+    const std::string& filepath,
+    const scene_cache_mode_t cacheFlags,
+    const common_vertex_t packedVertTypes
+) noexcept
+{
+    SceneAssetHandle ret = find_scene(filepath, packedVertTypes);
+
+    if (ret)
+    {
+        return ret;
+    }
+
+    SceneFileLoader loader;
+
+    if (!loader.load(filepath, cacheFlags, packedVertTypes))
+    {
+        LS_LOG_ERR("Unable to load the scene ", filepath, '.');
+        return ret;
+    }
+
+    return insert_scene(filepath, packedVertTypes, loader);
+}
+
+
+
+/*-------------------------------------
+ * Register a scene
+-------------------------------------*/
+SceneAssetHandle AssetRegistry::insert_scene(
+    const std::string& filepath,
+    const common_vertex_t packedVertTypes,
+    SceneFileLoader& loader
+) noexcept
+{
+    const std::string&& key = make_scene_key(filepath, packedVertTypes);
+    SceneGraph& graph = loader.get_loaded_data();
+    std::lock_guard<std::mutex> guard{lock};
+
+    std::weak_ptr<const SceneGraph>& entry = scenes[key];
+    SceneAssetHandle ret = entry.lock();
+
+    if (ret)
+    {
+        loader.unload();
+        return ret;
+    }
+
+    SharedScene* const pShared = new(std::nothrow) SharedScene{releaseQueue};
+    if (!pShared)
+    {
+        LS_LOG_ERR("Unable to allocate a shared scene for ", filepath, '.');
+        loader.unload();
+        return ret;
+    }
+
+    // Textures are moved into the registry from the highest index down so
+    // the remaining indices stay valid.
+    std::vector<std::pair<size_t, const std::string*>> texOrder;
+    texOrder.reserve(loader.get_texture_paths().size());
+
+    for (const std::pair<const std::string, size_t>& texPath : loader.get_texture_paths())
+    {
+        texOrder.emplace_back(texPath.second, &texPath.first);
+    }
+
+    std::sort(texOrder.begin(), texOrder.end(), [](const std::pair<size_t, const std::string*>& a, const std::pair<size_t, const std::string*>& b) -> bool
+    {
+        return a.first > b.first;
+    });
+
+    pShared->textures.reserve(texOrder.size());
+
+    for (const std::pair<size_t, const std::string*>& tex : texOrder)
+    {
+        Texture sceneTex = graph.renderData.textures.release(tex.first);
+        const GLuint sceneTexId = sceneTex.gpu_id();
+        TextureAssetHandle sharedTex = insert_texture_unlocked(*tex.second, std::move(sceneTex));
+
+        if (!sharedTex)
+        {
+            continue;
+        }
+
+        // Another scene already uploaded this texture with the same wrap
+        // mode.
+        if (sharedTex->gpu_id() != sceneTexId)
+        {
+            remap_material_textures(graph.materials, sceneTexId, sharedTex->gpu_id());
+        }
+
+        pShared->textures.push_back(std::move(sharedTex));
+    }
+
+    pShared->scene = std::move(graph);
+    loader.unload();
+
+    std::shared_ptr<SharedScene> owner{pShared};
+    ret = SceneAssetHandle{owner, &owner->scene};
+    entry = ret;
+
+    LS_LOG_MSG(
+        "Registered the shared scene ", filepath, " with ", pShared->textures.size(), " shared textures."
+    );
+
+    return ret;
+}
+
+
+
+/*-------------------------------------
+ * Delete released GPU data
+-------------------------------------*/
+size_t AssetRegistry::flush_releases() noexcept
+{
+    std::vector<Texture> releasedTextures;
+    std::vector<SceneGraph> releasedScenes;
+
+    // Terminate outside of the lock so other threads can keep releasing
+    // handles.
+    {
+        std::lock_guard<std::mutex> guard{releaseQueue->lock};
+        releasedTextures.swap(releaseQueue->textures);
+        releasedScenes.swap(releaseQueue->scenes);
+    }
+
+    for (Texture& tex : releasedTextures)
+    {
+        tex.terminate();
+    }
+
+    for (SceneGraph& scene : releasedScenes)
+    {
+        scene.terminate();
+    }
+
+    return releasedTextures.size() + releasedScenes.size();
+}
+
+
+
+/*-------------------------------------
+ * Remove released entries
+-------------------------------------*/
+size_t AssetRegistry::prune() noexcept
+{
+    std::lock_guard<std::mutex> guard{lock};
+    size_t numRemoved = 0;
+
+    for (std::unordered_map<std::string, std::weak_ptr<const Texture>>::iterator iter = textures.begin(); iter != textures.end();)
+    {
+        if (iter->second.expired())
+        {
+            iter = textures.erase(iter);
+            ++numRemoved;
+        }
+        else
+        {
+            ++iter;
+        }
+    }
+
+    for (std::unordered_map<std::string, std::weak_ptr<const SceneGraph>>::iterator iter = scenes.begin(); iter != scenes.end();)
+    {
+        if (iter->second.expired())
+        {
+            iter = scenes.erase(iter);
+            ++numRemoved;
+        }
+        else
+        {
+            ++iter;
+        }
+    }
+
+    return numRemoved;
+}
+
+
+
+/*-------------------------------------
+ * Count live textures
+-------------------------------------*/
+size_t AssetRegistry::get_num_textures() const noexcept
+{
+    std::lock_guard<std::mutex> guard{lock};
+    size_t numTextures = 0;
+
+    for (const std::pair<const std::string, std::weak_ptr<const Texture>>& tex : textures)
+    {
+        numTextures += tex.second.expired() ? 0 : 1;
+    }
+
+    return numTextures;
+}
+
+
+
+/*-------------------------------------
+ * Count live scenes
+-------------------------------------*/
+size_t AssetRegistry::get_num_scenes() const noexcept
+{
+    std::lock_guard<std::mutex> guard{lock};
+    size_t numScenes = 0;
+
+    for (const std::pair<const std::string, std::weak_ptr<const SceneGraph>>& scene : scenes)
+    {
+        numScenes += scene.second.expired() ? 0 : 1;
+    }
+
+    return numScenes;
+}
+} // end draw namespace
+} // end ls namespace
@@ -0,0 +1,234 @@
+
+#include <algorithm> // std::lower_bound
+#include <utility> // std::move
+
+#include "lightsky/utils/Assertions.h"
+
+#include "lightsky/draw/BufferSuballocator.h"
+
+
+
+namespace ls
+{
+namespace draw
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * BufferSuballocator Class
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Destructor
+-------------------------------------*/
+BufferSuballocator::~BufferSuballocator() noexcept
+{
+}
+
+
+
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+BufferSuballocator::BufferSuballocator() noexcept :
+    capacity{0},
+    numBytesUsed{0},
+    freeRanges{}
+{
+}
+
+
+
+/*-------------------------------------
+ * Copy Constructor
+-------------------------------------*/
+BufferSuballocator::BufferSuballocator(const BufferSuballocator& a) noexcept :
+    capacity{a.capacity},
+    numBytesUsed{a.numBytesUsed},
+    freeRanges{a.freeRanges}
+{
+}
+
+
+
+/*-------------------------------------
+ * Move Constructor
+-------------------------------------*/
+BufferSuballocator::BufferSuballocator(BufferSuballocator&& a) noexcept :
+    capacity{a.capacity},
+    numBytesUsed{a.numBytesUsed},
+    freeRanges{std::move(a.freeRanges)}
+{
+    a.capacity = 0;
+    a.numBytesUsed = 0;
+}
+
+
+
+/*-------------------------------------
+ * Copy Operator
+-------------------------------------*/
+BufferSuballocator& BufferSuballocator::operator=(const BufferSuballocator& a) noexcept
+{
+    capacity = a.capacity;
+    numBytesUsed = a.numBytesUsed;
+    freeRanges = a.freeRanges;
+
+    return *this;
+}
+
+
+
+/*-------------------------------------
+ * Move Operator
+-------------------------------------*/
+BufferSuballocator& BufferSuballocator::operator=(BufferSuballocator&& a) noexcept
+{
+    capacity = a.capacity;
+    a.capacity = 0;
+
+    numBytesUsed = a.numBytesUsed;
+    a.numBytesUsed = 0;
+
+    freeRanges = std::move(a.freeRanges);
+
+    return *this;
+}
+
+
+
+/*-------------------------------------
+ * Release all allocations
+-------------------------------------*/
+void BufferSuballocator::reset(const size_t numBytes) noexcept
+{
+    capacity = numBytes;
+    numBytesUsed = 0;
+    freeRanges.clear();
+
+    if (numBytes)
+    {
+        freeRanges.push_back(BufferRange{0, numBytes});
+    }
+}
+
+
+
+/*-------------------------------------
+ * Allocate a range
+-------------------------------------*/
+bool BufferSuballocator::allocate(const size_t numBytes, const size_t alignment, size_t& outOffset) noexcept
+{
+    LS_DEBUG_ASSERT(numBytes > 0);
+    LS_DEBUG_ASSERT(alignment > 0);
+
+    for (std::vector<BufferRange>::iterator iter = freeRanges.begin(); iter != freeRanges.end(); ++iter)
+    {
+        const size_t offset = iter->offset;
+        const size_t rangeEnd = offset + iter->numBytes;
+        const size_t alignedOffset = ((offset + alignment - 1) / alignment) * alignment;
+
+        if (alignedOffset > rangeEnd || numBytes > rangeEnd - alignedOffset)
+        {
+            continue;
+        }
+
+        const size_t allocEnd = alignedOffset + numBytes;
+
+        // The padding before an aligned allocation remains free, splitting
+        // the range in two.
+        if (alignedOffset != offset && allocEnd != rangeEnd)
+        {
+            iter->numBytes = alignedOffset - offset;
+            freeRanges.insert(iter + 1, BufferRange{allocEnd, rangeEnd - allocEnd});
+        }
+        else if (alignedOffset != offset)
+        {
+            iter->numBytes = alignedOffset - offset;
+        }
+        else if (allocEnd != rangeEnd)
+        {
+            iter->offset = allocEnd;
+            iter->numBytes = rangeEnd - allocEnd;
+        }
+        else
+        {
+            freeRanges.erase(iter);
+        }
+
+        numBytesUsed += numBytes;
+        outOffset = alignedOffset;
+        return true;
+    }
+
+    return false;
+}
+
+
+
+/*-------------------------------------
+ * Release a range
+-------------------------------------*/
+void BufferSuballocator::free(const size_t offset, const size_t numBytes) noexcept
+{
+    LS_DEBUG_ASSERT(numBytes <= numBytesUsed);
+    LS_DEBUG_ASSERT(offset + numBytes <= capacity);
+
+    if (!numBytes)
+    {
+        return;
+    }
+
+    numBytesUsed -= numBytes;
+
+    std::vector<BufferRange>::iterator next = std::lower_bound(
+        freeRanges.begin(),
+        freeRanges.end(),
+        offset,
+        [](const BufferRange& r, const size_t o) -> bool
+        {
+            return r.offset < o;
+        }
+    );
+
+    const bool mergePrev = next != freeRanges.begin() && (next - 1)->offset + (next - 1)->numBytes == offset;
+    const bool mergeNext = next != freeRanges.end() && offset + numBytes == next->offset;
+
+    if (mergePrev && mergeNext)
+    {
+        (next - 1)->numBytes += numBytes + next->numBytes;
+        freeRanges.erase(next);
+    }
+    else if (mergePrev)
+    {
+        (next - 1)->numBytes += numBytes;
+    }
+    else if (mergeNext)
+    {
+        next->offset = offset;
+        next->numBytes += numBytes;
+    }
+    else
+    {
+        freeRanges.insert(next, BufferRange{offset, numBytes});
+    }
+}
+
+
+
+/*-------------------------------------
+ * Retrieve the largest free range
+-------------------------------------*/
+size_t BufferSuballocator::get_largest_free_range() const noexcept
+{
+    size_t largest = 0;
+
+    for (const BufferRange& r : freeRanges)
+    {
+        largest = r.numBytes > largest ? r.numBytes : largest;
+    }
+
+    return largest;
+}
+} // end draw namespace
+} // end ls namespace
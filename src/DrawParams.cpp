@@ -18,7 +18,8 @@ DrawCommandParams::DrawCommandParams() noexcept :
     drawMode{draw_mode_t::DRAW_MODE_TRIS},
     indexType{index_element_t::INDEX_TYPE_NONE},
     first{0},
-    count{0}
+    count{0},
+    baseVertex{0}
 {
 }
 
@@ -42,6 +43,7 @@ DrawCommandParams::DrawCommandParams(const DrawCommandParams& d) noexcept :
     }
 
     count = d.count;
+    baseVertex = d.baseVertex;
 }
 
 /*-------------------------------------
@@ -73,6 +75,9 @@ DrawCommandParams::DrawCommandParams(DrawCommandParams&& d) noexcept :
 
     count = d.count;
     d.count = 0;
+
+    baseVertex = d.baseVertex;
+    d.baseVertex = 0;
 }
 
 /*-------------------------------------
@@ -96,6 +101,7 @@ DrawCommandParams& DrawCommandParams::operator=(const DrawCommandParams& d) noex
     }
 
     count = d.count;
+    baseVertex = d.baseVertex;
 
     return *this;
 }
@@ -132,6 +138,9 @@ DrawCommandParams& DrawCommandParams::operator=(DrawCommandParams&& d) noexcept
     count = d.count;
     d.count = 0;
 
+    baseVertex = d.baseVertex;
+    d.baseVertex = 0;
+
     return *this;
 }
 
@@ -149,6 +158,56 @@ void DrawCommandParams::reset() noexcept
     indexType = index_element_t::INDEX_TYPE_DEFAULT;
     first = 0;
     count = 0;
+    baseVertex = 0;
+}
+
+
+
+/*-------------------------------------
+ * Issue a draw call
+-------------------------------------*/
+void submit_draw_command(const DrawCommandParams& params, const unsigned numInstances) noexcept
+{
+    const GLenum mode = params.drawMode;
+    const GLsizei count = (GLsizei)params.count;
+
+    if (!(params.drawFunc & draw_func_t::DRAW_ELEMENTS))
+    {
+        if (numInstances == 1)
+        {
+            glDrawArrays(mode, (GLint)params.first, count);
+        }
+        else
+        {
+            glDrawArraysInstanced(mode, (GLint)params.first, count, (GLsizei)numInstances);
+        }
+    }
+    #if defined(LS_DRAW_BASE_VERTEX_SUPPORTED)
+    else if (params.baseVertex)
+    {
+        if (numInstances == 1)
+        {
+            glDrawElementsBaseVertex(mode, count, params.indexType, params.offset, params.baseVertex);
+        }
+        else
+        {
+            glDrawElementsInstancedBaseVertex(mode, count, params.indexType, params.offset, (GLsizei)numInstances, params.baseVertex);
+        }
+    }
+    #endif
+    else
+    {
+        if (numInstances == 1)
+        {
+            glDrawElements(mode, count, params.indexType, params.offset);
+        }
+        else
+        {
+            glDrawElementsInstanced(mode, count, params.indexType, params.offset, (GLsizei)numInstances);
+        }
+    }
+
+    LS_LOG_GL_ERR();
 }
 } // end draw namespace
 } // end ls namespace
@@ -0,0 +1,728 @@
+
+#include <algorithm> // std::sort
+#include <memory> // std::nothrow
+#include <unordered_map>
+#include <utility> // std::move
+
+#include "lightsky/utils/Log.h"
+#include "lightsky/utils/Pointer.h"
+
+#include "lightsky/draw/GeometryPool.h"
+#include "lightsky/draw/SceneGraph.h"
+#include "lightsky/draw/SceneMesh.h"
+#include "lightsky/draw/SceneNode.h"
+#include "lightsky/draw/VAOAssembly.h"
+#include "lightsky/draw/VBOAttrib.h"
+
+
+
+/*-----------------------------------------------------------------------------
+ * Anonymous helper functions
+-----------------------------------------------------------------------------*/
+namespace
+{
+
+namespace draw = ls::draw;
+
+
+
+/*-------------------------------------
+ * Copy a range between two GPU buffers
+-------------------------------------*/
+inline void copy_buffer_range(
+    const uint32_t srcId,
+    const uint32_t dstId,
+    const uint32_t srcOffset,
+    const uint32_t dstOffset,
+    const uint32_t numBytes
+) noexcept
+{
+    // The copy targets avoid disturbing any bound VAO.
+    glBindBuffer(draw::VBO_COPY_READ, srcId);
+    glBindBuffer(draw::VBO_COPY_WRITE, dstId);
+    glCopyBufferSubData(draw::VBO_COPY_READ, draw::VBO_COPY_WRITE, (GLintptr)srcOffset, (GLintptr)dstOffset, (GLsizeiptr)numBytes);
+    glBindBuffer(draw::VBO_COPY_READ, 0);
+    glBindBuffer(draw::VBO_COPY_WRITE, 0);
+}
+
+
+
+} // end anonymous namespace
+
+
+
+namespace ls
+{
+namespace draw
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * GeometryPool Class
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Destructor
+-------------------------------------*/
+GeometryPool::~GeometryPool() noexcept
+{
+    terminate();
+}
+
+
+
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+GeometryPool::GeometryPool() noexcept :
+    vboBytesPerLayout{0},
+    ibo{},
+    iboAllocator{},
+    stagingBuffer{},
+    stagingBytes{0},
+    layouts{},
+    entries{},
+    freeEntries{}
+{
+}
+
+
+
+/*-------------------------------------
+ * Move Constructor
+-------------------------------------*/
+GeometryPool::GeometryPool(GeometryPool&& p) noexcept :
+    vboBytesPerLayout{p.vboBytesPerLayout},
+    ibo{std::move(p.ibo)},
+    iboAllocator{std::move(p.iboAllocator)},
+    stagingBuffer{std::move(p.stagingBuffer)},
+    stagingBytes{p.stagingBytes},
+    layouts{std::move(p.layouts)},
+    entries{std::move(p.entries)},
+    freeEntries{std::move(p.freeEntries)}
+{
+    p.vboBytesPerLayout = 0;
+    p.stagingBytes = 0;
+}
+
+
+
+/*-------------------------------------
+ * Move Operator
+-------------------------------------*/
+GeometryPool& GeometryPool::operator=(GeometryPool&& p) noexcept
+{
+    if (this != &p)
+    {
+        terminate();
+
+        vboBytesPerLayout = p.vboBytesPerLayout;
+        p.vboBytesPerLayout = 0;
+
+        ibo = std::move(p.ibo);
+        iboAllocator = std::move(p.iboAllocator);
+        stagingBuffer = std::move(p.stagingBuffer);
+
+        stagingBytes = p.stagingBytes;
+        p.stagingBytes = 0;
+
+        layouts = std::move(p.layouts);
+        entries = std::move(p.entries);
+        freeEntries = std::move(p.freeEntries);
+    }
+
+    return *this;
+}
+
+
+
+/*-------------------------------------
+ * Initialization
+-------------------------------------*/
+bool GeometryPool::init(const uint32_t vboBytes, const uint32_t iboBytes) noexcept
+{
+    terminate();
+
+    #if !defined(LS_DRAW_BASE_VERTEX_SUPPORTED)
+        (void)vboBytes;
+        (void)iboBytes;
+        LS_LOG_ERR("Error: Geometry pools require base-vertex draws, which are unavailable with the current graphics API.");
+        return false;
+    #else
+        if (!vboBytes || !iboBytes)
+        {
+            LS_LOG_ERR("Error: Unable to initialize a geometry pool with an empty VBO or IBO.");
+            return false;
+        }
+
+        if (!ibo.init() || !ibo.setup_attribs(1))
+        {
+            ibo.terminate();
+            LS_LOG_ERR("Error: Unable to initialize the IBO of a geometry pool.");
+            return false;
+        }
+
+        ibo.bind();
+        ibo.set_data(iboBytes, nullptr, buffer_access_t::VBO_DYNAMIC_DRAW);
+        ibo.unbind();
+
+        iboAllocator.reset(iboBytes);
+        vboBytesPerLayout = vboBytes;
+
+        LS_LOG_MSG("Initialized a geometry pool with ", iboBytes, " index bytes and ", vboBytes, " vertex bytes per layout.");
+
+        return true;
+    #endif
+}
+
+
+
+/*-------------------------------------
+ * Termination
+-------------------------------------*/
+void GeometryPool::terminate() noexcept
+{
+    for (GeometryPoolLayout& layout : layouts)
+    {
+        layout.vao.terminate();
+        layout.vbo.terminate();
+    }
+
+    ibo.terminate();
+    stagingBuffer.terminate();
+
+    vboBytesPerLayout = 0;
+    iboAllocator.reset(0);
+    stagingBytes = 0;
+    layouts.clear();
+    entries.clear();
+    freeEntries.clear();
+}
+
+
+
+/*-------------------------------------
+ * Locate or create a vertex layout
+-------------------------------------*/
+uint32_t GeometryPool::find_or_add_layout(const common_vertex_t vertTypes) noexcept
+{
+    for (uint32_t i = 0; i < (uint32_t)layouts.size(); ++i)
+    {
+        if (layouts[i].vertTypes == vertTypes)
+        {
+            return i;
+        }
+    }
+
+    GeometryPoolLayout layout;
+    layout.vertTypes = vertTypes;
+    layout.vertStride = get_vertex_byte_size(vertTypes);
+
+    if (!layout.vertStride || !layout.vbo.init() || !layout.vbo.setup_attribs(vertTypes))
+    {
+        layout.vbo.terminate();
+        LS_LOG_ERR("Error: Unable to initialize a geometry pool VBO for the vertex types ", vertTypes, '.');
+        return GEOMETRY_POOL_INVALID_ID;
+    }
+
+    layout.vbo.bind();
+    layout.vbo.set_data(vboBytesPerLayout, nullptr, buffer_access_t::VBO_DYNAMIC_DRAW);
+    layout.vbo.unbind();
+
+    utils::Pointer<VAOAssembly> assembly{new(std::nothrow) VAOAssembly{}};
+
+    if (!assembly)
+    {
+        layout.vbo.terminate();
+        LS_LOG_ERR("Error: Unable to instantiate a VAO assembly for a geometry pool.");
+        return GEOMETRY_POOL_INVALID_ID;
+    }
+
+    // Every allocation is located with a base vertex, so all attributes
+    // begin at the start of the VBO.
+    const char* const* attribNames = get_common_vertex_names();
+    unsigned currentAttribId = 0;
+
+    for (unsigned k = 0; k < COMMON_VERTEX_FLAGS_COUNT; ++k)
+    {
+        if (0 != (vertTypes & COMMON_VERTEX_FLAGS_LIST[k]))
+        {
+            VBOAttrib& a = layout.vbo.get_attrib(currentAttribId);
+            a.set_offset((void*)(ptrdiff_t)get_vertex_attrib_offset(vertTypes, COMMON_VERTEX_FLAGS_LIST[k]));
+
+            assembly->set_vbo_attrib(currentAttribId, layout.vbo, currentAttribId);
+            assembly->set_attrib_name(currentAttribId, attribNames[k]);
+            currentAttribId++;
+        }
+    }
+
+    assembly->set_ibo_attrib(ibo);
+
+    if (!assembly->assemble(layout.vao))
+    {
+        layout.vbo.terminate();
+        LS_LOG_ERR("Error: Unable to assemble a geometry pool VAO for the vertex types ", vertTypes, '.');
+        return GEOMETRY_POOL_INVALID_ID;
+    }
+
+    layout.allocator.reset(vboBytesPerLayout);
+    layouts.push_back(std::move(layout));
+
+    LS_LOG_MSG("Added a geometry pool layout for the vertex types ", vertTypes, '.');
+
+    return (uint32_t)layouts.size() - 1;
+}
+
+
+
+/*-------------------------------------
+ * Reserve space for an allocation
+-------------------------------------*/
+uint32_t GeometryPool::reserve_entry(
+    const common_vertex_t vertTypes,
+    const uint32_t numVertBytes,
+    const uint32_t numIndexBytes,
+    const index_element_t indexType
+) noexcept
+{
+    if (!ibo.is_valid() || !numVertBytes || !numIndexBytes)
+    {
+        return GEOMETRY_POOL_INVALID_ID;
+    }
+
+    const uint32_t layoutId = find_or_add_layout(vertTypes);
+    if (layoutId == GEOMETRY_POOL_INVALID_ID)
+    {
+        return GEOMETRY_POOL_INVALID_ID;
+    }
+
+    GeometryPoolLayout& layout = layouts[layoutId];
+    size_t vboOffset = 0;
+    size_t iboOffset = 0;
+
+    // Vertices are placed at a multiple of their stride so they can be
+    // located using a base vertex.
+    if (!layout.allocator.allocate(numVertBytes, layout.vertStride, vboOffset))
+    {
+        return GEOMETRY_POOL_INVALID_ID;
+    }
+
+    if (!iboAllocator.allocate(numIndexBytes, get_index_byte_size(indexType), iboOffset))
+    {
+        layout.allocator.free(vboOffset, numVertBytes);
+        return GEOMETRY_POOL_INVALID_ID;
+    }
+
+    uint32_t entryId;
+
+    if (!freeEntries.empty())
+    {
+        entryId = freeEntries.back();
+        freeEntries.pop_back();
+    }
+    else
+    {
+        entryId = (uint32_t)entries.size();
+        entries.emplace_back();
+    }
+
+    GeometryPoolEntry& entry = entries[entryId];
+    entry.layoutId = layoutId;
+    entry.vboOffset = (uint32_t)vboOffset;
+    entry.numVertBytes = numVertBytes;
+    entry.iboOffset = (uint32_t)iboOffset;
+    entry.numIndexBytes = numIndexBytes;
+    entry.indexBias = 0;
+    entry.isUsed = true;
+
+    DrawCommandParams& drawParams = entry.drawParams;
+    drawParams.materialId = 0;
+    drawParams.drawFunc = draw_func_t::DRAW_ELEMENTS;
+    drawParams.drawMode = draw_mode_t::DRAW_MODE_DEFAULT;
+    drawParams.indexType = indexType;
+    drawParams.count = numIndexBytes / get_index_byte_size(indexType);
+
+    return entryId;
+}
+
+
+
+/*-------------------------------------
+ * Grow the staging buffer
+-------------------------------------*/
+bool GeometryPool::reserve_staging(const uint32_t numBytes) noexcept
+{
+    if (numBytes <= stagingBytes)
+    {
+        return true;
+    }
+
+    if (!stagingBuffer.is_valid() && !stagingBuffer.init())
+    {
+        LS_LOG_ERR("Error: Unable to initialize the staging buffer of a geometry pool.");
+        return false;
+    }
+
+    glBindBuffer(VBO_COPY_WRITE, stagingBuffer.gpu_id());
+    glBufferData(VBO_COPY_WRITE, (GLsizeiptr)numBytes, nullptr, buffer_access_t::VBO_STREAM_COPY);
+    glBindBuffer(VBO_COPY_WRITE, 0);
+
+    stagingBytes = numBytes;
+
+    return true;
+}
+
+
+
+/*-------------------------------------
+ * Move a range within a buffer
+-------------------------------------*/
+void GeometryPool::move_range(const BufferObject& buffer, const uint32_t srcOffset, const uint32_t dstOffset, const uint32_t numBytes) noexcept
+{
+    const bool overlaps = srcOffset < dstOffset + numBytes && dstOffset < srcOffset + numBytes;
+
+    // Copies within the same buffer may not overlap.
+    if (!overlaps)
+    {
+        copy_buffer_range(buffer.gpu_id(), buffer.gpu_id(), srcOffset, dstOffset, numBytes);
+        return;
+    }
+
+    LS_DEBUG_ASSERT(numBytes <= stagingBytes);
+
+    copy_buffer_range(buffer.gpu_id(), stagingBuffer.gpu_id(), srcOffset, 0, numBytes);
+    copy_buffer_range(stagingBuffer.gpu_id(), buffer.gpu_id(), 0, dstOffset, numBytes);
+}
+
+
+
+/*-------------------------------------
+ * Update an entry's draw parameters
+-------------------------------------*/
+void GeometryPool::update_draw_params(GeometryPoolEntry& entry) noexcept
+{
+    const GeometryPoolLayout& layout = layouts[entry.layoutId];
+    DrawCommandParams& drawParams = entry.drawParams;
+    const uint32_t firstVert = entry.vboOffset / layout.vertStride;
+
+    drawParams.vaoId = layout.vao.gpu_id();
+    drawParams.offset = (void*)(ptrdiff_t)entry.iboOffset;
+    drawParams.baseVertex = (int32_t)firstVert - (int32_t)entry.indexBias;
+}
+
+
+
+/*-------------------------------------
+ * Upload geometry into the pool
+-------------------------------------*/
+uint32_t GeometryPool::allocate(
+    const common_vertex_t vertTypes,
+    const uint32_t numVerts,
+    const void* const pVerts,
+    const index_element_t indexType,
+    const uint32_t numIndices,
+    const void* const pIndices,
+    const draw_mode_t drawMode
+) noexcept
+{
+    const uint32_t numVertBytes = numVerts * get_vertex_byte_size(vertTypes);
+    const uint32_t numIndexBytes = numIndices * get_index_byte_size(indexType);
+    const uint32_t entryId = reserve_entry(vertTypes, numVertBytes, numIndexBytes, indexType);
+
+    if (entryId == GEOMETRY_POOL_INVALID_ID)
+    {
+        LS_LOG_ERR("Error: Unable to allocate ", numVertBytes, " vertex bytes and ", numIndexBytes, " index bytes from a geometry pool.");
+        return GEOMETRY_POOL_INVALID_ID;
+    }
+
+    GeometryPoolEntry& entry = entries[entryId];
+    GeometryPoolLayout& layout = layouts[entry.layoutId];
+
+    // A bound VAO would otherwise capture the pool's IBO.
+    glBindVertexArray(0);
+
+    layout.vbo.bind();
+    layout.vbo.modify((ptrdiff_t)entry.vboOffset, numVertBytes, pVerts);
+    layout.vbo.unbind();
+
+    ibo.bind();
+    ibo.modify((ptrdiff_t)entry.iboOffset, numIndexBytes, pIndices);
+    ibo.unbind();
+
+    entry.drawParams.drawMode = drawMode;
+    update_draw_params(entry);
+
+    return entryId;
+}
+
+
+
+/*-------------------------------------
+ * Release an allocation
+-------------------------------------*/
+void GeometryPool::free(const uint32_t entryId) noexcept
+{
+    if (entryId >= entries.size() || !entries[entryId].isUsed)
+    {
+        return;
+    }
+
+    GeometryPoolEntry& entry = entries[entryId];
+
+    layouts[entry.layoutId].allocator.free(entry.vboOffset, entry.numVertBytes);
+    iboAllocator.free(entry.iboOffset, entry.numIndexBytes);
+
+    entry.isUsed = false;
+    freeEntries.push_back(entryId);
+}
+
+
+
+/*-------------------------------------
+ * Move a scene's meshes into the pool
+-------------------------------------*/
+bool GeometryPool::import_scene(SceneGraph& scene, std::vector<uint32_t>& outEntryIds) noexcept
+{
+    GLContextData& renderData = scene.renderData;
+    const std::vector<SceneMesh>& meshes = scene.meshes;
+
+    if (renderData.vbos.size() != 1 || renderData.ibos.size() != 1)
+    {
+        LS_LOG_ERR("Error: Only scenes with a single VBO and IBO can be imported into a geometry pool.");
+        return false;
+    }
+
+    const uint32_t srcVboId = renderData.vbos[0].gpu_id();
+    const uint32_t srcIboId = renderData.ibos[0].gpu_id();
+    std::vector<uint32_t> entryIds;
+    entryIds.reserve(meshes.size());
+
+    for (const SceneMesh& mesh : meshes)
+    {
+        const MeshMetaData& metaData = mesh.metaData;
+        const DrawCommandParams& srcParams = mesh.drawParams;
+        uint32_t entryId = GEOMETRY_POOL_INVALID_ID;
+
+        if (0 != (srcParams.drawFunc & draw_func_t::DRAW_ELEMENTS))
+        {
+            entryId = reserve_entry(metaData.vertTypes, metaData.calc_total_vertex_bytes(), metaData.calc_total_index_bytes(), metaData.indexType);
+        }
+
+        if (entryId == GEOMETRY_POOL_INVALID_ID)
+        {
+            LS_LOG_ERR("Error: Unable to import mesh ", entryIds.size(), " into a geometry pool.");
+
+            for (const uint32_t id : entryIds)
+            {
+                free(id);
+            }
+
+            return false;
+        }
+
+        GeometryPoolEntry& entry = entries[entryId];
+        const GeometryPoolLayout& layout = layouts[entry.layoutId];
+
+        copy_buffer_range(srcVboId, layout.vbo.gpu_id(), metaData.vboOffset, entry.vboOffset, entry.numVertBytes);
+        copy_buffer_range(srcIboId, ibo.gpu_id(), (uint32_t)(ptrdiff_t)srcParams.offset, entry.iboOffset, entry.numIndexBytes);
+
+        // Imported indices may already include the mesh's original location.
+        entry.indexBias = metaData.baseVertex - (uint32_t)srcParams.baseVertex;
+        entry.drawParams.materialId = srcParams.materialId;
+        entry.drawParams.drawMode = srcParams.drawMode;
+        entry.drawParams.count = srcParams.count;
+        update_draw_params(entry);
+
+        entryIds.push_back(entryId);
+    }
+
+    update_scene(scene, entryIds);
+
+    // The scene now draws entirely from the pool.
+    renderData.vaos.clear();
+    renderData.vbos.clear();
+    renderData.ibos.clear();
+
+    LS_LOG_MSG("Imported ", entryIds.size(), " meshes into a geometry pool.");
+
+    outEntryIds = std::move(entryIds);
+    return true;
+}
+
+
+
+/*-------------------------------------
+ * Synchronize a scene with the pool
+-------------------------------------*/
+void GeometryPool::update_scene(SceneGraph& scene, const std::vector<uint32_t>& entryIds) const noexcept
+{
+    std::vector<SceneMesh>& meshes = scene.meshes;
+
+    LS_DEBUG_ASSERT(entryIds.size() == meshes.size());
+
+    // Node draw commands are copies of their mesh's draw parameters. Each
+    // mesh occupies its own range of an IBO, so its index offset is unique.
+    std::unordered_map<uint64_t, uint32_t> meshIds;
+    meshIds.reserve(meshes.size());
+
+    for (uint32_t i = 0; i < (uint32_t)meshes.size(); ++i)
+    {
+        meshIds[(uint64_t)(ptrdiff_t)meshes[i].drawParams.offset] = i;
+    }
+
+    for (const SceneNode& node : scene.nodes)
+    {
+        if (node.type != scene_node_t::NODE_TYPE_MESH)
+        {
+            continue;
+        }
+
+        DrawCommandParams* const pNodeMeshes = scene.nodeMeshes[node.dataId].get();
+
+        for (uint32_t j = 0; j < scene.nodeMeshCounts[node.dataId]; ++j)
+        {
+            DrawCommandParams& nodeParams = pNodeMeshes[j];
+            const std::unordered_map<uint64_t, uint32_t>::const_iterator iter = meshIds.find((uint64_t)(ptrdiff_t)nodeParams.offset);
+
+            if (iter != meshIds.end())
+            {
+                const DrawCommandParams& pooledParams = entries[entryIds[iter->second]].drawParams;
+
+                nodeParams.vaoId = pooledParams.vaoId;
+                nodeParams.offset = pooledParams.offset;
+                nodeParams.baseVertex = pooledParams.baseVertex;
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < (uint32_t)meshes.size(); ++i)
+    {
+        const GeometryPoolEntry& entry = entries[entryIds[i]];
+        const uint32_t firstVert = entry.vboOffset / layouts[entry.layoutId].vertStride;
+        SceneMesh& mesh = meshes[i];
+
+        mesh.drawParams.vaoId = entry.drawParams.vaoId;
+        mesh.drawParams.offset = entry.drawParams.offset;
+        mesh.drawParams.baseVertex = entry.drawParams.baseVertex;
+
+        mesh.metaData.vboOffset = entry.vboOffset;
+        mesh.metaData.baseVertex = firstVert;
+
+        if (i < scene.morphs.size() && scene.morphs[i].numVerts)
+        {
+            scene.morphs[i].baseVertex = firstVert;
+        }
+    }
+}
+
+
+
+/*-------------------------------------
+ * Compact all buffers
+-------------------------------------*/
+uint64_t GeometryPool::defragment(const uint64_t maxBytes) noexcept
+{
+    uint64_t numBytesMoved = 0;
+    std::vector<uint32_t> order;
+    order.reserve(entries.size());
+
+    const auto hasBudget = [&]() -> bool
+    {
+        return !maxBytes || numBytesMoved < maxBytes;
+    };
+
+    // Vertices
+    for (uint32_t layoutId = 0; hasBudget() && layoutId < (uint32_t)layouts.size(); ++layoutId)
+    {
+        GeometryPoolLayout& layout = layouts[layoutId];
+        order.clear();
+
+        for (uint32_t i = 0; i < (uint32_t)entries.size(); ++i)
+        {
+            if (entries[i].isUsed && entries[i].layoutId == layoutId)
+            {
+                order.push_back(i);
+            }
+        }
+
+        std::sort(order.begin(), order.end(), [&](const uint32_t a, const uint32_t b) -> bool
+        {
+            return entries[a].vboOffset < entries[b].vboOffset;
+        });
+
+        for (uint32_t i = 0; hasBudget() && i < (uint32_t)order.size(); ++i)
+        {
+            GeometryPoolEntry& entry = entries[order[i]];
+            size_t newOffset = 0;
+
+            if (!reserve_staging(entry.numVertBytes))
+            {
+                return numBytesMoved;
+            }
+
+            // The released range merges with any free space before it, so the
+            // first fit is never located after the current offset.
+            layout.allocator.free(entry.vboOffset, entry.numVertBytes);
+            const bool isReallocated = layout.allocator.allocate(entry.numVertBytes, layout.vertStride, newOffset);
+            LS_DEBUG_ASSERT(isReallocated);
+            (void)isReallocated;
+
+            if ((uint32_t)newOffset != entry.vboOffset)
+            {
+                move_range(layout.vbo, entry.vboOffset, (uint32_t)newOffset, entry.numVertBytes);
+                entry.vboOffset = (uint32_t)newOffset;
+                numBytesMoved += entry.numVertBytes;
+                update_draw_params(entry);
+            }
+        }
+    }
+
+    // Indices
+    order.clear();
+
+    for (uint32_t i = 0; i < (uint32_t)entries.size(); ++i)
+    {
+        if (entries[i].isUsed)
+        {
+            order.push_back(i);
+        }
+    }
+
+    std::sort(order.begin(), order.end(), [&](const uint32_t a, const uint32_t b) -> bool
+    {
+        return entries[a].iboOffset < entries[b].iboOffset;
+    });
+
+    for (uint32_t i = 0; hasBudget() && i < (uint32_t)order.size(); ++i)
+    {
+        GeometryPoolEntry& entry = entries[order[i]];
+        size_t newOffset = 0;
+
+        if (!reserve_staging(entry.numIndexBytes))
+        {
+            break;
+        }
+
+        iboAllocator.free(entry.iboOffset, entry.numIndexBytes);
+        const bool isReallocated = iboAllocator.allocate(entry.numIndexBytes, get_index_byte_size(entry.drawParams.indexType), newOffset);
+        LS_DEBUG_ASSERT(isReallocated);
+        (void)isReallocated;
+
+        if ((uint32_t)newOffset != entry.iboOffset)
+        {
+            move_range(ibo, entry.iboOffset, (uint32_t)newOffset, entry.numIndexBytes);
+            entry.iboOffset = (uint32_t)newOffset;
+            numBytesMoved += entry.numIndexBytes;
+            update_draw_params(entry);
+        }
+    }
+
+    if (numBytesMoved)
+    {
+        LS_LOG_MSG("Moved ", numBytesMoved, " bytes while defragmenting a geometry pool.");
+    }
+
+    return numBytesMoved;
+}
+} // end draw namespace
+} // end ls namespace
@@ -0,0 +1,882 @@
+
+#include <cstring> // std::memset()
+
+#if defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+    #define LS_DRAW_CODEC_SSE 1
+#elif defined(__ARM_NEON)
+    #include <arm_neon.h>
+    #define LS_DRAW_CODEC_NEON 1
+#endif
+
+#include "lightsky/utils/Copy.h"
+
+#include "lightsky/draw/MeshCodec.h"
+
+
+
+/*-----------------------------------------------------------------------------
+ * Anonymous helper functions
+-----------------------------------------------------------------------------*/
+namespace
+{
+
+namespace utils = ls::utils;
+
+
+
+/*-------------------------------------
+ * Entropy stage constants
+-------------------------------------*/
+enum entropy_stream_t : uint8_t
+{
+    // Bytes are stored as-is.
+    ENTROPY_STREAM_STORED = 0,
+
+    // Every byte contains the same value.
+    ENTROPY_STREAM_CONSTANT = 1,
+
+    // Bytes are encoded using an order-0 rANS coder with two interleaved
+    // states and 16-bit renormalization.
+    ENTROPY_STREAM_RANS = 2
+};
+
+enum entropy_property_t : uint32_t
+{
+    RANS_PROB_BITS = 12,
+    RANS_PROB_SCALE = 1u << RANS_PROB_BITS,
+    RANS_LOWER_BOUND = 1u << 16,
+
+    // Streams shorter than this are cheaper to store than to describe with a
+    // frequency table.
+    RANS_MIN_STREAM_BYTES = 64
+};
+
+
+
+/*-------------------------------------
+ * Little-endian serialization
+-------------------------------------*/
+inline void write_codec_u16(std::vector<char>& out, const uint32_t n) noexcept
+{
+    out.push_back((char)(n & 0xFF));
+    out.push_back((char)((n >> 8) & 0xFF));
+}
+
+
+
+inline void write_codec_u32(std::vector<char>& out, const uint32_t n) noexcept
+{
+    write_codec_u16(out, n & 0xFFFF);
+    write_codec_u16(out, n >> 16);
+}
+
+
+
+inline uint32_t read_codec_u16(const uint8_t* const p) noexcept
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8);
+}
+
+
+
+inline uint32_t read_codec_u32(const uint8_t* const p) noexcept
+{
+    return read_codec_u16(p) | (read_codec_u16(p + 2) << 16);
+}
+
+
+
+/*-------------------------------------
+ * Scale symbol counts to a fixed total
+-------------------------------------*/
+void normalize_entropy_freqs(const uint32_t* const pCounts, const size_t total, uint32_t* const pFreqs) noexcept
+{
+    int32_t sum = 0;
+    unsigned largest = 0;
+
+    for (unsigned s = 0; s < 256; ++s)
+    {
+        pFreqs[s] = 0;
+
+        if (pCounts[s])
+        {
+            // Every present symbol needs a non-zero probability.
+            const uint64_t f = ((uint64_t)pCounts[s] * RANS_PROB_SCALE) / total;
+            pFreqs[s] = f ? (uint32_t)f : 1u;
+            sum += (int32_t)pFreqs[s];
+
+            if (pFreqs[s] > pFreqs[largest])
+            {
+                largest = s;
+            }
+        }
+    }
+
+    // Rounding errors are corrected on the most frequent symbols, which
+    // affects the compression ratio the least.
+    int32_t error = (int32_t)RANS_PROB_SCALE - sum;
+
+    if (error >= 0 || pFreqs[largest] > (uint32_t)(-error) * 2u)
+    {
+        pFreqs[largest] = (uint32_t)((int32_t)pFreqs[largest] + error);
+        return;
+    }
+
+    while (error < 0)
+    {
+        for (unsigned s = 0; s < 256 && error < 0; ++s)
+        {
+            if (pFreqs[s] > 1)
+            {
+                --pFreqs[s];
+                ++error;
+            }
+        }
+    }
+}
+
+
+
+/*-------------------------------------
+ * Entropy-encode a stream of bytes
+-------------------------------------*/
+void encode_entropy_stream(const uint8_t* const pIn, const size_t numBytes, std::vector<char>& out) noexcept
+{
+    uint32_t counts[256] = {0};
+    unsigned numSymbols = 0;
+
+    for (size_t i = 0; i < numBytes; ++i)
+    {
+        ++counts[pIn[i]];
+    }
+
+    for (unsigned s = 0; s < 256; ++s)
+    {
+        numSymbols += counts[s] ? 1 : 0;
+    }
+
+    if (numSymbols == 1)
+    {
+        out.push_back((char)ENTROPY_STREAM_CONSTANT);
+        out.push_back((char)pIn[0]);
+        return;
+    }
+
+    if (numBytes >= RANS_MIN_STREAM_BYTES)
+    {
+        uint32_t freqs[256];
+        uint32_t starts[256];
+        uint32_t cumulative = 0;
+
+        normalize_entropy_freqs(counts, numBytes, freqs);
+
+        for (unsigned s = 0; s < 256; ++s)
+        {
+            starts[s] = cumulative;
+            cumulative += freqs[s];
+        }
+
+        // Bytes are emitted in reverse so the decoder can read forwards.
+        std::vector<uint8_t> encoded(numBytes * 2 + 16);
+        uint8_t* const pEnd = encoded.data() + encoded.size();
+        uint8_t* p = pEnd;
+        uint32_t states[2] = {RANS_LOWER_BOUND, RANS_LOWER_BOUND};
+
+        for (size_t i = numBytes; i-- > 0;)
+        {
+            const uint8_t s = pIn[i];
+            const uint32_t f = freqs[s];
+            const uint32_t maxState = ((RANS_LOWER_BOUND >> RANS_PROB_BITS) << 16) * f;
+            uint32_t x = states[i & 1];
+
+            if (x >= maxState)
+            {
+                *--p = (uint8_t)(x >> 8);
+                *--p = (uint8_t)(x);
+                x >>= 16;
+            }
+
+            states[i & 1] = ((x / f) << RANS_PROB_BITS) + (x % f) + starts[s];
+        }
+
+        for (unsigned j = 2; j-- > 0;)
+        {
+            *--p = (uint8_t)(states[j] >> 24);
+            *--p = (uint8_t)(states[j] >> 16);
+            *--p = (uint8_t)(states[j] >> 8);
+            *--p = (uint8_t)(states[j]);
+        }
+
+        const size_t numEncoded = (size_t)(pEnd - p);
+        const size_t headerBytes = 2 + numSymbols * 3 + 4;
+
+        // Decoding stored bytes is much faster, so the entropy coder must
+        // save at least 1/8 of the stream to be worthwhile.
+        if (headerBytes + numEncoded <= numBytes - (numBytes / 8))
+        {
+            out.push_back((char)ENTROPY_STREAM_RANS);
+            out.push_back((char)(numSymbols - 1));
+
+            for (unsigned s = 0; s < 256; ++s)
+            {
+                if (freqs[s])
+                {
+                    out.push_back((char)s);
+                    write_codec_u16(out, freqs[s]);
+                }
+            }
+
+            write_codec_u32(out, (uint32_t)numEncoded);
+            out.insert(out.end(), reinterpret_cast<const char*>(p), reinterpret_cast<const char*>(pEnd));
+            return;
+        }
+    }
+
+    out.push_back((char)ENTROPY_STREAM_STORED);
+    out.insert(out.end(), reinterpret_cast<const char*>(pIn), reinterpret_cast<const char*>(pIn + numBytes));
+}
+
+
+
+/*-------------------------------------
+ * Decode a stream of bytes from the entropy stage
+-------------------------------------*/
+const uint8_t* decode_entropy_stream(
+    const uint8_t* p,
+    const uint8_t* const pEnd,
+    uint8_t* const pOut,
+    const size_t numBytes
+) noexcept
+{
+    if (p >= pEnd)
+    {
+        return nullptr;
+    }
+
+    const uint8_t mode = *p++;
+
+    if (mode == ENTROPY_STREAM_STORED)
+    {
+        if ((size_t)(pEnd - p) < numBytes)
+        {
+            return nullptr;
+        }
+
+        utils::fast_memcpy(pOut, p, numBytes);
+        return p + numBytes;
+    }
+
+    if (mode == ENTROPY_STREAM_CONSTANT)
+    {
+        if (p >= pEnd)
+        {
+            return nullptr;
+        }
+
+        std::memset(pOut, *p, numBytes);
+        return p + 1;
+    }
+
+    if (mode != ENTROPY_STREAM_RANS || p >= pEnd)
+    {
+        return nullptr;
+    }
+
+    const unsigned numSymbols = (unsigned)(*p++) + 1u;
+
+    if ((size_t)(pEnd - p) < numSymbols * 3u + 4u)
+    {
+        return nullptr;
+    }
+
+    // Each slot contains the symbol, its frequency, and the slot's offset
+    // from the start of the symbol's range so a single lookup is needed per
+    // decoded byte. No frequency can exceed 12 bits if 2+ symbols exist.
+    uint32_t slots[RANS_PROB_SCALE];
+    uint32_t cumulative = 0;
+
+    for (unsigned i = 0; i < numSymbols; ++i, p += 3)
+    {
+        const uint32_t s = p[0];
+        const uint32_t f = read_codec_u16(p + 1);
+
+        if (!f || f >= RANS_PROB_SCALE || cumulative + f > RANS_PROB_SCALE)
+        {
+            return nullptr;
+        }
+
+        for (uint32_t j = 0; j < f; ++j)
+        {
+            slots[cumulative + j] = s | (j << 8) | (f << 20);
+        }
+
+        cumulative += f;
+    }
+
+    const uint32_t numEncoded = read_codec_u32(p);
+    p += 4;
+
+    if (cumulative != RANS_PROB_SCALE || numEncoded < 8 || (size_t)(pEnd - p) < numEncoded)
+    {
+        return nullptr;
+    }
+
+    const uint8_t* const pStreamEnd = p + numEncoded;
+    uint32_t x0 = read_codec_u32(p);
+    uint32_t x1 = read_codec_u32(p + 4);
+    size_t i = 0;
+    p += 8;
+
+    // A single 16-bit read always restores a state to its normalized range.
+    // Bounds are only checked once per pair of symbols until the stream is
+    // nearly exhausted.
+    for (; i + 2 <= numBytes && (pStreamEnd - p) >= 4; i += 2)
+    {
+        const uint32_t slot0 = slots[x0 & (RANS_PROB_SCALE - 1)];
+        const uint32_t slot1 = slots[x1 & (RANS_PROB_SCALE - 1)];
+
+        pOut[i+0] = (uint8_t)slot0;
+        pOut[i+1] = (uint8_t)slot1;
+
+        x0 = (slot0 >> 20) * (x0 >> RANS_PROB_BITS) + ((slot0 >> 8) & (RANS_PROB_SCALE - 1));
+        x1 = (slot1 >> 20) * (x1 >> RANS_PROB_BITS) + ((slot1 >> 8) & (RANS_PROB_SCALE - 1));
+
+        // Renormalization depends on the data and is kept branchless.
+        const uint32_t n0 = x0 < RANS_LOWER_BOUND;
+        x0 = n0 ? ((x0 << 16) | read_codec_u16(p)) : x0;
+        p += n0 * 2;
+
+        const uint32_t n1 = x1 < RANS_LOWER_BOUND;
+        x1 = n1 ? ((x1 << 16) | read_codec_u16(p)) : x1;
+        p += n1 * 2;
+    }
+
+    for (; i < numBytes; ++i)
+    {
+        uint32_t& x = (i & 1) ? x1 : x0;
+        const uint32_t slot = slots[x & (RANS_PROB_SCALE - 1)];
+
+        pOut[i] = (uint8_t)slot;
+        x = (slot >> 20) * (x >> RANS_PROB_BITS) + ((slot >> 8) & (RANS_PROB_SCALE - 1));
+
+        if (x < RANS_LOWER_BOUND)
+        {
+            if (pStreamEnd - p < 2)
+            {
+                return nullptr;
+            }
+
+            x = (x << 16) | read_codec_u16(p);
+            p += 2;
+        }
+    }
+
+    // Both states return to their initial value once all symbols have been
+    // decoded, which doubles as an integrity check.
+    if (p != pStreamEnd || x0 != RANS_LOWER_BOUND || x1 != RANS_LOWER_BOUND)
+    {
+        return nullptr;
+    }
+
+    return pStreamEnd;
+}
+
+
+
+/*-------------------------------------
+ * Undo delta-encoding of a byte plane
+-------------------------------------*/
+#if defined(LS_DRAW_CODEC_SSE)
+
+inline void integrate_byte_plane(uint8_t* const pPlane, const size_t numBytes) noexcept
+{
+    __m128i carry = _mm_setzero_si128();
+    size_t i = 0;
+
+    for (; i + 16 <= numBytes; i += 16)
+    {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pPlane + i));
+
+        // Log-step prefix sum within the register.
+        x = _mm_add_epi8(x, _mm_slli_si128(x, 1));
+        x = _mm_add_epi8(x, _mm_slli_si128(x, 2));
+        x = _mm_add_epi8(x, _mm_slli_si128(x, 4));
+        x = _mm_add_epi8(x, _mm_slli_si128(x, 8));
+        x = _mm_add_epi8(x, carry);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pPlane + i), x);
+
+        // Broadcast the last byte into the next block.
+        carry = _mm_srli_si128(x, 15);
+        carry = _mm_unpacklo_epi8(carry, carry);
+        carry = _mm_unpacklo_epi16(carry, carry);
+        carry = _mm_shuffle_epi32(carry, 0);
+    }
+
+    uint8_t sum = i ? pPlane[i - 1] : 0;
+
+    for (; i < numBytes; ++i)
+    {
+        sum = (uint8_t)(sum + pPlane[i]);
+        pPlane[i] = sum;
+    }
+}
+
+#elif defined(LS_DRAW_CODEC_NEON)
+
+inline void integrate_byte_plane(uint8_t* const pPlane, const size_t numBytes) noexcept
+{
+    const uint8x16_t zero = vdupq_n_u8(0);
+    uint8x16_t carry = zero;
+    size_t i = 0;
+
+    for (; i + 16 <= numBytes; i += 16)
+    {
+        uint8x16_t x = vld1q_u8(pPlane + i);
+
+        // Log-step prefix sum within the register.
+        x = vaddq_u8(x, vextq_u8(zero, x, 15));
+        x = vaddq_u8(x, vextq_u8(zero, x, 14));
+        x = vaddq_u8(x, vextq_u8(zero, x, 12));
+        x = vaddq_u8(x, vextq_u8(zero, x, 8));
+        x = vaddq_u8(x, carry);
+
+        vst1q_u8(pPlane + i, x);
+        carry = vdupq_n_u8(vgetq_lane_u8(x, 15));
+    }
+
+    uint8_t sum = i ? pPlane[i - 1] : 0;
+
+    for (; i < numBytes; ++i)
+    {
+        sum = (uint8_t)(sum + pPlane[i]);
+        pPlane[i] = sum;
+    }
+}
+
+#else
+
+inline void integrate_byte_plane(uint8_t* const pPlane, const size_t numBytes) noexcept
+{
+    uint8_t sum = 0;
+
+    for (size_t i = 0; i < numBytes; ++i)
+    {
+        sum = (uint8_t)(sum + pPlane[i]);
+        pPlane[i] = sum;
+    }
+}
+
+#endif
+
+
+
+/*-------------------------------------
+ * Transpose 16 byte planes of 16 vertices into 16 rows
+ *
+ * Four rounds of interleaving pair each register with the one 8 positions
+ * away. Planes are loaded in bit-reversed order so the rows come out in
+ * order.
+-------------------------------------*/
+#if defined(LS_DRAW_CODEC_SSE) || defined(LS_DRAW_CODEC_NEON)
+
+constexpr unsigned CODEC_TRANSPOSE_ORDER[16] = {0, 8, 4, 12, 2, 10, 6, 14, 1, 9, 5, 13, 3, 11, 7, 15};
+
+#endif
+
+#if defined(LS_DRAW_CODEC_SSE)
+
+inline void transpose_byte_planes(const uint8_t* const pPlanes, const size_t planeStride, uint8_t* const pRows, const size_t rowStride) noexcept
+{
+    __m128i a[16];
+    __m128i b[16];
+
+    for (unsigned k = 0; k < 16; ++k)
+    {
+        a[k] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pPlanes + CODEC_TRANSPOSE_ORDER[k] * planeStride));
+    }
+
+    for (unsigned k = 0; k < 8; ++k)
+    {
+        b[2*k+0] = _mm_unpacklo_epi8(a[k], a[k+8]);
+        b[2*k+1] = _mm_unpackhi_epi8(a[k], a[k+8]);
+    }
+
+    for (unsigned k = 0; k < 8; ++k)
+    {
+        a[2*k+0] = _mm_unpacklo_epi16(b[k], b[k+8]);
+        a[2*k+1] = _mm_unpackhi_epi16(b[k], b[k+8]);
+    }
+
+    for (unsigned k = 0; k < 8; ++k)
+    {
+        b[2*k+0] = _mm_unpacklo_epi32(a[k], a[k+8]);
+        b[2*k+1] = _mm_unpackhi_epi32(a[k], a[k+8]);
+    }
+
+    for (unsigned k = 0; k < 8; ++k)
+    {
+        a[2*k+0] = _mm_unpacklo_epi64(b[k], b[k+8]);
+        a[2*k+1] = _mm_unpackhi_epi64(b[k], b[k+8]);
+    }
+
+    for (unsigned v = 0; v < 16; ++v)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pRows + v * rowStride), a[v]);
+    }
+}
+
+#elif defined(LS_DRAW_CODEC_NEON)
+
+inline void transpose_byte_planes(const uint8_t* const pPlanes, const size_t planeStride, uint8_t* const pRows, const size_t rowStride) noexcept
+{
+    uint8x16_t a[16];
+    uint8x16_t b[16];
+
+    for (unsigned k = 0; k < 16; ++k)
+    {
+        a[k] = vld1q_u8(pPlanes + CODEC_TRANSPOSE_ORDER[k] * planeStride);
+    }
+
+    for (unsigned k = 0; k < 8; ++k)
+    {
+        const uint8x16x2_t z = vzipq_u8(a[k], a[k+8]);
+        b[2*k+0] = z.val[0];
+        b[2*k+1] = z.val[1];
+    }
+
+    for (unsigned k = 0; k < 8; ++k)
+    {
+        const uint16x8x2_t z = vzipq_u16(vreinterpretq_u16_u8(b[k]), vreinterpretq_u16_u8(b[k+8]));
+        a[2*k+0] = vreinterpretq_u8_u16(z.val[0]);
+        a[2*k+1] = vreinterpretq_u8_u16(z.val[1]);
+    }
+
+    for (unsigned k = 0; k < 8; ++k)
+    {
+        const uint32x4x2_t z = vzipq_u32(vreinterpretq_u32_u8(a[k]), vreinterpretq_u32_u8(a[k+8]));
+        b[2*k+0] = vreinterpretq_u8_u32(z.val[0]);
+        b[2*k+1] = vreinterpretq_u8_u32(z.val[1]);
+    }
+
+    for (unsigned k = 0; k < 8; ++k)
+    {
+        a[2*k+0] = vcombine_u8(vget_low_u8(b[k]), vget_low_u8(b[k+8]));
+        a[2*k+1] = vcombine_u8(vget_high_u8(b[k]), vget_high_u8(b[k+8]));
+    }
+
+    for (unsigned v = 0; v < 16; ++v)
+    {
+        vst1q_u8(pRows + v * rowStride, a[v]);
+    }
+}
+
+#endif
+
+
+
+/*-------------------------------------
+ * Interleave byte planes into vertices
+-------------------------------------*/
+inline void interleave_byte_planes(
+    const uint8_t* const pPlanes,
+    const size_t planeStride,
+    uint8_t* const pRows,
+    const size_t numVertices,
+    const uint32_t vertStride
+) noexcept
+{
+    size_t v = 0;
+
+    #if defined(LS_DRAW_CODEC_SSE) || defined(LS_DRAW_CODEC_NEON)
+        const uint32_t numSimdPlanes = vertStride & ~15u;
+
+        for (; v + 16 <= numVertices; v += 16)
+        {
+            for (uint32_t b = 0; b < numSimdPlanes; b += 16)
+            {
+                transpose_byte_planes(pPlanes + b * planeStride + v, planeStride, pRows + v * vertStride + b, vertStride);
+            }
+
+            for (uint32_t b = numSimdPlanes; b < vertStride; ++b)
+            {
+                const uint8_t* const pPlane = pPlanes + b * planeStride + v;
+
+                for (size_t i = 0; i < 16; ++i)
+                {
+                    pRows[(v + i) * vertStride + b] = pPlane[i];
+                }
+            }
+        }
+    #endif
+
+    for (; v < numVertices; ++v)
+    {
+        for (uint32_t b = 0; b < vertStride; ++b)
+        {
+            pRows[v * vertStride + b] = pPlanes[b * planeStride + v];
+        }
+    }
+}
+
+
+
+/*-------------------------------------
+ * Read a single index
+-------------------------------------*/
+inline uint32_t read_codec_index(const char* const pIndices, const uint32_t i, const uint32_t indexBytes) noexcept
+{
+    if (indexBytes == 1)
+    {
+        return reinterpret_cast<const uint8_t*>(pIndices)[i];
+    }
+
+    if (indexBytes == 2)
+    {
+        return reinterpret_cast<const uint16_t*>(pIndices)[i];
+    }
+
+    return reinterpret_cast<const uint32_t*>(pIndices)[i];
+}
+
+
+
+/*-------------------------------------
+ * Expand variable-length index deltas
+-------------------------------------*/
+template <typename index_t>
+bool decode_index_deltas(const uint8_t* p, const uint8_t* const pEnd, index_t* const pOut, const uint32_t numIndices) noexcept
+{
+    uint32_t prev = 0;
+
+    for (uint32_t i = 0; i < numIndices; ++i)
+    {
+        uint32_t zigzag = 0;
+
+        for (unsigned shift = 0;; shift += 7)
+        {
+            if (p >= pEnd || shift > 28)
+            {
+                return false;
+            }
+
+            const uint8_t b = *p++;
+            zigzag |= (uint32_t)(b & 0x7F) << shift;
+
+            if (!(b & 0x80))
+            {
+                break;
+            }
+        }
+
+        prev += (zigzag >> 1) ^ (0u - (zigzag & 1u));
+        pOut[i] = (index_t)prev;
+    }
+
+    return p == pEnd;
+}
+
+} // end anonymous namespace
+
+
+
+namespace ls
+{
+namespace draw
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * Vertex Encoding
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Encode interleaved vertices
+-------------------------------------*/
+void encode_mesh_vertices(
+    const char* const pVertices,
+    const uint32_t numVertices,
+    const uint32_t vertStride,
+    std::vector<char>& outEncoded
+) noexcept
+{
+    const uint8_t* const pIn = reinterpret_cast<const uint8_t*>(pVertices);
+    std::vector<uint8_t> plane(numVertices);
+
+    // Each byte of a vertex is split into its own plane so similar bytes
+    // (exponents, high bits of indices, etc.) are coded together.
+    for (uint32_t b = 0; b < vertStride; ++b)
+    {
+        uint8_t prev = 0;
+
+        for (uint32_t v = 0; v < numVertices; ++v)
+        {
+            const uint8_t curr = pIn[(size_t)v * vertStride + b];
+            plane[v] = (uint8_t)(curr - prev);
+            prev = curr;
+        }
+
+        encode_entropy_stream(plane.data(), plane.size(), outEncoded);
+    }
+}
+
+
+
+/*-------------------------------------
+ * Decode interleaved vertices
+-------------------------------------*/
+bool decode_mesh_vertices(
+    const char* const pEncoded,
+    const size_t numEncodedBytes,
+    char* const pOutVertices,
+    const uint32_t numVertices,
+    const uint32_t vertStride,
+    std::vector<char>& scratch
+) noexcept
+{
+    constexpr size_t rowBlockBytes = 4096;
+
+    const size_t rowVerts = vertStride < rowBlockBytes ? (rowBlockBytes / vertStride) : 1;
+    const size_t planeBytes = (size_t)numVertices * vertStride;
+
+    scratch.resize(planeBytes + rowVerts * vertStride);
+
+    uint8_t* const pPlanes = reinterpret_cast<uint8_t*>(scratch.data());
+    uint8_t* const pRows = pPlanes + planeBytes;
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(pEncoded);
+    const uint8_t* const pEnd = p + numEncodedBytes;
+
+    for (uint32_t b = 0; b < vertStride; ++b)
+    {
+        uint8_t* const pPlane = pPlanes + (size_t)b * numVertices;
+
+        p = decode_entropy_stream(p, pEnd, pPlane, numVertices);
+
+        if (!p)
+        {
+            return false;
+        }
+
+        integrate_byte_plane(pPlane, numVertices);
+    }
+
+    if (p != pEnd)
+    {
+        return false;
+    }
+
+    // Vertices are re-interleaved in a small, cached block then copied out
+    // in order. This avoids scattered writes into mapped GPU memory.
+    for (size_t v0 = 0; v0 < numVertices; v0 += rowVerts)
+    {
+        const size_t count = (numVertices - v0) < rowVerts ? (numVertices - v0) : rowVerts;
+        interleave_byte_planes(pPlanes + v0, numVertices, pRows, count, vertStride);
+        utils::fast_memcpy(pOutVertices + v0 * vertStride, pRows, count * vertStride);
+    }
+
+    return true;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * Index Encoding
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Encode indices
+-------------------------------------*/
+void encode_mesh_indices(
+    const char* const pIndices,
+    const uint32_t numIndices,
+    const uint32_t indexBytes,
+    std::vector<char>& outEncoded
+) noexcept
+{
+    std::vector<uint8_t> deltas;
+    deltas.reserve(numIndices + numIndices / 2);
+
+    // Optimized meshes reference nearby vertices, so each index is usually a
+    // small positive or negative step from the previous one.
+    uint32_t prev = 0;
+
+    for (uint32_t i = 0; i < numIndices; ++i)
+    {
+        const uint32_t curr = read_codec_index(pIndices, i, indexBytes);
+        const int32_t delta = (int32_t)(curr - prev);
+        uint32_t zigzag = ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31);
+
+        while (zigzag >= 0x80)
+        {
+            deltas.push_back((uint8_t)(zigzag | 0x80));
+            zigzag >>= 7;
+        }
+
+        deltas.push_back((uint8_t)zigzag);
+        prev = curr;
+    }
+
+    write_codec_u32(outEncoded, (uint32_t)deltas.size());
+    encode_entropy_stream(deltas.data(), deltas.size(), outEncoded);
+}
+
+
+
+/*-------------------------------------
+ * Decode indices
+-------------------------------------*/
+bool decode_mesh_indices(
+    const char* const pEncoded,
+    const size_t numEncodedBytes,
+    char* const pOutIndices,
+    const uint32_t numIndices,
+    const uint32_t indexBytes,
+    std::vector<char>& scratch
+) noexcept
+{
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(pEncoded);
+    const uint8_t* const pEnd = p + numEncodedBytes;
+
+    if (numEncodedBytes < 4)
+    {
+        return false;
+    }
+
+    const uint32_t numDeltaBytes = read_codec_u32(p);
+    p += 4;
+
+    // Each index requires between 1 and 5 bytes.
+    if (numDeltaBytes < numIndices || numDeltaBytes > (uint64_t)numIndices * 5u)
+    {
+        return false;
+    }
+
+    scratch.resize(numDeltaBytes);
+    uint8_t* const pDeltas = reinterpret_cast<uint8_t*>(scratch.data());
+
+    p = decode_entropy_stream(p, pEnd, pDeltas, numDeltaBytes);
+
+    if (p != pEnd)
+    {
+        return false;
+    }
+
+    switch (indexBytes)
+    {
+        case 1:
+            return decode_index_deltas<uint8_t>(pDeltas, pDeltas + numDeltaBytes, reinterpret_cast<uint8_t*>(pOutIndices), numIndices);
+
+        case 2:
+            return decode_index_deltas<uint16_t>(pDeltas, pDeltas + numDeltaBytes, reinterpret_cast<uint16_t*>(pOutIndices), numIndices);
+
+        case 4:
+            return decode_index_deltas<uint32_t>(pDeltas, pDeltas + numDeltaBytes, reinterpret_cast<uint32_t*>(pOutIndices), numIndices);
+
+        default:
+            break;
+    }
+
+    return false;
+}
+} // end draw namespace
+} // end ls namespace
@@ -0,0 +1,590 @@
+
+#include <algorithm> // std::fill(), std::stable_sort()
+#include <cstring> // memcmp()
+
+#include "lightsky/utils/Copy.h"
+
+#include "lightsky/math/Math.h"
+
+#include "lightsky/draw/MeshOptimizer.h"
+
+
+
+/*-----------------------------------------------------------------------------
+ * Anonymous helper functions
+-----------------------------------------------------------------------------*/
+namespace
+{
+
+namespace math = ls::math;
+
+
+
+/*-------------------------------------
+ * Retrieve a vertex position
+-------------------------------------*/
+inline math::vec3 get_optimizer_position(const float* const pPositions, const size_t stride, const uint32_t index) noexcept
+{
+    const float* const p = reinterpret_cast<const float*>(reinterpret_cast<const char*>(pPositions) + stride * index);
+    return math::vec3{p[0], p[1], p[2]};
+}
+
+
+
+/*-------------------------------------
+ * Vertex-to-triangle adjacency
+-------------------------------------*/
+struct TriangleAdjacency
+{
+    // Number of triangles which reference each vertex.
+    std::vector<uint32_t> counts;
+
+    // Offset of each vertex's first triangle within "triangles."
+    std::vector<uint32_t> offsets;
+
+    // Triangle indices, grouped by vertex.
+    std::vector<uint32_t> triangles;
+
+    TriangleAdjacency(const uint32_t* const pIndices, const size_t numIndices, const uint32_t numVertices) noexcept :
+        counts(numVertices, 0),
+        offsets(numVertices, 0),
+        triangles(numIndices, 0)
+    {
+        for (size_t i = 0; i < numIndices; ++i)
+        {
+            ++counts[pIndices[i]];
+        }
+
+        uint32_t offset = 0;
+        for (uint32_t v = 0; v < numVertices; ++v)
+        {
+            offsets[v] = offset;
+            offset += counts[v];
+        }
+
+        // "counts" is rebuilt while filling each vertex's triangle list.
+        std::fill(counts.begin(), counts.end(), 0);
+
+        for (size_t i = 0; i < numIndices; ++i)
+        {
+            const uint32_t v = pIndices[i];
+            triangles[offsets[v] + counts[v]++] = (uint32_t)(i / 3);
+        }
+    }
+};
+
+
+
+} // end anonymous namespace
+
+
+
+namespace ls
+{
+namespace draw
+{
+
+
+
+/*-------------------------------------
+ * Simulate a FIFO vertex cache
+-------------------------------------*/
+size_t calc_vertex_cache_misses(
+    const uint32_t* const pIndices,
+    const size_t numIndices,
+    const uint32_t numVertices,
+    const unsigned cacheSize
+) noexcept
+{
+    // A vertex is cached if it was added within the last "cacheSize" misses.
+    std::vector<size_t> timestamps(numVertices, 0);
+    size_t numMisses = 0;
+
+    for (size_t i = 0; i < numIndices; ++i)
+    {
+        const uint32_t v = pIndices[i];
+
+        if (!timestamps[v] || numMisses - timestamps[v] + 1 > cacheSize)
+        {
+            ++numMisses;
+            timestamps[v] = numMisses;
+        }
+    }
+
+    return numMisses;
+}
+
+
+
+/*-------------------------------------
+ * Tipsify
+-------------------------------------*/
+void optimize_vertex_cache(
+    uint32_t* const pIndices,
+    const size_t numIndices,
+    const uint32_t numVertices,
+    std::vector<uint32_t>& outClusters,
+    const unsigned cacheSize
+) noexcept
+{
+    const size_t numTriangles = numIndices / 3;
+
+    outClusters.clear();
+
+    if (!numTriangles || !numVertices)
+    {
+        return;
+    }
+
+    const TriangleAdjacency adjacency{pIndices, numIndices, numVertices};
+    std::vector<uint32_t> liveCounts = adjacency.counts;
+    std::vector<size_t> timestamps(numVertices, 0);
+    std::vector<char> emitted(numTriangles, 0);
+    std::vector<uint32_t> deadEnds;
+    std::vector<uint32_t> candidates;
+    std::vector<uint32_t> outIndices;
+
+    deadEnds.reserve(numIndices);
+    candidates.reserve(64);
+    outIndices.reserve(numIndices);
+
+    size_t time = cacheSize + 1;
+    uint32_t cursor = 0;
+    int64_t fanVertex = 0;
+    bool newCluster = true;
+
+    while (fanVertex >= 0)
+    {
+        const uint32_t f = (uint32_t)fanVertex;
+        const uint32_t* const pTriangles = adjacency.triangles.data() + adjacency.offsets[f];
+
+        candidates.clear();
+
+        for (uint32_t t = 0; t < adjacency.counts[f]; ++t)
+        {
+            const uint32_t tri = pTriangles[t];
+
+            if (emitted[tri])
+            {
+                continue;
+            }
+
+            if (newCluster)
+            {
+                outClusters.push_back((uint32_t)(outIndices.size() / 3));
+                newCluster = false;
+            }
+
+            for (unsigned k = 0; k < 3; ++k)
+            {
+                const uint32_t v = pIndices[tri * 3 + k];
+
+                outIndices.push_back(v);
+                deadEnds.push_back(v);
+                candidates.push_back(v);
+                --liveCounts[v];
+
+                if (time - timestamps[v] > cacheSize)
+                {
+                    timestamps[v] = time++;
+                }
+            }
+
+            emitted[tri] = 1;
+        }
+
+        // Pick the candidate which will remain in the cache the longest
+        // after its remaining triangles are emitted.
+        fanVertex = -1;
+        size_t bestPriority = 0;
+
+        for (const uint32_t v : candidates)
+        {
+            if (!liveCounts[v])
+            {
+                continue;
+            }
+
+            size_t priority = 0;
+
+            if (time - timestamps[v] + 2 * liveCounts[v] <= cacheSize)
+            {
+                priority = time - timestamps[v];
+            }
+
+            if (fanVertex < 0 || priority > bestPriority)
+            {
+                bestPriority = priority;
+                fanVertex = v;
+            }
+        }
+
+        if (fanVertex >= 0)
+        {
+            continue;
+        }
+
+        // Dead end. Resume from a recently used vertex if possible, otherwise
+        // start a new cluster from the next unprocessed vertex.
+        while (!deadEnds.empty())
+        {
+            const uint32_t v = deadEnds.back();
+            deadEnds.pop_back();
+
+            if (liveCounts[v])
+            {
+                fanVertex = v;
+                break;
+            }
+        }
+
+        if (fanVertex >= 0)
+        {
+            continue;
+        }
+
+        while (cursor < numVertices)
+        {
+            if (liveCounts[cursor])
+            {
+                fanVertex = cursor++;
+                newCluster = true;
+                break;
+            }
+
+            ++cursor;
+        }
+    }
+
+    utils::fast_memcpy(pIndices, outIndices.data(), sizeof(uint32_t) * outIndices.size());
+}
+
+
+
+/*-------------------------------------
+ * Sort triangle clusters to reduce overdraw
+-------------------------------------*/
+void optimize_overdraw(
+    uint32_t* const pIndices,
+    const size_t numIndices,
+    const float* const pPositions,
+    const size_t positionStride,
+    const uint32_t numVertices,
+    const std::vector<uint32_t>& hardClusters,
+    const float threshold,
+    const unsigned cacheSize
+) noexcept
+{
+    const size_t numTriangles = numIndices / 3;
+
+    if (!numTriangles || hardClusters.empty())
+    {
+        return;
+    }
+
+    // Split each hard cluster wherever the cache has been used efficiently
+    // enough that restarting with an empty cache costs little.
+    const float targetAcmr = threshold * (float)calc_vertex_cache_misses(pIndices, numIndices, numVertices, cacheSize) / (float)numTriangles;
+    std::vector<size_t> timestamps(numVertices, 0);
+    std::vector<uint32_t> clusters;
+    size_t numMisses = 0;
+
+    clusters.reserve(hardClusters.size());
+
+    for (size_t h = 0; h < hardClusters.size(); ++h)
+    {
+        const size_t first = hardClusters[h];
+        const size_t last = (h + 1 < hardClusters.size()) ? hardClusters[h + 1] : numTriangles;
+        size_t clusterStart = numMisses;
+        size_t clusterMisses = 0;
+        size_t clusterTris = 0;
+
+        clusters.push_back((uint32_t)first);
+
+        for (size_t t = first; t < last; ++t)
+        {
+            for (unsigned k = 0; k < 3; ++k)
+            {
+                const uint32_t v = pIndices[t * 3 + k];
+
+                if (timestamps[v] <= clusterStart || numMisses - timestamps[v] + 1 > cacheSize)
+                {
+                    ++numMisses;
+                    ++clusterMisses;
+                    timestamps[v] = numMisses;
+                }
+            }
+
+            ++clusterTris;
+
+            if (t + 1 < last && (float)clusterMisses <= targetAcmr * (float)clusterTris)
+            {
+                clusters.push_back((uint32_t)(t + 1));
+                clusterStart = numMisses;
+                clusterMisses = 0;
+                clusterTris = 0;
+            }
+        }
+    }
+
+    const size_t numClusters = clusters.size();
+
+    if (numClusters < 2)
+    {
+        return;
+    }
+
+    std::vector<math::vec3> centroids(numClusters, math::vec3{0.f, 0.f, 0.f});
+    std::vector<math::vec3> normals(numClusters, math::vec3{0.f, 0.f, 0.f});
+    std::vector<float> areas(numClusters, 0.f);
+    math::vec3 meshCentroid{0.f};
+    float meshArea = 0.f;
+
+    // Area-weighted centroid and normal of each cluster
+    for (size_t c = 0; c < numClusters; ++c)
+    {
+        const size_t first = clusters[c];
+        const size_t last = (c + 1 < numClusters) ? clusters[c + 1] : numTriangles;
+
+        for (size_t t = first; t < last; ++t)
+        {
+            const math::vec3&& p0 = get_optimizer_position(pPositions, positionStride, pIndices[t * 3 + 0]);
+            const math::vec3&& p1 = get_optimizer_position(pPositions, positionStride, pIndices[t * 3 + 1]);
+            const math::vec3&& p2 = get_optimizer_position(pPositions, positionStride, pIndices[t * 3 + 2]);
+            const math::vec3&& n = math::cross(p1 - p0, p2 - p0);
+            const float area = math::length(n);
+
+            centroids[c] += (p0 + p1 + p2) * (area / 3.f);
+            normals[c] += n;
+            areas[c] += area;
+        }
+
+        meshCentroid += centroids[c];
+        meshArea += areas[c];
+    }
+
+    meshCentroid = meshArea > 0.f ? (meshCentroid / meshArea) : meshCentroid;
+
+    // Clusters facing away from the mesh's center are more likely to occlude
+    // the rest of the mesh, so they are drawn first.
+    std::vector<float> sortKeys(numClusters, 0.f);
+    std::vector<uint32_t> order(numClusters, 0);
+
+    for (size_t c = 0; c < numClusters; ++c)
+    {
+        const float normalLength = math::length(normals[c]);
+        order[c] = (uint32_t)c;
+
+        if (areas[c] > 0.f && normalLength > 0.f)
+        {
+            const math::vec3&& centroid = centroids[c] / areas[c];
+            sortKeys[c] = math::dot(centroid - meshCentroid, normals[c] / normalLength);
+        }
+    }
+
+    std::stable_sort(order.begin(), order.end(), [&](const uint32_t a, const uint32_t b) -> bool
+    {
+        return sortKeys[a] > sortKeys[b];
+    });
+
+    std::vector<uint32_t> outIndices;
+    outIndices.reserve(numIndices);
+
+    for (const uint32_t c : order)
+    {
+        const size_t first = clusters[c];
+        const size_t last = (c + 1 < numClusters) ? clusters[c + 1] : numTriangles;
+
+        outIndices.insert(outIndices.end(), pIndices + first * 3, pIndices + last * 3);
+    }
+
+    utils::fast_memcpy(pIndices, outIndices.data(), sizeof(uint32_t) * outIndices.size());
+}
+
+
+
+/*-------------------------------------
+ * Reorder vertices for fetch locality
+-------------------------------------*/
+void optimize_vertex_fetch(
+    uint32_t* const pIndices,
+    const size_t numIndices,
+    const uint32_t numVertices,
+    std::vector<uint32_t>& outRemap
+) noexcept
+{
+    constexpr uint32_t unmapped = (uint32_t)-1;
+
+    outRemap.assign(numVertices, unmapped);
+    uint32_t nextVertex = 0;
+
+    for (size_t i = 0; i < numIndices; ++i)
+    {
+        uint32_t& v = outRemap[pIndices[i]];
+
+        if (v == unmapped)
+        {
+            v = nextVertex++;
+        }
+
+        pIndices[i] = v;
+    }
+
+    for (uint32_t& v : outRemap)
+    {
+        if (v == unmapped)
+        {
+            v = nextVertex++;
+        }
+    }
+}
+
+
+
+/*-------------------------------------
+ * Reorder interleaved vertices
+-------------------------------------*/
+void remap_vertices(
+    const char* const pInVertices,
+    char* const pOutVertices,
+    const unsigned vertStride,
+    const std::vector<uint32_t>& remap
+) noexcept
+{
+    const size_t numVertices = remap.size();
+
+    for (size_t i = 0; i < numVertices; ++i)
+    {
+        utils::fast_memcpy(pOutVertices + (size_t)remap[i] * vertStride, pInVertices + i * vertStride, vertStride);
+    }
+}
+
+
+
+/*-------------------------------------
+ * Merge identical vertices
+-------------------------------------*/
+uint32_t weld_vertices(
+    const char* const pVertices,
+    const unsigned vertStride,
+    const uint32_t numVertices,
+    std::vector<uint32_t>& outRemap
+) noexcept
+{
+    constexpr uint32_t emptySlot = 0xFFFFFFFF;
+
+    outRemap.assign(numVertices, 0);
+
+    // Open-addressed table of the first occurrence of each unique vertex,
+    // kept at most half full to keep probe sequences short.
+    size_t tableSize = 1;
+    while (tableSize < (size_t)numVertices * 2)
+    {
+        tableSize <<= 1;
+    }
+
+    const size_t tableMask = tableSize - 1;
+    std::vector<uint32_t> table(tableSize, emptySlot);
+    uint32_t numUnique = 0;
+
+    for (uint32_t v = 0; v < numVertices; ++v)
+    {
+        const char* const pVert = pVertices + (size_t)v * vertStride;
+        size_t slot = (size_t)hash_mesh_data(pVert, vertStride) & tableMask;
+
+        while (true)
+        {
+            const uint32_t first = table[slot];
+
+            if (first == emptySlot)
+            {
+                table[slot] = v;
+                outRemap[v] = numUnique++;
+                break;
+            }
+
+            if (memcmp(pVertices + (size_t)first * vertStride, pVert, vertStride) == 0)
+            {
+                outRemap[v] = outRemap[first];
+                break;
+            }
+
+            slot = (slot + 1) & tableMask;
+        }
+    }
+
+    return numUnique;
+}
+
+
+
+/*-------------------------------------
+ * Hash mesh data
+-------------------------------------*/
+uint64_t hash_mesh_data(
+    const void* const pData,
+    const size_t numBytes,
+    const uint64_t seed
+) noexcept
+{
+    const unsigned char* const pBytes = reinterpret_cast<const unsigned char*>(pData);
+    uint64_t hash = seed;
+
+    for (size_t i = 0; i < numBytes; ++i)
+    {
+        hash ^= (uint64_t)pBytes[i];
+        hash *= 0x100000001B3ull;
+    }
+
+    return hash;
+}
+
+
+
+/*-------------------------------------
+ * Run all optimization stages
+-------------------------------------*/
+MeshOptimizerStats optimize_mesh(
+    uint32_t* const pIndices,
+    const size_t numIndices,
+    const float* const pPositions,
+    const size_t positionStride,
+    const uint32_t numVertices,
+    std::vector<uint32_t>& outRemap,
+    const bool remapVertices
+) noexcept
+{
+    MeshOptimizerStats stats;
+    stats.numVertices = numVertices;
+    stats.numTriangles = (uint32_t)(numIndices / 3);
+
+    const float triCount = stats.numTriangles ? (float)stats.numTriangles : 1.f;
+    const float vertCount = numVertices ? (float)numVertices : 1.f;
+    const size_t missesBefore = calc_vertex_cache_misses(pIndices, numIndices, numVertices);
+
+    stats.acmrBefore = (float)missesBefore / triCount;
+    stats.atvrBefore = (float)missesBefore / vertCount;
+
+    std::vector<uint32_t> clusters;
+    optimize_vertex_cache(pIndices, numIndices, numVertices, clusters);
+    optimize_overdraw(pIndices, numIndices, pPositions, positionStride, numVertices, clusters);
+
+    outRemap.clear();
+
+    if (remapVertices)
+    {
+        optimize_vertex_fetch(pIndices, numIndices, numVertices, outRemap);
+    }
+
+    const size_t missesAfter = calc_vertex_cache_misses(pIndices, numIndices, numVertices);
+
+    stats.acmrAfter = (float)missesAfter / triCount;
+    stats.atvrAfter = (float)missesAfter / vertCount;
+
+    return stats;
+}
+
+
+
+} // end draw namespace
+} // end ls namespace
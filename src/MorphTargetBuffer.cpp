@@ -0,0 +1,348 @@
+
+#include <cstdint>
+#include <utility> // std::move
+
+#include "lightsky/utils/Assertions.h"
+#include "lightsky/utils/Log.h"
+
+#include "lightsky/draw/GLQuery.h"
+#include "lightsky/draw/MorphTargetBuffer.h"
+#include "lightsky/draw/SceneGraph.h"
+#include "lightsky/draw/SceneMorph.h"
+#include "lightsky/draw/TextureAssembly.h"
+
+
+
+/*-----------------------------------------------------------------------------
+ * Anonymous helper functions
+-----------------------------------------------------------------------------*/
+namespace
+{
+
+namespace draw = ls::draw;
+
+/*-------------------------------------
+ * CPU-side layout of a std140 morph target uniform block
+-------------------------------------*/
+struct MorphUniformBlock
+{
+    int32_t info[4]; // baseVertex, firstHeader, numVerts, numActive
+    float weights[draw::morph_property_t::MORPH_MAX_TARGETS];
+};
+
+
+
+/*-------------------------------------
+ * Write a single texel to the delta texture
+-------------------------------------*/
+inline float* write_morph_texel(float* const pTexel, const float x, const float y, const float z, const float w) noexcept
+{
+    pTexel[0] = x;
+    pTexel[1] = y;
+    pTexel[2] = z;
+    pTexel[3] = w;
+    return pTexel + 4;
+}
+} // end anonymous namespace
+
+
+
+namespace ls
+{
+namespace draw
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * MorphTargetBuffer Class
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Destructor
+-------------------------------------*/
+MorphTargetBuffer::~MorphTargetBuffer() noexcept
+{
+    terminate();
+}
+
+
+
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+MorphTargetBuffer::MorphTargetBuffer() noexcept :
+    blockStride{0},
+    headerOffsets{},
+    uniformData{},
+    deltaTex{},
+    ubo{}
+{
+}
+
+
+
+/*-------------------------------------
+ * Copy Constructor
+-------------------------------------*/
+MorphTargetBuffer::MorphTargetBuffer(const MorphTargetBuffer& m) noexcept :
+    blockStride{m.blockStride},
+    headerOffsets{m.headerOffsets},
+    uniformData{m.uniformData},
+    deltaTex{},
+    ubo{}
+{
+}
+
+
+
+/*-------------------------------------
+ * Move Constructor
+-------------------------------------*/
+MorphTargetBuffer::MorphTargetBuffer(MorphTargetBuffer&& m) noexcept :
+    blockStride{m.blockStride},
+    headerOffsets{std::move(m.headerOffsets)},
+    uniformData{std::move(m.uniformData)},
+    deltaTex{std::move(m.deltaTex)},
+    ubo{std::move(m.ubo)}
+{
+    m.blockStride = 0;
+}
+
+
+
+/*-------------------------------------
+ * Copy Operator
+-------------------------------------*/
+MorphTargetBuffer& MorphTargetBuffer::operator=(const MorphTargetBuffer& m) noexcept
+{
+    blockStride = m.blockStride;
+    headerOffsets = m.headerOffsets;
+    uniformData = m.uniformData;
+
+    return *this;
+}
+
+
+
+/*-------------------------------------
+ * Move Operator
+-------------------------------------*/
+MorphTargetBuffer& MorphTargetBuffer::operator=(MorphTargetBuffer&& m) noexcept
+{
+    terminate();
+
+    blockStride = m.blockStride;
+    m.blockStride = 0;
+
+    headerOffsets = std::move(m.headerOffsets);
+    uniformData = std::move(m.uniformData);
+    deltaTex = std::move(m.deltaTex);
+    ubo = std::move(m.ubo);
+
+    return *this;
+}
+
+
+
+/*-------------------------------------
+ * Upload all morph targets
+-------------------------------------*/
+bool MorphTargetBuffer::init(const SceneGraph& graph) noexcept
+{
+    terminate();
+
+    const std::vector<SceneMorph>& morphs = graph.morphs;
+    LS_DEBUG_ASSERT(morphs.size() == graph.meshes.size());
+
+    if (morphs.empty())
+    {
+        return true;
+    }
+
+    // Determine where each mesh's headers and deltas will be placed.
+    size_t totalTexels = 0;
+    headerOffsets.reserve(morphs.size());
+
+    for (const SceneMorph& morph : morphs)
+    {
+        headerOffsets.push_back((unsigned)totalTexels);
+
+        if (morph.get_num_targets())
+        {
+            totalTexels += morph.numVerts + morph.deltas.size() * morph_property_t::MORPH_TEXELS_PER_DELTA;
+        }
+    }
+
+    // Every mesh gets a uniform block, even if it isn't morphed, so shaders
+    // can be shared between morphed and static meshes.
+    const size_t alignBytes = math::max<GLint>(get_gl_int(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT), 1);
+    blockStride = ((sizeof(MorphUniformBlock) + alignBytes - 1) / alignBytes) * alignBytes;
+    uniformData.resize(blockStride * morphs.size(), 0);
+
+    if (!ubo.init())
+    {
+        LS_LOG_ERR("Unable to initialize a uniform buffer for ", morphs.size(), " morph target blocks.");
+        terminate();
+        return false;
+    }
+
+    ubo.bind();
+    ubo.set_data(uniformData.size(), uniformData.data(), buffer_access_t::VBO_STREAM_DRAW);
+    ubo.unbind();
+
+    if (!totalTexels)
+    {
+        LS_LOG_MSG("No morphed meshes available to generate morph target deltas.");
+        return true;
+    }
+
+    // Texel indices are sent to the GPU as floats.
+    LS_DEBUG_ASSERT(totalTexels < (1u << 24u));
+
+    const int texWidth = (int)morph_property_t::MORPH_TEXTURE_WIDTH;
+    const int texHeight = (int)((totalTexels + texWidth - 1) / texWidth);
+
+    if (texHeight > get_max_texture_size())
+    {
+        LS_LOG_ERR("Unable to fit ", totalTexels, " morph target texels into a single texture.");
+        terminate();
+        return false;
+    }
+
+    std::vector<float> texels;
+    texels.resize((size_t)texWidth * (size_t)texHeight * 4, 0.f);
+
+    for (size_t i = 0; i < morphs.size(); ++i)
+    {
+        const SceneMorph& morph = morphs[i];
+
+        if (!morph.get_num_targets())
+        {
+            continue;
+        }
+
+        LS_DEBUG_ASSERT(morph.vertOffsets.size() == morph.numVerts + 1);
+
+        const unsigned firstDelta = headerOffsets[i] + morph.numVerts;
+        float* pHeader = texels.data() + headerOffsets[i] * 4;
+        float* pDelta = texels.data() + firstDelta * 4;
+
+        for (unsigned v = 0; v < morph.numVerts; ++v)
+        {
+            const unsigned deltaStart = morph.vertOffsets[v];
+            const unsigned deltaCount = morph.vertOffsets[v + 1] - deltaStart;
+            const unsigned texelStart = firstDelta + deltaStart * morph_property_t::MORPH_TEXELS_PER_DELTA;
+
+            pHeader = write_morph_texel(pHeader, (float)texelStart, (float)deltaCount, 0.f, 0.f);
+        }
+
+        for (const SceneMorphDelta& delta : morph.deltas)
+        {
+            const math::vec3& p = delta.position;
+            const math::vec3& n = delta.normal;
+
+            pDelta = write_morph_texel(pDelta, p[0], p[1], p[2], (float)delta.targetId);
+            pDelta = write_morph_texel(pDelta, n[0], n[1], n[2], 0.f);
+        }
+    }
+
+    TextureAssembly assembly;
+    assembly.set_format_attrib(pixel_format_t::COLOR_FMT_RGBA_32F);
+
+    // Deltas are fetched per-texel, filtering would blend unrelated vertices.
+    assembly.set_int_attrib(TEX_PARAM_MAG_FILTER, tex_filter_t::TEX_FILTER_NEAREST);
+    assembly.set_int_attrib(TEX_PARAM_MIN_FILTER, tex_filter_t::TEX_FILTER_NEAREST);
+    assembly.set_int_attrib(TEX_PARAM_WRAP_S, tex_wrap_t::TEX_WRAP_CLAMP);
+    assembly.set_int_attrib(TEX_PARAM_WRAP_T, tex_wrap_t::TEX_WRAP_CLAMP);
+    assembly.set_size_attrib(math::vec2i{texWidth, texHeight}, tex_type_t::TEX_TYPE_2D, tex_2d_type_t::TEX_SUBTYPE_2D);
+
+    if (!assembly.assemble(deltaTex, texels.data()))
+    {
+        LS_LOG_ERR("Unable to upload ", totalTexels, " morph target texels to the GPU.");
+        terminate();
+        return false;
+    }
+
+    update(graph);
+
+    LS_LOG_GL_ERR();
+
+    return true;
+}
+
+
+
+/*-------------------------------------
+ * Release all resources
+-------------------------------------*/
+void MorphTargetBuffer::terminate() noexcept
+{
+    blockStride = 0;
+    headerOffsets.clear();
+    uniformData.clear();
+    deltaTex.terminate();
+    ubo.terminate();
+}
+
+
+
+/*-------------------------------------
+ * Update all target weights
+-------------------------------------*/
+void MorphTargetBuffer::update(const SceneGraph& graph) noexcept
+{
+    const std::vector<SceneMorph>& morphs = graph.morphs;
+    LS_DEBUG_ASSERT(morphs.size() == headerOffsets.size());
+
+    char* const pBlocks = uniformData.data();
+
+    for (size_t i = morphs.size(); i--;)
+    {
+        const SceneMorph& morph = morphs[i];
+        MorphUniformBlock* const pBlock = reinterpret_cast<MorphUniformBlock*>(pBlocks + blockStride * i);
+        const size_t numTargets = morph.get_num_targets();
+        int32_t numActive = 0;
+
+        LS_DEBUG_ASSERT(numTargets <= morph_property_t::MORPH_MAX_TARGETS);
+
+        for (size_t t = 0; t < numTargets; ++t)
+        {
+            const float w = morph.weights[t];
+            pBlock->weights[t] = w;
+            numActive += (w != 0.f);
+        }
+
+        pBlock->info[0] = (int32_t)morph.baseVertex;
+        pBlock->info[1] = (int32_t)headerOffsets[i];
+        pBlock->info[2] = (int32_t)morph.numVerts;
+        pBlock->info[3] = numActive;
+    }
+
+    if (ubo.is_valid())
+    {
+        // Orphan the previous buffer rather than waiting on the GPU to finish
+        // reading from it.
+        ubo.bind();
+        ubo.set_data(uniformData.size(), pBlocks, buffer_access_t::VBO_STREAM_DRAW);
+        ubo.unbind();
+    }
+}
+
+
+
+/*-------------------------------------
+ * Bind a single mesh's uniform block
+-------------------------------------*/
+void MorphTargetBuffer::bind_mesh(const size_t meshId, const unsigned bindingIndex) const noexcept
+{
+    LS_DEBUG_ASSERT(meshId < headerOffsets.size());
+    LS_DEBUG_ASSERT(ubo.is_valid());
+
+    ubo.bind_range(
+        bindingIndex,
+        (ptrdiff_t)(blockStride * meshId),
+        (ptrdiff_t)sizeof(MorphUniformBlock)
+    );
+}
+} // end draw namespace
+} // end ls namespace
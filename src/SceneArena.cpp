@@ -0,0 +1,218 @@
+
+#include <utility> // std::move
+
+#include "lightsky/utils/Assertions.h"
+#include "lightsky/utils/Log.h"
+
+#include "lightsky/draw/SceneArena.h"
+
+
+
+namespace ls
+{
+namespace draw
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * SceneArena Class
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Destructor
+-------------------------------------*/
+SceneArena::~SceneArena() noexcept
+{
+}
+
+
+
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+SceneArena::SceneArena(const size_t blockSize) noexcept :
+    minBlockSize{blockSize ? blockSize : (size_t)DEFAULT_BLOCK_SIZE},
+    currentBlock{0},
+    blocks{}
+{
+}
+
+
+
+/*-------------------------------------
+ * Move Constructor
+-------------------------------------*/
+SceneArena::SceneArena(SceneArena&& a) noexcept :
+    minBlockSize{a.minBlockSize},
+    currentBlock{a.currentBlock},
+    blocks{std::move(a.blocks)}
+{
+    a.currentBlock = 0;
+    a.blocks.clear();
+}
+
+
+
+/*-------------------------------------
+ * Move Operator
+-------------------------------------*/
+SceneArena& SceneArena::operator=(SceneArena&& a) noexcept
+{
+    if (this != &a)
+    {
+        minBlockSize = a.minBlockSize;
+
+        currentBlock = a.currentBlock;
+        a.currentBlock = 0;
+
+        blocks = std::move(a.blocks);
+        a.blocks.clear();
+    }
+
+    return *this;
+}
+
+
+
+/*-------------------------------------
+ * Add a block
+-------------------------------------*/
+bool SceneArena::add_block(const size_t numBytes) noexcept
+{
+    // Blocks grow geometrically to keep the number of heap allocations
+    // logarithmic in the total amount of memory requested.
+    size_t blockSize = blocks.empty() ? minBlockSize : (blocks.back().capacity * 2);
+
+    if (blockSize < numBytes)
+    {
+        blockSize = numBytes;
+    }
+
+    utils::Pointer<char[]> pData{new(std::nothrow) char[blockSize]};
+
+    if (!pData)
+    {
+        return false;
+    }
+
+    blocks.emplace_back(ArenaBlock{std::move(pData), blockSize, 0});
+
+    return true;
+}
+
+
+
+/*-------------------------------------
+ * Allocate memory
+-------------------------------------*/
+void* SceneArena::allocate(const size_t numBytes, const size_t alignment) noexcept
+{
+    LS_DEBUG_ASSERT(alignment && !(alignment & (alignment - 1)));
+    LS_DEBUG_ASSERT(alignment <= alignof(std::max_align_t));
+
+    const size_t alignMask = alignment - 1;
+
+    // Later blocks may have been kept from before a reset.
+    for (; currentBlock < blocks.size(); ++currentBlock)
+    {
+        ArenaBlock& block = blocks[currentBlock];
+        const size_t offset = (block.numBytesUsed + alignMask) & ~alignMask;
+
+        if (offset <= block.capacity && numBytes <= block.capacity - offset)
+        {
+            block.numBytesUsed = offset + numBytes;
+            return block.pData.get() + offset;
+        }
+    }
+
+    // Blocks are aligned to std::max_align_t, no padding is needed at the
+    // start of a new block.
+    if (!add_block(numBytes))
+    {
+        currentBlock = blocks.empty() ? 0 : (blocks.size() - 1);
+        return nullptr;
+    }
+
+    currentBlock = blocks.size() - 1;
+
+    ArenaBlock& block = blocks.back();
+    block.numBytesUsed = numBytes;
+
+    return block.pData.get();
+}
+
+
+
+/*-------------------------------------
+ * Rewind all blocks
+-------------------------------------*/
+void SceneArena::reset() noexcept
+{
+    if (blocks.size() > 1)
+    {
+        const size_t totalBytes = get_capacity();
+
+        blocks.clear();
+
+        if (!add_block(totalBytes))
+        {
+            LS_LOG_ERR("Unable to merge ", totalBytes, " bytes of scratch memory into a single block.");
+        }
+    }
+    else if (!blocks.empty())
+    {
+        blocks.front().numBytesUsed = 0;
+    }
+
+    currentBlock = 0;
+}
+
+
+
+/*-------------------------------------
+ * Free all blocks
+-------------------------------------*/
+void SceneArena::clear() noexcept
+{
+    blocks.clear();
+    currentBlock = 0;
+}
+
+
+
+/*-------------------------------------
+ * Get the total capacity
+-------------------------------------*/
+size_t SceneArena::get_capacity() const noexcept
+{
+    size_t totalBytes = 0;
+
+    for (const ArenaBlock& block : blocks)
+    {
+        totalBytes += block.capacity;
+    }
+
+    return totalBytes;
+}
+
+
+
+/*-------------------------------------
+ * Get the number of bytes in use
+-------------------------------------*/
+size_t SceneArena::get_num_bytes_used() const noexcept
+{
+    size_t totalBytes = 0;
+
+    for (const ArenaBlock& block : blocks)
+    {
+        totalBytes += block.numBytesUsed;
+    }
+
+    return totalBytes;
+}
+
+
+
+} // end draw namespace
+} // end ls namespace
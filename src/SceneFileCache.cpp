@@ -0,0 +1,727 @@
+
+#include <atomic>
+#include <cstdio> // std::rename, std::remove
+#include <functional> // std::hash
+#include <thread> // std::this_thread::get_id()
+#include <utility> // std::move
+
+#include "lightsky/setup/OS.h"
+
+#if defined(LS_OS_WINDOWS)
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+    #include <sys/types.h>
+    #include <sys/stat.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include "lightsky/utils/Log.h"
+
+#include "lightsky/draw/SceneFileCache.h"
+
+
+
+/*-----------------------------------------------------------------------------
+ * Anonymous helper functions
+-----------------------------------------------------------------------------*/
+namespace
+{
+
+/*-------------------------------------
+ * Invalid file handle
+-------------------------------------*/
+#if defined(LS_OS_WINDOWS)
+    const intptr_t SCENE_CACHE_INVALID_HANDLE = (intptr_t)INVALID_HANDLE_VALUE;
+#else
+    constexpr intptr_t SCENE_CACHE_INVALID_HANDLE = -1;
+#endif
+
+
+
+/*-------------------------------------
+ * Generate a temporary path to write a cache into
+-------------------------------------*/
+std::string get_temp_cache_path(const std::string& path) noexcept
+{
+    // Concurrent writers of the same cache must not share a temporary file.
+    static std::atomic<uint64_t> nextTempId{0};
+
+    const size_t threadId = std::hash<std::thread::id>{}(std::this_thread::get_id());
+    return path + '.' + std::to_string(threadId) + '-' + std::to_string(nextTempId.fetch_add(1)) + ".tmp";
+}
+
+
+
+/*-------------------------------------
+ * Replace a file with another
+-------------------------------------*/
+bool replace_cache_file(const std::string& srcPath, const std::string& dstPath) noexcept
+{
+    // Readers which still map the previous cache keep its contents.
+    // Windows will refuse to replace a file which is mapped elsewhere.
+    #if defined(LS_OS_WINDOWS)
+        return 0 != MoveFileExA(srcPath.c_str(), dstPath.c_str(), MOVEFILE_REPLACE_EXISTING);
+    #else
+        return 0 == std::rename(srcPath.c_str(), dstPath.c_str());
+    #endif
+}
+
+} // end anonymous namespace
+
+
+
+namespace ls
+{
+namespace draw
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * Cache Utilities
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Retrieve a cache path
+-------------------------------------*/
+std::string get_scene_cache_path(
+    const std::string& sourcePath,
+    const common_vertex_t packedVertTypes,
+    const bool baseVertexDraws
+) noexcept
+{
+    // Caches using the default settings keep their original name.
+    std::string cachePath = sourcePath;
+
+    if (packedVertTypes)
+    {
+        cachePath += ".p" + std::to_string((unsigned)packedVertTypes);
+    }
+
+    if (baseVertexDraws)
+    {
+        cachePath += ".bv";
+    }
+
+    return cachePath + SCENE_CACHE_FILE_EXTENSION;
+}
+
+
+
+/*-------------------------------------
+ * Retrieve file statistics
+-------------------------------------*/
+bool get_scene_file_stats(const std::string& path, uint64_t& outBytes, int64_t& outTime) noexcept
+{
+    // Modification times are retrieved at the highest available resolution
+    // so a source file which is modified within the same second as its
+    // cache was written is still detected.
+    #if defined(LS_OS_WINDOWS)
+        WIN32_FILE_ATTRIBUTE_DATA fileStats;
+        if (!GetFileAttributesExA(path.c_str(), GetFileExInfoStandard, &fileStats))
+        {
+            return false;
+        }
+
+        outBytes = ((uint64_t)fileStats.nFileSizeHigh << 32) | (uint64_t)fileStats.nFileSizeLow;
+
+        // 100-nanosecond intervals
+        outTime = (int64_t)(((uint64_t)fileStats.ftLastWriteTime.dwHighDateTime << 32) | (uint64_t)fileStats.ftLastWriteTime.dwLowDateTime);
+    #else
+        struct stat fileStats;
+        if (stat(path.c_str(), &fileStats) != 0)
+        {
+            return false;
+        }
+
+        outBytes = (uint64_t)fileStats.st_size;
+
+        // nanoseconds
+        #if defined(LS_OS_OSX) || defined(LS_OS_IOS) || defined(LS_OS_IOS_SIM)
+            outTime = (int64_t)fileStats.st_mtimespec.tv_sec * INT64_C(1000000000) + (int64_t)fileStats.st_mtimespec.tv_nsec;
+        #else
+            outTime = (int64_t)fileStats.st_mtim.tv_sec * INT64_C(1000000000) + (int64_t)fileStats.st_mtim.tv_nsec;
+        #endif
+    #endif
+
+    return true;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * SceneFileCache Class
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Destructor
+-------------------------------------*/
+SceneFileCache::~SceneFileCache() noexcept
+{
+    close();
+}
+
+
+
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+SceneFileCache::SceneFileCache() noexcept :
+    pData{nullptr},
+    numBytes{0},
+    fileHandle{SCENE_CACHE_INVALID_HANDLE},
+    mapHandle{SCENE_CACHE_INVALID_HANDLE}
+{
+}
+
+
+
+/*-------------------------------------
+ * Move Constructor
+-------------------------------------*/
+SceneFileCache::SceneFileCache(SceneFileCache&& c) noexcept :
+    pData{c.pData},
+    numBytes{c.numBytes},
+    fileHandle{c.fileHandle},
+    mapHandle{c.mapHandle}
+{
+    c.pData = nullptr;
+    c.numBytes = 0;
+    c.fileHandle = SCENE_CACHE_INVALID_HANDLE;
+    c.mapHandle = SCENE_CACHE_INVALID_HANDLE;
+}
+
+
+
+/*-------------------------------------
+ * Move Operator
+-------------------------------------*/
+SceneFileCache& SceneFileCache::operator=(SceneFileCache&& c) noexcept
+{
+    if (this != &c)
+    {
+        close();
+
+        pData = c.pData;
+        c.pData = nullptr;
+
+        numBytes = c.numBytes;
+        c.numBytes = 0;
+
+        fileHandle = c.fileHandle;
+        c.fileHandle = SCENE_CACHE_INVALID_HANDLE;
+
+        mapHandle = c.mapHandle;
+        c.mapHandle = SCENE_CACHE_INVALID_HANDLE;
+    }
+
+    return *this;
+}
+
+
+
+/*-------------------------------------
+ * Map a file into memory
+-------------------------------------*/
+bool SceneFileCache::open(const std::string& path) noexcept
+{
+    close();
+
+    #if defined(LS_OS_WINDOWS)
+        HANDLE hFile = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (hFile == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(hFile, &fileSize) || fileSize.QuadPart <= 0)
+        {
+            CloseHandle(hFile);
+            return false;
+        }
+
+        HANDLE hMap = CreateFileMappingA(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!hMap)
+        {
+            CloseHandle(hFile);
+            return false;
+        }
+
+        const void* const pMap = MapViewOfFile(hMap, FILE_MAP_READ, 0, 0, 0);
+        if (!pMap)
+        {
+            CloseHandle(hMap);
+            CloseHandle(hFile);
+            return false;
+        }
+
+        fileHandle = (intptr_t)hFile;
+        mapHandle = (intptr_t)hMap;
+        numBytes = (size_t)fileSize.QuadPart;
+        pData = (const char*)pMap;
+
+    #else
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            return false;
+        }
+
+        struct stat fileStats;
+        if (fstat(fd, &fileStats) != 0 || fileStats.st_size <= 0)
+        {
+            ::close(fd);
+            return false;
+        }
+
+        void* const pMap = mmap(nullptr, (size_t)fileStats.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (pMap == MAP_FAILED)
+        {
+            ::close(fd);
+            return false;
+        }
+
+        // The header and scene data are read sequentially, followed by a
+        // single large copy of the vertex and index payloads.
+        madvise(pMap, (size_t)fileStats.st_size, MADV_SEQUENTIAL);
+
+        fileHandle = (intptr_t)fd;
+        numBytes = (size_t)fileStats.st_size;
+        pData = (const char*)pMap;
+    #endif
+
+    return true;
+}
+
+
+
+/*-------------------------------------
+ * Unmap the current file
+-------------------------------------*/
+void SceneFileCache::close() noexcept
+{
+    #if defined(LS_OS_WINDOWS)
+        if (pData)
+        {
+            UnmapViewOfFile(pData);
+        }
+
+        if (mapHandle != SCENE_CACHE_INVALID_HANDLE)
+        {
+            CloseHandle((HANDLE)mapHandle);
+        }
+
+        if (fileHandle != SCENE_CACHE_INVALID_HANDLE)
+        {
+            CloseHandle((HANDLE)fileHandle);
+        }
+    #else
+        if (pData)
+        {
+            munmap((void*)pData, numBytes);
+        }
+
+        if (fileHandle != SCENE_CACHE_INVALID_HANDLE)
+        {
+            ::close((int)fileHandle);
+        }
+    #endif
+
+    pData = nullptr;
+    numBytes = 0;
+    fileHandle = SCENE_CACHE_INVALID_HANDLE;
+    mapHandle = SCENE_CACHE_INVALID_HANDLE;
+}
+
+
+
+/*-------------------------------------
+ * Validate the file header
+-------------------------------------*/
+bool SceneFileCache::validate(const std::string& sourcePath) const noexcept
+{
+    if (!pData || numBytes < sizeof(SceneCacheHeader))
+    {
+        return false;
+    }
+
+    const SceneCacheHeader& header = get_header();
+
+    if (header.magic != SCENE_CACHE_MAGIC
+    || header.endianCheck != SCENE_CACHE_ENDIAN_CHECK
+    || header.pointerBytes != sizeof(size_t)
+    ) {
+        LS_LOG_ERR("\tThe scene cache for ", sourcePath, " was not created on this platform.");
+        return false;
+    }
+
+    if (header.version != SCENE_CACHE_VERSION)
+    {
+        LS_LOG_MSG("\tThe scene cache for ", sourcePath, " is version ", header.version, ", expected version ", SCENE_CACHE_VERSION, '.');
+        return false;
+    }
+
+    // Payloads must be within the file.
+    if (header.vboOffset > numBytes
+    || header.vboBytes > numBytes - header.vboOffset
+    || header.iboOffset > numBytes
+    || header.iboBytes > numBytes - header.iboOffset
+    ) {
+        LS_LOG_ERR("\tThe scene cache for ", sourcePath, " is truncated.");
+        return false;
+    }
+
+    uint64_t sourceBytes = 0;
+    int64_t sourceTime = 0;
+
+    if (get_scene_file_stats(sourcePath, sourceBytes, sourceTime)
+    && (sourceBytes != header.sourceBytes || sourceTime != header.sourceTime)
+    ) {
+        LS_LOG_MSG("\tThe scene cache for ", sourcePath, " is out of date.");
+        return false;
+    }
+
+    return true;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * SceneCacheWriter Class
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Destructor
+-------------------------------------*/
+SceneCacheWriter::~SceneCacheWriter() noexcept
+{
+    close();
+}
+
+
+
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+SceneCacheWriter::SceneCacheWriter() noexcept :
+    fout{},
+    outPath{},
+    tempPath{}
+{
+}
+
+
+
+/*-------------------------------------
+ * Open a file for writing
+-------------------------------------*/
+bool SceneCacheWriter::open(const std::string& path) noexcept
+{
+    close();
+
+    outPath = path;
+    tempPath = get_temp_cache_path(path);
+    fout.open(tempPath, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+
+    if (!fout.good())
+    {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+
+
+/*-------------------------------------
+ * Replace the output file with the written data
+-------------------------------------*/
+bool SceneCacheWriter::commit() noexcept
+{
+    if (!is_valid())
+    {
+        close();
+        return false;
+    }
+
+    fout.flush();
+    fout.close();
+
+    if (fout.fail() || !replace_cache_file(tempPath, outPath))
+    {
+        close();
+        return false;
+    }
+
+    fout.clear();
+    outPath.clear();
+    tempPath.clear();
+
+    return true;
+}
+
+
+
+/*-------------------------------------
+ * Close the current file
+-------------------------------------*/
+void SceneCacheWriter::close() noexcept
+{
+    if (fout.is_open())
+    {
+        fout.close();
+    }
+
+    fout.clear();
+
+    // Uncommitted data is discarded.
+    if (!tempPath.empty())
+    {
+        std::remove(tempPath.c_str());
+    }
+
+    outPath.clear();
+    tempPath.clear();
+}
+
+
+
+/*-------------------------------------
+ * Check for write errors
+-------------------------------------*/
+bool SceneCacheWriter::is_valid() const noexcept
+{
+    return fout.is_open() && fout.good();
+}
+
+
+
+/*-------------------------------------
+ * Retrieve the write position
+-------------------------------------*/
+uint64_t SceneCacheWriter::get_offset() noexcept
+{
+    return (uint64_t)fout.tellp();
+}
+
+
+
+/*-------------------------------------
+ * Move the write position
+-------------------------------------*/
+void SceneCacheWriter::seek(const uint64_t offset) noexcept
+{
+    fout.seekp((std::streamoff)offset, std::ios_base::beg);
+}
+
+
+
+/*-------------------------------------
+ * Align the write position
+-------------------------------------*/
+void SceneCacheWriter::pad_to(const uint64_t alignment) noexcept
+{
+    static constexpr char zeroes[SCENE_CACHE_PAYLOAD_ALIGNMENT] = {0};
+
+    const uint64_t offset = get_offset();
+    const uint64_t padding = (alignment - (offset & (alignment - 1))) & (alignment - 1);
+
+    for (uint64_t i = 0; i < padding; i += sizeof(zeroes))
+    {
+        const uint64_t count = padding - i;
+        write_bytes(zeroes, (size_t)(count < sizeof(zeroes) ? count : sizeof(zeroes)));
+    }
+}
+
+
+
+/*-------------------------------------
+ * Write raw bytes
+-------------------------------------*/
+void SceneCacheWriter::write_bytes(const void* const pBytes, const size_t count) noexcept
+{
+    if (count)
+    {
+        fout.write(reinterpret_cast<const char*>(pBytes), (std::streamsize)count);
+    }
+}
+
+
+
+/*-------------------------------------
+ * Write a string
+-------------------------------------*/
+void SceneCacheWriter::write_string(const std::string& str) noexcept
+{
+    write_array<char>(str.data(), str.size());
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * SceneCacheReader Class
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Destructor
+-------------------------------------*/
+SceneCacheReader::~SceneCacheReader() noexcept
+{
+}
+
+
+
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+SceneCacheReader::SceneCacheReader(const char* const pBytes, const size_t byteCount, const size_t startOffset) noexcept :
+    pData{pBytes},
+    numBytes{byteCount},
+    offset{startOffset},
+    valid{pBytes != nullptr && startOffset <= byteCount}
+{
+}
+
+
+
+/*-------------------------------------
+ * Copy Constructor
+-------------------------------------*/
+SceneCacheReader::SceneCacheReader(const SceneCacheReader& r) noexcept :
+    pData{r.pData},
+    numBytes{r.numBytes},
+    offset{r.offset},
+    valid{r.valid}
+{
+}
+
+
+
+/*-------------------------------------
+ * Move Constructor
+-------------------------------------*/
+SceneCacheReader::SceneCacheReader(SceneCacheReader&& r) noexcept :
+    pData{r.pData},
+    numBytes{r.numBytes},
+    offset{r.offset},
+    valid{r.valid}
+{
+    r.pData = nullptr;
+    r.numBytes = 0;
+    r.offset = 0;
+    r.valid = false;
+}
+
+
+
+/*-------------------------------------
+ * Copy Operator
+-------------------------------------*/
+SceneCacheReader& SceneCacheReader::operator=(const SceneCacheReader& r) noexcept
+{
+    pData = r.pData;
+    numBytes = r.numBytes;
+    offset = r.offset;
+    valid = r.valid;
+
+    return *this;
+}
+
+
+
+/*-------------------------------------
+ * Move Operator
+-------------------------------------*/
+SceneCacheReader& SceneCacheReader::operator=(SceneCacheReader&& r) noexcept
+{
+    pData = r.pData;
+    r.pData = nullptr;
+
+    numBytes = r.numBytes;
+    r.numBytes = 0;
+
+    offset = r.offset;
+    r.offset = 0;
+
+    valid = r.valid;
+    r.valid = false;
+
+    return *this;
+}
+
+
+
+/*-------------------------------------
+ * Read raw bytes
+-------------------------------------*/
+const char* SceneCacheReader::read_bytes(const size_t count) noexcept
+{
+    if (!valid || count > numBytes - offset)
+    {
+        valid = false;
+        return nullptr;
+    }
+
+    const char* const pBytes = pData + offset;
+    offset += count;
+
+    return pBytes;
+}
+
+
+
+/*-------------------------------------
+ * Read an element count
+-------------------------------------*/
+bool SceneCacheReader::read_count(size_t& outCount, const size_t minElementBytes) noexcept
+{
+    uint64_t count = 0;
+    outCount = 0;
+
+    if (!read<uint64_t>(count))
+    {
+        return false;
+    }
+
+    if (minElementBytes && count > (uint64_t)(get_bytes_remaining() / minElementBytes))
+    {
+        valid = false;
+        return false;
+    }
+
+    outCount = (size_t)count;
+
+    return true;
+}
+
+
+
+/*-------------------------------------
+ * Read a string
+-------------------------------------*/
+bool SceneCacheReader::read_string(std::string& outStr) noexcept
+{
+    uint64_t count = 0;
+
+    if (!read<uint64_t>(count))
+    {
+        return false;
+    }
+
+    const char* const pBytes = read_bytes((size_t)count);
+
+    if (!pBytes)
+    {
+        return false;
+    }
+
+    outStr.assign(pBytes, (size_t)count);
+
+    return true;
+}
+} // end draw namespace
+} // end ls namespace
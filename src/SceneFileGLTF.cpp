@@ -0,0 +1,3404 @@
+
+#include <atomic>
+#include <cmath> // std::atan, std::tan
+#include <cstdlib> // std::strtod
+#include <cstring> // std::memcpy, std::memcmp, std::strlen
+#include <functional> // std::ref
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits> // std::underlying_type
+#include <unordered_map>
+#include <utility> // std::move
+#include <vector>
+
+#include "lightsky/utils/Copy.h" // utils::fast_fill()
+#include "lightsky/utils/Endian.h"
+#include "lightsky/utils/Log.h"
+
+#include "lightsky/math/Math.h"
+
+#include "lightsky/draw/Animation.h"
+#include "lightsky/draw/BoundingBox.h"
+#include "lightsky/draw/Camera.h"
+#include "lightsky/draw/MeshOptimizer.h"
+#include "lightsky/draw/PackedVertex.h"
+#include "lightsky/draw/SceneFileLoader.h"
+#include "lightsky/draw/SceneFileUtility.h"
+#include "lightsky/draw/SceneMaterial.h"
+#include "lightsky/draw/Transform.h"
+#include "lightsky/draw/VertexUtils.h"
+
+
+
+/*-----------------------------------------------------------------------------
+ * Anonymous helper functions
+-----------------------------------------------------------------------------*/
+namespace
+{
+
+namespace draw = ls::draw;
+namespace math = ls::math;
+namespace utils = ls::utils;
+
+/*-------------------------------------
+ * glTF constants
+-------------------------------------*/
+enum gltf_property_t : uint32_t
+{
+    GLTF_GLB_MAGIC = 0x46546C67, // "glTF"
+    GLTF_GLB_VERSION = 2,
+    GLTF_GLB_HEADER_BYTES = 12,
+    GLTF_GLB_CHUNK_HEADER_BYTES = 8,
+    GLTF_GLB_CHUNK_JSON = 0x4E4F534A, // "JSON"
+    GLTF_GLB_CHUNK_BIN = 0x004E4942, // "BIN\0"
+
+    GLTF_COMPONENT_BYTE = 5120,
+    GLTF_COMPONENT_UBYTE = 5121,
+    GLTF_COMPONENT_SHORT = 5122,
+    GLTF_COMPONENT_USHORT = 5123,
+    GLTF_COMPONENT_UINT = 5125,
+    GLTF_COMPONENT_FLOAT = 5126,
+
+    GLTF_MODE_POINTS = 0,
+    GLTF_MODE_LINES = 1,
+    GLTF_MODE_LINE_LOOP = 2,
+    GLTF_MODE_LINE_STRIP = 3,
+    GLTF_MODE_TRIS = 4,
+    GLTF_MODE_TRI_STRIP = 5,
+    GLTF_MODE_TRI_FAN = 6,
+
+    GLTF_WRAP_CLAMP = 33071,
+    GLTF_WRAP_MIRROR_REPEAT = 33648,
+    GLTF_WRAP_REPEAT = 10497,
+
+    // Nesting limit of the JSON parser, preventing malformed files from
+    // overflowing the stack.
+    GLTF_JSON_MAX_DEPTH = 256
+};
+
+constexpr size_t GLTF_INVALID_INDEX = (size_t)-1;
+
+
+
+/*-------------------------------------
+ * JSON value types
+-------------------------------------*/
+enum gltf_json_t : uint8_t
+{
+    GLTF_JSON_NULL,
+    GLTF_JSON_BOOLEAN,
+    GLTF_JSON_NUMBER,
+    GLTF_JSON_STRING,
+    GLTF_JSON_ARRAY,
+    GLTF_JSON_OBJECT
+};
+
+
+
+/*-------------------------------------
+ * A single JSON value
+-------------------------------------*/
+struct GLTFJson
+{
+    gltf_json_t type = GLTF_JSON_NULL;
+
+    bool boolean = false;
+
+    double number = 0.0;
+
+    std::string str;
+
+    // Object members are stored as parallel lists of keys and values. Arrays
+    // only use the list of values.
+    std::vector<std::string> keys;
+
+    std::vector<GLTFJson> items;
+
+    const GLTFJson& operator[](const char* const key) const noexcept;
+
+    const GLTFJson& operator[](const size_t index) const noexcept;
+
+    bool is_valid() const noexcept;
+
+    size_t size() const noexcept;
+
+    double as_number(const double fallback) const noexcept;
+
+    size_t as_index(const size_t fallback = GLTF_INVALID_INDEX) const noexcept;
+
+    const std::string& as_string() const noexcept;
+};
+
+
+
+/*-------------------------------------
+ * Shared value returned by lookups which fail
+-------------------------------------*/
+const GLTFJson& get_gltf_json_null() noexcept
+{
+    static const GLTFJson nullValue{};
+    return nullValue;
+}
+
+
+
+/*-------------------------------------
+ * Retrieve an object member
+-------------------------------------*/
+const GLTFJson& GLTFJson::operator[](const char* const key) const noexcept
+{
+    if (type == GLTF_JSON_OBJECT)
+    {
+        for (size_t i = 0; i < keys.size(); ++i)
+        {
+            if (keys[i] == key)
+            {
+                return items[i];
+            }
+        }
+    }
+
+    return get_gltf_json_null();
+}
+
+
+
+/*-------------------------------------
+ * Retrieve an array element
+-------------------------------------*/
+const GLTFJson& GLTFJson::operator[](const size_t index) const noexcept
+{
+    return (type == GLTF_JSON_ARRAY && index < items.size()) ? items[index] : get_gltf_json_null();
+}
+
+
+
+/*-------------------------------------
+ * Determine if a value exists
+-------------------------------------*/
+inline bool GLTFJson::is_valid() const noexcept
+{
+    return type != GLTF_JSON_NULL;
+}
+
+
+
+/*-------------------------------------
+ * Count the elements of an array or object
+-------------------------------------*/
+inline size_t GLTFJson::size() const noexcept
+{
+    return (type == GLTF_JSON_ARRAY || type == GLTF_JSON_OBJECT) ? items.size() : 0;
+}
+
+
+
+/*-------------------------------------
+ * Retrieve a number
+-------------------------------------*/
+inline double GLTFJson::as_number(const double fallback) const noexcept
+{
+    return type == GLTF_JSON_NUMBER ? number : fallback;
+}
+
+
+
+/*-------------------------------------
+ * Retrieve an array index or element count
+-------------------------------------*/
+size_t GLTFJson::as_index(const size_t fallback) const noexcept
+{
+    if (type != GLTF_JSON_NUMBER || !(number >= 0.0) || number >= 4294967295.0 || std::floor(number) != number)
+    {
+        return fallback;
+    }
+
+    return (size_t)number;
+}
+
+
+
+/*-------------------------------------
+ * Retrieve a string
+-------------------------------------*/
+inline const std::string& GLTFJson::as_string() const noexcept
+{
+    return type == GLTF_JSON_STRING ? str : get_gltf_json_null().str;
+}
+
+
+
+/*-------------------------------------
+ * Convert a hexadecimal digit into its value
+-------------------------------------*/
+inline int get_gltf_hex_digit(const char c) noexcept
+{
+    if (c >= '0' && c <= '9')
+    {
+        return c - '0';
+    }
+
+    if (c >= 'a' && c <= 'f')
+    {
+        return c - 'a' + 10;
+    }
+
+    if (c >= 'A' && c <= 'F')
+    {
+        return c - 'A' + 10;
+    }
+
+    return -1;
+}
+
+
+
+/*-------------------------------------
+ * Recursive-descent JSON parser
+-------------------------------------*/
+class GLTFJsonParser
+{
+  private:
+    const char* pIter = nullptr;
+
+    const char* pEnd = nullptr;
+
+    void skip_whitespace() noexcept;
+
+    bool parse_value(GLTFJson& outValue, const unsigned depth) noexcept;
+
+    bool parse_object(GLTFJson& outValue, const unsigned depth) noexcept;
+
+    bool parse_array(GLTFJson& outValue, const unsigned depth) noexcept;
+
+    bool parse_string(std::string& outStr) noexcept;
+
+    bool parse_hex4(uint32_t& outCodePoint) noexcept;
+
+    bool parse_number(GLTFJson& outValue) noexcept;
+
+    bool parse_literal(const char* const pLiteral) noexcept;
+
+  public:
+    bool parse(const char* const pData, const size_t numBytes, GLTFJson& outRoot) noexcept;
+};
+
+
+
+/*-------------------------------------
+ * Skip insignificant whitespace
+-------------------------------------*/
+void GLTFJsonParser::skip_whitespace() noexcept
+{
+    while (pIter < pEnd && (*pIter == ' ' || *pIter == '\t' || *pIter == '\n' || *pIter == '\r'))
+    {
+        ++pIter;
+    }
+}
+
+
+
+/*-------------------------------------
+ * Parse any JSON value
+-------------------------------------*/
+bool GLTFJsonParser::parse_value(GLTFJson& outValue, const unsigned depth) noexcept
+{
+    skip_whitespace();
+
+    if (pIter >= pEnd || depth > GLTF_JSON_MAX_DEPTH)
+    {
+        return false;
+    }
+
+    switch (*pIter)
+    {
+        case '{':
+            return parse_object(outValue, depth);
+
+        case '[':
+            return parse_array(outValue, depth);
+
+        case '\"':
+            outValue.type = GLTF_JSON_STRING;
+            return parse_string(outValue.str);
+
+        case 't':
+            outValue.type = GLTF_JSON_BOOLEAN;
+            outValue.boolean = true;
+            return parse_literal("true");
+
+        case 'f':
+            outValue.type = GLTF_JSON_BOOLEAN;
+            outValue.boolean = false;
+            return parse_literal("false");
+
+        case 'n':
+            outValue.type = GLTF_JSON_NULL;
+            return parse_literal("null");
+
+        default:
+            break;
+    }
+
+    return parse_number(outValue);
+}
+
+
+
+/*-------------------------------------
+ * Parse a JSON object
+-------------------------------------*/
+bool GLTFJsonParser::parse_object(GLTFJson& outValue, const unsigned depth) noexcept
+{
+    ++pIter;
+    outValue.type = GLTF_JSON_OBJECT;
+    skip_whitespace();
+
+    if (pIter < pEnd && *pIter == '}')
+    {
+        ++pIter;
+        return true;
+    }
+
+    while (true)
+    {
+        skip_whitespace();
+
+        if (pIter >= pEnd || *pIter != '\"')
+        {
+            return false;
+        }
+
+        outValue.keys.emplace_back();
+        if (!parse_string(outValue.keys.back()))
+        {
+            return false;
+        }
+
+        skip_whitespace();
+
+        if (pIter >= pEnd || *pIter != ':')
+        {
+            return false;
+        }
+
+        ++pIter;
+
+        outValue.items.emplace_back();
+        if (!parse_value(outValue.items.back(), depth + 1))
+        {
+            return false;
+        }
+
+        skip_whitespace();
+
+        if (pIter >= pEnd)
+        {
+            return false;
+        }
+
+        if (*pIter == '}')
+        {
+            ++pIter;
+            return true;
+        }
+
+        if (*pIter != ',')
+        {
+            return false;
+        }
+
+        ++pIter;
+    }
+}
+
+
+
+/*-------------------------------------
+ * Parse a JSON array
+-------------------------------------*/
+bool GLTFJsonParser::parse_array(GLTFJson& outValue, const unsigned depth) noexcept
+{
+    ++pIter;
+    outValue.type = GLTF_JSON_ARRAY;
+    skip_whitespace();
+
+    if (pIter < pEnd && *pIter == ']')
+    {
+        ++pIter;
+        return true;
+    }
+
+    while (true)
+    {
+        outValue.items.emplace_back();
+        if (!parse_value(outValue.items.back(), depth + 1))
+        {
+            return false;
+        }
+
+        skip_whitespace();
+
+        if (pIter >= pEnd)
+        {
+            return false;
+        }
+
+        if (*pIter == ']')
+        {
+            ++pIter;
+            return true;
+        }
+
+        if (*pIter != ',')
+        {
+            return false;
+        }
+
+        ++pIter;
+    }
+}
+
+
+
+/*-------------------------------------
+ * Parse a JSON string, converting escape sequences into UTF-8
+-------------------------------------*/
+bool GLTFJsonParser::parse_string(std::string& outStr) noexcept
+{
+    ++pIter;
+    outStr.clear();
+
+    while (pIter < pEnd)
+    {
+        const char c = *pIter++;
+
+        if (c == '\"')
+        {
+            return true;
+        }
+
+        if ((unsigned char)c < 0x20)
+        {
+            return false;
+        }
+
+        if (c != '\\')
+        {
+            outStr.push_back(c);
+            continue;
+        }
+
+        if (pIter >= pEnd)
+        {
+            return false;
+        }
+
+        const char escape = *pIter++;
+        uint32_t codePoint = 0;
+
+        switch (escape)
+        {
+            case '\"':
+            case '\\':
+            case '/':
+                outStr.push_back(escape);
+                continue;
+
+            case 'b': outStr.push_back('\b'); continue;
+            case 'f': outStr.push_back('\f'); continue;
+            case 'n': outStr.push_back('\n'); continue;
+            case 'r': outStr.push_back('\r'); continue;
+            case 't': outStr.push_back('\t'); continue;
+
+            case 'u':
+                break;
+
+            default:
+                return false;
+        }
+
+        if (!parse_hex4(codePoint))
+        {
+            return false;
+        }
+
+        // Characters outside of the basic multilingual plane are escaped as
+        // surrogate pairs.
+        if (codePoint >= 0xD800 && codePoint <= 0xDBFF)
+        {
+            uint32_t lowSurrogate = 0;
+
+            if (pEnd - pIter < 6 || pIter[0] != '\\' || pIter[1] != 'u')
+            {
+                return false;
+            }
+
+            pIter += 2;
+
+            if (!parse_hex4(lowSurrogate) || lowSurrogate < 0xDC00 || lowSurrogate > 0xDFFF)
+            {
+                return false;
+            }
+
+            codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (lowSurrogate - 0xDC00);
+        }
+        else if (codePoint >= 0xDC00 && codePoint <= 0xDFFF)
+        {
+            return false;
+        }
+
+        if (codePoint < 0x80)
+        {
+            outStr.push_back((char)codePoint);
+        }
+        else if (codePoint < 0x800)
+        {
+            outStr.push_back((char)(0xC0 | (codePoint >> 6)));
+            outStr.push_back((char)(0x80 | (codePoint & 0x3F)));
+        }
+        else if (codePoint < 0x10000)
+        {
+            outStr.push_back((char)(0xE0 | (codePoint >> 12)));
+            outStr.push_back((char)(0x80 | ((codePoint >> 6) & 0x3F)));
+            outStr.push_back((char)(0x80 | (codePoint & 0x3F)));
+        }
+        else
+        {
+            outStr.push_back((char)(0xF0 | (codePoint >> 18)));
+            outStr.push_back((char)(0x80 | ((codePoint >> 12) & 0x3F)));
+            outStr.push_back((char)(0x80 | ((codePoint >> 6) & 0x3F)));
+            outStr.push_back((char)(0x80 | (codePoint & 0x3F)));
+        }
+    }
+
+    return false;
+}
+
+
+
+/*-------------------------------------
+ * Parse the four hex digits of a unicode escape
+-------------------------------------*/
+bool GLTFJsonParser::parse_hex4(uint32_t& outCodePoint) noexcept
+{
+    if (pEnd - pIter < 4)
+    {
+        return false;
+    }
+
+    outCodePoint = 0;
+
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        const int digit = get_gltf_hex_digit(*pIter++);
+
+        if (digit < 0)
+        {
+            return false;
+        }
+
+        outCodePoint = (outCodePoint << 4) | (uint32_t)digit;
+    }
+
+    return true;
+}
+
+
+
+/*-------------------------------------
+ * Parse a JSON number
+-------------------------------------*/
+bool GLTFJsonParser::parse_number(GLTFJson& outValue) noexcept
+{
+    const char* const pStart = pIter;
+
+    while (pIter < pEnd && ((*pIter >= '0' && *pIter <= '9') || *pIter == '-' || *pIter == '+' || *pIter == '.' || *pIter == 'e' || *pIter == 'E'))
+    {
+        ++pIter;
+    }
+
+    // The mapped file is not null-terminated, so numbers are copied before
+    // being converted.
+    char numStr[64];
+    const size_t numChars = (size_t)(pIter - pStart);
+
+    if (!numChars || numChars >= sizeof(numStr))
+    {
+        return false;
+    }
+
+    std::memcpy(numStr, pStart, numChars);
+    numStr[numChars] = '\0';
+
+    char* pNumEnd = nullptr;
+    const double number = std::strtod(numStr, &pNumEnd);
+
+    if (pNumEnd != numStr + numChars)
+    {
+        return false;
+    }
+
+    outValue.type = GLTF_JSON_NUMBER;
+    outValue.number = number;
+
+    return true;
+}
+
+
+
+/*-------------------------------------
+ * Parse the literals "true", "false", or "null"
+-------------------------------------*/
+bool GLTFJsonParser::parse_literal(const char* const pLiteral) noexcept
+{
+    const size_t numChars = std::strlen(pLiteral);
+
+    if ((size_t)(pEnd - pIter) < numChars || std::memcmp(pIter, pLiteral, numChars) != 0)
+    {
+        return false;
+    }
+
+    pIter += numChars;
+    return true;
+}
+
+
+
+/*-------------------------------------
+ * Parse a complete JSON document
+-------------------------------------*/
+bool GLTFJsonParser::parse(const char* const pData, const size_t numBytes, GLTFJson& outRoot) noexcept
+{
+    pIter = pData;
+    pEnd = pData + numBytes;
+    outRoot = GLTFJson{};
+
+    // Skip the UTF-8 byte-order mark
+    if (numBytes >= 3 && (unsigned char)pData[0] == 0xEF && (unsigned char)pData[1] == 0xBB && (unsigned char)pData[2] == 0xBF)
+    {
+        pIter += 3;
+    }
+
+    if (!parse_value(outRoot, 0))
+    {
+        return false;
+    }
+
+    // GLB chunks are padded with spaces, though some exporters use zeroes.
+    skip_whitespace();
+
+    while (pIter < pEnd && *pIter == '\0')
+    {
+        ++pIter;
+    }
+
+    return pIter == pEnd;
+}
+
+
+
+/*-------------------------------------
+ * Decode a base64 string
+-------------------------------------*/
+bool decode_gltf_base64(const char* const pIn, const size_t numChars, std::vector<char>& outData) noexcept
+{
+    uint32_t bits = 0;
+    unsigned numBits = 0;
+
+    outData.clear();
+    outData.reserve(numChars / 4 * 3);
+
+    for (size_t i = 0; i < numChars; ++i)
+    {
+        const char c = pIn[i];
+        uint32_t value;
+
+        if (c >= 'A' && c <= 'Z')
+        {
+            value = (uint32_t)(c - 'A');
+        }
+        else if (c >= 'a' && c <= 'z')
+        {
+            value = (uint32_t)(c - 'a') + 26;
+        }
+        else if (c >= '0' && c <= '9')
+        {
+            value = (uint32_t)(c - '0') + 52;
+        }
+        else if (c == '+' || c == '-')
+        {
+            value = 62;
+        }
+        else if (c == '/' || c == '_')
+        {
+            value = 63;
+        }
+        else if (c == '=')
+        {
+            break;
+        }
+        else
+        {
+            return false;
+        }
+
+        bits = (bits << 6) | value;
+        numBits += 6;
+
+        if (numBits >= 8)
+        {
+            numBits -= 8;
+            outData.push_back((char)((bits >> numBits) & 0xFF));
+        }
+    }
+
+    return true;
+}
+
+
+
+/*-------------------------------------
+ * Decode the percent-encoded characters of a relative URI
+-------------------------------------*/
+std::string decode_gltf_uri(const std::string& uri) noexcept
+{
+    std::string outPath;
+    outPath.reserve(uri.size());
+
+    for (size_t i = 0; i < uri.size(); ++i)
+    {
+        if (uri[i] == '%' && i + 2 < uri.size())
+        {
+            const int hi = get_gltf_hex_digit(uri[i + 1]);
+            const int lo = get_gltf_hex_digit(uri[i + 2]);
+
+            if (hi >= 0 && lo >= 0)
+            {
+                outPath.push_back((char)((hi << 4) | lo));
+                i += 2;
+                continue;
+            }
+        }
+
+        outPath.push_back(uri[i]);
+    }
+
+    return outPath;
+}
+
+
+
+/*-------------------------------------
+ * Read an unaligned little-endian integer
+-------------------------------------*/
+inline uint32_t read_gltf_u32(const char* const pData) noexcept
+{
+    uint32_t ret;
+    std::memcpy(&ret, pData, sizeof(uint32_t));
+    return ret;
+}
+
+
+
+/*-------------------------------------
+ * Locate the JSON and binary chunks of a GLB file
+-------------------------------------*/
+bool read_glb_chunks(
+    const char* const pFile,
+    const size_t fileBytes,
+    const char*& outJson,
+    size_t& outJsonBytes,
+    const char*& outBin,
+    size_t& outBinBytes
+) noexcept
+{
+    const size_t totalBytes = read_gltf_u32(pFile + 8);
+
+    if (read_gltf_u32(pFile + 4) != GLTF_GLB_VERSION || totalBytes > fileBytes)
+    {
+        return false;
+    }
+
+    size_t offset = GLTF_GLB_HEADER_BYTES;
+    outJson = nullptr;
+    outJsonBytes = 0;
+    outBin = nullptr;
+    outBinBytes = 0;
+
+    while (totalBytes - offset >= GLTF_GLB_CHUNK_HEADER_BYTES)
+    {
+        const size_t chunkBytes = read_gltf_u32(pFile + offset);
+        const uint32_t chunkType = read_gltf_u32(pFile + offset + 4);
+        offset += GLTF_GLB_CHUNK_HEADER_BYTES;
+
+        if (chunkBytes > totalBytes - offset)
+        {
+            return false;
+        }
+
+        // The first chunk must contain JSON, optionally followed by a
+        // single binary chunk. Unknown chunks are ignored.
+        if (!outJson)
+        {
+            if (chunkType != GLTF_GLB_CHUNK_JSON)
+            {
+                return false;
+            }
+
+            outJson = pFile + offset;
+            outJsonBytes = chunkBytes;
+        }
+        else if (chunkType == GLTF_GLB_CHUNK_BIN && !outBin)
+        {
+            outBin = pFile + offset;
+            outBinBytes = chunkBytes;
+        }
+
+        offset += (chunkBytes + 3u) & ~(size_t)3u;
+
+        if (offset > totalBytes)
+        {
+            break;
+        }
+    }
+
+    return outJson != nullptr;
+}
+
+
+
+/*-------------------------------------
+ * Resolved glTF buffers, views, and accessors
+-------------------------------------*/
+struct GLTFBuffer
+{
+    const char* pData;
+
+    size_t numBytes;
+};
+
+struct GLTFBufferView
+{
+    const char* pData;
+
+    size_t numBytes;
+
+    size_t byteStride;
+
+    bool isValid;
+};
+
+struct GLTFAccessor
+{
+    // Bounds of the accessor's buffer view
+    const char* pView;
+
+    size_t viewBytes;
+
+    // Location of the first element
+    const char* pData;
+
+    size_t count;
+
+    size_t stride;
+
+    unsigned componentType;
+
+    unsigned numComponents;
+
+    bool normalized;
+
+    bool isValid;
+};
+
+struct GLTFDocument
+{
+    GLTFJson json;
+
+    std::vector<GLTFBuffer> buffers;
+
+    std::vector<GLTFBufferView> views;
+
+    std::vector<GLTFAccessor> accessors;
+};
+
+
+
+/*-------------------------------------
+ * Retrieve the size of a single accessor component
+-------------------------------------*/
+inline unsigned get_gltf_component_bytes(const unsigned componentType) noexcept
+{
+    switch (componentType)
+    {
+        case GLTF_COMPONENT_BYTE:
+        case GLTF_COMPONENT_UBYTE:
+            return 1;
+
+        case GLTF_COMPONENT_SHORT:
+        case GLTF_COMPONENT_USHORT:
+            return 2;
+
+        case GLTF_COMPONENT_UINT:
+        case GLTF_COMPONENT_FLOAT:
+            return 4;
+
+        default:
+            break;
+    }
+
+    return 0;
+}
+
+
+
+/*-------------------------------------
+ * Retrieve the number of components within an accessor type
+-------------------------------------*/
+unsigned get_gltf_num_components(const std::string& type) noexcept
+{
+    if (type == "SCALAR") return 1;
+    if (type == "VEC2") return 2;
+    if (type == "VEC3") return 3;
+    if (type == "VEC4") return 4;
+    if (type == "MAT2") return 4;
+    if (type == "MAT3") return 9;
+    if (type == "MAT4") return 16;
+
+    return 0;
+}
+
+
+
+/*-------------------------------------
+ * Resolve all buffers from the GLB binary chunk, data URIs, or external files
+-------------------------------------*/
+bool load_gltf_buffers(
+    GLTFDocument& doc,
+    const char* const pBin,
+    const size_t binBytes,
+    const std::string& baseFileDir,
+    std::vector<draw::SceneFileCache>& outMappings,
+    std::vector<std::vector<char>>& outBuffers
+) noexcept
+{
+    const GLTFJson& inBuffers = doc.json["buffers"];
+    doc.buffers.resize(inBuffers.size(), GLTFBuffer{nullptr, 0});
+
+    for (size_t i = 0; i < inBuffers.size(); ++i)
+    {
+        const GLTFJson& inBuffer = inBuffers[i];
+        const GLTFJson& inUri = inBuffer["uri"];
+        const std::string& uri = inUri.as_string();
+        const size_t byteLength = inBuffer["byteLength"].as_index(0);
+        GLTFBuffer& outBuffer = doc.buffers[i];
+
+        if (!inUri.is_valid())
+        {
+            // Only the first buffer of a GLB file may reference its binary
+            // chunk.
+            if (i != 0 || !pBin)
+            {
+                LS_LOG_ERR("\tError: glTF buffer ", i, " does not contain a URI.");
+                return false;
+            }
+
+            outBuffer = GLTFBuffer{pBin, binBytes};
+        }
+        else if (uri.compare(0, 5, "data:") == 0)
+        {
+            const std::string::size_type dataStart = uri.find(";base64,");
+
+            if (dataStart == std::string::npos)
+            {
+                LS_LOG_ERR("\tError: glTF buffer ", i, " uses an unsupported data URI.");
+                return false;
+            }
+
+            outBuffers.emplace_back();
+            std::vector<char>& decoded = outBuffers.back();
+
+            if (!decode_gltf_base64(uri.data() + dataStart + 8, uri.size() - dataStart - 8, decoded))
+            {
+                LS_LOG_ERR("\tError: Unable to decode glTF buffer ", i, '.');
+                return false;
+            }
+
+            outBuffer = GLTFBuffer{decoded.data(), decoded.size()};
+        }
+        else
+        {
+            const std::string&& bufferPath = baseFileDir + decode_gltf_uri(uri);
+            draw::SceneFileCache mapping;
+
+            if (!mapping.open(bufferPath))
+            {
+                LS_LOG_ERR("\tError: Unable to open the glTF buffer ", bufferPath, '.');
+                return false;
+            }
+
+            outBuffer = GLTFBuffer{mapping.get_data(), mapping.get_size()};
+            outMappings.emplace_back(std::move(mapping));
+        }
+
+        if (outBuffer.numBytes < byteLength)
+        {
+            LS_LOG_ERR("\tError: glTF buffer ", i, " is smaller than its declared length.");
+            return false;
+        }
+
+        outBuffer.numBytes = byteLength;
+    }
+
+    return true;
+}
+
+
+
+/*-------------------------------------
+ * Validate all buffer views and accessors
+ *
+ * Invalid, sparse, or unbacked accessors are flagged rather than rejected so
+ * files which never reference them can still be imported.
+-------------------------------------*/
+void resolve_gltf_accessors(GLTFDocument& doc) noexcept
+{
+    const GLTFJson& inViews = doc.json["bufferViews"];
+    const GLTFJson& inAccessors = doc.json["accessors"];
+
+    doc.views.resize(inViews.size());
+    doc.accessors.resize(inAccessors.size());
+
+    for (size_t i = 0; i < inViews.size(); ++i)
+    {
+        const GLTFJson& inView = inViews[i];
+        const size_t bufferId = inView["buffer"].as_index();
+        const size_t offset = inView["byteOffset"].as_index(0);
+        const size_t numBytes = inView["byteLength"].as_index();
+        GLTFBufferView& outView = doc.views[i];
+
+        outView = GLTFBufferView{nullptr, 0, inView["byteStride"].as_index(0), false};
+
+        if (bufferId < doc.buffers.size()
+        && offset != GLTF_INVALID_INDEX
+        && numBytes != GLTF_INVALID_INDEX
+        && offset <= doc.buffers[bufferId].numBytes
+        && numBytes <= doc.buffers[bufferId].numBytes - offset
+        ) {
+            outView.pData = doc.buffers[bufferId].pData + offset;
+            outView.numBytes = numBytes;
+            outView.isValid = true;
+        }
+    }
+
+    for (size_t i = 0; i < inAccessors.size(); ++i)
+    {
+        const GLTFJson& inAccessor = inAccessors[i];
+        const size_t viewId = inAccessor["bufferView"].as_index();
+        GLTFAccessor& outAccessor = doc.accessors[i];
+
+        outAccessor = GLTFAccessor{nullptr, 0, nullptr, 0, 0, 0, 0, false, false};
+
+        if (inAccessor["sparse"].is_valid() || viewId >= doc.views.size() || !doc.views[viewId].isValid)
+        {
+            continue;
+        }
+
+        const GLTFBufferView& view = doc.views[viewId];
+        const unsigned componentType = (unsigned)inAccessor["componentType"].as_index(0);
+        const unsigned numComponents = get_gltf_num_components(inAccessor["type"].as_string());
+        const size_t elementBytes = get_gltf_component_bytes(componentType) * numComponents;
+        const size_t count = inAccessor["count"].as_index();
+        const size_t offset = inAccessor["byteOffset"].as_index(0);
+        const size_t stride = view.byteStride ? view.byteStride : elementBytes;
+
+        if (!elementBytes || count == GLTF_INVALID_INDEX || offset == GLTF_INVALID_INDEX)
+        {
+            continue;
+        }
+
+        // All elements must lie within the buffer view.
+        if (count && (offset > view.numBytes
+        || elementBytes > view.numBytes - offset
+        || (count - 1) > (view.numBytes - offset - elementBytes) / stride
+        )) {
+            continue;
+        }
+
+        outAccessor.pView = view.pData;
+        outAccessor.viewBytes = view.numBytes;
+        outAccessor.pData = view.pData + offset;
+        outAccessor.count = count;
+        outAccessor.stride = stride;
+        outAccessor.componentType = componentType;
+        outAccessor.numComponents = numComponents;
+        outAccessor.normalized = inAccessor["normalized"].boolean;
+        outAccessor.isValid = true;
+    }
+}
+
+
+
+/*-------------------------------------
+ * Locate an accessor from its index
+ *
+ * Returns FALSE if the index references an unusable accessor. The output is
+ * set to NULL if no index was provided.
+-------------------------------------*/
+bool find_gltf_accessor(const GLTFDocument& doc, const GLTFJson& index, const GLTFAccessor*& outAccessor) noexcept
+{
+    outAccessor = nullptr;
+
+    if (!index.is_valid())
+    {
+        return true;
+    }
+
+    const size_t accessorId = index.as_index();
+
+    if (accessorId >= doc.accessors.size() || !doc.accessors[accessorId].isValid)
+    {
+        return false;
+    }
+
+    outAccessor = &doc.accessors[accessorId];
+    return true;
+}
+
+
+
+/*-------------------------------------
+ * Read a single accessor component as a float
+-------------------------------------*/
+inline float read_gltf_float(const char* const pData, const unsigned componentType, const bool normalized) noexcept
+{
+    switch (componentType)
+    {
+        case GLTF_COMPONENT_FLOAT:
+        {
+            float f;
+            std::memcpy(&f, pData, sizeof(float));
+            return f;
+        }
+
+        case GLTF_COMPONENT_BYTE:
+        {
+            const float f = (float)(int8_t)pData[0];
+            return normalized ? math::max(f / 127.f, -1.f) : f;
+        }
+
+        case GLTF_COMPONENT_UBYTE:
+        {
+            const float f = (float)(uint8_t)pData[0];
+            return normalized ? (f / 255.f) : f;
+        }
+
+        case GLTF_COMPONENT_SHORT:
+        {
+            int16_t s;
+            std::memcpy(&s, pData, sizeof(int16_t));
+            return normalized ? math::max((float)s / 32767.f, -1.f) : (float)s;
+        }
+
+        case GLTF_COMPONENT_USHORT:
+        {
+            uint16_t s;
+            std::memcpy(&s, pData, sizeof(uint16_t));
+            return normalized ? ((float)s / 65535.f) : (float)s;
+        }
+
+        case GLTF_COMPONENT_UINT:
+        {
+            uint32_t u;
+            std::memcpy(&u, pData, sizeof(uint32_t));
+            return (float)u;
+        }
+
+        default:
+            break;
+    }
+
+    return 0.f;
+}
+
+
+
+/*-------------------------------------
+ * Read a single accessor component as an unsigned integer
+-------------------------------------*/
+inline uint32_t read_gltf_uint(const char* const pData, const unsigned componentType) noexcept
+{
+    switch (componentType)
+    {
+        case GLTF_COMPONENT_UBYTE:
+            return (uint8_t)pData[0];
+
+        case GLTF_COMPONENT_USHORT:
+        {
+            uint16_t s;
+            std::memcpy(&s, pData, sizeof(uint16_t));
+            return s;
+        }
+
+        case GLTF_COMPONENT_UINT:
+        {
+            uint32_t u;
+            std::memcpy(&u, pData, sizeof(uint32_t));
+            return u;
+        }
+
+        default:
+            break;
+    }
+
+    return (uint32_t)read_gltf_float(pData, componentType, false);
+}
+
+
+
+/*-------------------------------------
+ * Read up to "numValues" components of an accessor element. Missing
+ * components are left unmodified.
+-------------------------------------*/
+inline void read_gltf_floats(const GLTFAccessor& accessor, const size_t index, float* const pOut, const unsigned numValues) noexcept
+{
+    const char* const pElement = accessor.pData + index * accessor.stride;
+    const unsigned componentBytes = get_gltf_component_bytes(accessor.componentType);
+    const unsigned numComponents = math::min(numValues, accessor.numComponents);
+
+    for (unsigned i = 0; i < numComponents; ++i)
+    {
+        pOut[i] = read_gltf_float(pElement + i * componentBytes, accessor.componentType, accessor.normalized);
+    }
+}
+
+
+
+/*-------------------------------------
+ * Read a 3D vector from an accessor
+-------------------------------------*/
+inline math::vec3 read_gltf_vec3(const GLTFAccessor& accessor, const size_t index) noexcept
+{
+    float v[3] = {0.f, 0.f, 0.f};
+    read_gltf_floats(accessor, index, v, 3);
+    return math::vec3{v[0], v[1], v[2]};
+}
+
+
+
+/*-------------------------------------
+ * Read a 4D vector from an accessor
+-------------------------------------*/
+inline math::vec4 read_gltf_vec4(const GLTFAccessor& accessor, const size_t index, const float defaultW) noexcept
+{
+    float v[4] = {0.f, 0.f, 0.f, defaultW};
+    read_gltf_floats(accessor, index, v, 4);
+    return math::vec4{v[0], v[1], v[2], v[3]};
+}
+
+
+
+/*-------------------------------------
+ * Write a single vertex attribute
+-------------------------------------*/
+template <typename data_t>
+inline void write_gltf_vertex(char* const pVert, const data_t& data) noexcept
+{
+    std::memcpy(pVert, &data, sizeof(data_t));
+}
+
+
+
+/*-------------------------------------
+ * A glTF primitive, imported as a single SceneMesh
+-------------------------------------*/
+struct GLTFPrimitive
+{
+    const GLTFJson* pMesh = nullptr;
+
+    uint32_t materialId = 0;
+
+    draw::draw_mode_t drawMode = draw::draw_mode_t::DRAW_MODE_TRIS;
+
+    draw::common_vertex_t vertType = (draw::common_vertex_t)0;
+
+    const GLTFAccessor* pPositions = nullptr;
+
+    const GLTFAccessor* pUvs = nullptr;
+
+    const GLTFAccessor* pNormals = nullptr;
+
+    const GLTFAccessor* pTangents = nullptr;
+
+    const GLTFAccessor* pColors = nullptr;
+
+    const GLTFAccessor* pJoints = nullptr;
+
+    const GLTFAccessor* pWeights = nullptr;
+
+    const GLTFAccessor* pIndices = nullptr;
+
+    // Morph target deltas. Either accessor of a target may be NULL.
+    std::vector<const GLTFAccessor*> targetPositions;
+
+    std::vector<const GLTFAccessor*> targetNormals;
+
+    // Results of the conversion. Vertices and indices either reference a
+    // mapped file directly or are converted into the vectors below.
+    bool isValid = false;
+
+    unsigned numVerts = 0;
+
+    unsigned numIndices = 0;
+
+    const char* pVertData = nullptr;
+
+    const char* pIndexData = nullptr;
+
+    draw::index_element_t indexType = draw::index_element_t::INDEX_TYPE_NONE;
+
+    std::vector<char> vertices;
+
+    std::vector<uint32_t> indices;
+
+    math::vec3 dequantScale = math::vec3{1.f, 1.f, 1.f};
+
+    math::vec3 dequantBias = math::vec3{0.f, 0.f, 0.f};
+
+    draw::BoundingBox bounds;
+
+    draw::SceneMorph morph;
+
+    draw::MeshOptimizerStats stats = draw::MeshOptimizerStats{0, 0, 0.f, 0.f, 0.f, 0.f};
+};
+
+
+
+/*-------------------------------------
+ * Convert a glTF primitive mode
+-------------------------------------*/
+bool convert_gltf_draw_mode(const size_t inMode, draw::draw_mode_t& outMode) noexcept
+{
+    switch (inMode)
+    {
+        case GLTF_MODE_POINTS:     outMode = draw::draw_mode_t::DRAW_MODE_POINTS; break;
+        case GLTF_MODE_LINES:      outMode = draw::draw_mode_t::DRAW_MODE_LINES; break;
+        case GLTF_MODE_LINE_LOOP:  outMode = draw::draw_mode_t::DRAW_MODE_LINE_LOOP; break;
+        case GLTF_MODE_LINE_STRIP: outMode = draw::draw_mode_t::DRAW_MODE_LINE_STRIP; break;
+        case GLTF_MODE_TRIS:       outMode = draw::draw_mode_t::DRAW_MODE_TRIS; break;
+        case GLTF_MODE_TRI_STRIP:  outMode = draw::draw_mode_t::DRAW_MODE_TRI_STRIP; break;
+        case GLTF_MODE_TRI_FAN:    outMode = draw::draw_mode_t::DRAW_MODE_TRI_FAN; break;
+
+        default:
+            return false;
+    }
+
+    return true;
+}
+
+
+
+/*-------------------------------------
+ * Convert a glTF sampler's wrapping mode
+-------------------------------------*/
+draw::tex_wrap_t convert_gltf_tex_wrapping(const size_t inWrapMode) noexcept
+{
+    switch (inWrapMode)
+    {
+        case GLTF_WRAP_CLAMP:
+            return draw::tex_wrap_t::TEX_WRAP_CLAMP;
+
+        case GLTF_WRAP_MIRROR_REPEAT:
+            return draw::tex_wrap_t::TEX_WRAP_MIRROR_REPEAT;
+
+        case GLTF_WRAP_REPEAT:
+            return draw::tex_wrap_t::TEX_WRAP_REPEAT;
+
+        default:
+            break;
+    }
+
+    return draw::tex_wrap_t::TEX_WRAP_DEFAULT;
+}
+
+
+
+/*-------------------------------------
+ * Locate all primitives and their vertex attributes
+-------------------------------------*/
+bool gather_gltf_primitives(
+    const GLTFDocument& doc,
+    const draw::common_vertex_t packedVertTypes,
+    std::vector<GLTFPrimitive>& outPrims,
+    std::vector<size_t>& outMeshOffsets,
+    bool& outNeedsDefaultMaterial
+) noexcept
+{
+    const GLTFJson& inMeshes = doc.json["meshes"];
+    const size_t numMaterials = doc.json["materials"].size();
+    size_t numPrims = 0;
+
+    for (size_t m = 0; m < inMeshes.size(); ++m)
+    {
+        numPrims += inMeshes[m]["primitives"].size();
+    }
+
+    outPrims.resize(numPrims);
+    outMeshOffsets.clear();
+    outMeshOffsets.reserve(inMeshes.size() + 1);
+    outNeedsDefaultMaterial = false;
+    numPrims = 0;
+
+    // Every mesh is split into one SceneMesh per primitive. Mesh nodes
+    // reference the range of SceneMeshes given by "outMeshOffsets."
+    for (size_t m = 0; m < inMeshes.size(); ++m)
+    {
+        const GLTFJson& inMesh = inMeshes[m];
+        const GLTFJson& inPrims = inMesh["primitives"];
+
+        outMeshOffsets.push_back(numPrims);
+
+        for (size_t p = 0; p < inPrims.size(); ++p, ++numPrims)
+        {
+            const GLTFJson& inPrim = inPrims[p];
+            const GLTFJson& inAttribs = inPrim["attributes"];
+            GLTFPrimitive& prim = outPrims[numPrims];
+
+            prim.pMesh = &inMesh;
+
+            if (!find_gltf_accessor(doc, inAttribs["POSITION"], prim.pPositions)
+            || !find_gltf_accessor(doc, inAttribs["TEXCOORD_0"], prim.pUvs)
+            || !find_gltf_accessor(doc, inAttribs["NORMAL"], prim.pNormals)
+            || !find_gltf_accessor(doc, inAttribs["TANGENT"], prim.pTangents)
+            || !find_gltf_accessor(doc, inAttribs["COLOR_0"], prim.pColors)
+            || !find_gltf_accessor(doc, inAttribs["JOINTS_0"], prim.pJoints)
+            || !find_gltf_accessor(doc, inAttribs["WEIGHTS_0"], prim.pWeights)
+            || !find_gltf_accessor(doc, inPrim["indices"], prim.pIndices)
+            ) {
+                LS_LOG_MSG("\tglTF mesh ", m, " references a sparse or invalid accessor.");
+                return false;
+            }
+
+            if (!prim.pPositions)
+            {
+                LS_LOG_MSG("\tglTF mesh ", m, " contains a primitive without vertex positions.");
+                return false;
+            }
+
+            if (!convert_gltf_draw_mode(inPrim["mode"].as_index(GLTF_MODE_TRIS), prim.drawMode))
+            {
+                LS_LOG_MSG("\tglTF mesh ", m, " contains an unknown primitive mode.");
+                return false;
+            }
+
+            const size_t materialId = inPrim["material"].as_index();
+            if (materialId < numMaterials)
+            {
+                prim.materialId = (uint32_t)materialId;
+            }
+            else
+            {
+                prim.materialId = (uint32_t)numMaterials;
+                outNeedsDefaultMaterial = true;
+            }
+
+            // Tangents are only usable alongside normals, and joints are
+            // only usable alongside weights.
+            if (!prim.pNormals)
+            {
+                prim.pTangents = nullptr;
+            }
+
+            if (!prim.pJoints || !prim.pWeights)
+            {
+                prim.pJoints = nullptr;
+                prim.pWeights = nullptr;
+            }
+
+            const size_t numVerts = prim.pPositions->count;
+            const auto isUsable = [&](const GLTFAccessor* pAttrib, const unsigned minComponents) -> bool
+            {
+                return !pAttrib || (pAttrib->count == numVerts && pAttrib->numComponents >= minComponents && pAttrib->numComponents <= 4);
+            };
+
+            if (prim.pPositions->componentType != GLTF_COMPONENT_FLOAT
+            || !isUsable(prim.pPositions, 3)
+            || !isUsable(prim.pUvs, 2)
+            || !isUsable(prim.pNormals, 3)
+            || !isUsable(prim.pTangents, 4)
+            || !isUsable(prim.pColors, 3)
+            || !isUsable(prim.pJoints, 4)
+            || !isUsable(prim.pWeights, 4)
+            || (prim.pIndices && (prim.pIndices->numComponents != 1 || prim.pIndices->componentType == GLTF_COMPONENT_FLOAT))
+            || (prim.pJoints && prim.pJoints->componentType != GLTF_COMPONENT_UBYTE && prim.pJoints->componentType != GLTF_COMPONENT_USHORT)
+            || numVerts > 0xFFFFFFFFu
+            ) {
+                LS_LOG_MSG("\tglTF mesh ", m, " contains vertex attributes which can not be imported natively.");
+                return false;
+            }
+
+            std::underlying_type<draw::common_vertex_t>::type vertTypes = draw::common_vertex_t::POSITION_VERTEX;
+
+            if (prim.pUvs)
+            {
+                vertTypes |= draw::common_vertex_t::TEXTURE_VERTEX;
+            }
+
+            if (prim.pNormals)
+            {
+                vertTypes |= draw::common_vertex_t::NORMAL_VERTEX;
+            }
+
+            if (prim.pTangents)
+            {
+                vertTypes |= draw::common_vertex_t::TANGENT_VERTEX | draw::common_vertex_t::BITANGENT_VERTEX;
+            }
+
+            if (prim.pColors)
+            {
+                vertTypes |= draw::common_vertex_t::COLOR_VERTEX;
+            }
+
+            if (prim.pJoints)
+            {
+                vertTypes |= draw::common_vertex_t::BONE_VERTEX;
+            }
+
+            prim.vertType = draw::get_packed_vertex_types((draw::common_vertex_t)vertTypes, packedVertTypes);
+
+            // Morph targets
+            const GLTFJson& inTargets = inPrim["targets"];
+            const size_t numTargets = math::min<size_t>(inTargets.size(), draw::morph_property_t::MORPH_MAX_TARGETS);
+
+            if (inTargets.size() > numTargets)
+            {
+                LS_LOG_ERR("\t\tWarning: glTF mesh ", m, " contains ", inTargets.size(), " morph targets. Only the first ", numTargets, " will be imported.");
+            }
+
+            prim.targetPositions.resize(numTargets, nullptr);
+            prim.targetNormals.resize(numTargets, nullptr);
+
+            for (size_t t = 0; t < numTargets; ++t)
+            {
+                if (!find_gltf_accessor(doc, inTargets[t]["POSITION"], prim.targetPositions[t])
+                || !find_gltf_accessor(doc, inTargets[t]["NORMAL"], prim.targetNormals[t])
+                || !isUsable(prim.targetPositions[t], 3)
+                || !isUsable(prim.targetNormals[t], 3)
+                ) {
+                    LS_LOG_MSG("\tglTF mesh ", m, " contains morph targets which can not be imported natively.");
+                    return false;
+                }
+            }
+        }
+    }
+
+    outMeshOffsets.push_back(numPrims);
+
+    return true;
+}
+
+
+
+/*-------------------------------------
+ * Import a single texture reference of a material
+-------------------------------------*/
+void import_gltf_texture(
+    const GLTFDocument& doc,
+    const GLTFJson& texInfo,
+    const std::string& baseFileDir,
+    std::unordered_map<std::string, size_t>& texturePaths,
+    std::vector<std::pair<std::string, draw::tex_wrap_t>>& pendingTextures,
+    draw::SceneMaterial& outMaterial,
+    unsigned& texSlot
+) noexcept
+{
+    if (!texInfo.is_valid())
+    {
+        return;
+    }
+
+    const GLTFJson& inTexture = doc.json["textures"][texInfo["index"].as_index()];
+    const GLTFJson& inImage = doc.json["images"][inTexture["source"].as_index()];
+    const GLTFJson& inSampler = doc.json["samplers"][inTexture["sampler"].as_index()];
+    const std::string& uri = inImage["uri"].as_string();
+
+    // Images stored within buffers or data URIs can not be decoded by the
+    // texture loader.
+    if (uri.empty() || uri.compare(0, 5, "data:") == 0)
+    {
+        LS_LOG_ERR("\t\tWarning: Embedded glTF images are not supported. A texture will be skipped.");
+        return;
+    }
+
+    const std::string texPath{baseFileDir + decode_gltf_uri(uri)};
+    const std::unordered_map<std::string, size_t>::const_iterator iter = texturePaths.find(texPath);
+    size_t texIndex;
+
+    if (iter != texturePaths.cend())
+    {
+        LS_LOG_MSG("\t\t\tDuplicate texture detected: ", texPath);
+        texIndex = iter->second;
+    }
+    else
+    {
+        texIndex = pendingTextures.size();
+        texturePaths[texPath] = texIndex;
+        pendingTextures.emplace_back(texPath, convert_gltf_tex_wrapping(inSampler["wrapS"].as_index(GLTF_WRAP_REPEAT)));
+    }
+
+    if (texSlot >= draw::active_texture_t::MAX_ACTIVE_TEXTURES)
+    {
+        LS_LOG_ERR("\t\t\tWarning: Texture ", texPath, " may not be used at this time. Too many texture slots have been used already.");
+    }
+    else
+    {
+        outMaterial.bindSlots[texSlot] = draw::tex_slot_t::TEXTURE_SLOT_GPU_OFFSET + texSlot;
+        outMaterial.textures[texSlot] = (GLuint)texIndex;
+    }
+
+    ++texSlot;
+}
+
+
+
+/*-------------------------------------
+ * Import all materials
+-------------------------------------*/
+void import_gltf_materials(
+    const GLTFDocument& doc,
+    const std::string& baseFileDir,
+    const bool needsDefaultMaterial,
+    std::vector<draw::SceneMaterial>& outMaterials,
+    std::unordered_map<std::string, size_t>& texturePaths,
+    std::vector<std::pair<std::string, draw::tex_wrap_t>>& pendingTextures
+) noexcept
+{
+    const GLTFJson& inMaterials = doc.json["materials"];
+    const size_t numMaterials = inMaterials.size();
+
+    LS_LOG_MSG("\tImporting ", numMaterials, " materials from the glTF file.");
+
+    // Primitives without a material use a default one, placed after all
+    // others.
+    outMaterials.resize(numMaterials + (needsDefaultMaterial ? 1 : 0));
+    texturePaths.reserve(numMaterials);
+
+    for (size_t i = 0; i < outMaterials.size(); ++i)
+    {
+        draw::SceneMaterial& outMaterial = outMaterials[i];
+        outMaterial.reset();
+        utils::fast_fill(outMaterial.textures, (GLuint)draw::material_property_t::INVALID_MATERIAL_TEXTURE, draw::active_texture_t::MAX_ACTIVE_TEXTURES);
+
+        if (i >= numMaterials)
+        {
+            continue;
+        }
+
+        // Textures occupy the same slots as those imported through Assimp.
+        const GLTFJson& inMaterial = inMaterials[i];
+        const GLTFJson& inPbr = inMaterial["pbrMetallicRoughness"];
+        unsigned texSlot = 0;
+
+        import_gltf_texture(doc, inPbr["baseColorTexture"], baseFileDir, texturePaths, pendingTextures, outMaterial, texSlot);
+        import_gltf_texture(doc, inMaterial["emissiveTexture"], baseFileDir, texturePaths, pendingTextures, outMaterial, texSlot);
+        import_gltf_texture(doc, inMaterial["normalTexture"], baseFileDir, texturePaths, pendingTextures, outMaterial, texSlot);
+        import_gltf_texture(doc, inMaterial["occlusionTexture"], baseFileDir, texturePaths, pendingTextures, outMaterial, texSlot);
+        import_gltf_texture(doc, inPbr["metallicRoughnessTexture"], baseFileDir, texturePaths, pendingTextures, outMaterial, texSlot);
+    }
+
+    LS_LOG_MSG("\t\tDone.");
+}
+
+
+
+/*-------------------------------------
+ * Determine if a primitive's vertices already match the interleaved layout
+ * of its VAO.
+ *
+ * Returns a pointer to the first vertex if they can be uploaded directly,
+ * or NULL if they must be converted.
+-------------------------------------*/
+const char* get_gltf_direct_vertices(const GLTFPrimitive& prim, const unsigned vertStride) noexcept
+{
+    const draw::common_vertex_t vertType = prim.vertType;
+    const GLTFAccessor* pFirst = nullptr;
+    const char* pBase = nullptr;
+
+    for (unsigned i = 0; i < draw::COMMON_VERTEX_FLAGS_COUNT; ++i)
+    {
+        const draw::common_vertex_t flag = draw::COMMON_VERTEX_FLAGS_LIST[i];
+        const GLTFAccessor* pAttrib;
+        unsigned componentType;
+        unsigned numComponents;
+        bool normalized;
+
+        if (!(vertType & flag))
+        {
+            continue;
+        }
+
+        // Only attributes which are stored without conversion can match.
+        switch (flag)
+        {
+            case draw::common_vertex_t::POSITION_VERTEX:
+                pAttrib = prim.pPositions;
+                componentType = GLTF_COMPONENT_FLOAT;
+                numComponents = 3;
+                normalized = false;
+                break;
+
+            case draw::common_vertex_t::COLOR_VERTEX:
+                pAttrib = prim.pColors;
+                componentType = GLTF_COMPONENT_FLOAT;
+                numComponents = 4;
+                normalized = false;
+                break;
+
+            case draw::common_vertex_t::PACKED_COLOR_VERTEX:
+                pAttrib = prim.pColors;
+                componentType = GLTF_COMPONENT_UBYTE;
+                numComponents = 4;
+                normalized = true;
+                break;
+
+            case draw::common_vertex_t::BONE_ID_VERTEX:
+                pAttrib = prim.pJoints;
+                componentType = GLTF_COMPONENT_UBYTE;
+                numComponents = 4;
+                normalized = false;
+                break;
+
+            case draw::common_vertex_t::BONE_WEIGHT_VERTEX:
+                pAttrib = prim.pWeights;
+                componentType = GLTF_COMPONENT_UBYTE;
+                numComponents = 4;
+                normalized = true;
+                break;
+
+            default:
+                return nullptr;
+        }
+
+        if (pAttrib->componentType != componentType
+        || pAttrib->numComponents != numComponents
+        || pAttrib->normalized != normalized
+        || pAttrib->stride != vertStride
+        ) {
+            return nullptr;
+        }
+
+        // Every attribute must be interleaved within the same buffer view at
+        // the same offsets as the VAO.
+        const unsigned attribOffset = draw::get_vertex_attrib_offset(vertType, flag);
+
+        if (!pFirst)
+        {
+            if ((size_t)(pAttrib->pData - pAttrib->pView) < attribOffset)
+            {
+                return nullptr;
+            }
+
+            pFirst = pAttrib;
+            pBase = pAttrib->pData - attribOffset;
+        }
+        else if (pAttrib->pView != pFirst->pView || pAttrib->pData - attribOffset != pBase)
+        {
+            return nullptr;
+        }
+    }
+
+    if (!pFirst || !pFirst->count || (size_t)(pBase - pFirst->pView) + pFirst->count * vertStride > pFirst->viewBytes)
+    {
+        return nullptr;
+    }
+
+    // Quantized weights must already sum to 255.
+    if (vertType & draw::common_vertex_t::BONE_WEIGHT_VERTEX)
+    {
+        for (size_t v = 0; v < prim.pWeights->count; ++v)
+        {
+            const unsigned char* const pWeights = reinterpret_cast<const unsigned char*>(prim.pWeights->pData + v * vertStride);
+            const unsigned weightSum = (unsigned)pWeights[0] + pWeights[1] + pWeights[2] + pWeights[3];
+
+            if (weightSum != 255 && weightSum != 0)
+            {
+                return nullptr;
+            }
+        }
+    }
+
+    return pBase;
+}
+
+
+
+/*-------------------------------------
+ * Determine if a primitive's indices can be uploaded directly
+-------------------------------------*/
+draw::index_element_t get_gltf_direct_index_type(const GLTFPrimitive& prim, const unsigned numVerts, const bool baseVertexDraws) noexcept
+{
+    #if defined(LS_DRAW_BASE_VERTEX_SUPPORTED)
+        const GLTFAccessor* const pIndices = prim.pIndices;
+        draw::index_element_t indexType;
+
+        // Indices must be offset by the location of each mesh within its
+        // VAO unless base-vertex draws are used.
+        if (!baseVertexDraws || !pIndices || !pIndices->count)
+        {
+            return draw::index_element_t::INDEX_TYPE_NONE;
+        }
+
+        switch (pIndices->componentType)
+        {
+            case GLTF_COMPONENT_USHORT:
+                indexType = draw::index_element_t::INDEX_TYPE_USHORT;
+                break;
+
+            case GLTF_COMPONENT_UINT:
+                indexType = draw::index_element_t::INDEX_TYPE_UINT;
+                break;
+
+            default:
+                return draw::index_element_t::INDEX_TYPE_NONE;
+        }
+
+        if (pIndices->stride != get_gltf_component_bytes(pIndices->componentType)
+        || draw::get_index_byte_size(indexType) < draw::get_index_byte_size(get_mesh_index_type(0, numVerts, true))
+        ) {
+            return draw::index_element_t::INDEX_TYPE_NONE;
+        }
+
+        for (size_t i = 0; i < pIndices->count; ++i)
+        {
+            if (read_gltf_uint(pIndices->pData + i * pIndices->stride, pIndices->componentType) >= numVerts)
+            {
+                return draw::index_element_t::INDEX_TYPE_NONE;
+            }
+        }
+
+        return indexType;
+
+    #else
+        // Indices must be offset by the location of each mesh within its
+        // VAO.
+        (void)prim;
+        (void)numVerts;
+        (void)baseVertexDraws;
+        return draw::index_element_t::INDEX_TYPE_NONE;
+    #endif
+}
+
+
+
+/*-------------------------------------
+ * Convert the vertices of a primitive into the interleaved layout of its VAO
+-------------------------------------*/
+void convert_gltf_vertices(
+    const GLTFPrimitive& prim,
+    const std::vector<math::vec3>& positions,
+    char* const pVerts,
+    const unsigned vertStride
+) noexcept
+{
+    const draw::common_vertex_t vertType = prim.vertType;
+    const unsigned numVerts = (unsigned)positions.size();
+    const math::vec3& dequantScale = prim.dequantScale;
+
+    // Flat axes quantize to 0 and are restored entirely by the bias.
+    const math::vec3 invScale{
+        dequantScale[0] > 0.f ? (1.f / dequantScale[0]) : 0.f,
+        dequantScale[1] > 0.f ? (1.f / dequantScale[1]) : 0.f,
+        dequantScale[2] > 0.f ? (1.f / dequantScale[2]) : 0.f
+    };
+
+    // glTF places the origin of a texture at its top-left corner.
+    const auto readUv = [&](const unsigned v) -> math::vec2
+    {
+        float uv[2] = {0.f, 0.f};
+        read_gltf_floats(*prim.pUvs, v, uv, 2);
+        return math::vec2{uv[0], 1.f - uv[1]};
+    };
+
+    const auto readBitangent = [&](const unsigned v) -> math::vec3
+    {
+        const math::vec3&& n = read_gltf_vec3(*prim.pNormals, v);
+        const math::vec4&& t = read_gltf_vec4(*prim.pTangents, v, 1.f);
+        return math::cross(n, math::vec3{t[0], t[1], t[2]}) * t[3];
+    };
+
+    // Joints which exceed the number of bones a skin can hold are dropped
+    // along with their weights.
+    const auto readBones = [&](const unsigned v, math::vec4_t<uint8_t>& outIds, math::vec4& outWeights) -> void
+    {
+        const char* const pJoint = prim.pJoints->pData + v * prim.pJoints->stride;
+        const unsigned jointBytes = get_gltf_component_bytes(prim.pJoints->componentType);
+
+        outWeights = read_gltf_vec4(*prim.pWeights, v, 0.f);
+
+        for (unsigned i = 0; i < 4; ++i)
+        {
+            const uint32_t jointId = read_gltf_uint(pJoint + i * jointBytes, prim.pJoints->componentType);
+            const bool isValid = jointId < draw::skin_property_t::SKIN_MAX_BONES;
+
+            outIds[i] = isValid ? (uint8_t)jointId : (uint8_t)0;
+            outWeights[i] = isValid ? outWeights[i] : 0.f;
+        }
+    };
+
+    for (unsigned i = 0; i < draw::COMMON_VERTEX_FLAGS_COUNT; ++i)
+    {
+        const draw::common_vertex_t flag = draw::COMMON_VERTEX_FLAGS_LIST[i];
+
+        if (!(vertType & flag))
+        {
+            continue;
+        }
+
+        char* pVbo = pVerts + draw::get_vertex_attrib_offset(vertType, flag);
+        math::vec4_t<uint8_t> boneIds;
+        math::vec4 boneWeights;
+
+        for (unsigned v = 0; v < numVerts; ++v, pVbo += vertStride)
+        {
+            switch (flag)
+            {
+                case draw::common_vertex_t::POSITION_VERTEX:
+                    write_gltf_vertex(pVbo, positions[v]);
+                    break;
+
+                case draw::common_vertex_t::PACKED_POSITION_VERTEX:
+                    write_gltf_vertex(pVbo, draw::pack_vertex_position(positions[v], prim.dequantBias, invScale));
+                    break;
+
+                case draw::common_vertex_t::TEXTURE_VERTEX:
+                    write_gltf_vertex(pVbo, readUv(v));
+                    break;
+
+                case draw::common_vertex_t::PACKED_TEXTURE_VERTEX:
+                {
+                    const math::vec2&& uv = readUv(v);
+                    write_gltf_vertex(pVbo, math::vec2_t<uint16_t>{draw::pack_vertex_half(uv[0]), draw::pack_vertex_half(uv[1])});
+                    break;
+                }
+
+                case draw::common_vertex_t::COLOR_VERTEX:
+                    write_gltf_vertex(pVbo, read_gltf_vec4(*prim.pColors, v, 1.f));
+                    break;
+
+                case draw::common_vertex_t::PACKED_COLOR_VERTEX:
+                    write_gltf_vertex(pVbo, draw::pack_vertex_color(read_gltf_vec4(*prim.pColors, v, 1.f)));
+                    break;
+
+                case draw::common_vertex_t::NORMAL_VERTEX:
+                    write_gltf_vertex(pVbo, draw::pack_vertex_normal(read_gltf_vec3(*prim.pNormals, v)));
+                    break;
+
+                case draw::common_vertex_t::PACKED_NORMAL_VERTEX:
+                    write_gltf_vertex(pVbo, draw::pack_vertex_octahedral(read_gltf_vec3(*prim.pNormals, v)));
+                    break;
+
+                case draw::common_vertex_t::TANGENT_VERTEX:
+                    write_gltf_vertex(pVbo, draw::pack_vertex_normal(read_gltf_vec3(*prim.pTangents, v)));
+                    break;
+
+                case draw::common_vertex_t::PACKED_TANGENT_VERTEX:
+                    write_gltf_vertex(pVbo, draw::pack_vertex_octahedral(read_gltf_vec3(*prim.pTangents, v)));
+                    break;
+
+                case draw::common_vertex_t::BITANGENT_VERTEX:
+                    write_gltf_vertex(pVbo, draw::pack_vertex_normal(readBitangent(v)));
+                    break;
+
+                case draw::common_vertex_t::PACKED_BITANGENT_VERTEX:
+                    write_gltf_vertex(pVbo, draw::pack_vertex_octahedral(readBitangent(v)));
+                    break;
+
+                case draw::common_vertex_t::BONE_ID_VERTEX:
+                    readBones(v, boneIds, boneWeights);
+                    write_gltf_vertex(pVbo, boneIds);
+                    break;
+
+                case draw::common_vertex_t::BONE_WEIGHT_VERTEX:
+                    readBones(v, boneIds, boneWeights);
+                    write_gltf_vertex(pVbo, draw::pack_vertex_bone_weights(boneWeights));
+                    break;
+
+                default:
+                    LS_DEBUG_ASSERT(false);
+                    break;
+            }
+        }
+    }
+}
+
+
+
+/*-------------------------------------
+ * Import the sparse morph targets of a primitive
+-------------------------------------*/
+void import_gltf_morphs(const GLTFPrimitive& prim, const unsigned numVerts, draw::SceneMorph& outMorph) noexcept
+{
+    // Squared length which a delta must exceed in order to be stored.
+    constexpr float minDeltaLength = 1.e-12f;
+
+    const unsigned numTargets = (unsigned)prim.targetPositions.size();
+    const GLTFJson& inMesh = *prim.pMesh;
+    const GLTFJson& inNames = inMesh["extras"]["targetNames"];
+    const GLTFJson& inWeights = inMesh["weights"];
+
+    outMorph.reset();
+
+    if (!numTargets)
+    {
+        return;
+    }
+
+    outMorph.numVerts = numVerts;
+    outMorph.vertOffsets.reserve(numVerts + 1);
+    outMorph.targetNames.reserve(numTargets);
+    outMorph.weights.reserve(numTargets);
+
+    for (unsigned t = 0; t < numTargets; ++t)
+    {
+        outMorph.targetNames.emplace_back(inNames[t].as_string());
+        outMorph.weights.push_back((float)inWeights[t].as_number(0.0));
+    }
+
+    // glTF already stores deltas. Only those which modify a vertex are kept.
+    for (unsigned v = 0; v < numVerts; ++v)
+    {
+        outMorph.vertOffsets.push_back((unsigned)outMorph.deltas.size());
+
+        for (unsigned t = 0; t < numTargets; ++t)
+        {
+            const GLTFAccessor* const pPositions = prim.targetPositions[t];
+            const GLTFAccessor* const pNormals = prim.pNormals ? prim.targetNormals[t] : nullptr;
+            draw::SceneMorphDelta delta;
+
+            delta.position = pPositions ? read_gltf_vec3(*pPositions, v) : math::vec3{0.f, 0.f, 0.f};
+            delta.normal = pNormals ? read_gltf_vec3(*pNormals, v) : math::vec3{0.f, 0.f, 0.f};
+            delta.targetId = t;
+
+            if (math::dot(delta.position, delta.position) > minDeltaLength
+            || math::dot(delta.normal, delta.normal) > minDeltaLength)
+            {
+                outMorph.deltas.push_back(delta);
+            }
+        }
+    }
+
+    outMorph.vertOffsets.push_back((unsigned)outMorph.deltas.size());
+}
+
+
+
+/*-------------------------------------
+ * Convert a single primitive
+-------------------------------------*/
+void convert_gltf_primitive(
+    const size_t primId,
+    GLTFPrimitive& prim,
+    std::vector<math::vec3>& positions,
+    std::vector<uint32_t>& remap,
+    std::vector<char>& scratchVerts,
+    const bool baseVertexDraws
+) noexcept
+{
+    const GLTFAccessor& inPositions = *prim.pPositions;
+    const unsigned vertStride = draw::get_vertex_byte_size(prim.vertType);
+    unsigned numVerts = (unsigned)inPositions.count;
+
+    positions.resize(numVerts);
+
+    for (unsigned v = 0; v < numVerts; ++v)
+    {
+        positions[v] = read_gltf_vec3(inPositions, v);
+    }
+
+    // Object-space bounds and the dequantization range share the same
+    // extents.
+    if (numVerts)
+    {
+        prim.bounds.set_top_rear_right(positions[0]);
+        prim.bounds.set_bot_front_left(positions[0]);
+
+        math::vec3 minPos = positions[0];
+        math::vec3 maxPos = positions[0];
+
+        for (unsigned v = 1; v < numVerts; ++v)
+        {
+            const math::vec3& p = positions[v];
+            prim.bounds.compare_and_update(p);
+
+            minPos = math::vec3{math::min(minPos[0], p[0]), math::min(minPos[1], p[1]), math::min(minPos[2], p[2])};
+            maxPos = math::vec3{math::max(maxPos[0], p[0]), math::max(maxPos[1], p[1]), math::max(maxPos[2], p[2])};
+        }
+
+        if (prim.vertType & draw::common_vertex_t::PACKED_POSITION_VERTEX)
+        {
+            prim.dequantScale = maxPos - minPos;
+            prim.dequantBias = minPos;
+        }
+    }
+    else
+    {
+        prim.bounds.reset_size();
+    }
+
+    // Vertices and indices are uploaded directly from the mapped file when
+    // their layout already matches. All others are converted.
+    const char* const pDirectVerts = get_gltf_direct_vertices(prim, vertStride);
+    const draw::index_element_t directIndexType = get_gltf_direct_index_type(prim, numVerts, baseVertexDraws);
+    const bool hasMorphs = !prim.targetPositions.empty();
+
+    prim.stats = draw::MeshOptimizerStats{numVerts, 0, 0.f, 0.f, 0.f, 0.f};
+
+    if (!pDirectVerts)
+    {
+        prim.vertices.resize((size_t)numVerts * vertStride);
+        convert_gltf_vertices(prim, positions, prim.vertices.data(), vertStride);
+    }
+
+    if (directIndexType != draw::index_element_t::INDEX_TYPE_NONE)
+    {
+        prim.pIndexData = prim.pIndices->pData;
+        prim.indexType = directIndexType;
+        prim.numIndices = (unsigned)prim.pIndices->count;
+    }
+    else
+    {
+        if (prim.pIndices)
+        {
+            const GLTFAccessor& inIndices = *prim.pIndices;
+            prim.indices.resize(inIndices.count);
+
+            for (size_t i = 0; i < inIndices.count; ++i)
+            {
+                const uint32_t index = read_gltf_uint(inIndices.pData + i * inIndices.stride, inIndices.componentType);
+
+                if (index >= numVerts)
+                {
+                    LS_LOG_ERR("\t\tError: glTF primitive ", primId, " references a vertex which does not exist.");
+                    return;
+                }
+
+                prim.indices[i] = index;
+            }
+        }
+        else
+        {
+            // Non-indexed primitives are drawn with sequential indices so
+            // every mesh in a scene can share the same draw function.
+            prim.indices.resize(numVerts);
+
+            for (unsigned i = 0; i < numVerts; ++i)
+            {
+                prim.indices[i] = i;
+            }
+        }
+
+        prim.numIndices = (unsigned)prim.indices.size();
+
+        // Morph targets reference vertices by their original index, as do
+        // vertices read directly from the file.
+        if (!pDirectVerts && !hasMorphs && numVerts)
+        {
+            const uint32_t numUnique = draw::weld_vertices(prim.vertices.data(), vertStride, numVerts, remap);
+
+            if (numUnique < numVerts)
+            {
+                char* const pVerts = prim.vertices.data();
+
+                for (uint32_t v = 0; v < numVerts; ++v)
+                {
+                    if (remap[v] != v)
+                    {
+                        std::memcpy(pVerts + (size_t)remap[v] * vertStride, pVerts + (size_t)v * vertStride, vertStride);
+                        positions[remap[v]] = positions[v];
+                    }
+                }
+
+                for (uint32_t& index : prim.indices)
+                {
+                    index = remap[index];
+                }
+
+                LS_LOG_MSG("\t\tWelded ", numVerts - numUnique, " vertices in glTF primitive ", primId, '.');
+
+                numVerts = numUnique;
+                prim.vertices.resize((size_t)numVerts * vertStride);
+                positions.resize(numVerts);
+            }
+        }
+
+        if (prim.drawMode == draw::draw_mode_t::DRAW_MODE_TRIS && prim.numIndices && prim.numIndices % 3 == 0)
+        {
+            remap.clear();
+
+            prim.stats = draw::optimize_mesh(
+                prim.indices.data(), prim.indices.size(),
+                &positions[0][0], sizeof(math::vec3),
+                numVerts,
+                remap,
+                !pDirectVerts && !hasMorphs
+            );
+
+            if (!remap.empty())
+            {
+                scratchVerts.resize(prim.vertices.size());
+                draw::remap_vertices(prim.vertices.data(), scratchVerts.data(), vertStride, remap);
+                prim.vertices.swap(scratchVerts);
+            }
+
+            LS_LOG_MSG(
+                "\t\tOptimized glTF primitive ", primId, " (", prim.stats.numTriangles, " triangles):",
+                " ACMR ", prim.stats.acmrBefore, " -> ", prim.stats.acmrAfter,
+                ", ATVR ", prim.stats.atvrBefore, " -> ", prim.stats.atvrAfter
+            );
+        }
+    }
+
+    import_gltf_morphs(prim, numVerts, prim.morph);
+
+    prim.numVerts = numVerts;
+    prim.pVertData = pDirectVerts ? pDirectVerts : prim.vertices.data();
+    prim.isValid = true;
+}
+
+
+
+/*-------------------------------------
+ * Convert primitives until none remain
+-------------------------------------*/
+void convert_gltf_primitives(std::vector<GLTFPrimitive>& prims, std::atomic_uint& nextPrimId, const bool baseVertexDraws) noexcept
+{
+    std::vector<math::vec3> positions;
+    std::vector<uint32_t> remap;
+    std::vector<char> scratchVerts;
+
+    // Each primitive only writes to its own data, so no further
+    // synchronization is needed.
+    for (unsigned primId = nextPrimId.fetch_add(1); primId < prims.size(); primId = nextPrimId.fetch_add(1))
+    {
+        convert_gltf_primitive(primId, prims[primId], positions, remap, scratchVerts, baseVertexDraws);
+    }
+}
+
+
+
+/*-------------------------------------
+ * Append an upload range, merging it with the previous range if both are
+ * contiguous in memory and within the GPU buffer.
+-------------------------------------*/
+void add_gltf_upload_range(std::vector<draw::SceneUploadRange>& ranges, const draw::SceneUploadRange& range) noexcept
+{
+    if (!range.numBytes)
+    {
+        return;
+    }
+
+    if (!ranges.empty())
+    {
+        draw::SceneUploadRange& prev = ranges.back();
+
+        if (prev.isIndexData == range.isIndexData
+        && prev.pData + prev.numBytes == range.pData
+        && prev.offset + prev.numBytes == range.offset
+        ) {
+            prev.numBytes += range.numBytes;
+            return;
+        }
+    }
+
+    ranges.push_back(range);
+}
+
+
+
+/*-------------------------------------
+ * Add a node to the scene graph
+-------------------------------------*/
+draw::SceneNode& add_gltf_scene_node(draw::SceneGraph& sceneData, const std::string& name, draw::Transform baseTrans) noexcept
+{
+    std::vector<draw::SceneNode>& nodeList = sceneData.nodes;
+
+    nodeList.emplace_back(draw::SceneNode());
+    draw::SceneNode& currentNode = nodeList.back();
+
+    currentNode.reset();
+    currentNode.nodeId = nodeList.size() - 1;
+    currentNode.type = draw::scene_node_t::NODE_TYPE_EMPTY;
+
+    sceneData.nodeNames.push_back(sceneData.nameTable.intern(name));
+
+    // Store the transform as specified by the scene graph hierarchy, then
+    // the original, unmodified, unparented transform.
+    sceneData.currentTransforms.push_back(baseTrans);
+
+    baseTrans.apply_transform();
+    sceneData.baseTransforms.push_back(baseTrans.get_transform());
+
+    return currentNode;
+}
+
+
+
+/*-------------------------------------
+ * Apply the parent transform of the most recently added node
+-------------------------------------*/
+void parent_gltf_scene_node(draw::SceneGraph& sceneData, const size_t parentId) noexcept
+{
+    draw::Transform& nodeTransform = sceneData.currentTransforms.back();
+    nodeTransform.parentId = parentId;
+
+    if (parentId != draw::scene_property_t::SCENE_GRAPH_ROOT_ID)
+    {
+        nodeTransform.apply_pre_transform(sceneData.currentTransforms[parentId].get_transform());
+    }
+
+    sceneData.modelMatrices.push_back(nodeTransform.get_transform());
+}
+
+
+
+/*-------------------------------------
+ * Import a camera node
+-------------------------------------*/
+void import_gltf_camera(
+    const GLTFJson& inCam,
+    const char* camName,
+    draw::SceneGraph& sceneData,
+    draw::SceneNode& outNode
+) noexcept
+{
+    std::vector<draw::Camera>& camList = sceneData.cameras;
+
+    outNode.type = draw::scene_node_t::NODE_TYPE_CAMERA;
+    outNode.dataId = camList.size();
+
+    camList.emplace_back(draw::Camera{});
+    draw::Camera& outCam = camList.back();
+
+    if (inCam["type"].as_string() == "orthographic")
+    {
+        const GLTFJson& inOrtho = inCam["orthographic"];
+        const float xMag = (float)inOrtho["xmag"].as_number(1.0);
+        const float yMag = (float)inOrtho["ymag"].as_number(1.0);
+
+        outCam.set_aspect_ratio(yMag != 0.f ? (xMag / yMag) : 1.f, 1.f);
+        outCam.set_near_plane((float)inOrtho["znear"].as_number(draw::Camera::DEFAULT_Z_NEAR));
+        outCam.set_far_plane((float)inOrtho["zfar"].as_number(draw::Camera::DEFAULT_Z_FAR));
+        outCam.set_projection_type(draw::projection_type_t::PROJECTION_ORTHOGONAL);
+    }
+    else
+    {
+        // glTF specifies a vertical field of view. An infinite far plane is
+        // replaced by the default depth range.
+        const GLTFJson& inPersp = inCam["perspective"];
+        const float aspect = (float)inPersp["aspectRatio"].as_number(1.0);
+        const float yFov = (float)inPersp["yfov"].as_number(draw::Camera::DEFAULT_VIEW_ANGLE);
+        const float xFov = 2.f * std::atan(aspect * std::tan(0.5f * yFov));
+
+        outCam.set_fov(xFov);
+        outCam.set_aspect_ratio(aspect, 1.f);
+        outCam.set_near_plane((float)inPersp["znear"].as_number(draw::Camera::DEFAULT_Z_NEAR));
+        outCam.set_far_plane((float)inPersp["zfar"].as_number(draw::Camera::DEFAULT_Z_FAR));
+        outCam.set_projection_type(draw::projection_type_t::PROJECTION_PERSPECTIVE);
+    }
+
+    outCam.update();
+
+    // glTF cameras look down their local -Z axis.
+    draw::Transform& camTrans = sceneData.currentTransforms.back();
+    const math::mat4& inMat = sceneData.baseTransforms.back();
+    const math::vec3 camPos{inMat[3][0], inMat[3][1], inMat[3][2]};
+    const math::vec3 camDir{inMat[2][0], inMat[2][1], inMat[2][2]};
+    const math::vec3 camUp{inMat[1][0], inMat[1][1], inMat[1][2]};
+
+    camTrans.set_type(draw::transform_type_t::TRANSFORM_TYPE_VIEW_FPS);
+    camTrans.look_at(camPos, camPos - camDir, camUp);
+
+    LS_LOG_MSG("\tLoaded the scene camera ", camName, ':',
+               "\n\t\tField of View: ", LS_RAD2DEG(outCam.get_fov()),
+               "\n\t\tAspect Ratio:  ", outCam.get_aspect_ratio(),
+               "\n\t\tNear Plane:    ", outCam.get_near_plane(),
+               "\n\t\tFar Plane:     ", outCam.get_far_plane(),
+               "\n\t\tPosition:      {", camPos[0], ", ", camPos[1], ", ", camPos[2], '}',
+               "\n\t\tUp Direction:  {", camUp[0], ", ", camUp[1], ", ", camUp[2], '}'
+    );
+}
+
+
+
+/*-------------------------------------
+ * Read and import a node and all of its children
+-------------------------------------*/
+void import_gltf_node(
+    const GLTFDocument& doc,
+    const std::vector<size_t>& meshOffsets,
+    const size_t gltfNodeId,
+    const size_t parentId,
+    std::vector<size_t>& nodeIds,
+    draw::SceneGraph& sceneData
+) noexcept
+{
+    const GLTFJson& inNode = doc.json["nodes"][gltfNodeId];
+
+    // glTF nodes may only have a single parent. This also guards against
+    // cyclic hierarchies.
+    if (gltfNodeId >= nodeIds.size() || nodeIds[gltfNodeId] != draw::scene_property_t::SCENE_GRAPH_ROOT_ID)
+    {
+        LS_LOG_ERR("\t\tWarning: glTF node ", gltfNodeId, " is invalid or has already been imported.");
+        return;
+    }
+
+    // Node transformation. This is also needed for camera nodes to be
+    // imported properly.
+    draw::Transform baseTrans;
+    const GLTFJson& inMatrix = inNode["matrix"];
+
+    if (inMatrix.size() == 16)
+    {
+        float m[16];
+
+        for (unsigned i = 0; i < 16; ++i)
+        {
+            m[i] = (float)inMatrix[i].as_number(0.0);
+        }
+
+        // glTF matrices are column-major.
+        baseTrans.extract_transforms(math::mat4{
+            m[0],  m[1],  m[2],  m[3],
+            m[4],  m[5],  m[6],  m[7],
+            m[8],  m[9],  m[10], m[11],
+            m[12], m[13], m[14], m[15]
+        });
+    }
+    else
+    {
+        const GLTFJson& inPos = inNode["translation"];
+        const GLTFJson& inScale = inNode["scale"];
+        const GLTFJson& inRotation = inNode["rotation"];
+
+        baseTrans.set_position(math::vec3{
+            (float)inPos[0].as_number(0.0),
+            (float)inPos[1].as_number(0.0),
+            (float)inPos[2].as_number(0.0)
+        });
+
+        baseTrans.set_scale(math::vec3{
+            (float)inScale[0].as_number(1.0),
+            (float)inScale[1].as_number(1.0),
+            (float)inScale[2].as_number(1.0)
+        });
+
+        baseTrans.set_orientation(math::quat{
+            (float)inRotation[0].as_number(0.0),
+            (float)inRotation[1].as_number(0.0),
+            (float)inRotation[2].as_number(0.0),
+            (float)inRotation[3].as_number(1.0)
+        });
+    }
+
+    const GLTFJson& inName = inNode["name"];
+    std::string nodeName = inName.is_valid() ? inName.as_string() : (std::string{"node_"} + std::to_string(gltfNodeId));
+    draw::SceneNode& currentNode = add_gltf_scene_node(sceneData, nodeName, baseTrans);
+    const size_t nodeId = currentNode.nodeId;
+
+    nodeIds[gltfNodeId] = nodeId;
+
+    const GLTFJson& inCam = doc.json["cameras"][inNode["camera"].as_index()];
+    const size_t meshId = inNode["mesh"].as_index();
+
+    if (inCam.is_valid())
+    {
+        import_gltf_camera(inCam, sceneData.get_node_name(nodeId), sceneData, currentNode);
+    }
+    else if (meshId + 1 < meshOffsets.size() && meshOffsets[meshId + 1] > meshOffsets[meshId])
+    {
+        const size_t firstMesh = meshOffsets[meshId];
+        const unsigned numMeshes = (unsigned)(meshOffsets[meshId + 1] - firstMesh);
+        utils::Pointer<draw::DrawCommandParams[]> drawParams{new draw::DrawCommandParams[numMeshes]};
+
+        for (unsigned i = 0; i < numMeshes; ++i)
+        {
+            drawParams[i] = sceneData.meshes[firstMesh + i].drawParams;
+        }
+
+        currentNode.type = draw::scene_node_t::NODE_TYPE_MESH;
+        currentNode.dataId = sceneData.nodeMeshes.size();
+
+        sceneData.nodeMeshCounts.push_back(numMeshes);
+        sceneData.nodeMeshes.emplace_back(std::move(drawParams));
+    }
+
+    parent_gltf_scene_node(sceneData, parentId);
+
+    // recursively load node children
+    const GLTFJson& inChildren = inNode["children"];
+
+    for (size_t i = 0; i < inChildren.size(); ++i)
+    {
+        import_gltf_node(doc, meshOffsets, inChildren[i].as_index(), nodeId, nodeIds, sceneData);
+    }
+}
+
+
+
+/*-------------------------------------
+ * Import the node hierarchy of the default scene
+-------------------------------------*/
+void import_gltf_nodes(
+    const GLTFDocument& doc,
+    const std::vector<size_t>& meshOffsets,
+    std::vector<size_t>& nodeIds,
+    draw::SceneGraph& sceneData
+) noexcept
+{
+    const GLTFJson& inNodes = doc.json["nodes"];
+    const GLTFJson& inScenes = doc.json["scenes"];
+    std::vector<size_t> rootIds;
+
+    nodeIds.assign(inNodes.size(), (size_t)draw::scene_property_t::SCENE_GRAPH_ROOT_ID);
+
+    if (inScenes.size())
+    {
+        const GLTFJson& inRoots = inScenes[doc.json["scene"].as_index(0)]["nodes"];
+
+        for (size_t i = 0; i < inRoots.size(); ++i)
+        {
+            rootIds.push_back(inRoots[i].as_index());
+        }
+    }
+    else
+    {
+        // Without a scene, every node which is not a child is a root.
+        std::vector<bool> isChild(inNodes.size(), false);
+
+        for (size_t i = 0; i < inNodes.size(); ++i)
+        {
+            const GLTFJson& inChildren = inNodes[i]["children"];
+
+            for (size_t c = 0; c < inChildren.size(); ++c)
+            {
+                const size_t childId = inChildren[c].as_index();
+
+                if (childId < isChild.size())
+                {
+                    isChild[childId] = true;
+                }
+            }
+        }
+
+        for (size_t i = 0; i < inNodes.size(); ++i)
+        {
+            if (!isChild[i])
+            {
+                rootIds.push_back(i);
+            }
+        }
+    }
+
+    sceneData.nodes.reserve(inNodes.size() + 1);
+    sceneData.baseTransforms.reserve(inNodes.size() + 1);
+    sceneData.currentTransforms.reserve(inNodes.size() + 1);
+    sceneData.modelMatrices.reserve(inNodes.size() + 1);
+    sceneData.nodeNames.reserve(inNodes.size() + 1);
+
+    // Multiple root nodes are placed under a single root, as Assimp does.
+    size_t parentId = draw::scene_property_t::SCENE_GRAPH_ROOT_ID;
+
+    if (rootIds.size() > 1)
+    {
+        parentId = add_gltf_scene_node(sceneData, std::string{"ROOT"}, draw::Transform{}).nodeId;
+        parent_gltf_scene_node(sceneData, draw::scene_property_t::SCENE_GRAPH_ROOT_ID);
+    }
+
+    for (const size_t rootId : rootIds)
+    {
+        import_gltf_node(doc, meshOffsets, rootId, parentId, nodeIds, sceneData);
+    }
+}
+
+
+
+/*-------------------------------------
+ * Import the skin of every skinned mesh node
+-------------------------------------*/
+void import_gltf_skins(
+    const GLTFDocument& doc,
+    const std::vector<size_t>& meshOffsets,
+    const std::vector<size_t>& nodeIds,
+    draw::SceneGraph& sceneData
+) noexcept
+{
+    const GLTFJson& inNodes = doc.json["nodes"];
+    const GLTFJson& inSkins = doc.json["skins"];
+    std::vector<draw::SceneSkin>& skins = sceneData.skins;
+
+    for (size_t n = 0; n < inNodes.size(); ++n)
+    {
+        const GLTFJson& inNode = inNodes[n];
+        const size_t meshId = inNode["mesh"].as_index();
+        const GLTFJson& inSkin = inSkins[inNode["skin"].as_index()];
+
+        if (!inSkin.is_valid() || meshId + 1 >= meshOffsets.size() || nodeIds[n] == draw::scene_property_t::SCENE_GRAPH_ROOT_ID)
+        {
+            continue;
+        }
+
+        const GLTFJson& inJoints = inSkin["joints"];
+        const unsigned numBones = (unsigned)math::min<size_t>(inJoints.size(), draw::skin_property_t::SKIN_MAX_BONES);
+        const GLTFAccessor* pBindPoses = nullptr;
+
+        if (!find_gltf_accessor(doc, inSkin["inverseBindMatrices"], pBindPoses)
+        || (pBindPoses && (pBindPoses->numComponents != 16 || pBindPoses->count < numBones))
+        ) {
+            LS_LOG_ERR("\t\tWarning: Unable to read the inverse bind matrices of the skin for node ", n, '.');
+            pBindPoses = nullptr;
+        }
+
+        // SceneMeshes only hold a single skin. Meshes which are instanced
+        // by multiple skinned nodes use the first skin.
+        for (size_t m = meshOffsets[meshId]; m < meshOffsets[meshId + 1]; ++m)
+        {
+            draw::SceneSkin& skin = skins[m];
+
+            if (!(sceneData.meshes[m].metaData.vertTypes & draw::common_vertex_t::BONE_ID_VERTEX) || !skin.boneIds.empty())
+            {
+                continue;
+            }
+
+            skin.reset();
+            skin.boneIds.reserve(numBones);
+            skin.inverseBindPoses.reserve(numBones);
+
+            // Bones are stored in the same order as the joint indices of
+            // each vertex.
+            for (unsigned b = 0; b < numBones; ++b)
+            {
+                const size_t jointId = inJoints[b].as_index();
+                const size_t boneId = jointId < nodeIds.size() ? nodeIds[jointId] : (size_t)draw::scene_property_t::SCENE_GRAPH_ROOT_ID;
+                math::mat4 bindPose{1.f};
+
+                if (boneId == draw::scene_property_t::SCENE_GRAPH_ROOT_ID)
+                {
+                    LS_LOG_ERR("\t\tWarning: Unable to locate the node for joint ", b, " of the skin for node ", n, '.');
+                }
+
+                if (pBindPoses)
+                {
+                    float m4[16];
+                    utils::fast_fill(m4, 0.f, 16);
+                    read_gltf_floats(*pBindPoses, b, m4, 16);
+
+                    bindPose = math::mat4{
+                        m4[0],  m4[1],  m4[2],  m4[3],
+                        m4[4],  m4[5],  m4[6],  m4[7],
+                        m4[8],  m4[9],  m4[10], m4[11],
+                        m4[12], m4[13], m4[14], m4[15]
+                    };
+                }
+
+                skin.boneIds.push_back(boneId);
+                skin.inverseBindPoses.push_back(bindPose);
+            }
+        }
+    }
+}
+
+
+
+/*-------------------------------------
+ * Animation samplers which target a single node
+-------------------------------------*/
+enum gltf_anim_path_t : unsigned
+{
+    GLTF_ANIM_PATH_TRANSLATION,
+    GLTF_ANIM_PATH_ROTATION,
+    GLTF_ANIM_PATH_SCALE,
+    GLTF_ANIM_PATH_WEIGHTS,
+    GLTF_ANIM_PATH_COUNT
+};
+
+struct GLTFAnimSampler
+{
+    const GLTFAccessor* pInput;
+
+    const GLTFAccessor* pOutput;
+
+    bool isStep;
+
+    bool isCubic;
+};
+
+struct GLTFNodeTracks
+{
+    size_t gltfNodeId;
+
+    GLTFAnimSampler samplers[GLTF_ANIM_PATH_COUNT];
+};
+
+
+
+/*-------------------------------------
+ * Read the time of a keyframe as a percentage of an animation
+-------------------------------------*/
+inline draw::anim_prec_t read_gltf_key_time(const GLTFAnimSampler& sampler, const size_t keyId, const float maxTime) noexcept
+{
+    float t = 0.f;
+    read_gltf_floats(*sampler.pInput, keyId, &t, 1);
+    return maxTime > 0.f ? (draw::anim_prec_t)(t / maxTime) : (draw::anim_prec_t)0;
+}
+
+
+
+/*-------------------------------------
+ * Read the output of a keyframe. Cubic splines store an in-tangent, value,
+ * and out-tangent for each key, of which only the value is used.
+-------------------------------------*/
+inline size_t get_gltf_key_index(const GLTFAnimSampler& sampler, const size_t keyId, const size_t numValues) noexcept
+{
+    return sampler.isCubic ? ((keyId * 3 + 1) * numValues) : (keyId * numValues);
+}
+
+
+
+/*-------------------------------------
+ * Import all animations
+-------------------------------------*/
+void import_gltf_animations(
+    const GLTFDocument& doc,
+    const std::vector<size_t>& meshOffsets,
+    const std::vector<size_t>& nodeIds,
+    draw::SceneGraph& sceneData
+) noexcept
+{
+    const GLTFJson& inAnims = doc.json["animations"];
+    const GLTFJson& inNodes = doc.json["nodes"];
+    const size_t totalAnimations = inAnims.size();
+    std::vector<draw::Animation>& animations = sceneData.animations;
+    std::vector<std::vector<draw::AnimationChannel>>& allChannels = sceneData.nodeAnims;
+    std::vector<GLTFNodeTracks> nodeTracks;
+
+    animations.reserve(totalAnimations);
+
+    for (size_t i = 0; i < totalAnimations; ++i)
+    {
+        const GLTFJson& inAnim = inAnims[i];
+        const GLTFJson& inChannels = inAnim["channels"];
+        const GLTFJson& inSamplers = inAnim["samplers"];
+        float maxTime = 0.f;
+
+        // glTF stores translations, rotations, and scales in separate
+        // channels. These are grouped into a single track for each node.
+        nodeTracks.clear();
+
+        for (size_t c = 0; c < inChannels.size(); ++c)
+        {
+            const GLTFJson& inChannel = inChannels[c];
+            const GLTFJson& inTarget = inChannel["target"];
+            const GLTFJson& inSampler = inSamplers[inChannel["sampler"].as_index()];
+            const std::string& path = inTarget["path"].as_string();
+            const std::string& interpolation = inSampler["interpolation"].as_string();
+            const size_t gltfNodeId = inTarget["node"].as_index();
+            GLTFAnimSampler sampler{nullptr, nullptr, interpolation == "STEP", interpolation == "CUBICSPLINE"};
+            unsigned pathId;
+
+            if (path == "translation")   pathId = GLTF_ANIM_PATH_TRANSLATION;
+            else if (path == "rotation") pathId = GLTF_ANIM_PATH_ROTATION;
+            else if (path == "scale")    pathId = GLTF_ANIM_PATH_SCALE;
+            else if (path == "weights")  pathId = GLTF_ANIM_PATH_WEIGHTS;
+            else                         pathId = GLTF_ANIM_PATH_COUNT;
+
+            if (pathId == GLTF_ANIM_PATH_COUNT
+            || gltfNodeId >= nodeIds.size()
+            || nodeIds[gltfNodeId] == draw::scene_property_t::SCENE_GRAPH_ROOT_ID
+            || !find_gltf_accessor(doc, inSampler["input"], sampler.pInput)
+            || !find_gltf_accessor(doc, inSampler["output"], sampler.pOutput)
+            || !sampler.pInput
+            || !sampler.pOutput
+            || !sampler.pInput->count
+            ) {
+                // failing to load an Animation track is not an error.
+                LS_LOG_ERR("\tError: Unable to import channel ", c, " of glTF animation ", i, '.');
+                continue;
+            }
+
+            const size_t numValues = (pathId == GLTF_ANIM_PATH_ROTATION) ? 4 : ((pathId == GLTF_ANIM_PATH_WEIGHTS) ? 1 : 3);
+            const size_t numKeys = sampler.pInput->count;
+
+            if (pathId != GLTF_ANIM_PATH_WEIGHTS
+            && (sampler.pOutput->numComponents < numValues || sampler.pOutput->count < get_gltf_key_index(sampler, numKeys - 1, 1) + 1)
+            ) {
+                LS_LOG_ERR("\tError: Mismatched keyframes in channel ", c, " of glTF animation ", i, '.');
+                continue;
+            }
+
+            float lastTime = 0.f;
+            read_gltf_floats(*sampler.pInput, numKeys - 1, &lastTime, 1);
+            maxTime = math::max(maxTime, lastTime);
+
+            GLTFNodeTracks* pTracks = nullptr;
+
+            for (GLTFNodeTracks& t : nodeTracks)
+            {
+                if (t.gltfNodeId == gltfNodeId)
+                {
+                    pTracks = &t;
+                    break;
+                }
+            }
+
+            if (!pTracks)
+            {
+                nodeTracks.emplace_back(GLTFNodeTracks{});
+                pTracks = &nodeTracks.back();
+                pTracks->gltfNodeId = gltfNodeId;
+
+                for (GLTFAnimSampler& s : pTracks->samplers)
+                {
+                    s = GLTFAnimSampler{nullptr, nullptr, false, false};
+                }
+            }
+
+            pTracks->samplers[pathId] = sampler;
+        }
+
+        // The animation as a whole is measured in milliseconds, as Assimp
+        // does for glTF files.
+        const GLTFJson& inName = inAnim["name"];
+
+        animations.emplace_back(draw::Animation{});
+        draw::Animation& anim = animations.back();
+
+        anim = setup_imported_animation(
+            sceneData.nameTable,
+            inName.is_valid() ? inName.as_string().c_str() : "",
+            (draw::anim_prec_t)(maxTime * 1000.f),
+            (draw::anim_prec_t)1000.0,
+            (unsigned)nodeTracks.size()
+        );
+
+        for (const GLTFNodeTracks& tracks : nodeTracks)
+        {
+            const size_t nodeId = nodeIds[tracks.gltfNodeId];
+            const GLTFAnimSampler& posSampler = tracks.samplers[GLTF_ANIM_PATH_TRANSLATION];
+            const GLTFAnimSampler& rotSampler = tracks.samplers[GLTF_ANIM_PATH_ROTATION];
+            const GLTFAnimSampler& sclSampler = tracks.samplers[GLTF_ANIM_PATH_SCALE];
+            const GLTFAnimSampler& morphSampler = tracks.samplers[GLTF_ANIM_PATH_WEIGHTS];
+
+            // Morph target weights
+            const size_t gltfMeshId = inNodes[tracks.gltfNodeId]["mesh"].as_index();
+
+            if (morphSampler.pInput && gltfMeshId + 1 < meshOffsets.size())
+            {
+                const size_t numKeys = morphSampler.pInput->count;
+                const size_t valuesPerKey = morphSampler.isCubic ? 3 : 1;
+                const size_t numTargets = morphSampler.pOutput->count / (numKeys * valuesPerKey);
+
+                for (size_t meshId = meshOffsets[gltfMeshId]; meshId < meshOffsets[gltfMeshId + 1]; ++meshId)
+                {
+                    const unsigned meshTargets = (unsigned)math::min<size_t>(numTargets, sceneData.morphs[meshId].get_num_targets());
+
+                    for (unsigned t = 0; t < meshTargets; ++t)
+                    {
+                        draw::AnimationKeyListFloat frames;
+
+                        if (!frames.init(numKeys))
+                        {
+                            LS_LOG_ERR("\tError: Unable to allocate ", numKeys, " morph target keyframes for ", sceneData.get_node_name(nodeId), '.');
+                            break;
+                        }
+
+                        for (size_t k = 0; k < numKeys; ++k)
+                        {
+                            float weight = 0.f;
+                            read_gltf_floats(*morphSampler.pOutput, get_gltf_key_index(morphSampler, k, numTargets) + t, &weight, 1);
+                            frames.set_frame(k, read_gltf_key_time(morphSampler, k, maxTime), weight);
+                        }
+
+                        anim.add_morph_channel(meshId, t, std::move(frames));
+                    }
+                }
+            }
+
+            if (!posSampler.pInput && !rotSampler.pInput && !sclSampler.pInput)
+            {
+                continue;
+            }
+
+            // Components without a channel hold the node's rest pose.
+            const draw::Transform& restPose = sceneData.currentTransforms[nodeId];
+            draw::AnimationChannel track;
+
+            if (!track.set_num_frames(
+                posSampler.pInput ? (unsigned)posSampler.pInput->count : 1,
+                sclSampler.pInput ? (unsigned)sclSampler.pInput->count : 1,
+                rotSampler.pInput ? (unsigned)rotSampler.pInput->count : 1
+            )) {
+                LS_LOG_MSG("Unable to import the Animation \"", sceneData.get_node_name(nodeId), "\".");
+                continue;
+            }
+
+            draw::AnimationKeyListVec3& outPosFrames = track.positionFrames;
+            draw::AnimationKeyListVec3& outSclFrames = track.scaleFrames;
+            draw::AnimationKeyListQuat& outRotFrames = track.rotationFrames;
+
+            for (size_t k = 0; k < outPosFrames.size(); ++k)
+            {
+                if (posSampler.pInput)
+                {
+                    const math::vec3&& pos = read_gltf_vec3(*posSampler.pOutput, get_gltf_key_index(posSampler, k, 1));
+                    outPosFrames.set_frame(k, read_gltf_key_time(posSampler, k, maxTime), pos);
+                }
+                else
+                {
+                    outPosFrames.set_frame(k, 0.f, restPose.get_position());
+                }
+            }
+
+            for (size_t k = 0; k < outSclFrames.size(); ++k)
+            {
+                if (sclSampler.pInput)
+                {
+                    const math::vec3&& scl = read_gltf_vec3(*sclSampler.pOutput, get_gltf_key_index(sclSampler, k, 1));
+                    outSclFrames.set_frame(k, read_gltf_key_time(sclSampler, k, maxTime), scl);
+                }
+                else
+                {
+                    outSclFrames.set_frame(k, 0.f, restPose.get_scale());
+                }
+            }
+
+            for (size_t k = 0; k < outRotFrames.size(); ++k)
+            {
+                if (rotSampler.pInput)
+                {
+                    const math::vec4&& rot = read_gltf_vec4(*rotSampler.pOutput, get_gltf_key_index(rotSampler, k, 1), 1.f);
+                    outRotFrames.set_frame(k, read_gltf_key_time(rotSampler, k, maxTime), math::quat{rot[0], rot[1], rot[2], rot[3]});
+                }
+                else
+                {
+                    outRotFrames.set_frame(k, 0.f, restPose.get_orientation());
+                }
+            }
+
+            // Tracks whose samplers all use step interpolation jump between
+            // keyframes.
+            const bool isStep = (!posSampler.pInput || posSampler.isStep)
+                && (!rotSampler.pInput || rotSampler.isStep)
+                && (!sclSampler.pInput || sclSampler.isStep);
+
+            track.animationMode = isStep ? draw::animation_flag_t::ANIM_FLAG_IMMEDIATE : draw::animation_flag_t::ANIM_FLAG_INTERPOLATE;
+
+            // If a list of animation tracks doesn't exist for the current node
+            // then be sure to add it.
+            draw::SceneNode& node = sceneData.nodes[nodeId];
+
+            if (node.animListId == draw::scene_property_t::SCENE_GRAPH_ROOT_ID)
+            {
+                node.animListId = allChannels.size();
+                allChannels.emplace_back(std::vector<draw::AnimationChannel>{});
+            }
+
+            std::vector<draw::AnimationChannel>& nodeChannels = allChannels[node.animListId];
+            nodeChannels.emplace_back(std::move(track));
+
+            // Add the node's imported track to the current animation
+            anim.add_anim_channel(node, nodeChannels.size() - 1);
+        }
+
+        LS_LOG_MSG(
+            "\tLoaded Animation ", i + 1, '/', totalAnimations,
+            "\n\t\tName:      ", anim.get_anim_name(sceneData.nameTable),
+            "\n\t\tDuration:  ", anim.get_duration(),
+            "\n\t\tTicks/Sec: ", anim.get_ticks_per_sec(),
+            "\n\t\tChannels:  ", anim.get_num_anim_channels(),
+            "\n\t\tMorphs:    ", anim.get_num_morph_channels()
+        );
+    }
+
+    LS_LOG_MSG("\tSuccessfully loaded ", animations.size(), " animations.");
+}
+
+} // end anonymous namespace
+
+
+
+namespace ls
+{
+namespace draw
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * SceneFilePreLoader Class
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Load a glTF file without Assimp
+-------------------------------------*/
+bool SceneFilePreLoader::load_gltf(const std::string& filename) noexcept
+{
+    // Accessors are read in-place, which requires the host to share glTF's
+    // little-endian byte order.
+    if (utils::get_endian_order() != utils::endian_t::LS_LITTLE_ENDIAN)
+    {
+        return false;
+    }
+
+    LS_LOG_MSG("Attempting to load the glTF file ", filename, " natively.");
+
+    GLTFDocument doc;
+    const char* pBin = nullptr;
+    size_t binBytes = 0;
+
+    {
+        SceneLoadTimer timer{profile, SCENE_LOAD_PHASE_FILE_READ};
+
+        SceneFileCache file;
+
+        if (!file.open(filename))
+        {
+            LS_LOG_ERR("\tError: Unable to open the glTF file ", filename, ".\n");
+            return false;
+        }
+
+        const std::string::size_type baseDirIndex = filename.find_last_of(u8R"(\/)");
+        if (baseDirIndex != std::string::npos)
+        {
+            baseFileDir = filename.substr(0, baseDirIndex + 1);
+        }
+
+        // Binary glTF files contain a JSON chunk followed by an optional
+        // binary chunk. Both remain within the mapped file.
+        const char* pJson = file.get_data();
+        size_t jsonBytes = file.get_size();
+
+        if (jsonBytes >= GLTF_GLB_HEADER_BYTES && read_gltf_u32(pJson) == GLTF_GLB_MAGIC)
+        {
+            if (!read_glb_chunks(file.get_data(), file.get_size(), pJson, jsonBytes, pBin, binBytes))
+            {
+                LS_LOG_ERR("\tError: The binary glTF file ", filename, " is corrupt.\n");
+                return false;
+            }
+        }
+
+        profile.add_bytes(SCENE_LOAD_PHASE_FILE_READ, file.get_size());
+        gltfMappings.emplace_back(std::move(file));
+
+        GLTFJsonParser parser;
+
+        if (!parser.parse(pJson, jsonBytes, doc.json))
+        {
+            LS_LOG_ERR("\tError: Unable to parse the JSON contained within ", filename, ".\n");
+            return false;
+        }
+
+        const std::string& version = doc.json["asset"]["version"].as_string();
+
+        if (version.empty() || version[0] != '2' || (version.size() > 1 && version[1] != '.'))
+        {
+            LS_LOG_MSG("\tThe glTF file ", filename, " uses an unsupported version \"", version, "\".");
+            return false;
+        }
+
+        if (doc.json["extensionsRequired"].size())
+        {
+            LS_LOG_MSG("\tThe glTF file ", filename, " requires extensions which are not supported natively.");
+            return false;
+        }
+
+        if (!load_gltf_buffers(doc, pBin, binBytes, baseFileDir, gltfMappings, gltfBuffers))
+        {
+            return false;
+        }
+
+        for (const GLTFBuffer& buffer : doc.buffers)
+        {
+            profile.add_bytes(SCENE_LOAD_PHASE_FILE_READ, buffer.pData != pBin ? buffer.numBytes : 0);
+        }
+
+        resolve_gltf_accessors(doc);
+    }
+
+    std::vector<GLTFPrimitive> prims;
+    std::vector<size_t> meshOffsets;
+    bool needsDefaultMaterial = false;
+    bool ret;
+
+    {
+        SceneLoadTimer timer{profile, SCENE_LOAD_PHASE_PRELOAD};
+        ret = gather_gltf_primitives(doc, sceneInfo.packedVertTypes, prims, meshOffsets, needsDefaultMaterial);
+    }
+
+    if (!ret)
+    {
+        return false;
+    }
+
+    {
+        SceneLoadTimer timer{profile, SCENE_LOAD_PHASE_TEXTURES};
+        import_gltf_materials(doc, baseFileDir, needsDefaultMaterial, sceneData.materials, texturePaths, pendingTextures);
+    }
+
+    // Primitives are converted on worker threads alongside the current
+    // thread.
+    const unsigned numPrims = (unsigned)prims.size();
+
+    {
+        SceneLoadTimer timer{profile, SCENE_LOAD_PHASE_MESHES};
+
+        std::atomic_uint nextPrimId{0};
+        std::vector<std::thread> workers;
+        const unsigned numThreads = calc_num_threads(numPrims);
+        workers.reserve(numThreads);
+
+        for (unsigned i = 1; i < numThreads; ++i)
+        {
+            try
+            {
+                workers.emplace_back(convert_gltf_primitives, std::ref(prims), std::ref(nextPrimId), sceneInfo.baseVertexDraws != 0);
+            }
+            catch (const std::system_error& e)
+            {
+                LS_LOG_ERR("\t\tUnable to start a glTF conversion thread: ", e.what());
+                break;
+            }
+        }
+
+        LS_LOG_MSG("\tConverting ", numPrims, " meshes on ", workers.size() + 1, " threads.");
+
+        convert_gltf_primitives(prims, nextPrimId, sceneInfo.baseVertexDraws != 0);
+
+        for (std::thread& t : workers)
+        {
+            t.join();
+        }
+    }
+
+    for (const GLTFPrimitive& prim : prims)
+    {
+        if (!prim.isValid)
+        {
+            LS_LOG_ERR("\tError: Failed to convert the meshes of ", filename, ".\n");
+            return false;
+        }
+
+        profile.add_bytes(SCENE_LOAD_PHASE_MESHES, (uint64_t)prim.vertices.size() + prim.indices.size() * sizeof(uint32_t));
+
+        if (!prim.vertices.empty())
+        {
+            profile.add_allocation(SCENE_LOAD_PHASE_MESHES, prim.vertices.size());
+        }
+    }
+
+    {
+        SceneLoadTimer timer{profile, SCENE_LOAD_PHASE_PRELOAD};
+
+        // Group all meshes with the same vertex types into contiguous
+        // sections of the VBO, as "preload_mesh_data()" does.
+        for (const GLTFPrimitive& prim : prims)
+        {
+            VboGroupMarker* pMarker = get_matching_marker(prim.vertType, vboMarkers);
+
+            if (!pMarker)
+            {
+                vboMarkers.push_back(VboGroupMarker{});
+                pMarker = &vboMarkers.back();
+                pMarker->vertType = prim.vertType;
+                pMarker->numVboBytes = 0;
+                pMarker->vboOffset = 0;
+                pMarker->meshOffset = 0;
+                pMarker->baseVert = 0;
+            }
+
+            const unsigned numMeshBytes = prim.numVerts * get_vertex_byte_size(prim.vertType);
+            pMarker->numVboBytes += numMeshBytes;
+            sceneInfo.totalVboBytes += numMeshBytes;
+            sceneInfo.totalVertices += prim.numVerts;
+        }
+
+        unsigned totalVboOffset = 0;
+        for (VboGroupMarker& m : vboMarkers)
+        {
+            m.vboOffset = totalVboOffset;
+            totalVboOffset += m.numVboBytes;
+        }
+
+        // Place every mesh within the VBO and IBO. VAO IDs are stored as
+        // indices into "vboMarkers" until the GPU buffers have been created.
+        VboGroupCursor* const pCursors = init_vbo_group_cursors(scratch, vboMarkers);
+        std::vector<SceneMesh>& meshes = sceneData.meshes;
+
+        if (!pCursors)
+        {
+            LS_LOG_ERR("\tError: Unable to allocate the mesh layout of ", filename, ".\n");
+            return false;
+        }
+
+        meshes.resize(numPrims);
+        sceneData.skins.resize(numPrims);
+        sceneData.morphs.resize(numPrims);
+        sceneData.bounds.resize(numPrims);
+        meshStats.resize(numPrims);
+        gltfBuffers.reserve(gltfBuffers.size() + numPrims);
+
+        for (unsigned meshId = 0; meshId < numPrims; ++meshId)
+        {
+            GLTFPrimitive& prim = prims[meshId];
+            const VboGroupMarker* const pMeshGroup = get_matching_marker(prim.vertType, vboMarkers);
+            const VboGroupMarker& meshGroup = *pMeshGroup;
+            const size_t meshGroupId = (size_t)(pMeshGroup - vboMarkers.data());
+            VboGroupCursor& cursor = pCursors[meshGroupId];
+
+            SceneMesh& mesh = meshes[meshId];
+            mesh.reset();
+            mesh.drawParams.materialId = prim.materialId;
+            mesh.drawParams.vaoId = (uint32_t)meshGroupId;
+
+            MeshMetaData& metaData = mesh.metaData;
+            metaData.vertTypes = meshGroup.vertType;
+            metaData.totalVerts = prim.numVerts;
+            metaData.baseVertex = cursor.baseVert;
+            metaData.vboOffset = meshGroup.vboOffset + cursor.meshOffset;
+            metaData.indexType = prim.pIndexData ? prim.indexType : get_mesh_index_type(cursor.baseVert, metaData.totalVerts, sceneInfo.baseVertexDraws != 0);
+            metaData.totalIndices = prim.numIndices;
+
+            if (metaData.vertTypes & common_vertex_t::PACKED_POSITION_VERTEX)
+            {
+                metaData.dequantScale = prim.dequantScale;
+                metaData.dequantBias = prim.dequantBias;
+            }
+
+            const unsigned baseIndex = get_mesh_index_offset(sceneInfo.totalIboBytes);
+
+            DrawCommandParams& drawParams = mesh.drawParams;
+            drawParams.drawFunc = draw_func_t::DRAW_ELEMENTS;
+            drawParams.drawMode = prim.drawMode;
+            drawParams.indexType = metaData.indexType;
+            drawParams.offset = (void*)((ptrdiff_t)baseIndex);
+            drawParams.count = metaData.totalIndices;
+
+            drawParams.baseVertex = sceneInfo.baseVertexDraws ? (int32_t)cursor.baseVert : 0;
+
+            sceneInfo.totalIboBytes = baseIndex + metaData.calc_total_index_bytes();
+            sceneInfo.totalIndices += metaData.totalIndices;
+
+            if (get_index_byte_size(metaData.indexType) > get_index_byte_size(sceneInfo.indexType))
+            {
+                sceneInfo.indexType = metaData.indexType;
+            }
+
+            // Vertices are either uploaded from the mapped file or from their
+            // converted buffer.
+            add_gltf_upload_range(gltfRanges, SceneUploadRange{prim.pVertData, metaData.vboOffset, metaData.calc_total_vertex_bytes(), false});
+
+            if (!prim.vertices.empty())
+            {
+                gltfBuffers.emplace_back(std::move(prim.vertices));
+            }
+
+            if (prim.pIndexData)
+            {
+                add_gltf_upload_range(gltfRanges, SceneUploadRange{prim.pIndexData, baseIndex, metaData.calc_total_index_bytes(), true});
+            }
+            else if (metaData.totalIndices)
+            {
+                // Indices are local to the mesh if base-vertex draws are used.
+                // Converted indices live in the scratch arena until they are
+                // uploaded.
+                const unsigned indexOffset = metaData.baseVertex - (unsigned)drawParams.baseVertex;
+                const unsigned numIndexBytes = metaData.calc_total_index_bytes();
+                char* const pOutIndices = static_cast<char*>(scratch.allocate(numIndexBytes, sizeof(uint32_t)));
+
+                if (!pOutIndices)
+                {
+                    LS_LOG_ERR("\tError: Unable to allocate ", numIndexBytes, " bytes of indices for ", filename, ".\n");
+                    return false;
+                }
+
+                if (metaData.indexType == index_element_t::INDEX_TYPE_USHORT)
+                {
+                    convert_mesh_indices<unsigned short>(prim.indices.data(), prim.indices.size(), pOutIndices, indexOffset);
+                }
+                else
+                {
+                    convert_mesh_indices<unsigned int>(prim.indices.data(), prim.indices.size(), pOutIndices, indexOffset);
+                }
+
+                std::vector<uint32_t>().swap(prim.indices);
+
+                add_gltf_upload_range(gltfRanges, SceneUploadRange{pOutIndices, baseIndex, numIndexBytes, true});
+            }
+
+            cursor.meshOffset += metaData.calc_total_vertex_bytes();
+            cursor.baseVert += metaData.totalVerts;
+
+            sceneData.bounds[meshId] = prim.bounds;
+            sceneData.skins[meshId].reset();
+            sceneData.morphs[meshId] = std::move(prim.morph);
+            sceneData.morphs[meshId].baseVertex = metaData.baseVertex;
+            meshStats[meshId] = prim.stats;
+        }
+
+        LS_LOG_MSG(
+            "\tScene File Memory requirements:",
+            "\n\t\tVBO Byte Size:   ", sceneInfo.totalVboBytes,
+            "\n\t\tVertex Count:    ", sceneInfo.totalVertices,
+            "\n\t\tIBO Byte Size:   ", sceneInfo.totalIboBytes,
+            "\n\t\tIndex Count:     ", sceneInfo.totalIndices,
+            "\n\t\tVAO Count:       ", vboMarkers.size(),
+            "\n\t\tUpload Ranges:   ", gltfRanges.size()
+        );
+
+        profile.add_bytes(SCENE_LOAD_PHASE_PRELOAD, (uint64_t)sceneInfo.totalVboBytes + sceneInfo.totalIboBytes);
+    }
+
+    std::vector<size_t> nodeIds;
+
+    {
+        SceneLoadTimer timer{profile, SCENE_LOAD_PHASE_HIERARCHY};
+        import_gltf_nodes(doc, meshOffsets, nodeIds, sceneData);
+        import_gltf_skins(doc, meshOffsets, nodeIds, sceneData);
+    }
+
+    {
+        SceneLoadTimer timer{profile, SCENE_LOAD_PHASE_ANIMATIONS};
+        import_gltf_animations(doc, meshOffsets, nodeIds, sceneData);
+    }
+
+    profile_scene_allocation(profile, SCENE_LOAD_PHASE_CPU_ALLOC, sceneData.meshes);
+    profile_scene_allocation(profile, SCENE_LOAD_PHASE_CPU_ALLOC, sceneData.skins);
+    profile_scene_allocation(profile, SCENE_LOAD_PHASE_CPU_ALLOC, sceneData.morphs);
+    profile_scene_allocation(profile, SCENE_LOAD_PHASE_CPU_ALLOC, sceneData.materials);
+    profile_scene_allocation(profile, SCENE_LOAD_PHASE_CPU_ALLOC, sceneData.bounds);
+    profile_scene_allocation(profile, SCENE_LOAD_PHASE_CPU_ALLOC, sceneData.nodes);
+    profile_scene_allocation(profile, SCENE_LOAD_PHASE_CPU_ALLOC, sceneData.baseTransforms);
+    profile_scene_allocation(profile, SCENE_LOAD_PHASE_CPU_ALLOC, sceneData.currentTransforms);
+    profile_scene_allocation(profile, SCENE_LOAD_PHASE_CPU_ALLOC, sceneData.nodeNames);
+    profile_scene_allocation(profile, SCENE_LOAD_PHASE_CPU_ALLOC, sceneData.animations);
+    profile_scene_allocation(profile, SCENE_LOAD_PHASE_CPU_ALLOC, sceneData.cameras);
+    profile_scene_allocation(profile, SCENE_LOAD_PHASE_CPU_ALLOC, sceneData.nodeMeshCounts);
+    profile_scene_allocation(profile, SCENE_LOAD_PHASE_CPU_ALLOC, sceneData.nodeMeshes);
+
+    LS_LOG_MSG(
+        "\tDone. Successfully loaded the scene file \"", filename, ".\"",
+        "\n\t\tTotal Meshes:     ", sceneData.meshes.size(),
+        "\n\t\tTotal Textures:   ", pendingTextures.size(),
+        "\n\t\tTotal Nodes:      ", sceneData.nodes.size(),
+        "\n\t\tTotal Cameras:    ", sceneData.cameras.size(),
+        "\n\t\tTotal Animations: ", sceneData.animations.size(),
+        '\n'
+    );
+
+    return true;
+}
+
+
+
+} // end draw namespace
+} // end ls namespace
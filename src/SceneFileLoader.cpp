@@ -3,11 +3,22 @@
 #include <memory> // std::nothrow
 #include <string>
 #include <cstring> // strcmp()
+#include <atomic>
+#include <condition_variable>
+#include <functional> // std::ref
+#include <mutex>
+#include <system_error>
+#include <thread>
 
+#include "lightsky/utils/Copy.h" // utils::fast_fill()
+
+#include "lightsky/draw/BoundingBox.h"
 #include "lightsky/draw/Camera.h"
 #include "lightsky/draw/Color.h"
 #include "lightsky/draw/ImageBuffer.h"
 #include "lightsky/draw/IndexBuffer.h"
+#include "lightsky/draw/MeshCodec.h"
+#include "lightsky/draw/MeshOptimizer.h"
 #include "lightsky/draw/PackedVertex.h"
 #include "lightsky/draw/SceneFileLoader.h"
 #include "lightsky/draw/SceneFileUtility.h"
@@ -22,164 +33,738 @@
 
 
 
-namespace ls
-{
-namespace draw
+/*-----------------------------------------------------------------------------
+ * Anonymous helper functions
+-----------------------------------------------------------------------------*/
+namespace
 {
 
+namespace draw = ls::draw;
+namespace math = ls::math;
+namespace utils = ls::utils;
 
-
-/*-----------------------------------------------------------------------------
- * SceneGraph Class
------------------------------------------------------------------------------*/
 /*-------------------------------------
- * Destructor
+ * Write animation keyframes into a scene cache
 -------------------------------------*/
-VboGroupMarker::~VboGroupMarker() noexcept
+template <typename data_t>
+void write_cached_key_list(draw::SceneCacheWriter& w, const draw::AnimationKeyList<data_t>& keys) noexcept
 {
+    const size_t numKeys = keys.size();
+
+    w.write<uint64_t>((uint64_t)numKeys);
+
+    for (size_t i = 0; i < numKeys; ++i)
+    {
+        w.write<draw::anim_prec_t>(keys.get_frame_time(i));
+        w.write<data_t>(keys.get_frame_data(i));
+    }
 }
 
+
+
 /*-------------------------------------
- * Constructor
+ * Read animation keyframes from a scene cache
 -------------------------------------*/
-VboGroupMarker::VboGroupMarker() noexcept :
-    vertType{(common_vertex_t)0},
-    numVboBytes{0},
-    vboOffset{0},
-    meshOffset{0},
-    baseVert{0}
+template <typename data_t>
+bool read_cached_key_list(draw::SceneCacheReader& r, draw::AnimationKeyList<data_t>& outKeys) noexcept
 {
+    size_t numKeys = 0;
+
+    if (!r.read_count(numKeys, sizeof(draw::anim_prec_t) + sizeof(data_t)) || !outKeys.init(numKeys))
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < numKeys; ++i)
+    {
+        draw::anim_prec_t frameTime;
+        data_t frameData;
+
+        if (!r.read(frameTime) || !r.read(frameData))
+        {
+            return false;
+        }
+
+        outKeys.set_frame(i, frameTime, frameData);
+    }
+
+    return true;
 }
 
+
+
 /*-------------------------------------
- * Copy Constructor
+ * Read back a GPU buffer into a scene cache
 -------------------------------------*/
-VboGroupMarker::VboGroupMarker(const VboGroupMarker& v) noexcept :
-    vertType{v.vertType},
-    numVboBytes{v.numVboBytes},
-    vboOffset{v.vboOffset},
-    meshOffset{v.meshOffset},
-    baseVert{v.baseVert}
+bool write_cached_buffer(draw::SceneCacheWriter& w, const draw::BufferObject& b, const unsigned numBytes) noexcept
 {
+    if (!numBytes)
+    {
+        return true;
+    }
+
+    b.bind();
+    const void* const pData = b.map_data(0, numBytes, draw::buffer_map_t::VBO_MAP_BIT_READ);
+
+    if (!pData)
+    {
+        b.unbind();
+        return false;
+    }
+
+    w.write_bytes(pData, numBytes);
+
+    b.unmap_data();
+    b.unbind();
+
+    return true;
 }
 
+
+
 /*-------------------------------------
- * Move Constructor
+ * Verify compressed payload blocks fit within their buffers
 -------------------------------------*/
-VboGroupMarker::VboGroupMarker(VboGroupMarker&& v) noexcept :
-    vertType{v.vertType},
-    numVboBytes{v.numVboBytes},
-    vboOffset{v.vboOffset},
-    meshOffset{v.meshOffset},
-    baseVert{v.baseVert}
+bool validate_cached_blocks(
+    const std::vector<draw::SceneCachePayloadBlock>& blocks,
+    const draw::SceneCacheHeader& header,
+    const uint64_t totalVboBytes,
+    const uint64_t totalIboBytes
+) noexcept
 {
-    v.vertType = (common_vertex_t)0;
-    v.numVboBytes = 0;
-    v.vboOffset = 0;
-    v.meshOffset = 0;
-    v.baseVert = 0;
+    for (const draw::SceneCachePayloadBlock& b : blocks)
+    {
+        const bool isVertexBlock = b.codec == draw::mesh_codec_t::MESH_CODEC_VERTICES;
+        const uint64_t rawLimit = isVertexBlock ? totalVboBytes : totalIboBytes;
+        const uint64_t encodedLimit = isVertexBlock ? header.vboBytes : header.iboBytes;
+
+        if ((!isVertexBlock && b.codec != draw::mesh_codec_t::MESH_CODEC_INDICES)
+        || (!isVertexBlock && b.elementBytes != 1 && b.elementBytes != 2 && b.elementBytes != 4)
+        || !b.elementBytes
+        || b.rawBytes % b.elementBytes
+        || b.rawOffset > rawLimit
+        || b.rawBytes > rawLimit - b.rawOffset
+        || b.encodedOffset > encodedLimit
+        || b.encodedBytes > encodedLimit - b.encodedOffset
+        ) {
+            return false;
+        }
+    }
+
+    return true;
 }
 
+
+
 /*-------------------------------------
- * Copy Operator
+ * Verify all indices read from a cache reference valid scene data
 -------------------------------------*/
-VboGroupMarker& VboGroupMarker::operator=(const VboGroupMarker& v) noexcept
+bool validate_cached_scene(const draw::SceneGraph& sceneData, const size_t numTextures) noexcept
 {
-    vertType = v.vertType;
-    numVboBytes = v.numVboBytes;
-    vboOffset = v.vboOffset;
-    meshOffset = v.meshOffset;
-    baseVert = v.baseVert;
-    return *this;
+    constexpr size_t rootId = draw::scene_property_t::SCENE_GRAPH_ROOT_ID;
+    const size_t numNodes = sceneData.nodes.size();
+    const size_t numMeshes = sceneData.meshes.size();
+    const size_t numMaterials = sceneData.materials.size();
+    const std::vector<std::vector<draw::AnimationChannel>>& nodeAnims = sceneData.nodeAnims;
+
+    // Meshes without a material use the default ID of 0.
+    const auto isMaterialValid = [&](const draw::DrawCommandParams& p) -> bool
+    {
+        return !numMaterials || p.materialId < numMaterials;
+    };
+
+    if (sceneData.bounds.size() != numMeshes
+    || sceneData.baseTransforms.size() != numNodes
+    || sceneData.currentTransforms.size() != numNodes
+    || sceneData.modelMatrices.size() != numNodes
+    || sceneData.nodeNames.size() != numNodes
+    || sceneData.nodeMeshes.size() != sceneData.nodeMeshCounts.size()
+    ) {
+        return false;
+    }
+
+    for (const draw::SceneMaterial& m : sceneData.materials)
+    {
+        for (unsigned slot = 0; slot < draw::active_texture_t::MAX_ACTIVE_TEXTURES; ++slot)
+        {
+            if (m.textures[slot] != draw::material_property_t::INVALID_MATERIAL_TEXTURE && m.textures[slot] >= numTextures)
+            {
+                return false;
+            }
+        }
+    }
+
+    for (const draw::SceneMesh& m : sceneData.meshes)
+    {
+        if (!isMaterialValid(m.drawParams))
+        {
+            return false;
+        }
+    }
+
+    for (size_t i = 0; i < sceneData.nodeMeshes.size(); ++i)
+    {
+        for (unsigned j = 0; j < sceneData.nodeMeshCounts[i]; ++j)
+        {
+            if (!isMaterialValid(sceneData.nodeMeshes[i][j]))
+            {
+                return false;
+            }
+        }
+    }
+
+    for (const draw::SceneSkin& s : sceneData.skins)
+    {
+        if (s.boneIds.size() != s.inverseBindPoses.size())
+        {
+            return false;
+        }
+
+        for (const size_t boneId : s.boneIds)
+        {
+            if (boneId >= numNodes)
+            {
+                return false;
+            }
+        }
+    }
+
+    for (const draw::SceneMorph& m : sceneData.morphs)
+    {
+        const size_t numTargets = m.get_num_targets();
+
+        if (!numTargets)
+        {
+            continue;
+        }
+
+        if (numTargets > draw::morph_property_t::MORPH_MAX_TARGETS
+        || m.targetNames.size() != numTargets
+        || m.vertOffsets.size() != (size_t)m.numVerts + 1
+        || m.vertOffsets.back() > m.deltas.size()
+        ) {
+            return false;
+        }
+
+        for (unsigned v = 0; v < m.numVerts; ++v)
+        {
+            if (m.vertOffsets[v] > m.vertOffsets[v + 1])
+            {
+                return false;
+            }
+        }
+
+        for (const draw::SceneMorphDelta& d : m.deltas)
+        {
+            if (d.targetId >= numTargets)
+            {
+                return false;
+            }
+        }
+    }
+
+    // Parents are always stored before their children.
+    for (size_t i = 0; i < numNodes; ++i)
+    {
+        const draw::SceneNode& node = sceneData.nodes[i];
+        const size_t parentId = sceneData.currentTransforms[i].parentId;
+
+        if (node.nodeId != i
+        || (parentId != rootId && parentId >= i)
+        || (node.animListId != rootId && node.animListId >= nodeAnims.size())
+        ) {
+            return false;
+        }
+
+        switch (node.type)
+        {
+            case draw::scene_node_t::NODE_TYPE_EMPTY:
+                break;
+
+            case draw::scene_node_t::NODE_TYPE_MESH:
+                if (node.dataId >= sceneData.nodeMeshes.size())
+                {
+                    return false;
+                }
+                break;
+
+            case draw::scene_node_t::NODE_TYPE_CAMERA:
+                if (node.dataId >= sceneData.cameras.size())
+                {
+                    return false;
+                }
+                break;
+
+            default:
+                return false;
+        }
+    }
+
+    for (const draw::Animation& anim : sceneData.animations)
+    {
+        const std::vector<size_t>& animIds = anim.get_node_animations();
+        const std::vector<size_t>& trackIds = anim.get_node_tracks();
+        const std::vector<size_t>& transformIds = anim.get_transforms();
+        const std::vector<size_t>& morphMeshIds = anim.get_morph_meshes();
+        const std::vector<unsigned>& morphTargetIds = anim.get_morph_targets();
+
+        for (size_t i = 0; i < animIds.size(); ++i)
+        {
+            if (transformIds[i] >= numNodes
+            || animIds[i] >= nodeAnims.size()
+            || trackIds[i] >= nodeAnims[animIds[i]].size()
+            ) {
+                return false;
+            }
+        }
+
+        for (size_t i = 0; i < morphMeshIds.size(); ++i)
+        {
+            if (morphMeshIds[i] >= sceneData.morphs.size()
+            || morphTargetIds[i] >= sceneData.morphs[morphMeshIds[i]].get_num_targets()
+            ) {
+                return false;
+            }
+        }
+    }
+
+    return true;
 }
 
+
+
 /*-------------------------------------
- * Move Operator
+ * Read back a GPU buffer into CPU memory
 -------------------------------------*/
-VboGroupMarker& VboGroupMarker::operator=(VboGroupMarker&& v) noexcept
+bool read_cached_buffer(const draw::BufferObject& b, const unsigned numBytes, std::vector<char>& outData) noexcept
 {
-    vertType = v.vertType;
-    v.vertType = (common_vertex_t)0;
+    outData.resize(numBytes);
 
-    numVboBytes = v.numVboBytes;
-    v.numVboBytes = 0;
+    if (!numBytes)
+    {
+        return true;
+    }
 
-    vboOffset = v.vboOffset;
-    v.vboOffset = 0;
+    b.bind();
+    const void* const pData = b.map_data(0, numBytes, draw::buffer_map_t::VBO_MAP_BIT_READ);
 
-    meshOffset = v.meshOffset;
-    v.meshOffset = 0;
+    if (!pData)
+    {
+        b.unbind();
+        return false;
+    }
 
-    baseVert = v.baseVert;
-    v.baseVert = 0;
+    utils::fast_memcpy(outData.data(), pData, numBytes);
 
-    return *this;
+    b.unmap_data();
+    b.unbind();
+
+    return true;
 }
 
 
 
-/*-----------------------------------------------------------------------------
- * SceneFilePreLoader Class
------------------------------------------------------------------------------*/
 /*-------------------------------------
- * Destructor
+ * Split a range of a VBO or IBO into compressed blocks
 -------------------------------------*/
-SceneFilePreLoader::~SceneFilePreLoader() noexcept
+void encode_cached_blocks(
+    const std::vector<char>& rawData,
+    const uint64_t rawOffset,
+    const uint32_t numElements,
+    const uint32_t elementBytes,
+    const draw::mesh_codec_t codec,
+    std::vector<char>& outEncoded,
+    std::vector<draw::SceneCachePayloadBlock>& outBlocks
+) noexcept
 {
-    unload();
+    for (uint32_t i = 0; i < numElements; i += draw::mesh_codec_t::MESH_CODEC_BLOCK_ELEMENTS)
+    {
+        const uint32_t count = math::min<uint32_t>(numElements - i, draw::mesh_codec_t::MESH_CODEC_BLOCK_ELEMENTS);
+        const char* const pRaw = rawData.data() + rawOffset + (uint64_t)i * elementBytes;
+        draw::SceneCachePayloadBlock block;
+
+        block.rawOffset = rawOffset + (uint64_t)i * elementBytes;
+        block.encodedOffset = outEncoded.size();
+        block.rawBytes = count * elementBytes;
+        block.codec = codec;
+        block.elementBytes = elementBytes;
+
+        if (codec == draw::mesh_codec_t::MESH_CODEC_VERTICES)
+        {
+            draw::encode_mesh_vertices(pRaw, count, elementBytes, outEncoded);
+        }
+        else
+        {
+            draw::encode_mesh_indices(pRaw, count, elementBytes, outEncoded);
+        }
+
+        block.encodedBytes = (uint32_t)(outEncoded.size() - block.encodedOffset);
+        outBlocks.push_back(block);
+    }
 }
 
 
 
 /*-------------------------------------
- * Constructor
+ * Decode compressed blocks until none remain
 -------------------------------------*/
-SceneFilePreLoader::SceneFilePreLoader() noexcept :
-    filepath{},
-    importer{nullptr},
-    sceneInfo{},
-    sceneData{},
-    baseFileDir{"./"},
-    vboMarkers{},
-    texturePaths{}
+void decode_cached_blocks(
+    const std::vector<draw::SceneCachePayloadBlock>& blocks,
+    const char* const pVboData,
+    const char* const pIboData,
+    char* const pVbo,
+    char* const pIbo,
+    std::atomic_size_t& nextBlock,
+    std::atomic_bool& succeeded
+) noexcept
 {
+    const size_t numBlocks = blocks.size();
+    std::vector<char> scratch;
+
+    // Each block only writes to its own range of the VBO or IBO.
+    for (size_t i = nextBlock.fetch_add(1); i < numBlocks && succeeded; i = nextBlock.fetch_add(1))
+    {
+        const draw::SceneCachePayloadBlock& b = blocks[i];
+        const uint32_t numElements = b.rawBytes / b.elementBytes;
+        bool ret;
+
+        if (b.codec == draw::mesh_codec_t::MESH_CODEC_VERTICES)
+        {
+            ret = draw::decode_mesh_vertices(pVboData + b.encodedOffset, b.encodedBytes, pVbo + b.rawOffset, numElements, b.elementBytes, scratch);
+        }
+        else
+        {
+            ret = draw::decode_mesh_indices(pIboData + b.encodedOffset, b.encodedBytes, pIbo + b.rawOffset, numElements, b.elementBytes, scratch);
+        }
+
+        if (!ret)
+        {
+            succeeded = false;
+        }
+    }
 }
 
 
 
 /*-------------------------------------
- * SceneResource Move Constructor
+ * Decoding state of a pending texture
 -------------------------------------*/
-SceneFilePreLoader::SceneFilePreLoader(SceneFilePreLoader&& s) noexcept :
-    filepath{std::move(s.filepath)},
-    importer{std::move(s.importer)},
-    sceneInfo{std::move(s.sceneInfo)},
-    sceneData{std::move(s.sceneData)},
-    baseFileDir{std::move(s.baseFileDir)},
-    vboMarkers{std::move(s.vboMarkers)},
-    texturePaths{std::move(s.texturePaths)}
+enum class texture_decode_status_t : unsigned char
 {
-}
+    TEXTURE_DECODE_PENDING,
+    TEXTURE_DECODE_SUCCESS,
+    TEXTURE_DECODE_FAILED
+};
 
 
 
 /*-------------------------------------
- * Mesh Loader move operator
+ * Images shared between texture decoding threads and the GL thread
 -------------------------------------*/
-SceneFilePreLoader& SceneFilePreLoader::operator=(SceneFilePreLoader&& s) noexcept
+struct TextureDecodeQueue
 {
-    unload();
+    const std::vector<std::pair<std::string, draw::tex_wrap_t>>& paths;
 
-    filepath = std::move(s.filepath);
-    importer = std::move(s.importer);
-    sceneInfo = std::move(s.sceneInfo);
-    sceneData = std::move(s.sceneData);
-    baseFileDir = std::move(s.baseFileDir);
-    vboMarkers = std::move(s.vboMarkers);
-    texturePaths = std::move(s.texturePaths);
+    std::vector<draw::ImageBuffer> images;
 
-    return *this;
-}
+    // Guarded by "lock."
+    std::vector<texture_decode_status_t> status;
+
+    std::atomic_size_t nextIndex;
+
+    std::mutex lock;
+
+    std::condition_variable cond;
+
+    TextureDecodeQueue(const std::vector<std::pair<std::string, draw::tex_wrap_t>>& texPaths) noexcept :
+        paths{texPaths},
+        images(texPaths.size()),
+        status(texPaths.size(), texture_decode_status_t::TEXTURE_DECODE_PENDING),
+        nextIndex{0},
+        lock{},
+        cond{}
+    {}
+};
+
+
+
+/*-------------------------------------
+ * Decode images until none remain in a queue
+-------------------------------------*/
+void decode_pending_textures(TextureDecodeQueue& q) noexcept
+{
+    const size_t numImages = q.images.size();
+
+    for (size_t i = q.nextIndex.fetch_add(1); i < numImages; i = q.nextIndex.fetch_add(1))
+    {
+        const bool loaded = q.images[i].load_file(q.paths[i].first) == draw::ImageBuffer::img_status_t::FILE_LOAD_SUCCESS;
+
+        {
+            std::lock_guard<std::mutex> guard{q.lock};
+            q.status[i] = loaded ? texture_decode_status_t::TEXTURE_DECODE_SUCCESS : texture_decode_status_t::TEXTURE_DECODE_FAILED;
+        }
+
+        q.cond.notify_all();
+    }
+}
+
+
+
+/*-------------------------------------
+ * Update the mesh indices of a node hierarchy
+-------------------------------------*/
+void remap_assimp_node_meshes(aiNode* const pNode, const std::vector<unsigned>& meshRemap) noexcept
+{
+    if (!pNode)
+    {
+        return;
+    }
+
+    for (unsigned i = 0; i < pNode->mNumMeshes; ++i)
+    {
+        pNode->mMeshes[i] = meshRemap[pNode->mMeshes[i]];
+    }
+
+    for (unsigned i = 0; i < pNode->mNumChildren; ++i)
+    {
+        remap_assimp_node_meshes(pNode->mChildren[i], meshRemap);
+    }
+}
+
+
+
+/*-------------------------------------
+ * Determine if a file should be imported by the native glTF loader
+-------------------------------------*/
+bool is_gltf_file(const std::string& filename) noexcept
+{
+    const std::string::size_type extIndex = filename.find_last_of('.');
+    if (extIndex == std::string::npos || filename.find_first_of(u8R"(\/)", extIndex) != std::string::npos)
+    {
+        return false;
+    }
+
+    std::string ext = filename.substr(extIndex + 1);
+    for (char& c : ext)
+    {
+        c = (c >= 'A' && c <= 'Z') ? (char)(c - 'A' + 'a') : c;
+    }
+
+    return ext == "gltf" || ext == "glb";
+}
+
+} // end anonymous namespace
+
+
+
+namespace ls
+{
+namespace draw
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * SceneGraph Class
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Destructor
+-------------------------------------*/
+VboGroupMarker::~VboGroupMarker() noexcept
+{
+}
+
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+VboGroupMarker::VboGroupMarker() noexcept :
+    vertType{(common_vertex_t)0},
+    numVboBytes{0},
+    vboOffset{0},
+    meshOffset{0},
+    baseVert{0}
+{
+}
+
+/*-------------------------------------
+ * Copy Constructor
+-------------------------------------*/
+VboGroupMarker::VboGroupMarker(const VboGroupMarker& v) noexcept :
+    vertType{v.vertType},
+    numVboBytes{v.numVboBytes},
+    vboOffset{v.vboOffset},
+    meshOffset{v.meshOffset},
+    baseVert{v.baseVert}
+{
+}
+
+/*-------------------------------------
+ * Move Constructor
+-------------------------------------*/
+VboGroupMarker::VboGroupMarker(VboGroupMarker&& v) noexcept :
+    vertType{v.vertType},
+    numVboBytes{v.numVboBytes},
+    vboOffset{v.vboOffset},
+    meshOffset{v.meshOffset},
+    baseVert{v.baseVert}
+{
+    v.vertType = (common_vertex_t)0;
+    v.numVboBytes = 0;
+    v.vboOffset = 0;
+    v.meshOffset = 0;
+    v.baseVert = 0;
+}
+
+/*-------------------------------------
+ * Copy Operator
+-------------------------------------*/
+VboGroupMarker& VboGroupMarker::operator=(const VboGroupMarker& v) noexcept
+{
+    vertType = v.vertType;
+    numVboBytes = v.numVboBytes;
+    vboOffset = v.vboOffset;
+    meshOffset = v.meshOffset;
+    baseVert = v.baseVert;
+    return *this;
+}
+
+/*-------------------------------------
+ * Move Operator
+-------------------------------------*/
+VboGroupMarker& VboGroupMarker::operator=(VboGroupMarker&& v) noexcept
+{
+    vertType = v.vertType;
+    v.vertType = (common_vertex_t)0;
+
+    numVboBytes = v.numVboBytes;
+    v.numVboBytes = 0;
+
+    vboOffset = v.vboOffset;
+    v.vboOffset = 0;
+
+    meshOffset = v.meshOffset;
+    v.meshOffset = 0;
+
+    baseVert = v.baseVert;
+    v.baseVert = 0;
+
+    return *this;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * SceneFilePreLoader Class
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Destructor
+-------------------------------------*/
+SceneFilePreLoader::~SceneFilePreLoader() noexcept
+{
+    unload();
+}
+
+
+
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+SceneFilePreLoader::SceneFilePreLoader() noexcept :
+    maxThreads{0},
+    filepath{},
+    importer{nullptr},
+    sceneInfo{},
+    sceneData{},
+    baseFileDir{"./"},
+    vboMarkers{},
+    texturePaths{},
+    cacheMode{SCENE_CACHE_DISABLED},
+    cache{},
+    cacheBlocks{},
+    pendingTextures{},
+    meshStats{},
+    gltfMappings{},
+    gltfBuffers{},
+    gltfRanges{},
+    profile{},
+    scratch{}
+{
+}
+
+
+
+/*-------------------------------------
+ * SceneResource Move Constructor
+-------------------------------------*/
+SceneFilePreLoader::SceneFilePreLoader(SceneFilePreLoader&& s) noexcept :
+    maxThreads{s.maxThreads},
+    filepath{std::move(s.filepath)},
+    importer{std::move(s.importer)},
+    sceneInfo{std::move(s.sceneInfo)},
+    sceneData{std::move(s.sceneData)},
+    baseFileDir{std::move(s.baseFileDir)},
+    vboMarkers{std::move(s.vboMarkers)},
+    texturePaths{std::move(s.texturePaths)},
+    cacheMode{s.cacheMode},
+    cache{std::move(s.cache)},
+    cacheBlocks{std::move(s.cacheBlocks)},
+    pendingTextures{std::move(s.pendingTextures)},
+    meshStats{std::move(s.meshStats)},
+    gltfMappings{std::move(s.gltfMappings)},
+    gltfBuffers{std::move(s.gltfBuffers)},
+    gltfRanges{std::move(s.gltfRanges)},
+    profile{std::move(s.profile)},
+    scratch{std::move(s.scratch)}
+{
+    s.cacheMode = SCENE_CACHE_DISABLED;
+}
+
+
+
+/*-------------------------------------
+ * Mesh Loader move operator
+-------------------------------------*/
+SceneFilePreLoader& SceneFilePreLoader::operator=(SceneFilePreLoader&& s) noexcept
+{
+    unload();
+
+    maxThreads = s.maxThreads;
+    filepath = std::move(s.filepath);
+    importer = std::move(s.importer);
+    sceneInfo = std::move(s.sceneInfo);
+    sceneData = std::move(s.sceneData);
+    baseFileDir = std::move(s.baseFileDir);
+    vboMarkers = std::move(s.vboMarkers);
+    texturePaths = std::move(s.texturePaths);
+
+    cacheMode = s.cacheMode;
+    s.cacheMode = SCENE_CACHE_DISABLED;
+
+    cache = std::move(s.cache);
+    cacheBlocks = std::move(s.cacheBlocks);
+    pendingTextures = std::move(s.pendingTextures);
+    meshStats = std::move(s.meshStats);
+    gltfMappings = std::move(s.gltfMappings);
+    gltfBuffers = std::move(s.gltfBuffers);
+    gltfRanges = std::move(s.gltfRanges);
+    profile = std::move(s.profile);
+    scratch = std::move(s.scratch);
+
+    return *this;
+}
+
+
+
+/*-------------------------------------
+ * Determine how many threads a stage of a load may use
+-------------------------------------*/
+unsigned SceneFilePreLoader::calc_num_threads(const size_t numTasks) const noexcept
+{
+    unsigned numThreads = maxThreads ? maxThreads : std::thread::hardware_concurrency();
+
+    numThreads = numThreads ? numThreads : 1;
+    return numTasks < numThreads ? (unsigned)numTasks : numThreads;
+}
 
 
 
@@ -200,7 +785,921 @@ void SceneFilePreLoader::unload() noexcept
 
     vboMarkers.clear();
 
-    texturePaths.clear();
+    texturePaths.clear();
+
+    cacheMode = SCENE_CACHE_DISABLED;
+
+    cache.close();
+
+    cacheBlocks.clear();
+
+    pendingTextures.clear();
+
+    meshStats.clear();
+
+    // Upload ranges reference the mappings and buffers.
+    gltfRanges.clear();
+
+    gltfBuffers.clear();
+
+    gltfMappings.clear();
+
+    scratch.reset();
+}
+
+
+
+/*-------------------------------------
+ * Load a set of meshes from a file
+-------------------------------------*/
+bool SceneFilePreLoader::load(
+    const std::string& filename,
+    const scene_cache_mode_t cacheFlags,
+    const common_vertex_t packedVertTypes,
+    const scene_import_profile_t importProfile
+) noexcept
+{
+    #if defined(LS_DRAW_BASE_VERTEX_SUPPORTED)
+        const uint32_t baseVertexDraws = (importProfile & SCENE_IMPORT_BASE_VERTEX) ? 1u : 0u;
+    #else
+        const uint32_t baseVertexDraws = 0;
+    #endif
+
+    unload();
+    sceneInfo.packedVertTypes = packedVertTypes;
+    sceneInfo.baseVertexDraws = baseVertexDraws;
+
+    profile.reset();
+    profile.filepath = filename;
+
+    if (cacheFlags & SCENE_CACHE_READ)
+    {
+        bool cacheLoaded;
+
+        {
+            SceneLoadTimer timer{profile, SCENE_LOAD_PHASE_FILE_READ};
+            cacheLoaded = load_cache(filename);
+        }
+
+        if (cacheLoaded)
+        {
+            profile.add_bytes(SCENE_LOAD_PHASE_FILE_READ, cache.get_size());
+            cacheMode = cacheFlags;
+            filepath = filename;
+            return true;
+        }
+
+        unload();
+        sceneInfo.packedVertTypes = packedVertTypes;
+        sceneInfo.baseVertexDraws = baseVertexDraws;
+    }
+
+    cacheMode = cacheFlags;
+
+    if (is_gltf_file(filename))
+    {
+        if (load_gltf(filename))
+        {
+            filepath = filename;
+            return true;
+        }
+
+        unload();
+        sceneInfo.packedVertTypes = packedVertTypes;
+        sceneInfo.baseVertexDraws = baseVertexDraws;
+        cacheMode = cacheFlags;
+
+        LS_LOG_MSG("\tUnable to import ", filename, " natively. Falling back to Assimp.");
+    }
+
+    LS_LOG_MSG("Attempting to load 3D mesh file ", filename, '.');
+
+    // load
+    importer.reset(new Assimp::Importer);
+
+    Assimp::Importer& fileImporter = *importer.get();
+    //fileImporter.SetPropertyBool(AI_CONFIG_IMPORT_NO_SKELETON_MESHES, true);
+    //fileImporter.SetPropertyBool(AI_CONFIG_PP_FD_REMOVE, true); // remove degenerate triangles
+    fileImporter.SetPropertyInteger(AI_CONFIG_FAVOUR_SPEED, AI_TRUE);
+
+    const unsigned importFlags = (importProfile & SCENE_IMPORT_FAST) ? SCENE_FILE_FAST_IMPORT_FLAGS : SCENE_FILE_IMPORT_FLAGS;
+    const aiScene* pImported;
+
+    {
+        SceneLoadTimer timer{profile, SCENE_LOAD_PHASE_FILE_READ};
+        pImported = fileImporter.ReadFile(filename.c_str(), importFlags);
+    }
+
+    if (!pImported)
+    {
+        LS_LOG_ERR(
+            "\tError: Unable to load the mesh file ", filename,
+            " due to an import error:\n\t", fileImporter.GetErrorString(), '\n'
+        );
+        unload();
+        return false;
+    }
+    else
+    {
+        LS_LOG_MSG("\tMesh file successfully imported. Running post-process optimization.");
+
+        const std::string::size_type baseDirIndex = filename.find_last_of(u8R"(\/)");
+        if (baseDirIndex != std::string::npos)
+        {
+            baseFileDir = filename.substr(0, baseDirIndex + 1);
+        }
+    }
+
+    const aiScene* pScene;
+
+    {
+        SceneLoadTimer timer{profile, SCENE_LOAD_PHASE_PRELOAD};
+
+        if (importProfile & SCENE_IMPORT_FAST)
+        {
+            // The importer owns its scene, which is modified in-place just as
+            // Assimp's own post-processing steps would.
+            weld_mesh_data(const_cast<aiScene*>(fileImporter.GetScene()));
+        }
+
+        pScene = preload_mesh_data();
+        profile.add_bytes(SCENE_LOAD_PHASE_PRELOAD, (uint64_t)sceneInfo.totalVboBytes + sceneInfo.totalIboBytes);
+    }
+
+    if (!pScene)
+    {
+        LS_LOG_ERR(
+            "\tError: Failed to process the 3D mesh file ",
+            filename, " in memory.\n"
+        );
+        unload();
+        return false;
+    }
+
+    bool cpuAllocated;
+
+    {
+        SceneLoadTimer timer{profile, SCENE_LOAD_PHASE_CPU_ALLOC};
+        cpuAllocated = allocate_cpu_data(pScene);
+    }
+
+    if (!cpuAllocated)
+    {
+        LS_LOG_ERR(
+            "\tError: Failed to allocate data for the 3D mesh file ",
+            filename, ".\n"
+        );
+        unload();
+        return false;
+    }
+
+    LS_LOG_MSG(
+        "\tDone. Successfully loaded the scene file \"", filename, ".\"",
+        "\n\t\tTotal Meshes:     ", sceneData.meshes.size(),
+        "\n\t\tTotal Textures:   ", sceneData.renderData.textures.size(),
+        "\n\t\tTotal Nodes:      ", sceneData.nodes.size(),
+        "\n\t\tTotal Cameras:    ", sceneData.cameras.size(),
+        "\n\t\tTotal Animations: ", sceneData.animations.size(),
+        '\n'
+    );
+
+    filepath = filename;
+
+    return true;
+}
+
+
+
+/*-------------------------------------
+ * Weld and instance all meshes in parallel
+-------------------------------------*/
+void SceneFilePreLoader::weld_mesh_data(aiScene* const pScene) noexcept
+{
+    const unsigned numMeshes = pScene->mNumMeshes;
+    std::vector<uint64_t> meshHashes(numMeshes, 0);
+    std::atomic_uint numWelded{0};
+    std::atomic_uint nextMeshId{0};
+    std::vector<std::thread> workers;
+    const unsigned numThreads = calc_num_threads(numMeshes);
+    workers.reserve(numThreads);
+
+    for (unsigned i = 1; i < numThreads; ++i)
+    {
+        try
+        {
+            workers.emplace_back(&SceneFilePreLoader::weld_meshes, this, pScene, std::ref(meshHashes), std::ref(numWelded), std::ref(nextMeshId));
+        }
+        catch (const std::system_error& e)
+        {
+            LS_LOG_ERR("\t\tUnable to start a mesh welding thread: ", e.what());
+            break;
+        }
+    }
+
+    weld_meshes(pScene, meshHashes, numWelded, nextMeshId);
+
+    for (std::thread& t : workers)
+    {
+        t.join();
+    }
+
+    const unsigned numInstanced = instance_mesh_data(pScene, meshHashes);
+
+    LS_LOG_MSG(
+        "\tWelded ", numWelded.load(), " vertices on ", workers.size() + 1, " threads.",
+        " Replaced ", numInstanced, " of ", numMeshes, " meshes with instances."
+    );
+}
+
+
+
+/*-------------------------------------
+ * Weld meshes until none remain
+-------------------------------------*/
+void SceneFilePreLoader::weld_meshes(
+    aiScene* const pScene,
+    std::vector<uint64_t>& outHashes,
+    std::atomic_uint& outNumWelded,
+    std::atomic_uint& nextMeshId
+) noexcept
+{
+    const unsigned numMeshes = pScene->mNumMeshes;
+    std::vector<char> vertices;
+    std::vector<uint32_t> remap;
+
+    for (unsigned meshId = nextMeshId.fetch_add(1); meshId < numMeshes; meshId = nextMeshId.fetch_add(1))
+    {
+        aiMesh* const pMesh = pScene->mMeshes[meshId];
+
+        outNumWelded += weld_assimp_mesh(pMesh, sceneInfo.packedVertTypes, vertices, remap);
+        outHashes[meshId] = hash_assimp_mesh(pMesh);
+    }
+}
+
+
+
+/*-------------------------------------
+ * Replace duplicate meshes with instances
+-------------------------------------*/
+unsigned SceneFilePreLoader::instance_mesh_data(aiScene* const pScene, const std::vector<uint64_t>& meshHashes) noexcept
+{
+    const unsigned numMeshes = pScene->mNumMeshes;
+    std::vector<unsigned> meshRemap(numMeshes, 0);
+    std::unordered_map<uint64_t, std::vector<unsigned>> uniqueMeshes;
+    unsigned numUnique = 0;
+
+    // Unique meshes are compacted towards the front of the scene's mesh
+    // list. Their new index is never ahead of the mesh being read.
+    for (unsigned meshId = 0; meshId < numMeshes; ++meshId)
+    {
+        aiMesh* const pMesh = pScene->mMeshes[meshId];
+        std::vector<unsigned>& candidates = uniqueMeshes[meshHashes[meshId]];
+        unsigned instanceId = numUnique;
+
+        for (const unsigned candidateId : candidates)
+        {
+            if (are_assimp_meshes_equal(pScene->mMeshes[candidateId], pMesh))
+            {
+                instanceId = candidateId;
+                break;
+            }
+        }
+
+        meshRemap[meshId] = instanceId;
+
+        if (instanceId == numUnique)
+        {
+            candidates.push_back(numUnique);
+            pScene->mMeshes[numUnique++] = pMesh;
+        }
+        else
+        {
+            delete pMesh;
+        }
+    }
+
+    for (unsigned meshId = numUnique; meshId < numMeshes; ++meshId)
+    {
+        pScene->mMeshes[meshId] = nullptr;
+    }
+
+    pScene->mNumMeshes = numUnique;
+
+    if (numUnique != numMeshes)
+    {
+        remap_assimp_node_meshes(pScene->mRootNode, meshRemap);
+    }
+
+    return numMeshes - numUnique;
+}
+
+
+
+/*-------------------------------------
+ * Verify *this contains data to pass to a SceneFileLoader
+-------------------------------------*/
+bool SceneFilePreLoader::is_loaded() const noexcept
+{
+    return cache.is_open() || !gltfMappings.empty() || (importer.get() && importer->GetScene() != nullptr);
+}
+
+
+
+/*-------------------------------------
+ * Perform a pre-processing step in
+ * order to ensure a one-time
+ * allocation of vertex+index data.
+-------------------------------------*/
+const aiScene* SceneFilePreLoader::preload_mesh_data() noexcept
+{
+    const aiScene* const pScene = importer->GetScene();
+
+    if (!pScene)
+    {
+        LS_LOG_ERR("\tERROR: Unable to pre-process a scene file in-memory.");
+        return nullptr;
+    }
+
+    for (unsigned meshIter = 0; meshIter < pScene->mNumMeshes; ++meshIter)
+    {
+        const aiMesh* const pMesh = pScene->mMeshes[meshIter];
+        const common_vertex_t inVertType = get_packed_vertex_types(convert_assimp_verts(pMesh), sceneInfo.packedVertTypes);
+        VboGroupMarker* outMeshMarker = get_matching_marker(inVertType, vboMarkers);
+
+        // Keep track of where in the output VBO a mesh's data should be placed.
+        // Use the following information to contiguously group all mesh
+        // vertices of similar types within the output VBO
+        if (!outMeshMarker)
+        {
+            vboMarkers.push_back(VboGroupMarker{});
+            outMeshMarker = &vboMarkers[vboMarkers.size() - 1];
+            outMeshMarker->vertType = inVertType;
+            outMeshMarker->numVboBytes = 0;
+            outMeshMarker->vboOffset = 0;
+            outMeshMarker->meshOffset = 0;
+            outMeshMarker->baseVert = 0;
+        }
+
+        const unsigned numMeshVerts = pMesh->mNumVertices;
+        const unsigned vertSize = get_vertex_byte_size(outMeshMarker->vertType);
+        const unsigned baseVert = vertSize ? (outMeshMarker->numVboBytes / vertSize) : 0;
+        sceneInfo.totalVertices += numMeshVerts;
+
+        const unsigned numMeshBytes = numMeshVerts * vertSize;
+        outMeshMarker->numVboBytes += numMeshBytes;
+        sceneInfo.totalVboBytes += numMeshBytes;
+
+        // NOTE: I don't believe grouping indices by type in a single IBO
+        // should matter, it's possible they can take advantage of the GPU's
+        // caches but we'll hold off on that for now.
+        unsigned numIndices = 0;
+        for (unsigned faceIter = 0; faceIter < pMesh->mNumFaces; ++faceIter)
+        {
+            numIndices += pMesh->mFaces[faceIter].mNumIndices;
+        }
+        sceneInfo.totalIndices += numIndices;
+
+        // Each mesh uses the smallest index type which can address its own
+        // vertices.
+        const index_element_t meshIndexType = get_mesh_index_type(baseVert, numMeshVerts, sceneInfo.baseVertexDraws != 0);
+        sceneInfo.totalIboBytes = get_mesh_index_offset(sceneInfo.totalIboBytes) + get_index_byte_size(meshIndexType) * numIndices;
+
+        if (get_index_byte_size(meshIndexType) > get_index_byte_size(sceneInfo.indexType))
+        {
+            sceneInfo.indexType = meshIndexType;
+        }
+    }
+
+    // calculate all of the vertex strides
+    unsigned totalVboOffset = 0;
+    for (VboGroupMarker& m : this->vboMarkers)
+    {
+        m.vboOffset = totalVboOffset;
+        totalVboOffset += m.numVboBytes;
+    }
+
+    LS_LOG_MSG(
+        "\tScene File Memory requirements:",
+        "\n\t\tVBO Byte Size:   ", sceneInfo.totalVboBytes,
+        "\n\t\tVertex Count:    ", sceneInfo.totalVertices,
+        "\n\t\tIBO Byte Size:   ", sceneInfo.totalIboBytes,
+        "\n\t\tIndex Count:     ", sceneInfo.totalIndices,
+        "\n\t\tVAO Count:       ", vboMarkers.size()
+    );
+    for (unsigned i = 0; i < vboMarkers.size(); ++i)
+    {
+        VboGroupMarker& m = vboMarkers[i];
+        LS_LOG_MSG("\t\t                 VAO ", i, ": 0x", std::hex, m.vertType, std::dec);
+
+        for (unsigned i = 0; i < COMMON_VERTEX_NAMES_COUNT; ++i)
+        {
+            if (!!(m.vertType & COMMON_VERTEX_FLAGS_LIST[i]))
+            {
+                LS_LOG_MSG("\t\t                        ", get_common_vertex_names()[i]);
+            }
+        }
+    }
+
+    return pScene;
+}
+
+
+
+/*-------------------------------------
+ * Allocate all required CPU-side memory for a scene.
+-------------------------------------*/
+bool SceneFilePreLoader::allocate_cpu_data(const aiScene* const pScene) noexcept
+{
+    sceneData.meshes.resize(pScene->mNumMeshes);
+    sceneData.skins.resize(pScene->mNumMeshes);
+    sceneData.morphs.resize(pScene->mNumMeshes);
+    sceneData.materials.resize(pScene->mNumMaterials);
+
+    for (SceneMaterial& m : sceneData.materials)
+    {
+        m.reset();
+    }
+
+    // reserve space for textures using ASSIMP's materials count, the
+    // "pScene->mNumTextures" member only counts textures saved into the file
+    // itself. Materials store file paths.
+    GLContextData& renderData = sceneData.renderData;
+    renderData.textures.reserve(pScene->mNumMaterials);
+
+    texturePaths.reserve(pScene->mNumMaterials);
+
+    // Reserve data here. There's no telling whether all nodes can be imported
+    // or not while Assimp's bones and lights remain unsupported.
+    const unsigned numSceneNodes = count_assimp_nodes(pScene->mRootNode);
+    sceneData.bounds.reserve(pScene->mNumMeshes);
+    sceneData.nodes.reserve(numSceneNodes);
+    sceneData.baseTransforms.reserve(numSceneNodes);
+    sceneData.currentTransforms.reserve(numSceneNodes);
+    sceneData.nodeNames.reserve(numSceneNodes);
+    sceneData.animations.reserve(pScene->mNumAnimations);
+    sceneData.cameras.reserve(pScene->mNumCameras);
+    sceneData.nodeMeshCounts.reserve(pScene->mNumMeshes);
+    sceneData.nodeMeshes.reserve(pScene->mNumMeshes);
+
+    profile_scene_allocation(profile, SCENE_LOAD_PHASE_CPU_ALLOC, sceneData.meshes);
+    profile_scene_allocation(profile, SCENE_LOAD_PHASE_CPU_ALLOC, sceneData.skins);
+    profile_scene_allocation(profile, SCENE_LOAD_PHASE_CPU_ALLOC, sceneData.morphs);
+    profile_scene_allocation(profile, SCENE_LOAD_PHASE_CPU_ALLOC, sceneData.materials);
+    profile_scene_allocation(profile, SCENE_LOAD_PHASE_CPU_ALLOC, sceneData.bounds);
+    profile_scene_allocation(profile, SCENE_LOAD_PHASE_CPU_ALLOC, sceneData.nodes);
+    profile_scene_allocation(profile, SCENE_LOAD_PHASE_CPU_ALLOC, sceneData.baseTransforms);
+    profile_scene_allocation(profile, SCENE_LOAD_PHASE_CPU_ALLOC, sceneData.currentTransforms);
+    profile_scene_allocation(profile, SCENE_LOAD_PHASE_CPU_ALLOC, sceneData.nodeNames);
+    profile_scene_allocation(profile, SCENE_LOAD_PHASE_CPU_ALLOC, sceneData.animations);
+    profile_scene_allocation(profile, SCENE_LOAD_PHASE_CPU_ALLOC, sceneData.cameras);
+    profile_scene_allocation(profile, SCENE_LOAD_PHASE_CPU_ALLOC, sceneData.nodeMeshCounts);
+    profile_scene_allocation(profile, SCENE_LOAD_PHASE_CPU_ALLOC, sceneData.nodeMeshes);
+
+    return true;
+}
+
+
+
+/*-------------------------------------
+ * Load all CPU-side memory for a scene from a binary cache.
+-------------------------------------*/
+bool SceneFilePreLoader::load_cache(const std::string& filename) noexcept
+{
+    const std::string&& cachePath = get_scene_cache_path(filename, sceneInfo.packedVertTypes, sceneInfo.baseVertexDraws != 0);
+
+    // A missing cache is expected the first time a file is loaded.
+    if (!cache.open(cachePath))
+    {
+        return false;
+    }
+
+    if (!cache.validate(filename))
+    {
+        cache.close();
+        return false;
+    }
+
+    LS_LOG_MSG("Attempting to load the 3D scene cache ", cachePath, '.');
+
+    const std::string::size_type baseDirIndex = filename.find_last_of(u8R"(\/)");
+    if (baseDirIndex != std::string::npos)
+    {
+        baseFileDir = filename.substr(0, baseDirIndex + 1);
+    }
+
+    // Element counts are validated against the remaining file size before
+    // any allocations. Reads become no-ops once the reader is invalid so the
+    // result only needs to be checked at the end.
+    SceneCacheReader r{cache.get_data(), cache.get_size(), sizeof(SceneCacheHeader)};
+    size_t count = 0;
+    const common_vertex_t packedVertTypes = sceneInfo.packedVertTypes;
+    const uint32_t baseVertexDraws = sceneInfo.baseVertexDraws;
+
+    // Vertex groups
+    r.read(sceneInfo);
+
+    if (r.is_valid() && sceneInfo.packedVertTypes != packedVertTypes)
+    {
+        LS_LOG_MSG("\tThe scene cache ", cachePath, " uses different vertex packing and will be regenerated.");
+        cache.close();
+        return false;
+    }
+
+    if (r.is_valid() && sceneInfo.baseVertexDraws != baseVertexDraws)
+    {
+        LS_LOG_MSG("\tThe scene cache ", cachePath, " uses different index offsets and will be regenerated.");
+        cache.close();
+        return false;
+    }
+    r.read_count(count, sizeof(common_vertex_t) + sizeof(unsigned) * 2);
+    vboMarkers.resize(count);
+
+    for (VboGroupMarker& m : vboMarkers)
+    {
+        r.read(m.vertType);
+        r.read(m.numVboBytes);
+        r.read(m.vboOffset);
+    }
+
+    // Textures are decoded by the SceneFileLoader.
+    r.read_count(count, sizeof(uint64_t) + sizeof(tex_wrap_t));
+    pendingTextures.resize(count);
+
+    for (std::pair<std::string, tex_wrap_t>& tex : pendingTextures)
+    {
+        r.read_string(tex.first);
+        r.read(tex.second);
+    }
+
+    // Materials reference textures by their index in "pendingTextures" until
+    // they have been uploaded.
+    r.read_count(count, sizeof(SceneMaterial::bindSlots) + sizeof(SceneMaterial::textures));
+    sceneData.materials.resize(count);
+
+    for (SceneMaterial& m : sceneData.materials)
+    {
+        m.reset();
+        r.read_array(m.bindSlots, active_texture_t::MAX_ACTIVE_TEXTURES);
+        r.read_array(m.textures, active_texture_t::MAX_ACTIVE_TEXTURES);
+    }
+
+    // Meshes, skins, and morphs share the same indices. VAO IDs are stored as
+    // indices into "vboMarkers."
+    r.read_count(count, sizeof(DrawCommandParams) + sizeof(MeshMetaData));
+    sceneData.meshes.resize(count);
+    sceneData.skins.resize(count);
+    sceneData.morphs.resize(count);
+
+    for (SceneMesh& m : sceneData.meshes)
+    {
+        m.reset();
+        r.read(m.drawParams);
+        r.read(m.metaData);
+    }
+
+    for (SceneSkin& s : sceneData.skins)
+    {
+        r.read_vector(s.boneIds);
+        r.read_vector(s.inverseBindPoses);
+    }
+
+    for (SceneMorph& m : sceneData.morphs)
+    {
+        r.read(m.baseVertex);
+        r.read(m.numVerts);
+        r.read_vector(m.vertOffsets);
+        r.read_vector(m.deltas);
+
+        r.read_count(count, sizeof(uint64_t));
+        m.targetNames.resize(count);
+
+        for (std::string& name : m.targetNames)
+        {
+            r.read_string(name);
+        }
+
+        r.read_vector(m.weights);
+    }
+
+    r.read_count(count, sizeof(math::vec3) * 2);
+    sceneData.bounds.resize(count);
+
+    for (BoundingBox& b : sceneData.bounds)
+    {
+        math::vec3 topRearRight, botFrontLeft;
+        r.read(topRearRight);
+        r.read(botFrontLeft);
+        b.set_top_rear_right(topRearRight);
+        b.set_bot_front_left(botFrontLeft);
+    }
+
+    // Node hierarchy
+    r.read_vector(sceneData.nodes);
+    r.read_vector(sceneData.baseTransforms);
+
+    const size_t numNodes = sceneData.nodes.size();
+    sceneData.currentTransforms.resize(numNodes);
+
+    for (size_t i = 0; i < numNodes && r.is_valid(); ++i)
+    {
+        Transform& t = sceneData.currentTransforms[i];
+        transform_type_t type;
+        math::vec3 position, scale;
+        math::quat orientation;
+
+        r.read(t.parentId);
+        r.read(type);
+        r.read(position);
+        r.read(scale);
+        r.read(orientation);
+
+        t.set_type(type);
+        t.set_position(position);
+        t.set_scale(scale);
+        t.set_orientation(orientation);
+
+        // Parents are always stored before their children.
+        if (t.parentId != SCENE_GRAPH_ROOT_ID && t.parentId < i)
+        {
+            t.apply_pre_transform(sceneData.currentTransforms[t.parentId].get_transform());
+        }
+    }
+
+    r.read_vector(sceneData.modelMatrices);
+
+    // Names are read into a single string, then interned.
+    std::string name;
+
+    r.read_count(count, sizeof(uint64_t));
+    sceneData.nodeNames.resize(count);
+
+    for (scene_name_t& nameId : sceneData.nodeNames)
+    {
+        r.read_string(name);
+        nameId = sceneData.nameTable.intern(name);
+    }
+
+    r.read_count(count, sizeof(projection_type_t) + sizeof(float) * 5);
+    sceneData.cameras.resize(count);
+
+    for (Camera& cam : sceneData.cameras)
+    {
+        projection_type_t projType = projection_type_t::PROJECTION_PERSPECTIVE;
+        float fov = 0.f, aspectW = 1.f, aspectH = 1.f, zNear = 0.f, zFar = 1.f;
+
+        r.read(projType);
+        r.read(fov);
+        r.read(aspectW);
+        r.read(aspectH);
+        r.read(zNear);
+        r.read(zFar);
+
+        cam.set_projection_type(projType);
+        cam.set_fov((unsigned)fov);
+        cam.set_aspect_ratio(aspectW, aspectH);
+        cam.set_near_plane(zNear);
+        cam.set_far_plane(zFar);
+        cam.update();
+    }
+
+    // Mesh node draw commands
+    r.read_vector(sceneData.nodeMeshCounts);
+    sceneData.nodeMeshes.reserve(sceneData.nodeMeshCounts.size());
+
+    for (const unsigned numMeshes : sceneData.nodeMeshCounts)
+    {
+        if (numMeshes > r.get_bytes_remaining() / sizeof(DrawCommandParams))
+        {
+            LS_LOG_ERR("\tError: Invalid mesh count in the scene cache ", cachePath, ".\n");
+            return false;
+        }
+
+        utils::Pointer<DrawCommandParams[]> drawParams{new DrawCommandParams[numMeshes]};
+        r.read_array(drawParams.get(), numMeshes);
+        sceneData.nodeMeshes.emplace_back(std::move(drawParams));
+    }
+
+    // Animations
+    r.read_count(count, sizeof(uint64_t));
+    sceneData.animations.resize(count);
+
+    // Channel indices are read into the same arrays for every animation so
+    // their storage is only allocated once.
+    std::vector<size_t> animIds, trackIds, transformIds, morphMeshIds;
+    std::vector<unsigned> morphTargetIds;
+
+    for (Animation& anim : sceneData.animations)
+    {
+        animation_play_t playMode = animation_play_t::ANIM_PLAY_DEFAULT;
+        anim_prec_t duration = 0.f, ticksPerSec = 0.f;
+
+        r.read_string(name);
+        r.read(playMode);
+        r.read(duration);
+        r.read(ticksPerSec);
+        r.read_vector(animIds);
+        r.read_vector(trackIds);
+        r.read_vector(transformIds);
+        r.read_vector(morphMeshIds);
+        r.read_vector(morphTargetIds);
+
+        if (animIds.size() != trackIds.size()
+        || animIds.size() != transformIds.size()
+        || morphMeshIds.size() != morphTargetIds.size()
+        ) {
+            LS_LOG_ERR("\tError: Mismatched animation channels in the scene cache ", cachePath, ".\n");
+            return false;
+        }
+
+        anim.set_anim_name(sceneData.nameTable, sceneData.nameTable.intern(name));
+        anim.set_play_mode(playMode);
+        anim.set_duration(duration);
+        anim.set_ticks_per_sec(ticksPerSec);
+        anim.reserve_anim_channels(animIds.size());
+
+        for (size_t i = 0; i < animIds.size(); ++i)
+        {
+            SceneNode node;
+            node.reset();
+            node.nodeId = transformIds[i];
+            node.animListId = animIds[i];
+            anim.add_anim_channel(node, trackIds[i]);
+        }
+
+        for (size_t i = 0; i < morphMeshIds.size(); ++i)
+        {
+            AnimationKeyListFloat frames;
+            read_cached_key_list(r, frames);
+            anim.add_morph_channel(morphMeshIds[i], morphTargetIds[i], std::move(frames));
+        }
+    }
+
+    r.read_count(count, sizeof(uint64_t));
+    sceneData.nodeAnims.resize(count);
+
+    for (std::vector<AnimationChannel>& channels : sceneData.nodeAnims)
+    {
+        r.read_count(count, sizeof(animation_flag_t) + sizeof(uint64_t) * 3);
+        channels.resize(count);
+
+        for (AnimationChannel& c : channels)
+        {
+            r.read(c.animationMode);
+            read_cached_key_list(r, c.positionFrames);
+            read_cached_key_list(r, c.scaleFrames);
+            read_cached_key_list(r, c.rotationFrames);
+        }
+    }
+
+    // Compressed payload blocks
+    r.read_vector(cacheBlocks);
+
+    const SceneCacheHeader& header = cache.get_header();
+    bool payloadsValid = false;
+
+    if (header.payloadEncoding == SCENE_CACHE_PAYLOAD_RAW)
+    {
+        payloadsValid = cacheBlocks.empty()
+            && header.vboBytes == sceneInfo.totalVboBytes
+            && header.iboBytes == sceneInfo.totalIboBytes;
+    }
+    else if (header.payloadEncoding == SCENE_CACHE_PAYLOAD_ENCODED)
+    {
+        payloadsValid = validate_cached_blocks(cacheBlocks, header, sceneInfo.totalVboBytes, sceneInfo.totalIboBytes);
+    }
+
+    if (!r.is_valid() || !payloadsValid || !validate_cached_scene(sceneData, pendingTextures.size()))
+    {
+        LS_LOG_ERR("\tError: The scene cache ", cachePath, " is corrupt.\n");
+        return false;
+    }
+
+    LS_LOG_MSG(
+        "\tDone. Successfully loaded the scene cache \"", cachePath, ".\"",
+        "\n\t\tTotal Meshes:     ", sceneData.meshes.size(),
+        "\n\t\tTotal Textures:   ", pendingTextures.size(),
+        "\n\t\tTotal Nodes:      ", sceneData.nodes.size(),
+        "\n\t\tTotal Cameras:    ", sceneData.cameras.size(),
+        "\n\t\tTotal Animations: ", sceneData.animations.size(),
+        '\n'
+    );
+
+    return true;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * SceneFileLoader Class
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Destructor
+-------------------------------------*/
+SceneFileLoader::~SceneFileLoader() noexcept
+{
+}
+
+
+
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+SceneFileLoader::SceneFileLoader() noexcept :
+    preloader{}
+{
+}
+
+
+
+/*-------------------------------------
+ * SceneResource Move Constructor
+-------------------------------------*/
+SceneFileLoader::SceneFileLoader(SceneFileLoader&& s) noexcept :
+    preloader{std::move(s.preloader)}
+{
+}
+
+
+
+/*-------------------------------------
+ * Mesh Loader move operator
+-------------------------------------*/
+SceneFileLoader& SceneFileLoader::operator=(SceneFileLoader&& s) noexcept
+{
+    preloader = std::move(s.preloader);
+
+    return *this;
+}
+
+
+
+/*-------------------------------------
+ * SceneResource Destructor
+-------------------------------------*/
+void SceneFileLoader::unload() noexcept
+{
+    preloader.unload();
+}
+
+
+
+/*-------------------------------------
+ * Load a set of meshes from a file
+-------------------------------------*/
+bool SceneFileLoader::load(
+    const std::string& filename,
+    const scene_cache_mode_t cacheFlags,
+    const common_vertex_t packedVertTypes,
+    const scene_import_profile_t importProfile
+) noexcept
+{
+    unload();
+
+    if (!preloader.load(filename, cacheFlags, packedVertTypes, importProfile))
+    {
+        return false;
+    }
+
+    if (preloader.cache.is_open())
+    {
+        return load_cached_scene();
+    }
+    else if (!preloader.gltfMappings.empty())
+    {
+        return load_gltf_scene();
+    }
+
+    return load_scene(preloader.importer->GetScene());
+}
+
+
+
+/*-------------------------------------
+ * Load a set of meshes from a file
+-------------------------------------*/
+bool SceneFileLoader::load(SceneFilePreLoader&& p) noexcept
+{
+    LS_DEBUG_ASSERT(&p != &preloader);
+
+    unload();
+
+    if (p.is_loaded())
+    {
+        preloader = std::move(p);
+
+        if (preloader.cache.is_open())
+        {
+            return load_cached_scene();
+        }
+        else if (!preloader.gltfMappings.empty())
+        {
+            return load_gltf_scene();
+        }
+
+        return load_scene(preloader.importer->GetScene());
+    }
+
+    return false;
 }
 
 
@@ -208,59 +1707,69 @@ void SceneFilePreLoader::unload() noexcept
 /*-------------------------------------
  * Load a set of meshes from a file
 -------------------------------------*/
-bool SceneFilePreLoader::load(const std::string& filename) noexcept
+bool SceneFileLoader::load_scene(const aiScene* const pScene) noexcept
 {
-    unload();
+    const std::string& filename = preloader.filepath;
+    SceneGraph& sceneData = preloader.sceneData;
 
-    LS_LOG_MSG("Attempting to load 3D mesh file ", filename, '.');
+    LS_LOG_MSG("\tAllocating GPU memory for 3D scene data.");
+    if (!allocate_gpu_data())
+    {
+        unload();
+        LS_LOG_ERR("\t\tUnable to initialize 3D scene data on the CPU.\n");
+        return false;
+    }
 
-    // load
-    importer.reset(new Assimp::Importer);
+    SceneLoadProfile& profile = preloader.profile;
+    bool ret;
 
-    Assimp::Importer& fileImporter = *importer.get();
-    //fileImporter.SetPropertyBool(AI_CONFIG_IMPORT_NO_SKELETON_MESHES, true);
-    //fileImporter.SetPropertyBool(AI_CONFIG_PP_FD_REMOVE, true); // remove degenerate triangles
-    fileImporter.SetPropertyInteger(AI_CONFIG_FAVOUR_SPEED, AI_TRUE);
+    {
+        SceneLoadTimer timer{profile, SCENE_LOAD_PHASE_TEXTURES};
+        ret = import_materials(pScene);
+    }
 
-    if (!fileImporter.ReadFile(filename.c_str(), SCENE_FILE_IMPORT_FLAGS))
+    if (!ret)
     {
-        LS_LOG_ERR(
-            "\tError: Unable to load the mesh file ", filename,
-            " due to an import error:\n\t", fileImporter.GetErrorString(), '\n'
-        );
+        LS_LOG_ERR("\tError: Unable to load materials for the 3D mesh ", filename, "!\n");
         unload();
         return false;
     }
-    else
-    {
-        LS_LOG_MSG("\tMesh file successfully imported. Running post-process optimization.");
 
-        const std::string::size_type baseDirIndex = filename.find_last_of(u8R"(\/)");
-        if (baseDirIndex != std::string::npos)
-        {
-            baseFileDir = filename.substr(0, baseDirIndex + 1);
-        }
+    {
+        SceneLoadTimer timer{profile, SCENE_LOAD_PHASE_MESHES};
+        ret = import_mesh_data(pScene);
+        profile.add_bytes(SCENE_LOAD_PHASE_MESHES, (uint64_t)preloader.sceneInfo.totalVboBytes + preloader.sceneInfo.totalIboBytes);
     }
 
-    const aiScene* const pScene = preload_mesh_data();
-    if (!pScene)
+    if (!ret)
     {
-        LS_LOG_ERR(
-            "\tError: Failed to process the 3D mesh file ",
-            filename, " in memory.\n"
-        );
+        LS_LOG_ERR("\tError: Failed to load the 3D mesh ", filename, "!\n");
         unload();
         return false;
     }
 
-    if (!allocate_cpu_data(pScene))
     {
-        LS_LOG_ERR(
-            "\tError: Failed to allocate data for the 3D mesh file ",
-            filename, ".\n"
-        );
-        unload();
-        return false;
+        SceneLoadTimer timer{profile, SCENE_LOAD_PHASE_HIERARCHY};
+
+        read_node_hierarchy(pScene, pScene->mRootNode, scene_property_t::SCENE_GRAPH_ROOT_ID);
+
+        import_mesh_skins(pScene);
+    }
+
+    for (const SceneNode n : sceneData.nodes)
+    {
+        const size_t nId = n.nodeId;
+        LS_LOG_MSG(nId, ' ', sceneData.currentTransforms[nId].parentId);
+    }
+
+    {
+        SceneLoadTimer timer{profile, SCENE_LOAD_PHASE_ANIMATIONS};
+        ret = import_animations(pScene);
+    }
+
+    if (!ret)
+    {
+        LS_LOG_ERR("\tWarning: Failed to animations from ", filename, "!\n");
     }
 
     LS_LOG_MSG(
@@ -273,7 +1782,16 @@ bool SceneFilePreLoader::load(const std::string& filename) noexcept
         '\n'
     );
 
-    filepath = filename;
+    if (preloader.cacheMode & SCENE_CACHE_WRITE)
+    {
+        SceneLoadTimer timer{preloader.profile, SCENE_LOAD_PHASE_CACHE_WRITE};
+        const std::string&& cachePath = get_scene_cache_path(filename, preloader.sceneInfo.packedVertTypes, preloader.sceneInfo.baseVertexDraws != 0);
+
+        if (!save_cache(cachePath))
+        {
+            LS_LOG_ERR("\tWarning: Unable to write the scene cache ", cachePath, ".\n");
+        }
+    }
 
     return true;
 }
@@ -281,290 +1799,420 @@ bool SceneFilePreLoader::load(const std::string& filename) noexcept
 
 
 /*-------------------------------------
- * Verify *this contains data to pass to a SceneFileLoader
+ * Upload a scene which was loaded from a binary cache
 -------------------------------------*/
-bool SceneFilePreLoader::is_loaded() const noexcept
+bool SceneFileLoader::load_cached_scene() noexcept
 {
-    return importer.get() && importer->GetScene() != nullptr;
+    SceneFileCache& cache = preloader.cache;
+    const SceneCacheHeader& header = cache.get_header();
+
+    // Raw vertex and index payloads are passed to OpenGL directly from the
+    // mapped file. Compressed payloads are decoded into the mapped buffers.
+    LS_LOG_MSG("\tUploading cached 3D scene data to the GPU.");
+
+    const bool isEncoded = header.payloadEncoding == SCENE_CACHE_PAYLOAD_ENCODED;
+    bool ret;
+
+    if (isEncoded)
+    {
+        ret = allocate_gpu_data(nullptr, nullptr);
+
+        if (ret)
+        {
+            SceneLoadTimer timer{preloader.profile, SCENE_LOAD_PHASE_MESHES};
+            ret = decode_cached_payloads();
+            preloader.profile.add_bytes(SCENE_LOAD_PHASE_MESHES, (uint64_t)preloader.sceneInfo.totalVboBytes + preloader.sceneInfo.totalIboBytes);
+        }
+    }
+    else
+    {
+        ret = allocate_gpu_data(cache.get_data() + header.vboOffset, cache.get_data() + header.iboOffset);
+    }
+
+    if (!ret)
+    {
+        unload();
+        LS_LOG_ERR("\t\tUnable to initialize cached 3D scene data on the GPU.\n");
+        return false;
+    }
+
+    // The mapping is no longer needed once its payload has been uploaded.
+    cache.close();
+
+    finalize_cached_scene();
+
+    return true;
 }
 
 
 
 /*-------------------------------------
- * Perform a pre-processing step in
- * order to ensure a one-time
- * allocation of vertex+index data.
+ * Upload a scene which was natively imported from a glTF file
 -------------------------------------*/
-const aiScene* SceneFilePreLoader::preload_mesh_data() noexcept
+bool SceneFileLoader::load_gltf_scene() noexcept
 {
-    const aiScene* const pScene = importer->GetScene();
+    const std::string& filename = preloader.filepath;
+    const SceneFileMetaData& sceneInfo = preloader.sceneInfo;
+    std::vector<SceneUploadRange>& ranges = preloader.gltfRanges;
 
-    if (!pScene)
+    LS_LOG_MSG("\tUploading glTF 3D scene data to the GPU.");
+
+    // A vertex layout which matches the source file exactly can be passed
+    // to OpenGL as-is. All other ranges are copied into the allocated
+    // buffers.
+    const void* pVboData = nullptr;
+    for (const SceneUploadRange& range : ranges)
     {
-        LS_LOG_ERR("\tERROR: Unable to pre-process a scene file in-memory.");
-        return nullptr;
+        if (!range.isIndexData && range.offset == 0 && range.numBytes == sceneInfo.totalVboBytes)
+        {
+            pVboData = range.pData;
+        }
     }
 
-    for (unsigned meshIter = 0; meshIter < pScene->mNumMeshes; ++meshIter)
+    if (!allocate_gpu_data(pVboData, nullptr))
     {
-        const aiMesh* const pMesh = pScene->mMeshes[meshIter];
-        const common_vertex_t inVertType = convert_assimp_verts(pMesh);
-        VboGroupMarker* outMeshMarker = get_matching_marker(inVertType, vboMarkers);
+        unload();
+        LS_LOG_ERR("\t\tUnable to initialize glTF 3D scene data on the GPU.\n");
+        return false;
+    }
 
-        // Keep track of where in the output VBO a mesh's data should be placed.
-        // Use the following information to contiguously group all mesh
-        // vertices of similar types within the output VBO
-        if (!outMeshMarker)
+    GLContextData& renderData = preloader.sceneData.renderData;
+
+    {
+        SceneLoadTimer timer{preloader.profile, SCENE_LOAD_PHASE_MESHES};
+
+        for (const SceneUploadRange& range : ranges)
         {
-            vboMarkers.push_back(VboGroupMarker{});
-            outMeshMarker = &vboMarkers[vboMarkers.size() - 1];
-            outMeshMarker->vertType = inVertType;
-            outMeshMarker->numVboBytes = 0;
-            outMeshMarker->vboOffset = 0;
-            outMeshMarker->meshOffset = 0;
-            outMeshMarker->baseVert = 0;
+            preloader.profile.add_bytes(SCENE_LOAD_PHASE_MESHES, range.numBytes);
         }
 
-        const unsigned numMeshVerts = pMesh->mNumVertices;
-        sceneInfo.totalVertices += numMeshVerts;
+        if (renderData.vbos.size() && renderData.vbos.back().is_valid() && !pVboData)
+        {
+            VertexBuffer& vbo = renderData.vbos.back();
+            vbo.bind();
 
-        const unsigned numMeshBytes = numMeshVerts * get_vertex_byte_size(outMeshMarker->vertType);
-        outMeshMarker->numVboBytes += numMeshBytes;
-        sceneInfo.totalVboBytes += numMeshBytes;
+            for (const SceneUploadRange& range : ranges)
+            {
+                if (!range.isIndexData)
+                {
+                    vbo.modify(range.offset, range.numBytes, range.pData);
+                }
+            }
 
-        // NOTE: I don't believe grouping indices by type in a single IBO
-        // should matter, it's possible they can take advantage of the GPU's
-        // caches but we'll hold off on that for now.
-        unsigned numIndices = 0;
-        for (unsigned faceIter = 0; faceIter < pMesh->mNumFaces; ++faceIter)
+            vbo.unbind();
+        }
+
+        if (renderData.ibos.size() && renderData.ibos.back().is_valid())
         {
-            numIndices += pMesh->mFaces[faceIter].mNumIndices;
+            IndexBuffer& ibo = renderData.ibos.back();
+            ibo.bind();
+
+            for (const SceneUploadRange& range : ranges)
+            {
+                if (range.isIndexData)
+                {
+                    ibo.modify(range.offset, range.numBytes, range.pData);
+                }
+            }
+
+            ibo.unbind();
         }
-        sceneInfo.totalIndices += numIndices;
     }
 
-    sceneInfo.indexType = get_required_index_type(sceneInfo.totalIndices);
-    sceneInfo.totalIboBytes = get_index_byte_size(sceneInfo.indexType) * sceneInfo.totalIndices;
+    // Mapped files and converted buffers are no longer needed once their
+    // data has been uploaded.
+    ranges.clear();
+    preloader.gltfBuffers.clear();
+    preloader.gltfMappings.clear();
 
-    // calculate all of the vertex strides
-    unsigned totalVboOffset = 0;
-    for (VboGroupMarker& m : this->vboMarkers)
-    {
-        m.vboOffset = totalVboOffset;
-        totalVboOffset += m.numVboBytes;
-    }
+    finalize_cached_scene();
 
-    LS_LOG_MSG(
-        "\tScene File Memory requirements:",
-        "\n\t\tVBO Byte Size:   ", sceneInfo.totalVboBytes,
-        "\n\t\tVertex Count:    ", sceneInfo.totalVertices,
-        "\n\t\tIBO Byte Size:   ", sceneInfo.totalIboBytes,
-        "\n\t\tIndex Count:     ", sceneInfo.totalIndices,
-        "\n\t\tVAO Count:       ", vboMarkers.size()
-    );
-    for (unsigned i = 0; i < vboMarkers.size(); ++i)
+    if (preloader.cacheMode & SCENE_CACHE_WRITE)
     {
-        VboGroupMarker& m = vboMarkers[i];
-        LS_LOG_MSG("\t\t                 VAO ", i, ": 0x", std::hex, m.vertType, std::dec);
+        SceneLoadTimer timer{preloader.profile, SCENE_LOAD_PHASE_CACHE_WRITE};
+        const std::string&& cachePath = get_scene_cache_path(filename, preloader.sceneInfo.packedVertTypes, preloader.sceneInfo.baseVertexDraws != 0);
 
-        for (unsigned i = 0; i < COMMON_VERTEX_NAMES_COUNT; ++i)
+        if (!save_cache(cachePath))
         {
-            if (!!(m.vertType & COMMON_VERTEX_FLAGS_LIST[i]))
-            {
-                LS_LOG_MSG("\t\t                        ", get_common_vertex_names()[i]);
-            }
+            LS_LOG_ERR("\tWarning: Unable to write the scene cache ", cachePath, ".\n");
         }
     }
 
-    return pScene;
+    return true;
 }
 
 
 
 /*-------------------------------------
- * Allocate all required CPU-side memory for a scene.
+ * Allocate streaming buffers for a scene loaded from a binary cache
 -------------------------------------*/
-bool SceneFilePreLoader::allocate_cpu_data(const aiScene* const pScene) noexcept
+bool SceneFileLoader::load_streamed_scene(const unsigned numVboBytes, const unsigned numIboBytes) noexcept
 {
-    sceneData.meshes.resize(pScene->mNumMeshes);
-    sceneData.materials.resize(pScene->mNumMaterials);
+    LS_LOG_MSG("\tAllocating GPU memory to stream cached 3D scene data.");
 
-    for (SceneMaterial& m : sceneData.materials)
+    // Mesh payloads remain within the mapped cache until they are requested.
+    if (!allocate_gpu_buffers(numVboBytes, numIboBytes, nullptr, nullptr, true))
     {
-        m.reset();
+        unload();
+        LS_LOG_ERR("\t\tUnable to initialize streamed 3D scene data on the GPU.\n");
+        return false;
     }
 
-    // reserve space for textures using ASSIMP's materials count, the
-    // "pScene->mNumTextures" member only counts textures saved into the file
-    // itself. Materials store file paths.
-    GLContextData& renderData = sceneData.renderData;
-    renderData.textures.reserve(pScene->mNumMaterials);
-
-    texturePaths.reserve(pScene->mNumMaterials);
-
-    // Reserve data here. There's no telling whether all nodes can be imported
-    // or not while Assimp's bones and lights remain unsupported.
-    const unsigned numSceneNodes = count_assimp_nodes(pScene->mRootNode);
-    sceneData.bounds.reserve(numSceneNodes);
-    sceneData.nodes.reserve(numSceneNodes);
-    sceneData.baseTransforms.reserve(numSceneNodes);
-    sceneData.currentTransforms.reserve(numSceneNodes);
-    sceneData.nodeNames.reserve(numSceneNodes);
-    sceneData.animations.reserve(pScene->mNumAnimations);
-    sceneData.cameras.reserve(pScene->mNumCameras);
-    sceneData.nodeMeshCounts.reserve(pScene->mNumMeshes);
-    sceneData.nodeMeshes.reserve(pScene->mNumMeshes);
+    finalize_cached_scene();
 
     return true;
 }
 
 
 
-/*-----------------------------------------------------------------------------
- * SceneFileLoader Class
------------------------------------------------------------------------------*/
 /*-------------------------------------
- * Destructor
+ * Remap cached GPU handles and import textures
 -------------------------------------*/
-SceneFileLoader::~SceneFileLoader() noexcept
+void SceneFileLoader::finalize_cached_scene() noexcept
 {
-}
+    const std::string& filename = preloader.filepath;
+    SceneGraph& sceneData = preloader.sceneData;
+    GLContextData& renderData = sceneData.renderData;
+    const VAODataList& vaos = renderData.vaos;
+    const GLuint vboId = renderData.vbos.size() ? renderData.vbos.back().gpu_id() : 0;
+    const GLuint iboId = renderData.ibos.size() ? renderData.ibos.back().gpu_id() : 0;
 
+    const auto remapVao = [&](DrawCommandParams& drawParams) -> void
+    {
+        drawParams.vaoId = drawParams.vaoId < vaos.size() ? vaos[drawParams.vaoId].gpu_id() : 0;
+    };
 
+    for (SceneMesh& mesh : sceneData.meshes)
+    {
+        remapVao(mesh.drawParams);
+        mesh.vboId = vboId;
+        mesh.iboId = iboId;
+    }
 
-/*-------------------------------------
- * Constructor
--------------------------------------*/
-SceneFileLoader::SceneFileLoader() noexcept :
-    preloader{}
-{
-}
+    for (size_t i = 0; i < sceneData.nodeMeshes.size(); ++i)
+    {
+        for (unsigned j = 0; j < sceneData.nodeMeshCounts[i]; ++j)
+        {
+            remapVao(sceneData.nodeMeshes[i][j]);
+        }
+    }
 
+    {
+        SceneLoadTimer timer{preloader.profile, SCENE_LOAD_PHASE_TEXTURES};
+        import_pending_textures();
+    }
 
+    if (sceneData.animations.size() > 0)
+    {
+        Animation& initialState = sceneData.animations[0];
+        initialState.init(sceneData);
+    }
 
-/*-------------------------------------
- * SceneResource Move Constructor
--------------------------------------*/
-SceneFileLoader::SceneFileLoader(SceneFileLoader&& s) noexcept :
-    preloader{std::move(s.preloader)}
-{
+    LS_LOG_MSG(
+        "\tDone. Successfully uploaded the scene file \"", filename, ".\"",
+        "\n\t\tTotal Meshes:     ", sceneData.meshes.size(),
+        "\n\t\tTotal Textures:   ", sceneData.renderData.textures.size(),
+        "\n\t\tTotal Nodes:      ", sceneData.nodes.size(),
+        "\n\t\tTotal Cameras:    ", sceneData.cameras.size(),
+        "\n\t\tTotal Animations: ", sceneData.animations.size(),
+        '\n'
+    );
 }
 
 
 
 /*-------------------------------------
- * Mesh Loader move operator
+ * Decode compressed cache payloads into the GPU buffers
 -------------------------------------*/
-SceneFileLoader& SceneFileLoader::operator=(SceneFileLoader&& s) noexcept
+bool SceneFileLoader::decode_cached_payloads() noexcept
 {
-    preloader = std::move(s.preloader);
+    SceneGraph& sceneData = preloader.sceneData;
+    GLContextData& renderData = sceneData.renderData;
+    const SceneFileMetaData& sceneInfo = preloader.sceneInfo;
+    const std::vector<SceneCachePayloadBlock>& blocks = preloader.cacheBlocks;
+    const SceneFileCache& cache = preloader.cache;
+    const SceneCacheHeader& header = cache.get_header();
 
-    return *this;
-}
+    char* const pVbo = (sceneInfo.totalVboBytes && renderData.vbos.size()) ? map_scene_file_buffer(renderData.vbos.back(), sceneInfo.totalVboBytes) : nullptr;
+    char* const pIbo = (sceneInfo.totalIboBytes && renderData.ibos.size()) ? map_scene_file_buffer(renderData.ibos.back(), sceneInfo.totalIboBytes) : nullptr;
+    std::atomic_bool succeeded{(pVbo || !sceneInfo.totalVboBytes) && (pIbo || !sceneInfo.totalIboBytes)};
+
+    if (succeeded)
+    {
+        std::atomic_size_t nextBlock{0};
+        std::vector<std::thread> workers;
+        const unsigned numThreads = preloader.calc_num_threads(blocks.size());
+        workers.reserve(numThreads);
 
+        for (unsigned i = 1; i < numThreads; ++i)
+        {
+            try
+            {
+                workers.emplace_back(
+                    &decode_cached_blocks,
+                    std::cref(blocks),
+                    cache.get_data() + header.vboOffset,
+                    cache.get_data() + header.iboOffset,
+                    pVbo,
+                    pIbo,
+                    std::ref(nextBlock),
+                    std::ref(succeeded)
+                );
+            }
+            catch (const std::system_error& e)
+            {
+                LS_LOG_ERR("\t\tUnable to start a payload decoding thread: ", e.what());
+                break;
+            }
+        }
 
+        LS_LOG_MSG("\t\tDecoding ", blocks.size(), " compressed blocks on ", workers.size() + 1, " threads.");
 
-/*-------------------------------------
- * SceneResource Destructor
--------------------------------------*/
-void SceneFileLoader::unload() noexcept
-{
-    preloader.unload();
-}
+        decode_cached_blocks(blocks, cache.get_data() + header.vboOffset, cache.get_data() + header.iboOffset, pVbo, pIbo, nextBlock, succeeded);
 
+        for (std::thread& t : workers)
+        {
+            t.join();
+        }
+    }
 
+    if (pVbo)
+    {
+        renderData.vbos.back().unmap_data();
+        renderData.vbos.back().unbind();
+    }
 
-/*-------------------------------------
- * Load a set of meshes from a file
--------------------------------------*/
-bool SceneFileLoader::load(const std::string& filename) noexcept
-{
-    unload();
+    if (pIbo)
+    {
+        renderData.ibos.back().unmap_data();
+        renderData.ibos.back().unbind();
+    }
 
-    if (!preloader.load(filename))
+    if (!succeeded)
     {
-        return false;
+        LS_LOG_ERR("\t\tFailed to decode the compressed vertices and indices of a scene cache.");
     }
 
-    return load_scene(preloader.importer->GetScene());
+    return succeeded;
 }
 
 
 
 /*-------------------------------------
- * Load a set of meshes from a file
+ * Decode and upload all pending textures
 -------------------------------------*/
-bool SceneFileLoader::load(SceneFilePreLoader&& p) noexcept
+void SceneFileLoader::import_pending_textures() noexcept
 {
-    LS_DEBUG_ASSERT(&p != &preloader);
+    std::vector<std::pair<std::string, tex_wrap_t>>& pendingTextures = preloader.pendingTextures;
+    std::vector<SceneMaterial>& materials = preloader.sceneData.materials;
+    TextureDataList& textures = preloader.sceneData.renderData.textures;
+    const size_t numTextures = pendingTextures.size();
+    std::vector<GLuint> texIds(numTextures, 0);
+    std::vector<size_t> texIndices(numTextures, material_property_t::INVALID_MATERIAL_TEXTURE);
 
-    unload();
+    LS_LOG_MSG("\tImporting ", numTextures, " textures.");
 
-    if (p.is_loaded())
+    if (numTextures)
     {
-        preloader = std::move(p);
-        return load_scene(preloader.importer->GetScene());
-    }
+        TextureDecodeQueue decodeQueue{pendingTextures};
+        std::vector<std::thread> workers;
+        const unsigned numThreads = preloader.calc_num_threads(numTextures);
+        workers.reserve(numThreads);
 
-    return false;
-}
+        for (unsigned i = 0; i < numThreads; ++i)
+        {
+            try
+            {
+                workers.emplace_back(&decode_pending_textures, std::ref(decodeQueue));
+            }
+            catch (const std::system_error& e)
+            {
+                LS_LOG_ERR("\t\tUnable to start a texture decoding thread: ", e.what());
+                break;
+            }
+        }
 
+        // Decode everything here if no threads could be started.
+        if (workers.empty())
+        {
+            decode_pending_textures(decodeQueue);
+        }
 
+        LS_LOG_MSG("\t\tDecoding textures on ", workers.size(), " threads.");
 
-/*-------------------------------------
- * Load a set of meshes from a file
--------------------------------------*/
-bool SceneFileLoader::load_scene(const aiScene* const pScene) noexcept
-{
-    const std::string& filename = preloader.filepath;
-    SceneGraph& sceneData = preloader.sceneData;
+        utils::Pointer<TextureAssembly> texMaker{new TextureAssembly{}};
+        textures.reserve(textures.size() + numTextures);
 
-    LS_LOG_MSG("\tAllocating GPU memory for 3D scene data.");
-    if (!allocate_gpu_data())
-    {
-        unload();
-        LS_LOG_ERR("\t\tUnable to initialize 3D scene data on the CPU.\n");
-        return false;
-    }
+        // Upload in list order so texture indices never depend on which
+        // thread finished first.
+        for (size_t i = 0; i < numTextures; ++i)
+        {
+            texture_decode_status_t decodeStatus;
 
-    if (!import_materials(pScene))
-    {
-        LS_LOG_ERR("\tError: Unable to load materials for the 3D mesh ", filename, "!\n");
-        unload();
-        return false;
-    }
+            {
+                std::unique_lock<std::mutex> lock{decodeQueue.lock};
+                decodeQueue.cond.wait(lock, [&]() -> bool
+                {
+                    return decodeQueue.status[i] != texture_decode_status_t::TEXTURE_DECODE_PENDING;
+                });
+                decodeStatus = decodeQueue.status[i];
+            }
 
-    if (!import_mesh_data(pScene))
-    {
-        LS_LOG_ERR("\tError: Failed to load the 3D mesh ", filename, "!\n");
-        unload();
-        return false;
+            const std::string& texPath = pendingTextures[i].first;
+            ImageBuffer& img = decodeQueue.images[i];
+
+            if (decodeStatus == texture_decode_status_t::TEXTURE_DECODE_SUCCESS)
+            {
+                texMaker->clear();
+                texIndices[i] = upload_texture(img, *texMaker, pendingTextures[i].second);
+
+                preloader.profile.add_bytes(SCENE_LOAD_PHASE_TEXTURES, img.get_num_bytes());
+                preloader.profile.add_allocation(SCENE_LOAD_PHASE_TEXTURES, img.get_num_bytes());
+            }
+
+            // Release each image as soon as possible to limit peak memory.
+            img.unload();
+
+            if (texIndices[i] != material_property_t::INVALID_MATERIAL_TEXTURE)
+            {
+                texIds[i] = textures[texIndices[i]].gpu_id();
+            }
+            else
+            {
+                LS_LOG_ERR("\t\t\tFailed to load the texture ", texPath);
+            }
+        }
+
+        for (std::thread& t : workers)
+        {
+            t.join();
+        }
     }
 
-    read_node_hierarchy(pScene, pScene->mRootNode, scene_property_t::SCENE_GRAPH_ROOT_ID);
+    // Only successfully uploaded textures can be referenced by path.
+    std::unordered_map<std::string, size_t>& texturePaths = preloader.texturePaths;
+    texturePaths.clear();
 
-    for (const SceneNode n : sceneData.nodes)
+    for (size_t i = 0; i < numTextures; ++i)
     {
-        const size_t nId = n.nodeId;
-        LS_LOG_MSG(nId, ' ', sceneData.currentTransforms[nId].parentId);
+        if (texIndices[i] != material_property_t::INVALID_MATERIAL_TEXTURE)
+        {
+            texturePaths[pendingTextures[i].first] = texIndices[i];
+        }
     }
 
-    if (!import_animations(pScene))
+    for (SceneMaterial& m : materials)
     {
-        LS_LOG_ERR("\tWarning: Failed to animations from ", filename, "!\n");
+        for (unsigned slot = 0; slot < active_texture_t::MAX_ACTIVE_TEXTURES; ++slot)
+        {
+            const GLuint texIndex = m.textures[slot];
+            m.textures[slot] = texIndex < texIds.size() ? texIds[texIndex] : 0;
+        }
     }
 
-    LS_LOG_MSG(
-        "\tDone. Successfully loaded the scene file \"", filename, ".\"",
-        "\n\t\tTotal Meshes:     ", sceneData.meshes.size(),
-        "\n\t\tTotal Textures:   ", sceneData.renderData.textures.size(),
-        "\n\t\tTotal Nodes:      ", sceneData.nodes.size(),
-        "\n\t\tTotal Cameras:    ", sceneData.cameras.size(),
-        "\n\t\tTotal Animations: ", sceneData.animations.size(),
-        '\n'
-    );
+    pendingTextures.clear();
 
-    return true;
+    LS_LOG_MSG("\t\tDone.");
 }
 
 
@@ -572,12 +2220,39 @@ bool SceneFileLoader::load_scene(const aiScene* const pScene) noexcept
 /*-------------------------------------
  * Allocate all required GPU-side memory for a scene.
 -------------------------------------*/
-bool SceneFileLoader::allocate_gpu_data() noexcept
+bool SceneFileLoader::allocate_gpu_data(const void* const pVboData, const void* const pIboData) noexcept
+{
+    const SceneFileMetaData& sceneInfo = preloader.sceneInfo;
+
+    return allocate_gpu_buffers(
+        sceneInfo.totalVertices ? sceneInfo.totalVboBytes : 0,
+        sceneInfo.totalIndices ? sceneInfo.totalIboBytes : 0,
+        pVboData,
+        pIboData,
+        false
+    );
+}
+
+
+
+/*-------------------------------------
+ * Allocate GPU buffers of a specific size
+-------------------------------------*/
+bool SceneFileLoader::allocate_gpu_buffers(
+    const unsigned numVboBytes,
+    const unsigned numIboBytes,
+    const void* const pVboData,
+    const void* const pIboData,
+    const bool isStreamed
+) noexcept
 {
     SceneGraph& sceneData = preloader.sceneData;
-    std::vector<VboGroupMarker> vboMarkers = preloader.vboMarkers;
-    SceneFileMetaData& sceneInfo = preloader.sceneInfo;
+    const std::vector<VboGroupMarker>& vboMarkers = preloader.vboMarkers;
     GLContextData& renderData = sceneData.renderData;
+    const buffer_access_t usage = isStreamed ? buffer_access_t::VBO_DYNAMIC_DRAW : buffer_access_t::VBO_STATIC_DRAW;
+
+    SceneLoadProfile& profile = preloader.profile;
+    SceneLoadTimer timer{profile, SCENE_LOAD_PHASE_GPU_ALLOC};
 
     VertexBuffer vbo;
     IndexBuffer ibo;
@@ -589,7 +2264,13 @@ bool SceneFileLoader::allocate_gpu_data() noexcept
     }
 
     size_t totalMeshTypes = vboMarkers.size();
-    utils::Pointer<common_vertex_t[]> vertTypes{new common_vertex_t[totalMeshTypes]};
+    common_vertex_t* const vertTypes = preloader.scratch.allocate_array<common_vertex_t>(totalMeshTypes);
+
+    if (!vertTypes)
+    {
+        LS_LOG_ERR("\t\tFailed to allocate the vertex types for the currently loading scene file.");
+        return false;
+    }
 
     // initialize the VBO attributes
     for (unsigned i = 0; i < vboMarkers.size(); ++i)
@@ -597,22 +2278,25 @@ bool SceneFileLoader::allocate_gpu_data() noexcept
         vertTypes[i] = vboMarkers[i].vertType;
     }
 
-    if (sceneInfo.totalVertices)
+    if (numVboBytes)
     {
-        if (!vbo.init() || !vbo.setup_attribs(vertTypes.get(), (unsigned)totalMeshTypes))
+        if (!vbo.init() || !vbo.setup_attribs(vertTypes, (unsigned)totalMeshTypes))
         {
             LS_LOG_ERR("\t\tFailed to initialize a VBO to hold all mesh data for the currently loading scene file.");
             return false;
         }
 
         vbo.bind();
-        vbo.set_data(sceneInfo.totalVboBytes, nullptr, buffer_access_t::VBO_STATIC_DRAW);
+        vbo.set_data(numVboBytes, pVboData, usage);
         vbo.unbind();
 
-        LS_LOG_MSG("\t\tAllocated ", sceneInfo.totalVboBytes, " bytes for ", vboMarkers.size(), " types of vertices.");
+        profile.add_allocation(SCENE_LOAD_PHASE_GPU_ALLOC, numVboBytes);
+        profile.add_bytes(SCENE_LOAD_PHASE_GPU_ALLOC, pVboData ? numVboBytes : 0);
+
+        LS_LOG_MSG("\t\tAllocated ", numVboBytes, " bytes for ", vboMarkers.size(), " types of vertices.");
     }
 
-    if (sceneInfo.totalIndices)
+    if (numIboBytes)
     {
         // We're only creating one IBO for loading mesh data
         if (!ibo.init() || !ibo.setup_attribs(1))
@@ -623,21 +2307,16 @@ bool SceneFileLoader::allocate_gpu_data() noexcept
         }
 
         ibo.bind();
-        ibo.set_data(sceneInfo.totalIboBytes, nullptr, buffer_access_t::VBO_STATIC_DRAW);
+        ibo.set_data(numIboBytes, pIboData, usage);
         ibo.unbind();
-        LS_LOG_MSG("\t\tAllocated ", sceneInfo.totalIboBytes, " bytes for indices.");
-    }
 
-    utils::Pointer<VAOAssembly> assembly{new(std::nothrow) VAOAssembly{}};
-
-    if (!assembly)
-    {
-        LS_LOG_ERR("\t\tFailed to instantiate a VAO assembly pipeline for the currently loading scene file.");
-        vbo.terminate();
-        ibo.terminate();
-        return false;
+        profile.add_allocation(SCENE_LOAD_PHASE_GPU_ALLOC, numIboBytes);
+        profile.add_bytes(SCENE_LOAD_PHASE_GPU_ALLOC, pIboData ? numIboBytes : 0);
+        LS_LOG_MSG("\t\tAllocated ", numIboBytes, " bytes for indices.");
     }
 
+    VAOAssembly assembly;
+
     // Start adding the mesh descriptors and GL handles
     VAODataList& vaos = renderData.vaos;
     vaos.clear();
@@ -651,19 +2330,24 @@ bool SceneFileLoader::allocate_gpu_data() noexcept
         VertexArray vao{};
         common_vertex_t inAttribs = vertTypes[i];
         unsigned currentVaoAttribId = 0;
-        VboGroupMarker& m = vboMarkers[i];
+        const VboGroupMarker& m = vboMarkers[i];
+
+        // Streamed meshes can be placed anywhere within the VBO. Each VAO
+        // starts at the beginning of the buffer and meshes are located using
+        // a base vertex.
+        const unsigned vboOffset = isStreamed ? 0 : m.vboOffset;
 
-        assembly->clear();
+        assembly.clear();
 
         for (unsigned k = 0; k < COMMON_VERTEX_FLAGS_COUNT; ++k)
         {
             if (0 != (inAttribs & COMMON_VERTEX_FLAGS_LIST[k]))
             {
                 VBOAttrib& a = vbo.get_attrib(currentVboAttribId);
-                a.set_offset((void*)(ptrdiff_t)(m.vboOffset + get_vertex_attrib_offset(inAttribs, COMMON_VERTEX_FLAGS_LIST[k])));
+                a.set_offset((void*)(ptrdiff_t)(vboOffset + get_vertex_attrib_offset(inAttribs, COMMON_VERTEX_FLAGS_LIST[k])));
 
-                assembly->set_vbo_attrib(currentVaoAttribId, vbo, currentVboAttribId);
-                assembly->set_attrib_name(currentVaoAttribId, attribNames[k]);
+                assembly.set_vbo_attrib(currentVaoAttribId, vbo, currentVboAttribId);
+                assembly.set_attrib_name(currentVaoAttribId, attribNames[k]);
                 currentVboAttribId++;
                 currentVaoAttribId++;
             }
@@ -671,11 +2355,12 @@ bool SceneFileLoader::allocate_gpu_data() noexcept
 
         if (ibo.is_valid())
         {
-            assembly->set_ibo_attrib(ibo);
+            assembly.set_ibo_attrib(ibo);
         }
 
-        LS_ASSERT(assembly->assemble(vao));
+        LS_ASSERT(assembly.assemble(vao));
         vaos.add(std::move(vao));
+        profile.add_allocation(SCENE_LOAD_PHASE_GPU_ALLOC);
     }
 
     renderData.vbos.add(std::move(vbo));
@@ -718,21 +2403,29 @@ bool SceneFileLoader::import_materials(const aiScene* const pScene) noexcept
 
     SceneGraph& sceneData = preloader.sceneData;
     std::vector<SceneMaterial>& materials = sceneData.materials;
-    utils::Pointer<TextureAssembly> texMaker{new TextureAssembly{}};
-    utils::Pointer<ImageBuffer> imgLoader{new ImageBuffer{}};
+
+    // Gather all unique texture paths first. Material slots reference the
+    // pending texture list until every image has been decoded and uploaded.
+    preloader.pendingTextures.clear();
+    preloader.texturePaths.clear();
 
     for (unsigned i = 0; i < numMaterials; ++i)
     {
         const aiMaterial* const pMaterial = pScene->mMaterials[i];
         SceneMaterial& newMaterial = materials[i];
 
+        utils::fast_fill(newMaterial.textures, (GLuint)material_property_t::INVALID_MATERIAL_TEXTURE, active_texture_t::MAX_ACTIVE_TEXTURES);
+
         for (unsigned j = 0; j < LS_ARRAY_SIZE(texTypes); ++j)
         {
-            import_texture_path(pMaterial, texTypes[j], newMaterial, *imgLoader, *texMaker);
+            import_texture_path(pMaterial, texTypes[j], newMaterial);
         }
     }
 
     LS_LOG_MSG("\t\tDone.");
+
+    import_pending_textures();
+
     return true;
 }
 
@@ -744,17 +2437,9 @@ bool SceneFileLoader::import_materials(const aiScene* const pScene) noexcept
 void SceneFileLoader::import_texture_path(
     const aiMaterial* const pMaterial,
     const int slotType,
-    SceneMaterial& outMaterial,
-    ImageBuffer& imgLoader,
-    TextureAssembly& texAssembly
+    SceneMaterial& outMaterial
 ) noexcept
 {
-    imgLoader.unload();
-    texAssembly.clear();
-
-    SceneGraph& sceneData = preloader.sceneData;
-    GLContextData& renderData = sceneData.renderData;
-    TextureDataList& textures = renderData.textures;
     const unsigned maxTexCount = pMaterial->GetTextureCount((aiTextureType)slotType);
 
     switch (slotType)
@@ -818,32 +2503,23 @@ void SceneFileLoader::import_texture_path(
         const std::string& baseFileDir = preloader.baseFileDir;
         const std::string texPath{baseFileDir + inPath.C_Str()};
         std::unordered_map<std::string, size_t>& texturePaths = preloader.texturePaths;
+        std::vector<std::pair<std::string, tex_wrap_t>>& pendingTextures = preloader.pendingTextures;
         const std::unordered_map<std::string, size_t>::const_iterator iter = texturePaths.find(texPath);
-        GLuint texId = 0;
+        size_t texIndex;
 
         if (iter != texturePaths.cend())
         {
             LS_LOG_MSG("\t\t\tDuplicate texture detected: ", texPath);
-            const Texture& loadedTex = renderData.textures[iter->second];
-            texId = loadedTex.gpu_id();
+            texIndex = iter->second;
         }
         else
         {
-            const tex_wrap_t wrapMode = convert_assimp_tex_wrapping(inWrapMode);
-            const size_t texIndex = load_texture_at_path(texPath, imgLoader, texAssembly, wrapMode);
-
-            if (texIndex != material_property_t::INVALID_MATERIAL_TEXTURE)
-            {
-                texId = textures[texIndex].gpu_id();
-                texturePaths[texPath] = texIndex;
-            }
-            else
-            {
-                // only set the texture to 0, don't modify the bind slot in
-                // case something still needs to be rendered. OpenGL will just
-                // use a black texture.
-                texId = 0;
-            }
+            // Textures which fail to load are remapped to 0 later on. The
+            // bind slot is left intact in case something still needs to be
+            // rendered. OpenGL will just use a black texture.
+            texIndex = pendingTextures.size();
+            texturePaths[texPath] = texIndex;
+            pendingTextures.emplace_back(texPath, convert_assimp_tex_wrapping(inWrapMode));
         }
 
         // redundancy
@@ -853,7 +2529,7 @@ void SceneFileLoader::import_texture_path(
         }
         else
         {
-            outMaterial.textures[activeTexSlot] = texId;
+            outMaterial.textures[activeTexSlot] = (GLuint)texIndex;
         }
     }
 }
@@ -861,11 +2537,10 @@ void SceneFileLoader::import_texture_path(
 
 
 /*-------------------------------------
- * Attempt to load a texture from the local filesystem
+ * Upload a decoded texture to the GPU
 -------------------------------------*/
-size_t SceneFileLoader::load_texture_at_path(
-    const std::string& path,
-    ImageBuffer& imgLoader,
+size_t SceneFileLoader::upload_texture(
+    const ImageBuffer& imgLoader,
     TextureAssembly& texAssembly,
     const tex_wrap_t wrapMode
 ) noexcept
@@ -873,11 +2548,6 @@ size_t SceneFileLoader::load_texture_at_path(
     TextureDataList& textures = preloader.sceneData.renderData.textures;
     Texture outTex;
 
-    if (imgLoader.load_file(path) != ImageBuffer::img_status_t::FILE_LOAD_SUCCESS)
-    {
-        return material_property_t::INVALID_MATERIAL_TEXTURE;
-    }
-
     // textures from ASSIMP's 3D models are 2D until otherwise noted
     const math::vec3i& imgSize3d = imgLoader.get_pixel_size();
     const math::vec2i&& imgSize2d = {imgSize3d[0], imgSize3d[1]};
@@ -921,10 +2591,11 @@ size_t SceneFileLoader::load_texture_at_path(
 -------------------------------------*/
 bool SceneFileLoader::import_mesh_data(const aiScene* const pScene) noexcept
 {
-    std::vector<VboGroupMarker> tempVboMarks = preloader.vboMarkers;
+    VboGroupCursor* const pCursors = init_vbo_group_cursors(preloader.scratch, preloader.vboMarkers);
     SceneGraph& sceneData = preloader.sceneData;
     GLContextData& renderData = sceneData.renderData;
     const SceneFileMetaData& sceneInfo = preloader.sceneInfo;
+    const unsigned numMeshes = pScene->mNumMeshes;
 
     LS_LOG_MSG("\tImporting vertices and indices of individual meshes from a file.");
 
@@ -932,9 +2603,9 @@ bool SceneFileLoader::import_mesh_data(const aiScene* const pScene) noexcept
     IndexBuffer& ibo = renderData.ibos.back();
     unsigned baseIndex = 0;
     char* const pVbo = map_scene_file_buffer(vbo, sceneInfo.totalVboBytes);
-    char* pIbo = map_scene_file_buffer(ibo, sceneInfo.totalIboBytes);
+    char* const pIbo = map_scene_file_buffer(ibo, sceneInfo.totalIboBytes);
 
-    if (!pVbo || !pIbo)
+    if (!pCursors || !pVbo || !pIbo)
     {
         vbo.unmap_data();
         vbo.unbind();
@@ -943,48 +2614,283 @@ bool SceneFileLoader::import_mesh_data(const aiScene* const pScene) noexcept
         return false;
     }
 
-    std::vector<SceneMesh>& meshes = sceneData.meshes;
+    std::vector<SceneMesh>& meshes = sceneData.meshes;
+    preloader.meshStats.resize(numMeshes);
+    sceneData.bounds.resize(numMeshes);
+
+    // Calculate the location of every mesh within the VBO and IBO up-front so
+    // each mesh can be converted independently.
+    for (unsigned meshId = 0; meshId < numMeshes; ++meshId)
+    {
+        const aiMesh* const pMesh = pScene->mMeshes[meshId];
+        const common_vertex_t vertType = get_packed_vertex_types(convert_assimp_verts(pMesh), preloader.sceneInfo.packedVertTypes);
+
+        const size_t meshGroupId = get_mesh_group_marker(vertType, preloader.vboMarkers);
+        const VboGroupMarker& meshGroup = preloader.vboMarkers[meshGroupId];
+        VboGroupCursor& cursor = pCursors[meshGroupId];
+        LS_DEBUG_ASSERT(meshGroup.vertType == vertType);
+
+        SceneMesh& mesh = meshes[meshId];
+        mesh.drawParams.materialId = pMesh->mMaterialIndex;
+        mesh.drawParams.vaoId = renderData.vaos[meshGroupId].gpu_id();
+        mesh.vboId = vbo.gpu_id();
+        mesh.iboId = ibo.gpu_id();
+
+        MeshMetaData& metaData = mesh.metaData;
+        metaData.vertTypes = meshGroup.vertType;
+        metaData.totalVerts = pMesh->mNumVertices;
+        metaData.baseVertex = cursor.baseVert;
+        metaData.vboOffset = meshGroup.vboOffset + cursor.meshOffset;
+        metaData.indexType = get_mesh_index_type(cursor.baseVert, metaData.totalVerts, preloader.sceneInfo.baseVertexDraws != 0);
+        metaData.totalIndices = 0;
+
+        for (unsigned faceIter = 0; faceIter < pMesh->mNumFaces; ++faceIter)
+        {
+            metaData.totalIndices += pMesh->mFaces[faceIter].mNumIndices;
+        }
+
+        baseIndex = get_mesh_index_offset(baseIndex);
+
+        DrawCommandParams& drawParams = mesh.drawParams;
+        drawParams.drawFunc = draw_func_t::DRAW_ELEMENTS;
+        drawParams.drawMode = convert_assimp_draw_mode(pMesh);
+        drawParams.indexType = metaData.indexType;
+        drawParams.offset = (void*)((ptrdiff_t)baseIndex);
+        drawParams.count = metaData.totalIndices;
+
+        // Indices address the entire VAO unless base-vertex draws were
+        // requested.
+        drawParams.baseVertex = preloader.sceneInfo.baseVertexDraws ? (int32_t)cursor.baseVert : 0;
+
+        cursor.meshOffset += metaData.calc_total_vertex_bytes();
+        cursor.baseVert += metaData.totalVerts;
+        baseIndex += metaData.calc_total_index_bytes();
+    }
+
+    // vertex data in ASSIMP is not interleaved. It has to be converted into
+    // the internally used vertex format which is recommended for use on mobile
+    // devices. The current thread converts meshes alongside all workers.
+    std::atomic_uint nextMeshId{0};
+    std::vector<std::thread> workers;
+    const unsigned numThreads = preloader.calc_num_threads(numMeshes);
+    workers.reserve(numThreads);
+
+    for (unsigned i = 1; i < numThreads; ++i)
+    {
+        try
+        {
+            workers.emplace_back(&SceneFileLoader::convert_mesh_data, this, pScene, pVbo, pIbo, std::ref(nextMeshId));
+        }
+        catch (const std::system_error& e)
+        {
+            LS_LOG_ERR("\t\tUnable to start a mesh conversion thread: ", e.what());
+            break;
+        }
+    }
+
+    LS_LOG_MSG("\t\tConverting ", numMeshes, " meshes on ", workers.size() + 1, " threads.");
+
+    convert_mesh_data(pScene, pVbo, pIbo, nextMeshId);
+
+    for (std::thread& t : workers)
+    {
+        t.join();
+    }
+
+    vbo.unmap_data();
+    vbo.unbind();
+    ibo.unmap_data();
+    ibo.unbind();
+
+    LS_LOG_MSG("\t\tDone.");
+
+    return true;
+}
+
+
+
+/*-------------------------------------
+ * Convert meshes until none remain
+-------------------------------------*/
+void SceneFileLoader::convert_mesh_data(
+    const aiScene* const pScene,
+    char* const pVbo,
+    char* const pIbo,
+    std::atomic_uint& nextMeshId
+) noexcept
+{
+    const unsigned numMeshes = pScene->mNumMeshes;
+    SceneGraph& sceneData = preloader.sceneData;
+    std::vector<uint32_t> indices;
+    std::vector<uint32_t> remap;
+    std::vector<char> vertices;
+
+    // Each mesh only writes to its own range of the VBO and IBO, as well as
+    // its own morph data and statistics, so no further synchronization is
+    // needed.
+    for (unsigned meshId = nextMeshId.fetch_add(1); meshId < numMeshes; meshId = nextMeshId.fetch_add(1))
+    {
+        const aiMesh* const pMesh = pScene->mMeshes[meshId];
+        SceneMesh& mesh = sceneData.meshes[meshId];
+        MeshMetaData& metaData = mesh.metaData;
+        char* const pMeshVerts = pVbo + metaData.vboOffset;
+        char* const pMeshIndices = pIbo + (ptrdiff_t)mesh.drawParams.offset;
+        MeshOptimizerStats& stats = preloader.meshStats[meshId];
+
+        // Gather all indices, relative to the mesh's first vertex
+        indices.clear();
+        indices.reserve(metaData.totalIndices);
+
+        for (unsigned faceIter = 0; faceIter < pMesh->mNumFaces; ++faceIter)
+        {
+            const aiFace& face = pMesh->mFaces[faceIter];
+            indices.insert(indices.end(), face.mIndices, face.mIndices + face.mNumIndices);
+        }
+
+        remap.clear();
+        stats = MeshOptimizerStats{pMesh->mNumVertices, 0, 0.f, 0.f, 0.f, 0.f};
+
+        if (mesh.drawParams.drawMode == draw_mode_t::DRAW_MODE_TRIS
+        && indices.size() == (size_t)pMesh->mNumFaces * 3
+        && pMesh->HasPositions())
+        {
+            // Morph targets reference vertices by their original index.
+            stats = optimize_mesh(
+                indices.data(), indices.size(),
+                &pMesh->mVertices[0].x, sizeof(aiVector3D),
+                pMesh->mNumVertices,
+                remap,
+                pMesh->mNumAnimMeshes == 0
+            );
+
+            LS_LOG_MSG(
+                "\t\tOptimized mesh ", meshId, " (", stats.numTriangles, " triangles):",
+                " ACMR ", stats.acmrBefore, " -> ", stats.acmrAfter,
+                ", ATVR ", stats.atvrBefore, " -> ", stats.atvrAfter
+            );
+        }
+
+        if (metaData.vertTypes & common_vertex_t::PACKED_POSITION_VERTEX)
+        {
+            calc_mesh_dequantization(pMesh, metaData.dequantScale, metaData.dequantBias);
+        }
+
+        // Object-space bounds allow meshes to be culled or streamed without
+        // reading their vertices back.
+        BoundingBox& bounds = sceneData.bounds[meshId];
+
+        if (pMesh->HasPositions() && pMesh->mNumVertices)
+        {
+            const math::vec3&& firstPos = convert_assimp_vector(pMesh->mVertices[0]);
+            bounds.set_top_rear_right(firstPos);
+            bounds.set_bot_front_left(firstPos);
+
+            for (unsigned v = 1; v < pMesh->mNumVertices; ++v)
+            {
+                bounds.compare_and_update(convert_assimp_vector(pMesh->mVertices[v]));
+            }
+        }
+        else
+        {
+            bounds.reset_size();
+        }
+
+        if (remap.empty())
+        {
+            upload_mesh_vertices(pMesh, pMeshVerts, metaData);
+        }
+        else
+        {
+            // Mapped buffers are write-only. Vertices are converted to the
+            // CPU before being copied into their final order.
+            vertices.resize(metaData.calc_total_vertex_bytes());
+            upload_mesh_vertices(pMesh, vertices.data(), metaData);
+            remap_vertices(vertices.data(), pMeshVerts, metaData.calc_vertex_stride(), remap);
+        }
+
+        // Indices are local to the mesh if base-vertex draws are used.
+        const unsigned indexOffset = metaData.baseVertex - (unsigned)mesh.drawParams.baseVertex;
+
+        upload_mesh_indices(indices.data(), indices.size(), pMeshIndices, indexOffset, metaData.indexType);
+        import_mesh_morphs(pMesh, metaData.baseVertex, sceneData.morphs[meshId]);
+    }
+}
+
+
+
+/*-------------------------------------
+    Import sparse morph targets
+-------------------------------------*/
+void SceneFileLoader::import_mesh_morphs(const aiMesh* const pMesh, const unsigned baseVertex, SceneMorph& outMorph) noexcept
+{
+    // Squared length which a delta must exceed in order to be stored.
+    constexpr float minDeltaLength = 1.e-12f;
+
+    const unsigned numVerts = pMesh->mNumVertices;
+    const unsigned numTargets = math::min<unsigned>(pMesh->mNumAnimMeshes, morph_property_t::MORPH_MAX_TARGETS);
+
+    outMorph.reset();
+
+    if (!numTargets)
+    {
+        return;
+    }
+
+    if (pMesh->mNumAnimMeshes > morph_property_t::MORPH_MAX_TARGETS)
+    {
+        LS_LOG_ERR("\t\tWarning: Mesh \"", pMesh->mName.C_Str(), "\" contains ", pMesh->mNumAnimMeshes, " morph targets. Only the first ", numTargets, " will be imported.");
+    }
+
+    outMorph.baseVertex = baseVertex;
+    outMorph.numVerts = numVerts;
+    outMorph.vertOffsets.reserve(numVerts + 1);
+    outMorph.targetNames.reserve(numTargets);
+    outMorph.weights.reserve(numTargets);
+
+    for (unsigned t = 0; t < numTargets; ++t)
+    {
+        const aiAnimMesh* const pTarget = pMesh->mAnimMeshes[t];
+        LS_DEBUG_ASSERT(pTarget->mNumVertices == numVerts);
+
+        outMorph.targetNames.emplace_back(pTarget->mName.C_Str());
+        outMorph.weights.push_back((float)pTarget->mWeight);
+    }
 
-    // vertex data in ASSIMP is not interleaved. It has to be converted into
-    // the internally used vertex format which is recommended for use on mobile
-    // devices.
-    for (unsigned meshId = 0; meshId < pScene->mNumMeshes; ++meshId)
+    // ASSIMP stores complete replacement vertices for each target. Only the
+    // offsets of modified vertices are kept so the GPU can skip the rest.
+    for (unsigned v = 0; v < numVerts; ++v)
     {
-        const aiMesh* const pMesh = pScene->mMeshes[meshId];
-        const common_vertex_t vertType = convert_assimp_verts(pMesh);
+        outMorph.vertOffsets.push_back((unsigned)outMorph.deltas.size());
 
-        const size_t meshGroupId = get_mesh_group_marker(vertType, preloader.vboMarkers);
-        VboGroupMarker& meshGroup = tempVboMarks[meshGroupId];
-        LS_DEBUG_ASSERT                (meshGroup.vertType == vertType);
+        for (unsigned t = 0; t < numTargets; ++t)
+        {
+            const aiAnimMesh* const pTarget = pMesh->mAnimMeshes[t];
+            SceneMorphDelta delta;
 
-        SceneMesh& mesh = meshes[meshId];
-        mesh.drawParams.materialId = pMesh->mMaterialIndex;
-        mesh.drawParams.vaoId = renderData.vaos[meshGroupId].gpu_id();
-        mesh.vboId = vbo.gpu_id();
-        mesh.iboId = ibo.gpu_id();
+            delta.position = pTarget->HasPositions()
+                ? convert_assimp_vector(pTarget->mVertices[v] - pMesh->mVertices[v])
+                : math::vec3{0.f, 0.f, 0.f};
 
-        MeshMetaData& metaData = mesh.metaData;
-        metaData.vertTypes = meshGroup.vertType;
-        metaData.totalVerts = pMesh->mNumVertices;
-        const unsigned meshOffset = meshGroup.vboOffset + meshGroup.meshOffset;
+            delta.normal = (pTarget->HasNormals() && pMesh->HasNormals())
+                ? convert_assimp_vector(pTarget->mNormals[v] - pMesh->mNormals[v])
+                : math::vec3{0.f, 0.f, 0.f};
 
-        upload_mesh_vertices(pMesh, pVbo + meshOffset, meshGroup.vertType);
+            delta.targetId = t;
 
-        meshGroup.meshOffset += metaData.calc_total_vertex_bytes();
-        metaData.indexType = sceneInfo.indexType;
-        pIbo = upload_mesh_indices(pMesh, pIbo, baseIndex, meshGroup.baseVert, mesh);
-        meshGroup.baseVert += metaData.totalVerts;
-        baseIndex += metaData.calc_total_index_bytes();
+            if (math::dot(delta.position, delta.position) > minDeltaLength
+            || math::dot(delta.normal, delta.normal) > minDeltaLength)
+            {
+                outMorph.deltas.push_back(delta);
+            }
+        }
     }
 
-    vbo.unmap_data();
-    vbo.unbind();
-    ibo.unmap_data();
-    ibo.unbind();
-
-    LS_LOG_MSG("\t\tDone.");
+    outMorph.vertOffsets.push_back((unsigned)outMorph.deltas.size());
 
-    return true;
+    LS_LOG_MSG(
+        "\t\tImported ", numTargets, " morph targets (", outMorph.deltas.size(),
+        " deltas) for mesh \"", pMesh->mName.C_Str(), "\"."
+    );
 }
 
 
@@ -992,61 +2898,33 @@ bool SceneFileLoader::import_mesh_data(const aiScene* const pScene) noexcept
 /*-------------------------------------
     Read all face data (triangles)
 -------------------------------------*/
-char* SceneFileLoader::upload_mesh_indices(
-    const aiMesh* const pMesh,
-    char* pIbo,
-    const unsigned baseIndex,
+void SceneFileLoader::upload_mesh_indices(
+    const uint32_t* const pIndices,
+    const size_t numIndices,
+    char* const pIbo,
     const unsigned baseVertex,
-    SceneMesh& outMesh
-) noexcept
+    const index_element_t indexType
+) const noexcept
 {
-    const SceneFileMetaData& sceneInfo = preloader.sceneInfo;
-    MeshMetaData& metaData = outMesh.metaData;
-
-    // iterate through all faces in the mesh
-    for (unsigned faceIter = 0; faceIter < pMesh->mNumFaces; ++faceIter)
+    switch (indexType)
     {
-        const aiFace& face = pMesh->mFaces[faceIter];
-
-        for (unsigned i = 0; i < face.mNumIndices; ++i)
-        {
-            const unsigned idx = face.mIndices[i] + baseVertex;
+        case index_element_t::INDEX_TYPE_UBYTE:
+            convert_mesh_indices<unsigned char>(pIndices, numIndices, pIbo, baseVertex);
+            break;
 
-            switch (sceneInfo.indexType)
-            {
-                case index_element_t::INDEX_TYPE_UBYTE:
-                    *reinterpret_cast<unsigned char*>(pIbo) = (unsigned char)(idx);
-                    break;
-
-                case index_element_t::INDEX_TYPE_USHORT:
-                    *reinterpret_cast<unsigned short*>(pIbo) = (unsigned short)(idx);
-                    break;
-
-                case index_element_t::INDEX_TYPE_UINT:
-                    *reinterpret_cast<unsigned int*>(pIbo) = (unsigned int)(idx);
-                    break;
-
-                case index_element_t::INDEX_TYPE_NONE:
-                default:
-                    LS_ASSERT(false && "Unknown index type.");
-                    break;
-            }
+        case index_element_t::INDEX_TYPE_USHORT:
+            convert_mesh_indices<unsigned short>(pIndices, numIndices, pIbo, baseVertex);
+            break;
 
-            pIbo = (char*)((ptrdiff_t)pIbo + metaData.calc_index_stride());
-        }
+        case index_element_t::INDEX_TYPE_UINT:
+            convert_mesh_indices<unsigned int>(pIndices, numIndices, pIbo, baseVertex);
+            break;
 
-        metaData.totalIndices += face.mNumIndices;
+        case index_element_t::INDEX_TYPE_NONE:
+        default:
+            LS_ASSERT(false && "Unknown index type.");
+            break;
     }
-
-    // store the first/last vertex indices
-    DrawCommandParams& drawParams = outMesh.drawParams;
-    drawParams.drawFunc = draw_func_t::DRAW_ELEMENTS;
-    drawParams.drawMode = convert_assimp_draw_mode(pMesh);
-    drawParams.indexType = sceneInfo.indexType;
-    drawParams.offset = (void*)((ptrdiff_t)baseIndex);
-    drawParams.count = metaData.totalIndices;
-
-    return pIbo;
 }
 
 
@@ -1085,7 +2963,7 @@ void SceneFileLoader::read_node_hierarchy(
     // the parent node's child indices.
     SceneGraph& sceneData = preloader.sceneData;
     std::vector<SceneNode>& nodeList = sceneData.nodes;
-    std::vector<std::string>& nodeNames = sceneData.nodeNames;
+    std::vector<scene_name_t>& nodeNames = sceneData.nodeNames;
     std::vector<math::mat4>& baseTransforms = sceneData.baseTransforms;
     std::vector<Transform>& currTransforms = sceneData.currentTransforms;
     std::vector<math::mat4>& modelMatrices = sceneData.modelMatrices;
@@ -1100,7 +2978,7 @@ void SceneFileLoader::read_node_hierarchy(
     currentNode.nodeId = nodeList.size() - 1;
 
     // import the node name
-    nodeNames.emplace_back(std::string{pInNode->mName.C_Str()});
+    nodeNames.push_back(sceneData.nameTable.intern(pInNode->mName.C_Str()));
 
     // import the node transformation
     // This is also needed for camera nodes to be imported properly
@@ -1170,6 +3048,42 @@ void SceneFileLoader::read_node_hierarchy(
     }
 }
 
+/*-------------------------------------
+    Import all bones
+-------------------------------------*/
+void SceneFileLoader::import_mesh_skins(const aiScene* const pScene) noexcept
+{
+    SceneGraph& sceneData = preloader.sceneData;
+    std::vector<SceneSkin>& skins = sceneData.skins;
+
+    for (unsigned meshId = 0; meshId < pScene->mNumMeshes; ++meshId)
+    {
+        const aiMesh* const pMesh = pScene->mMeshes[meshId];
+        const unsigned numBones = math::min<unsigned>(pMesh->mNumBones, skin_property_t::SKIN_MAX_BONES);
+        SceneSkin& skin = skins[meshId];
+
+        skin.reset();
+        skin.boneIds.reserve(numBones);
+        skin.inverseBindPoses.reserve(numBones);
+
+        // Bones are stored in the same order as the bone indices of each
+        // vertex.
+        for (unsigned boneId = 0; boneId < numBones; ++boneId)
+        {
+            const aiBone* const pBone = pMesh->mBones[boneId];
+            const size_t nodeId = sceneData.find_node_id(sceneData.nameTable.find(pBone->mName.C_Str()));
+
+            if (nodeId == scene_property_t::SCENE_GRAPH_ROOT_ID)
+            {
+                LS_LOG_ERR("\t\tWarning: Unable to locate the node for bone \"", pBone->mName.C_Str(), "\" in mesh ", meshId, '.');
+            }
+
+            skin.boneIds.push_back(nodeId);
+            skin.inverseBindPoses.push_back(convert_assimp_matrix(pBone->mOffsetMatrix));
+        }
+    }
+}
+
 /*-------------------------------------
     Import a mesh node
 -------------------------------------*/
@@ -1298,6 +3212,7 @@ bool SceneFileLoader::import_animations(const aiScene* const pScene) noexcept
         // The animation as a whole needs to have its properties imported from
         // ASSIMP.
         Animation&& tempAnim = setup_imported_animation(
+            sceneData.nameTable,
             pInAnim->mName.C_Str(),
             pInAnim->mDuration,
             pInAnim->mTicksPerSecond,
@@ -1338,12 +3253,22 @@ bool SceneFileLoader::import_animations(const aiScene* const pScene) noexcept
             anim.add_anim_channel(node, nodeChannels.size() - 1);
         }
 
+        for (unsigned c = 0; c < pInAnim->mNumMorphMeshChannels; ++c)
+        {
+            if (!import_morph_animation(pScene, pInAnim->mMorphMeshChannels[c], anim))
+            {
+                // failing to load a morph track is not an error either.
+                ret = false;
+            }
+        }
+
         LS_LOG_MSG(
             "\tLoaded Animation ", i + 1, '/', totalAnimations,
-            "\n\t\tName:      ", anim.get_anim_name(),
+            "\n\t\tName:      ", anim.get_anim_name(sceneData.nameTable),
             "\n\t\tDuration:  ", anim.get_duration(),
             "\n\t\tTicks/Sec: ", anim.get_ticks_per_sec(),
-            "\n\t\tChannels:  ", anim.get_num_anim_channels()
+            "\n\t\tChannels:  ", anim.get_num_anim_channels(),
+            "\n\t\tMorphs:    ", anim.get_num_morph_channels()
         );
     }
 
@@ -1371,14 +3296,14 @@ size_t SceneFileLoader::import_animation_track(
     const unsigned sclFrames = pInAnim->mNumScalingKeys;
     const unsigned rotFrames = pInAnim->mNumRotationKeys;
     SceneGraph& sceneData = preloader.sceneData;
-    const std::vector<std::string>& nodeNames = sceneData.nodeNames;
-    const char* const pInName = pInAnim->mNodeName.C_Str();
+    const std::vector<scene_name_t>& nodeNames = sceneData.nodeNames;
+    const scene_name_t inNameId = sceneData.nameTable.find(pInAnim->mNodeName.C_Str());
     size_t nodeId = 0;
 
     // Locate the node associated with the current animation track.
     for (; nodeId < nodeNames.size(); ++nodeId)
     {
-        if (nodeNames[nodeId] == pInName)
+        if (nodeNames[nodeId] == inNameId)
         {
             break;
         }
@@ -1453,5 +3378,421 @@ size_t SceneFileLoader::import_animation_track(
 
     return nodeId;
 }
+
+/*-------------------------------------
+ * Import morph target weight tracks
+-------------------------------------*/
+bool SceneFileLoader::import_morph_animation(
+    const aiScene* const pScene,
+    const aiMeshMorphAnim* const pInAnim,
+    Animation& outAnim
+) noexcept
+{
+    const std::vector<SceneMorph>& morphs = preloader.sceneData.morphs;
+    const anim_prec_t animDuration = outAnim.get_duration();
+    const unsigned numKeys = pInAnim->mNumKeys;
+
+    // Morph channels can reference either a node containing meshes or the
+    // name of a mesh.
+    const aiNode* const pNode = pScene->mRootNode->FindNode(pInAnim->mName);
+    unsigned* const pMeshIds = preloader.scratch.allocate_array<unsigned>(pNode ? pNode->mNumMeshes : pScene->mNumMeshes);
+    unsigned numMeshIds = 0;
+
+    if (!pMeshIds)
+    {
+        LS_LOG_ERR("\tError: Unable to allocate the mesh list of a morph target animation: ", pInAnim->mName.C_Str());
+        return false;
+    }
+
+    if (pNode)
+    {
+        for (unsigned m = 0; m < pNode->mNumMeshes; ++m)
+        {
+            pMeshIds[numMeshIds++] = pNode->mMeshes[m];
+        }
+    }
+    else
+    {
+        for (unsigned m = 0; m < pScene->mNumMeshes; ++m)
+        {
+            if (pScene->mMeshes[m]->mName == pInAnim->mName)
+            {
+                pMeshIds[numMeshIds++] = m;
+            }
+        }
+    }
+
+    if (!numMeshIds || !numKeys)
+    {
+        LS_LOG_ERR("\tError: Unable to locate the mesh for a morph target animation: ", pInAnim->mName.C_Str());
+        return false;
+    }
+
+    for (unsigned i = 0; i < numMeshIds; ++i)
+    {
+        const unsigned meshId = pMeshIds[i];
+        const unsigned numTargets = (unsigned)morphs[meshId].get_num_targets();
+
+        for (unsigned t = 0; t < numTargets; ++t)
+        {
+            AnimationKeyListFloat frames;
+            bool isTargetUsed = false;
+
+            if (!frames.init(numKeys))
+            {
+                LS_LOG_ERR("\tError: Unable to allocate ", numKeys, " morph target keyframes for ", pInAnim->mName.C_Str(), '.');
+                return false;
+            }
+
+            // Each key only lists the targets it modifies. All other targets
+            // have a weight of 0.
+            for (unsigned k = 0; k < numKeys; ++k)
+            {
+                const aiMeshMorphKey& inKey = pInAnim->mKeys[k];
+                float weight = 0.f;
+
+                for (unsigned w = 0; w < inKey.mNumValuesAndWeights; ++w)
+                {
+                    if (inKey.mValues[w] == t)
+                    {
+                        weight = (float)inKey.mWeights[w];
+                        isTargetUsed = true;
+                        break;
+                    }
+                }
+
+                frames.set_frame(k, inKey.mTime / animDuration, weight);
+            }
+
+            if (isTargetUsed)
+            {
+                outAnim.add_morph_channel(meshId, t, std::move(frames));
+            }
+        }
+    }
+
+    return true;
+}
+
+/*-------------------------------------
+ * Save the loaded scene into a binary cache
+-------------------------------------*/
+bool SceneFileLoader::save_cache(const std::string& cachePath) const noexcept
+{
+    const SceneGraph& sceneData = preloader.sceneData;
+    const GLContextData& renderData = sceneData.renderData;
+    const SceneFileMetaData& sceneInfo = preloader.sceneInfo;
+    const VAODataList& vaos = renderData.vaos;
+    const TextureDataList& textures = renderData.textures;
+    SceneCacheHeader header;
+    SceneCacheWriter w;
+
+    if (!w.open(cachePath))
+    {
+        return false;
+    }
+
+    LS_LOG_MSG("\tWriting the 3D scene cache ", cachePath, '.');
+
+    // The header is rewritten once all data is in place. Until then, the
+    // magic number is invalid so a partially written cache will be rejected.
+    w.write(header);
+
+    // GL handles are stored as indices which are remapped when loaded.
+    const auto findVaoIndex = [&](const GLuint vaoId) -> uint32_t
+    {
+        for (size_t i = 0; i < vaos.size(); ++i)
+        {
+            if (vaos[i].gpu_id() == vaoId)
+            {
+                return (uint32_t)i;
+            }
+        }
+        return (uint32_t)-1;
+    };
+
+    const auto findTextureIndex = [&](const GLuint texId) -> GLuint
+    {
+        for (size_t i = 0; texId && i < textures.size(); ++i)
+        {
+            if (textures[i].gpu_id() == texId)
+            {
+                return (GLuint)i;
+            }
+        }
+        return material_property_t::INVALID_MATERIAL_TEXTURE;
+    };
+
+    // Vertex groups
+    w.write(sceneInfo);
+    w.write<uint64_t>(preloader.vboMarkers.size());
+
+    for (const VboGroupMarker& m : preloader.vboMarkers)
+    {
+        w.write(m.vertType);
+        w.write(m.numVboBytes);
+        w.write(m.vboOffset);
+    }
+
+    // Textures
+    std::vector<const std::string*> texPaths(textures.size(), nullptr);
+    for (const std::pair<const std::string, size_t>& texPath : preloader.texturePaths)
+    {
+        if (texPath.second < texPaths.size())
+        {
+            texPaths[texPath.second] = &texPath.first;
+        }
+    }
+
+    w.write<uint64_t>(textures.size());
+
+    for (size_t i = 0; i < textures.size(); ++i)
+    {
+        w.write_string(texPaths[i] ? *texPaths[i] : std::string{});
+        w.write(textures[i].get_attribs().get_wrap_mode(tex_param_t::TEX_PARAM_WRAP_S));
+    }
+
+    // Materials
+    w.write<uint64_t>(sceneData.materials.size());
+
+    for (const SceneMaterial& m : sceneData.materials)
+    {
+        GLuint texIndices[active_texture_t::MAX_ACTIVE_TEXTURES];
+
+        for (unsigned slot = 0; slot < active_texture_t::MAX_ACTIVE_TEXTURES; ++slot)
+        {
+            texIndices[slot] = findTextureIndex(m.textures[slot]);
+        }
+
+        w.write_array(m.bindSlots, active_texture_t::MAX_ACTIVE_TEXTURES);
+        w.write_array(texIndices, active_texture_t::MAX_ACTIVE_TEXTURES);
+    }
+
+    // Meshes, skins, morphs, and bounds
+    w.write<uint64_t>(sceneData.meshes.size());
+
+    for (const SceneMesh& m : sceneData.meshes)
+    {
+        DrawCommandParams drawParams = m.drawParams;
+        drawParams.vaoId = findVaoIndex(drawParams.vaoId);
+
+        w.write(drawParams);
+        w.write(m.metaData);
+    }
+
+    for (const SceneSkin& s : sceneData.skins)
+    {
+        w.write_vector(s.boneIds);
+        w.write_vector(s.inverseBindPoses);
+    }
+
+    for (const SceneMorph& m : sceneData.morphs)
+    {
+        w.write(m.baseVertex);
+        w.write(m.numVerts);
+        w.write_vector(m.vertOffsets);
+        w.write_vector(m.deltas);
+        w.write<uint64_t>(m.targetNames.size());
+
+        for (const std::string& name : m.targetNames)
+        {
+            w.write_string(name);
+        }
+
+        w.write_vector(m.weights);
+    }
+
+    w.write<uint64_t>(sceneData.bounds.size());
+
+    for (const BoundingBox& b : sceneData.bounds)
+    {
+        w.write(b.get_top_rear_right());
+        w.write(b.get_bot_front_left());
+    }
+
+    // Node hierarchy
+    w.write_vector(sceneData.nodes);
+    w.write_vector(sceneData.baseTransforms);
+
+    for (const Transform& t : sceneData.currentTransforms)
+    {
+        w.write(t.parentId);
+        w.write(t.get_type());
+        w.write(t.get_position());
+        w.write(t.get_scale());
+        w.write(t.get_orientation());
+    }
+
+    w.write_vector(sceneData.modelMatrices);
+    w.write<uint64_t>(sceneData.nodeNames.size());
+
+    // Interned names are written in the same format as std::string objects.
+    const SceneNameTable& names = sceneData.nameTable;
+
+    for (const scene_name_t nameId : sceneData.nodeNames)
+    {
+        w.write_array<char>(names.get_name(nameId), names.get_name_length(nameId));
+    }
+
+    w.write<uint64_t>(sceneData.cameras.size());
+
+    for (const Camera& cam : sceneData.cameras)
+    {
+        w.write(cam.get_projection_type());
+        w.write(cam.get_fov());
+        w.write(cam.get_aspect_width());
+        w.write(cam.get_aspect_height());
+        w.write(cam.get_near_plane());
+        w.write(cam.get_far_plane());
+    }
+
+    // Mesh node draw commands
+    w.write_vector(sceneData.nodeMeshCounts);
+
+    for (size_t i = 0; i < sceneData.nodeMeshes.size(); ++i)
+    {
+        const unsigned numMeshes = sceneData.nodeMeshCounts[i];
+        std::vector<DrawCommandParams> drawParams{sceneData.nodeMeshes[i].get(), sceneData.nodeMeshes[i].get() + numMeshes};
+
+        for (DrawCommandParams& p : drawParams)
+        {
+            p.vaoId = findVaoIndex(p.vaoId);
+        }
+
+        w.write_vector(drawParams);
+    }
+
+    // Animations
+    w.write<uint64_t>(sceneData.animations.size());
+
+    for (const Animation& anim : sceneData.animations)
+    {
+        const scene_name_t animNameId = anim.get_anim_name_id();
+
+        w.write_array<char>(names.get_name(animNameId), names.get_name_length(animNameId));
+        w.write(anim.get_play_mode());
+        w.write(anim.get_duration());
+        w.write(anim.get_ticks_per_sec());
+        w.write_vector(anim.get_node_animations());
+        w.write_vector(anim.get_node_tracks());
+        w.write_vector(anim.get_transforms());
+        w.write_vector(anim.get_morph_meshes());
+        w.write_vector(anim.get_morph_targets());
+
+        for (const AnimationKeyListFloat& frames : anim.get_morph_frames())
+        {
+            write_cached_key_list(w, frames);
+        }
+    }
+
+    w.write<uint64_t>(sceneData.nodeAnims.size());
+
+    for (const std::vector<AnimationChannel>& channels : sceneData.nodeAnims)
+    {
+        w.write<uint64_t>(channels.size());
+
+        for (const AnimationChannel& c : channels)
+        {
+            w.write(c.animationMode);
+            write_cached_key_list(w, c.positionFrames);
+            write_cached_key_list(w, c.scaleFrames);
+            write_cached_key_list(w, c.rotationFrames);
+        }
+    }
+
+    // Vertex and index payloads are aligned so they can be uploaded directly
+    // from the mapped file.
+    bool ret = true;
+
+    if (preloader.cacheMode & SCENE_CACHE_COMPRESS)
+    {
+        std::vector<char> vboData;
+        std::vector<char> iboData;
+        std::vector<char> encodedVerts;
+        std::vector<char> encodedIndices;
+        std::vector<SceneCachePayloadBlock> blocks;
+
+        ret = (!sceneInfo.totalVboBytes || (renderData.vbos.size() && read_cached_buffer(renderData.vbos.back(), sceneInfo.totalVboBytes, vboData)))
+            && (!sceneInfo.totalIboBytes || (renderData.ibos.size() && read_cached_buffer(renderData.ibos.back(), sceneInfo.totalIboBytes, iboData)));
+
+        // Blocks never cross mesh boundaries so their vertex strides and
+        // index types remain constant.
+        for (size_t i = 0; ret && i < sceneData.meshes.size(); ++i)
+        {
+            const SceneMesh& m = sceneData.meshes[i];
+            const MeshMetaData& metaData = m.metaData;
+
+            encode_cached_blocks(vboData, metaData.vboOffset, metaData.totalVerts, metaData.calc_vertex_stride(), MESH_CODEC_VERTICES, encodedVerts, blocks);
+            encode_cached_blocks(iboData, (uint64_t)(ptrdiff_t)m.drawParams.offset, metaData.totalIndices, metaData.calc_index_stride(), MESH_CODEC_INDICES, encodedIndices, blocks);
+        }
+
+        w.write_vector(blocks);
+
+        w.pad_to(SCENE_CACHE_PAYLOAD_ALIGNMENT);
+        header.vboOffset = w.get_offset();
+        header.vboBytes = encodedVerts.size();
+        w.write_bytes(encodedVerts.data(), encodedVerts.size());
+
+        w.pad_to(SCENE_CACHE_PAYLOAD_ALIGNMENT);
+        header.iboOffset = w.get_offset();
+        header.iboBytes = encodedIndices.size();
+        w.write_bytes(encodedIndices.data(), encodedIndices.size());
+
+        header.payloadEncoding = SCENE_CACHE_PAYLOAD_ENCODED;
+
+        LS_LOG_MSG(
+            "\t\tCompressed ", sceneInfo.totalVboBytes + sceneInfo.totalIboBytes,
+            " bytes of vertices and indices into ", encodedVerts.size() + encodedIndices.size(),
+            " bytes (", blocks.size(), " blocks)."
+        );
+    }
+    else
+    {
+        w.write_vector(std::vector<SceneCachePayloadBlock>{});
+
+        w.pad_to(SCENE_CACHE_PAYLOAD_ALIGNMENT);
+        header.vboOffset = w.get_offset();
+        header.vboBytes = sceneInfo.totalVboBytes;
+
+        if (sceneInfo.totalVboBytes)
+        {
+            ret = renderData.vbos.size() && write_cached_buffer(w, renderData.vbos.back(), sceneInfo.totalVboBytes);
+        }
+
+        w.pad_to(SCENE_CACHE_PAYLOAD_ALIGNMENT);
+        header.iboOffset = w.get_offset();
+        header.iboBytes = sceneInfo.totalIboBytes;
+
+        if (ret && sceneInfo.totalIboBytes)
+        {
+            ret = renderData.ibos.size() && write_cached_buffer(w, renderData.ibos.back(), sceneInfo.totalIboBytes);
+        }
+
+        header.payloadEncoding = SCENE_CACHE_PAYLOAD_RAW;
+    }
+
+    header.magic = SCENE_CACHE_MAGIC;
+    header.version = SCENE_CACHE_VERSION;
+    header.endianCheck = SCENE_CACHE_ENDIAN_CHECK;
+    header.pointerBytes = sizeof(size_t);
+    get_scene_file_stats(preloader.filepath, header.sourceBytes, header.sourceTime);
+
+    w.seek(0);
+    w.write(header);
+
+    // The previous cache is only replaced once this one is complete.
+    ret = ret && w.commit();
+
+    if (!ret)
+    {
+        LS_LOG_ERR("\t\tFailed to write the scene cache ", cachePath, '.');
+        w.close();
+        return false;
+    }
+
+    LS_LOG_MSG("\t\tDone.");
+
+    return true;
+}
 } // end draw namespace
 } // end ls namespace
@@ -1,8 +1,20 @@
 
+#include <cstring> // memcmp()
 #include <type_traits>
 
+#if defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+    #define LS_DRAW_IMPORT_SSE 1
+#elif defined(__ARM_NEON)
+    #include <arm_neon.h>
+    #define LS_DRAW_IMPORT_NEON 1
+#endif
+
+#include "lightsky/utils/Pointer.h"
+
 #include "lightsky/math/Math.h"
 
+#include "lightsky/draw/MeshOptimizer.h"
 #include "lightsky/draw/Setup.h"
 #include "lightsky/draw/SceneFileUtility.h"
 
@@ -81,6 +93,11 @@ common_vertex_t convert_assimp_verts(const aiMesh* const pMesh) noexcept
         vertTypes |= common_vertex_t::COLOR_VERTEX;
     }
 
+    if (pMesh->HasBones())
+    {
+        vertTypes |= common_vertex_t::BONE_VERTEX;
+    }
+
     if (!vertTypes)
     {
         LS_LOG_ERR("Warning: No vertex data found for the imported submesh \"", pMesh->mName.C_Str(), ".\"");
@@ -140,6 +157,27 @@ draw::VboGroupMarker* get_matching_marker(const common_vertex_t inVertType, std:
 
 
 
+/*-------------------------------------
+ * Allocate VBO Group cursors
+-------------------------------------*/
+VboGroupCursor* init_vbo_group_cursors(draw::SceneArena& arena, const std::vector<draw::VboGroupMarker>& markers) noexcept
+{
+    VboGroupCursor* const pCursors = arena.allocate_array<VboGroupCursor>(markers.size());
+
+    if (pCursors)
+    {
+        for (size_t i = 0; i < markers.size(); ++i)
+        {
+            pCursors[i].meshOffset = markers[i].meshOffset;
+            pCursors[i].baseVert = markers[i].baseVert;
+        }
+    }
+
+    return pCursors;
+}
+
+
+
 /*-------------------------------------
  * Helper function to map a VBO/IBO
 -------------------------------------*/
@@ -170,6 +208,122 @@ inline char* set_mesh_vertex_data(char* const pVert, const data_t& data, const u
 
 
 
+/*-------------------------------------
+ * Pack normalized vectors into the 2_10_10_10 format.
+ *
+ * Four vectors are de-interleaved and packed at a time. The results are
+ * identical to "pack_vertex_normal(...)", including its truncation of each
+ * component towards 0.
+-------------------------------------*/
+#if defined(LS_DRAW_IMPORT_SSE)
+
+inline void pack_mesh_normals(
+    const aiVector3D* const pIn,
+    char* pVbo,
+    const unsigned numVertices,
+    const unsigned vertStride
+) noexcept
+{
+    static_assert(sizeof(aiVector3D) == sizeof(float) * 3, "Assimp vectors must be tightly packed.");
+
+    const float* pFloats = reinterpret_cast<const float*>(pIn);
+    const __m128 scale = _mm_set1_ps(511.f);
+    const __m128i mask = _mm_set1_epi32(0x03FF);
+    const unsigned numSimd = ls::utils::get_endian_order() == ls::utils::endian_t::LS_LITTLE_ENDIAN ? (numVertices & ~3u) : 0;
+    unsigned i = 0;
+
+    for (; i < numSimd; i += 4, pFloats += 12)
+    {
+        // [x0 y0 z0 x1], [y1 z1 x2 y2], [z2 x3 y3 z3]
+        const __m128 a = _mm_loadu_ps(pFloats + 0);
+        const __m128 b = _mm_loadu_ps(pFloats + 4);
+        const __m128 c = _mm_loadu_ps(pFloats + 8);
+
+        const __m128 x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+        const __m128 y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+        const __m128 z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+
+        const __m128i px = _mm_and_si128(_mm_cvttps_epi32(_mm_mul_ps(x, scale)), mask);
+        const __m128i py = _mm_and_si128(_mm_cvttps_epi32(_mm_mul_ps(y, scale)), mask);
+        const __m128i pz = _mm_and_si128(_mm_cvttps_epi32(_mm_mul_ps(z, scale)), mask);
+        const __m128i packed = _mm_or_si128(px, _mm_or_si128(_mm_slli_epi32(py, 10), _mm_slli_epi32(pz, 20)));
+
+        int32_t out[4];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), packed);
+
+        pVbo = set_mesh_vertex_data(pVbo, out[0], vertStride);
+        pVbo = set_mesh_vertex_data(pVbo, out[1], vertStride);
+        pVbo = set_mesh_vertex_data(pVbo, out[2], vertStride);
+        pVbo = set_mesh_vertex_data(pVbo, out[3], vertStride);
+    }
+
+    for (; i < numVertices; ++i)
+    {
+        pVbo = set_mesh_vertex_data(pVbo, convert_assimp_normal(pIn[i]), vertStride);
+    }
+}
+
+#elif defined(LS_DRAW_IMPORT_NEON)
+
+inline void pack_mesh_normals(
+    const aiVector3D* const pIn,
+    char* pVbo,
+    const unsigned numVertices,
+    const unsigned vertStride
+) noexcept
+{
+    static_assert(sizeof(aiVector3D) == sizeof(float) * 3, "Assimp vectors must be tightly packed.");
+
+    const float* pFloats = reinterpret_cast<const float*>(pIn);
+    const float32x4_t scale = vdupq_n_f32(511.f);
+    const uint32x4_t mask = vdupq_n_u32(0x03FF);
+    const unsigned numSimd = ls::utils::get_endian_order() == ls::utils::endian_t::LS_LITTLE_ENDIAN ? (numVertices & ~3u) : 0;
+    unsigned i = 0;
+
+    for (; i < numSimd; i += 4, pFloats += 12)
+    {
+        // vld3q de-interleaves XYZ triplets directly.
+        const float32x4x3_t xyz = vld3q_f32(pFloats);
+
+        const uint32x4_t px = vandq_u32(vreinterpretq_u32_s32(vcvtq_s32_f32(vmulq_f32(xyz.val[0], scale))), mask);
+        const uint32x4_t py = vandq_u32(vreinterpretq_u32_s32(vcvtq_s32_f32(vmulq_f32(xyz.val[1], scale))), mask);
+        const uint32x4_t pz = vandq_u32(vreinterpretq_u32_s32(vcvtq_s32_f32(vmulq_f32(xyz.val[2], scale))), mask);
+        const uint32x4_t packed = vorrq_u32(px, vorrq_u32(vshlq_n_u32(py, 10), vshlq_n_u32(pz, 20)));
+
+        int32_t out[4];
+        vst1q_s32(out, vreinterpretq_s32_u32(packed));
+
+        pVbo = set_mesh_vertex_data(pVbo, out[0], vertStride);
+        pVbo = set_mesh_vertex_data(pVbo, out[1], vertStride);
+        pVbo = set_mesh_vertex_data(pVbo, out[2], vertStride);
+        pVbo = set_mesh_vertex_data(pVbo, out[3], vertStride);
+    }
+
+    for (; i < numVertices; ++i)
+    {
+        pVbo = set_mesh_vertex_data(pVbo, convert_assimp_normal(pIn[i]), vertStride);
+    }
+}
+
+#else
+
+inline void pack_mesh_normals(
+    const aiVector3D* const pIn,
+    char* pVbo,
+    const unsigned numVertices,
+    const unsigned vertStride
+) noexcept
+{
+    for (unsigned i = 0; i < numVertices; ++i)
+    {
+        pVbo = set_mesh_vertex_data(pVbo, convert_assimp_normal(pIn[i]), vertStride);
+    }
+}
+
+#endif
+
+
+
 /*-------------------------------------
  * Calculate the vertex positions for a mesh.
 -------------------------------------*/
@@ -226,13 +380,7 @@ unsigned calc_mesh_geometry_norms(
 ) noexcept
 {
     const unsigned numVertices = pMesh->mNumVertices;
-    const aiVector3D* const pInNorms = pMesh->mNormals;
-
-    for (unsigned i = 0; i < numVertices; ++i)
-    {
-        const aiVector3D& inNorm = pInNorms[i];
-        pVbo = set_mesh_vertex_data(pVbo, convert_assimp_normal(inNorm), vertStride);
-    }
+    pack_mesh_normals(pMesh->mNormals, pVbo, numVertices, vertStride);
 
     return numVertices * get_vertex_byte_size(common_vertex_t::NORMAL_VERTEX);
 }
@@ -251,12 +399,9 @@ unsigned calc_mesh_geometry_tangent(
 ) noexcept
 {
     const unsigned numVertices = pMesh->mNumVertices;
+    const aiVector3D* const pInTangents = (tangentType == common_vertex_t::TANGENT_VERTEX) ? pMesh->mTangents : pMesh->mBitangents;
 
-    for (unsigned i = 0; i < numVertices; ++i)
-    {
-        const aiVector3D& inTng = (tangentType == common_vertex_t::TANGENT_VERTEX) ? pMesh->mTangents[i] : pMesh->mBitangents[i];
-        pVbo = set_mesh_vertex_data(pVbo, convert_assimp_normal(inTng), vertStride);
-    }
+    pack_mesh_normals(pInTangents, pVbo, numVertices, vertStride);
 
     return numVertices * get_vertex_byte_size(tangentType);
 }
@@ -286,53 +431,317 @@ unsigned calc_mesh_geometry_colors(
 
 
 
+/*-------------------------------------
+ * Calculate the scale and bias which map a mesh's bounding box to [0, 1].
+-------------------------------------*/
+void calc_mesh_dequantization(
+    const aiMesh* const pMesh,
+    math::vec3& outScale,
+    math::vec3& outBias
+) noexcept
+{
+    const unsigned numVertices = pMesh->mNumVertices;
+    const aiVector3D* const pInVerts = pMesh->mVertices;
+
+    if (!numVertices)
+    {
+        outScale = math::vec3{1.f, 1.f, 1.f};
+        outBias = math::vec3{0.f, 0.f, 0.f};
+        return;
+    }
+
+    aiVector3D minPos = pInVerts[0];
+    aiVector3D maxPos = pInVerts[0];
+
+    for (unsigned i = 1; i < numVertices; ++i)
+    {
+        const aiVector3D& v = pInVerts[i];
+
+        minPos.x = math::min(minPos.x, v.x);
+        minPos.y = math::min(minPos.y, v.y);
+        minPos.z = math::min(minPos.z, v.z);
+
+        maxPos.x = math::max(maxPos.x, v.x);
+        maxPos.y = math::max(maxPos.y, v.y);
+        maxPos.z = math::max(maxPos.z, v.z);
+    }
+
+    outScale = convert_assimp_vector(maxPos - minPos);
+    outBias = convert_assimp_vector(minPos);
+}
+
+
+
+/*-------------------------------------
+ * Quantize vertex positions to normalized 16-bit integers.
+-------------------------------------*/
+unsigned calc_mesh_geometry_packed_pos(
+    const aiMesh* const pMesh,
+    char* pVbo,
+    const unsigned vertStride,
+    const math::vec3& dequantScale,
+    const math::vec3& dequantBias
+) noexcept
+{
+    const unsigned numVertices = pMesh->mNumVertices;
+    const aiVector3D* const pInVerts = pMesh->mVertices;
+
+    // Flat axes quantize to 0 and are restored entirely by the bias.
+    const math::vec3 invScale{
+        dequantScale[0] > 0.f ? (1.f / dequantScale[0]) : 0.f,
+        dequantScale[1] > 0.f ? (1.f / dequantScale[1]) : 0.f,
+        dequantScale[2] > 0.f ? (1.f / dequantScale[2]) : 0.f
+    };
+
+    for (unsigned i = 0; i < numVertices; ++i)
+    {
+        const math::vec3 inVert = convert_assimp_vector(pInVerts[i]);
+        pVbo = set_mesh_vertex_data(pVbo, draw::pack_vertex_position(inVert, dequantBias, invScale), vertStride);
+    }
+
+    return numVertices * get_vertex_byte_size(common_vertex_t::PACKED_POSITION_VERTEX);
+}
+
+
+
+/*-------------------------------------
+ * Convert Assimp UVs to half-floats.
+-------------------------------------*/
+unsigned calc_mesh_geometry_packed_uvs(
+    const aiMesh* const pMesh,
+    char* pVbo,
+    const unsigned vertStride
+) noexcept
+{
+    const unsigned numVertices = pMesh->mNumVertices;
+    const aiVector3D* const inUvs = pMesh->mTextureCoords[aiTextureType_NONE];
+
+    for (unsigned i = 0; i < numVertices; ++i)
+    {
+        const aiVector3D& inUv = inUvs[i];
+        const math::vec2_t<uint16_t> outUv{draw::pack_vertex_half(inUv.x), draw::pack_vertex_half(inUv.y)};
+        pVbo = set_mesh_vertex_data(pVbo, outUv, vertStride);
+    }
+
+    return numVertices * get_vertex_byte_size(common_vertex_t::PACKED_TEXTURE_VERTEX);
+}
+
+
+
+/*-------------------------------------
+ * Octahedral-encode Assimp Normals, Tangents, or BiTangents.
+-------------------------------------*/
+unsigned calc_mesh_geometry_packed_norms(
+    const aiMesh* const pMesh,
+    char* pVbo,
+    const unsigned vertStride,
+    const common_vertex_t normType
+) noexcept
+{
+    const unsigned numVertices = pMesh->mNumVertices;
+    const aiVector3D* pInNorms;
+
+    switch (normType)
+    {
+        case common_vertex_t::PACKED_TANGENT_VERTEX:
+            pInNorms = pMesh->mTangents;
+            break;
+
+        case common_vertex_t::PACKED_BITANGENT_VERTEX:
+            pInNorms = pMesh->mBitangents;
+            break;
+
+        default:
+            pInNorms = pMesh->mNormals;
+            break;
+    }
+
+    for (unsigned i = 0; i < numVertices; ++i)
+    {
+        const math::vec3 inNorm = convert_assimp_vector(pInNorms[i]);
+        pVbo = set_mesh_vertex_data(pVbo, draw::pack_vertex_octahedral(inNorm), vertStride);
+    }
+
+    return numVertices * get_vertex_byte_size(normType);
+}
+
+
+
+/*-------------------------------------
+ * Convert Assimp Colors to normalized bytes.
+-------------------------------------*/
+unsigned calc_mesh_geometry_packed_colors(
+    const aiMesh* const pMesh,
+    char* pVbo,
+    const unsigned vertStride
+) noexcept
+{
+    const unsigned numVertices = pMesh->mNumVertices;
+    const aiColor4D* const pInColors = pMesh->mColors[aiTextureType_NONE];
+
+    for (unsigned i = 0; i < numVertices; ++i)
+    {
+        const aiColor4D& inColor = pInColors[i];
+        pVbo = set_mesh_vertex_data(pVbo, draw::pack_vertex_color(convert_assimp_color(inColor)), vertStride);
+    }
+
+    return numVertices * get_vertex_byte_size(common_vertex_t::PACKED_COLOR_VERTEX);
+}
+
+
+
+/*-------------------------------------
+ * Convert Assimp bone weights to internal bone indices and weights.
+-------------------------------------*/
+unsigned calc_mesh_geometry_bones(
+    const aiMesh* const pMesh,
+    char* pVbo,
+    const unsigned vertStride
+) noexcept
+{
+    typedef math::vec4_t<unsigned char> bone_bytes_t;
+
+    const unsigned numVertices = pMesh->mNumVertices;
+    const unsigned numBones = math::min<unsigned>(pMesh->mNumBones, draw::skin_property_t::SKIN_MAX_BONES);
+
+    if (numBones < pMesh->mNumBones)
+    {
+        LS_LOG_ERR("\t\tWarning: Only ", numBones, " of ", pMesh->mNumBones, " bones can be imported for the submesh \"", pMesh->mName.C_Str(), ".\"");
+    }
+
+    ls::utils::Pointer<bone_bytes_t[]> boneIds{new bone_bytes_t[numVertices]};
+    ls::utils::Pointer<math::vec4[]> boneWeights{new math::vec4[numVertices]};
+
+    for (unsigned i = 0; i < numVertices; ++i)
+    {
+        boneIds[i] = bone_bytes_t{0, 0, 0, 0};
+        boneWeights[i] = math::vec4{0.f, 0.f, 0.f, 0.f};
+    }
+
+    // Keep only the most influential bones of each vertex.
+    for (unsigned boneId = 0; boneId < numBones; ++boneId)
+    {
+        const aiBone* const pBone = pMesh->mBones[boneId];
+
+        for (unsigned w = 0; w < pBone->mNumWeights; ++w)
+        {
+            const aiVertexWeight& inWeight = pBone->mWeights[w];
+            math::vec4& outWeights = boneWeights[inWeight.mVertexId];
+            unsigned minSlot = 0;
+
+            for (unsigned slot = 1; slot < draw::skin_property_t::SKIN_MAX_VERTEX_INFLUENCES; ++slot)
+            {
+                if (outWeights[slot] < outWeights[minSlot])
+                {
+                    minSlot = slot;
+                }
+            }
+
+            if (inWeight.mWeight > outWeights[minSlot])
+            {
+                outWeights[minSlot] = inWeight.mWeight;
+                boneIds[inWeight.mVertexId][minSlot] = (unsigned char)boneId;
+            }
+        }
+    }
+
+    const unsigned idBytes = get_vertex_byte_size(common_vertex_t::BONE_ID_VERTEX);
+
+    // Quantize all weights to unsigned bytes which sum to exactly 255.
+    for (unsigned i = 0; i < numVertices; ++i)
+    {
+        *reinterpret_cast<bone_bytes_t*>(pVbo) = boneIds[i];
+        *reinterpret_cast<bone_bytes_t*>(pVbo + idBytes) = draw::pack_vertex_bone_weights(boneWeights[i]);
+        pVbo += vertStride;
+    }
+
+    return numVertices * get_vertex_byte_size(common_vertex_t::BONE_VERTEX);
+}
+
+
+
 /*-------------------------------------
  * Function to dispatch all text-loading responsibilities to their respective loaders.
 -------------------------------------*/
 unsigned upload_mesh_vertices(
     const aiMesh* const pMesh,
     char* pVbo,
-    const common_vertex_t vertTypes
+    const draw::MeshMetaData& metaData
 ) noexcept
 {
+    const common_vertex_t vertTypes = metaData.vertTypes;
     const unsigned vertStride = get_vertex_stride(vertTypes);
-    unsigned offset = 0;
     unsigned bytesWritten = 0;
 
+    // Offsets follow the order of COMMON_VERTEX_FLAGS_LIST, which is also
+    // used to setup each VAO.
+    const auto attribOffset = [&](const common_vertex_t attrib) -> unsigned
+    {
+        return get_vertex_attrib_offset(vertTypes, attrib);
+    };
+
     if (vertTypes & common_vertex_t::POSITION_VERTEX)
     {
-        bytesWritten += calc_mesh_geometry_pos(pMesh, pVbo + offset, vertStride);
-        offset += get_vertex_byte_size(common_vertex_t::POSITION_VERTEX);
+        bytesWritten += calc_mesh_geometry_pos(pMesh, pVbo + attribOffset(common_vertex_t::POSITION_VERTEX), vertStride);
+    }
+    else if (vertTypes & common_vertex_t::PACKED_POSITION_VERTEX)
+    {
+        char* const pOut = pVbo + attribOffset(common_vertex_t::PACKED_POSITION_VERTEX);
+        bytesWritten += calc_mesh_geometry_packed_pos(pMesh, pOut, vertStride, metaData.dequantScale, metaData.dequantBias);
     }
 
     if (vertTypes & common_vertex_t::TEXTURE_VERTEX)
     {
-        bytesWritten += calc_mesh_geometry_uvs(pMesh, pVbo + offset, vertStride);
-        offset += get_vertex_byte_size(common_vertex_t::TEXTURE_VERTEX);
+        bytesWritten += calc_mesh_geometry_uvs(pMesh, pVbo + attribOffset(common_vertex_t::TEXTURE_VERTEX), vertStride);
+    }
+    else if (vertTypes & common_vertex_t::PACKED_TEXTURE_VERTEX)
+    {
+        bytesWritten += calc_mesh_geometry_packed_uvs(pMesh, pVbo + attribOffset(common_vertex_t::PACKED_TEXTURE_VERTEX), vertStride);
+    }
+
+    if (vertTypes & common_vertex_t::COLOR_VERTEX)
+    {
+        bytesWritten += calc_mesh_geometry_colors(pMesh, pVbo + attribOffset(common_vertex_t::COLOR_VERTEX), vertStride);
+    }
+    else if (vertTypes & common_vertex_t::PACKED_COLOR_VERTEX)
+    {
+        bytesWritten += calc_mesh_geometry_packed_colors(pMesh, pVbo + attribOffset(common_vertex_t::PACKED_COLOR_VERTEX), vertStride);
     }
 
     if (vertTypes & common_vertex_t::NORMAL_VERTEX)
     {
-        bytesWritten += calc_mesh_geometry_norms(pMesh, pVbo + offset, vertStride);
-        offset += get_vertex_byte_size(common_vertex_t::NORMAL_VERTEX);
+        bytesWritten += calc_mesh_geometry_norms(pMesh, pVbo + attribOffset(common_vertex_t::NORMAL_VERTEX), vertStride);
     }
 
     if (vertTypes & common_vertex_t::TANGENT_VERTEX)
     {
-        bytesWritten += calc_mesh_geometry_tangent(pMesh, pVbo + offset, vertStride, common_vertex_t::TANGENT_VERTEX);
-        offset += get_vertex_byte_size(common_vertex_t::TANGENT_VERTEX);
+        char* const pOut = pVbo + attribOffset(common_vertex_t::TANGENT_VERTEX);
+        bytesWritten += calc_mesh_geometry_tangent(pMesh, pOut, vertStride, common_vertex_t::TANGENT_VERTEX);
     }
 
     if (vertTypes & common_vertex_t::BITANGENT_VERTEX)
     {
-        bytesWritten += calc_mesh_geometry_tangent(pMesh, pVbo + offset, vertStride, common_vertex_t::BITANGENT_VERTEX);
-        offset += get_vertex_byte_size(common_vertex_t::BITANGENT_VERTEX);
+        char* const pOut = pVbo + attribOffset(common_vertex_t::BITANGENT_VERTEX);
+        bytesWritten += calc_mesh_geometry_tangent(pMesh, pOut, vertStride, common_vertex_t::BITANGENT_VERTEX);
     }
 
-    if (vertTypes & common_vertex_t::COLOR_VERTEX)
+    constexpr common_vertex_t packedNormTypes[] = {
+        common_vertex_t::PACKED_NORMAL_VERTEX,
+        common_vertex_t::PACKED_TANGENT_VERTEX,
+        common_vertex_t::PACKED_BITANGENT_VERTEX
+    };
+
+    for (const common_vertex_t normType : packedNormTypes)
     {
-        bytesWritten += calc_mesh_geometry_colors(pMesh, pVbo + offset, vertStride);
-        offset += get_vertex_byte_size(common_vertex_t::COLOR_VERTEX);
+        if (vertTypes & normType)
+        {
+            bytesWritten += calc_mesh_geometry_packed_norms(pMesh, pVbo + attribOffset(normType), vertStride, normType);
+        }
+    }
+
+    if (common_vertex_t::BONE_VERTEX == (vertTypes & common_vertex_t::BONE_VERTEX))
+    {
+        bytesWritten += calc_mesh_geometry_bones(pMesh, pVbo + attribOffset(common_vertex_t::BONE_ID_VERTEX), vertStride);
     }
 
     return bytesWritten;
@@ -340,6 +749,246 @@ unsigned upload_mesh_vertices(
 
 
 
+/*-------------------------------------
+ * Compact a vertex channel using a remapping table from weld_vertices()
+-------------------------------------*/
+template <typename data_t>
+inline void compact_assimp_channel(data_t* const pData, const std::vector<uint32_t>& remap) noexcept
+{
+    if (!pData)
+    {
+        return;
+    }
+
+    // The first occurrence of each vertex is always mapped to the next
+    // unused location, which is never ahead of the vertex being read.
+    uint32_t numWritten = 0;
+
+    for (size_t v = 0; v < remap.size(); ++v)
+    {
+        if (remap[v] == numWritten)
+        {
+            pData[numWritten++] = pData[v];
+        }
+    }
+}
+
+
+
+/*-------------------------------------
+ * Merge identical vertices of a mesh
+-------------------------------------*/
+unsigned weld_assimp_mesh(
+    aiMesh* const pMesh,
+    const common_vertex_t packedVertTypes,
+    std::vector<char>& scratchVerts,
+    std::vector<uint32_t>& scratchRemap
+) noexcept
+{
+    const unsigned numVertices = pMesh->mNumVertices;
+
+    // Morph targets reference vertices by their original index.
+    if (!numVertices || pMesh->mNumAnimMeshes)
+    {
+        return 0;
+    }
+
+    draw::MeshMetaData metaData{};
+    metaData.vertTypes = draw::get_packed_vertex_types(convert_assimp_verts(pMesh), packedVertTypes);
+
+    if (metaData.vertTypes & common_vertex_t::PACKED_POSITION_VERTEX)
+    {
+        calc_mesh_dequantization(pMesh, metaData.dequantScale, metaData.dequantBias);
+    }
+
+    const unsigned vertStride = draw::get_vertex_stride(metaData.vertTypes);
+    if (!vertStride)
+    {
+        return 0;
+    }
+
+    // Vertices are compared after conversion so only attributes which are
+    // actually uploaded (after quantization) need to match.
+    scratchVerts.assign((size_t)numVertices * vertStride, 0);
+    upload_mesh_vertices(pMesh, scratchVerts.data(), metaData);
+
+    const uint32_t numUnique = draw::weld_vertices(scratchVerts.data(), vertStride, numVertices, scratchRemap);
+    if (numUnique == numVertices)
+    {
+        return 0;
+    }
+
+    // Bone weights of duplicate vertices are discarded. Their converted
+    // weights match those of the vertex they were merged into.
+    if (pMesh->mNumBones)
+    {
+        std::vector<bool> isFirst(numVertices, false);
+        uint32_t numSeen = 0;
+
+        for (unsigned v = 0; v < numVertices; ++v)
+        {
+            if (scratchRemap[v] == numSeen)
+            {
+                isFirst[v] = true;
+                ++numSeen;
+            }
+        }
+
+        for (unsigned boneId = 0; boneId < pMesh->mNumBones; ++boneId)
+        {
+            aiBone* const pBone = pMesh->mBones[boneId];
+            unsigned numWeights = 0;
+
+            for (unsigned w = 0; w < pBone->mNumWeights; ++w)
+            {
+                const aiVertexWeight inWeight = pBone->mWeights[w];
+
+                if (inWeight.mVertexId < numVertices && isFirst[inWeight.mVertexId])
+                {
+                    pBone->mWeights[numWeights++] = aiVertexWeight{scratchRemap[inWeight.mVertexId], inWeight.mWeight};
+                }
+            }
+
+            pBone->mNumWeights = numWeights;
+        }
+    }
+
+    compact_assimp_channel(pMesh->mVertices, scratchRemap);
+    compact_assimp_channel(pMesh->mNormals, scratchRemap);
+    compact_assimp_channel(pMesh->mTangents, scratchRemap);
+    compact_assimp_channel(pMesh->mBitangents, scratchRemap);
+
+    for (unsigned c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS; ++c)
+    {
+        compact_assimp_channel(pMesh->mColors[c], scratchRemap);
+    }
+
+    for (unsigned c = 0; c < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++c)
+    {
+        compact_assimp_channel(pMesh->mTextureCoords[c], scratchRemap);
+    }
+
+    for (unsigned faceIter = 0; faceIter < pMesh->mNumFaces; ++faceIter)
+    {
+        aiFace& face = pMesh->mFaces[faceIter];
+
+        for (unsigned i = 0; i < face.mNumIndices; ++i)
+        {
+            face.mIndices[i] = scratchRemap[face.mIndices[i]];
+        }
+    }
+
+    pMesh->mNumVertices = numUnique;
+
+    return numVertices - numUnique;
+}
+
+
+
+/*-------------------------------------
+ * Hash the material, positions, and faces of a mesh.
+-------------------------------------*/
+uint64_t hash_assimp_mesh(const aiMesh* const pMesh) noexcept
+{
+    uint64_t hash = draw::hash_mesh_data(&pMesh->mMaterialIndex, sizeof(pMesh->mMaterialIndex));
+    hash = draw::hash_mesh_data(&pMesh->mPrimitiveTypes, sizeof(pMesh->mPrimitiveTypes), hash);
+    hash = draw::hash_mesh_data(&pMesh->mNumVertices, sizeof(pMesh->mNumVertices), hash);
+    hash = draw::hash_mesh_data(&pMesh->mNumFaces, sizeof(pMesh->mNumFaces), hash);
+
+    if (pMesh->mVertices)
+    {
+        hash = draw::hash_mesh_data(pMesh->mVertices, sizeof(aiVector3D) * pMesh->mNumVertices, hash);
+    }
+
+    for (unsigned faceIter = 0; faceIter < pMesh->mNumFaces; ++faceIter)
+    {
+        const aiFace& face = pMesh->mFaces[faceIter];
+        hash = draw::hash_mesh_data(face.mIndices, sizeof(unsigned) * face.mNumIndices, hash);
+    }
+
+    return hash;
+}
+
+
+
+/*-------------------------------------
+ * Compare an optional vertex channel of two meshes
+-------------------------------------*/
+template <typename data_t>
+inline bool are_assimp_channels_equal(const data_t* const pA, const data_t* const pB, const unsigned numVertices) noexcept
+{
+    if (!pA || !pB)
+    {
+        return pA == pB;
+    }
+
+    return memcmp(pA, pB, sizeof(data_t) * numVertices) == 0;
+}
+
+
+
+/*-------------------------------------
+ * Determine if two meshes can be replaced by a single instance.
+-------------------------------------*/
+bool are_assimp_meshes_equal(const aiMesh* const pA, const aiMesh* const pB) noexcept
+{
+    // Skinned and morphed meshes are bound to their own nodes.
+    if (pA->mNumBones || pB->mNumBones || pA->mNumAnimMeshes || pB->mNumAnimMeshes)
+    {
+        return false;
+    }
+
+    if (pA->mMaterialIndex != pB->mMaterialIndex
+    || pA->mPrimitiveTypes != pB->mPrimitiveTypes
+    || pA->mNumVertices != pB->mNumVertices
+    || pA->mNumFaces != pB->mNumFaces)
+    {
+        return false;
+    }
+
+    const unsigned numVertices = pA->mNumVertices;
+
+    if (!are_assimp_channels_equal(pA->mVertices, pB->mVertices, numVertices)
+    || !are_assimp_channels_equal(pA->mNormals, pB->mNormals, numVertices)
+    || !are_assimp_channels_equal(pA->mTangents, pB->mTangents, numVertices)
+    || !are_assimp_channels_equal(pA->mBitangents, pB->mBitangents, numVertices))
+    {
+        return false;
+    }
+
+    for (unsigned c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS; ++c)
+    {
+        if (!are_assimp_channels_equal(pA->mColors[c], pB->mColors[c], numVertices))
+        {
+            return false;
+        }
+    }
+
+    for (unsigned c = 0; c < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++c)
+    {
+        if (!are_assimp_channels_equal(pA->mTextureCoords[c], pB->mTextureCoords[c], numVertices))
+        {
+            return false;
+        }
+    }
+
+    for (unsigned faceIter = 0; faceIter < pA->mNumFaces; ++faceIter)
+    {
+        const aiFace& faceA = pA->mFaces[faceIter];
+        const aiFace& faceB = pB->mFaces[faceIter];
+
+        if (faceA.mNumIndices != faceB.mNumIndices
+        || memcmp(faceA.mIndices, faceB.mIndices, sizeof(unsigned) * faceA.mNumIndices) != 0)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+
 /*-------------------------------------
  * Count all scene nodes in an aiScene
 -------------------------------------*/
@@ -367,6 +1016,7 @@ unsigned count_assimp_nodes(const aiNode* const pNode) noexcept
  * Setup an animation for importing
 -------------------------------------*/
 draw::Animation setup_imported_animation(
+    draw::SceneNameTable& names,
     const char* const name,
     const draw::anim_prec_t duration,
     const draw::anim_prec_t ticksPerSec,
@@ -376,7 +1026,7 @@ draw::Animation setup_imported_animation(
     draw::Animation anim{};
 
     anim.set_duration(duration);
-    anim.set_anim_name(std::string{name});
+    anim.set_anim_name(names, names.intern(name));
     anim.set_ticks_per_sec(ticksPerSec > 0.0 ? ticksPerSec : 23.976);
     anim.reserve_anim_channels(numChannels);
 
@@ -100,12 +100,15 @@ SceneGraph::~SceneGraph() noexcept
 SceneGraph::SceneGraph() noexcept :
     cameras(),
     meshes(),
+    skins(),
+    morphs(),
     bounds(),
     materials(),
     nodes(),
     baseTransforms(),
     currentTransforms(),
     modelMatrices(),
+    nameTable(),
     nodeNames(),
     animations(),
     nodeAnims(),
@@ -138,12 +141,15 @@ SceneGraph& SceneGraph::operator=(const SceneGraph& s) noexcept
 {
     cameras = s.cameras;
     meshes = s.meshes;
+    skins = s.skins;
+    morphs = s.morphs;
     bounds = s.bounds;
     materials = s.materials;
     nodes = s.nodes;
     baseTransforms = s.baseTransforms;
     currentTransforms = s.currentTransforms;
     modelMatrices = s.modelMatrices;
+    nameTable = s.nameTable;
     nodeNames = s.nodeNames;
     animations = s.animations;
     nodeAnims = s.nodeAnims;
@@ -180,12 +186,15 @@ SceneGraph& SceneGraph::operator=(SceneGraph&& s) noexcept
 {
     cameras = std::move(s.cameras);
     meshes = std::move(s.meshes);
+    skins = std::move(s.skins);
+    morphs = std::move(s.morphs);
     bounds = std::move(s.bounds);
     materials = std::move(s.materials);
     nodes = std::move(s.nodes);
     baseTransforms = std::move(s.baseTransforms);
     currentTransforms = std::move(s.currentTransforms);
     modelMatrices = std::move(s.modelMatrices);
+    nameTable = std::move(s.nameTable);
     nodeNames = std::move(s.nodeNames);
     animations = std::move(s.animations);
     nodeAnims = std::move(s.nodeAnims);
@@ -203,12 +212,15 @@ void SceneGraph::terminate() noexcept
 {
     cameras.clear();
     meshes.clear();
+    skins.clear();
+    morphs.clear();
     bounds.clear();
     materials.clear();
     nodes.clear();
     baseTransforms.clear();
     currentTransforms.clear();
     modelMatrices.clear();
+    nameTable.clear();
     nodeNames.clear();
     animations.clear();
     nodeAnims.clear();
@@ -362,6 +374,32 @@ void SceneGraph::delete_node_animation_data(const size_t nodeId, const size_t an
     }
 }
 
+/*-------------------------------------
+ * Bone Deletion
+-------------------------------------*/
+void SceneGraph::delete_node_skin_data(const size_t nodeId) noexcept
+{
+    for (SceneSkin& skin : skins)
+    {
+        for (size_t& boneId : skin.boneIds)
+        {
+            if (boneId == scene_property_t::SCENE_GRAPH_ROOT_ID)
+            {
+                continue;
+            }
+
+            if (boneId == nodeId)
+            {
+                boneId = scene_property_t::SCENE_GRAPH_ROOT_ID;
+            }
+            else if (boneId > nodeId)
+            {
+                --boneId;
+            }
+        }
+    }
+}
+
 /*-------------------------------------
  * Delete all nodes
 -------------------------------------*/
@@ -372,11 +410,21 @@ void SceneGraph::clear_node_data() noexcept
     baseTransforms.clear();
     currentTransforms.clear();
     modelMatrices.clear();
+    nameTable.clear();
     nodeNames.clear();
     animations.clear();
     nodeAnims.clear();
     nodeMeshCounts.clear();
     nodeMeshes.clear();
+
+    // Skins belong to meshes, which are kept, but their bones are nodes.
+    for (SceneSkin& skin : skins)
+    {
+        for (size_t& boneId : skin.boneIds)
+        {
+            boneId = scene_property_t::SCENE_GRAPH_ROOT_ID;
+        }
+    }
 }
 
 /*-------------------------------------
@@ -436,6 +484,7 @@ size_t SceneGraph::delete_node(const size_t nodeIndex) noexcept
 
     // early exit in case there are no animations tied to the current node.
     delete_node_animation_data(nodeIndex, animId);
+    delete_node_skin_data(nodeIndex);
 
     // Decrement all node ID and data ID indices that are greater than those in
     // the current node. Also deal with the last bit of transformation data in
@@ -525,6 +574,20 @@ bool SceneGraph::reparent_node(const size_t nodeIndex, const size_t newParentId)
     rotate_list(currentTransforms, nodeIndex, displacement, newNodeIndex);
     rotate_list(modelMatrices, nodeIndex, displacement, newNodeIndex);
 
+    // Bones reference nodes by index. Keep track of where each of the
+    // affected nodes were moved to.
+    std::vector<size_t> movedIds;
+
+    if (!skins.empty())
+    {
+        movedIds.resize(effectEnd - effectStart);
+
+        for (size_t i = effectStart; i < effectEnd; ++i)
+        {
+            movedIds[nodes[i].nodeId - effectStart] = i;
+        }
+    }
+
     for (size_t i = effectStart; i < effectEnd; ++i)
     {
         size_t& rParentId = currentTransforms[i].parentId;
@@ -571,6 +634,17 @@ bool SceneGraph::reparent_node(const size_t nodeIndex, const size_t newParentId)
         }
     }
 
+    for (SceneSkin& skin : skins)
+    {
+        for (size_t& boneId : skin.boneIds)
+        {
+            if (boneId >= effectStart && boneId < effectEnd)
+            {
+                boneId = movedIds[boneId - effectStart];
+            }
+        }
+    }
+
     //LS_LOG_MSG("\tDone.");
 
     LS_DEBUG_ASSERT(newNodeIndex <= nodes.size());
@@ -584,12 +658,25 @@ bool SceneGraph::reparent_node(const size_t nodeIndex, const size_t newParentId)
  * Node Searching
 -------------------------------------*/
 size_t SceneGraph::find_node_id(const std::string& nameQuery) const noexcept
+{
+    return find_node_id(nameTable.find(nameQuery));
+}
+
+/*-------------------------------------
+ * Node Searching (interned names)
+-------------------------------------*/
+size_t SceneGraph::find_node_id(const scene_name_t nameId) const noexcept
 {
     size_t nodeId = scene_property_t::SCENE_GRAPH_ROOT_ID;
 
+    if (nameId == SCENE_NAME_INVALID)
+    {
+        return nodeId;
+    }
+
     for (size_t i = nodeNames.size(); i--;)
     {
-        if (nodeNames[i] == nameQuery)
+        if (nodeNames[i] == nameId)
         {
             return i;
         }
@@ -598,6 +685,15 @@ size_t SceneGraph::find_node_id(const std::string& nameQuery) const noexcept
     return nodeId;
 }
 
+/*-------------------------------------
+ * Node Name Retrieval
+-------------------------------------*/
+const char* SceneGraph::get_node_name(const size_t nodeIndex) const noexcept
+{
+    LS_DEBUG_ASSERT(nodeIndex < nodeNames.size());
+    return nameTable.get_name(nodeNames[nodeIndex]);
+}
+
 /*-------------------------------------
  * Node Child Counting (total)
 -------------------------------------*/
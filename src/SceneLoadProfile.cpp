@@ -0,0 +1,184 @@
+
+#include <cstdio> // std::snprintf()
+
+#include "lightsky/draw/SceneLoadProfile.h"
+
+
+
+/*-----------------------------------------------------------------------------
+ * Anonymous helper functions
+-----------------------------------------------------------------------------*/
+namespace
+{
+
+/*-------------------------------------
+ * Append a JSON string, escaping all reserved characters
+-------------------------------------*/
+void append_json_string(std::string& outJson, const std::string& str) noexcept
+{
+    outJson.push_back('\"');
+
+    for (const char c : str)
+    {
+        switch (c)
+        {
+            case '\"': outJson += "\\\""; break;
+            case '\\': outJson += "\\\\"; break;
+            case '\b': outJson += "\\b"; break;
+            case '\f': outJson += "\\f"; break;
+            case '\n': outJson += "\\n"; break;
+            case '\r': outJson += "\\r"; break;
+            case '\t': outJson += "\\t"; break;
+
+            default:
+                if ((unsigned char)c < 0x20)
+                {
+                    char escape[8];
+                    std::snprintf(escape, sizeof(escape), "\\u%04x", (unsigned)c);
+                    outJson += escape;
+                }
+                else
+                {
+                    outJson.push_back(c);
+                }
+                break;
+        }
+    }
+
+    outJson.push_back('\"');
+}
+
+
+
+/*-------------------------------------
+ * Append a JSON member containing an unsigned integer
+-------------------------------------*/
+void append_json_number(std::string& outJson, const char* const pKey, const uint64_t value) noexcept
+{
+    outJson.push_back('\"');
+    outJson += pKey;
+    outJson += "\":";
+    outJson += std::to_string(value);
+}
+
+
+
+} // end anonymous namespace
+
+
+
+namespace ls
+{
+namespace draw
+{
+
+
+
+/*-------------------------------------
+ * Retrieve a phase name
+-------------------------------------*/
+const char* get_scene_load_phase_name(const scene_load_phase_t phase) noexcept
+{
+    switch (phase)
+    {
+        case SCENE_LOAD_PHASE_FILE_READ:   return "file_read";
+        case SCENE_LOAD_PHASE_PRELOAD:     return "preload";
+        case SCENE_LOAD_PHASE_CPU_ALLOC:   return "cpu_alloc";
+        case SCENE_LOAD_PHASE_GPU_ALLOC:   return "gpu_alloc";
+        case SCENE_LOAD_PHASE_TEXTURES:    return "textures";
+        case SCENE_LOAD_PHASE_MESHES:      return "meshes";
+        case SCENE_LOAD_PHASE_HIERARCHY:   return "hierarchy";
+        case SCENE_LOAD_PHASE_ANIMATIONS:  return "animations";
+        case SCENE_LOAD_PHASE_CACHE_WRITE: return "cache_write";
+
+        default:
+            break;
+    }
+
+    return "unknown";
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * SceneLoadProfile Structure
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Clear all measurements
+-------------------------------------*/
+void SceneLoadProfile::reset() noexcept
+{
+    filepath.clear();
+
+    for (SceneLoadPhaseStats& stats : phases)
+    {
+        stats = SceneLoadPhaseStats{0, 0, 0, 0, 0};
+    }
+}
+
+
+
+/*-------------------------------------
+ * Sum all phase timings
+-------------------------------------*/
+uint64_t SceneLoadProfile::get_total_micros() const noexcept
+{
+    uint64_t totalMicros = 0;
+
+    for (const SceneLoadPhaseStats& stats : phases)
+    {
+        totalMicros += stats.wallTimeMicros;
+    }
+
+    return totalMicros;
+}
+
+
+
+/*-------------------------------------
+ * Export to JSON
+-------------------------------------*/
+std::string SceneLoadProfile::to_json() const noexcept
+{
+    std::string outJson;
+    outJson.reserve(160 * SCENE_LOAD_PHASE_COUNT);
+
+    outJson += "{\"file\":";
+    append_json_string(outJson, filepath);
+    outJson.push_back(',');
+    append_json_number(outJson, "totalMicros", get_total_micros());
+    outJson += ",\"phases\":[";
+
+    for (unsigned i = 0; i < SCENE_LOAD_PHASE_COUNT; ++i)
+    {
+        const SceneLoadPhaseStats& stats = phases[i];
+
+        if (i)
+        {
+            outJson.push_back(',');
+        }
+
+        outJson += "{\"name\":\"";
+        outJson += get_scene_load_phase_name((scene_load_phase_t)i);
+        outJson += "\",";
+        append_json_number(outJson, "wallTimeMicros", stats.wallTimeMicros);
+        outJson.push_back(',');
+        append_json_number(outJson, "bytes", stats.numBytes);
+        outJson.push_back(',');
+        append_json_number(outJson, "allocations", stats.numAllocations);
+        outJson.push_back(',');
+        append_json_number(outJson, "allocatedBytes", stats.allocatedBytes);
+        outJson.push_back(',');
+        append_json_number(outJson, "calls", stats.numCalls);
+        outJson.push_back('}');
+    }
+
+    outJson += "]}";
+
+    return outJson;
+}
+
+
+
+} // end draw namespace
+} // end ls namespace
@@ -0,0 +1,504 @@
+
+#include <chrono>
+#include <new> // std::nothrow
+#include <system_error>
+#include <utility> // std::move
+
+#include "lightsky/utils/Log.h"
+
+#include "lightsky/draw/SceneLoadService.h"
+
+
+
+namespace ls
+{
+namespace draw
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * SceneLoadRequest Class
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Destructor
+-------------------------------------*/
+SceneLoadRequest::~SceneLoadRequest() noexcept
+{
+}
+
+
+
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+SceneLoadRequest::SceneLoadRequest(
+    const std::string& filename,
+    const scene_cache_mode_t cacheMode,
+    const common_vertex_t packedVertTypes,
+    const scene_import_profile_t importMode
+) noexcept :
+    filepath{filename},
+    cacheFlags{cacheMode},
+    packedTypes{packedVertTypes},
+    importProfile{importMode},
+    status{scene_load_status_t::SCENE_LOAD_QUEUED},
+    preloader{},
+    loader{},
+    promise{},
+    future{promise.get_future().share()}
+{
+}
+
+
+
+/*-------------------------------------
+ * Finalize a request
+-------------------------------------*/
+void SceneLoadRequest::finish(const scene_load_status_t finalStatus) noexcept
+{
+    preloader.unload();
+    status = finalStatus;
+    promise.set_value(finalStatus);
+}
+
+
+
+/*-------------------------------------
+ * Retrieve the file path
+-------------------------------------*/
+const std::string& SceneLoadRequest::get_filepath() const noexcept
+{
+    return filepath;
+}
+
+
+
+/*-------------------------------------
+ * Retrieve the current status
+-------------------------------------*/
+scene_load_status_t SceneLoadRequest::get_status() const noexcept
+{
+    return status.load();
+}
+
+
+
+/*-------------------------------------
+ * Retrieve the approximate progress
+-------------------------------------*/
+float SceneLoadRequest::get_progress() const noexcept
+{
+    switch (status.load())
+    {
+        case scene_load_status_t::SCENE_LOAD_QUEUED:
+            return 0.f;
+
+        case scene_load_status_t::SCENE_LOAD_PRELOADING:
+            return 0.25f;
+
+        case scene_load_status_t::SCENE_LOAD_PRELOADED:
+            return 0.5f;
+
+        case scene_load_status_t::SCENE_LOAD_UPLOADING:
+            return 0.75f;
+
+        default:
+            break;
+    }
+
+    return 1.f;
+}
+
+
+
+/*-------------------------------------
+ * Check if a request has finished
+-------------------------------------*/
+bool SceneLoadRequest::is_finished() const noexcept
+{
+    const scene_load_status_t s = status.load();
+
+    return s == scene_load_status_t::SCENE_LOAD_COMPLETE
+        || s == scene_load_status_t::SCENE_LOAD_FAILED
+        || s == scene_load_status_t::SCENE_LOAD_CANCELLED;
+}
+
+
+
+/*-------------------------------------
+ * Retrieve the completion future
+-------------------------------------*/
+std::shared_future<scene_load_status_t> SceneLoadRequest::get_future() const noexcept
+{
+    return future;
+}
+
+
+
+/*-------------------------------------
+ * Retrieve the loaded scene
+-------------------------------------*/
+SceneFileLoader& SceneLoadRequest::get_loader() noexcept
+{
+    return loader;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * SceneLoadService Class
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Destructor
+-------------------------------------*/
+SceneLoadService::~SceneLoadService() noexcept
+{
+    terminate();
+}
+
+
+
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+SceneLoadService::SceneLoadService() noexcept :
+    workers{},
+    threadsPerLoad{1},
+    queueLock{},
+    queueCond{},
+    preloadQueue{},
+    uploadLock{},
+    uploadQueue{},
+    shouldStop{false}
+{
+}
+
+
+
+/*-------------------------------------
+ * Start all worker threads
+-------------------------------------*/
+bool SceneLoadService::init(unsigned numThreads, const unsigned numThreadsPerLoad) noexcept
+{
+    terminate();
+
+    {
+        std::lock_guard<std::mutex> lock{queueLock};
+        threadsPerLoad = numThreadsPerLoad;
+    }
+
+    if (!numThreads)
+    {
+        numThreads = std::thread::hardware_concurrency();
+    }
+
+    numThreads = numThreads ? numThreads : 1;
+    workers.reserve(numThreads);
+
+    for (unsigned i = 0; i < numThreads; ++i)
+    {
+        try
+        {
+            // The worker list is only modified under the queue lock so
+            // "load(...)" can check for workers from any thread.
+            std::lock_guard<std::mutex> lock{queueLock};
+            workers.emplace_back(&SceneLoadService::thread_loop, this);
+        }
+        catch (const std::system_error& e)
+        {
+            LS_LOG_ERR("Unable to start a scene loading thread: ", e.what());
+            terminate();
+            return false;
+        }
+    }
+
+    LS_LOG_MSG("Started ", workers.size(), " scene loading threads.");
+
+    return true;
+}
+
+
+
+/*-------------------------------------
+ * Join all worker threads
+-------------------------------------*/
+void SceneLoadService::terminate() noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock{queueLock};
+        shouldStop = true;
+    }
+
+    queueCond.notify_all();
+
+    for (std::thread& t : workers)
+    {
+        t.join();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{queueLock};
+        workers.clear();
+
+        // Anything left over will never be processed.
+        for (const SceneLoadHandle& request : preloadQueue)
+        {
+            request->finish(scene_load_status_t::SCENE_LOAD_CANCELLED);
+        }
+        preloadQueue.clear();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{uploadLock};
+        for (const SceneLoadHandle& request : uploadQueue)
+        {
+            request->finish(scene_load_status_t::SCENE_LOAD_CANCELLED);
+        }
+        uploadQueue.clear();
+    }
+
+    shouldStop = false;
+}
+
+
+
+/*-------------------------------------
+ * Worker thread loop
+-------------------------------------*/
+void SceneLoadService::thread_loop() noexcept
+{
+    while (true)
+    {
+        SceneLoadHandle request;
+
+        {
+            std::unique_lock<std::mutex> lock{queueLock};
+            queueCond.wait(lock, [&]() -> bool
+            {
+                return shouldStop || !preloadQueue.empty();
+            });
+
+            if (shouldStop)
+            {
+                return;
+            }
+
+            request = std::move(preloadQueue.front());
+            preloadQueue.pop_front();
+
+            // Claiming the request while the queue is locked prevents a
+            // concurrent cancellation.
+            request->status = scene_load_status_t::SCENE_LOAD_PRELOADING;
+
+            // Each request runs alongside the other workers, so its own
+            // parallel stages are limited.
+            request->preloader.set_max_threads(threadsPerLoad);
+        }
+
+        if (!request->preloader.load(request->filepath, request->cacheFlags, request->packedTypes, request->importProfile))
+        {
+            request->finish(scene_load_status_t::SCENE_LOAD_FAILED);
+            continue;
+        }
+
+        std::lock_guard<std::mutex> lock{uploadLock};
+        request->status = scene_load_status_t::SCENE_LOAD_PRELOADED;
+        uploadQueue.emplace_back(std::move(request));
+    }
+}
+
+
+
+/*-------------------------------------
+ * Queue a single file
+-------------------------------------*/
+SceneLoadHandle SceneLoadService::load(
+    const std::string& filename,
+    const scene_cache_mode_t cacheMode,
+    const common_vertex_t packedVertTypes,
+    const scene_import_profile_t importProfile
+) noexcept
+{
+    SceneLoadHandle request{new(std::nothrow) SceneLoadRequest{filename, cacheMode, packedVertTypes, importProfile}};
+
+    if (!request)
+    {
+        LS_LOG_ERR("Unable to allocate a load request for ", filename, '.');
+        return request;
+    }
+
+    {
+        // Queued requests would never be picked up without a worker.
+        std::lock_guard<std::mutex> lock{queueLock};
+
+        if (workers.empty())
+        {
+            LS_LOG_ERR("Unable to load ", filename, " before the scene loading threads have started.");
+            request->finish(scene_load_status_t::SCENE_LOAD_FAILED);
+            return request;
+        }
+
+        preloadQueue.push_back(request);
+    }
+
+    queueCond.notify_one();
+
+    return request;
+}
+
+
+
+/*-------------------------------------
+ * Queue multiple files
+-------------------------------------*/
+std::vector<SceneLoadHandle> SceneLoadService::load(
+    const std::vector<std::string>& filenames,
+    const scene_cache_mode_t cacheMode,
+    const common_vertex_t packedVertTypes,
+    const scene_import_profile_t importProfile
+) noexcept
+{
+    std::vector<SceneLoadHandle> requests;
+    requests.reserve(filenames.size());
+
+    {
+        std::lock_guard<std::mutex> lock{queueLock};
+
+        for (const std::string& filename : filenames)
+        {
+            SceneLoadHandle request{new(std::nothrow) SceneLoadRequest{filename, cacheMode, packedVertTypes, importProfile}};
+
+            if (!request)
+            {
+                LS_LOG_ERR("Unable to allocate a load request for ", filename, '.');
+            }
+            else if (workers.empty())
+            {
+                LS_LOG_ERR("Unable to load ", filename, " before the scene loading threads have started.");
+                request->finish(scene_load_status_t::SCENE_LOAD_FAILED);
+            }
+            else
+            {
+                preloadQueue.push_back(request);
+            }
+
+            requests.emplace_back(std::move(request));
+        }
+    }
+
+    queueCond.notify_all();
+
+    return requests;
+}
+
+
+
+/*-------------------------------------
+ * Cancel a request
+-------------------------------------*/
+bool SceneLoadService::cancel(const SceneLoadHandle& handle) noexcept
+{
+    if (!handle)
+    {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{queueLock};
+
+        for (std::deque<SceneLoadHandle>::iterator iter = preloadQueue.begin(); iter != preloadQueue.end(); ++iter)
+        {
+            if (*iter == handle)
+            {
+                preloadQueue.erase(iter);
+                handle->finish(scene_load_status_t::SCENE_LOAD_CANCELLED);
+                return true;
+            }
+        }
+    }
+
+    std::lock_guard<std::mutex> lock{uploadLock};
+
+    for (std::deque<SceneLoadHandle>::iterator iter = uploadQueue.begin(); iter != uploadQueue.end(); ++iter)
+    {
+        if (*iter == handle)
+        {
+            uploadQueue.erase(iter);
+            handle->finish(scene_load_status_t::SCENE_LOAD_CANCELLED);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+
+/*-------------------------------------
+ * Upload preloaded scenes
+-------------------------------------*/
+unsigned SceneLoadService::update(const uint64_t budgetMicros) noexcept
+{
+    typedef std::chrono::steady_clock clock_type;
+
+    const clock_type::time_point startTime = clock_type::now();
+    unsigned numUploaded = 0;
+
+    while (true)
+    {
+        SceneLoadHandle request;
+
+        {
+            std::lock_guard<std::mutex> lock{uploadLock};
+
+            if (uploadQueue.empty())
+            {
+                break;
+            }
+
+            request = std::move(uploadQueue.front());
+            uploadQueue.pop_front();
+            request->status = scene_load_status_t::SCENE_LOAD_UPLOADING;
+        }
+
+        const bool ret = request->loader.load(std::move(request->preloader));
+        request->finish(ret ? scene_load_status_t::SCENE_LOAD_COMPLETE : scene_load_status_t::SCENE_LOAD_FAILED);
+
+        if (ret)
+        {
+            ++numUploaded;
+        }
+
+        const uint64_t elapsedMicros = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(clock_type::now() - startTime).count();
+
+        if (elapsedMicros >= budgetMicros)
+        {
+            break;
+        }
+    }
+
+    return numUploaded;
+}
+
+
+
+/*-------------------------------------
+ * Count all pending requests
+-------------------------------------*/
+size_t SceneLoadService::get_num_pending() noexcept
+{
+    size_t numPending = 0;
+
+    {
+        std::lock_guard<std::mutex> lock{queueLock};
+        numPending += preloadQueue.size();
+    }
+
+    std::lock_guard<std::mutex> lock{uploadLock};
+    numPending += uploadQueue.size();
+
+    return numPending;
+}
+} // end draw namespace
+} // end ls namespace
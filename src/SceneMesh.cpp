@@ -21,8 +21,12 @@ void MeshMetaData::reset() noexcept
     numSubmeshes = 0;
     vertTypes = (common_vertex_t)0;
     totalVerts = 0;
+    baseVertex = 0;
+    vboOffset = 0;
     indexType = index_element_t::INDEX_TYPE_NONE;
     totalIndices = 0;
+    dequantScale = math::vec3{1.f, 1.f, 1.f};
+    dequantBias = math::vec3{0.f, 0.f, 0.f};
 }
 
 
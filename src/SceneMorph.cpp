@@ -0,0 +1,67 @@
+
+#include "lightsky/utils/Assertions.h"
+
+#include "lightsky/draw/SceneMorph.h"
+
+
+
+namespace ls
+{
+namespace draw
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * SceneMorph Structure
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Reset all morph targets
+-------------------------------------*/
+void SceneMorph::reset() noexcept
+{
+    baseVertex = 0;
+    numVerts = 0;
+    vertOffsets.clear();
+    deltas.clear();
+    targetNames.clear();
+    weights.clear();
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * Morphing Functions
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * CPU Morphing
+-------------------------------------*/
+void morph_vertex_positions(const SceneMorph& morph, math::vec3* const pPositions) noexcept
+{
+    if (!morph.get_num_targets())
+    {
+        return;
+    }
+
+    LS_DEBUG_ASSERT(morph.vertOffsets.size() == morph.numVerts + 1);
+
+    const unsigned* const pOffsets = morph.vertOffsets.data();
+    const SceneMorphDelta* const pDeltas = morph.deltas.data();
+    const float* const pWeights = morph.weights.data();
+
+    for (unsigned v = 0; v < morph.numVerts; ++v)
+    {
+        for (unsigned d = pOffsets[v]; d < pOffsets[v + 1]; ++d)
+        {
+            const SceneMorphDelta& delta = pDeltas[d];
+            const float weight = pWeights[delta.targetId];
+
+            if (weight != 0.f)
+            {
+                pPositions[v] += delta.position * weight;
+            }
+        }
+    }
+}
+} // end draw namespace
+} // end ls namespace
@@ -0,0 +1,308 @@
+
+#include <cstring> // std::strlen(), std::memcmp()
+#include <utility> // std::move
+
+#include "lightsky/draw/SceneNameTable.h"
+
+
+
+namespace ls
+{
+namespace draw
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * SceneNameTable Class
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Destructor
+-------------------------------------*/
+SceneNameTable::~SceneNameTable() noexcept
+{
+}
+
+
+
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+SceneNameTable::SceneNameTable() noexcept :
+    pData{nullptr}
+{
+}
+
+
+
+/*-------------------------------------
+ * Copy Constructor
+-------------------------------------*/
+SceneNameTable::SceneNameTable(const SceneNameTable& t) noexcept :
+    pData{t.pData}
+{
+}
+
+
+
+/*-------------------------------------
+ * Move Constructor
+-------------------------------------*/
+SceneNameTable::SceneNameTable(SceneNameTable&& t) noexcept :
+    pData{std::move(t.pData)}
+{
+}
+
+
+
+/*-------------------------------------
+ * Copy Operator
+-------------------------------------*/
+SceneNameTable& SceneNameTable::operator=(const SceneNameTable& t) noexcept
+{
+    pData = t.pData;
+    return *this;
+}
+
+
+
+/*-------------------------------------
+ * Move Operator
+-------------------------------------*/
+SceneNameTable& SceneNameTable::operator=(SceneNameTable&& t) noexcept
+{
+    if (this != &t)
+    {
+        pData = std::move(t.pData);
+    }
+
+    return *this;
+}
+
+
+
+/*-------------------------------------
+ * Copy-on-write access to storage
+-------------------------------------*/
+SceneNameTable::NameData& SceneNameTable::get_unique_data() noexcept
+{
+    if (!pData)
+    {
+        pData = std::make_shared<NameData>();
+    }
+    else if (pData.use_count() > 1)
+    {
+        pData = std::make_shared<NameData>(*pData);
+    }
+
+    return *pData;
+}
+
+
+
+/*-------------------------------------
+ * Insert into the hash table
+-------------------------------------*/
+void SceneNameTable::insert_bucket(std::vector<scene_name_t>& buckets, const utils::hash_t hash, const scene_name_t nameId) noexcept
+{
+    const size_t mask = buckets.size() - 1;
+    size_t i = (size_t)hash & mask;
+
+    while (buckets[i] != SCENE_NAME_INVALID)
+    {
+        i = (i + 1) & mask;
+    }
+
+    buckets[i] = nameId;
+}
+
+
+
+/*-------------------------------------
+ * Search the hash table
+-------------------------------------*/
+scene_name_t SceneNameTable::find_name(const char* pName, const size_t numChars, const utils::hash_t hash) const noexcept
+{
+    if (!pData || pData->buckets.empty())
+    {
+        return SCENE_NAME_INVALID;
+    }
+
+    const std::vector<scene_name_t>& buckets = pData->buckets;
+    const std::vector<NameEntry>& entries = pData->entries;
+    const char* const pChars = pData->chars.data();
+    const size_t mask = buckets.size() - 1;
+
+    // The table is never more than half full, an empty bucket is always
+    // reached.
+    for (size_t i = (size_t)hash & mask; buckets[i] != SCENE_NAME_INVALID; i = (i + 1) & mask)
+    {
+        const NameEntry& entry = entries[buckets[i]];
+
+        if (entry.hash == hash
+        && entry.numChars == numChars
+        && 0 == std::memcmp(pChars + entry.offset, pName, numChars)
+        ) {
+            return buckets[i];
+        }
+    }
+
+    return SCENE_NAME_INVALID;
+}
+
+
+
+/*-------------------------------------
+ * Add a name
+-------------------------------------*/
+scene_name_t SceneNameTable::intern_name(const char* pName, const size_t numChars) noexcept
+{
+    const utils::hash_t hash = utils::string_hash(pName);
+    const scene_name_t existingId = find_name(pName, numChars, hash);
+
+    if (existingId != SCENE_NAME_INVALID)
+    {
+        return existingId;
+    }
+
+    NameData& data = get_unique_data();
+    const scene_name_t nameId = (scene_name_t)data.entries.size();
+
+    // Keep the hash table at most half full so probing stays short.
+    if (data.buckets.size() < (data.entries.size() + 1) * 2)
+    {
+        std::vector<scene_name_t> buckets(data.buckets.empty() ? 16 : (data.buckets.size() * 2), (scene_name_t)SCENE_NAME_INVALID);
+
+        for (size_t i = 0; i < data.entries.size(); ++i)
+        {
+            insert_bucket(buckets, data.entries[i].hash, (scene_name_t)i);
+        }
+
+        data.buckets = std::move(buckets);
+    }
+
+    data.entries.push_back(NameEntry{(uint32_t)data.chars.size(), (uint32_t)numChars, hash});
+    data.chars.insert(data.chars.end(), pName, pName + numChars);
+    data.chars.push_back('\0');
+
+    insert_bucket(data.buckets, hash, nameId);
+
+    return nameId;
+}
+
+
+
+/*-------------------------------------
+ * Intern a C-string
+-------------------------------------*/
+scene_name_t SceneNameTable::intern(const char* pName) noexcept
+{
+    if (!pName)
+    {
+        pName = "";
+    }
+
+    return intern_name(pName, std::strlen(pName));
+}
+
+
+
+/*-------------------------------------
+ * Intern a string object
+-------------------------------------*/
+scene_name_t SceneNameTable::intern(const std::string& name) noexcept
+{
+    return intern_name(name.c_str(), name.size());
+}
+
+
+
+/*-------------------------------------
+ * Find a C-string
+-------------------------------------*/
+scene_name_t SceneNameTable::find(const char* pName) const noexcept
+{
+    if (!pName)
+    {
+        pName = "";
+    }
+
+    return find_name(pName, std::strlen(pName), utils::string_hash(pName));
+}
+
+
+
+/*-------------------------------------
+ * Find a string object
+-------------------------------------*/
+scene_name_t SceneNameTable::find(const std::string& name) const noexcept
+{
+    return find_name(name.c_str(), name.size(), utils::string_hash(name.c_str()));
+}
+
+
+
+/*-------------------------------------
+ * Get the characters of a name
+-------------------------------------*/
+const char* SceneNameTable::get_name(const scene_name_t nameId) const noexcept
+{
+    if (nameId >= size())
+    {
+        return "";
+    }
+
+    return pData->chars.data() + pData->entries[nameId].offset;
+}
+
+
+
+/*-------------------------------------
+ * Get the length of a name
+-------------------------------------*/
+size_t SceneNameTable::get_name_length(const scene_name_t nameId) const noexcept
+{
+    return (nameId < size()) ? pData->entries[nameId].numChars : 0;
+}
+
+
+
+/*-------------------------------------
+ * Get the hash of a name
+-------------------------------------*/
+utils::hash_t SceneNameTable::get_hash(const scene_name_t nameId) const noexcept
+{
+    return (nameId < size()) ? pData->entries[nameId].hash : utils::string_hash("");
+}
+
+
+
+/*-------------------------------------
+ * Get the memory usage
+-------------------------------------*/
+size_t SceneNameTable::get_num_bytes() const noexcept
+{
+    if (!pData)
+    {
+        return 0;
+    }
+
+    return pData->chars.capacity()
+        + sizeof(NameEntry) * pData->entries.capacity()
+        + sizeof(scene_name_t) * pData->buckets.capacity();
+}
+
+
+
+/*-------------------------------------
+ * Remove all names
+-------------------------------------*/
+void SceneNameTable::clear() noexcept
+{
+    pData.reset();
+}
+
+
+
+} // end draw namespace
+} // end ls namespace
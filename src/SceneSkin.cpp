@@ -0,0 +1,226 @@
+
+#if defined(__SSE__) || defined(_M_X64)
+    #include <xmmintrin.h>
+    #define LS_DRAW_SKIN_SSE 1
+#elif defined(__ARM_NEON)
+    #include <arm_neon.h>
+    #define LS_DRAW_SKIN_NEON 1
+#endif
+
+#include "lightsky/utils/Assertions.h"
+
+#include "lightsky/draw/SceneGraph.h"
+#include "lightsky/draw/SceneSkin.h"
+
+
+
+/*-----------------------------------------------------------------------------
+ * Anonymous helper functions
+-----------------------------------------------------------------------------*/
+namespace
+{
+
+namespace math = ls::math;
+
+typedef math::vec4_t<unsigned char> bone_bytes_t;
+
+
+
+/*-------------------------------------
+ * Skin a single vertex position
+-------------------------------------*/
+#if defined(LS_DRAW_SKIN_SSE)
+
+inline math::vec3 skin_vertex_position(
+    const math::mat4* const pPalette,
+    const bone_bytes_t& boneIds,
+    const bone_bytes_t& boneWeights,
+    const math::vec3& pos
+) noexcept
+{
+    __m128 c0 = _mm_setzero_ps();
+    __m128 c1 = _mm_setzero_ps();
+    __m128 c2 = _mm_setzero_ps();
+    __m128 c3 = _mm_setzero_ps();
+
+    // Blend all bone matrices, column by column, before transforming the
+    // vertex. This only requires one matrix-vector multiply per vertex.
+    for (unsigned i = 0; i < ls::draw::SKIN_MAX_VERTEX_INFLUENCES; ++i)
+    {
+        if (!boneWeights[i])
+        {
+            continue;
+        }
+
+        const __m128 w = _mm_set1_ps((float)boneWeights[i] * (1.f / 255.f));
+        const float* const pM = &pPalette[boneIds[i]][0][0];
+
+        c0 = _mm_add_ps(c0, _mm_mul_ps(_mm_loadu_ps(pM + 0), w));
+        c1 = _mm_add_ps(c1, _mm_mul_ps(_mm_loadu_ps(pM + 4), w));
+        c2 = _mm_add_ps(c2, _mm_mul_ps(_mm_loadu_ps(pM + 8), w));
+        c3 = _mm_add_ps(c3, _mm_mul_ps(_mm_loadu_ps(pM + 12), w));
+    }
+
+    __m128 ret = _mm_add_ps(c3, _mm_mul_ps(c0, _mm_set1_ps(pos[0])));
+    ret = _mm_add_ps(ret, _mm_mul_ps(c1, _mm_set1_ps(pos[1])));
+    ret = _mm_add_ps(ret, _mm_mul_ps(c2, _mm_set1_ps(pos[2])));
+
+    float out[4];
+    _mm_storeu_ps(out, ret);
+
+    return math::vec3{out[0], out[1], out[2]};
+}
+
+#elif defined(LS_DRAW_SKIN_NEON)
+
+inline math::vec3 skin_vertex_position(
+    const math::mat4* const pPalette,
+    const bone_bytes_t& boneIds,
+    const bone_bytes_t& boneWeights,
+    const math::vec3& pos
+) noexcept
+{
+    float32x4_t c0 = vdupq_n_f32(0.f);
+    float32x4_t c1 = vdupq_n_f32(0.f);
+    float32x4_t c2 = vdupq_n_f32(0.f);
+    float32x4_t c3 = vdupq_n_f32(0.f);
+
+    for (unsigned i = 0; i < ls::draw::SKIN_MAX_VERTEX_INFLUENCES; ++i)
+    {
+        if (!boneWeights[i])
+        {
+            continue;
+        }
+
+        const float32x4_t w = vdupq_n_f32((float)boneWeights[i] * (1.f / 255.f));
+        const float* const pM = &pPalette[boneIds[i]][0][0];
+
+        c0 = vmlaq_f32(c0, vld1q_f32(pM + 0), w);
+        c1 = vmlaq_f32(c1, vld1q_f32(pM + 4), w);
+        c2 = vmlaq_f32(c2, vld1q_f32(pM + 8), w);
+        c3 = vmlaq_f32(c3, vld1q_f32(pM + 12), w);
+    }
+
+    float32x4_t ret = vmlaq_n_f32(c3, c0, pos[0]);
+    ret = vmlaq_n_f32(ret, c1, pos[1]);
+    ret = vmlaq_n_f32(ret, c2, pos[2]);
+
+    float out[4];
+    vst1q_f32(out, ret);
+
+    return math::vec3{out[0], out[1], out[2]};
+}
+
+#else
+
+inline math::vec3 skin_vertex_position(
+    const math::mat4* const pPalette,
+    const bone_bytes_t& boneIds,
+    const bone_bytes_t& boneWeights,
+    const math::vec3& pos
+) noexcept
+{
+    const math::vec4 v{pos[0], pos[1], pos[2], 1.f};
+    math::vec4 ret{0.f, 0.f, 0.f, 0.f};
+
+    for (unsigned i = 0; i < ls::draw::SKIN_MAX_VERTEX_INFLUENCES; ++i)
+    {
+        if (boneWeights[i])
+        {
+            ret += (pPalette[boneIds[i]] * v) * ((float)boneWeights[i] * (1.f / 255.f));
+        }
+    }
+
+    return math::vec3{ret[0], ret[1], ret[2]};
+}
+
+#endif /* LS_DRAW_SKIN_SSE */
+} // end anonymous namespace
+
+
+
+namespace ls
+{
+namespace draw
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * SceneSkin Structure
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Reset all bones
+-------------------------------------*/
+void SceneSkin::reset() noexcept
+{
+    boneIds.clear();
+    inverseBindPoses.clear();
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * Skinning Functions
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Calculate a bone palette
+-------------------------------------*/
+void calc_skin_palette(const SceneGraph& graph, const SceneSkin& skin, math::mat4* const pOutPalette) noexcept
+{
+    LS_DEBUG_ASSERT(skin.boneIds.size() == skin.inverseBindPoses.size());
+
+    const size_t* const pBoneIds = skin.boneIds.data();
+    const math::mat4* const pBindPoses = skin.inverseBindPoses.data();
+    const math::mat4* const pModelMats = graph.modelMatrices.data();
+
+    for (size_t i = skin.boneIds.size(); i--;)
+    {
+        const size_t boneId = pBoneIds[i];
+
+        if (boneId == scene_property_t::SCENE_GRAPH_ROOT_ID)
+        {
+            pOutPalette[i] = math::mat4(1.f);
+        }
+        else
+        {
+            pOutPalette[i] = pModelMats[boneId] * pBindPoses[i];
+        }
+    }
+}
+
+
+
+/*-------------------------------------
+ * CPU Skinning
+-------------------------------------*/
+void skin_vertex_positions(
+    const math::mat4* const pPalette,
+    const char* const pVerts,
+    const common_vertex_t vertTypes,
+    const unsigned numVerts,
+    math::vec3* const pOutPositions
+) noexcept
+{
+    LS_DEBUG_ASSERT(0 != (vertTypes & common_vertex_t::POSITION_VERTEX));
+    LS_DEBUG_ASSERT(common_vertex_t::BONE_VERTEX == (vertTypes & common_vertex_t::BONE_VERTEX));
+
+    const unsigned stride = get_vertex_stride(vertTypes);
+    const unsigned posOffset = get_vertex_attrib_offset(vertTypes, common_vertex_t::POSITION_VERTEX);
+    const unsigned idOffset = get_vertex_attrib_offset(vertTypes, common_vertex_t::BONE_ID_VERTEX);
+    const unsigned weightOffset = get_vertex_attrib_offset(vertTypes, common_vertex_t::BONE_WEIGHT_VERTEX);
+
+    const char* pVert = pVerts;
+
+    for (unsigned i = 0; i < numVerts; ++i)
+    {
+        const math::vec3& pos = *reinterpret_cast<const math::vec3*>(pVert + posOffset);
+        const bone_bytes_t& ids = *reinterpret_cast<const bone_bytes_t*>(pVert + idOffset);
+        const bone_bytes_t& weights = *reinterpret_cast<const bone_bytes_t*>(pVert + weightOffset);
+
+        pOutPositions[i] = skin_vertex_position(pPalette, ids, weights, pos);
+        pVert += stride;
+    }
+}
+} // end draw namespace
+} // end ls namespace
@@ -0,0 +1,833 @@
+
+#include <algorithm> // std::sort, std::upper_bound
+#include <climits> // UINT_MAX
+#include <limits> // std::numeric_limits
+#include <unordered_map>
+#include <utility> // std::move, std::pair
+
+#include "lightsky/utils/Assertions.h"
+#include "lightsky/utils/Log.h"
+
+#include "lightsky/math/vec4.h"
+
+#include "lightsky/draw/BoundingBox.h"
+#include "lightsky/draw/Camera.h"
+#include "lightsky/draw/DrawParams.h"
+#include "lightsky/draw/IndexBuffer.h"
+#include "lightsky/draw/MeshCodec.h"
+#include "lightsky/draw/SceneStreamer.h"
+#include "lightsky/draw/VertexBuffer.h"
+
+
+
+/*-----------------------------------------------------------------------------
+ * Anonymous helper functions
+-----------------------------------------------------------------------------*/
+namespace
+{
+
+namespace draw = ls::draw;
+namespace math = ls::math;
+
+/*-------------------------------------
+ * Mapping flags for streamed buffer ranges
+ *
+ * Other ranges of the streaming buffers may still be in use by the GPU, so
+ * neither the entire buffer nor unsynchronized writes can be used.
+-------------------------------------*/
+constexpr draw::buffer_map_t STREAMED_MESH_MAP_FLAGS = (draw::buffer_map_t)(0
+    | draw::buffer_map_t::VBO_MAP_BIT_INVALIDATE_RANGE
+    | draw::buffer_map_t::VBO_MAP_BIT_WRITE
+    | 0);
+
+
+
+/*-------------------------------------
+ * Calculate the largest axis scale of a transformation
+-------------------------------------*/
+inline float calc_max_scale(const math::mat4& m) noexcept
+{
+    const float sx = math::length(math::vec3{m[0][0], m[0][1], m[0][2]});
+    const float sy = math::length(math::vec3{m[1][0], m[1][1], m[1][2]});
+    const float sz = math::length(math::vec3{m[2][0], m[2][1], m[2][2]});
+
+    return math::max(sx, math::max(sy, sz));
+}
+
+
+
+/*-------------------------------------
+ * Locate the mesh which owns a range of a cached buffer
+-------------------------------------*/
+inline uint32_t find_block_mesh(const std::vector<std::pair<uint64_t, uint32_t>>& meshStarts, const uint64_t rawOffset) noexcept
+{
+    std::vector<std::pair<uint64_t, uint32_t>>::const_iterator iter = std::upper_bound(
+        meshStarts.begin(),
+        meshStarts.end(),
+        std::pair<uint64_t, uint32_t>{rawOffset, UINT_MAX}
+    );
+
+    return iter == meshStarts.begin() ? UINT_MAX : (iter - 1)->second;
+}
+} // end anonymous namespace
+
+
+
+namespace ls
+{
+namespace draw
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * SceneStreamer Class
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Destructor
+-------------------------------------*/
+SceneStreamer::~SceneStreamer() noexcept
+{
+    unload();
+}
+
+
+
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+SceneStreamer::SceneStreamer() noexcept :
+    loader{},
+    vboAllocator{},
+    iboAllocator{},
+    meshes{},
+    draws{},
+    meshBlocks{},
+    loadOrder{},
+    evictOrder{},
+    scratch{},
+    residencyBudget{0},
+    residentBytes{0},
+    maxDistance{std::numeric_limits<float>::max()},
+    frameId{0}
+{
+}
+
+
+
+/*-------------------------------------
+ * Move Constructor
+-------------------------------------*/
+SceneStreamer::SceneStreamer(SceneStreamer&& s) noexcept :
+    loader{std::move(s.loader)},
+    vboAllocator{std::move(s.vboAllocator)},
+    iboAllocator{std::move(s.iboAllocator)},
+    meshes{std::move(s.meshes)},
+    draws{std::move(s.draws)},
+    meshBlocks{std::move(s.meshBlocks)},
+    loadOrder{std::move(s.loadOrder)},
+    evictOrder{std::move(s.evictOrder)},
+    scratch{std::move(s.scratch)},
+    residencyBudget{s.residencyBudget},
+    residentBytes{s.residentBytes},
+    maxDistance{s.maxDistance},
+    frameId{s.frameId}
+{
+    s.residencyBudget = 0;
+    s.residentBytes = 0;
+    s.frameId = 0;
+}
+
+
+
+/*-------------------------------------
+ * Move Operator
+-------------------------------------*/
+SceneStreamer& SceneStreamer::operator=(SceneStreamer&& s) noexcept
+{
+    unload();
+
+    loader = std::move(s.loader);
+    vboAllocator = std::move(s.vboAllocator);
+    iboAllocator = std::move(s.iboAllocator);
+    meshes = std::move(s.meshes);
+    draws = std::move(s.draws);
+    meshBlocks = std::move(s.meshBlocks);
+    loadOrder = std::move(s.loadOrder);
+    evictOrder = std::move(s.evictOrder);
+    scratch = std::move(s.scratch);
+
+    residencyBudget = s.residencyBudget;
+    s.residencyBudget = 0;
+
+    residentBytes = s.residentBytes;
+    s.residentBytes = 0;
+
+    maxDistance = s.maxDistance;
+
+    frameId = s.frameId;
+    s.frameId = 0;
+
+    return *this;
+}
+
+
+
+/*-------------------------------------
+ * Unload all data
+-------------------------------------*/
+void SceneStreamer::unload() noexcept
+{
+    loader.unload();
+    vboAllocator.reset(0);
+    iboAllocator.reset(0);
+    meshes.clear();
+    draws.clear();
+    meshBlocks.clear();
+    loadOrder.clear();
+    evictOrder.clear();
+    scratch.clear();
+    residencyBudget = 0;
+    residentBytes = 0;
+    frameId = 0;
+}
+
+
+
+/*-------------------------------------
+ * Load a scene file for streaming
+-------------------------------------*/
+bool SceneStreamer::load(
+    const std::string& filename,
+    const uint64_t budgetBytes,
+    const common_vertex_t packedVertTypes
+) noexcept
+{
+    unload();
+
+    SceneFilePreLoader preload;
+
+    // Streamed meshes are always drawn with a base vertex, so their indices
+    // are imported relative to each mesh.
+    if (!preload.load(filename, SCENE_CACHE_READ_WRITE, packedVertTypes, SCENE_IMPORT_BASE_VERTEX))
+    {
+        return false;
+    }
+
+    // Mesh payloads are streamed from the binary cache. Files without an
+    // up-to-date cache are imported once in order to generate it.
+    if (!preload.cache.is_open())
+    {
+        LS_LOG_MSG("\tImporting ", filename, " to generate a scene cache for streaming.");
+
+        const bool ret = loader.load(std::move(preload));
+        loader.unload();
+
+        if (!ret || !preload.load(filename, SCENE_CACHE_READ, packedVertTypes, SCENE_IMPORT_BASE_VERTEX) || !preload.cache.is_open())
+        {
+            LS_LOG_ERR("\tError: Unable to generate a scene cache to stream ", filename, ".\n");
+            return false;
+        }
+    }
+
+    return load(std::move(preload), budgetBytes);
+}
+
+
+
+/*-------------------------------------
+ * Stream a preloaded scene
+-------------------------------------*/
+bool SceneStreamer::load(SceneFilePreLoader&& preload, const uint64_t budgetBytes) noexcept
+{
+    LS_DEBUG_ASSERT(&preload != &loader.preloader);
+
+    unload();
+
+    #if !defined(LS_DRAW_BASE_VERTEX_SUPPORTED)
+        LS_LOG_ERR("\tError: Streamed scenes require base-vertex draws, which are unavailable with the current graphics API.\n");
+        return false;
+    #endif
+
+    if (!preload.cache.is_open())
+    {
+        LS_LOG_ERR("\tError: Only scenes which were loaded from a binary cache can be streamed.\n");
+        return false;
+    }
+
+    if (!budgetBytes)
+    {
+        LS_LOG_ERR("\tError: Unable to stream a scene without a residency budget.\n");
+        return false;
+    }
+
+    loader.preloader = std::move(preload);
+
+    if (!init_streaming_data())
+    {
+        LS_LOG_ERR("\tError: Unable to locate the meshes of ", loader.preloader.filepath, " within its scene cache.\n");
+        unload();
+        return false;
+    }
+
+    // The streaming buffers are split in proportion to the scene's own
+    // vertex and index data. Extra space reduces the number of evictions
+    // caused by fragmentation and alignment.
+    const SceneFileMetaData& sceneInfo = loader.preloader.sceneInfo;
+    const uint64_t totalVboBytes = sceneInfo.totalVertices ? sceneInfo.totalVboBytes : 0;
+    const uint64_t totalIboBytes = sceneInfo.totalIndices ? sceneInfo.totalIboBytes : 0;
+    const uint64_t totalBytes = totalVboBytes + totalIboBytes;
+    const uint64_t streamedBytes = math::min<uint64_t>(budgetBytes, totalBytes);
+    const uint64_t vboShare = totalBytes ? (uint64_t)((double)streamedBytes * ((double)totalVboBytes / (double)totalBytes)) : 0;
+    const uint64_t iboShare = streamedBytes - vboShare;
+    uint32_t maxStride = 0;
+
+    for (const VboGroupMarker& m : loader.preloader.vboMarkers)
+    {
+        maxStride = math::max<uint32_t>(maxStride, get_vertex_byte_size(m.vertType));
+    }
+
+    uint64_t numVboBytes = totalVboBytes ? (math::min<uint64_t>(vboShare + vboShare / 8, totalVboBytes) + maxStride * loader.preloader.vboMarkers.size()) : 0;
+    uint64_t numIboBytes = totalIboBytes ? (math::min<uint64_t>(iboShare + iboShare / 8, totalIboBytes) + sizeof(uint32_t) * meshes.size()) : 0;
+
+    numVboBytes = math::min<uint64_t>(numVboBytes, UINT_MAX);
+    numIboBytes = math::min<uint64_t>(numIboBytes, UINT_MAX);
+
+    if (!loader.load_streamed_scene((unsigned)numVboBytes, (unsigned)numIboBytes))
+    {
+        unload();
+        return false;
+    }
+
+    vboAllocator.reset(numVboBytes);
+    iboAllocator.reset(numIboBytes);
+    residencyBudget = budgetBytes;
+
+    // Nothing is drawn until meshes have been uploaded.
+    for (uint32_t i = 0; i < meshes.size(); ++i)
+    {
+        update_draw_params(i);
+    }
+
+    LS_LOG_MSG(
+        "\tStreaming ", meshes.size(), " meshes within a budget of ", budgetBytes, " bytes.",
+        "\n\t\tStreaming VBO: ", numVboBytes, " bytes",
+        "\n\t\tStreaming IBO: ", numIboBytes, " bytes",
+        '\n'
+    );
+
+    return true;
+}
+
+
+
+/*-------------------------------------
+ * Match draw commands and cache blocks to meshes
+-------------------------------------*/
+bool SceneStreamer::init_streaming_data() noexcept
+{
+    const SceneGraph& sceneData = loader.preloader.sceneData;
+    const std::vector<SceneMesh>& sceneMeshes = sceneData.meshes;
+    const std::vector<SceneCachePayloadBlock>& blocks = loader.preloader.cacheBlocks;
+    const SceneCacheHeader& header = loader.preloader.cache.get_header();
+    const bool isEncoded = header.payloadEncoding == SCENE_CACHE_PAYLOAD_ENCODED;
+    const uint32_t numMeshes = (uint32_t)sceneMeshes.size();
+
+    if (sceneData.bounds.size() != numMeshes)
+    {
+        LS_LOG_ERR("\t\tThe scene cache does not contain the bounds of each mesh.");
+        return false;
+    }
+
+    // Node draw commands are copies of their mesh's draw parameters. Each
+    // mesh occupies its own range of the IBO, so its index offset is unique.
+    std::unordered_map<uint64_t, uint32_t> meshIds;
+    meshIds.reserve(numMeshes);
+    meshes.resize(numMeshes);
+
+    for (uint32_t i = 0; i < numMeshes; ++i)
+    {
+        const SceneMesh& mesh = sceneMeshes[i];
+        const MeshMetaData& metaData = mesh.metaData;
+        SceneStreamedMesh& m = meshes[i];
+
+        m.srcVboOffset = metaData.vboOffset;
+        m.srcIboOffset = (uint64_t)(ptrdiff_t)mesh.drawParams.offset;
+        m.firstBlock = 0;
+        m.numBlocks = 0;
+        m.firstDraw = 0;
+        m.numDraws = 0;
+        m.indexBias = metaData.baseVertex - (uint32_t)mesh.drawParams.baseVertex;
+        m.vboOffset = 0;
+        m.iboOffset = 0;
+        m.lastVisibleFrame = 0;
+        m.priority = std::numeric_limits<float>::infinity();
+        m.isResident = false;
+        m.isCorrupt = !metaData.totalVerts || !metaData.totalIndices;
+
+        if (m.isCorrupt)
+        {
+            continue;
+        }
+
+        if (!isEncoded
+        && (m.srcVboOffset + metaData.calc_total_vertex_bytes() > header.vboBytes
+        || m.srcIboOffset + metaData.calc_total_index_bytes() > header.iboBytes))
+        {
+            return false;
+        }
+
+        meshIds[m.srcIboOffset] = i;
+    }
+
+    for (const SceneNode& node : sceneData.nodes)
+    {
+        if (node.type != scene_node_t::NODE_TYPE_MESH)
+        {
+            continue;
+        }
+
+        const DrawCommandParams* const pNodeMeshes = sceneData.nodeMeshes[node.dataId].get();
+
+        for (uint32_t j = 0; j < sceneData.nodeMeshCounts[node.dataId]; ++j)
+        {
+            const std::unordered_map<uint64_t, uint32_t>::const_iterator iter = meshIds.find((uint64_t)(ptrdiff_t)pNodeMeshes[j].offset);
+
+            if (iter != meshIds.end())
+            {
+                draws.push_back(SceneStreamedDraw{(uint32_t)node.nodeId, (uint32_t)node.dataId, j, iter->second});
+                meshes[iter->second].numDraws++;
+            }
+        }
+    }
+
+    std::sort(draws.begin(), draws.end(), [](const SceneStreamedDraw& a, const SceneStreamedDraw& b) -> bool
+    {
+        return a.meshId < b.meshId;
+    });
+
+    for (uint32_t i = 0, firstDraw = 0; i < numMeshes; ++i)
+    {
+        meshes[i].firstDraw = firstDraw;
+        firstDraw += meshes[i].numDraws;
+    }
+
+    if (!isEncoded)
+    {
+        return true;
+    }
+
+    // Blocks never span multiple meshes, so each belongs to the mesh whose
+    // range contains its first byte.
+    std::vector<std::pair<uint64_t, uint32_t>> vertStarts;
+    std::vector<std::pair<uint64_t, uint32_t>> indexStarts;
+    std::vector<uint64_t> blockBytes(numMeshes, 0);
+    std::vector<uint32_t> blockMeshIds(blocks.size(), UINT_MAX);
+
+    for (uint32_t i = 0; i < numMeshes; ++i)
+    {
+        if (!meshes[i].isCorrupt)
+        {
+            vertStarts.emplace_back(meshes[i].srcVboOffset, i);
+            indexStarts.emplace_back(meshes[i].srcIboOffset, i);
+        }
+    }
+
+    std::sort(vertStarts.begin(), vertStarts.end());
+    std::sort(indexStarts.begin(), indexStarts.end());
+
+    for (size_t i = 0; i < blocks.size(); ++i)
+    {
+        const SceneCachePayloadBlock& b = blocks[i];
+        const bool isVertexBlock = b.codec == mesh_codec_t::MESH_CODEC_VERTICES;
+        const uint32_t meshId = find_block_mesh(isVertexBlock ? vertStarts : indexStarts, b.rawOffset);
+
+        if (meshId == UINT_MAX)
+        {
+            continue;
+        }
+
+        const MeshMetaData& metaData = sceneMeshes[meshId].metaData;
+        const uint64_t meshStart = isVertexBlock ? meshes[meshId].srcVboOffset : meshes[meshId].srcIboOffset;
+        const uint64_t meshBytes = isVertexBlock ? metaData.calc_total_vertex_bytes() : metaData.calc_total_index_bytes();
+
+        if (b.rawOffset + b.rawBytes > meshStart + meshBytes)
+        {
+            return false;
+        }
+
+        blockMeshIds[i] = meshId;
+        blockBytes[meshId] += b.rawBytes;
+        meshes[meshId].numBlocks++;
+    }
+
+    for (uint32_t i = 0, firstBlock = 0; i < numMeshes; ++i)
+    {
+        SceneStreamedMesh& m = meshes[i];
+
+        if (!m.isCorrupt && blockBytes[i] != sceneMeshes[i].metaData.calc_total_bytes())
+        {
+            return false;
+        }
+
+        m.firstBlock = firstBlock;
+        firstBlock += m.numBlocks;
+        m.numBlocks = 0;
+    }
+
+    meshBlocks.resize(blocks.size());
+
+    for (uint32_t i = 0; i < blocks.size(); ++i)
+    {
+        if (blockMeshIds[i] != UINT_MAX)
+        {
+            SceneStreamedMesh& m = meshes[blockMeshIds[i]];
+            meshBlocks[m.firstBlock + m.numBlocks++] = i;
+        }
+    }
+
+    return true;
+}
+
+
+
+/*-------------------------------------
+ * Calculate mesh priorities
+-------------------------------------*/
+void SceneStreamer::update_priorities(const math::vec3& viewPos, const math::mat4& viewProjMatrix) noexcept
+{
+    const SceneGraph& sceneData = loader.preloader.sceneData;
+
+    for (SceneStreamedMesh& m : meshes)
+    {
+        m.priority = std::numeric_limits<float>::infinity();
+    }
+
+    // Every instance of a mesh is tested. Its priority is the distance to
+    // its nearest instance.
+    for (const SceneStreamedDraw& d : draws)
+    {
+        SceneStreamedMesh& m = meshes[d.meshId];
+        const math::mat4& modelMatrix = sceneData.modelMatrices[d.nodeId];
+        const BoundingBox& bounds = sceneData.bounds[d.meshId];
+        const math::vec3& trr = bounds.get_top_rear_right();
+        const math::vec3& bfl = bounds.get_bot_front_left();
+
+        const math::vec3&& center = (trr + bfl) * 0.5f;
+        const math::vec4&& worldCenter = modelMatrix * math::vec4{center[0], center[1], center[2], 1.f};
+        const float radius = math::length(trr - bfl) * 0.5f * calc_max_scale(modelMatrix);
+        const float centerDist = math::length(math::vec3{worldCenter[0], worldCenter[1], worldCenter[2]} - viewPos);
+        const float dist = math::max(0.f, centerDist - radius);
+
+        if (dist > maxDistance)
+        {
+            continue;
+        }
+
+        if (dist <= 0.f || is_visible(bounds, viewProjMatrix * modelMatrix))
+        {
+            m.lastVisibleFrame = frameId;
+        }
+
+        m.priority = math::min(m.priority, dist);
+    }
+}
+
+
+
+/*-------------------------------------
+ * Upload and evict meshes
+-------------------------------------*/
+unsigned SceneStreamer::update(const math::vec3& viewPos, const math::mat4& viewProjMatrix, const uint64_t maxUploadBytes) noexcept
+{
+    if (meshes.empty())
+    {
+        return 0;
+    }
+
+    ++frameId;
+    update_priorities(viewPos, viewProjMatrix);
+
+    // Visible meshes are loaded before meshes which are only nearby. Ties
+    // are broken by which mesh was seen most recently.
+    const uint32_t currentFrame = frameId;
+    const std::vector<SceneStreamedMesh>& streamedMeshes = meshes;
+
+    const auto isHigherPriority = [&](const uint32_t a, const uint32_t b) -> bool
+    {
+        const SceneStreamedMesh& ma = streamedMeshes[a];
+        const SceneStreamedMesh& mb = streamedMeshes[b];
+        const bool aVisible = ma.lastVisibleFrame == currentFrame;
+        const bool bVisible = mb.lastVisibleFrame == currentFrame;
+
+        if (aVisible != bVisible)
+        {
+            return aVisible;
+        }
+
+        if (ma.priority != mb.priority)
+        {
+            return ma.priority < mb.priority;
+        }
+
+        return ma.lastVisibleFrame > mb.lastVisibleFrame;
+    };
+
+    loadOrder.clear();
+    evictOrder.clear();
+
+    for (uint32_t i = 0; i < meshes.size(); ++i)
+    {
+        const SceneStreamedMesh& m = meshes[i];
+
+        if (m.isResident)
+        {
+            evictOrder.push_back(i);
+        }
+        else if (!m.isCorrupt && m.priority != std::numeric_limits<float>::infinity())
+        {
+            loadOrder.push_back(i);
+        }
+    }
+
+    std::sort(loadOrder.begin(), loadOrder.end(), isHigherPriority);
+    std::sort(evictOrder.begin(), evictOrder.end(), [&](const uint32_t a, const uint32_t b) -> bool
+    {
+        return isHigherPriority(b, a);
+    });
+
+    size_t nextEviction = 0;
+
+    // The budget may have been lowered since the last update.
+    while (residentBytes > residencyBudget && nextEviction < evictOrder.size())
+    {
+        evict_mesh(evictOrder[nextEviction++]);
+    }
+
+    const std::vector<SceneMesh>& sceneMeshes = loader.preloader.sceneData.meshes;
+    uint64_t numUploadedBytes = 0;
+    unsigned numUploaded = 0;
+
+    for (const uint32_t meshId : loadOrder)
+    {
+        const uint64_t numMeshBytes = sceneMeshes[meshId].metaData.calc_total_bytes();
+
+        if (numMeshBytes > residencyBudget)
+        {
+            continue;
+        }
+
+        if (maxUploadBytes && numUploaded && numUploadedBytes + numMeshBytes > maxUploadBytes)
+        {
+            break;
+        }
+
+        // Only meshes with a lower priority than the requested mesh can be
+        // evicted to make room for it.
+        while (true)
+        {
+            if (residentBytes + numMeshBytes <= residencyBudget && upload_mesh(meshId))
+            {
+                numUploadedBytes += numMeshBytes;
+                ++numUploaded;
+                break;
+            }
+
+            if (meshes[meshId].isCorrupt
+            || nextEviction >= evictOrder.size()
+            || !isHigherPriority(meshId, evictOrder[nextEviction]))
+            {
+                break;
+            }
+
+            evict_mesh(evictOrder[nextEviction++]);
+        }
+    }
+
+    return numUploaded;
+}
+
+
+
+/*-------------------------------------
+ * Upload a single mesh
+-------------------------------------*/
+bool SceneStreamer::upload_mesh(const uint32_t meshId) noexcept
+{
+    SceneGraph& sceneData = loader.preloader.sceneData;
+    const MeshMetaData& metaData = sceneData.meshes[meshId].metaData;
+    SceneStreamedMesh& m = meshes[meshId];
+    const uint32_t vertStride = metaData.calc_vertex_stride();
+    const uint32_t numVertBytes = metaData.calc_total_vertex_bytes();
+    const uint32_t numIndexBytes = metaData.calc_total_index_bytes();
+    size_t vboOffset = 0;
+    size_t iboOffset = 0;
+
+    LS_DEBUG_ASSERT(!m.isResident);
+
+    // Vertices are placed at a multiple of their stride so they can be
+    // located using a base vertex.
+    if (!vboAllocator.allocate(numVertBytes, vertStride, vboOffset))
+    {
+        return false;
+    }
+
+    if (!iboAllocator.allocate(numIndexBytes, sizeof(uint32_t), iboOffset))
+    {
+        vboAllocator.free(vboOffset, numVertBytes);
+        return false;
+    }
+
+    GLContextData& renderData = sceneData.renderData;
+    VertexBuffer& vbo = renderData.vbos.back();
+    IndexBuffer& ibo = renderData.ibos.back();
+    const SceneFileCache& cache = loader.preloader.cache;
+    const SceneCacheHeader& header = cache.get_header();
+    const char* const pCachedVerts = cache.get_data() + header.vboOffset;
+    const char* const pCachedIndices = cache.get_data() + header.iboOffset;
+    bool ret = true;
+
+    // A bound VAO would otherwise capture the streaming IBO.
+    glBindVertexArray(0);
+
+    if (header.payloadEncoding != SCENE_CACHE_PAYLOAD_ENCODED)
+    {
+        vbo.bind();
+        vbo.modify((ptrdiff_t)vboOffset, numVertBytes, pCachedVerts + m.srcVboOffset);
+        vbo.unbind();
+
+        ibo.bind();
+        ibo.modify((ptrdiff_t)iboOffset, numIndexBytes, pCachedIndices + m.srcIboOffset);
+        ibo.unbind();
+    }
+    else
+    {
+        const std::vector<SceneCachePayloadBlock>& blocks = loader.preloader.cacheBlocks;
+
+        vbo.bind();
+        char* const pVbo = (char*)vbo.map_data((ptrdiff_t)vboOffset, numVertBytes, STREAMED_MESH_MAP_FLAGS);
+
+        ibo.bind();
+        char* const pIbo = (char*)ibo.map_data((ptrdiff_t)iboOffset, numIndexBytes, STREAMED_MESH_MAP_FLAGS);
+
+        ret = pVbo && pIbo;
+
+        for (uint32_t i = 0; ret && i < m.numBlocks; ++i)
+        {
+            const SceneCachePayloadBlock& b = blocks[meshBlocks[m.firstBlock + i]];
+            const uint32_t numElements = b.rawBytes / b.elementBytes;
+
+            if (b.codec == mesh_codec_t::MESH_CODEC_VERTICES)
+            {
+                ret = decode_mesh_vertices(pCachedVerts + b.encodedOffset, b.encodedBytes, pVbo + (b.rawOffset - m.srcVboOffset), numElements, b.elementBytes, scratch);
+            }
+            else
+            {
+                ret = decode_mesh_indices(pCachedIndices + b.encodedOffset, b.encodedBytes, pIbo + (b.rawOffset - m.srcIboOffset), numElements, b.elementBytes, scratch);
+            }
+        }
+
+        if (pVbo)
+        {
+            vbo.bind();
+            vbo.unmap_data();
+        }
+
+        if (pIbo)
+        {
+            ibo.bind();
+            ibo.unmap_data();
+        }
+
+        vbo.unbind();
+        ibo.unbind();
+    }
+
+    if (!ret)
+    {
+        LS_LOG_ERR("\tError: Unable to stream mesh ", meshId, " from ", loader.preloader.filepath, ". It will not be requested again.");
+        vboAllocator.free(vboOffset, numVertBytes);
+        iboAllocator.free(iboOffset, numIndexBytes);
+        m.isCorrupt = true;
+        return false;
+    }
+
+    m.vboOffset = (uint32_t)vboOffset;
+    m.iboOffset = (uint32_t)iboOffset;
+    m.isResident = true;
+    residentBytes += metaData.calc_total_bytes();
+
+    update_draw_params(meshId);
+
+    return true;
+}
+
+
+
+/*-------------------------------------
+ * Evict a single mesh
+-------------------------------------*/
+void SceneStreamer::evict_mesh(const uint32_t meshId) noexcept
+{
+    const MeshMetaData& metaData = loader.preloader.sceneData.meshes[meshId].metaData;
+    SceneStreamedMesh& m = meshes[meshId];
+
+    LS_DEBUG_ASSERT(m.isResident);
+
+    vboAllocator.free(m.vboOffset, metaData.calc_total_vertex_bytes());
+    iboAllocator.free(m.iboOffset, metaData.calc_total_index_bytes());
+    residentBytes -= metaData.calc_total_bytes();
+    m.isResident = false;
+
+    update_draw_params(meshId);
+}
+
+
+
+/*-------------------------------------
+ * Synchronize draw parameters with residency
+-------------------------------------*/
+void SceneStreamer::update_draw_params(const uint32_t meshId) noexcept
+{
+    SceneGraph& sceneData = loader.preloader.sceneData;
+    SceneMesh& mesh = sceneData.meshes[meshId];
+    MeshMetaData& metaData = mesh.metaData;
+    DrawCommandParams& drawParams = mesh.drawParams;
+    const SceneStreamedMesh& m = meshes[meshId];
+
+    if (m.isResident)
+    {
+        const uint32_t firstVert = m.vboOffset / metaData.calc_vertex_stride();
+
+        // Cached indices may already include the mesh's original location.
+        drawParams.offset = (void*)(ptrdiff_t)m.iboOffset;
+        drawParams.count = metaData.totalIndices;
+        drawParams.baseVertex = (int32_t)firstVert - (int32_t)m.indexBias;
+
+        metaData.vboOffset = m.vboOffset;
+        metaData.baseVertex = firstVert;
+
+        if (meshId < sceneData.morphs.size() && sceneData.morphs[meshId].numVerts)
+        {
+            sceneData.morphs[meshId].baseVertex = firstVert;
+        }
+    }
+    else
+    {
+        drawParams.offset = nullptr;
+        drawParams.count = 0;
+        drawParams.baseVertex = 0;
+    }
+
+    for (uint32_t i = 0; i < m.numDraws; ++i)
+    {
+        const SceneStreamedDraw& d = draws[m.firstDraw + i];
+        DrawCommandParams& nodeParams = sceneData.nodeMeshes[d.nodeDataId][d.subMeshId];
+
+        nodeParams.offset = drawParams.offset;
+        nodeParams.count = drawParams.count;
+        nodeParams.baseVertex = drawParams.baseVertex;
+    }
+}
+} // end draw namespace
+} // end ls namespace
@@ -0,0 +1,220 @@
+
+#include <utility> // std::move
+
+#include "lightsky/utils/Assertions.h"
+#include "lightsky/utils/Log.h"
+
+#include "lightsky/draw/GLQuery.h"
+#include "lightsky/draw/SceneGraph.h"
+#include "lightsky/draw/SceneSkin.h"
+#include "lightsky/draw/SkinPalette.h"
+
+
+
+namespace ls
+{
+namespace draw
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * SkinPalette Class
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Destructor
+-------------------------------------*/
+SkinPalette::~SkinPalette() noexcept
+{
+    terminate();
+}
+
+
+
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+SkinPalette::SkinPalette() noexcept :
+    matrices{},
+    paletteOffsets{},
+    ubo{}
+{
+}
+
+
+
+/*-------------------------------------
+ * Copy Constructor
+-------------------------------------*/
+SkinPalette::SkinPalette(const SkinPalette& p) noexcept :
+    matrices{p.matrices},
+    paletteOffsets{p.paletteOffsets},
+    ubo{}
+{
+}
+
+
+
+/*-------------------------------------
+ * Move Constructor
+-------------------------------------*/
+SkinPalette::SkinPalette(SkinPalette&& p) noexcept :
+    matrices{std::move(p.matrices)},
+    paletteOffsets{std::move(p.paletteOffsets)},
+    ubo{std::move(p.ubo)}
+{
+}
+
+
+
+/*-------------------------------------
+ * Copy Operator
+-------------------------------------*/
+SkinPalette& SkinPalette::operator=(const SkinPalette& p) noexcept
+{
+    matrices = p.matrices;
+    paletteOffsets = p.paletteOffsets;
+
+    return *this;
+}
+
+
+
+/*-------------------------------------
+ * Move Operator
+-------------------------------------*/
+SkinPalette& SkinPalette::operator=(SkinPalette&& p) noexcept
+{
+    terminate();
+
+    matrices = std::move(p.matrices);
+    paletteOffsets = std::move(p.paletteOffsets);
+    ubo = std::move(p.ubo);
+
+    return *this;
+}
+
+
+
+/*-------------------------------------
+ * Initialize all palettes
+-------------------------------------*/
+bool SkinPalette::init(const SceneGraph& graph) noexcept
+{
+    terminate();
+
+    const std::vector<SceneSkin>& skins = graph.skins;
+    LS_DEBUG_ASSERT(skins.size() == graph.meshes.size());
+
+    // Each palette must start at a multiple of the UBO offset alignment so
+    // it can be bound using glBindBufferRange().
+    const size_t alignBytes = math::max<GLint>(get_gl_int(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT), 1);
+    const size_t alignMats = (alignBytes + sizeof(math::mat4) - 1) / sizeof(math::mat4);
+    size_t totalMats = 0;
+
+    paletteOffsets.reserve(skins.size());
+
+    for (const SceneSkin& skin : skins)
+    {
+        paletteOffsets.push_back(totalMats);
+
+        const size_t numBones = skin.get_num_bones();
+        totalMats += ((numBones + alignMats - 1) / alignMats) * alignMats;
+    }
+
+    if (!totalMats)
+    {
+        LS_LOG_MSG("No skinned meshes available to generate bone palettes.");
+        return true;
+    }
+
+    // Shaders declare a palette of SKIN_MAX_BONES matrices and the bound
+    // range of a uniform block must cover all of it. Pad the buffer so the
+    // full range of the last palette remains within the buffer.
+    totalMats = math::max<size_t>(totalMats, paletteOffsets.back() + skin_property_t::SKIN_MAX_BONES);
+
+    matrices.resize(totalMats, math::mat4(1.f));
+
+    if (!ubo.init())
+    {
+        LS_LOG_ERR("Unable to initialize a uniform buffer for ", skins.size(), " bone palettes.");
+        terminate();
+        return false;
+    }
+
+    ubo.bind();
+    ubo.set_data(sizeof(math::mat4) * totalMats, matrices.data(), buffer_access_t::VBO_STREAM_DRAW);
+    ubo.unbind();
+
+    LS_LOG_GL_ERR();
+
+    return true;
+}
+
+
+
+/*-------------------------------------
+ * Release all resources
+-------------------------------------*/
+void SkinPalette::terminate() noexcept
+{
+    matrices.clear();
+    paletteOffsets.clear();
+    ubo.terminate();
+}
+
+
+
+/*-------------------------------------
+ * Update all palettes
+-------------------------------------*/
+void SkinPalette::update(const SceneGraph& graph, const bool uploadToGpu) noexcept
+{
+    const std::vector<SceneSkin>& skins = graph.skins;
+    LS_DEBUG_ASSERT(skins.size() == paletteOffsets.size());
+
+    math::mat4* const pMatrices = matrices.data();
+
+    for (size_t i = skins.size(); i--;)
+    {
+        const SceneSkin& skin = skins[i];
+
+        if (skin.get_num_bones())
+        {
+            calc_skin_palette(graph, skin, pMatrices + paletteOffsets[i]);
+        }
+    }
+
+    if (uploadToGpu && ubo.is_valid())
+    {
+        // Orphan the previous buffer rather than waiting on the GPU to finish
+        // reading from it.
+        ubo.bind();
+        ubo.set_data(sizeof(math::mat4) * matrices.size(), pMatrices, buffer_access_t::VBO_STREAM_DRAW);
+        ubo.unbind();
+    }
+}
+
+
+
+/*-------------------------------------
+ * Bind a single palette
+-------------------------------------*/
+void SkinPalette::bind_palette(const size_t meshId, const unsigned bindingIndex) const noexcept
+{
+    LS_DEBUG_ASSERT(meshId < paletteOffsets.size());
+    LS_DEBUG_ASSERT(ubo.is_valid());
+
+    // Always bind a full palette. Ranges of neighboring meshes overlap, which
+    // is harmless as palettes are only read by shaders.
+    const size_t first = paletteOffsets[meshId];
+    LS_DEBUG_ASSERT(first + skin_property_t::SKIN_MAX_BONES <= matrices.size());
+
+    ubo.bind_range(
+        bindingIndex,
+        (ptrdiff_t)(sizeof(math::mat4) * first),
+        (ptrdiff_t)(sizeof(math::mat4) * skin_property_t::SKIN_MAX_BONES)
+    );
+}
+} // end draw namespace
+} // end ls namespace
@@ -44,6 +44,15 @@ unsigned draw::get_num_vertex_bytes(const vertex_data_t type)
             return sizeof(int32_t);
         case VERTEX_DATA_2_10U:
             return sizeof(uint32_t);
+        case VERTEX_DATA_VEC_4UB:
+        case VERTEX_DATA_VEC_4UBN:
+            return sizeof(math::vec4_t<unsigned char>);
+        case VERTEX_DATA_VEC_4USN:
+            return sizeof(math::vec4_t<unsigned short>);
+        case VERTEX_DATA_VEC_2SN:
+            return sizeof(math::vec2_t<short>);
+        case VERTEX_DATA_VEC_2HF:
+            return sizeof(math::vec2_t<unsigned short>);
 
         case VERTEX_DATA_VEC_2B:
             return sizeof(math::vec2_t<char>);
@@ -144,6 +153,8 @@ unsigned draw::get_vertex_components(const vertex_data_t type)
         case VERTEX_DATA_VEC_2I:
         case VERTEX_DATA_VEC_2UI:
         case VERTEX_DATA_VEC_2F:
+        case VERTEX_DATA_VEC_2SN:
+        case VERTEX_DATA_VEC_2HF:
             return 2;
 
         case VERTEX_DATA_VEC_3B:
@@ -158,6 +169,9 @@ unsigned draw::get_vertex_components(const vertex_data_t type)
         case VERTEX_DATA_VEC_4F:
         case VERTEX_DATA_2_10I:
         case VERTEX_DATA_2_10U:
+        case VERTEX_DATA_VEC_4UB:
+        case VERTEX_DATA_VEC_4UBN:
+        case VERTEX_DATA_VEC_4USN:
             return 4;
 
         case VERTEX_DATA_MAT_2F:
@@ -280,6 +294,19 @@ draw::vertex_data_t draw::get_vertex_base_type(const vertex_data_t type)
         case VERTEX_DATA_VEC_4B:
             return VERTEX_DATA_BYTE;
 
+        case VERTEX_DATA_VEC_4UB:
+        case VERTEX_DATA_VEC_4UBN:
+            return VERTEX_DATA_UBYTE;
+
+        case VERTEX_DATA_VEC_4USN:
+            return VERTEX_DATA_USHORT;
+
+        case VERTEX_DATA_VEC_2SN:
+            return VERTEX_DATA_SHORT;
+
+        case VERTEX_DATA_VEC_2HF:
+            return VERTEX_DATA_HALF_FLOAT;
+
         case VERTEX_DATA_VEC_2I:
         case VERTEX_DATA_VEC_3I:
         case VERTEX_DATA_VEC_4I:
@@ -337,7 +364,10 @@ GLboolean draw::get_vertex_normalization(const vertex_data_t type)
 {
     return (type == vertex_data_t::VERTEX_DATA_FIXED
             || type == vertex_data_t::VERTEX_DATA_2_10U
-            || type == vertex_data_t::VERTEX_DATA_2_10I)
+            || type == vertex_data_t::VERTEX_DATA_2_10I
+            || type == vertex_data_t::VERTEX_DATA_VEC_4UBN
+            || type == vertex_data_t::VERTEX_DATA_VEC_4USN
+            || type == vertex_data_t::VERTEX_DATA_VEC_2SN)
            ? GL_TRUE
            : GL_FALSE;
 }
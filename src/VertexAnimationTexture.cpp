@@ -0,0 +1,756 @@
+
+#include <cmath> // std::sqrt
+#include <cstdint>
+#include <cstring> // std::memcpy
+#include <utility> // std::move
+
+#include "lightsky/math/Math.h"
+
+#include "lightsky/utils/Assertions.h"
+#include "lightsky/utils/Log.h"
+
+#include "lightsky/draw/Animation.h"
+#include "lightsky/draw/GLQuery.h"
+#include "lightsky/draw/PackedVertex.h"
+#include "lightsky/draw/SceneGraph.h"
+#include "lightsky/draw/SceneMorph.h"
+#include "lightsky/draw/SceneSkin.h"
+#include "lightsky/draw/TextureAssembly.h"
+#include "lightsky/draw/VertexAnimationTexture.h"
+
+
+
+/*-----------------------------------------------------------------------------
+ * Anonymous helper functions
+-----------------------------------------------------------------------------*/
+namespace
+{
+
+namespace math = ls::math;
+namespace draw = ls::draw;
+
+typedef math::vec4_t<unsigned char> bone_bytes_t;
+
+
+
+/*-------------------------------------
+ * CPU-side layout of a std140 vertex animation uniform block
+-------------------------------------*/
+struct VatUniformBlock
+{
+    int32_t info[4]; // baseVertex, firstTexel, numVerts, numFrames
+    float timing[4]; // seconds, 1/duration, 0, 0
+};
+
+
+
+/*-------------------------------------
+ * Locate the node which draws a mesh
+-------------------------------------*/
+size_t find_mesh_node(const draw::SceneGraph& graph, const size_t meshId) noexcept
+{
+    const draw::DrawCommandParams& meshParams = graph.meshes[meshId].drawParams;
+
+    for (const draw::SceneNode& node : graph.nodes)
+    {
+        if (node.type != draw::scene_node_t::NODE_TYPE_MESH)
+        {
+            continue;
+        }
+
+        const draw::DrawCommandParams* const pParams = graph.nodeMeshes[node.dataId].get();
+
+        for (unsigned i = 0; i < graph.nodeMeshCounts[node.dataId]; ++i)
+        {
+            if (pParams[i].vaoId == meshParams.vaoId
+            && pParams[i].first == meshParams.first
+            && pParams[i].count == meshParams.count)
+            {
+                return node.nodeId;
+            }
+        }
+    }
+
+    return draw::scene_property_t::SCENE_GRAPH_ROOT_ID;
+}
+
+
+
+/*-------------------------------------
+ * Copy the vertices of a mesh from the GPU
+-------------------------------------*/
+bool read_mesh_vertices(const draw::SceneGraph& graph, const draw::SceneMesh& mesh, std::vector<char>& outVerts) noexcept
+{
+    const draw::VBODataList& vbos = graph.renderData.vbos;
+    const draw::MeshMetaData& metaData = mesh.metaData;
+    const unsigned numBytes = metaData.calc_total_vertex_bytes();
+
+    for (size_t i = 0; i < vbos.size(); ++i)
+    {
+        const draw::VertexBuffer& vbo = vbos[i];
+
+        if (vbo.gpu_id() != mesh.vboId)
+        {
+            continue;
+        }
+
+        vbo.bind();
+        const void* const pData = vbo.map_data(metaData.vboOffset, numBytes, draw::buffer_map_t::VBO_MAP_BIT_READ);
+
+        if (pData)
+        {
+            outVerts.resize(numBytes);
+            std::memcpy(outVerts.data(), pData, numBytes);
+            vbo.unmap_data();
+        }
+
+        vbo.unbind();
+        return pData != nullptr;
+    }
+
+    return false;
+}
+
+
+
+/*-------------------------------------
+ * Deform the vertices of a single mesh
+-------------------------------------*/
+void bake_mesh_frame(
+    const draw::SceneGraph& graph,
+    const size_t meshId,
+    const size_t nodeId,
+    const char* const pVerts,
+    std::vector<math::mat4>& palette,
+    float* pPositions,
+    float* pNormals
+) noexcept
+{
+    const draw::MeshMetaData& metaData = graph.meshes[meshId].metaData;
+    const draw::SceneSkin& skin = graph.skins[meshId];
+    const draw::SceneMorph& morph = graph.morphs[meshId];
+
+    const draw::common_vertex_t vertTypes = metaData.vertTypes;
+    const unsigned numVerts = metaData.totalVerts;
+    const unsigned stride = draw::get_vertex_stride(vertTypes);
+    const bool packedPos = 0 != (vertTypes & draw::common_vertex_t::PACKED_POSITION_VERTEX);
+    const bool packedNorms = 0 != (vertTypes & draw::common_vertex_t::PACKED_NORMAL_VERTEX);
+    const unsigned posOffset = draw::get_vertex_attrib_offset(vertTypes, packedPos ? draw::common_vertex_t::PACKED_POSITION_VERTEX : draw::common_vertex_t::POSITION_VERTEX);
+    const unsigned normOffset = draw::get_vertex_attrib_offset(vertTypes, packedNorms ? draw::common_vertex_t::PACKED_NORMAL_VERTEX : draw::common_vertex_t::NORMAL_VERTEX);
+    const unsigned idOffset = draw::get_vertex_attrib_offset(vertTypes, draw::common_vertex_t::BONE_ID_VERTEX);
+    const unsigned weightOffset = draw::get_vertex_attrib_offset(vertTypes, draw::common_vertex_t::BONE_WEIGHT_VERTEX);
+
+    const bool haveNormals = 0 != (vertTypes & (draw::common_vertex_t::NORMAL_VERTEX | draw::common_vertex_t::PACKED_NORMAL_VERTEX));
+    const bool isMorphed = morph.get_num_targets() && morph.numVerts == numVerts;
+    const bool isSkinned = skin.get_num_bones()
+        && draw::common_vertex_t::BONE_VERTEX == (vertTypes & draw::common_vertex_t::BONE_VERTEX);
+
+    if (isSkinned)
+    {
+        palette.resize(skin.get_num_bones());
+        draw::calc_skin_palette(graph, skin, palette.data());
+    }
+
+    // Skinned vertices are already placed in world-space by their palette.
+    const math::mat4 rigidMat = (nodeId == draw::scene_property_t::SCENE_GRAPH_ROOT_ID)
+        ? math::mat4{1.f}
+        : graph.modelMatrices[nodeId];
+
+    // Non-uniform scaling would skew normals transformed by the model matrix.
+    const math::mat4 rigidNormMat = math::transpose(math::inverse(rigidMat));
+
+    for (unsigned v = 0; v < numVerts; ++v)
+    {
+        const char* const pVert = pVerts + (size_t)v * stride;
+
+        math::vec3 pos;
+        math::vec3 norm{0.f, 0.f, 0.f};
+
+        if (packedPos)
+        {
+            const math::vec4_t<uint16_t>& p = *reinterpret_cast<const math::vec4_t<uint16_t>*>(pVert + posOffset);
+            pos = math::vec3{(float)p[0], (float)p[1], (float)p[2]} * (1.f / 65535.f) * metaData.dequantScale + metaData.dequantBias;
+        }
+        else
+        {
+            pos = *reinterpret_cast<const math::vec3*>(pVert + posOffset);
+        }
+
+        if (packedNorms)
+        {
+            norm = draw::unpack_vertex_octahedral(*reinterpret_cast<const math::vec2_t<int16_t>*>(pVert + normOffset));
+        }
+        else if (haveNormals)
+        {
+            norm = draw::unpack_vertex_normal(*reinterpret_cast<const int32_t*>(pVert + normOffset));
+        }
+
+        if (isMorphed)
+        {
+            for (unsigned d = morph.vertOffsets[v]; d < morph.vertOffsets[v + 1]; ++d)
+            {
+                const draw::SceneMorphDelta& delta = morph.deltas[d];
+                const float weight = morph.weights[delta.targetId];
+
+                pos += delta.position * weight;
+                norm += delta.normal * weight;
+            }
+        }
+
+        const math::vec4 p{pos[0], pos[1], pos[2], 1.f};
+        const math::vec4 n{norm[0], norm[1], norm[2], 0.f};
+        math::vec4 outPos{0.f, 0.f, 0.f, 0.f};
+        math::vec4 outNorm{0.f, 0.f, 0.f, 0.f};
+
+        if (isSkinned)
+        {
+            const bone_bytes_t& ids = *reinterpret_cast<const bone_bytes_t*>(pVert + idOffset);
+            const bone_bytes_t& weights = *reinterpret_cast<const bone_bytes_t*>(pVert + weightOffset);
+
+            for (unsigned i = 0; i < draw::skin_property_t::SKIN_MAX_VERTEX_INFLUENCES; ++i)
+            {
+                if (weights[i])
+                {
+                    const float w = (float)weights[i] * (1.f / 255.f);
+                    outPos += (palette[ids[i]] * p) * w;
+                    outNorm += (palette[ids[i]] * n) * w;
+                }
+            }
+        }
+        else
+        {
+            outPos = rigidMat * p;
+            outNorm = rigidNormMat * n;
+        }
+
+        const float normLen2 = outNorm[0]*outNorm[0] + outNorm[1]*outNorm[1] + outNorm[2]*outNorm[2];
+        const float normScale = (normLen2 > 0.f) ? (1.f / std::sqrt(normLen2)) : 0.f;
+
+        pPositions[0] = outPos[0];
+        pPositions[1] = outPos[1];
+        pPositions[2] = outPos[2];
+        pPositions[3] = 1.f;
+        pPositions += 4;
+
+        pNormals[0] = outNorm[0] * normScale;
+        pNormals[1] = outNorm[1] * normScale;
+        pNormals[2] = outNorm[2] * normScale;
+        pNormals[3] = 0.f;
+        pNormals += 4;
+    }
+}
+} // end anonymous namespace
+
+
+
+namespace ls
+{
+namespace draw
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * VertexAnimationTexture Class
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Destructor
+-------------------------------------*/
+VertexAnimationTexture::~VertexAnimationTexture() noexcept
+{
+    terminate();
+}
+
+
+
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+VertexAnimationTexture::VertexAnimationTexture() noexcept :
+    numFrames{0},
+    durationSecs{0.f},
+    maxInstances{0},
+    blockStride{0},
+    meshOffsets{},
+    uniformData{},
+    instanceData{},
+    frameTex{},
+    instanceTex{},
+    ubo{}
+{
+}
+
+
+
+/*-------------------------------------
+ * Copy Constructor
+-------------------------------------*/
+VertexAnimationTexture::VertexAnimationTexture(const VertexAnimationTexture& v) noexcept :
+    numFrames{v.numFrames},
+    durationSecs{v.durationSecs},
+    maxInstances{v.maxInstances},
+    blockStride{v.blockStride},
+    meshOffsets{v.meshOffsets},
+    uniformData{v.uniformData},
+    instanceData{v.instanceData},
+    frameTex{},
+    instanceTex{},
+    ubo{}
+{
+}
+
+
+
+/*-------------------------------------
+ * Move Constructor
+-------------------------------------*/
+VertexAnimationTexture::VertexAnimationTexture(VertexAnimationTexture&& v) noexcept :
+    numFrames{v.numFrames},
+    durationSecs{v.durationSecs},
+    maxInstances{v.maxInstances},
+    blockStride{v.blockStride},
+    meshOffsets{std::move(v.meshOffsets)},
+    uniformData{std::move(v.uniformData)},
+    instanceData{std::move(v.instanceData)},
+    frameTex{std::move(v.frameTex)},
+    instanceTex{std::move(v.instanceTex)},
+    ubo{std::move(v.ubo)}
+{
+    v.numFrames = 0;
+    v.durationSecs = 0.f;
+    v.maxInstances = 0;
+    v.blockStride = 0;
+}
+
+
+
+/*-------------------------------------
+ * Copy Operator
+-------------------------------------*/
+VertexAnimationTexture& VertexAnimationTexture::operator=(const VertexAnimationTexture& v) noexcept
+{
+    numFrames = v.numFrames;
+    durationSecs = v.durationSecs;
+    maxInstances = v.maxInstances;
+    blockStride = v.blockStride;
+    meshOffsets = v.meshOffsets;
+    uniformData = v.uniformData;
+    instanceData = v.instanceData;
+
+    return *this;
+}
+
+
+
+/*-------------------------------------
+ * Move Operator
+-------------------------------------*/
+VertexAnimationTexture& VertexAnimationTexture::operator=(VertexAnimationTexture&& v) noexcept
+{
+    terminate();
+
+    numFrames = v.numFrames;
+    v.numFrames = 0;
+
+    durationSecs = v.durationSecs;
+    v.durationSecs = 0.f;
+
+    maxInstances = v.maxInstances;
+    v.maxInstances = 0;
+
+    blockStride = v.blockStride;
+    v.blockStride = 0;
+
+    meshOffsets = std::move(v.meshOffsets);
+    uniformData = std::move(v.uniformData);
+    instanceData = std::move(v.instanceData);
+    frameTex = std::move(v.frameTex);
+    instanceTex = std::move(v.instanceTex);
+    ubo = std::move(v.ubo);
+
+    return *this;
+}
+
+
+
+/*-------------------------------------
+ * Release all baked frames
+-------------------------------------*/
+void VertexAnimationTexture::terminate_frames() noexcept
+{
+    numFrames = 0;
+    durationSecs = 0.f;
+    blockStride = 0;
+    meshOffsets.clear();
+    uniformData.clear();
+    frameTex.terminate();
+}
+
+
+
+/*-------------------------------------
+ * Bake an animation
+-------------------------------------*/
+bool VertexAnimationTexture::bake(
+    SceneGraph& graph,
+    const unsigned animationIndex,
+    const unsigned frameCount,
+    const bool useHalfFloats
+) noexcept
+{
+    terminate_frames();
+
+    if (animationIndex >= graph.animations.size())
+    {
+        LS_LOG_ERR("Unable to bake animation ", animationIndex, ". Only ", graph.animations.size(), " animations are available.");
+        return false;
+    }
+
+    if (frameCount < vat_property_t::VAT_MIN_FRAMES)
+    {
+        LS_LOG_ERR("Unable to bake an animation using ", frameCount, " frames.");
+        return false;
+    }
+
+    const Animation& anim = graph.animations[animationIndex];
+    const std::vector<SceneMesh>& meshes = graph.meshes;
+
+    LS_DEBUG_ASSERT(graph.skins.size() == meshes.size());
+    LS_DEBUG_ASSERT(graph.morphs.size() == meshes.size());
+
+    // Determine where each mesh's frames will be placed.
+    size_t totalTexels = 0;
+    meshOffsets.reserve(meshes.size());
+
+    for (const SceneMesh& mesh : meshes)
+    {
+        meshOffsets.push_back((unsigned)totalTexels);
+
+        if (mesh.metaData.vertTypes & (common_vertex_t::POSITION_VERTEX | common_vertex_t::PACKED_POSITION_VERTEX))
+        {
+            totalTexels += (size_t)mesh.metaData.totalVerts * 2 * frameCount;
+        }
+    }
+
+    if (!totalTexels)
+    {
+        LS_LOG_ERR("No meshes with vertex positions are available to bake.");
+        terminate_frames();
+        return false;
+    }
+
+    // Texel indices are calculated using signed integers in GLSL.
+    LS_DEBUG_ASSERT(totalTexels < (1u << 31u));
+
+    const int texWidth = (int)vat_property_t::VAT_TEXTURE_WIDTH;
+    const int texHeight = (int)((totalTexels + texWidth - 1) / texWidth);
+
+    if (texHeight > get_max_texture_size())
+    {
+        LS_LOG_ERR("Unable to fit ", totalTexels, " baked vertices into a single texture. Try reducing the frame count.");
+        terminate_frames();
+        return false;
+    }
+
+    // Baking requires a CPU copy of each mesh's vertices.
+    std::vector<std::vector<char>> vertData;
+    std::vector<size_t> meshNodes;
+    vertData.resize(meshes.size());
+    meshNodes.reserve(meshes.size());
+
+    for (size_t i = 0; i < meshes.size(); ++i)
+    {
+        meshNodes.push_back(find_mesh_node(graph, i));
+
+        if ((meshes[i].metaData.vertTypes & (common_vertex_t::POSITION_VERTEX | common_vertex_t::PACKED_POSITION_VERTEX))
+        && !read_mesh_vertices(graph, meshes[i], vertData[i]))
+        {
+            LS_LOG_ERR("Unable to read the vertices of mesh ", i, " from the GPU.");
+            terminate_frames();
+            return false;
+        }
+    }
+
+    // Preserve the current state of the graph so baking is non-destructive.
+    const std::vector<Transform> prevTransforms = graph.currentTransforms;
+    const std::vector<math::mat4> prevMatrices = graph.modelMatrices;
+    std::vector<std::vector<float>> prevWeights;
+    prevWeights.reserve(graph.morphs.size());
+
+    for (const SceneMorph& morph : graph.morphs)
+    {
+        prevWeights.push_back(morph.weights);
+    }
+
+    std::vector<float> texels;
+    std::vector<math::mat4> palette;
+    texels.resize((size_t)texWidth * (size_t)texHeight * 4, 0.f);
+
+    for (unsigned f = 0; f < frameCount; ++f)
+    {
+        const anim_prec_t percentDone = (anim_prec_t)f / (anim_prec_t)(frameCount - 1);
+
+        anim.animate(graph, percentDone);
+        graph.update();
+
+        for (size_t i = 0; i < meshes.size(); ++i)
+        {
+            if (vertData[i].empty())
+            {
+                continue;
+            }
+
+            const size_t numVerts = meshes[i].metaData.totalVerts;
+            float* const pFrame = texels.data() + (meshOffsets[i] + numVerts * 2 * f) * 4;
+
+            bake_mesh_frame(graph, i, meshNodes[i], vertData[i].data(), palette, pFrame, pFrame + numVerts * 4);
+        }
+    }
+
+    graph.currentTransforms = prevTransforms;
+    graph.modelMatrices = prevMatrices;
+
+    for (size_t i = 0; i < prevWeights.size(); ++i)
+    {
+        graph.morphs[i].weights = std::move(prevWeights[i]);
+    }
+
+    TextureAssembly assembly;
+    assembly.set_format_attrib(useHalfFloats ? pixel_format_t::COLOR_FMT_RGBA_16F : pixel_format_t::COLOR_FMT_RGBA_32F);
+
+    // Frames are interpolated manually, filtering would blend unrelated
+    // vertices.
+    assembly.set_int_attrib(TEX_PARAM_MAG_FILTER, tex_filter_t::TEX_FILTER_NEAREST);
+    assembly.set_int_attrib(TEX_PARAM_MIN_FILTER, tex_filter_t::TEX_FILTER_NEAREST);
+    assembly.set_int_attrib(TEX_PARAM_WRAP_S, tex_wrap_t::TEX_WRAP_CLAMP);
+    assembly.set_int_attrib(TEX_PARAM_WRAP_T, tex_wrap_t::TEX_WRAP_CLAMP);
+    assembly.set_size_attrib(math::vec2i{texWidth, texHeight}, tex_type_t::TEX_TYPE_2D, tex_2d_type_t::TEX_SUBTYPE_2D);
+
+    bool texCreated;
+
+    if (useHalfFloats)
+    {
+        std::vector<uint16_t> halfTexels;
+        halfTexels.reserve(texels.size());
+
+        for (const float f : texels)
+        {
+            halfTexels.push_back(pack_vertex_half(f));
+        }
+
+        texCreated = assembly.assemble(frameTex, halfTexels.data());
+    }
+    else
+    {
+        texCreated = assembly.assemble(frameTex, texels.data());
+    }
+
+    if (!texCreated)
+    {
+        LS_LOG_ERR("Unable to upload ", totalTexels, " baked vertices to the GPU.");
+        terminate_frames();
+        return false;
+    }
+
+    // Animations without a tick rate use the same default as imported
+    // animations.
+    const anim_prec_t ticksPerSec = anim.get_ticks_per_sec() > 0.0 ? anim.get_ticks_per_sec() : (anim_prec_t)23.976;
+
+    numFrames = frameCount;
+    durationSecs = (float)(anim.get_duration() / ticksPerSec);
+
+    const size_t alignBytes = math::max<GLint>(get_gl_int(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT), 1);
+    blockStride = ((sizeof(VatUniformBlock) + alignBytes - 1) / alignBytes) * alignBytes;
+    uniformData.resize(blockStride * meshes.size(), 0);
+
+    for (size_t i = 0; i < meshes.size(); ++i)
+    {
+        VatUniformBlock* const pBlock = reinterpret_cast<VatUniformBlock*>(uniformData.data() + blockStride * i);
+        pBlock->info[0] = (int32_t)meshes[i].metaData.baseVertex;
+        pBlock->info[1] = (int32_t)meshOffsets[i];
+        pBlock->info[2] = vertData[i].empty() ? 0 : (int32_t)meshes[i].metaData.totalVerts;
+        pBlock->info[3] = (int32_t)numFrames;
+        pBlock->timing[1] = durationSecs > 0.f ? (1.f / durationSecs) : 0.f;
+    }
+
+    // The uniform buffer is reused between bakes.
+    if (!ubo.is_valid() && !ubo.init())
+    {
+        LS_LOG_ERR("Unable to initialize a uniform buffer for ", meshes.size(), " vertex animation blocks.");
+        terminate_frames();
+        return false;
+    }
+
+    update(0.f);
+
+    LS_LOG_GL_ERR();
+
+    return true;
+}
+
+
+
+/*-------------------------------------
+ * Allocate the instance texture
+-------------------------------------*/
+bool VertexAnimationTexture::init_instances(const unsigned instanceCount) noexcept
+{
+    maxInstances = 0;
+    instanceData.clear();
+    instanceTex.terminate();
+
+    if (!instanceCount)
+    {
+        return false;
+    }
+
+    const size_t totalTexels = (size_t)instanceCount * vat_property_t::VAT_TEXELS_PER_INSTANCE;
+    const int texWidth = (int)vat_property_t::VAT_TEXTURE_WIDTH;
+    const int texHeight = (int)((totalTexels + texWidth - 1) / texWidth);
+
+    if (texHeight > get_max_texture_size())
+    {
+        LS_LOG_ERR("Unable to fit ", instanceCount, " vertex animation instances into a single texture.");
+        return false;
+    }
+
+    instanceData.resize((size_t)texWidth * (size_t)texHeight * 4, 0.f);
+
+    TextureAssembly assembly;
+    assembly.set_format_attrib(pixel_format_t::COLOR_FMT_RGBA_32F);
+    assembly.set_int_attrib(TEX_PARAM_MAG_FILTER, tex_filter_t::TEX_FILTER_NEAREST);
+    assembly.set_int_attrib(TEX_PARAM_MIN_FILTER, tex_filter_t::TEX_FILTER_NEAREST);
+    assembly.set_int_attrib(TEX_PARAM_WRAP_S, tex_wrap_t::TEX_WRAP_CLAMP);
+    assembly.set_int_attrib(TEX_PARAM_WRAP_T, tex_wrap_t::TEX_WRAP_CLAMP);
+    assembly.set_size_attrib(math::vec2i{texWidth, texHeight}, tex_type_t::TEX_TYPE_2D, tex_2d_type_t::TEX_SUBTYPE_2D);
+
+    if (!assembly.assemble(instanceTex, instanceData.data()))
+    {
+        LS_LOG_ERR("Unable to allocate a texture for ", instanceCount, " vertex animation instances.");
+        instanceData.clear();
+        return false;
+    }
+
+    maxInstances = instanceCount;
+
+    return true;
+}
+
+
+
+/*-------------------------------------
+ * Release all resources
+-------------------------------------*/
+void VertexAnimationTexture::terminate() noexcept
+{
+    terminate_frames();
+
+    maxInstances = 0;
+    instanceData.clear();
+    instanceTex.terminate();
+    ubo.terminate();
+}
+
+
+
+/*-------------------------------------
+ * Upload instance data
+-------------------------------------*/
+void VertexAnimationTexture::set_instances(const VertexAnimationInstance* const pInstances, const unsigned instanceCount) noexcept
+{
+    LS_DEBUG_ASSERT(instanceCount <= maxInstances);
+
+    if (!instanceCount)
+    {
+        return;
+    }
+
+    float* pTexel = instanceData.data();
+
+    for (unsigned i = 0; i < instanceCount; ++i)
+    {
+        const math::mat4& m = pInstances[i].modelMatrix;
+
+        // Matrices are stored as rows so the last row can be discarded.
+        for (unsigned r = 0; r < 3; ++r)
+        {
+            *pTexel++ = m[0][r];
+            *pTexel++ = m[1][r];
+            *pTexel++ = m[2][r];
+            *pTexel++ = m[3][r];
+        }
+
+        *pTexel++ = pInstances[i].timeOffset;
+        *pTexel++ = pInstances[i].playbackRate;
+        *pTexel++ = 0.f;
+        *pTexel++ = 0.f;
+    }
+
+    // Only upload the rows which contain new data.
+    const int texWidth = (int)vat_property_t::VAT_TEXTURE_WIDTH;
+    const int numTexels = (int)(instanceCount * vat_property_t::VAT_TEXELS_PER_INSTANCE);
+    const int numRows = (numTexels + texWidth - 1) / texWidth;
+
+    instanceTex.bind();
+    instanceTex.modify(tex_2d_type_t::TEX_SUBTYPE_2D, math::vec2i{0, 0}, math::vec2i{texWidth, numRows}, instanceData.data());
+    instanceTex.unbind();
+}
+
+
+
+/*-------------------------------------
+ * Update the playback time
+-------------------------------------*/
+void VertexAnimationTexture::update(const float seconds) noexcept
+{
+    char* const pBlocks = uniformData.data();
+
+    for (size_t i = meshOffsets.size(); i--;)
+    {
+        reinterpret_cast<VatUniformBlock*>(pBlocks + blockStride * i)->timing[0] = seconds;
+    }
+
+    if (ubo.is_valid() && !uniformData.empty())
+    {
+        // Orphan the previous buffer rather than waiting on the GPU to finish
+        // reading from it.
+        ubo.bind();
+        ubo.set_data(uniformData.size(), pBlocks, buffer_access_t::VBO_STREAM_DRAW);
+        ubo.unbind();
+    }
+}
+
+
+
+/*-------------------------------------
+ * Bind a single mesh's uniform block
+-------------------------------------*/
+void VertexAnimationTexture::bind_mesh(const size_t meshId, const unsigned bindingIndex) const noexcept
+{
+    LS_DEBUG_ASSERT(meshId < meshOffsets.size());
+    LS_DEBUG_ASSERT(ubo.is_valid());
+
+    ubo.bind_range(
+        bindingIndex,
+        (ptrdiff_t)(blockStride * meshId),
+        (ptrdiff_t)sizeof(VatUniformBlock)
+    );
+}
+
+
+
+/*-------------------------------------
+ * Draw instances of a baked mesh
+-------------------------------------*/
+void VertexAnimationTexture::draw_instances(const SceneGraph& graph, const size_t meshId, const unsigned instanceCount) const noexcept
+{
+    LS_DEBUG_ASSERT(meshId < graph.meshes.size());
+    LS_DEBUG_ASSERT(instanceCount <= maxInstances);
+
+    const DrawCommandParams& params = graph.meshes[meshId].drawParams;
+
+    glBindVertexArray(params.vaoId);
+    submit_draw_command(params, instanceCount);
+}
+} // end draw namespace
+} // end ls namespace
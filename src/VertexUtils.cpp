@@ -6,6 +6,7 @@
  */
 
 #include <limits>
+#include <type_traits> // std::underlying_type
 
 #include "lightsky/math/scalar_utils.h"
 
@@ -23,12 +24,18 @@ const char* const* draw::get_common_vertex_names() noexcept
 {
     static const char* const names[] = {
         draw::VERT_ATTRIB_NAME_POSITION,
+        draw::VERT_ATTRIB_NAME_PACKED_POSITION,
         draw::VERT_ATTRIB_NAME_TEXTURE,
+        draw::VERT_ATTRIB_NAME_TEXTURE,
+        draw::VERT_ATTRIB_NAME_COLOR,
         draw::VERT_ATTRIB_NAME_COLOR,
 
         draw::VERT_ATTRIB_NAME_NORMAL,
+        draw::VERT_ATTRIB_NAME_PACKED_NORMAL,
         draw::VERT_ATTRIB_NAME_TANGENT,
+        draw::VERT_ATTRIB_NAME_PACKED_TANGENT,
         draw::VERT_ATTRIB_NAME_BITANGENT,
+        draw::VERT_ATTRIB_NAME_PACKED_BITANGENT,
 
         draw::VERT_ATTRIB_NAME_MODEL_MATRIX,
 
@@ -83,6 +90,33 @@ unsigned draw::get_vertex_attrib_offset(const common_vertex_t vertexTypes, const
     return numBytes;
 }
 
+/*-------------------------------------
+ * Swap floating-point vertex types for packed ones
+-------------------------------------*/
+draw::common_vertex_t draw::get_packed_vertex_types(const common_vertex_t vertexTypes, const common_vertex_t packedTypes) noexcept
+{
+    constexpr common_vertex_t packingPairs[][2] = {
+        {POSITION_VERTEX,  PACKED_POSITION_VERTEX},
+        {TEXTURE_VERTEX,   PACKED_TEXTURE_VERTEX},
+        {COLOR_VERTEX,     PACKED_COLOR_VERTEX},
+        {NORMAL_VERTEX,    PACKED_NORMAL_VERTEX},
+        {TANGENT_VERTEX,   PACKED_TANGENT_VERTEX},
+        {BITANGENT_VERTEX, PACKED_BITANGENT_VERTEX}
+    };
+
+    std::underlying_type<common_vertex_t>::type outTypes = vertexTypes;
+
+    for (const common_vertex_t* pair : packingPairs)
+    {
+        if ((vertexTypes & pair[0]) && (packedTypes & pair[1]))
+        {
+            outTypes = (outTypes & ~pair[0]) | pair[1];
+        }
+    }
+
+    return (common_vertex_t)outTypes;
+}
+
 /*-------------------------------------
  * Get the minimum required index format required to perform indexed rendering.
 -------------------------------------*/
@@ -0,0 +1,500 @@
+
+#include <algorithm> // std::sort
+#include <cfloat> // FLT_MAX
+#include <cmath> // std::floor, std::sqrt
+#include <utility> // std::move
+
+#include "lightsky/utils/Log.h"
+
+#include "lightsky/draw/BoundingBox.h"
+#include "lightsky/draw/Camera.h"
+#include "lightsky/draw/Color.h"
+#include "lightsky/draw/SceneMaterial.h"
+#include "lightsky/draw/SceneMesh.h"
+#include "lightsky/draw/SceneNode.h"
+#include "lightsky/draw/Texture.h"
+#include "lightsky/draw/Transform.h"
+#include "lightsky/draw/WorldPartition.h"
+
+
+
+/*-----------------------------------------------------------------------------
+ * Anonymous helper functions
+-----------------------------------------------------------------------------*/
+namespace
+{
+
+namespace draw = ls::draw;
+namespace math = ls::math;
+
+
+
+/*-------------------------------------
+ * Pack a grid coordinate into a hash key (21 bits per axis)
+-------------------------------------*/
+inline uint64_t pack_cell_coord(const math::vec3i& coord) noexcept
+{
+    constexpr uint64_t axisBias = 1ull << 20ull;
+    constexpr uint64_t axisMask = (1ull << 21ull) - 1ull;
+
+    return
+        ((((uint64_t)(int64_t)coord[0] + axisBias) & axisMask) << 0ull)
+        | ((((uint64_t)(int64_t)coord[1] + axisBias) & axisMask) << 21ull)
+        | ((((uint64_t)(int64_t)coord[2] + axisBias) & axisMask) << 42ull);
+}
+
+
+
+/*-------------------------------------
+ * Distance along a single grid axis
+-------------------------------------*/
+inline float calc_axis_distance(const int coord, const float origin, const float size, const float point) noexcept
+{
+    // Axes with a size of 0 are ignored, flattening the grid to 2D.
+    if (size <= 0.f)
+    {
+        return 0.f;
+    }
+
+    const float minPos = origin + size * (float)coord;
+    const float maxPos = minPos + size;
+
+    if (point < minPos)
+    {
+        return minPos - point;
+    }
+
+    if (point > maxPos)
+    {
+        return point - maxPos;
+    }
+
+    return 0.f;
+}
+
+
+
+} // end anonymous namespace
+
+
+
+namespace ls
+{
+namespace draw
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * WorldPartition Class
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Destructor
+-------------------------------------*/
+WorldPartition::~WorldPartition() noexcept
+{
+    terminate();
+}
+
+
+
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+WorldPartition::WorldPartition() noexcept :
+    loadService{},
+    cells{},
+    cellIds{},
+    residentView{},
+    loadOrder{},
+    cellOrigin{0.f},
+    cellSize{0.f},
+    loadRadius{0.f},
+    unloadRadius{0.f},
+    cacheMode{SCENE_CACHE_READ_WRITE}
+{
+}
+
+
+
+/*-------------------------------------
+ * Initialization
+-------------------------------------*/
+bool WorldPartition::init(
+    const math::vec3& origin,
+    const math::vec3& size,
+    const unsigned numThreads,
+    const scene_cache_mode_t cacheFlags
+) noexcept
+{
+    terminate();
+
+    if (size[0] <= 0.f && size[1] <= 0.f && size[2] <= 0.f)
+    {
+        LS_LOG_ERR("Unable to initialize a world partition: invalid cell size.");
+        return false;
+    }
+
+    if (!loadService.init(numThreads))
+    {
+        LS_LOG_ERR("Unable to start the world partition's loading threads.");
+        return false;
+    }
+
+    cellOrigin = origin;
+    cellSize = size;
+    cacheMode = cacheFlags;
+
+    return true;
+}
+
+
+
+/*-------------------------------------
+ * Termination
+-------------------------------------*/
+void WorldPartition::terminate() noexcept
+{
+    for (WorldCell& cell : cells)
+    {
+        if (cell.request)
+        {
+            loadService.cancel(cell.request);
+            cell.request.reset();
+        }
+
+        unload_cell(cell);
+    }
+
+    // Joining the loading threads releases all requests which could not be
+    // cancelled.
+    loadService.terminate();
+
+    cells.clear();
+    cellIds.clear();
+    residentView.clear();
+    loadOrder.clear();
+}
+
+
+
+/*-------------------------------------
+ * Map a cell to a file
+-------------------------------------*/
+size_t WorldPartition::add_cell(const math::vec3i& coord, const std::string& filepath) noexcept
+{
+    const uint64_t key = pack_cell_coord(coord);
+    const std::unordered_map<uint64_t, size_t>::const_iterator iter = cellIds.find(key);
+
+    if (iter != cellIds.end())
+    {
+        LS_LOG_MSG("World cell (", coord[0], ", ", coord[1], ", ", coord[2], ") is already mapped to ", cells[iter->second].filepath, '.');
+        return iter->second;
+    }
+
+    const size_t cellId = cells.size();
+    cells.emplace_back();
+
+    WorldCell& cell = cells.back();
+    cell.coord = coord;
+    cell.filepath = filepath;
+    cell.status = world_cell_status_t::WORLD_CELL_UNLOADED;
+    cell.request.reset();
+    cell.memory = WorldCellMemory{0, 0, 0};
+
+    cellIds[key] = cellId;
+
+    // Adding a cell may reallocate all cell scenes.
+    update_view();
+
+    return cellId;
+}
+
+
+
+/*-------------------------------------
+ * Locate a cell
+-------------------------------------*/
+size_t WorldPartition::find_cell(const math::vec3i& coord) const noexcept
+{
+    const std::unordered_map<uint64_t, size_t>::const_iterator iter = cellIds.find(pack_cell_coord(coord));
+    return iter != cellIds.end() ? iter->second : (size_t)SCENE_GRAPH_ROOT_ID;
+}
+
+
+
+/*-------------------------------------
+ * Convert a position to a grid coordinate
+-------------------------------------*/
+math::vec3i WorldPartition::get_cell_coord(const math::vec3& point) const noexcept
+{
+    math::vec3i coord{0};
+
+    for (unsigned i = 0; i < 3; ++i)
+    {
+        if (cellSize[i] > 0.f)
+        {
+            coord[i] = (int)std::floor((point[i] - cellOrigin[i]) / cellSize[i]);
+        }
+    }
+
+    return coord;
+}
+
+
+
+/*-------------------------------------
+ * Set the load & unload distances
+-------------------------------------*/
+void WorldPartition::set_radii(const float loadDistance, const float unloadDistance) noexcept
+{
+    loadRadius = loadDistance;
+    unloadRadius = unloadDistance < loadDistance ? loadDistance : unloadDistance;
+}
+
+
+
+/*-------------------------------------
+ * Distance between a point and a cell
+-------------------------------------*/
+float WorldPartition::calc_cell_distance(const math::vec3i& coord, const math::vec3& point) const noexcept
+{
+    const float dx = calc_axis_distance(coord[0], cellOrigin[0], cellSize[0], point[0]);
+    const float dy = calc_axis_distance(coord[1], cellOrigin[1], cellSize[1], point[1]);
+    const float dz = calc_axis_distance(coord[2], cellOrigin[2], cellSize[2], point[2]);
+
+    return std::sqrt(dx*dx + dy*dy + dz*dz);
+}
+
+
+
+/*-------------------------------------
+ * Release a resident cell
+-------------------------------------*/
+void WorldPartition::unload_cell(WorldCell& cell) noexcept
+{
+    cell.scene.terminate();
+    cell.memory = WorldCellMemory{0, 0, 0};
+    cell.status = world_cell_status_t::WORLD_CELL_UNLOADED;
+}
+
+
+
+/*-------------------------------------
+ * Rebuild the list of resident cells
+-------------------------------------*/
+void WorldPartition::update_view() noexcept
+{
+    residentView.clear();
+
+    for (size_t i = 0; i < cells.size(); ++i)
+    {
+        if (cells[i].status == world_cell_status_t::WORLD_CELL_RESIDENT)
+        {
+            residentView.push_back(WorldCellView{i, &cells[i].scene});
+        }
+    }
+}
+
+
+
+/*-------------------------------------
+ * Stream cells around a set of cameras
+-------------------------------------*/
+bool WorldPartition::update(const std::vector<math::vec3>& cameraPositions, const uint64_t budgetMicros) noexcept
+{
+    bool viewChanged = false;
+
+    loadService.update(budgetMicros);
+    loadOrder.clear();
+
+    for (size_t i = 0; i < cells.size(); ++i)
+    {
+        WorldCell& cell = cells[i];
+        float distance = FLT_MAX;
+
+        for (const math::vec3& camPos : cameraPositions)
+        {
+            const float camDist = calc_cell_distance(cell.coord, camPos);
+            distance = camDist < distance ? camDist : distance;
+        }
+
+        const bool inLoadRange = distance <= loadRadius;
+        const bool inUnloadRange = distance <= unloadRadius;
+
+        switch (cell.status)
+        {
+            case world_cell_status_t::WORLD_CELL_UNLOADED:
+                if (inLoadRange)
+                {
+                    loadOrder.emplace_back(distance, i);
+                }
+                break;
+
+            case world_cell_status_t::WORLD_CELL_LOADING:
+                if (!cell.request->is_finished())
+                {
+                    // Loads which have already started can not be cancelled.
+                    // Their results are discarded once they finish.
+                    if (!inUnloadRange && loadService.cancel(cell.request))
+                    {
+                        cell.request.reset();
+                        cell.status = world_cell_status_t::WORLD_CELL_UNLOADED;
+                    }
+                    break;
+                }
+
+                if (cell.request->get_status() == scene_load_status_t::SCENE_LOAD_COMPLETE)
+                {
+                    SceneGraph& loadedData = cell.request->get_loader().get_loaded_data();
+
+                    if (inUnloadRange)
+                    {
+                        cell.scene = std::move(loadedData);
+                        cell.memory = calc_scene_memory(cell.scene);
+                        cell.status = world_cell_status_t::WORLD_CELL_RESIDENT;
+                        viewChanged = true;
+                    }
+                    else
+                    {
+                        loadedData.terminate();
+                        cell.status = world_cell_status_t::WORLD_CELL_UNLOADED;
+                    }
+                }
+                else if (cell.request->get_status() == scene_load_status_t::SCENE_LOAD_CANCELLED)
+                {
+                    cell.status = world_cell_status_t::WORLD_CELL_UNLOADED;
+                }
+                else
+                {
+                    LS_LOG_ERR("Unable to load world cell (", cell.coord[0], ", ", cell.coord[1], ", ", cell.coord[2], ") from ", cell.filepath, '.');
+                    cell.status = world_cell_status_t::WORLD_CELL_FAILED;
+                }
+
+                cell.request.reset();
+                break;
+
+            case world_cell_status_t::WORLD_CELL_RESIDENT:
+                if (!inUnloadRange)
+                {
+                    unload_cell(cell);
+                    viewChanged = true;
+                }
+                break;
+
+            case world_cell_status_t::WORLD_CELL_FAILED:
+                // Failed cells are retried after all cameras have left them.
+                if (!inUnloadRange)
+                {
+                    cell.status = world_cell_status_t::WORLD_CELL_UNLOADED;
+                }
+                break;
+        }
+    }
+
+    // Request the nearest cells first so they are preloaded before distant
+    // ones.
+    std::sort(loadOrder.begin(), loadOrder.end());
+
+    for (const std::pair<float, size_t>& order : loadOrder)
+    {
+        WorldCell& cell = cells[order.second];
+
+        cell.request = loadService.load(cell.filepath, cacheMode);
+        if (!cell.request)
+        {
+            LS_LOG_ERR("Unable to queue world cell (", cell.coord[0], ", ", cell.coord[1], ", ", cell.coord[2], ") for loading.");
+            cell.status = world_cell_status_t::WORLD_CELL_FAILED;
+            continue;
+        }
+
+        cell.status = world_cell_status_t::WORLD_CELL_LOADING;
+    }
+
+    if (viewChanged)
+    {
+        update_view();
+    }
+
+    return viewChanged;
+}
+
+
+
+/*-------------------------------------
+ * Sum the memory of all resident cells
+-------------------------------------*/
+WorldCellMemory WorldPartition::get_resident_memory() const noexcept
+{
+    WorldCellMemory total{0, 0, 0};
+
+    for (const WorldCellView& view : residentView)
+    {
+        const WorldCellMemory& mem = cells[view.cellId].memory;
+        total.cpuBytes += mem.cpuBytes;
+        total.geometryBytes += mem.geometryBytes;
+        total.textureBytes += mem.textureBytes;
+    }
+
+    return total;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * Scene Memory Utilities
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Calculate the memory used by a scene graph
+-------------------------------------*/
+WorldCellMemory calc_scene_memory(const SceneGraph& graph) noexcept
+{
+    WorldCellMemory mem{0, 0, 0};
+
+    // CPU arrays. Containers nested within skins, morphs, and animations are
+    // not included.
+    mem.cpuBytes += sizeof(Camera) * graph.cameras.size();
+    mem.cpuBytes += sizeof(SceneMesh) * graph.meshes.size();
+    mem.cpuBytes += sizeof(SceneSkin) * graph.skins.size();
+    mem.cpuBytes += sizeof(SceneMorph) * graph.morphs.size();
+    mem.cpuBytes += sizeof(BoundingBox) * graph.bounds.size();
+    mem.cpuBytes += sizeof(SceneMaterial) * graph.materials.size();
+    mem.cpuBytes += sizeof(SceneNode) * graph.nodes.size();
+    mem.cpuBytes += sizeof(math::mat4) * graph.baseTransforms.size();
+    mem.cpuBytes += sizeof(Transform) * graph.currentTransforms.size();
+    mem.cpuBytes += sizeof(math::mat4) * graph.modelMatrices.size();
+    mem.cpuBytes += sizeof(Animation) * graph.animations.size();
+
+    mem.cpuBytes += sizeof(scene_name_t) * graph.nodeNames.size();
+    mem.cpuBytes += graph.nameTable.get_num_bytes();
+
+    for (const std::vector<AnimationChannel>& channels : graph.nodeAnims)
+    {
+        mem.cpuBytes += sizeof(AnimationChannel) * channels.size();
+    }
+
+    for (const unsigned meshCount : graph.nodeMeshCounts)
+    {
+        mem.cpuBytes += sizeof(unsigned) + sizeof(DrawCommandParams) * meshCount;
+    }
+
+    for (const SceneMesh& mesh : graph.meshes)
+    {
+        mem.geometryBytes += mesh.metaData.calc_total_bytes();
+    }
+
+    // Only the base level of each texture is counted.
+    for (size_t i = 0; i < graph.renderData.textures.size(); ++i)
+    {
+        const Texture& tex = graph.renderData.textures[i];
+        const math::vec3i& size = tex.get_size();
+        const uint64_t depth = size[2] > 0 ? (uint64_t)size[2] : 1ull;
+        const uint64_t bytesPerPixel = get_num_color_bytes(get_color_type(tex.get_attribs().get_internal_format()));
+
+        mem.textureBytes += (uint64_t)size[0] * (uint64_t)size[1] * depth * bytesPerPixel;
+    }
+
+    return mem;
+}
+} // end draw namespace
+} // end ls namespace